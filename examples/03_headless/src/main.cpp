@@ -24,8 +24,13 @@ class HeadlessLoop {
     auto tickLength = std::chrono::milliseconds(60000 / (bpm * 4));
     std::cout << "[headless] quiet-mode=" << quietMode << ", bpm=" << bpm << "\n";
 
+    // Sleep until each tick's slot on a fixed grid rather than "sleep, then
+    // work": time spent inside the callback no longer pushes every later tick.
+    const auto step = quietMode ? tickLength / 8 : tickLength;
+    auto deadline = std::chrono::steady_clock::now();
     for (int i = 0; i < cycles; ++i) {
-      std::this_thread::sleep_for(quietMode ? tickLength / 8 : tickLength);
+      deadline += step;
+      std::this_thread::sleep_until(deadline);
       if (callback_) {
         callback_(i);
       }
@@ -1,6 +1,7 @@
 #include "offline_renderer.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -57,24 +58,18 @@ double samplerAdsr(double t,
   return 0.0;
 }
 
+double modalSustain(double feedback) { return std::clamp(0.35 + 0.45 * feedback, 0.1, 0.95); }
+
+double modalDecayHz(double damping) { return 0.75 + (1.5 - damping) * 1.75; }
+
 double modalEnvelope(double t, double damping, double feedback) {
-  const double sustain = std::clamp(0.35 + 0.45 * feedback, 0.1, 0.95);
-  const double decayHz = 0.75 + (1.5 - damping) * 1.75;
-  return sustain * std::exp(-t * decayHz);
+  return modalSustain(feedback) * std::exp(-t * modalDecayHz(damping));
 }
 
-void writeTag(std::ofstream& out, const char (&tag)[5]) {
-  out.write(tag, 4);
-}
+constexpr double kResonatorSilence = 1e-6;
 
-template <typename T>
-void writeLittleEndian(std::ofstream& out, T value) {
-  using UnsignedT = std::make_unsigned_t<T>;
-  UnsignedT v = static_cast<UnsignedT>(value);
-  for (std::size_t i = 0; i < sizeof(UnsignedT); ++i) {
-    const char byte = static_cast<char>((v >> (8u * i)) & 0xFFu);
-    out.put(byte);
-  }
+std::size_t framesFor(double seconds, double framesPerSecond) {
+  return static_cast<std::size_t>(std::ceil(seconds * framesPerSecond)) + 2u;
 }
 
 }  // namespace
@@ -85,14 +80,13 @@ OfflineRenderer::OfflineRenderer(RenderSettings settings)
 }
 
 void OfflineRenderer::reset() {
-  mix_.assign(settings_.frames, 0.0);
+  frames_ = settings_.frames;
+  voices_.clear();
   pcm16_.clear();
 }
 
-void OfflineRenderer::ensureBuffer(std::size_t framesNeeded) {
-  if (framesNeeded > mix_.size()) {
-    mix_.resize(framesNeeded, 0.0);
-  }
+void OfflineRenderer::ensureFrames(std::size_t framesNeeded) {
+  frames_ = std::max(frames_, framesNeeded);
 }
 
 void OfflineRenderer::mixSamplerEvents(const std::vector<SamplerEvent>& events) {
@@ -124,43 +118,32 @@ void OfflineRenderer::mixSamplerEvents(const std::vector<SamplerEvent>& events)
   }
 
   const std::size_t tail = static_cast<std::size_t>(settings_.sampleRate * 2.0);
-  ensureBuffer(static_cast<std::size_t>(maxWhen) + tail + 1);
+  ensureFrames(static_cast<std::size_t>(maxWhen) + tail + 1);
 
-  const double framesPerSecond = settings_.sampleRate;
   const double sustainHold = settings_.samplerSustainHold;
   const double baseFrequencies[] = {110.0, 164.81, 220.0, 261.63, 329.63, 392.0, 523.25};
 
-  for (const auto& voice : voices) {
-    const double freqBase = baseFrequencies[voice.sampleIndex % std::size(baseFrequencies)];
-    const double freq = freqBase * static_cast<double>(voice.playbackRate);
-    const double pan = 0.5 * (static_cast<double>(voice.leftGain) + static_cast<double>(voice.rightGain));
-    const std::size_t start = static_cast<std::size_t>(voice.startSample);
-
-    for (std::size_t frame = start; frame < mix_.size(); ++frame) {
-      const double t = (static_cast<double>(frame - start)) / framesPerSecond;
-      const double env = samplerAdsr(t,
-                                     static_cast<double>(voice.envelope.attack),
-                                     static_cast<double>(voice.envelope.decay),
-                                     static_cast<double>(voice.envelope.sustain),
-                                     static_cast<double>(voice.envelope.release),
-                                     sustainHold);
-      if (env <= 0.0) {
-        if (t > (voice.envelope.attack + voice.envelope.decay + sustainHold + voice.envelope.release)) {
-          break;
-        }
-        continue;
-      }
-
-      const double toneBlend = static_cast<double>(voice.tone);
-      const double fundamental = std::sin(kTwoPi * freq * t);
-      const double harmonic = std::sin(kTwoPi * freq * 2.03 * t);
-      double sample = (1.0 - toneBlend) * fundamental + toneBlend * harmonic;
-      if (voice.usesSdStreaming) {
-        const double grit = std::sin(kTwoPi * freq * 0.125 * t);
-        sample = (sample * 0.9) + (grit * 0.1);
-      }
-      mix_[frame] += sample * env * pan;
-    }
+  voices_.reserve(voices_.size() + voices.size());
+  for (const auto& state : voices) {
+    Voice voice;
+    voice.kind = Voice::Kind::kSampler;
+    voice.start = static_cast<std::size_t>(state.startSample);
+    const double freqBase = baseFrequencies[state.sampleIndex % std::size(baseFrequencies)];
+    voice.frequency = freqBase * static_cast<double>(state.playbackRate);
+    voice.pan = 0.5 * (static_cast<double>(state.leftGain) + static_cast<double>(state.rightGain));
+    voice.tone = static_cast<double>(state.tone);
+    voice.attack = static_cast<double>(state.envelope.attack);
+    voice.decay = static_cast<double>(state.envelope.decay);
+    voice.sustain = static_cast<double>(state.envelope.sustain);
+    voice.release = static_cast<double>(state.envelope.release);
+    voice.lifetime = state.envelope.attack + state.envelope.decay + sustainHold + state.envelope.release;
+    voice.sdGrit = state.usesSdStreaming;
+    // samplerAdsr() stretches zero-length stages to kMinStage, so it can ring
+    // a hair past `lifetime`; nothing sounds after the stretched length.
+    const double audible = std::max(voice.attack, 1e-4) + std::max(voice.decay, 1e-4) + sustainHold +
+                           std::max(voice.release, 1e-4);
+    voice.end = std::min(frames_, voice.start + framesFor(std::max(audible, voice.lifetime), settings_.sampleRate));
+    voices_.push_back(voice);
   }
 }
 
@@ -192,101 +175,207 @@ void OfflineRenderer::mixResonatorEvents(const std::vector<ResonatorEvent>& even
   }
 
   const std::size_t tail = static_cast<std::size_t>(settings_.sampleRate * 4.0);
-  ensureBuffer(static_cast<std::size_t>(maxWhen) + tail + 1);
+  ensureFrames(static_cast<std::size_t>(maxWhen) + tail + 1);
+
+  voices_.reserve(voices_.size() + voices.size());
+  for (const auto& state : voices) {
+    Voice voice;
+    voice.kind = Voice::Kind::kResonator;
+    voice.start = static_cast<std::size_t>(state.startSample);
+    voice.frequency = static_cast<double>(state.frequency);
+    voice.burstGain = static_cast<double>(state.burstGain);
+    voice.damping = static_cast<double>(state.damping);
+    voice.feedback = static_cast<double>(state.feedback);
+    voice.burstEnd = static_cast<double>(state.burstMs) / 1000.0;
+    for (std::size_t mode = 0; mode < voice.modalFrequencies.size(); ++mode) {
+      voice.modalFrequencies[mode] = static_cast<double>(state.modalFrequencies[mode]);
+      voice.modalGains[mode] = static_cast<double>(state.modalGains[mode]);
+    }
+    // The envelope only falls, so the voice is silent for good once it drops
+    // under kResonatorSilence (and the render loop stops trying after 6 s).
+    voice.end = frames_;
+    const double decayHz = modalDecayHz(voice.damping);
+    if (decayHz > 0.0) {
+      const double fade = std::log(modalSustain(voice.feedback) / kResonatorSilence) / decayHz;
+      voice.end = std::min(frames_, voice.start + framesFor(std::max(fade, 6.0), settings_.sampleRate));
+    }
+    voices_.push_back(voice);
+  }
+}
 
+void OfflineRenderer::addSampler(const Voice& voice, std::size_t first, std::size_t count, double* out) const {
   const double framesPerSecond = settings_.sampleRate;
+  const double sustainHold = settings_.samplerSustainHold;
+  const std::size_t from = std::max(first, voice.start);
+  const std::size_t to = std::min(first + count, voice.end);
+  for (std::size_t frame = from; frame < to; ++frame) {
+    const double t = (static_cast<double>(frame - voice.start)) / framesPerSecond;
+    const double env = samplerAdsr(t, voice.attack, voice.decay, voice.sustain, voice.release, sustainHold);
+    if (env <= 0.0) {
+      if (t > voice.lifetime) {
+        break;
+      }
+      continue;
+    }
+
+    const double toneBlend = voice.tone;
+    const double fundamental = std::sin(kTwoPi * voice.frequency * t);
+    const double harmonic = std::sin(kTwoPi * voice.frequency * 2.03 * t);
+    double sample = (1.0 - toneBlend) * fundamental + toneBlend * harmonic;
+    if (voice.sdGrit) {
+      const double grit = std::sin(kTwoPi * voice.frequency * 0.125 * t);
+      sample = (sample * 0.9) + (grit * 0.1);
+    }
+    out[frame - first] += sample * env * voice.pan;
+  }
+}
 
-  for (const auto& voice : voices) {
-    const std::size_t start = static_cast<std::size_t>(voice.startSample);
-    const double burst = static_cast<double>(voice.burstGain);
-    const double damping = static_cast<double>(voice.damping);
-    const double feedback = static_cast<double>(voice.feedback);
-    const double burstEnd = static_cast<double>(voice.burstMs) / 1000.0;
-
-    for (std::size_t frame = start; frame < mix_.size(); ++frame) {
-      const double t = (static_cast<double>(frame - start)) / framesPerSecond;
-      const double envelope = modalEnvelope(t, damping, feedback);
-      if (envelope < 1e-6) {
-        if (t > 6.0) {
-          break;
-        }
+void OfflineRenderer::addResonator(const Voice& voice, std::size_t first, std::size_t count, double* out) const {
+  const double framesPerSecond = settings_.sampleRate;
+  const std::size_t from = std::max(first, voice.start);
+  const std::size_t to = std::min(first + count, voice.end);
+  for (std::size_t frame = from; frame < to; ++frame) {
+    const double t = (static_cast<double>(frame - voice.start)) / framesPerSecond;
+    const double envelope = modalEnvelope(t, voice.damping, voice.feedback);
+    if (envelope < kResonatorSilence) {
+      if (t > 6.0) {
+        break;
+      }
+      continue;
+    }
+    const double excite = std::exp(-std::max(0.0, t - voice.burstEnd) * 6.5);
+    double sample = 0.0;
+    for (std::size_t mode = 0; mode < voice.modalFrequencies.size(); ++mode) {
+      const double freq = voice.modalFrequencies[mode];
+      const double gain = voice.modalGains[mode];
+      if (gain <= 0.0 || freq <= 0.0) {
         continue;
       }
-      const double excite = std::exp(-std::max(0.0, t - burstEnd) * 6.5);
-      double sample = 0.0;
-      for (std::size_t mode = 0; mode < voice.modalFrequencies.size(); ++mode) {
-        const double freq = static_cast<double>(voice.modalFrequencies[mode]);
-        const double gain = static_cast<double>(voice.modalGains[mode]);
-        if (gain <= 0.0 || freq <= 0.0) {
-          continue;
-        }
-        sample += gain * std::sin(kTwoPi * freq * t);
+      sample += gain * std::sin(kTwoPi * freq * t);
+    }
+    sample += 0.35 * std::sin(kTwoPi * voice.frequency * t);
+    out[frame - first] += sample * voice.burstGain * envelope * (0.5 + 0.5 * excite);
+  }
+}
+
+template <typename Sink>
+void OfflineRenderer::renderBlocks(std::size_t frames, Sink&& sink) const {
+  // Voices enter the live set when their start reaches the block and leave
+  // once their end is behind it.  The set is kept in mix order, which is the
+  // order a resident buffer would have summed them in.
+  std::vector<std::size_t> byStart(voices_.size());
+  for (std::size_t i = 0; i < byStart.size(); ++i) {
+    byStart[i] = i;
+  }
+  std::stable_sort(byStart.begin(), byStart.end(),
+                   [&](std::size_t a, std::size_t b) { return voices_[a].start < voices_[b].start; });
+  std::vector<std::size_t> live;
+  std::size_t next = 0;
+  std::array<double, kBlockFrames> block{};
+  for (std::size_t first = 0; first < frames; first += kBlockFrames) {
+    const std::size_t count = std::min(kBlockFrames, frames - first);
+    const std::size_t last = first + count;
+    bool joined = false;
+    while (next < byStart.size() && voices_[byStart[next]].start < last) {
+      live.push_back(byStart[next++]);
+      joined = true;
+    }
+    if (joined) {
+      std::sort(live.begin(), live.end());
+    }
+    live.erase(std::remove_if(live.begin(), live.end(), [&](std::size_t i) { return voices_[i].end <= first; }),
+               live.end());
+
+    std::fill(block.begin(), block.begin() + static_cast<std::ptrdiff_t>(count), 0.0);
+    for (std::size_t i : live) {
+      const Voice& voice = voices_[i];
+      if (voice.kind == Voice::Kind::kSampler) {
+        addSampler(voice, first, count, block.data());
+      } else {
+        addResonator(voice, first, count, block.data());
       }
-      sample += 0.35 * std::sin(kTwoPi * static_cast<double>(voice.frequency) * t);
-      mix_[frame] += sample * burst * envelope * (0.5 + 0.5 * excite);
+    }
+    if (!sink(block.data(), count)) {
+      return;
     }
   }
 }
 
-const std::vector<int16_t>& OfflineRenderer::finalize() {
+double OfflineRenderer::normalizeScale() const {
   double maxAbs = 0.0;
-  for (double v : mix_) {
-    maxAbs = std::max(maxAbs, std::abs(v));
-  }
+  renderBlocks(frames_, [&](const double* block, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      maxAbs = std::max(maxAbs, std::abs(block[i]));
+    }
+    return true;
+  });
   const double target = settings_.normalizeTarget;
-  const double scale = (maxAbs > 0.0) ? (target / maxAbs) : 0.0;
+  return (maxAbs > 0.0) ? (target / maxAbs) : 0.0;
+}
 
-  pcm16_.resize(mix_.size());
-  for (std::size_t i = 0; i < mix_.size(); ++i) {
-    const double scaled = mix_[i] * scale;
-    const auto quantized = static_cast<long>(std::lround(scaled * 32767.0));
-    pcm16_[i] = static_cast<int16_t>(std::clamp<long>(quantized, -32768L, 32767L));
-  }
+const std::vector<int16_t>& OfflineRenderer::finalize() {
+  const double scale = normalizeScale();
+  pcm16_.clear();
+  pcm16_.reserve(frames_);
+  renderBlocks(frames_, [&](const double* block, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const double scaled = block[i] * scale;
+      const auto quantized = static_cast<long>(std::lround(scaled * 32767.0));
+      pcm16_.push_back(static_cast<int16_t>(std::clamp<long>(quantized, -32768L, 32767L)));
+    }
+    return true;
+  });
   return pcm16_;
 }
 
-bool OfflineRenderer::exportWav(const std::string& path,
-                                std::uint32_t sampleRate,
-                                const std::vector<int16_t>& samples) {
-  if (path.empty() || sampleRate == 0 || samples.empty()) {
+bool OfflineRenderer::streamTo(WavStreamWriter& writer, std::size_t frames, std::size_t copies) const {
+  if (!writer.isOpen()) {
     return false;
   }
-
-  std::filesystem::path p(path);
-  if (p.has_parent_path()) {
-    std::error_code ec;
-    std::filesystem::create_directories(p.parent_path(), ec);
-    if (ec) {
-      return false;
+  // Pass one finds the peak, pass two renders the same blocks again and
+  // writes them; neither keeps more than a block.
+  const double scale = normalizeScale();
+  const std::size_t channels = copies > 0 ? copies : writer.channels();
+  std::array<double, 2048> chunk{};
+  std::size_t used = 0;
+  auto put = [&](double scaled) {
+    if (used + channels > chunk.size()) {
+      if (!writer.writeNormalized(chunk.data(), used)) {
+        return false;
+      }
+      used = 0;
     }
+    for (std::size_t ch = 0; ch < channels; ++ch) {
+      chunk[used++] = scaled;
+    }
+    return true;
+  };
+  bool ok = true;
+  renderBlocks(std::min(frames, frames_), [&](const double* block, std::size_t count) {
+    for (std::size_t i = 0; i < count && ok; ++i) {
+      ok = put(block[i] * scale);
+    }
+    return ok;
+  });
+  // Silence past the end of the mix.
+  for (std::size_t frame = frames_; frame < frames && ok; ++frame) {
+    ok = put(0.0);
   }
+  return ok && (used == 0 || writer.writeNormalized(chunk.data(), used));
+}
 
-  std::ofstream out(p, std::ios::binary);
-  if (!out) {
+bool OfflineRenderer::exportWav(const std::string& path,
+                                std::uint32_t sampleRate,
+                                const std::vector<int16_t>& samples) {
+  if (samples.empty()) {
     return false;
   }
-
-  const std::uint16_t kChannels = 1;
-  const std::uint16_t kBitsPerSample = 16;
-  const std::uint32_t dataBytes = static_cast<std::uint32_t>(samples.size() * sizeof(std::int16_t));
-  const std::uint32_t byteRate = sampleRate * kChannels * (kBitsPerSample / 8);
-  const std::uint16_t blockAlign = static_cast<std::uint16_t>(kChannels * (kBitsPerSample / 8));
-
-  writeTag(out, "RIFF");
-  writeLittleEndian(out, static_cast<std::uint32_t>(36u + dataBytes));
-  writeTag(out, "WAVE");
-  writeTag(out, "fmt ");
-  writeLittleEndian(out, static_cast<std::uint32_t>(16u));
-  writeLittleEndian(out, static_cast<std::uint16_t>(1u));
-  writeLittleEndian(out, kChannels);
-  writeLittleEndian(out, sampleRate);
-  writeLittleEndian(out, byteRate);
-  writeLittleEndian(out, blockAlign);
-  writeLittleEndian(out, kBitsPerSample);
-  writeTag(out, "data");
-  writeLittleEndian(out, dataBytes);
-  out.write(reinterpret_cast<const char*>(samples.data()), dataBytes);
-  return out.good();
+  WavStreamWriter writer;
+  if (!writer.open(path, sampleRate, 1)) {
+    return false;
+  }
+  const bool wrote = writer.writePcm16(samples.data(), samples.size());
+  return writer.close() && wrote;
 }
 
 bool OfflineRenderer::exportJson(const std::string& path, const std::string& payload) {
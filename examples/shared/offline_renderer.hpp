@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -7,6 +8,8 @@
 
 #include "Seed.h"
 
+#include "wav_stream_writer.hpp"
+
 namespace offline {
 
 struct RenderSettings {
@@ -26,6 +29,12 @@ struct ResonatorEvent {
   std::uint32_t whenSamples = 0;
 };
 
+// The renderer never holds the mix.  mix*Events() only record each voice the
+// engines allocated; samples are synthesised block by block whenever a caller
+// asks for them.  Every voice is a closed-form function of time, so the same
+// frame always comes out bit for bit the same, and peak normalisation can
+// afford two passes: one to find the peak, one to write.  Memory follows the
+// number of voices, not the length of the take.
 class OfflineRenderer {
  public:
   explicit OfflineRenderer(RenderSettings settings = {});
@@ -33,9 +42,19 @@ class OfflineRenderer {
   void reset();
   void mixSamplerEvents(const std::vector<SamplerEvent>& events);
   void mixResonatorEvents(const std::vector<ResonatorEvent>& events);
+  // The whole mix as 16-bit PCM.  Short fixtures only: the result is one
+  // sample per frame.
   const std::vector<int16_t>& finalize();
+  // Normalise and quantise exactly `frames` frames of the mix straight into an
+  // open writer (silence past the end of the mix).  Each mix frame is written
+  // `copies` times, which defaults to the writer's channel count.  For 16-bit
+  // output the payload matches finalize() sample for sample.  Long takes use
+  // this: it holds one render block, however long the take.
+  bool streamTo(WavStreamWriter& writer, std::size_t frames, std::size_t copies = 0) const;
 
-  const std::vector<double>& mixBuffer() const { return mix_; }
+  // Length of the mix so far: the requested frames, or longer if a voice's
+  // tail ran past them.
+  std::size_t frames() const { return frames_; }
   double sampleRate() const { return settings_.sampleRate; }
 
   static bool exportWav(const std::string& path,
@@ -44,11 +63,49 @@ class OfflineRenderer {
   static bool exportJson(const std::string& path, const std::string& payload);
 
  private:
-  void ensureBuffer(std::size_t framesNeeded);
+  static constexpr std::size_t kBlockFrames = 4096;
+
+  // Everything needed to synthesise one voice, copied out of the engine's
+  // VoiceState at mix time.  `end` is the mix length when the voice was
+  // added (later calls that lengthen the mix do not extend earlier voices),
+  // clipped to where the voice goes silent for good.
+  struct Voice {
+    enum class Kind : std::uint8_t { kSampler, kResonator };
+    Kind kind = Kind::kSampler;
+    std::size_t start = 0;
+    std::size_t end = 0;
+    double frequency = 0.0;
+    // Sampler.
+    double pan = 0.0;
+    double tone = 0.0;
+    double attack = 0.0;
+    double decay = 0.0;
+    double sustain = 0.0;
+    double release = 0.0;
+    double lifetime = 0.0;
+    bool sdGrit = false;
+    // Resonator.
+    double burstGain = 0.0;
+    double damping = 0.0;
+    double feedback = 0.0;
+    double burstEnd = 0.0;
+    std::array<double, 4> modalFrequencies{};
+    std::array<double, 4> modalGains{};
+  };
+
+  void ensureFrames(std::size_t framesNeeded);
+  // Sum of every voice over [first, first + count), added in the order the
+  // voices were mixed so each frame rounds exactly as a resident mix would.
+  template <typename Sink>
+  void renderBlocks(std::size_t frames, Sink&& sink) const;
+  void addSampler(const Voice& voice, std::size_t first, std::size_t count, double* out) const;
+  void addResonator(const Voice& voice, std::size_t first, std::size_t count, double* out) const;
+  double normalizeScale() const;
 
  private:
   RenderSettings settings_;
-  std::vector<double> mix_;
+  std::size_t frames_ = 0;
+  std::vector<Voice> voices_;
   std::vector<int16_t> pcm16_;
 };
 
@@ -0,0 +1,335 @@
+#pragma once
+
+// Chunked WAV writer for long offline takes.
+//
+// The first WAV exporters in this repo took the whole take as one vector, wrote
+// it, and then walked it a second time to hash it for the golden manifest.  For
+// a 30-second fixture that's fine; for a multi-hour soak it means the entire
+// take sits in RAM twice over.  WavStreamWriter flips that around:
+// - `open()` writes a placeholder header,
+// - `write*()` calls encode samples into a small fixed buffer, flush it to disk
+//   whenever it fills, and fold the same bytes into a running FNV-1a hash,
+// - `close()` flushes the tail and seeks back to patch the RIFF/data sizes.
+// Memory stays at one chunk no matter how long the take runs, and the payload
+// is only touched once.
+//
+// The hash covers the data chunk payload only (no header), byte for byte as it
+// lands on disk.  For 16-bit PCM that is exactly what `golden::hash_pcm16`
+// hashes, so streamed fixtures keep their existing manifest entries.
+//
+// Plain RIFF caps the file at 4 GiB.  Writes that would cross that line fail
+// instead of wrapping the size fields, so a too-long take is an error rather
+// than a corrupt file.  At 48 kHz stereo 16-bit that's a little over six hours.
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace offline {
+
+// 64-bit FNV-1a, fed incrementally.  Same constants as the golden helpers.
+class Fnv1a64 {
+ public:
+  static constexpr std::uint64_t kOffset = 1469598103934665603ull;
+  static constexpr std::uint64_t kPrime = 1099511628211ull;
+
+  void update(const unsigned char* bytes, std::size_t count) {
+    std::uint64_t state = state_;
+    for (std::size_t i = 0; i < count; ++i) {
+      state ^= static_cast<std::uint64_t>(bytes[i]);
+      state *= kPrime;
+    }
+    state_ = state;
+  }
+
+  void update(std::string_view bytes) {
+    update(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+  }
+
+  void reset() { state_ = kOffset; }
+  std::uint64_t value() const { return state_; }
+
+  // 16 lowercase hex digits, the format golden.json stores.
+  std::string hex() const {
+    std::ostringstream oss;
+    oss << std::hex << std::nouppercase << std::setfill('0') << std::setw(16) << state_;
+    return oss.str();
+  }
+
+ private:
+  std::uint64_t state_ = kOffset;
+};
+
+enum class WavSampleFormat : std::uint8_t { kPcm16, kPcm24, kFloat32 };
+
+class WavStreamWriter {
+ public:
+  // Bytes buffered between disk writes.  A multiple of 2, 3 and 4 so a sample
+  // never straddles a flush.
+  static constexpr std::size_t kChunkBytes = 12288;
+
+  WavStreamWriter() = default;
+  ~WavStreamWriter() { close(); }
+
+  WavStreamWriter(const WavStreamWriter&) = delete;
+  WavStreamWriter& operator=(const WavStreamWriter&) = delete;
+
+  // Create parent directories, truncate `path`, and write a header whose size
+  // fields get patched by close().
+  bool open(const std::string& path,
+            std::uint32_t sampleRate,
+            std::uint16_t channels,
+            WavSampleFormat format = WavSampleFormat::kPcm16) {
+    close();
+    failed_ = false;
+    samples_ = 0;
+    dataBytes_ = 0;
+    used_ = 0;
+    hash_.reset();
+    if (path.empty() || sampleRate == 0 || channels == 0) {
+      return false;
+    }
+
+    std::filesystem::path p(path);
+    if (p.has_parent_path()) {
+      std::error_code ec;
+      std::filesystem::create_directories(p.parent_path(), ec);
+      if (ec) {
+        return false;
+      }
+    }
+    out_.open(p, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+      return false;
+    }
+
+    format_ = format;
+    channels_ = channels;
+    const std::uint16_t bytesPerSample = sampleBytes();
+    const bool isFloat = format_ == WavSampleFormat::kFloat32;
+
+    putTag("RIFF");
+    putLe(static_cast<std::uint32_t>(0));  // patched
+    putTag("WAVE");
+    putTag("fmt ");
+    // Float files carry the cbSize field and a fact chunk, as the spec asks
+    // for non-PCM formats.
+    putLe(static_cast<std::uint32_t>(isFloat ? 18u : 16u));
+    putLe(static_cast<std::uint16_t>(isFloat ? 3u : 1u));
+    putLe(channels_);
+    putLe(sampleRate);
+    putLe(static_cast<std::uint32_t>(sampleRate * channels_ * bytesPerSample));
+    putLe(static_cast<std::uint16_t>(channels_ * bytesPerSample));
+    putLe(static_cast<std::uint16_t>(bytesPerSample * 8u));
+    if (isFloat) {
+      putLe(static_cast<std::uint16_t>(0u));
+      putTag("fact");
+      putLe(static_cast<std::uint32_t>(4u));
+      factOffset_ = static_cast<std::uint32_t>(out_.tellp());
+      putLe(static_cast<std::uint32_t>(0u));  // patched
+    }
+    putTag("data");
+    dataSizeOffset_ = static_cast<std::uint32_t>(out_.tellp());
+    putLe(static_cast<std::uint32_t>(0u));  // patched
+    headerBytes_ = static_cast<std::uint32_t>(out_.tellp());
+    open_ = out_.good();
+    return open_;
+  }
+
+  // Interleaved 16-bit samples.  Bit-exact for kPcm16; other formats widen
+  // them the way a DAW would (x / 32768).
+  bool writePcm16(const std::int16_t* samples, std::size_t count) {
+    if (!reserve(count)) {
+      return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      switch (format_) {
+        case WavSampleFormat::kPcm16:
+          pushPcm16(samples[i]);
+          break;
+        case WavSampleFormat::kPcm24:
+          pushPcm24(static_cast<std::int32_t>(samples[i]) * 256);
+          break;
+        case WavSampleFormat::kFloat32:
+          pushFloat(static_cast<float>(samples[i]) / 32768.0f);
+          break;
+      }
+    }
+    samples_ += count;
+    return true;
+  }
+
+  // Interleaved samples in [-1, 1] (float or double).  PCM formats quantise
+  // with lround(x * full scale) and clamp, the same rounding
+  // OfflineRenderer::finalize() uses, so streaming a mix reproduces the
+  // buffered export byte for byte.
+  template <typename Sample>
+  bool writeNormalized(const Sample* samples, std::size_t count) {
+    if (!reserve(count)) {
+      return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      const double x = static_cast<double>(samples[i]);
+      switch (format_) {
+        case WavSampleFormat::kPcm16: {
+          const long q = std::lround(x * 32767.0);
+          pushPcm16(static_cast<std::int16_t>(std::clamp<long>(q, -32768L, 32767L)));
+          break;
+        }
+        case WavSampleFormat::kPcm24: {
+          const long q = std::lround(x * 8388607.0);
+          pushPcm24(static_cast<std::int32_t>(std::clamp<long>(q, -8388608L, 8388607L)));
+          break;
+        }
+        case WavSampleFormat::kFloat32:
+          pushFloat(static_cast<float>(x));
+          break;
+      }
+    }
+    samples_ += count;
+    return true;
+  }
+
+  // Flush, pad the data chunk to an even length, and patch the header.  Safe
+  // to call twice; the destructor calls it for you.  Returns false if any
+  // write along the way failed or the take ended mid-frame.
+  bool close() {
+    if (!open_) {
+      return false;
+    }
+    open_ = false;
+    flush();
+    if (dataBytes_ % 2u != 0u) {
+      out_.put('\0');  // RIFF pad byte; not part of the data size or the hash
+    }
+    const std::uint64_t fileBytes = headerBytes_ + dataBytes_ + (dataBytes_ % 2u);
+    out_.seekp(4);
+    putLe(static_cast<std::uint32_t>(fileBytes - 8u));
+    out_.seekp(dataSizeOffset_);
+    putLe(static_cast<std::uint32_t>(dataBytes_));
+    if (format_ == WavSampleFormat::kFloat32) {
+      out_.seekp(factOffset_);
+      putLe(static_cast<std::uint32_t>(frames()));
+    }
+    const bool ok = out_.good() && !failed_ && samples_ % channels_ == 0u;
+    out_.close();
+    return ok;
+  }
+
+  bool isOpen() const { return open_; }
+  std::uint16_t channels() const { return channels_; }
+  WavSampleFormat format() const { return format_; }
+  std::uint64_t samplesWritten() const { return samples_; }
+  std::uint64_t frames() const { return channels_ ? samples_ / channels_ : 0u; }
+  std::uint64_t dataBytes() const { return dataBytes_ + used_; }
+  // Hash of every payload byte handed over so far, including bytes still in
+  // the chunk buffer.
+  std::string hashHex() const {
+    Fnv1a64 pending = hash_;
+    pending.update(buffer_.data(), used_);
+    return pending.hex();
+  }
+
+ private:
+  // Leave room for the header and the pad byte under the 32-bit RIFF size.
+  static constexpr std::uint64_t kMaxDataBytes = 0xFFFFFFFFull - 64u;
+
+  std::uint16_t sampleBytes() const {
+    switch (format_) {
+      case WavSampleFormat::kPcm24:
+        return 3u;
+      case WavSampleFormat::kFloat32:
+        return 4u;
+      case WavSampleFormat::kPcm16:
+      default:
+        return 2u;
+    }
+  }
+
+  bool reserve(std::size_t count) {
+    if (!open_ || failed_) {
+      return false;
+    }
+    if (dataBytes() + static_cast<std::uint64_t>(count) * sampleBytes() > kMaxDataBytes) {
+      failed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  void pushPcm16(std::int16_t sample) {
+    const auto v = static_cast<std::uint16_t>(sample);
+    push(static_cast<unsigned char>(v & 0xFFu));
+    push(static_cast<unsigned char>((v >> 8u) & 0xFFu));
+  }
+
+  void pushPcm24(std::int32_t sample) {
+    const auto v = static_cast<std::uint32_t>(sample);
+    push(static_cast<unsigned char>(v & 0xFFu));
+    push(static_cast<unsigned char>((v >> 8u) & 0xFFu));
+    push(static_cast<unsigned char>((v >> 16u) & 0xFFu));
+  }
+
+  void pushFloat(float sample) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &sample, sizeof(bits));
+    for (unsigned shift = 0; shift < 32u; shift += 8u) {
+      push(static_cast<unsigned char>((bits >> shift) & 0xFFu));
+    }
+  }
+
+  void push(unsigned char byte) {
+    buffer_[used_++] = byte;
+    if (used_ == buffer_.size()) {
+      flush();
+    }
+  }
+
+  void flush() {
+    if (used_ == 0) {
+      return;
+    }
+    hash_.update(buffer_.data(), used_);
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(used_));
+    if (!out_) {
+      failed_ = true;
+    }
+    dataBytes_ += used_;
+    used_ = 0;
+  }
+
+  void putTag(const char (&tag)[5]) { out_.write(tag, 4); }
+
+  template <typename T>
+  void putLe(T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      out_.put(static_cast<char>((static_cast<std::uint64_t>(value) >> (8u * i)) & 0xFFu));
+    }
+  }
+
+  std::ofstream out_;
+  std::array<unsigned char, kChunkBytes> buffer_{};
+  std::size_t used_ = 0;
+  Fnv1a64 hash_;
+  std::uint64_t samples_ = 0;
+  std::uint64_t dataBytes_ = 0;
+  std::uint32_t headerBytes_ = 0;
+  std::uint32_t dataSizeOffset_ = 0;
+  std::uint32_t factOffset_ = 0;
+  std::uint16_t channels_ = 1;
+  WavSampleFormat format_ = WavSampleFormat::kPcm16;
+  bool open_ = false;
+  bool failed_ = false;
+};
+
+}  // namespace offline
@@ -30,11 +30,21 @@ struct PresetClockSettings {
   bool transportLatch{false};
 };
 
+// Quantize settings ride along so a scene can bring its own scale.  The mask
+// uses the ScaleQuantizer layout (bit n = n semitones above the root); zero
+// means the scene did not define a custom scale.
+struct PresetQuantizeSettings {
+  std::uint8_t scaleIndex{0};
+  std::uint8_t root{0};
+  std::uint16_t scaleMask{0};
+};
+
 struct Preset {
   std::string slot;              // human-facing preset label / storage key
   std::uint32_t masterSeed{0};
   std::uint8_t focusSeed{0};
   PresetClockSettings clock{};
+  PresetQuantizeSettings quantize{};
   std::vector<Seed> seeds{};
   std::vector<std::uint8_t> engineSelections{};
   PageId page{PageId::kSeeds};
@@ -28,6 +28,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace hal {
@@ -100,6 +101,43 @@ void nativeBoardSetButton(Board::ButtonID id, bool pressed);
 // simulator uses this to feed the front-panel USB menu without speaking to
 // hardware.
 std::vector<std::string> nativeEnumerateControllers();
+
+// Compiled panel scripts.  `nativeBoardFeed()` queues one line at a time and
+// lets poll() chew through it in 10 ms steps, which is fine for a few presses
+// but crawls through hour-long soak scenarios.  A NativeScript is the same DSL
+// compiled once into a flat timeline sorted by absolute time, so a runner can
+// jump the clock straight to each event.  On top of `btn`, `enc` and `wait` the
+// compiler understands:
+//   at 1500ms        -- move the script cursor to an absolute time
+//   repeat 600 / end -- unroll the enclosed lines N times (nesting allowed)
+// Time units: us, ms (default), s, min, h.
+struct NativeScriptEvent {
+  enum class Type : std::uint8_t { Button, Encoder };
+  std::uint64_t at_us{0};  // offset from the moment the script is loaded
+  Type type{Type::Button};
+  Board::ButtonID button{Board::ButtonID::TapTempo};
+  bool pressed{false};
+  Board::EncoderID encoder{Board::EncoderID::SeedBank};
+  std::int32_t delta{0};
+};
+
+struct NativeScript {
+  std::vector<NativeScriptEvent> events;
+  std::uint64_t duration_us{0};  // where the cursor ended, including trailing waits
+};
+
+// Returns false (and a "line N: ..." message) on malformed input; `out` is
+// left untouched in that case.
+bool compileNativeScript(std::string_view text, NativeScript& out, std::string* error = nullptr);
+bool loadNativeScriptFile(const std::string& path, NativeScript& out, std::string* error = nullptr);
+// Arm the board with a compiled timeline anchored at the current board time.
+void nativeBoardLoadScript(const NativeScript& script);
+// Absolute board time of the next timeline event, or UINT64_MAX when done.
+std::uint64_t nativeBoardNextEventMicros();
+// Jump the board clock to `micros` and apply every timeline event due by then,
+// each stamped with its own scheduled time.  The first call hands the clock to
+// the caller: poll() stops adding its 10 ms step until nativeBoardReset().
+void nativeBoardAdvanceTo(std::uint64_t micros);
 #endif
 
 }  // namespace hal
@@ -33,6 +33,12 @@ public:
   // Persist a preset blob.  Implementations decide where it lands; callers
   // should treat a false return as "nope, storage stayed untouched".
   virtual bool save(std::string_view slot, const std::vector<std::uint8_t>& data) = 0;
+
+  // Moves on every successful save to the medium behind this store, through
+  // this handle or any other one.  Caches compare it with the value they last
+  // saw to notice writes they did not make.  Backends with nothing shared
+  // underneath can keep the default.
+  virtual std::uint32_t generation() const { return 0; }
 };
 
 // Null backend: always empty, never writes.  Handy for tests that want to
@@ -55,6 +61,11 @@ public:
   std::vector<std::string> list() const override;
   bool load(std::string_view slot, std::vector<std::uint8_t>& out) const override;
   bool save(std::string_view slot, const std::vector<std::uint8_t>& data) override;
+  std::uint32_t generation() const override { return generation_; }
+
+  // The one EEPROM the board has.  AppState and the legacy Storage helpers
+  // both use it, so a scene saved through either is what the other reads.
+  static StoreEeprom& board();
 
 private:
   struct Entry {
@@ -71,6 +82,8 @@ private:
 #if !SEEDBOX_HW
   mutable std::vector<std::uint8_t> mockEeprom_{};
 #endif
+  // Shared by every instance: on hardware they all front the same chip.
+  static inline std::uint32_t generation_{0};
 };
 
 // Optional SD card backend.  On hardware we expect an SD card mounted via the
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "app/AppState.h"
 #include "app/UiState.h"
+#include "ui/TextFrame.h"
 
 namespace ui {
 
@@ -16,9 +18,22 @@ public:
   bool hasFrames() const { return !frames_.empty(); }
   const std::string& latest() const { return frames_.back(); }
 
+  // Bus accounting that mirrors OledView: what the partial refresh of the last
+  // frame would have sent, the running total, and what the same frames would
+  // have cost as full-panel redraws.
+  std::size_t lastFlushBytes() const { return lastFlushBytes_; }
+  std::size_t totalFlushBytes() const { return totalFlushBytes_; }
+  std::size_t totalFullFlushBytes() const { return totalFullFlushBytes_; }
+  const FrameDiff& lastDiff() const { return lastDiff_; }
+
 private:
   bool log_{true};
   std::vector<std::string> frames_{};
+  TextFrame rendered_{};
+  FrameDiff lastDiff_{};
+  std::size_t lastFlushBytes_{0};
+  std::size_t totalFlushBytes_{0};
+  std::size_t totalFullFlushBytes_{0};
 };
 
 }  // namespace ui
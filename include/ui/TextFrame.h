@@ -7,7 +7,16 @@
 // exact same pixels.  `TextFrame` captures that layout as a fixed set of 16-char
 // lines so we can diff frames in tests and trust that the SH1107 panel will see
 // the same content.
+//
+// The frame also knows how to diff itself.  `DiffTextFrames` reports, per line,
+// the run of character columns that changed, and the geometry helpers below
+// turn that into the pixel rectangles and SH1107 bytes a partial refresh would
+// cost.  The hardware view uses them to redraw only what moved; the ASCII view
+// uses them to count the bytes it *would* have sent, so tests can prove the
+// savings on Linux.
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include "app/AppState.h"
 #include "app/UiState.h"
 
@@ -19,9 +28,58 @@ struct TextFrame {
   std::size_t lineCount{0};
 };
 
+// Panel geometry shared by every renderer: 6-pixel glyph cells on 10-pixel
+// rows, on a 128x64 SH1107 that is written in 8-row pages.
+namespace oled {
+constexpr std::int16_t kPanelWidth = 128;
+constexpr std::int16_t kPanelHeight = 64;
+constexpr std::int16_t kGlyphWidth = 6;
+constexpr std::int16_t kLineHeight = 10;
+constexpr std::int16_t kStatusInsetY = 1;
+constexpr std::int16_t kPageHeight = 8;
+// Page address plus the two column-address nibbles sent before each page run.
+constexpr std::size_t kPageCommandBytes = 3;
+}  // namespace oled
+
+// Changed cells between two frames, at most one span per line.
+struct FrameDiff {
+  struct Span {
+    std::uint8_t line{0};
+    // Character columns [firstColumn, endColumn) differ.
+    std::uint8_t firstColumn{0};
+    std::uint8_t endColumn{0};
+    // The inverted status bar appeared or vanished, so the whole row repaints.
+    bool fullWidth{false};
+  };
+
+  std::array<Span, TextFrame::kMaxLines> spans{};
+  std::size_t spanCount{0};
+
+  bool empty() const { return spanCount == 0; }
+};
+
+struct PixelRect {
+  std::int16_t x{0};
+  std::int16_t y{0};
+  std::int16_t w{0};
+  std::int16_t h{0};
+};
+
 TextFrame ComposeTextFrame(const AppState::DisplaySnapshot& snapshot, const UiState& state);
 bool operator==(const TextFrame& a, const TextFrame& b);
 inline bool operator!=(const TextFrame& a, const TextFrame& b) { return !(a == b); }
 
+// Lines past a frame's `lineCount` read as blank, so dropped lines show up as
+// spans that need clearing.
+FrameDiff DiffTextFrames(const TextFrame& before, const TextFrame& after);
+// Panel rectangle covered by a span, clipped to the panel.
+PixelRect SpanRect(const FrameDiff::Span& span);
+// Bytes an SH1107 refresh of `rect` puts on the bus: the page commands plus
+// one data byte per column for every page the rectangle touches.
+std::size_t FlushBytes(const PixelRect& rect);
+std::size_t FlushBytes(const FrameDiff& diff);
+// What the old clear-and-redraw path paid for every change.
+std::size_t FullFlushBytes();
+
 }  // namespace ui
 
@@ -1,20 +1,29 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
 
 namespace util {
 
+// Which way a pitch is allowed to move when it lands between scale degrees.
+enum class QuantizerMode { kNearest, kUp, kDown };
+
 //
 // ScaleQuantizer
 // --------------
 // Helpers that snap arbitrary semitone offsets back onto musical scales. These
 // live in util/ so both the UI layer and the engines can reach for the same
 // math when a performer slaps the Quantize control. We expose three variants:
-// nearest-note snapping, force-up, and force-down. All of them work with the
-// same tiny Scale enum so classroom demos can focus on ear training instead of
-// bit masks.
+// nearest-note snapping, force-up, and force-down.
+//
+// Under the hood every scale is a 12-bit mask: bit n set means "n semitones
+// above the root is in the scale" (so major is 0b1010'1011'0101).  A mask gets
+// compiled once into a Table holding, for every root and every pitch class, the
+// distance down and up to the closest scale member.  A snap is then a floor, a
+// table lookup, and a fractional correction — no degree lists, no octave scan.
+// The tiny Scale enum stays around so classroom demos can focus on ear
+// training instead of bit masks.
 class ScaleQuantizer {
 public:
   enum class Scale : std::uint8_t {
@@ -25,14 +34,61 @@ public:
     kPentatonicMinor,
   };
 
+  using Mask = std::uint16_t;
+  static constexpr Mask kChromaticMask = 0x0FFF;
+
+  static constexpr Mask MaskFor(Scale scale) {
+    switch (scale) {
+      case Scale::kMajor:
+        return 0x0AB5;  // 0 2 4 5 7 9 11
+      case Scale::kMinor:
+        return 0x05AD;  // 0 2 3 5 7 8 10
+      case Scale::kPentatonicMajor:
+        return 0x0295;  // 0 2 4 7 9
+      case Scale::kPentatonicMinor:
+        return 0x04A9;  // 0 3 5 7 10
+      case Scale::kChromatic:
+      default:
+        return kChromaticMask;
+    }
+  }
+
+  // A compiled scale.  Bits above 11 are ignored; an empty mask has nothing to
+  // snap to, so it passes pitches through untouched.  288 bytes, cheap to copy
+  // and cheap to rebuild when a preset loads a new mask.
+  class Table {
+  public:
+    Table() : Table(kChromaticMask) {}
+    explicit Table(Mask mask);
+
+    Mask mask() const { return mask_; }
+    float snap(float semitoneOffset, std::uint8_t root, QuantizerMode mode) const;
+
+    // Snap `n` pitches in one go.  The mode and root are resolved once for the
+    // whole block so the inner loop is just lookups and selects.  `in` and
+    // `out` may point at the same buffer.
+    void quantizeBlock(const float* in, float* out, std::size_t n, std::uint8_t root,
+                       QuantizerMode mode) const;
+
+  private:
+    using Row = std::array<std::uint8_t, 12>;
+
+    Mask mask_{0};
+    // Indexed [root][absolute pitch class].
+    std::array<Row, 12> down_{};
+    std::array<Row, 12> up_{};
+  };
+
   static float SnapToScale(float semitoneOffset, std::uint8_t root, Scale scale);
   static float SnapUp(float semitoneOffset, std::uint8_t root, Scale scale);
   static float SnapDown(float semitoneOffset, std::uint8_t root, Scale scale);
 
-private:
-  static float Snap(float semitoneOffset, std::uint8_t root, Scale scale, int direction);
-  static const std::vector<int>& DegreesFor(Scale scale);
+  // Batch flavour of the helpers above for the built-in scales.
+  static void QuantizeBlock(const float* in, float* out, std::size_t n, std::uint8_t root, Scale scale,
+                            QuantizerMode mode);
+
+  // The shared, pre-built table for one of the built-in scales.
+  static const Table& TableFor(Scale scale);
 };
 
 }  // namespace util
-
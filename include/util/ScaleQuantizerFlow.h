@@ -9,8 +9,6 @@
 
 namespace util {
 
-enum class QuantizerMode { kNearest, kUp, kDown };
-
 const char* ToString(QuantizerMode mode);
 
 struct QuantizerSample {
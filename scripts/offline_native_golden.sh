@@ -14,6 +14,14 @@
 #                      Example: --input-tone a4=440:0.35:2.0
 #   --skip-manifest    Rebuild fixtures but leave tests/native_golden/golden.json
 #                      untouched. Handy when you just want WAVs on disk.
+#   --changed-only     Quiet run: only fixtures whose inputs changed are
+#                      re-rendered and reported, then one summary line lists
+#                      them. Cached fixtures are restored silently.
+#   --no-cache         Ignore build/golden-cache/ and re-render everything.
+#
+# Fixture renders are cached under build/golden-cache/, keyed by a hash of the
+# fixture definition, its recipe revision, and the engine sources it compiles
+# against. Unchanged fixtures are restored from the cache instead of rendered.
 #
 # Requirements: g++, Python 3. This script compiles tools/native_golden_offline.cpp
 # against the same engine sources the PlatformIO suite uses, emits fresh
@@ -29,6 +37,8 @@ BINARY="${BUILD_DIR}/native_golden_offline"
 FILTERS=()
 INPUT_TONES=()
 REFRESH_MANIFEST=1
+CHANGED_ONLY=0
+USE_CACHE=1
 
 while [[ $# -gt 0 ]]; do
   case "$1" in
@@ -48,6 +58,14 @@ while [[ $# -gt 0 ]]; do
       REFRESH_MANIFEST=0
       shift
       ;;
+    --changed-only)
+      CHANGED_ONLY=1
+      shift
+      ;;
+    --no-cache)
+      USE_CACHE=0
+      shift
+      ;;
     --input-tone)
       if [[ $# -lt 2 ]]; then
         echo "error: --input-tone flag requires an argument" >&2
@@ -87,6 +105,9 @@ if [[ ${#INPUT_TONES[@]} -gt 0 ]]; then
   export SEEDBOX_OFFLINE_GOLDEN_INPUT_TONES="${INPUT_TONE_VALUE}"
 fi
 
+export SEEDBOX_OFFLINE_GOLDEN_CHANGED_ONLY="${CHANGED_ONLY}"
+export SEEDBOX_OFFLINE_GOLDEN_CACHE="${USE_CACHE}"
+
 mkdir -p "${BUILD_DIR}"
 
 CXXFLAGS=(
@@ -108,6 +129,7 @@ SOURCES=(
   tools/native_golden_offline.cpp
   examples/shared/offline_renderer.cpp
   tests/native_golden/wav_helpers.cpp
+  tests/native_golden/golden_cache.cpp
   src/hal/board_native.cpp
   src/hal/hal_audio.cpp
   src/hal/hal_io.cpp
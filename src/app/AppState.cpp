@@ -9,6 +9,7 @@
 #include "app/AppState.h"
 #include "app/AppUiClockService.h"
 #include "app/AudioRuntimeState.h"
+#include "app/ControlJournal.h"
 #include "app/DisplayTelemetryService.h"
 #include "app/DisplaySnapshotBuilder.h"
 #include "app/GateQuantizeService.h"
@@ -72,6 +73,41 @@ constexpr hal::io::PinNumber kReseedButtonPin = 2;
 constexpr hal::io::PinNumber kLockButtonPin = 3;
 constexpr hal::io::PinNumber kStatusLedPin = 13;
 
+using JournalKind = ControlJournal::Kind;
+using JournalScope = ControlJournal::Scope;
+
+ControlJournal::Event journalEvent(JournalKind kind, uint8_t a = 0, uint8_t b = 0, uint8_t c = 0,
+                                   std::uint64_t value = 0) {
+  ControlJournal::Event event{};
+  event.kind = kind;
+  event.a = a;
+  event.b = b;
+  event.c = c;
+  event.value = value;
+  return event;
+}
+
+// Set while an audio entry point (handleAudio, tickHostAudio) runs on this
+// thread, so everything it calls counts journal depth on the audio counter.
+// On hardware the audio callback is an interrupt that runs to completion, so a
+// plain flag already reads false from the main loop.
+#if SEEDBOX_HW
+bool gOnAudioPath = false;
+#else
+thread_local bool gOnAudioPath = false;
+#endif
+
+class AudioPathMark {
+public:
+  AudioPathMark() : previous_(gOnAudioPath) { gOnAudioPath = true; }
+  ~AudioPathMark() { gOnAudioPath = previous_; }
+  AudioPathMark(const AudioPathMark&) = delete;
+  AudioPathMark& operator=(const AudioPathMark&) = delete;
+
+private:
+  bool previous_;
+};
+
 const std::array<hal::io::DigitalConfig, 3> kFrontPanelPins{{
     {kReseedButtonPin, true, true},
     {kLockButtonPin, true, true},
@@ -222,6 +258,17 @@ EnergyProbe measureEnergy(const float* left, const float* right, std::size_t fra
   return probe;
 }
 
+// Raw sum of squares over both channels; handleAudio() diffs it around each
+// engine's render to see how much energy that engine added.
+double bufferSumSquares(const float* left, const float* right, std::size_t frames) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < frames; ++i) {
+    sum += static_cast<double>(left[i]) * static_cast<double>(left[i]);
+    sum += static_cast<double>(right[i]) * static_cast<double>(right[i]);
+  }
+  return sum;
+}
+
 bool bufferClipDetected(const float* left, const float* right, std::size_t frames) {
   if (!left || frames == 0) {
     return false;
@@ -283,14 +330,7 @@ seedbox::io::Store* ensureStore(seedbox::io::Store* current) {
   if (current) {
     return current;
   }
-
-#if SEEDBOX_HW
-  static seedbox::io::StoreEeprom hwStore;
-  return &hwStore;
-#else
-  static seedbox::io::StoreEeprom simStore(4096);
-  return &simStore;
-#endif
+  return &seedbox::io::StoreEeprom::board();
 }
 }
 
@@ -332,7 +372,7 @@ void AppState::digitalCallbackThunk(hal::io::PinNumber pin, bool level, std::uin
 // students can run the simulator on a laptop and trust that the Teensy build
 // behaves the same.
 void AppState::initHardware() {
-  store_ = ensureStore(store_);
+  attachStore(ensureStore(store_));
 #if SEEDBOX_HW
   // Lock in the entire audio buffer pool before any engine spins up. We slam
   // all four line items from AudioMemoryBudget into one call so individual
@@ -354,7 +394,7 @@ void AppState::initHardware() {
 // rest of the wiring is identical so deterministic behaviour survives unit
 // tests and lecture demos.
 void AppState::initSim() {
-  store_ = ensureStore(store_);
+  attachStore(ensureStore(store_));
   #if !SEEDBOX_HW
   const auto teachingPreset = loadTeachingPresetForSim();
 #endif
@@ -372,7 +412,7 @@ void AppState::initSim() {
 
 #if !SEEDBOX_HW
 void AppState::initJuceHost(float sampleRate, std::size_t framesPerBlock) {
-  store_ = ensureStore(store_);
+  attachStore(ensureStore(store_));
   configureMidiRouting();
   hal::audio::init(&AppState::audioCallbackTrampoline, this);
   hal::audio::configureHostStream(sampleRate, framesPerBlock);
@@ -470,6 +510,20 @@ void AppState::bootRuntime(EngineRouter::Mode mode, bool hardwareMode) {
   populateSdClips(engines_.granular());
   engines_.resonator().setMaxVoices(hardwareMode ? 10 : 4);
   engines_.resonator().setDampingRange(0.18f, 0.92f);
+  // The ceilings above are where each pool starts.  On the Teensy and inside
+  // a plugin host a late block is an audible dropout, so the governor may
+  // trade voices for time from here on.  The plain sim keeps fixed pools:
+  // its renders must not depend on how busy the build machine is.
+  voiceGovernorWanted_ = hardwareMode || audioRuntime_.hostAudioMode();
+  engines_.setVoiceGovernorEnabled(voiceGovernorWanted_ && journal_ == nullptr);
+  // A DAW can hand the plugin anything, and hot input through the saturators
+  // aliases at the base rate, so inside a host they run 2x oversampled.  The
+  // sim stays at the base rate so its renders match the golden fixtures.
+  const util::Oversampler::Quality saturation =
+      audioRuntime_.hostAudioMode() ? util::Oversampler::kRealtime : util::Oversampler::kBypass;
+  engines_.burst().setOversampling(saturation);
+  engines_.resonator().setOversampling(saturation);
+  audioRuntime_.setOutputOversampling(saturation);
   ClockProvider* provider = clockTransport_.followExternalClockEnabled() ? static_cast<ClockProvider*>(&midiClockIn_)
                                                                          : static_cast<ClockProvider*>(&internalClock_);
   selectClockProvider(provider);
@@ -494,7 +548,7 @@ void AppState::bootRuntime(EngineRouter::Mode mode, bool hardwareMode) {
   // Sample-clock wiring is repeated after reseed because the runtime may have
   // rebuilt the scheduler while deciding what kind of body it is booting into.
   scheduler_.setSampleClockFn(hardwareMode ? &hal::audio::sampleClock : nullptr);
-  captureDisplaySnapshot(displayCache_, uiStateCache_);
+  refreshDisplayCache();
   displayDirty_ = true;
   audioRuntime_.resetAudioCallbackCount();
   clearPresetCrossfade();
@@ -505,6 +559,7 @@ void AppState::bootRuntime(EngineRouter::Mode mode, bool hardwareMode) {
   storageButtonPressFrame_ = frame_;
   quantizeScaleIndex_ = 0;
   quantizeRoot_ = 0;
+  quantizeCustomScale_ = util::ScaleQuantizer::Table(0);
   mode_ = Mode::HOME;
   input_.clear();
   swingPageRequested_ = false;
@@ -512,13 +567,28 @@ void AppState::bootRuntime(EngineRouter::Mode mode, bool hardwareMode) {
   previousModeBeforeSwing_ = Mode::HOME;
   quantizeScaleIndex_ = 0;
   quantizeRoot_ = 0;
+  quantizeCustomScale_ = util::ScaleQuantizer::Table(0);
+}
+
+void AppState::attachControlJournal(ControlJournal* journal) {
+  journal_ = journal;
+  if (enginesReady_) {
+    engines_.setVoiceGovernorEnabled(voiceGovernorWanted_ && journal_ == nullptr);
+  }
 }
 
+uint32_t& AppState::journalDepth() { return gOnAudioPath ? audioJournalDepth_ : controlJournalDepth_; }
+
 void AppState::handleAudio(const hal::audio::StereoBufferView& buffer) {
   audioRuntime_.incrementAudioCallbackCount();
   if (!buffer.left || !buffer.right || buffer.frames == 0) {
     return;
   }
+  const AudioPathMark audioPath;
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kAudioBlock, 0, 0, 0, buffer.frames),
+                                  JournalScope::When::kOnExit);
+  const std::uint32_t renderStart = FlightRecorder::stamp();
 
   inputGate_.refreshFromDryInput(buffer.frames);
 
@@ -526,6 +596,18 @@ void AppState::handleAudio(const hal::audio::StereoBufferView& buffer) {
   const float* dryRightInput = inputGate_.dryRight(buffer.frames);
   Engine::RenderContext ctx{dryLeftInput, dryRightInput, buffer.left, buffer.right, buffer.frames};
 
+  // Feed the live-input capture ring before anything renders.  An input gate
+  // that just opened marks an onset at the start of this block, which is as
+  // close as a block-rate meter can place it.
+  if (inputGate_.hasDryInput()) {
+    const std::uint32_t onsets = inputGate_.onsetCount();
+    if (onsets != captureOnsetsSeen_) {
+      engines_.liveCapture().markOnset();
+      captureOnsetsSeen_ = onsets;
+    }
+    engines_.captureLiveInput(ctx);
+  }
+
   // The render contract is simple: every callback starts from silence, then the
   // engines, test tone, and optional passthrough layers earn their way in.
   // Start from silence, then let the engines (or a test tone) paint over the
@@ -539,11 +621,41 @@ void AppState::handleAudio(const hal::audio::StereoBufferView& buffer) {
     audioRuntime_.renderTestTone(buffer.left, buffer.right, buffer.frames, hal::audio::sampleRate());
   }
 
+  // Engines mix into the same buffer, so each one's contribution to the flight
+  // record is the energy it added on top of whatever was already there.  Cross
+  // terms between engines are ignored; this is a meter, not an analyser.
+  // Those passes walk the whole buffer after every engine, so they only run
+  // while the recorder's engine metering is on.
+  // The same checkpoints time each engine for the voice governor; the meter
+  // maths between two renders is kept off the engines' bills.
+  std::array<float, FlightRecorder::kEngineSlots> engineRms{};
+  VoiceGovernor::LaneNanos engineNanos{};
+  const bool meterEngines = flightRecorder_.engineMetering();
+  const double energyScale = 1.0 / (2.0 * static_cast<double>(buffer.frames));
+  double energyBefore = meterEngines ? bufferSumSquares(buffer.left, buffer.right, buffer.frames) : 0.0;
+  std::uint32_t engineStart = FlightRecorder::stamp();
+  auto noteEngineEnergy = [&](std::size_t slot) {
+    engineNanos[slot] = FlightRecorder::elapsedNanos(engineStart);
+    if (!meterEngines) {
+      engineStart = FlightRecorder::stamp();
+      return;
+    }
+    const double energyAfter = bufferSumSquares(buffer.left, buffer.right, buffer.frames);
+    const double added = energyAfter - energyBefore;
+    engineRms[slot] = added > 0.0 ? static_cast<float>(std::sqrt(added * energyScale)) : 0.0f;
+    energyBefore = energyAfter;
+    engineStart = FlightRecorder::stamp();
+  };
   engines_.sampler().renderAudio(ctx);
+  noteEngineEnergy(0);
   engines_.granular().renderAudio(ctx);
+  noteEngineEnergy(1);
   engines_.resonator().renderAudio(ctx);
+  noteEngineEnergy(2);
   engines_.euclid().renderAudio(ctx);
+  noteEngineEnergy(3);
   engines_.burst().renderAudio(ctx);
+  noteEngineEnergy(4);
 
 #if !SEEDBOX_HW
   if (inputGate_.hasDryInput() && !seeds_.empty()) {
@@ -568,6 +680,8 @@ void AppState::handleAudio(const hal::audio::StereoBufferView& buffer) {
   // the callback counter above so timing-sensitive tests can probe the audio
   // heartbeat without blasting speakers.
   if (enginesIdle) {
+    const std::uint32_t renderNanos = recordFlightBlock(buffer, renderStart, engineRms, false);
+    governVoices(renderNanos, buffer.frames, engineNanos);
     return;
   }
 #endif
@@ -605,9 +719,123 @@ void AppState::handleAudio(const hal::audio::StereoBufferView& buffer) {
   latestAudioMetrics_.combinedPeak = combinedEnergy.peak;
   latestAudioMetrics_.clip = bufferClipDetected(buffer.left, buffer.right, buffer.frames);
   latestAudioMetrics_.limiter = latestAudioMetrics_.clip;
+  const std::uint32_t renderNanos = recordFlightBlock(buffer, renderStart, engineRms, latestAudioMetrics_.clip);
+  // Ceilings move after the block is done, so the next trigger already sees
+  // the new pool size and nothing changes under a voice mid-render.
+  governVoices(renderNanos, buffer.frames, engineNanos);
+  if (journal_) {
+    journal_->noteAudioBlock(buffer.left, buffer.right, buffer.frames);
+  }
+}
+
+std::uint32_t AppState::blockBudgetNanos(std::size_t frames) {
+  const float sampleRate = hal::audio::sampleRate();
+  if (!(sampleRate > 0.0f)) {
+    return 0;
+  }
+  const double nanos = static_cast<double>(frames) * 1.0e9 / static_cast<double>(sampleRate);
+  return static_cast<std::uint32_t>(std::min(nanos, 4.0e9));
+}
+
+void AppState::governVoices(std::uint32_t renderNanos, std::size_t frames, VoiceGovernor::LaneNanos engineNanos) {
+  const std::uint32_t budget = blockBudgetNanos(frames);
+#if SEEDBOX_HW
+  // Sampler, granular and resonator voices are AudioStream nodes: the library
+  // updates them around our callback, so the checkpoints in handleAudio() only
+  // saw their control work.  Their cycle counts (and the library's total, which
+  // covers everything including this callback) are the real bill.  Both lag
+  // one update, which is fine for a smoothed governor.
+  auto nanosFor = [budget](float percent) {
+    return static_cast<std::uint32_t>(std::max(0.0f, percent) * 0.01f * static_cast<float>(budget));
+  };
+  engineNanos[EngineRouter::kSamplerId] += nanosFor(engines_.sampler().graphUsagePercent());
+  engineNanos[EngineRouter::kGranularId] += nanosFor(engines_.granular().graphUsagePercent());
+  engineNanos[EngineRouter::kResonatorId] += nanosFor(engines_.resonator().graphUsagePercent());
+  renderNanos = std::max(renderNanos, nanosFor(hal::audio::processorUsagePercent()));
+#endif
+  engines_.governVoices(renderNanos, budget, engineNanos);
+}
+
+std::uint32_t AppState::recordFlightBlock(const hal::audio::StereoBufferView& buffer, std::uint32_t renderStart,
+                                          const std::array<float, FlightRecorder::kEngineSlots>& engineRms,
+                                          bool clip) {
+  FlightRecorder::Record rec{};
+  rec.block = audioRuntime_.audioCallbackCount();
+  rec.frames = static_cast<std::uint32_t>(buffer.frames);
+  rec.engineRms = engineRms;
+  rec.outputPeak = latestAudioMetrics_.combinedPeak;
+  const std::uint64_t triggers = scheduler_.triggersFired();
+  // The scheduler is rebuilt on reseed/recall, which restarts its counter.
+  rec.triggersFired = static_cast<std::uint32_t>(triggers >= flightTriggersSeen_ ? triggers - flightTriggersSeen_ : triggers);
+  flightTriggersSeen_ = triggers;
+  const std::size_t burstQueued = engines_.burst().queuedHits();
+  rec.burstQueueDepth = static_cast<std::uint16_t>(burstQueued > 0xFFFFu ? 0xFFFFu : burstQueued);
+  if (clip) {
+    rec.flags |= FlightRecorder::kClip | FlightRecorder::kLimiter;
+  }
+  if (audioRuntime_.testToneEnabled()) {
+    rec.flags |= FlightRecorder::kTestTone;
+  }
+  if (waitingForExternalClock()) {
+    rec.clock = FlightRecorder::ClockSource::kWaiting;
+  } else if (externalClockDominant()) {
+    rec.clock = FlightRecorder::ClockSource::kExternal;
+  }
+  // Timing stops last so the bookkeeping above is charged to the block too.
+  rec.renderNanos = FlightRecorder::elapsedNanos(renderStart);
+  const std::uint32_t budgetNanos = blockBudgetNanos(buffer.frames);
+  if (budgetNanos > 0 && rec.renderNanos > budgetNanos) {
+    rec.flags |= FlightRecorder::kOverrun;
+  }
+  flightRecorder_.record(rec);
+  return rec.renderNanos;
+}
+
+void AppState::serviceFlightRecorderDump() {
+#if !SEEDBOX_HW
+  std::uint64_t triggerBlock = 0;
+  if (!flightRecorder_.takeDumpRequest(triggerBlock) || flightDumpDirectory_.empty()) {
+    return;
+  }
+  std::vector<FlightRecorder::Record> records;
+  flightRecorder_.snapshot(records);
+  FlightRecorder::DumpHeader header{};
+  header.sampleRate = hal::audio::sampleRate();
+  header.triggerBlock = triggerBlock;
+  const std::string path =
+      (std::filesystem::path(flightDumpDirectory_) / ("flight-" + std::to_string(triggerBlock) + ".sbfr")).string();
+  if (FlightRecorder::writeDumpFile(path, FlightRecorder::DumpFormat::kBinary, header, records)) {
+    lastFlightDumpPath_ = path;
+  }
+#endif
 }
 
+#if !SEEDBOX_HW
+bool AppState::dumpFlightRecorder(const std::string& path, FlightRecorder::DumpFormat format) const {
+  std::vector<FlightRecorder::Record> records;
+  flightRecorder_.snapshot(records);
+  FlightRecorder::DumpHeader header{};
+  header.sampleRate = hal::audio::sampleRate();
+  return FlightRecorder::writeDumpFile(path, format, header, records);
+}
+
+void AppState::setFlightRecorderAutoDumpDirectory(const std::string& directory) {
+  flightDumpDirectory_ = directory;
+  if (!directory.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+  }
+  flightRecorder_.setAutoDump(!directory.empty());
+  flightRecorder_.setEngineMetering(!directory.empty());
+}
+#endif
+
 void AppState::handleDigitalEdge(uint8_t pin, bool level, uint32_t timestamp) {
+  // Edges only ever arrive from inside hal::io::poll(), i.e. mid-tick, so they
+  // are journalled regardless of depth; replay queues them for the next poll.
+  if (journal_) {
+    journal_->append(journalEvent(JournalKind::kDigitalEdge, pin, level ? 1u : 0u, 0, timestamp));
+  }
   if (pin == kReseedButtonPin) {
     if (level) {
       // The reseed button is dual-purpose: outside Storage it arms a reseed;
@@ -683,6 +911,8 @@ void AppState::handleDigitalEdge(uint8_t pin, bool level, uint32_t timestamp) {
 // internal scheduler drive things when we own the transport, or just counts
 // frames so the OLED can display a ticking counter.
 void AppState::tick() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kTick),
+                                  JournalScope::When::kOnExit);
   // tick() is the civil service of the instrument. It polls physical state,
   // resolves pending gestures, advances whichever clock currently owns time,
   // and finally republishes the display snapshot.
@@ -726,18 +956,27 @@ void AppState::tick() {
     maybeCommitPendingPreset(scheduler_.ticks());
   }
   stepPresetCrossfade();
+  // Background preset decoding: one stored slot per pass keeps boot cheap and
+  // still has the whole bank parsed before anyone reaches for it.
+  presetCache_.warmNext();
+  serviceFlightRecorderDump();
   ++frame_;
-  captureDisplaySnapshot(displayCache_, uiStateCache_);
+  refreshDisplayCache();
   displayDirty_ = true;
 }
 
 #if !SEEDBOX_HW
 void AppState::tickHostAudio() {
+  const AudioPathMark audioPath;
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kHostAudioTick),
+                                  JournalScope::When::kOnExit);
   static const HostAudioRealtimeService service{};
   service.tick(*this);
 }
 
 void AppState::serviceHostMaintenance() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kMaintenance),
+                                  JournalScope::When::kOnExit);
   // Desktop upkeep lives here: poll the simulated panel, resolve any queued
   // host gestures, commit deferred preset requests, and refresh the UI caches.
   hal::io::poll();
@@ -758,7 +997,9 @@ void AppState::serviceHostMaintenance() {
     reseed(masterSeed_);
   }
   maybeCommitPendingPreset(scheduler_.ticks());
-  captureDisplaySnapshot(displayCache_, uiStateCache_);
+  presetCache_.warmNext();
+  serviceFlightRecorderDump();
+  refreshDisplayCache();
   displayDirty_ = true;
 }
 #endif
@@ -807,7 +1048,16 @@ bool AppState::handleClockButtonEvent(const InputEvents::Event& evt) {
       // In tap-prime mode the Tap button teaches two things at once: transport
       // ownership can flip, and tempo lineage can become the next seed source.
       if (tapTempo_.noteTap(evt.timestampUs).has_value()) {
-        setTempoTarget(currentTapTempoBpm(), false);
+        // No smoothing here: the tap defines both the tempo and where beat one
+        // sits, and a glide would smear the phase it just set.
+        const float bpm = std::clamp(currentTapTempoBpm(), 20.0f, 999.0f);
+        targetBpm_ = bpm;
+        bpmSmoother_.reset(bpm);
+        const std::uint64_t now = board_.nowMicros();
+        clockTransport_.applyTapTempo(bpm, now > evt.timestampUs ? now - evt.timestampUs : 0u);
+        if (!clockTransport_.externalClockDominant()) {
+          inputGate_.alignGateTick(scheduler_.beatOriginTick());
+        }
       }
     } else {
       tapTempo_.resetPendingTap();
@@ -889,6 +1139,8 @@ const char* AppState::modeLabel(Mode mode) {
 }
 
 void AppState::setModeFromHost(Mode mode) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kMode, static_cast<uint8_t>(mode)));
   static const AppUiClockService service{};
   service.setModeFromHost(*this, mode);
 }
@@ -942,62 +1194,90 @@ float AppState::currentTapTempoBpm() const {
   return tapTempo_.currentBpm();
 }
 
+float AppState::tapTempoConfidence() const {
+  return tapTempo_.confidence();
+}
+
 void AppState::onExternalClockTick() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kClockTick));
   static const AppUiClockService service{};
   service.onExternalClockTick(*this);
 }
 
 void AppState::onExternalTransportStart() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kTransportStart));
   static const AppUiClockService service{};
   service.onExternalTransportStart(*this);
 }
 
 void AppState::onExternalTransportStop() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kTransportStop));
   static const AppUiClockService service{};
   service.onExternalTransportStop(*this);
 }
 
 void AppState::onExternalControlChange(uint8_t ch, uint8_t cc, uint8_t val) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kControlChange, ch, cc, val));
   static const Mn42ControlRouter router{};
   router.route(*this, ch, cc, val);
 }
 
 void AppState::setSwingPercentFromHost(float value) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kSwing, 0, 0, 0, ControlJournal::floatBits(value)));
   static const HostControlService service{};
   service.setSwingPercent(*this, value);
 }
 
 void AppState::applyQuantizeControlFromHost(uint8_t value) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kQuantize, value));
   static const HostControlService service{};
   service.applyQuantizeControl(*this, value);
 }
 
+void AppState::setQuantizeScaleMaskFromHost(uint16_t mask) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kQuantizeScaleMask, 0, 0, 0, mask));
+  static const HostControlService service{};
+  service.setQuantizeScaleMask(*this, mask);
+}
+
 void AppState::setDebugMetersEnabledFromHost(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kDebugMeters, enabled ? 1u : 0u));
   static const HostControlService service{};
   service.setDebugMetersEnabled(*this, enabled);
 }
 
 void AppState::setTransportLatchFromHost(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kTransportLatch, enabled ? 1u : 0u));
   static const HostControlService service{};
   service.setTransportLatch(*this, enabled);
 }
 
 void AppState::setFollowExternalClockFromHost(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kFollowExternalClock, enabled ? 1u : 0u));
   static const HostControlService service{};
   service.setFollowExternalClock(*this, enabled);
 }
 
 void AppState::setClockSourceExternalFromHost(bool external) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kClockSourceExternal, external ? 1u : 0u));
   static const HostControlService service{};
   service.setClockSourceExternal(*this, external);
 }
 
 void AppState::setInternalBpmFromHost(float bpm) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kInternalBpm, 0, 0, 0, ControlJournal::floatBits(bpm)));
   static const HostControlService service{};
   service.setInternalBpm(*this, bpm);
 }
 
 void AppState::syncInternalBpmFromHostTransport(float bpm) {
+  const JournalScope journalScope(
+      journal_, journalDepth(), journalEvent(JournalKind::kHostTransportBpm, 0, 0, 0, ControlJournal::floatBits(bpm)));
   // Transport sync needs the same BPM sanitation as UI automation, but it
   // should not dirty the display every time a host reports position.
   const float sanitized = std::clamp(bpm, 20.0f, 999.0f);
@@ -1038,19 +1318,66 @@ AppState::DiagnosticsSnapshot AppState::diagnosticsSnapshot() const {
   return service.diagnosticsSnapshot(*this);
 }
 
+void AppState::setTestToneEnabledFromHost(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kTestTone, enabled ? 1u : 0u));
+  audioRuntime_.setTestToneEnabled(enabled);
+}
+
 void AppState::setHostDiagnosticsFromHost(const DiagnosticsSnapshot::HostRuntime& host) {
   static const HostControlService service{};
   service.setHostDiagnostics(*this, host);
 }
 
+#if !SEEDBOX_HW
+void AppState::setRuntimeLoopDiagnostics(const NativeRuntimeLoop::Stats& stats) {
+  DiagnosticsSnapshot::RuntimeLoop published{};
+  published.timerFires = stats.timerFires;
+  published.deadlineMisses = stats.deadlineMisses;
+  published.skippedPeriods = stats.skippedPeriods;
+  published.worstLatenessUs = static_cast<std::uint32_t>(stats.worstLatenessNanos / 1000u);
+  published.loadPercent = stats.loadPercent();
+  setRuntimeLoopDiagnostics(published);
+}
+#endif
+
 void AppState::setSeedPrimeBypassFromHost(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kSeedPrimeBypass, enabled ? 1u : 0u));
   static const HostControlService service{};
   service.setSeedPrimeBypass(*this, enabled);
 }
 
 bool AppState::applySeedEditFromHost(uint8_t seedIndex, const std::function<void(Seed&)>& edit) {
   static const SeedMutationService service{};
-  return service.applySeedEditFromHost(*this, seedIndex, edit);
+  if (!JournalScope::recording(journal_, journalDepth())) {
+    const JournalScope journalScope(nullptr, journalDepth(), journalEvent(JournalKind::kSeedEdit, seedIndex));
+    return service.applySeedEditFromHost(*this, seedIndex, edit);
+  }
+  // A closure cannot go into a journal, so record what it produced: run it on
+  // a copy first and journal the edited Seed.  Replay assigns that Seed
+  // through this same path, locks and all.
+  Seed edited = seeds_.empty() ? Seed{} : seeds_[static_cast<std::size_t>(seedIndex) % seeds_.size()];
+  edit(edited);
+  const auto blob = ControlJournal::blobOf(&edited, 1);
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kSeedEdit, seedIndex),
+                                  JournalScope::When::kOnEntry, &blob);
+  return service.applySeedEditFromHost(*this, seedIndex, [&edited](Seed& seed) { seed = edited; });
+}
+
+bool AppState::setSeedParamFromHost(uint8_t seedIndex, SeedParam param, float value) {
+  if (param >= SeedParam::kCount) {
+    return false;
+  }
+  const JournalScope journalScope(
+      journal_, journalDepth(),
+      journalEvent(JournalKind::kSeedParam, seedIndex, static_cast<uint8_t>(param), 0, ControlJournal::floatBits(value)));
+  const auto column = static_cast<std::size_t>(param);
+  return applySeedEditFromHost(seedIndex, [column, value](Seed& seed) {
+    float row[SeedParamMatrix::kColumns]{};
+    SeedParamMatrix::packRow(seed, row);
+    row[column] = value;
+    SeedParamMatrix::unpackRow(row, seed);
+  });
 }
 
 void AppState::setLiveCaptureVariation(uint8_t variationSteps) {
@@ -1059,11 +1386,15 @@ void AppState::setLiveCaptureVariation(uint8_t variationSteps) {
 }
 
 void AppState::setInputGateDivisionFromHost(GateDivision division) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kGateDivision, static_cast<uint8_t>(division)));
   static const HostControlService service{};
   service.setInputGateDivision(*this, static_cast<std::uint8_t>(division));
 }
 
 void AppState::setInputGateFloorFromHost(float floor) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kGateFloor, 0, 0, 0, ControlJournal::floatBits(floor)));
   static const HostControlService service{};
   service.setInputGateFloor(*this, floor);
 }
@@ -1094,26 +1425,33 @@ void AppState::updateExternalClockWatchdog() {
 }
 
 void AppState::reseed(uint32_t masterSeed) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kReseed, 0, 0, 0, masterSeed));
   static const SeedPrimeRuntimeService service{};
   service.reseed(*this, masterSeed);
 }
 
 void AppState::seedPageReseed(uint32_t masterSeed, SeedPrimeMode mode) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kSeedPageReseed, static_cast<uint8_t>(mode), 0, 0, masterSeed));
   static const SeedPrimeRuntimeService service{};
   service.seedPageReseed(*this, masterSeed, mode);
 }
 
 void AppState::setSeedPrimeMode(SeedPrimeMode mode) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kSeedPrimeMode, static_cast<uint8_t>(mode)));
   static const SeedPrimeRuntimeService service{};
   service.setSeedPrimeMode(*this, mode);
 }
 
 void AppState::seedPageToggleLock(uint8_t index) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kSeedLock, index));
   static const SeedLockService service{};
   service.toggleSeedLock(*this, index);
 }
 
 void AppState::seedPageToggleGlobalLock() {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kGlobalSeedLock));
   static const SeedLockService service{};
   service.toggleGlobalLock(*this);
 }
@@ -1124,11 +1462,18 @@ bool AppState::isSeedLocked(uint8_t index) const {
 }
 
 void AppState::seedPageNudge(uint8_t index, const SeedNudge& nudge) {
+  const auto blob = JournalScope::recording(journal_, journalDepth()) ? ControlJournal::blobOf(&nudge, 1)
+                                                                    : std::vector<std::uint8_t>{};
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kSeedNudge, index),
+                                  JournalScope::When::kOnEntry, &blob);
   static const SeedMutationService service{};
   service.seedPageNudge(*this, index, nudge);
 }
 
 void AppState::seedPageCycleGranularSource(uint8_t index, int32_t steps) {
+  const JournalScope journalScope(
+      journal_, journalDepth(),
+      journalEvent(JournalKind::kGranularSource, index, 0, 0, static_cast<std::uint32_t>(steps)));
   static const SeedMutationService service{};
   service.seedPageCycleGranularSource(*this, index, steps);
 }
@@ -1138,6 +1483,10 @@ void AppState::recordTapTempoInterval(uint32_t intervalMs) {
 }
 
 void AppState::setSeedPreset(uint32_t presetId, const std::vector<Seed>& seeds) {
+  const auto blob = JournalScope::recording(journal_, journalDepth()) ? ControlJournal::blobOf(seeds.data(), seeds.size())
+                                                                    : std::vector<std::uint8_t>{};
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kSeedPreset, 0, 0, 0, presetId),
+                                  JournalScope::When::kOnEntry, &blob);
   static const SeedPrimeRuntimeService service{};
   service.setSeedPreset(*this, presetId, seeds);
 }
@@ -1148,16 +1497,19 @@ void AppState::applyQuantizeControl(uint8_t value) {
 }
 
 void AppState::setFocusSeed(uint8_t index) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kFocusSeed, index));
   static const SeedMutationService service{};
   service.setFocusSeed(*this, index);
 }
 
 void AppState::setSeedEngine(uint8_t seedIndex, uint8_t engineId) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kSeedEngine, seedIndex, engineId));
   static const SeedMutationService service{};
   service.setSeedEngine(*this, seedIndex, engineId);
 }
 
 void AppState::setPage(Page page) {
+  const JournalScope journalScope(journal_, journalDepth(), journalEvent(JournalKind::kPage, static_cast<uint8_t>(page)));
   static const PresetStorageService service{};
   service.setPage(*this, page);
 }
@@ -1167,6 +1519,11 @@ std::vector<std::string> AppState::storedPresets() const {
   return service.storedPresets(*this);
 }
 
+void AppState::attachStore(seedbox::io::Store* store) {
+  store_ = store;
+  presetCache_.reset(store_);
+}
+
 bool AppState::savePreset(std::string_view slot) {
   static const PresetStorageService service{};
   return service.savePreset(*this, slot);
@@ -1186,6 +1543,11 @@ void AppState::captureDisplaySnapshot(DisplaySnapshot& out, UiState* ui) const {
   service.captureDisplaySnapshot(*this, out, ui);
 }
 
+void AppState::refreshDisplayCache() {
+  static const DisplayTelemetryService service{};
+  service.refreshDisplayCache(*this);
+}
+
 void AppState::captureLearnFrame(LearnFrame& out) const {
   static const DisplayTelemetryService service{};
   service.captureLearnFrame(*this, out);
@@ -1208,6 +1570,9 @@ void AppState::captureStatusSnapshot(StatusSnapshot& out) const {
   input.hostDiagnostics.oversizeBlockDropCount = hostDiagnostics.oversizeBlockDropCount;
   input.hostDiagnostics.lastOversizeBlockFrames = hostDiagnostics.lastOversizeBlockFrames;
   input.hostDiagnostics.preparedScratchFrames = hostDiagnostics.preparedScratchFrames;
+  input.hostDiagnostics.commandQueueOverflowCount = hostDiagnostics.commandQueueOverflowCount;
+  input.hostDiagnostics.commandQueueHighWater = hostDiagnostics.commandQueueHighWater;
+  input.hostDiagnostics.commandQueueMaxLatencyUs = hostDiagnostics.commandQueueMaxLatencyUs;
   input.externalClockDominant = externalClockDominant();
   input.followExternalClockEnabled = followExternalClockEnabled();
   input.waitingForExternalClock = waitingForExternalClock();
@@ -1230,6 +1595,14 @@ std::string AppState::captureStatusJson() const {
   return builder.toJson(status);
 }
 
+std::size_t AppState::pollStatusTelemetry(std::uint32_t since, std::uint8_t* out, std::size_t capacity) {
+  StatusSnapshot status{};
+  captureStatusSnapshot(status);
+  statusTelemetry_.publish(StatusTelemetry::sample(status, static_cast<std::uint8_t>(mode_),
+                                                   static_cast<std::uint8_t>(currentPage_)));
+  return statusTelemetry_.encodeSince(since, out, capacity);
+}
+
 const Seed* AppState::debugScheduledSeed(uint8_t index) const {
   // Straight-through view into the scheduler's copy of a seed.  Gives us a
   // stable reference for debugging displays + tests.
@@ -1237,6 +1610,8 @@ const Seed* AppState::debugScheduledSeed(uint8_t index) const {
 }
 
 void AppState::armGranularLiveInput(bool enabled) {
+  const JournalScope journalScope(journal_, journalDepth(),
+                                  journalEvent(JournalKind::kGranularLiveInput, enabled ? 1u : 0u));
   engines_.granular().armLiveInput(enabled);
 }
 
@@ -7,6 +7,7 @@
 // Treat it like a field guide for the rest of the codebase: the UI, tests, and
 // documentation all poke through this interface.  That means generous comments
 // are fair game — we're not hiding cleverness, we're teaching it.
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -17,14 +18,20 @@
 #include "SeedLock.h"
 #include "Seed.h"
 #include "app/DisplaySnapshot.h"
+#include "app/DisplaySnapshotBuilder.h"
+#include "app/FlightRecorder.h"
 #include "app/AudioRuntimeState.h"
 #include "app/InputGateMonitor.h"
+#include "app/NativeRuntimeLoop.h"
 #include "app/Preset.h"
+#include "app/PresetCache.h"
 #include "app/PresetController.h"
 #include "app/StatusSnapshot.h"
+#include "app/StatusTelemetry.h"
 #include "app/TapTempoTracker.h"
 #include "app/ClockTransportController.h"
 #include "util/Smoother.h"
+#include "util/ScaleQuantizer.h"
 #include "engine/Patterns.h"
 #include "engine/EngineRouter.h"
 #include "util/Annotations.h"
@@ -59,6 +66,7 @@ class SeedLockService;
 class PresetStorageService;
 class DisplayTelemetryService;
 class HostAudioRealtimeService;
+class ControlJournal;
 
 // AppState is the mothership for everything the performer can poke at run time.
 // It owns the seed table, orchestrates scheduling, and provides a place for the
@@ -140,7 +148,19 @@ public:
       std::uint32_t oversizeBlockDropCount{0};
       std::uint32_t lastOversizeBlockFrames{0};
       std::uint32_t preparedScratchFrames{0};
+      std::uint32_t commandQueueOverflowCount{0};
+      std::uint32_t commandQueueHighWater{0};
+      std::uint32_t commandQueueMaxLatencyUs{0};
     } host{};
+    // Published by whatever paces tick() on the desktop (see
+    // NativeRuntimeLoop); stays zero on hardware and inside plugin hosts.
+    struct RuntimeLoop {
+      std::uint64_t timerFires{0};
+      std::uint64_t deadlineMisses{0};
+      std::uint64_t skippedPeriods{0};
+      std::uint32_t worstLatenessUs{0};
+      float loadPercent{0.0f};
+    } runtimeLoop{};
     PatternScheduler::Diagnostics scheduler{};
     uint64_t audioCallbackCount{0};
   };
@@ -172,6 +192,7 @@ public:
       SeedPrimeMode primeMode{SeedPrimeMode::kLfsr};
       float tapTempoBpm{0.0f};
       uint32_t lastTapIntervalMs{0};
+      float tapTempoConfidence{0.0f};
       float mutationRate{0.0f};
     } generator{};
   };
@@ -186,7 +207,41 @@ public:
   }
   void captureLearnFrame(LearnFrame& out) const;
   void captureStatusSnapshot(StatusSnapshot& out) const;
+  // Full JSON projection of the same status: handy for one-off requests.
   std::string captureStatusJson() const;
+  // High-rate alternative to captureStatusJson(): sample the status into the
+  // numeric telemetry table, then hand back only what changed after `since`
+  // as one compact frame (see StatusTelemetry.h).  Pass the sequence from the
+  // last frame you applied, or 0 for everything.  Returns the bytes written.
+  std::size_t pollStatusTelemetry(std::uint32_t since, std::uint8_t* out, std::size_t capacity);
+  const StatusTelemetry& statusTelemetry() const { return statusTelemetry_; }
+
+  // Per-block black box written by handleAudio() (see FlightRecorder.h).
+  const FlightRecorder& flightRecorder() const { return flightRecorder_; }
+  // Fill in per-engine levels (FlightRecorder::Record::engineRms).  Off by
+  // default; arming auto-dumps turns it on too.
+  void setFlightRecorderEngineMetering(bool enabled) { flightRecorder_.setEngineMetering(enabled); }
+#if !SEEDBOX_HW
+  // Write the ring as it stands right now.  Returns false if the file could
+  // not be written.
+  bool dumpFlightRecorder(const std::string& path, FlightRecorder::DumpFormat format) const;
+  // Arm post-mortem dumps: the first clip or overrun writes
+  // `<directory>/flight-<block>.sbfr` once its post-roll has been recorded.
+  // An empty directory disarms.  Engine metering follows the arming.
+  void setFlightRecorderAutoDumpDirectory(const std::string& directory);
+  const std::string& lastFlightRecorderDumpPath() const { return lastFlightDumpPath_; }
+#endif
+
+  // Session capture (see ControlJournal.h).  While attached, every external
+  // entry point below (MIDI, panel, pins, host setters) and every tick/audio
+  // block is appended to `journal`; nullptr detaches.  The audio thread and the
+  // control thread may record at the same time: appends are locked, and each
+  // thread tracks its own nesting, so neither hides the other's events.
+  // The voice governor sheds voices by wall-clock load, which a replay cannot
+  // reproduce, so it is parked while a journal is attached.  Attach and detach
+  // between blocks.
+  void attachControlJournal(ControlJournal* journal);
+  ControlJournal* controlJournal() const { return journal_; }
 
   const UiState& uiStateCache() const { return uiStateCache_; }
 
@@ -237,10 +292,15 @@ public:
   uint32_t masterSeed() const { return masterSeed_; }
   uint8_t focusSeed() const { return focusSeed_; }
   uint64_t schedulerTicks() const { return scheduler_.ticks(); }
+  // Since the scheduler was last rebuilt (reseed/recall).
+  uint64_t schedulerTriggersFired() const { return scheduler_.triggersFired(); }
+  float schedulerBpm() const { return scheduler_.bpm(); }
 
   const Seed* debugScheduledSeed(uint8_t index) const;
 
-  void attachStore(seedbox::io::Store* store) { store_ = store; }
+  // Swapping the store also re-queues the preset cache so recalls never serve
+  // presets decoded from the previous backend.
+  void attachStore(seedbox::io::Store* store);
   seedbox::io::Store* store() const { return store_; }
 
   void setPage(Page page);
@@ -248,6 +308,13 @@ public:
 
   bool savePreset(std::string_view slot);
   bool recallPreset(std::string_view slot, bool crossfade = true);
+  // Crossfade shape for recalls: length in scheduler ticks (0 cuts instantly)
+  // and an optional curve per seed parameter.
+  void setPresetCrossfadeTicks(std::uint32_t ticks) { presetCrossfadeTicks_ = ticks; }
+  std::uint32_t presetCrossfadeTicks() const { return presetCrossfadeTicks_; }
+  void setPresetCrossfadeCurve(SeedParam param, CrossfadeCurve curve) {
+    presetController_.setCrossfadeCurve(param, curve);
+  }
   std::vector<std::string> storedPresets() const;
   const std::string& activePresetSlot() const { return presetController_.activePresetSlot(); }
 
@@ -286,11 +353,16 @@ public:
   float swingPercent() const { return swingPercent_; }
   uint8_t quantizeScaleIndex() const { return quantizeScaleIndex_; }
   uint8_t quantizeRoot() const { return quantizeRoot_; }
+  // Scale slot 5 is the user-defined 12-bit mask (bit n = n semitones above the
+  // root).  It only joins the scale rotation once a mask has been loaded.
+  static constexpr uint8_t kQuantizeCustomScaleIndex = 5;
+  uint16_t quantizeScaleMask() const { return quantizeCustomScale_.mask(); }
 
   // Host/automation hooks. These mirror the hardware gestures so DAWs can hit
   // the same code paths the front panel pokes.
   void setSwingPercentFromHost(float value);
   void applyQuantizeControlFromHost(uint8_t value);
+  void setQuantizeScaleMaskFromHost(uint16_t mask);
   void setDebugMetersEnabledFromHost(bool enabled);
   void setTransportLatchFromHost(bool enabled);
   void setFollowExternalClockFromHost(bool enabled);
@@ -301,7 +373,12 @@ public:
   bool diagnosticsEnabled() const { return diagnosticsEnabled_; }
   DiagnosticsSnapshot diagnosticsSnapshot() const;
   void setHostDiagnosticsFromHost(const DiagnosticsSnapshot::HostRuntime& host);
-  void setTestToneEnabledFromHost(bool enabled) { audioRuntime_.setTestToneEnabled(enabled); }
+  void setRuntimeLoopDiagnostics(const DiagnosticsSnapshot::RuntimeLoop& loop) { runtimeLoopDiagnostics_ = loop; }
+#if !SEEDBOX_HW
+  // Convenience for whoever owns the loop: copy its running totals across.
+  void setRuntimeLoopDiagnostics(const NativeRuntimeLoop::Stats& stats);
+#endif
+  void setTestToneEnabledFromHost(bool enabled);
   bool testToneEnabled() const { return audioRuntime_.testToneEnabled(); }
   bool waitingForExternalClock() const { return clockTransport_.waitingForExternalClock(); }
   void setSeedPrimeBypassFromHost(bool enabled);
@@ -310,7 +387,12 @@ public:
   void setInputGateFloorFromHost(float floor);
   void setDryInputFromHost(const float* left, const float* right, std::size_t frames);
   bool applySeedEditFromHost(uint8_t seedIndex, const std::function<void(Seed&)>& edit);
+  // One packed column (see SeedParamMatrix) of one seed.  Same rules as
+  // applySeedEditFromHost(), but journals as a single compact event.
+  bool setSeedParamFromHost(uint8_t seedIndex, SeedParam param, float value);
   float currentTapTempoBpm() const;
+  // 0..1 agreement across the tap history (see TapTempoTracker).
+  float tapTempoConfidence() const;
 
 #if !SEEDBOX_HW
   void tickHostAudio();
@@ -343,6 +425,21 @@ private:
   void updateExternalClockWatchdog();
   void applyQuantizeControl(uint8_t value);
   void captureDisplaySnapshot(DisplaySnapshot& out, UiState* ui) const;
+  // Per-tick refresh of displayCache_/uiStateCache_ through the long-lived
+  // displayBuilder_, so unchanged fields are not re-formatted every tick.
+  void refreshDisplayCache();
+  // Audio thread: append this block to flightRecorder_ and return the render
+  // time it measured.
+  std::uint32_t recordFlightBlock(const hal::audio::StereoBufferView& buffer, std::uint32_t renderStart,
+                                  const std::array<float, FlightRecorder::kEngineSlots>& engineRms, bool clip);
+  // Deadline for a block of `frames` at the current sample rate (0 if unknown).
+  static std::uint32_t blockBudgetNanos(std::size_t frames);
+  // Audio thread: hand one block's cost to the voice governor.  On the Teensy
+  // the stopwatch figures are topped up from the audio library's own cycle
+  // counts, since the voices render outside handleAudio().
+  void governVoices(std::uint32_t renderNanos, std::size_t frames, VoiceGovernor::LaneNanos engineNanos);
+  // Control thread: write any auto-dump whose post-roll has landed.
+  void serviceFlightRecorderDump();
   bool handleClockButtonEvent(const InputEvents::Event& evt);
   void applyModeTransition(const InputEvents::Event& evt);
   bool handleSeedPrimeGesture(const InputEvents::Event& evt);
@@ -392,6 +489,8 @@ private:
   PatternScheduler scheduler_{};
   ClockTransportController clockTransport_{internalClock_, midiClockIn_, midiClockOut_, scheduler_};
   PresetController presetController_{};
+  PresetCache presetCache_{};
+  std::uint32_t presetCrossfadeTicks_{kPresetCrossfadeTicks};
   EngineRouter engines_{};
   bool enginesReady_{false};
   std::vector<uint8_t> seedEngineSelections_{};
@@ -416,6 +515,26 @@ private:
   bool swingEditing_{false};
   DisplaySnapshot displayCache_{};
   UiState uiStateCache_{};
+  // Only touched from the app thread via refreshDisplayCache(); the const
+  // captureDisplaySnapshot() path (used by host readers) builds its own.
+  DisplaySnapshotBuilder displayBuilder_{};
+  StatusTelemetry statusTelemetry_{};
+  FlightRecorder flightRecorder_{};
+  // Audio-thread bookkeeping for the next flight record.
+  uint64_t flightTriggersSeen_{0};
+  ControlJournal* journal_{nullptr};
+  // What bootRuntime() chose for the voice governor, restored on detach.
+  bool voiceGovernorWanted_{false};
+  // Nesting depth of journalled entry points; only depth-zero calls record.
+  // The audio callback and the control/message thread both enter AppState,
+  // so each keeps its own count and journalDepth() picks the caller's.
+  uint32_t& journalDepth();
+  uint32_t controlJournalDepth_{0};
+  uint32_t audioJournalDepth_{0};
+#if !SEEDBOX_HW
+  std::string flightDumpDirectory_{};
+  std::string lastFlightDumpPath_{};
+#endif
   RandomnessPanel randomnessPanel_{};
   LearnFrame::AudioMetrics latestAudioMetrics_{};
   bool displayDirty_{false};
@@ -424,13 +543,18 @@ private:
   Page currentPage_{Page::kSeeds};
   uint8_t quantizeScaleIndex_{0};
   uint8_t quantizeRoot_{0};
+  // Compiled once when a mask is loaded so Quantize taps only do lookups.
+  util::ScaleQuantizer::Table quantizeCustomScale_{util::ScaleQuantizer::Mask{0}};
   bool panicSkipNextTick_{false};
   float targetBpm_{120.f};
   OnePoleSmoother bpmSmoother_{};
   bool diagnosticsEnabled_{false};
   DiagnosticsSnapshot::HostRuntime hostDiagnostics_{};
+  DiagnosticsSnapshot::RuntimeLoop runtimeLoopDiagnostics_{};
   AudioRuntimeState audioRuntime_{};
   InputGateMonitor inputGate_{};
+  // Last InputGateMonitor onset count mirrored into the capture ring.
+  std::uint32_t captureOnsetsSeen_{0};
   GateDivision gateDivision_{GateDivision::kBars};
   bool storageButtonHeld_{false};
   bool storageLongPress_{false};
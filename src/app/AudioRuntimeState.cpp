@@ -10,6 +10,8 @@ constexpr float kHostOutputTrim = 0.62f;
 void AudioRuntimeState::resetHostState(bool hostAudioMode) {
   hostAudioMode_ = hostAudioMode;
   hostLimiterGain_ = 1.0f;
+  outputOversampleLeft_.reset();
+  outputOversampleRight_.reset();
 }
 
 void AudioRuntimeState::resetAudioCallbackCount() { audioCallbackCount_ = 0; }
@@ -38,11 +40,12 @@ void AudioRuntimeState::applyHostOutputSafety(float* left, float* right, std::si
   hostLimiterGain_ += (desiredGain - hostLimiterGain_) * slew;
   hostLimiterGain_ = std::clamp(hostLimiterGain_, 0.12f, 1.0f);
 
+  const auto softClip = [](float x) { return std::tanh(x * kSoftClipDrive) * kSoftClipOut; };
   for (std::size_t i = 0; i < frames; ++i) {
     const float l = left[i] * kHostOutputTrim * hostLimiterGain_;
     const float r = right[i] * kHostOutputTrim * hostLimiterGain_;
-    left[i] = std::tanh(l * kSoftClipDrive) * kSoftClipOut;
-    right[i] = std::tanh(r * kSoftClipDrive) * kSoftClipOut;
+    left[i] = outputOversampleLeft_.process(l, softClip);
+    right[i] = outputOversampleRight_.process(r, softClip);
   }
 }
 
@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "util/Oversampler.h"
+
 class AudioRuntimeState {
  public:
   void resetHostState(bool hostAudioMode);
@@ -17,11 +19,19 @@ class AudioRuntimeState {
   bool hostAudioMode() const { return hostAudioMode_; }
 
   void applyHostOutputSafety(float* left, float* right, std::size_t frames);
+  // Rate the output soft clip runs at (default kBypass).
+  void setOutputOversampling(const util::Oversampler::Quality& quality) {
+    outputOversampleLeft_.setQuality(quality);
+    outputOversampleRight_.setQuality(quality);
+  }
+  const util::Oversampler::Quality& outputOversampling() const { return outputOversampleLeft_.quality(); }
   void renderTestTone(float* left, float* right, std::size_t frames, float sampleRate);
 
  private:
   bool hostAudioMode_{false};
   float hostLimiterGain_{1.0f};
+  util::Oversampler outputOversampleLeft_{};
+  util::Oversampler outputOversampleRight_{};
   bool testToneEnabled_{false};
   float testTonePhase_{0.0f};
   std::uint64_t audioCallbackCount_{0};
@@ -1,6 +1,7 @@
 #include "app/ClockTransportController.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "engine/Patterns.h"
 
@@ -53,6 +54,18 @@ void ClockTransportController::applySwing(float swing) {
   }
 }
 
+void ClockTransportController::applyTapTempo(float bpm, uint64_t tapAgeUs) {
+  scheduler_.setBpm(bpm);
+  if (externalClockDominant_) {
+    return;
+  }
+  // The tap is usually reported a few ticks late (InputEvents waits out the
+  // double-press window), so count how many ticks ago it really happened.
+  const double ticksPerUs = static_cast<double>(bpm) * 24.0 / 60.0e6;
+  const auto ticksSinceTap = static_cast<uint32_t>(std::llround(static_cast<double>(tapAgeUs) * ticksPerUs) % 24);
+  scheduler_.alignBeat(ticksSinceTap);
+}
+
 void ClockTransportController::alignProviderRunning() {
   ::alignProviderRunning(clock_, internalClock_, midiClockIn_, midiClockOut_, externalTransportRunning_);
 }
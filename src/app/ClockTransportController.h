@@ -26,6 +26,11 @@ public:
   void selectClockProvider(ClockProvider* provider);
   void toggleClockProvider();
   void applySwing(float swing);
+  // Tap tempo is a statement about phase as much as speed: set the tempo and
+  // put the downbeat on the tap that produced it, `tapAgeUs` ago.  The
+  // scheduler's density gates and bar grid re-phase with it.  External
+  // clocks own their own phase, so only the tempo lands while they dominate.
+  void applyTapTempo(float bpm, uint64_t tapAgeUs);
   void resetTransportState();
   void clearTransportGateHold();
 
@@ -0,0 +1,577 @@
+#include "app/ControlJournal.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "hal/hal_audio.h"
+#include "hal/hal_io.h"
+
+#if !SEEDBOX_HW
+#include "app/AppState.h"
+#endif
+
+namespace {
+constexpr char kMagic[4] = {'S', 'B', 'C', 'J'};
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80u) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80u));
+    value >>= 7u;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool getVarint(const std::uint8_t*& cursor, const std::uint8_t* end, std::uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64u; shift += 7u) {
+    if (cursor == end) {
+      return false;
+    }
+    const std::uint8_t byte = *cursor++;
+    value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+    if ((byte & 0x80u) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Zig-zag so small negative encoder deltas stay one byte.
+std::uint64_t zigzag(std::int32_t v) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(v)) << 1u) ^ (v < 0 ? ~0ull : 0ull);
+}
+std::int32_t unzigzag(std::uint64_t v) {
+  return static_cast<std::int32_t>(static_cast<std::uint32_t>(v >> 1u) ^ (0u - static_cast<std::uint32_t>(v & 1u)));
+}
+
+// How many of a/b/c and whether `value` travel for each kind.
+struct Layout {
+  std::uint8_t bytes;
+  bool value;
+};
+
+Layout layoutFor(ControlJournal::Kind kind) {
+  using K = ControlJournal::Kind;
+  switch (kind) {
+    case K::kAudioBlock:
+    case K::kBoardTime:
+    case K::kReseed:
+    case K::kInternalBpm:
+    case K::kHostTransportBpm:
+    case K::kSwing:
+    case K::kGateFloor:
+    case K::kQuantizeScaleMask:
+    case K::kSeedPreset:
+      return {0, true};
+    case K::kButton:
+    case K::kDigitalEdge:
+    case K::kSeedParam:
+      return {2, true};
+    case K::kEncoder:
+    case K::kSeedPageReseed:
+    case K::kGranularSource:
+    case K::kBlob:
+      return {1, true};
+    case K::kControlChange:
+      return {3, false};
+    case K::kSeedEngine:
+      return {2, false};
+    case K::kFocusSeed:
+    case K::kMode:
+    case K::kQuantize:
+    case K::kTransportLatch:
+    case K::kFollowExternalClock:
+    case K::kClockSourceExternal:
+    case K::kTestTone:
+    case K::kDebugMeters:
+    case K::kSeedEdit:
+    case K::kGateDivision:
+    case K::kSeedPrimeMode:
+    case K::kSeedLock:
+    case K::kSeedNudge:
+    case K::kSeedPrimeBypass:
+    case K::kPage:
+    case K::kGranularLiveInput:
+      return {1, false};
+    default:
+      return {0, false};
+  }
+}
+
+// Kinds whose `value` is a signed int32 and travels zig-zagged.
+bool signedValue(ControlJournal::Kind kind) {
+  return kind == ControlJournal::Kind::kEncoder || kind == ControlJournal::Kind::kGranularSource;
+}
+
+}  // namespace
+
+ControlJournal::ControlJournal(std::size_t capacity) : ControlJournal(Header{}, capacity) {}
+
+ControlJournal::ControlJournal(const Header& header, std::size_t capacity) : header_(header), events_(capacity) {}
+
+void ControlJournal::clear() {
+  count_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+  audioHash_ = kHashSeed;
+  audioBlocks_ = 0;
+}
+
+bool ControlJournal::claim(std::size_t count, std::size_t& first) {
+  // A CAS rather than fetch_add: a claim that does not fit leaves the count
+  // alone, so the buffer never has a hole a later, smaller claim could skip.
+  std::size_t at = count_.load(std::memory_order_relaxed);
+  do {
+    if (count > events_.size() - at) {
+      dropped_.fetch_add(static_cast<std::uint32_t>(count), std::memory_order_relaxed);
+      return false;
+    }
+  } while (!count_.compare_exchange_weak(at, at + count, std::memory_order_acq_rel, std::memory_order_relaxed));
+  first = at;
+  return true;
+}
+
+void ControlJournal::append(const Event& event) {
+  std::size_t at = 0;
+  if (!claim(1, at)) {
+    return;
+  }
+  events_[at] = event;
+  events_[at].sample = hal::audio::sampleClock();
+}
+
+void ControlJournal::append(const Event& event, const std::vector<std::uint8_t>& bytes) {
+  const std::size_t chunks = (bytes.size() + 7u) / 8u;
+  std::size_t at = 0;
+  if (!claim(chunks + 1u, at)) {
+    return;
+  }
+  const std::uint32_t sample = hal::audio::sampleClock();
+  for (std::size_t offset = 0; offset < bytes.size(); offset += 8u) {
+    Event chunk{};
+    chunk.kind = Kind::kBlob;
+    chunk.sample = sample;
+    chunk.a = static_cast<std::uint8_t>(bytes.size() - offset < 8u ? bytes.size() - offset : 8u);
+    for (std::uint8_t i = 0; i < chunk.a; ++i) {
+      chunk.value |= static_cast<std::uint64_t>(bytes[offset + i]) << (8u * i);
+    }
+    events_[at++] = chunk;
+  }
+  events_[at] = event;
+  events_[at].sample = sample;
+}
+
+void ControlJournal::noteAudioBlock(const float* left, const float* right, std::size_t frames) {
+  audioHash_ = hashFloats(audioHash_, left, frames);
+  audioHash_ = hashFloats(audioHash_, right, frames);
+  ++audioBlocks_;
+}
+
+std::uint64_t ControlJournal::floatBits(float value) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float ControlJournal::bitsToFloat(std::uint64_t bits) {
+  const auto narrow = static_cast<std::uint32_t>(bits);
+  float value = 0.0f;
+  std::memcpy(&value, &narrow, sizeof(value));
+  return value;
+}
+
+std::uint64_t ControlJournal::hashFloats(std::uint64_t hash, const float* data, std::size_t count) {
+  if (!data) {
+    return hash;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &data[i], sizeof(bits));
+    for (unsigned byte = 0; byte < 4u; ++byte) {
+      hash ^= (bits >> (byte * 8u)) & 0xFFu;
+      hash *= kFnvPrime;
+    }
+  }
+  return hash;
+}
+
+void ControlJournal::encode(std::vector<std::uint8_t>& out) const {
+  const EventList recorded = events();
+  out.clear();
+  out.insert(out.end(), kMagic, kMagic + 4);
+  putVarint(out, kVersion);
+  out.push_back(static_cast<std::uint8_t>(header_.boot));
+  putVarint(out, floatBits(header_.sampleRate));
+  putVarint(out, header_.framesPerBlock);
+  putVarint(out, audioHash_);
+  putVarint(out, audioBlocks_);
+  putVarint(out, recorded.size());
+  std::uint32_t lastSample = 0;
+  for (const Event& event : recorded) {
+    out.push_back(static_cast<std::uint8_t>(event.kind));
+    // Unsigned wrap keeps the delta right across a sample clock rollover.
+    putVarint(out, static_cast<std::uint32_t>(event.sample - lastSample));
+    lastSample = event.sample;
+    const Layout layout = layoutFor(event.kind);
+    const std::uint8_t fields[3] = {event.a, event.b, event.c};
+    out.insert(out.end(), fields, fields + layout.bytes);
+    if (layout.value) {
+      putVarint(out, signedValue(event.kind) ? zigzag(static_cast<std::int32_t>(event.value)) : event.value);
+    }
+  }
+}
+
+bool ControlJournal::decode(const std::uint8_t* data, std::size_t size, ControlJournal& out) {
+  if (!data || size < 5 || std::memcmp(data, kMagic, 4) != 0) {
+    return false;
+  }
+  const std::uint8_t* cursor = data + 4;
+  const std::uint8_t* end = data + size;
+  std::uint64_t version = 0;
+  if (!getVarint(cursor, end, version) || version != kVersion || cursor == end) {
+    return false;
+  }
+  Header header{};
+  header.boot = static_cast<Boot>(*cursor++);
+  std::uint64_t rate = 0;
+  std::uint64_t frames = 0;
+  std::uint64_t hash = 0;
+  std::uint64_t blocks = 0;
+  std::uint64_t count = 0;
+  if (!getVarint(cursor, end, rate) || !getVarint(cursor, end, frames) || !getVarint(cursor, end, hash) ||
+      !getVarint(cursor, end, blocks) || !getVarint(cursor, end, count)) {
+    return false;
+  }
+  header.sampleRate = bitsToFloat(rate);
+  header.framesPerBlock = static_cast<std::uint32_t>(frames);
+
+  std::vector<Event> events;
+  // Every event is at least two bytes, which also bounds a hostile count.
+  if (count > static_cast<std::uint64_t>(end - cursor) / 2u) {
+    return false;
+  }
+  events.reserve(std::max(static_cast<std::size_t>(count), out.events_.size()));
+  std::uint32_t sample = 0;
+  for (std::uint64_t i = 0; i < count; ++i) {
+    if (cursor == end) {
+      return false;
+    }
+    Event event{};
+    const std::uint8_t kind = *cursor++;
+    if (kind == 0 || kind >= static_cast<std::uint8_t>(Kind::kCount)) {
+      return false;
+    }
+    event.kind = static_cast<Kind>(kind);
+    std::uint64_t delta = 0;
+    if (!getVarint(cursor, end, delta)) {
+      return false;
+    }
+    sample += static_cast<std::uint32_t>(delta);
+    event.sample = sample;
+    const Layout layout = layoutFor(event.kind);
+    if (static_cast<std::size_t>(end - cursor) < layout.bytes) {
+      return false;
+    }
+    std::uint8_t* fields[3] = {&event.a, &event.b, &event.c};
+    for (std::uint8_t f = 0; f < layout.bytes; ++f) {
+      *fields[f] = *cursor++;
+    }
+    if (layout.value) {
+      std::uint64_t value = 0;
+      if (!getVarint(cursor, end, value)) {
+        return false;
+      }
+      if (signedValue(event.kind)) {
+        value = static_cast<std::uint32_t>(unzigzag(value));
+      }
+      event.value = value;
+    }
+    events.push_back(event);
+  }
+
+  // Loading may grow the buffer; the journal is not recording while it loads.
+  if (events.size() < out.events_.size()) {
+    events.resize(out.events_.size());
+  }
+  out.header_ = header;
+  out.events_ = std::move(events);
+  out.count_.store(static_cast<std::size_t>(count), std::memory_order_release);
+  out.dropped_.store(0, std::memory_order_relaxed);
+  out.audioHash_ = hash;
+  out.audioBlocks_ = blocks;
+  return true;
+}
+
+ControlJournal::Scope::Scope(ControlJournal* journal, std::uint32_t& depth, const Event& event, When when,
+                             const std::vector<std::uint8_t>* blob)
+    : journal_(journal), depth_(depth), event_(event), recordOnExit_(false) {
+  if (recording(journal_, depth_)) {
+    if (when == When::kOnEntry) {
+      if (blob) {
+        journal_->append(event_, *blob);
+      } else {
+        journal_->append(event_);
+      }
+    } else {
+      recordOnExit_ = true;
+    }
+  }
+  ++depth_;
+}
+
+ControlJournal::Scope::~Scope() {
+  --depth_;
+  if (recordOnExit_) {
+    journal_->append(event_);
+  }
+}
+
+void ControlJournal::RecordingBoard::poll() {
+  inner_.poll();
+  const std::uint64_t now = inner_.nowMicros();
+  if (now != seenMicros_) {
+    seenMicros_ = now;
+    Event event{};
+    event.kind = Kind::kBoardTime;
+    event.value = now;
+    journal_.append(event);
+  }
+  for (std::uint8_t id = 0; id < 8u; ++id) {
+    const ButtonSample sample = inner_.sampleButton(static_cast<ButtonID>(id));
+    if (sample.pressed == seen_[id].pressed && sample.timestamp_us == seen_[id].timestamp_us) {
+      continue;
+    }
+    seen_[id] = sample;
+    Event event{};
+    event.kind = Kind::kButton;
+    event.a = id;
+    event.b = sample.pressed ? 1u : 0u;
+    event.value = sample.timestamp_us;
+    journal_.append(event);
+  }
+}
+
+int32_t ControlJournal::RecordingBoard::consumeEncoderDelta(EncoderID id) {
+  const int32_t delta = inner_.consumeEncoderDelta(id);
+  if (delta != 0) {
+    Event event{};
+    event.kind = Kind::kEncoder;
+    event.a = static_cast<std::uint8_t>(id);
+    event.value = static_cast<std::uint32_t>(delta);
+    journal_.append(event);
+  }
+  return delta;
+}
+
+hal::Board::ButtonSample ControlJournal::ReplayBoard::sampleButton(ButtonID id) const {
+  const auto idx = static_cast<std::size_t>(id);
+  return idx < 8u ? buttons_[idx] : ButtonSample{};
+}
+
+int32_t ControlJournal::ReplayBoard::consumeEncoderDelta(EncoderID id) {
+  const auto idx = static_cast<std::size_t>(id);
+  if (idx >= 4u) {
+    return 0;
+  }
+  const int32_t delta = encoders_[idx];
+  encoders_[idx] = 0;
+  return delta;
+}
+
+void ControlJournal::ReplayBoard::apply(const Event& event) {
+  switch (event.kind) {
+    case Kind::kBoardTime:
+      nowMicros_ = event.value;
+      break;
+    case Kind::kButton:
+      if (event.a < 8u) {
+        buttons_[event.a].pressed = event.b != 0;
+        buttons_[event.a].timestamp_us = event.value;
+      }
+      break;
+    case Kind::kEncoder:
+      if (event.a < 4u) {
+        encoders_[event.a] += static_cast<std::int32_t>(static_cast<std::uint32_t>(event.value));
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+#if !SEEDBOX_HW
+ControlJournal::ReplayResult ControlJournal::replay(const ControlJournal& journal) {
+  ReplayResult result{};
+  ReplayBoard board;
+  AppState app(board);
+  // The replay journal only exists for its audio hash; AppState appends the
+  // markers it sees to it as a side effect, which we simply ignore.  It gets
+  // no event buffer, so those appends are dropped without a copy.
+  ControlJournal sink(journal.header(), 0);
+  const Header& header = journal.header();
+  if (header.boot == Boot::kJuceHost) {
+    app.initJuceHost(header.sampleRate, header.framesPerBlock);
+  } else {
+    app.initSim();
+  }
+  app.attachControlJournal(&sink);
+
+  std::vector<float> left(header.framesPerBlock ? header.framesPerBlock : 128u);
+  std::vector<float> right(left.size());
+  std::vector<std::uint8_t> blob;
+  std::vector<Seed> seeds;
+  std::vector<AppState::SeedNudge> nudges;
+  for (const Event& event : journal.events()) {
+    switch (event.kind) {
+      case Kind::kTick:
+        app.tick();
+        break;
+      case Kind::kHostAudioTick:
+        app.tickHostAudio();
+        break;
+      case Kind::kMaintenance:
+        app.serviceHostMaintenance();
+        break;
+      case Kind::kAudioBlock: {
+        const auto frames = static_cast<std::size_t>(event.value);
+        if (frames > left.size()) {
+          left.resize(frames);
+          right.resize(frames);
+        }
+        hal::audio::renderHostBuffer(left.data(), right.data(), frames);
+        ++result.audioBlocks;
+        break;
+      }
+      case Kind::kBoardTime:
+      case Kind::kButton:
+      case Kind::kEncoder:
+        board.apply(event);
+        break;
+      case Kind::kDigitalEdge:
+        hal::io::mockSetDigitalInput(event.a, event.b != 0, static_cast<std::uint32_t>(event.value));
+        break;
+      case Kind::kClockTick:
+        app.onExternalClockTick();
+        break;
+      case Kind::kTransportStart:
+        app.onExternalTransportStart();
+        break;
+      case Kind::kTransportStop:
+        app.onExternalTransportStop();
+        break;
+      case Kind::kControlChange:
+        app.onExternalControlChange(event.a, event.b, event.c);
+        break;
+      case Kind::kReseed:
+        app.reseed(static_cast<std::uint32_t>(event.value));
+        break;
+      case Kind::kFocusSeed:
+        app.setFocusSeed(event.a);
+        break;
+      case Kind::kSeedEngine:
+        app.setSeedEngine(event.a, event.b);
+        break;
+      case Kind::kMode:
+        app.setModeFromHost(static_cast<AppState::Mode>(event.a));
+        break;
+      case Kind::kInternalBpm:
+        app.setInternalBpmFromHost(bitsToFloat(event.value));
+        break;
+      case Kind::kHostTransportBpm:
+        app.syncInternalBpmFromHostTransport(bitsToFloat(event.value));
+        break;
+      case Kind::kSwing:
+        app.setSwingPercentFromHost(bitsToFloat(event.value));
+        break;
+      case Kind::kQuantize:
+        app.applyQuantizeControlFromHost(event.a);
+        break;
+      case Kind::kTransportLatch:
+        app.setTransportLatchFromHost(event.a != 0);
+        break;
+      case Kind::kFollowExternalClock:
+        app.setFollowExternalClockFromHost(event.a != 0);
+        break;
+      case Kind::kClockSourceExternal:
+        app.setClockSourceExternalFromHost(event.a != 0);
+        break;
+      case Kind::kTestTone:
+        app.setTestToneEnabledFromHost(event.a != 0);
+        break;
+      case Kind::kDebugMeters:
+        app.setDebugMetersEnabledFromHost(event.a != 0);
+        break;
+      case Kind::kSeedParam:
+        app.setSeedParamFromHost(event.a, static_cast<SeedParam>(event.b), bitsToFloat(event.value));
+        break;
+      case Kind::kSeedEdit:
+        if (fromBlob(blob, seeds) && seeds.size() == 1u) {
+          const Seed edited = seeds.front();
+          app.applySeedEditFromHost(event.a, [&edited](Seed& seed) { seed = edited; });
+        }
+        break;
+      case Kind::kGateDivision:
+        app.setInputGateDivisionFromHost(static_cast<AppState::GateDivision>(event.a));
+        break;
+      case Kind::kGateFloor:
+        app.setInputGateFloorFromHost(bitsToFloat(event.value));
+        break;
+      case Kind::kSeedPageReseed:
+        app.seedPageReseed(static_cast<std::uint32_t>(event.value), static_cast<AppState::SeedPrimeMode>(event.a));
+        break;
+      case Kind::kSeedPrimeMode:
+        app.setSeedPrimeMode(static_cast<AppState::SeedPrimeMode>(event.a));
+        break;
+      case Kind::kSeedLock:
+        app.seedPageToggleLock(event.a);
+        break;
+      case Kind::kGlobalSeedLock:
+        app.seedPageToggleGlobalLock();
+        break;
+      case Kind::kSeedNudge:
+        if (fromBlob(blob, nudges) && nudges.size() == 1u) {
+          app.seedPageNudge(event.a, nudges.front());
+        }
+        break;
+      case Kind::kGranularSource:
+        app.seedPageCycleGranularSource(event.a, static_cast<std::int32_t>(static_cast<std::uint32_t>(event.value)));
+        break;
+      case Kind::kSeedPrimeBypass:
+        app.setSeedPrimeBypassFromHost(event.a != 0);
+        break;
+      case Kind::kQuantizeScaleMask:
+        app.setQuantizeScaleMaskFromHost(static_cast<std::uint16_t>(event.value));
+        break;
+      case Kind::kPage:
+        app.setPage(static_cast<AppState::Page>(event.a));
+        break;
+      case Kind::kSeedPreset:
+        if (fromBlob(blob, seeds)) {
+          app.setSeedPreset(static_cast<std::uint32_t>(event.value), seeds);
+        }
+        break;
+      case Kind::kGranularLiveInput:
+        app.armGranularLiveInput(event.a != 0);
+        break;
+      case Kind::kBlob:
+        for (std::uint8_t i = 0; i < event.a && i < 8u; ++i) {
+          blob.push_back(static_cast<std::uint8_t>(event.value >> (8u * i)));
+        }
+        break;
+      default:
+        break;
+    }
+    if (event.kind != Kind::kBlob) {
+      blob.clear();
+    }
+    ++result.events;
+  }
+  app.attachControlJournal(nullptr);
+  result.audioHash = sink.audioHash();
+  // A journal that ran out of room lost events, so even a matching hash would
+  // only be luck.
+  result.ok = journal.droppedEvents() == 0 && result.audioHash == journal.audioHash() &&
+              result.audioBlocks == journal.audioBlocks();
+  return result;
+}
+#endif
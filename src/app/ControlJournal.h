@@ -0,0 +1,289 @@
+#pragma once
+
+//
+// ControlJournal
+// --------------
+// Bit-exact session capture.  Control input reaches AppState from a pile of
+// surfaces: MIDI clock/CC, the front panel (real or a NativeBoard script), the
+// reseed/lock pins, and the JUCE host setters.  When a journal is attached,
+// every one of those entry points appends an Event.  The journal also records
+// the points where time moves: control ticks, host audio ticks, maintenance
+// passes and audio blocks.  Each event carries the audio sample clock at the
+// moment it arrived.
+//
+// Replaying the journal into a fresh AppState, in order and as fast as the CPU
+// allows, walks the exact same path.  The audio hash at the end must match the
+// one taken while recording; if it does not, something in the engine is
+// reading state the journal cannot see.  That is the point: a glitch report
+// becomes a ~kilobyte file you can rerun under a debugger on a Linux box.
+//
+// Host edits that arrive as closures (applySeedEditFromHost) and whole seed
+// tables (setSeedPreset) do not fit in one event.  Their bytes ride ahead of
+// them as a run of kBlob chunks.
+//
+// What is *not* captured: audio input (dry/live capture material) and
+// on-disk preset stores.  Sessions that lean on those replay only as well as
+// the replay machine's copy of them.
+//
+// Threading: the event buffer is allocated once, at construction, and never
+// grows.  append() claims its slots with one CAS on a shared count, so any
+// thread may record (the audio thread included) without locking or
+// allocating.  A run of blob chunks and its consumer claim their slots
+// together, so nothing from another thread lands between them.  When the
+// buffer is full, events are dropped and counted.  A journal that dropped
+// anything is truncated and will not replay.  events(), encode() and the
+// audio hash belong to whoever holds the journal once recording has stopped.
+// The hash is folded in by the audio thread alone.
+// Recording is a diagnostic mode; leave it detached in performance builds.
+// replay() boots a sim or JUCE-host AppState and is desktop-only.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "SeedBoxConfig.h"
+
+#include "hal/Board.h"
+
+class AppState;
+
+class ControlJournal {
+public:
+  static constexpr std::uint16_t kVersion = 1;
+  // Events the buffer holds before it starts dropping.  On the desktop that is
+  // several minutes of a 128-frame host session (about 6 MB); the firmware
+  // default only covers a short capture.
+#if SEEDBOX_HW
+  static constexpr std::size_t kDefaultCapacity = 2048;
+#else
+  static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 18;
+#endif
+
+  enum class Kind : std::uint8_t {
+    // Time markers: replay performs the same step.
+    kTick = 1,           // AppState::tick()
+    kHostAudioTick,      // AppState::tickHostAudio()
+    kMaintenance,        // AppState::serviceHostMaintenance()
+    kAudioBlock,         // one rendered block; value = frames
+    // Front panel and pins, captured at the hardware boundary.
+    kBoardTime,          // value = board micros
+    kButton,             // a = ButtonID, b = pressed, value = sample timestamp (us)
+    kEncoder,            // a = EncoderID, value = int32 delta
+    kDigitalEdge,        // a = pin, b = level, value = timestamp (us)
+    // MIDI ingress.
+    kClockTick,
+    kTransportStart,
+    kTransportStop,
+    kControlChange,      // a = channel, b = controller, c = value
+    // Host / automation setters.
+    kReseed,             // value = master seed
+    kFocusSeed,          // a = index
+    kSeedEngine,         // a = seed, b = engine id
+    kMode,               // a = AppState::Mode
+    kInternalBpm,        // value = float bits
+    kHostTransportBpm,   // value = float bits
+    kSwing,              // value = float bits
+    kQuantize,           // a = control value
+    kTransportLatch,     // a = enabled
+    kFollowExternalClock,
+    kClockSourceExternal,
+    kTestTone,
+    kDebugMeters,
+    kSeedParam,          // a = seed, b = SeedParam column, value = float bits
+    kSeedEdit,           // a = seed; the edited Seed travels in the kBlob run before it
+    kGateDivision,       // a = AppState::GateDivision
+    kGateFloor,          // value = float bits
+    kSeedPageReseed,     // a = AppState::SeedPrimeMode, value = master seed
+    kSeedPrimeMode,      // a = AppState::SeedPrimeMode
+    kSeedLock,           // a = seed index (toggle)
+    kGlobalSeedLock,     // toggle
+    kSeedNudge,          // a = seed; the SeedNudge travels in the kBlob run before it
+    kGranularSource,     // a = seed, value = int32 steps
+    kSeedPrimeBypass,    // a = enabled
+    kQuantizeScaleMask,  // value = mask
+    kPage,               // a = AppState::Page
+    kSeedPreset,         // value = preset id; the seeds travel in the kBlob run before it
+    kGranularLiveInput,  // a = armed
+    // Payload too big for one event: up to 8 bytes per chunk, consumed by the
+    // next non-blob event.
+    kBlob,               // a = byte count, value = bytes, little-endian
+    kCount
+  };
+
+  struct Event {
+    Kind kind{Kind::kTick};
+    std::uint32_t sample{0};  // hal::audio::sampleClock() when it arrived
+    std::uint8_t a{0};
+    std::uint8_t b{0};
+    std::uint8_t c{0};
+    std::uint64_t value{0};
+  };
+
+  enum class Boot : std::uint8_t { kSim = 0, kJuceHost };
+
+  struct Header {
+    Boot boot{Boot::kSim};
+    float sampleRate{48000.0f};
+    std::uint32_t framesPerBlock{128};
+  };
+
+  struct ReplayResult {
+    bool ok{false};
+    std::uint64_t events{0};
+    std::uint64_t audioBlocks{0};
+    std::uint64_t audioHash{0};
+  };
+
+  // The recorded events in order: a view over the front of the buffer.
+  class EventList {
+  public:
+    EventList(const Event* data, std::size_t size) : data_(data), size_(size) {}
+    const Event* begin() const { return data_; }
+    const Event* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const Event& operator[](std::size_t index) const { return data_[index]; }
+
+  private:
+    const Event* data_;
+    std::size_t size_;
+  };
+
+  explicit ControlJournal(std::size_t capacity = kDefaultCapacity);
+  explicit ControlJournal(const Header& header, std::size_t capacity = kDefaultCapacity);
+  ControlJournal(const ControlJournal&) = delete;
+  ControlJournal& operator=(const ControlJournal&) = delete;
+
+  const Header& header() const { return header_; }
+  // Safe to read once recording has stopped.
+  EventList events() const { return {events_.data(), count_.load(std::memory_order_acquire)}; }
+  std::size_t capacity() const { return events_.size(); }
+  // Events refused because the buffer was full.
+  std::uint32_t droppedEvents() const { return dropped_.load(std::memory_order_relaxed); }
+  std::uint64_t audioHash() const { return audioHash_; }
+  std::uint64_t audioBlocks() const { return audioBlocks_; }
+  void clear();
+
+  void append(const Event& event);
+  // `event` preceded by `bytes` split into kBlob chunks, claimed as one run so
+  // no other thread's event lands between the chunks and their consumer.
+  void append(const Event& event, const std::vector<std::uint8_t>& bytes);
+  // Fold a finished output block into the running audio hash (FNV-1a over
+  // the raw float bits, left then right).
+  void noteAudioBlock(const float* left, const float* right, std::size_t frames);
+
+  // Compact binary form: `SBCJ` header, then one kind byte, a varint sample
+  // delta and a kind-specific varint payload per event.
+  void encode(std::vector<std::uint8_t>& out) const;
+  static bool decode(const std::uint8_t* data, std::size_t size, ControlJournal& out);
+
+  // Boot a fresh AppState the way `header()` says, feed it every event in
+  // order and hash what it renders.  Runs as fast as the CPU allows.
+#if !SEEDBOX_HW
+  static ReplayResult replay(const ControlJournal& journal);
+#endif
+
+  // Raw bytes of plain structs (Seed, SeedNudge) for a kBlob run and back.
+  // Replay runs the same build that recorded, so the layout matches.
+  template <typename T>
+  static std::vector<std::uint8_t> blobOf(const T* items, std::size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "blobs carry plain structs only");
+    std::vector<std::uint8_t> bytes(sizeof(T) * count);
+    if (count > 0) {
+      std::memcpy(bytes.data(), items, bytes.size());
+    }
+    return bytes;
+  }
+  template <typename T>
+  static bool fromBlob(const std::vector<std::uint8_t>& bytes, std::vector<T>& out) {
+    static_assert(std::is_trivially_copyable<T>::value, "blobs carry plain structs only");
+    if (bytes.size() % sizeof(T) != 0) {
+      return false;
+    }
+    out.resize(bytes.size() / sizeof(T));
+    if (!out.empty()) {
+      std::memcpy(out.data(), bytes.data(), bytes.size());
+    }
+    return true;
+  }
+
+  static std::uint64_t floatBits(float value);
+  static float bitsToFloat(std::uint64_t bits);
+  static std::uint64_t hashFloats(std::uint64_t hash, const float* data, std::size_t count);
+  static constexpr std::uint64_t kHashSeed = 1469598103934665603ull;
+
+  // Records entry points from outside AppState only.  AppState keeps a depth
+  // counter per thread (audio and control); an event is appended only at
+  // depth zero, so a tick that reseeds internally does not also journal a
+  // kReseed the replay would apply twice.  Markers (kTick, ...) are appended
+  // on exit, after the inputs the step consumed.  A `blob` goes in front of an on-entry event; pass it only when
+  // recording() says it will be used, since building one costs a copy.
+  class Scope {
+  public:
+    enum class When : std::uint8_t { kOnEntry, kOnExit };
+    Scope(ControlJournal* journal, std::uint32_t& depth, const Event& event, When when = When::kOnEntry,
+          const std::vector<std::uint8_t>* blob = nullptr);
+    static bool recording(const ControlJournal* journal, std::uint32_t depth) { return journal && depth == 0; }
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    ControlJournal* journal_;
+    std::uint32_t& depth_;
+    Event event_;
+    bool recordOnExit_;
+  };
+
+  // Wraps the real board and journals what AppState sees of it: board time,
+  // button level changes and encoder deltas.
+  class RecordingBoard final : public hal::Board {
+  public:
+    RecordingBoard(hal::Board& inner, ControlJournal& journal) : inner_(inner), journal_(journal) {}
+    void poll() override;
+    ButtonSample sampleButton(ButtonID id) const override { return inner_.sampleButton(id); }
+    int32_t consumeEncoderDelta(EncoderID id) override;
+    bool tapTempoActive() const override { return inner_.tapTempoActive(); }
+    std::uint32_t nowMillis() const override { return inner_.nowMillis(); }
+    std::uint64_t nowMicros() const override { return inner_.nowMicros(); }
+
+  private:
+    hal::Board& inner_;
+    ControlJournal& journal_;
+    ButtonSample seen_[8]{};
+    std::uint64_t seenMicros_{0};
+  };
+
+  // Plays the journalled panel back: it holds exactly what kBoardTime,
+  // kButton and kEncoder events last wrote.
+  class ReplayBoard final : public hal::Board {
+  public:
+    void poll() override {}
+    ButtonSample sampleButton(ButtonID id) const override;
+    int32_t consumeEncoderDelta(EncoderID id) override;
+    bool tapTempoActive() const override { return sampleButton(ButtonID::TapTempo).pressed; }
+    std::uint32_t nowMillis() const override { return static_cast<std::uint32_t>(nowMicros_ / 1000u); }
+    std::uint64_t nowMicros() const override { return nowMicros_; }
+
+    void apply(const Event& event);
+
+  private:
+    ButtonSample buttons_[8]{};
+    int32_t encoders_[4]{};
+    std::uint64_t nowMicros_{0};
+  };
+
+private:
+  // Reserve `count` consecutive slots; returns false (and counts the drop) if
+  // they do not fit.
+  bool claim(std::size_t count, std::size_t& first);
+
+  Header header_;
+  std::vector<Event> events_{};
+  std::atomic<std::size_t> count_{0};
+  std::atomic<std::uint32_t> dropped_{0};
+  std::uint64_t audioHash_{kHashSeed};
+  std::uint64_t audioBlocks_{0};
+};
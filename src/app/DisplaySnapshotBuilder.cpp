@@ -5,20 +5,99 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
-#include <utility>
 
 namespace {
-template <std::size_t N, typename... Args>
-std::string_view formatScratch(std::array<char, N>& scratch, const char* fmt, Args&&... args) {
-  const int written = std::snprintf(scratch.data(), scratch.size(), fmt, std::forward<Args>(args)...);
-  if (written < 0) {
-    scratch[0] = '\0';
-    return std::string_view{scratch.data()};
+// Append-only formatter for the display fields.  Everything is integer maths:
+// this runs every tick on the Teensy, and snprintf's float path is the single
+// most expensive thing the old builder did.  Only non-finite or absurd floats
+// fall back to snprintf so they still print *something* honest.
+class FieldWriter {
+public:
+  explicit FieldWriter(std::array<char, 48>& buffer) : buf_(buffer.data()), cap_(buffer.size()) { buf_[0] = '\0'; }
+
+  FieldWriter& ch(char c) {
+    if (len_ + 1 < cap_) {
+      buf_[len_++] = c;
+      buf_[len_] = '\0';
+    }
+    return *this;
   }
-  const std::size_t len = std::min<std::size_t>(static_cast<std::size_t>(written), scratch.size() - 1u);
-  scratch[len] = '\0';
-  return std::string_view{scratch.data(), len};
-}
+
+  FieldWriter& text(std::string_view s) {
+    for (char c : s) {
+      ch(c);
+    }
+    return *this;
+  }
+
+  // Like %0<width>llu: zero-padded to at least `width` digits, never truncated.
+  FieldWriter& dec(std::uint64_t value, int width = 1) {
+    char digits[20];
+    int n = 0;
+    do {
+      digits[n++] = static_cast<char>('0' + (value % 10u));
+      value /= 10u;
+    } while (value != 0 && n < 20);
+    for (int pad = n; pad < width; ++pad) {
+      ch('0');
+    }
+    while (n > 0) {
+      ch(digits[--n]);
+    }
+    return *this;
+  }
+
+  // Like %0<width>X.
+  FieldWriter& hex(std::uint32_t value, int width) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+    char digits[8];
+    int n = 0;
+    do {
+      digits[n++] = kHex[value & 0xFu];
+      value >>= 4u;
+    } while (value != 0 && n < 8);
+    for (int pad = n; pad < width; ++pad) {
+      ch('0');
+    }
+    while (n > 0) {
+      ch(digits[--n]);
+    }
+    return *this;
+  }
+
+  // Like %.<decimals>f (or %+.<decimals>f).  A float times 10 or 100 is exact
+  // in a double, and nearbyint rounds ties to even, so the digits match what
+  // printf would have produced.
+  FieldWriter& fixed(float value, int decimals, bool plus = false) {
+    static constexpr std::uint32_t kScale[] = {1u, 10u, 100u};
+    if (!std::isfinite(value) || std::fabs(value) >= 1.0e9f || decimals < 0 || decimals > 2) {
+      char fallback[48];
+      std::snprintf(fallback, sizeof(fallback), plus ? "%+.*f" : "%.*f", decimals, static_cast<double>(value));
+      return text(fallback);
+    }
+    const std::uint32_t scale = kScale[decimals];
+    const auto units =
+        static_cast<std::uint64_t>(std::nearbyint(std::fabs(static_cast<double>(value)) * static_cast<double>(scale)));
+    if (std::signbit(value)) {
+      ch('-');
+    } else if (plus) {
+      ch('+');
+    }
+    dec(units / scale);
+    if (decimals > 0) {
+      ch('.');
+      dec(units % scale, decimals);
+    }
+    return *this;
+  }
+
+  std::string_view view() const { return std::string_view{buf_, len_}; }
+
+private:
+  char* buf_;
+  std::size_t cap_;
+  std::size_t len_{0};
+};
 
 template <std::size_t N>
 void writeDisplayField(char (&dst)[N], std::string_view text) {
@@ -47,11 +126,100 @@ bool hasSeedContent(const std::vector<Seed>* seeds) {
   return std::any_of(seeds->begin(), seeds->end(), [](const Seed& s) { return s.prng != 0; });
 }
 
+std::uint32_t packToken(const char (&token)[8]) {
+  return static_cast<std::uint32_t>(static_cast<unsigned char>(token[0])) |
+         (static_cast<std::uint32_t>(static_cast<unsigned char>(token[1])) << 8u) |
+         (static_cast<std::uint32_t>(static_cast<unsigned char>(token[2])) << 16u) |
+         (static_cast<std::uint32_t>(static_cast<unsigned char>(token[3])) << 24u);
+}
+
+// The focused engine's four-character voice token ("SM03", "GL01", "Rab0").
+void composeEngineToken(char (&token)[8], const DisplaySnapshotBuilder::Input& input, const Seed& s,
+                        std::size_t focusIndex) {
+  std::array<char, 48> scratch{};
+  FieldWriter w(scratch);
+  if (!input.engines) {
+    w.ch('?').dec(s.engine % 1000u, 3);
+  } else {
+    switch (s.engine) {
+      case 0: {
+        const auto voice = input.engines->sampler().voice(static_cast<uint8_t>(focusIndex % Sampler::kMaxVoices));
+        w.ch(voice.active ? 'S' : 's').ch(voice.usesSdStreaming ? 'D' : 'M').dec(voice.sampleIndex, 2);
+        break;
+      }
+      case 1: {
+        const auto voice = input.engines->granular().voice(static_cast<uint8_t>(focusIndex % GranularEngine::kVoicePoolSize));
+        GranularEngine::Source seedSource = static_cast<GranularEngine::Source>(s.granular.source);
+        if (seedSource != GranularEngine::Source::kSdClip) {
+          seedSource = GranularEngine::Source::kLiveInput;
+        }
+        uint8_t sdSlot = s.granular.sdSlot;
+        if (GranularEngine::kSdClipSlots > 0) {
+          sdSlot = static_cast<uint8_t>(sdSlot % GranularEngine::kSdClipSlots);
+        }
+        if (seedSource == GranularEngine::Source::kSdClip && GranularEngine::kSdClipSlots > 1 && sdSlot == 0) {
+          sdSlot = 1;
+        }
+        const bool voiceActive = voice.active && voice.seedId == s.id;
+        char sourceTag = (seedSource == GranularEngine::Source::kLiveInput) ? 'L' : 'C';
+        if (voiceActive && voice.source == seedSource) {
+          if (seedSource == GranularEngine::Source::kSdClip && GranularEngine::kSdClipSlots > 0) {
+            sdSlot = static_cast<uint8_t>(voice.sdSlot % GranularEngine::kSdClipSlots);
+          }
+        }
+        w.ch(voiceActive ? 'G' : 'g').ch(sourceTag).dec(sdSlot, 2);
+        break;
+      }
+      case 2: {
+        const auto voice = input.engines->resonator().voice(static_cast<uint8_t>(focusIndex % ResonatorBank::kMaxVoices));
+        const char* preset = input.engines->resonator().presetName(voice.bank);
+        char presetA = '-';
+        char presetB = '-';
+        if (preset && preset[0] != '\0') {
+          presetA = preset[0];
+          if (preset[1] != '\0') {
+            presetB = preset[1];
+          }
+        }
+        const uint8_t modeDigit = static_cast<uint8_t>(std::min<uint8_t>(voice.mode, 9));
+        w.ch(voice.active ? 'R' : 'r').ch(presetA).ch(presetB).ch(static_cast<char>('0' + modeDigit));
+        break;
+      }
+      default:
+        w.ch('?').dec(s.engine % 1000u, 3);
+        break;
+    }
+  }
+  const std::string_view text = w.view();
+  const std::size_t n = std::min<std::size_t>(sizeof(token) - 1u, text.size());
+  std::memcpy(token, text.data(), n);
+  token[n] = '\0';
+}
+
 }  // namespace
 
-void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut, const Input& input) const {
-  std::array<char, 64> scratch{};
-  writeDisplayField(out.title, formatScratch(scratch, "SeedBox %06X", input.masterSeed & 0xFFFFFFu));
+void DisplaySnapshotBuilder::invalidate() {
+  titleKey_.reset();
+  engineNameKey_.reset();
+  hintsKey_.reset();
+  statusKey_.reset();
+  metricsKey_.reset();
+  nuanceKey_.reset();
+}
+
+void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut, const Input& input) {
+  // Each text field below is guarded by the handful of inputs it is printed
+  // from.  When none of them moved, the previously formatted text is reused
+  // and the field costs a tuple compare instead of a format.
+  lastFormattedFields_ = 0;
+  std::array<char, 48> scratch{};
+
+  if (titleKey_.changed(input.masterSeed)) {
+    FieldWriter w(scratch);
+    w.text("SeedBox ").hex(input.masterSeed & 0xFFFFFFu, 6);
+    writeDisplayField(snapshot_.title, w.view());
+    ++lastFormattedFields_;
+  }
 
   const bool seedsPresent = hasSeedContent(input.seeds);
   const std::size_t seedCount = input.seeds ? input.seeds->size() : 0u;
@@ -59,6 +227,8 @@ void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut
   if (seedsPresent && seedCount > 0u) {
     focusIndex = std::min<std::size_t>(input.focusSeed, seedCount - 1u);
   }
+  const Seed* focus = seedsPresent ? &(*input.seeds)[focusIndex] : nullptr;
+  const std::uint8_t focusEngine = focus ? focus->engine : 0u;
   const bool globalLocked = input.seedLock ? input.seedLock->globalLocked() : false;
   const bool focusLocked = (input.seedLock && seedsPresent && focusIndex < seedCount)
                                ? input.seedLock->seedLocked(focusIndex)
@@ -67,94 +237,120 @@ void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut
   const char* gateLabel = gateDivisionLabel(input.gateDivision);
   const char* primeMode = primeModeLabel(input.seedPrimeMode);
 
-  uiOut.mode = UiState::Mode::kPerformance;
+  ui_.mode = UiState::Mode::kPerformance;
   if (input.mode == 6u) {
-    uiOut.mode = UiState::Mode::kEdit;
+    ui_.mode = UiState::Mode::kEdit;
   } else if (anyLockActive) {
-    uiOut.mode = UiState::Mode::kEdit;
+    ui_.mode = UiState::Mode::kEdit;
   }
   if (input.debugMetersEnabled) {
-    uiOut.mode = UiState::Mode::kSystem;
+    ui_.mode = UiState::Mode::kSystem;
   }
-  uiOut.bpm = input.bpm;
-  uiOut.swing = input.swing;
-  uiOut.clock = input.externalClockDominant ? UiState::ClockSource::kExternal : UiState::ClockSource::kInternal;
-  uiOut.seedLocked = anyLockActive;
-
-  if (seedsPresent && input.engines) {
-    const Seed& s = (*input.seeds)[focusIndex];
-    writeUiField(uiOut.engineName, engineLongName(s.engine));
-  } else {
-    writeUiField(uiOut.engineName, "Idle");
+  ui_.bpm = input.bpm;
+  ui_.swing = input.swing;
+  ui_.clock = input.externalClockDominant ? UiState::ClockSource::kExternal : UiState::ClockSource::kInternal;
+  ui_.seedLocked = anyLockActive;
+
+  const bool namedEngine = seedsPresent && input.engines;
+  if (engineNameKey_.changed(namedEngine, focusEngine)) {
+    writeUiField(ui_.engineName, namedEngine ? engineLongName(focusEngine) : "Idle");
+    ++lastFormattedFields_;
   }
 
-  if (input.mode == 6u) {
-    writeUiField(uiOut.pageHints[0], "Tap: exit swing");
-    writeUiField(uiOut.pageHints[1], "Seed:5% Den:1%");
-  } else if (input.mode == 4u) {
-    writeUiField(uiOut.pageHints[0],
-                 formatScratch(scratch, "Alt:prime %s", input.seedPrimeBypassEnabled ? "skip" : "fill"));
-    writeUiField(uiOut.pageHints[1],
-                 formatScratch(scratch, "Tap:%s clock", input.followExternalClockEnabled ? "ext" : "int"));
-  } else if (input.currentPage == 1u) {
-    writeUiField(uiOut.pageHints[0], "GPIO: recall");
-    writeUiField(uiOut.pageHints[1], "Hold GPIO: save");
-  } else if (globalLocked) {
-    writeUiField(uiOut.pageHints[0], "Pg seeds locked");
-    writeUiField(uiOut.pageHints[1], "Pg+Md: unlock all");
-  } else if (focusLocked) {
-    writeUiField(uiOut.pageHints[0], "Pg focus locked");
-    writeUiField(uiOut.pageHints[1], "Pg+Md: unlock");
-  } else if (input.mode == 2u && seedsPresent) {
-    switch ((*input.seeds)[focusIndex].engine) {
-      case EngineRouter::kEuclidId:
-        writeUiField(uiOut.pageHints[0], "Den:steps Fx:rot");
-        writeUiField(uiOut.pageHints[1], "Tone:fills");
-        break;
-      case EngineRouter::kBurstId:
-        writeUiField(uiOut.pageHints[0], "Den:clusters");
-        writeUiField(uiOut.pageHints[1], "Tone:spacing");
-        break;
-      default: {
-        writeUiField(uiOut.pageHints[0], "Tone S:src ALT:d");
-        const auto primeHint = formatScratch(scratch, "Tap:%s G%s", primeMode, gateLabel);
-        writeUiField(uiOut.pageHints[1], primeHint);
-        break;
+  if (hintsKey_.changed(input.mode, input.currentPage, globalLocked, focusLocked, seedsPresent, focusEngine,
+                        input.seedPrimeBypassEnabled, input.followExternalClockEnabled, input.seedPrimeMode,
+                        input.gateDivision)) {
+    lastFormattedFields_ += 2;
+    const auto primeHint = [&]() {
+      FieldWriter w(scratch);
+      w.text("Tap:").text(primeMode).text(" G").text(gateLabel);
+      return w.view();
+    };
+    if (input.mode == 6u) {
+      writeUiField(ui_.pageHints[0], "Tap: exit swing");
+      writeUiField(ui_.pageHints[1], "Seed:5% Den:1%");
+    } else if (input.mode == 4u) {
+      writeUiField(ui_.pageHints[0], input.seedPrimeBypassEnabled ? "Alt:prime skip" : "Alt:prime fill");
+      writeUiField(ui_.pageHints[1], input.followExternalClockEnabled ? "Tap:ext clock" : "Tap:int clock");
+    } else if (input.currentPage == 1u) {
+      writeUiField(ui_.pageHints[0], "GPIO: recall");
+      writeUiField(ui_.pageHints[1], "Hold GPIO: save");
+    } else if (globalLocked) {
+      writeUiField(ui_.pageHints[0], "Pg seeds locked");
+      writeUiField(ui_.pageHints[1], "Pg+Md: unlock all");
+    } else if (focusLocked) {
+      writeUiField(ui_.pageHints[0], "Pg focus locked");
+      writeUiField(ui_.pageHints[1], "Pg+Md: unlock");
+    } else if (input.mode == 2u && seedsPresent) {
+      switch (focusEngine) {
+        case EngineRouter::kEuclidId:
+          writeUiField(ui_.pageHints[0], "Den:steps Fx:rot");
+          writeUiField(ui_.pageHints[1], "Tone:fills");
+          break;
+        case EngineRouter::kBurstId:
+          writeUiField(ui_.pageHints[0], "Den:clusters");
+          writeUiField(ui_.pageHints[1], "Tone:spacing");
+          break;
+        default:
+          writeUiField(ui_.pageHints[0], "Tone S:src ALT:d");
+          writeUiField(ui_.pageHints[1], primeHint());
+          break;
       }
+    } else {
+      writeUiField(ui_.pageHints[0], "Gate:Shift+Den");
+      writeUiField(ui_.pageHints[1], primeHint());
     }
-  } else {
-    writeUiField(uiOut.pageHints[0], "Gate:Shift+Den");
-    const auto primeHint = formatScratch(scratch, "Tap:%s G%s", primeMode, gateLabel);
-    writeUiField(uiOut.pageHints[1], primeHint);
   }
 
-  if (!seedsPresent) {
+  if (!focus) {
     const char* mood = input.quietMode ? "quiet" : "empty";
     if (input.seedPrimeBypassEnabled) {
       mood = "bypass";
     }
-    if (input.waitingForExternalClock) {
-      writeDisplayField(out.status, "WAIT EXT CLK");
-    } else {
-      writeDisplayField(out.status, formatScratch(scratch, "%s %s", modeLabel(input.mode), mood));
+    if (statusKey_.changed(0u, input.waitingForExternalClock, input.mode, 0u, mood, 0.0f, false)) {
+      FieldWriter w(scratch);
+      if (input.waitingForExternalClock) {
+        w.text("WAIT EXT CLK");
+      } else {
+        w.text(modeLabel(input.mode)).ch(' ').text(mood);
+      }
+      writeDisplayField(snapshot_.status, w.view());
+      ++lastFormattedFields_;
+    }
+    const float sampleRateK = input.sampleRate / 1000.f;
+    if (metricsKey_.changed(0u, sampleRateK, 0.0f, 0.0f, input.framesPerBlock, 0u, '\0')) {
+      FieldWriter w(scratch);
+      w.text("SR").fixed(sampleRateK, 1).text("kB").dec(input.framesPerBlock, 2);
+      writeDisplayField(snapshot_.metrics, w.view());
+      ++lastFormattedFields_;
     }
-    writeDisplayField(out.metrics, formatScratch(scratch, "SR%.1fkB%02zu", input.sampleRate / 1000.f, input.framesPerBlock));
-    writeDisplayField(out.nuance,
-                      formatScratch(scratch, "AC%05lluF%05lu",
-                                     static_cast<unsigned long long>(input.audioCallbackCount % 100000ULL),
-                                     static_cast<unsigned long>(input.frame % 100000ULL)));
+    const auto callbacks = static_cast<std::uint32_t>(input.audioCallbackCount % 100000ULL);
+    const auto frame = static_cast<std::uint32_t>(input.frame % 100000ULL);
+    if (nuanceKey_.changed(0u, 0.0f, callbacks, frame, 0u, 0u, 0u)) {
+      FieldWriter w(scratch);
+      w.text("AC").dec(callbacks, 5).ch('F').dec(frame, 5);
+      writeDisplayField(snapshot_.nuance, w.view());
+      ++lastFormattedFields_;
+    }
+    out = snapshot_;
+    uiOut = ui_;
     return;
   }
 
-  const Seed& s = (*input.seeds)[focusIndex];
-  const std::string_view shortName = input.engines ? engineLabel(*input.engines, s.engine) : std::string_view{"UNK"};
-  if (input.waitingForExternalClock) {
-    writeDisplayField(out.status, "WAIT EXT CLK");
-  } else {
-    writeDisplayField(out.status,
-                      formatScratch(scratch, "#%02u%.*s%+0.1fst%c", s.id, static_cast<int>(shortName.size()),
-                                     shortName.data(), s.pitch, input.ledOn ? '*' : '-'));
+  const Seed& s = *focus;
+  if (statusKey_.changed(1u, input.waitingForExternalClock, focusEngine, s.id, input.engines, s.pitch, input.ledOn)) {
+    FieldWriter w(scratch);
+    if (input.waitingForExternalClock) {
+      w.text("WAIT EXT CLK");
+    } else {
+      const std::string_view shortName =
+          input.engines ? engineLabel(*input.engines, s.engine) : std::string_view{"UNK"};
+      w.ch('#').dec(s.id, 2).text(shortName).fixed(s.pitch, 1, true).text("st").ch(input.ledOn ? '*' : '-');
+    }
+    writeDisplayField(snapshot_.status, w.view());
+    ++lastFormattedFields_;
   }
+
   const float density = std::clamp(s.density, 0.0f, 99.99f);
   const float probability = std::clamp(s.probability, 0.0f, 1.0f);
   const Seed* schedulerSeed = input.schedulerSeed;
@@ -169,13 +365,24 @@ void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut
     const unsigned sizeHigh = static_cast<unsigned>(stats.grainSizeHistogram[lastBin]);
     const unsigned sprayLow = static_cast<unsigned>(stats.sprayHistogram[0] + stats.sprayHistogram[1]);
     const unsigned sprayHigh = static_cast<unsigned>(stats.sprayHistogram[lastBin]);
-    writeDisplayField(out.metrics,
-                      formatScratch(scratch, "GV%02u SD%02u GP%03u", stats.activeVoiceCount, stats.sdOnlyVoiceCount,
-                                     grains));
-    writeDisplayField(out.nuance,
-                      formatScratch(scratch, "S%02u|%02uP%02u|%02uF%u%u", sizeLow, sizeHigh, sprayLow, sprayHigh,
-                                     static_cast<unsigned>(stats.busiestMixerLoad),
-                                     static_cast<unsigned>(stats.mixerGroupsEngaged)));
+    if (metricsKey_.changed(1u, 0.0f, 0.0f, 0.0f, stats.activeVoiceCount,
+                            (static_cast<std::uint32_t>(stats.sdOnlyVoiceCount) << 16u) | grains, '\0')) {
+      FieldWriter w(scratch);
+      w.text("GV").dec(stats.activeVoiceCount, 2).text(" SD").dec(stats.sdOnlyVoiceCount, 2).text(" GP").dec(grains, 3);
+      writeDisplayField(snapshot_.metrics, w.view());
+      ++lastFormattedFields_;
+    }
+    const std::uint32_t mixers =
+        (static_cast<std::uint32_t>(stats.busiestMixerLoad) << 8u) | stats.mixerGroupsEngaged;
+    if (nuanceKey_.changed(1u, 0.0f, sizeLow, sizeHigh, sprayLow, sprayHigh, mixers)) {
+      FieldWriter w(scratch);
+      w.ch('S').dec(sizeLow, 2).ch('|').dec(sizeHigh, 2).ch('P').dec(sprayLow, 2).ch('|').dec(sprayHigh, 2);
+      w.ch('F').dec(stats.busiestMixerLoad).dec(stats.mixerGroupsEngaged);
+      writeDisplayField(snapshot_.nuance, w.view());
+      ++lastFormattedFields_;
+    }
+    out = snapshot_;
+    uiOut = ui_;
     return;
   }
 
@@ -184,75 +391,34 @@ void DisplaySnapshotBuilder::build(seedbox::DisplaySnapshot& out, UiState& uiOut
     if (s.engine == EngineRouter::kResonatorId && input.engines) {
       fanout = input.engines->resonator().fanoutProbeLevel();
     }
-    writeDisplayField(out.metrics,
-                      formatScratch(scratch, "D%.1fP%.1fF%.1f%c", density, probability, fanout, gateState));
-  } else {
-    writeDisplayField(out.metrics,
-                      formatScratch(scratch, "D%.1fP%.1fG%s%c", density, probability, gateLabel, gateState));
+    if (metricsKey_.changed(2u, density, probability, fanout, 0u, 0u, gateState)) {
+      FieldWriter w(scratch);
+      w.ch('D').fixed(density, 1).ch('P').fixed(probability, 1).ch('F').fixed(fanout, 1).ch(gateState);
+      writeDisplayField(snapshot_.metrics, w.view());
+      ++lastFormattedFields_;
+    }
+  } else if (metricsKey_.changed(3u, density, probability, 0.0f, input.gateDivision, 0u, gateState)) {
+    FieldWriter w(scratch);
+    w.ch('D').fixed(density, 1).ch('P').fixed(probability, 1).ch('G').text(gateLabel).ch(gateState);
+    writeDisplayField(snapshot_.metrics, w.view());
+    ++lastFormattedFields_;
   }
 
   const float mutate = std::clamp(s.mutateAmt, 0.0f, 1.0f);
   const float jitterMs = std::clamp(s.jitterMs, 0.0f, 999.9f);
   const unsigned jitterInt = static_cast<unsigned>(std::min(99.0f, std::round(jitterMs)));
   char engineToken[8] = {'-', '-', '-', '-', '\0'};
+  composeEngineToken(engineToken, input, s, focusIndex);
 
-  if (!input.engines) {
-    std::snprintf(engineToken, sizeof(engineToken), "?%03u", static_cast<unsigned>(s.engine % 1000));
-  } else {
-    switch (s.engine) {
-      case 0: {
-        const auto voice = input.engines->sampler().voice(static_cast<uint8_t>(focusIndex % Sampler::kMaxVoices));
-        std::snprintf(engineToken, sizeof(engineToken), "%c%c%02u", voice.active ? 'S' : 's',
-                      voice.usesSdStreaming ? 'D' : 'M', voice.sampleIndex);
-        break;
-      }
-      case 1: {
-        const auto voice = input.engines->granular().voice(static_cast<uint8_t>(focusIndex % GranularEngine::kVoicePoolSize));
-        GranularEngine::Source seedSource = static_cast<GranularEngine::Source>(s.granular.source);
-        if (seedSource != GranularEngine::Source::kSdClip) {
-          seedSource = GranularEngine::Source::kLiveInput;
-        }
-        uint8_t sdSlot = s.granular.sdSlot;
-        if (GranularEngine::kSdClipSlots > 0) {
-          sdSlot = static_cast<uint8_t>(sdSlot % GranularEngine::kSdClipSlots);
-        }
-        if (seedSource == GranularEngine::Source::kSdClip && GranularEngine::kSdClipSlots > 1 && sdSlot == 0) {
-          sdSlot = 1;
-        }
-        const bool voiceActive = voice.active && voice.seedId == s.id;
-        char sourceTag = (seedSource == GranularEngine::Source::kLiveInput) ? 'L' : 'C';
-        if (voiceActive && voice.source == seedSource) {
-          if (seedSource == GranularEngine::Source::kSdClip && GranularEngine::kSdClipSlots > 0) {
-            sdSlot = static_cast<uint8_t>(voice.sdSlot % GranularEngine::kSdClipSlots);
-          }
-        }
-        std::snprintf(engineToken, sizeof(engineToken), "%c%c%02u", voiceActive ? 'G' : 'g', sourceTag, sdSlot);
-        break;
-      }
-      case 2: {
-        const auto voice = input.engines->resonator().voice(static_cast<uint8_t>(focusIndex % ResonatorBank::kMaxVoices));
-        const char* preset = input.engines->resonator().presetName(voice.bank);
-        char presetA = '-';
-        char presetB = '-';
-        if (preset && preset[0] != '\0') {
-          presetA = preset[0];
-          if (preset[1] != '\0') {
-            presetB = preset[1];
-          }
-        }
-        const uint8_t modeDigit = static_cast<uint8_t>(std::min<uint8_t>(voice.mode, 9));
-        std::snprintf(engineToken, sizeof(engineToken), "%c%c%c%c", voice.active ? 'R' : 'r', presetA, presetB,
-                      static_cast<char>('0' + modeDigit));
-        break;
-      }
-      default:
-        std::snprintf(engineToken, sizeof(engineToken), "?%03u", static_cast<unsigned>(s.engine % 1000));
-        break;
-    }
+  if (nuanceKey_.changed(2u, mutate, packToken(engineToken), prngByte, jitterInt, 0u, 0u)) {
+    FieldWriter w(scratch);
+    w.text("Mu").fixed(mutate, 2).text(engineToken).ch('R').hex(prngByte, 2).ch('J').dec(jitterInt, 2);
+    writeDisplayField(snapshot_.nuance, w.view());
+    ++lastFormattedFields_;
   }
 
-  writeDisplayField(out.nuance,
-                    formatScratch(scratch, "Mu%.2f%sR%02XJ%02u", mutate, engineToken, prngByte, jitterInt));
+  out = snapshot_;
+  uiOut = ui_;
 }
 
 const char* DisplaySnapshotBuilder::modeLabel(std::uint8_t mode) {
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 #include "Seed.h"
@@ -46,12 +47,65 @@ public:
 
   // Build the human-facing "what is SeedBox doing right now?" frame used by
   // OLED, simulator, and debugging surfaces.
-  void build(seedbox::DisplaySnapshot& out, UiState& uiOut, const Input& input) const;
+  //
+  // The builder remembers the frame it produced last time.  Each text field is
+  // keyed on the handful of inputs it is printed from, and only fields whose
+  // key moved get formatted again; the rest are copied from the cache.  A
+  // builder that lives as long as AppState therefore pays for what changed
+  // between ticks (usually the callback counter and an LED), not for the
+  // whole screen.  A freshly constructed builder formats everything once.
+  void build(seedbox::DisplaySnapshot& out, UiState& uiOut, const Input& input);
+
+  // Forget the cached text so the next build() formats every field.
+  void invalidate();
+
+  // How many text fields the last build() actually formatted (title, engine
+  // name, two hints, status, metrics, nuance: seven at most).  Tests and the
+  // benchmark use it to prove the cache is doing its job.
+  std::uint8_t lastFormattedFields() const { return lastFormattedFields_; }
 
 private:
+  // Remembers the last inputs a field was formatted from.  changed() stores
+  // the new inputs and reports whether they differ (or whether nothing has
+  // been stored yet).
+  template <typename... Ts>
+  class FieldKey {
+  public:
+    bool changed(const Ts&... values) {
+      const std::tuple<Ts...> next{values...};
+      if (valid_ && next == last_) {
+        return false;
+      }
+      last_ = next;
+      valid_ = true;
+      return true;
+    }
+    void reset() { valid_ = false; }
+
+  private:
+    std::tuple<Ts...> last_{};
+    bool valid_{false};
+  };
+
   static const char* modeLabel(std::uint8_t mode);
   static const char* gateDivisionLabel(std::uint8_t division);
   static const char* primeModeLabel(std::uint8_t primeMode);
   static const char* engineLongName(std::uint8_t engine);
   static std::string_view engineLabel(const EngineRouter& router, std::uint8_t engine);
+
+  seedbox::DisplaySnapshot snapshot_{};
+  UiState ui_{};
+  std::uint8_t lastFormattedFields_{0};
+
+  FieldKey<std::uint32_t> titleKey_;
+  FieldKey<bool, std::uint8_t> engineNameKey_;
+  // mode, page, global lock, focus lock, seeds present, focus engine, prime
+  // bypass, follow clock, prime mode, gate division.
+  FieldKey<std::uint8_t, std::uint8_t, bool, bool, bool, std::uint8_t, bool, bool, std::uint8_t, std::uint8_t> hintsKey_;
+  // The status/metrics/nuance lines change layout with the page, so each key
+  // leads with a layout tag and the remaining slots mean whatever that layout
+  // prints.
+  FieldKey<std::uint8_t, bool, std::uint8_t, std::uint32_t, const void*, float, bool> statusKey_;
+  FieldKey<std::uint8_t, float, float, float, std::size_t, std::uint32_t, char> metricsKey_;
+  FieldKey<std::uint8_t, float, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t> nuanceKey_;
 };
@@ -15,11 +15,7 @@ namespace {
 constexpr hal::io::PinNumber kStatusLedPin = 13;
 }
 
-void DisplayTelemetryService::captureDisplaySnapshot(const AppState& app, AppState::DisplaySnapshot& out,
-                                                     UiState* ui) const {
-  UiState localUi{};
-  UiState* uiOut = ui ? ui : &localUi;
-  DisplaySnapshotBuilder builder;
+DisplaySnapshotBuilder::Input DisplayTelemetryService::gatherInput(const AppState& app) {
   DisplaySnapshotBuilder::Input input{};
   input.masterSeed = app.masterSeed_;
   input.sampleRate = hal::audio::sampleRate();
@@ -47,9 +43,20 @@ void DisplayTelemetryService::captureDisplaySnapshot(const AppState& app, AppSta
   input.seedLock = &app.seedLock_;
   input.schedulerSeed = app.debugScheduledSeed(app.focusSeed_);
   input.granularStats = &app.engines_.granular().stats();
-  // DisplaySnapshotBuilder owns the rendering language; this service just
-  // assembles the truth bundle it needs.
-  builder.build(out, *uiOut, input);
+  return input;
+}
+
+// DisplaySnapshotBuilder owns the rendering language; this service just
+// assembles the truth bundle it needs.
+void DisplayTelemetryService::captureDisplaySnapshot(const AppState& app, AppState::DisplaySnapshot& out,
+                                                     UiState* ui) const {
+  UiState localUi{};
+  DisplaySnapshotBuilder builder;
+  builder.build(out, ui ? *ui : localUi, gatherInput(app));
+}
+
+void DisplayTelemetryService::refreshDisplayCache(AppState& app) const {
+  app.displayBuilder_.build(app.displayCache_, app.uiStateCache_, gatherInput(app));
 }
 
 void DisplayTelemetryService::captureLearnFrame(const AppState& app, AppState::LearnFrame& out) const {
@@ -87,5 +94,6 @@ void DisplayTelemetryService::captureLearnFrame(const AppState& app, AppState::L
   out.generator.primeMode = app.seedPrimeMode_;
   out.generator.tapTempoBpm = app.currentTapTempoBpm();
   out.generator.lastTapIntervalMs = app.tapTempo_.lastIntervalMs();
+  out.generator.tapTempoConfidence = app.tapTempoConfidence();
   out.generator.mutationRate = app.randomnessPanel_.mutationRate;
 }
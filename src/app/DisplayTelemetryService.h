@@ -1,10 +1,19 @@
 #pragma once
 
 #include "app/AppState.h"
+#include "app/DisplaySnapshotBuilder.h"
 
 class DisplayTelemetryService {
 public:
+  // Cold path: a fresh builder formats every field.  Safe to call from any
+  // reader that only holds a const AppState.
   void captureDisplaySnapshot(const AppState& app, AppState::DisplaySnapshot& out, UiState* ui) const;
+  // Warm path: rebuilds AppState's display cache through its persistent
+  // builder, re-formatting only the fields whose inputs moved.
+  void refreshDisplayCache(AppState& app) const;
   void captureLearnFrame(const AppState& app, AppState::LearnFrame& out) const;
+
+private:
+  static DisplaySnapshotBuilder::Input gatherInput(const AppState& app);
 };
 
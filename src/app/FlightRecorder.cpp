@@ -0,0 +1,232 @@
+#include "app/FlightRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if SEEDBOX_HW
+#include <Arduino.h>
+#else
+#include <chrono>
+#include <fstream>
+#endif
+
+namespace {
+constexpr char kMagic[4] = {'S', 'B', 'F', 'R'};
+// Serialized record: 8 + 4 + 4 + 5*4 + 4 + 4 + 2 + 2 + 1 + 1 bytes.
+constexpr std::size_t kRecordBytes = 50;
+constexpr std::size_t kHeaderBytes = 4 + 2 + 2 + 4 + 8 + 4;
+
+template <typename T>
+void put(std::vector<std::uint8_t>& out, T value) {
+  std::uint8_t bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  // Dumps are little-endian; every target we build for already is.
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T get(const std::uint8_t*& cursor) {
+  T value{};
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+}  // namespace
+
+FlightRecorder::FlightRecorder() = default;
+
+void FlightRecorder::noteHostCounters(std::uint32_t midiDropped, std::uint32_t oversizeDrops,
+                                      std::uint32_t commandHighWater) {
+  hostMidiDropped_.store(midiDropped, std::memory_order_relaxed);
+  hostOversizeDrops_.store(oversizeDrops, std::memory_order_relaxed);
+  hostCommandHighWater_.store(commandHighWater, std::memory_order_relaxed);
+}
+
+void FlightRecorder::record(const Record& in) {
+  Record rec = in;
+  const std::uint32_t midiDropped = hostMidiDropped_.load(std::memory_order_relaxed);
+  const std::uint32_t oversizeDrops = hostOversizeDrops_.load(std::memory_order_relaxed);
+  if (midiDropped != seenMidiDropped_) {
+    rec.flags |= kMidiDrop;
+    seenMidiDropped_ = midiDropped;
+  }
+  if (oversizeDrops != seenOversizeDrops_) {
+    rec.flags |= kOversizeDrop;
+    seenOversizeDrops_ = oversizeDrops;
+  }
+  const std::uint32_t highWater = hostCommandHighWater_.load(std::memory_order_relaxed);
+  rec.hostCommandHighWater = static_cast<std::uint16_t>(highWater > 0xFFFFu ? 0xFFFFu : highWater);
+
+  const std::uint32_t index = writeIndex_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[index % kCapacity];
+  const auto lap = static_cast<std::uint32_t>(index / kCapacity);
+  // Odd while writing; 2 * (lap + 1) once this lap's record is complete.
+  slot.sequence.store(2u * lap + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.rec = rec;
+  slot.sequence.store(2u * lap + 2u, std::memory_order_release);
+  writeIndex_.store(index + 1u, std::memory_order_release);
+
+  if ((rec.flags & (kClip | kOverrun)) != 0 && autoDump_.load(std::memory_order_relaxed) &&
+      !dumpPending_.load(std::memory_order_acquire)) {
+    dumpTriggerBlock_ = rec.block;
+    dumpReadyAt_ = index + 1u + kDumpPostRollBlocks;
+    dumpPending_.store(true, std::memory_order_release);
+  }
+}
+
+std::size_t FlightRecorder::snapshot(std::vector<Record>& out) const {
+  out.clear();
+  const std::uint32_t head = writeIndex_.load(std::memory_order_acquire);
+  out.reserve(kCapacity);
+  // Always walk the last kCapacity indices, wrapping below zero if need be.
+  // Slots the writer has not reached yet still hold sequence 0, which no lap
+  // expects, so a young ring and a wrapped one need no special case.
+  for (std::uint32_t back = kCapacity; back > 0; --back) {
+    const std::uint32_t index = head - back;
+    const Slot& slot = slots_[index % kCapacity];
+    const std::uint32_t expected = 2u * static_cast<std::uint32_t>(index / kCapacity) + 2u;
+    const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != expected) {
+      continue;  // never written, being rewritten, or already lapped by the writer
+    }
+    Record copy = slot.rec;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+      continue;
+    }
+    out.push_back(copy);
+  }
+  return out.size();
+}
+
+bool FlightRecorder::takeDumpRequest(std::uint64_t& triggerBlock) {
+  if (!dumpPending_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  // Signed distance, so the test survives the index wrapping mid post-roll.
+  const auto sinceReady = static_cast<std::int32_t>(writeIndex_.load(std::memory_order_acquire) - dumpReadyAt_);
+  if (sinceReady < 0) {
+    return false;  // still collecting post-roll
+  }
+  triggerBlock = dumpTriggerBlock_;
+  dumpPending_.store(false, std::memory_order_release);
+  return true;
+}
+
+std::uint32_t FlightRecorder::stamp() {
+#if SEEDBOX_HW
+  return ARM_DWT_CYCCNT;
+#else
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+}
+
+std::uint32_t FlightRecorder::elapsedNanos(std::uint32_t start) {
+  const std::uint32_t delta = stamp() - start;
+#if SEEDBOX_HW
+  return static_cast<std::uint32_t>((static_cast<std::uint64_t>(delta) * 1000000000ull) / F_CPU_ACTUAL);
+#else
+  return delta;
+#endif
+}
+
+void FlightRecorder::encodeDump(const DumpHeader& header, const std::vector<Record>& records,
+                                std::vector<std::uint8_t>& out) {
+  out.clear();
+  out.reserve(kHeaderBytes + records.size() * kRecordBytes);
+  out.insert(out.end(), kMagic, kMagic + 4);
+  put<std::uint16_t>(out, kDumpVersion);
+  put<std::uint16_t>(out, static_cast<std::uint16_t>(kRecordBytes));
+  put<float>(out, header.sampleRate);
+  put<std::uint64_t>(out, header.triggerBlock);
+  put<std::uint32_t>(out, static_cast<std::uint32_t>(records.size()));
+  for (const Record& rec : records) {
+    put<std::uint64_t>(out, rec.block);
+    put<std::uint32_t>(out, rec.frames);
+    put<std::uint32_t>(out, rec.renderNanos);
+    for (float rms : rec.engineRms) {
+      put<float>(out, rms);
+    }
+    put<float>(out, rec.outputPeak);
+    put<std::uint32_t>(out, rec.triggersFired);
+    put<std::uint16_t>(out, rec.burstQueueDepth);
+    put<std::uint16_t>(out, rec.hostCommandHighWater);
+    put<std::uint8_t>(out, rec.flags);
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(rec.clock));
+  }
+}
+
+bool FlightRecorder::decodeDump(const std::uint8_t* data, std::size_t size, DumpHeader& header,
+                                std::vector<Record>& records) {
+  records.clear();
+  if (!data || size < kHeaderBytes || std::memcmp(data, kMagic, 4) != 0) {
+    return false;
+  }
+  const std::uint8_t* cursor = data + 4;
+  const auto version = get<std::uint16_t>(cursor);
+  const auto recordBytes = get<std::uint16_t>(cursor);
+  if (version != kDumpVersion || recordBytes != kRecordBytes) {
+    return false;
+  }
+  header.sampleRate = get<float>(cursor);
+  header.triggerBlock = get<std::uint64_t>(cursor);
+  const auto count = get<std::uint32_t>(cursor);
+  if (size - kHeaderBytes < static_cast<std::size_t>(count) * kRecordBytes) {
+    return false;
+  }
+  records.resize(count);
+  for (Record& rec : records) {
+    rec.block = get<std::uint64_t>(cursor);
+    rec.frames = get<std::uint32_t>(cursor);
+    rec.renderNanos = get<std::uint32_t>(cursor);
+    for (float& rms : rec.engineRms) {
+      rms = get<float>(cursor);
+    }
+    rec.outputPeak = get<float>(cursor);
+    rec.triggersFired = get<std::uint32_t>(cursor);
+    rec.burstQueueDepth = get<std::uint16_t>(cursor);
+    rec.hostCommandHighWater = get<std::uint16_t>(cursor);
+    rec.flags = get<std::uint8_t>(cursor);
+    rec.clock = static_cast<ClockSource>(get<std::uint8_t>(cursor));
+  }
+  return true;
+}
+
+void FlightRecorder::appendCsv(const std::vector<Record>& records, std::string& out) {
+  out += "block,frames,render_ns,sampler_rms,granular_rms,resonator_rms,euclid_rms,burst_rms,peak,triggers,"
+         "burst_queue,host_queue_hw,flags,clock\n";
+  char line[256];
+  for (const Record& rec : records) {
+    std::snprintf(line, sizeof(line), "%llu,%lu,%lu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%lu,%u,%u,%u,%u\n",
+                  static_cast<unsigned long long>(rec.block), static_cast<unsigned long>(rec.frames),
+                  static_cast<unsigned long>(rec.renderNanos), static_cast<double>(rec.engineRms[0]),
+                  static_cast<double>(rec.engineRms[1]), static_cast<double>(rec.engineRms[2]),
+                  static_cast<double>(rec.engineRms[3]), static_cast<double>(rec.engineRms[4]),
+                  static_cast<double>(rec.outputPeak), static_cast<unsigned long>(rec.triggersFired),
+                  static_cast<unsigned>(rec.burstQueueDepth), static_cast<unsigned>(rec.hostCommandHighWater),
+                  static_cast<unsigned>(rec.flags), static_cast<unsigned>(rec.clock));
+    out += line;
+  }
+}
+
+#if !SEEDBOX_HW
+bool FlightRecorder::writeDumpFile(const std::string& path, DumpFormat format, const DumpHeader& header,
+                                   const std::vector<Record>& records) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    return false;
+  }
+  if (format == DumpFormat::kCsv) {
+    std::string text;
+    appendCsv(records, text);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+  } else {
+    std::vector<std::uint8_t> bytes;
+    encodeDump(header, records, bytes);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  }
+  return out.good();
+}
+#endif
@@ -0,0 +1,145 @@
+#pragma once
+
+//
+// FlightRecorder
+// --------------
+// A black box for the audio thread.  Every rendered block leaves one small
+// Record in a fixed ring: how long the block took, how loud each engine was,
+// how many triggers fired since the last block, queue depths, clip/overrun
+// flags and who owned the clock.  The point-in-time diagnostics tell you *that*
+// a glitch happened; the ring tells you what the last second or so looked like
+// when it did.
+//
+// Concurrency: exactly one writer (the audio callback) and any number of
+// readers.  Each slot carries a sequence word that is odd while the writer is
+// inside it, so a reader copies the payload and keeps it only if the sequence
+// was even and unchanged on both sides of the copy.  Nothing locks, nothing
+// allocates after construction, and a slow reader can only lose the oldest
+// records, never stall the writer.  Shared counters are 32 bits, because a
+// Cortex-M7 has no lock-free 64-bit atomics; the write index wraps after 2^32
+// blocks (months of 128-frame blocks) and every comparison is wrap-aware.
+//
+// Post-mortem dumps: when auto-dump is armed, a record flagged as clipping or
+// overrunning raises a dump request.  The control thread (tick() on the sim,
+// host maintenance on JUCE) notices it once a few post-roll blocks have landed
+// and writes the ring out, so the dump shows the lead-up *and* the aftermath.
+// The audio thread never touches files.
+//
+// Dumps come in two flavours: a compact binary (`SBFR` header plus little-endian
+// records, read by tools/flight_recorder_view.cpp) and CSV for spreadsheets.
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SeedBoxConfig.h"
+
+class FlightRecorder {
+public:
+  static constexpr std::size_t kCapacity = 512;  // ~1.4 s of 128-frame blocks at 48 kHz
+  static constexpr std::size_t kEngineSlots = 5;  // sampler, granular, resonator, euclid, burst
+  static constexpr std::uint32_t kDumpPostRollBlocks = 32;
+  static constexpr std::uint16_t kDumpVersion = 1;
+
+  enum Flag : std::uint8_t {
+    kClip = 1u << 0,
+    kLimiter = 1u << 1,
+    kOverrun = 1u << 2,        // block took longer than its own duration
+    kOversizeDrop = 1u << 3,   // host dropped an oversize block since the last record
+    kMidiDrop = 1u << 4,       // host dropped MIDI since the last record
+    kTestTone = 1u << 5,
+  };
+
+  enum class ClockSource : std::uint8_t { kInternal = 0, kExternal, kWaiting };
+  enum class DumpFormat : std::uint8_t { kBinary = 0, kCsv };
+
+  struct Record {
+    std::uint64_t block{0};  // audio callback count
+    std::uint32_t frames{0};
+    std::uint32_t renderNanos{0};
+    std::array<float, kEngineSlots> engineRms{};
+    float outputPeak{0.0f};
+    std::uint32_t triggersFired{0};  // since the previous record
+    std::uint16_t burstQueueDepth{0};
+    std::uint16_t hostCommandHighWater{0};  // filled in by record()
+    std::uint8_t flags{0};
+    ClockSource clock{ClockSource::kInternal};
+  };
+
+  struct DumpHeader {
+    float sampleRate{0.0f};
+    std::uint64_t triggerBlock{0};  // 0 for on-demand dumps
+  };
+
+  FlightRecorder();
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  // Audio thread only.  Host queue depth and the host drop flags come from
+  // noteHostCounters(), so callers leave those fields alone.
+  void record(const Record& rec);
+
+  // Control thread: latest host-side counters.  record() turns any increase in
+  // the drop counters into kMidiDrop / kOversizeDrop on the next record.
+  void noteHostCounters(std::uint32_t midiDropped, std::uint32_t oversizeDrops, std::uint32_t commandHighWater);
+
+  // Any thread.  Oldest first; at most kCapacity records.
+  std::size_t snapshot(std::vector<Record>& out) const;
+  // Records written so far, modulo 2^32.
+  std::uint32_t recorded() const { return writeIndex_.load(std::memory_order_acquire); }
+
+  // Auto-dump arming.  A request raised while another is pending is folded
+  // into the first one.
+  void setAutoDump(bool enabled) { autoDump_.store(enabled, std::memory_order_relaxed); }
+  bool autoDump() const { return autoDump_.load(std::memory_order_relaxed); }
+  // Per-engine levels cost a full-buffer pass after every engine render, so
+  // handleAudio() only takes them while this is on; otherwise engineRms stays
+  // zero and the rest of the record is filled as usual.
+  void setEngineMetering(bool enabled) { engineMetering_.store(enabled, std::memory_order_relaxed); }
+  bool engineMetering() const { return engineMetering_.load(std::memory_order_relaxed); }
+  // Control thread: true once a pending request has its post-roll, handing
+  // back the block that triggered it and clearing the request.
+  bool takeDumpRequest(std::uint64_t& triggerBlock);
+
+  // Stopwatch for renderNanos: DWT cycles on Teensy, steady_clock elsewhere.
+  static std::uint32_t stamp();
+  static std::uint32_t elapsedNanos(std::uint32_t start);
+
+  // Serialisation shared with the viewer tool.
+  static void encodeDump(const DumpHeader& header, const std::vector<Record>& records, std::vector<std::uint8_t>& out);
+  static bool decodeDump(const std::uint8_t* data, std::size_t size, DumpHeader& header, std::vector<Record>& records);
+  static void appendCsv(const std::vector<Record>& records, std::string& out);
+#if !SEEDBOX_HW
+  // Desktop only: the firmware has no business opening files from here.
+  static bool writeDumpFile(const std::string& path, DumpFormat format, const DumpHeader& header,
+                            const std::vector<Record>& records);
+#endif
+
+private:
+  struct Slot {
+    std::atomic<std::uint32_t> sequence{0};
+    Record rec{};
+  };
+
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "FlightRecorder needs lock-free 32-bit atomics");
+  // The slot and lap maths below rely on 2^32 being a whole number of laps.
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+  std::array<Slot, kCapacity> slots_{};
+  std::atomic<std::uint32_t> writeIndex_{0};
+  std::atomic<bool> autoDump_{false};
+  std::atomic<bool> engineMetering_{false};
+  std::atomic<bool> dumpPending_{false};
+  // Handed over by dumpPending_: the writer fills these only while it is
+  // false, the control thread reads them only while it is true.
+  std::uint64_t dumpTriggerBlock_{0};
+  std::uint32_t dumpReadyAt_{0};
+  std::atomic<std::uint32_t> hostMidiDropped_{0};
+  std::atomic<std::uint32_t> hostOversizeDrops_{0};
+  std::atomic<std::uint32_t> hostCommandHighWater_{0};
+  // Writer-side memory of the counters above.
+  std::uint32_t seenMidiDropped_{0};
+  std::uint32_t seenOversizeDrops_{0};
+};
@@ -75,7 +75,10 @@ void GateQuantizeService::applyQuantizeControl(AppState& app, std::uint8_t value
 
   const std::uint8_t rawScaleIndex = static_cast<std::uint8_t>(value / 32);
   const std::uint8_t rawRoot = static_cast<std::uint8_t>(value % 12);
-  const std::uint8_t sanitizedScaleIndex = std::min<std::uint8_t>(rawScaleIndex, static_cast<std::uint8_t>(4));
+  const std::uint8_t maxScaleIndex =
+      app.quantizeCustomScale_.mask() != 0 ? AppState::kQuantizeCustomScaleIndex
+                                  : static_cast<std::uint8_t>(AppState::kQuantizeCustomScaleIndex - 1);
+  const std::uint8_t sanitizedScaleIndex = std::min<std::uint8_t>(rawScaleIndex, maxScaleIndex);
   const std::uint8_t sanitizedRoot = static_cast<std::uint8_t>(rawRoot % 12);
   app.quantizeScaleIndex_ = sanitizedScaleIndex;
   app.quantizeRoot_ = sanitizedRoot;
@@ -87,28 +90,33 @@ void GateQuantizeService::applyQuantizeControl(AppState& app, std::uint8_t value
     return;
   }
 
-  util::ScaleQuantizer::Scale scale = util::ScaleQuantizer::Scale::kChromatic;
+  // Built-in scales share prebuilt tables; the custom slot was compiled when
+  // its mask was loaded.
+  const util::ScaleQuantizer::Table* table = nullptr;
   switch (sanitizedScaleIndex) {
     case 1:
-      scale = util::ScaleQuantizer::Scale::kMajor;
+      table = &util::ScaleQuantizer::TableFor(util::ScaleQuantizer::Scale::kMajor);
       break;
     case 2:
-      scale = util::ScaleQuantizer::Scale::kMinor;
+      table = &util::ScaleQuantizer::TableFor(util::ScaleQuantizer::Scale::kMinor);
       break;
     case 3:
-      scale = util::ScaleQuantizer::Scale::kPentatonicMajor;
+      table = &util::ScaleQuantizer::TableFor(util::ScaleQuantizer::Scale::kPentatonicMajor);
       break;
     case 4:
-      scale = util::ScaleQuantizer::Scale::kPentatonicMinor;
+      table = &util::ScaleQuantizer::TableFor(util::ScaleQuantizer::Scale::kPentatonicMinor);
+      break;
+    case AppState::kQuantizeCustomScaleIndex:
+      table = &app.quantizeCustomScale_;
       break;
     case 0:
     default:
-      scale = util::ScaleQuantizer::Scale::kChromatic;
+      table = &util::ScaleQuantizer::TableFor(util::ScaleQuantizer::Scale::kChromatic);
       break;
   }
 
   Seed& seed = app.seeds_[idx];
-  const float quantized = util::ScaleQuantizer::SnapToScale(seed.pitch, sanitizedRoot, scale);
+  const float quantized = table->snap(seed.pitch, sanitizedRoot, util::QuantizerMode::kNearest);
   if (quantized != seed.pitch) {
     // Quantize is a real seed mutation, so the scheduler and engine cache have
     // to be refreshed immediately after the pitch snap.
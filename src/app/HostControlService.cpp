@@ -5,6 +5,7 @@
 #include "app/AppState.h"
 #include "engine/Granular.h"
 #include "hal/hal_audio.h"
+#include "util/ScaleQuantizer.h"
 
 // HostControlService is the DAW/editor handshake layer. It keeps external UI
 // commands thin and predictable so host automation touches the same runtime
@@ -18,6 +19,17 @@ void HostControlService::applyQuantizeControl(AppState& app, std::uint8_t value)
   app.applyQuantizeControl(value);
 }
 
+void HostControlService::setQuantizeScaleMask(AppState& app, std::uint16_t mask) const {
+  // Loading a mask only arms the custom slot; pitches move the next time the
+  // Quantize control lands on it.  Clearing the mask while it is selected
+  // falls back to chromatic so the index never points at nothing.
+  app.quantizeCustomScale_ = util::ScaleQuantizer::Table(mask);
+  if (app.quantizeCustomScale_.mask() == 0 && app.quantizeScaleIndex_ == AppState::kQuantizeCustomScaleIndex) {
+    app.quantizeScaleIndex_ = 0;
+  }
+  app.displayDirty_ = true;
+}
+
 void HostControlService::setDebugMetersEnabled(AppState& app, bool enabled) const {
   if (app.debugMetersEnabled_ == enabled) {
     return;
@@ -73,11 +85,16 @@ void HostControlService::setHostDiagnostics(AppState& app,
   // here on the non-audio maintenance path so every consumer sees one shared
   // diagnostics snapshot instead of plugin- or standalone-local side channels.
   app.hostDiagnostics_ = host;
+  // The flight recorder reads its copy from the audio thread, so it gets the
+  // counters it cares about through atomics rather than this plain struct.
+  app.flightRecorder_.noteHostCounters(host.midiDroppedCount, host.oversizeBlockDropCount,
+                                       host.commandQueueHighWater);
 }
 
 AppState::DiagnosticsSnapshot HostControlService::diagnosticsSnapshot(const AppState& app) const {
   AppState::DiagnosticsSnapshot snap{};
   snap.host = app.hostDiagnostics_;
+  snap.runtimeLoop = app.runtimeLoopDiagnostics_;
   snap.scheduler = app.scheduler_.diagnostics();
   snap.audioCallbackCount = app.audioRuntime_.audioCallbackCount();
   return snap;
@@ -11,6 +11,7 @@ public:
   // automation-friendly units.
   void setSwingPercent(AppState& app, float value) const;
   void applyQuantizeControl(AppState& app, std::uint8_t value) const;
+  void setQuantizeScaleMask(AppState& app, std::uint16_t mask) const;
   void setDebugMetersEnabled(AppState& app, bool enabled) const;
   void setTransportLatch(AppState& app, bool enabled) const;
   void setFollowExternalClock(AppState& app, bool enabled) const;
@@ -178,7 +178,9 @@ void InputEvents::flushPendingPresses(std::uint64_t now) {
       evt.type = Type::ButtonPress;
       evt.primaryButton = id;
       evt.buttons = {id};
-      evt.timestampUs = now;
+      // Stamp the press itself, not the flush: tap tempo measures between
+      // presses and must not inherit the double-press wait.
+      evt.timestampUs = it->second;
       emit(std::move(evt));
     }
     it = pending_presses_.erase(it);
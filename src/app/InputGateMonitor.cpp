@@ -95,6 +95,7 @@ void InputGateMonitor::updateInputGateState(float rms, float peak) {
   const bool hot = (rms >= floor_) || (peak >= floor_);
   if (hot && !hot_) {
     gateEdgePending_ = true;
+    ++onsetCount_;
   }
   hot_ = hot;
 }
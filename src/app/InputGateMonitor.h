@@ -10,6 +10,9 @@ class InputGateMonitor {
   float peak() const { return peak_; }
   bool hot() const { return hot_; }
   bool gateEdgePending() const { return gateEdgePending_; }
+  // Rising edges seen so far.  Unlike gateEdgePending() nobody consumes it, so
+  // the capture ring can mark onsets without stealing the scheduler's gate.
+  std::uint32_t onsetCount() const { return onsetCount_; }
 
   void setDryInput(const float* left, const float* right, std::size_t frames);
   void refreshFromDryInput(std::size_t probeFrames);
@@ -25,6 +28,9 @@ class InputGateMonitor {
     lastGateTick_ = tick;
     gateEdgePending_ = false;
   }
+  // Count the next division from `tick` (a freshly tapped downbeat) without
+  // dropping an edge that is already waiting for it.
+  void alignGateTick(std::uint64_t tick) { lastGateTick_ = tick; }
 
  private:
   void updateInputGateState(float rms, float peak);
@@ -34,6 +40,7 @@ class InputGateMonitor {
   float peak_{0.0f};
   bool hot_{false};
   bool gateEdgePending_{false};
+  std::uint32_t onsetCount_{0};
   std::uint64_t lastGateTick_{0};
   const float* dryLeft_{nullptr};
   const float* dryRight_{nullptr};
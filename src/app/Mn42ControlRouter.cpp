@@ -155,6 +155,9 @@ bool Mn42ControlRouter::applyParamControl(AppState& app, std::uint8_t controller
     // engine focus cache so the next audio block reflects the new gesture.
     app.scheduler_.updateSeed(idx, seed);
     app.engines_.onSeed(seed);
+    // Voices already ringing glide to the new tone/spread instead of
+    // stepping, so a CC sweep does not zipper.
+    app.engines_.glideSeedParams(seed);
     app.displayDirty_ = true;
   }
   return true;
@@ -227,11 +227,13 @@ void ModeEventRouter::handleSeedsEvent(AppState& app, const InputEvents::Event&
       eventHasButton(evt, hal::Board::ButtonID::AltSeed)) {
     // Quantize scale selection lives here so the physical surface and the MN-42
     // remote surface both speak the same scale/root control language.
-    constexpr int kScaleCount = 5;
+    // A loaded custom mask adds one more stop to the rotation.
+    const int scaleCount = app.quantizeCustomScale_.mask() != 0 ? AppState::kQuantizeCustomScaleIndex + 1
+                                                       : AppState::kQuantizeCustomScaleIndex;
     int next = static_cast<int>(app.quantizeScaleIndex_) + static_cast<int>(evt.encoderDelta);
-    next %= kScaleCount;
+    next %= scaleCount;
     if (next < 0) {
-      next += kScaleCount;
+      next += scaleCount;
     }
     app.quantizeScaleIndex_ = static_cast<uint8_t>(next);
     const uint8_t controlValue = static_cast<uint8_t>((app.quantizeScaleIndex_ * 32u) + (app.quantizeRoot_ % 12u));
@@ -278,12 +280,14 @@ void ModeEventRouter::handleEngineEvent(AppState& app, const InputEvents::Event&
 
   if (evt.type == InputEvents::Type::EncoderTurn && evt.encoderDelta != 0 && engineId == EngineRouter::kEuclidId) {
     // Euclid gets a page-local mini control surface: steps, fills, and rotate.
+    // Each seed owns its own lane, so the nudges start from that lane's values.
     Engine::ParamChange change{};
     change.seedId = seed.id;
+    const std::size_t lane = EuclidEngine::LaneForSeed(seed.id);
     switch (evt.encoder) {
       case hal::Board::EncoderID::Density: {
         change.id = static_cast<std::uint16_t>(EuclidEngine::Param::kSteps);
-        change.value = static_cast<std::int32_t>(app.engines_.euclid().steps()) +
+        change.value = static_cast<std::int32_t>(app.engines_.euclid().steps(lane)) +
                        (evt.encoderDelta * 1);
         app.engines_.euclid().onParam(change);
         app.displayDirty_ = true;
@@ -291,7 +295,7 @@ void ModeEventRouter::handleEngineEvent(AppState& app, const InputEvents::Event&
       }
       case hal::Board::EncoderID::ToneTilt: {
         change.id = static_cast<std::uint16_t>(EuclidEngine::Param::kFills);
-        change.value = static_cast<std::int32_t>(app.engines_.euclid().fills()) +
+        change.value = static_cast<std::int32_t>(app.engines_.euclid().fills(lane)) +
                        (evt.encoderDelta * 1);
         app.engines_.euclid().onParam(change);
         app.displayDirty_ = true;
@@ -299,7 +303,7 @@ void ModeEventRouter::handleEngineEvent(AppState& app, const InputEvents::Event&
       }
       case hal::Board::EncoderID::FxMutate: {
         change.id = static_cast<std::uint16_t>(EuclidEngine::Param::kRotate);
-        change.value = static_cast<std::int32_t>(app.engines_.euclid().rotate()) +
+        change.value = static_cast<std::int32_t>(app.engines_.euclid().rotate(lane)) +
                        (evt.encoderDelta * 1);
         app.engines_.euclid().onParam(change);
         app.displayDirty_ = true;
@@ -0,0 +1,186 @@
+#include "app/NativeRuntimeLoop.h"
+
+#if !SEEDBOX_HW
+
+#include <cmath>
+#include <utility>
+
+NativeRuntimeLoop::NativeRuntimeLoop(TimeMode mode)
+    : mode_(mode), origin_(std::chrono::steady_clock::now()) {}
+
+NativeRuntimeLoop::TimerId NativeRuntimeLoop::addTimer(Nanos period, Callback callback) {
+  Timer timer{};
+  timer.period = period ? period : 1u;
+  timer.deadline = now() + timer.period;
+  timer.callback = std::move(callback);
+  timers_.push_back(std::move(timer));
+  return timers_.size() - 1u;
+}
+
+void NativeRuntimeLoop::setTimerPeriod(TimerId id, Nanos period) {
+  if (id >= timers_.size() || period == 0) {
+    return;
+  }
+  Timer& timer = timers_[id];
+  if (timer.period == period) {
+    return;
+  }
+  // Re-anchor on the deadline already booked so a tempo change never lands in
+  // the past or double-fires.
+  timer.deadline = timer.deadline - timer.period + period;
+  timer.period = period;
+}
+
+void NativeRuntimeLoop::post(Callback event) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(std::move(event));
+  }
+  wake_.notify_one();
+}
+
+void NativeRuntimeLoop::requestStop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true, std::memory_order_relaxed);
+  }
+  wake_.notify_one();
+}
+
+void NativeRuntimeLoop::run() { runUntil(kForever); }
+
+void NativeRuntimeLoop::runFor(Nanos duration) {
+  const Nanos start = now();
+  runUntil(duration >= kForever - start ? kForever : start + duration);
+}
+
+NativeRuntimeLoop::Nanos NativeRuntimeLoop::now() const {
+  if (mode_ == TimeMode::kVirtual) {
+    return virtualNow_;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - origin_;
+  return static_cast<Nanos>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void NativeRuntimeLoop::advanceVirtual(Nanos cost) {
+  if (mode_ == TimeMode::kVirtual) {
+    virtualNow_ += cost;
+  }
+}
+
+NativeRuntimeLoop::Nanos NativeRuntimeLoop::periodForFrames(std::size_t frames, float sampleRate) {
+  if (frames == 0 || !(sampleRate > 0.0f)) {
+    return 0;
+  }
+  return static_cast<Nanos>(std::llround(static_cast<double>(frames) * 1.0e9 / static_cast<double>(sampleRate)));
+}
+
+NativeRuntimeLoop::Nanos NativeRuntimeLoop::periodForTicks(float bpm, float ticksPerBeat) {
+  if (!(bpm > 0.0f) || !(ticksPerBeat > 0.0f)) {
+    return 0;
+  }
+  const double ticksPerSecond = static_cast<double>(bpm) / 60.0 * static_cast<double>(ticksPerBeat);
+  return static_cast<Nanos>(std::llround(1.0e9 / ticksPerSecond));
+}
+
+void NativeRuntimeLoop::runUntil(Nanos limit) {
+  accountedUpTo_ = now();
+  while (!stop_.load(std::memory_order_relaxed)) {
+    accountElapsed();
+    if (drainEvents()) {
+      continue;  // events may have added work or asked us to stop
+    }
+    Timer* next = nullptr;
+    for (Timer& timer : timers_) {
+      // Ties go to the timer added first, so fire order is reproducible.
+      if (!next || timer.deadline < next->deadline) {
+        next = &timer;
+      }
+    }
+    const Nanos deadline = next ? next->deadline : kForever;
+    if (deadline > limit) {
+      if (now() >= limit) {
+        break;
+      }
+      waitUntil(limit);
+      continue;
+    }
+    if (now() < deadline) {
+      waitUntil(deadline);
+      continue;
+    }
+    fire(*next);
+  }
+  accountElapsed();
+  // A stop request is consumed by the run it ended.
+  stop_.store(false, std::memory_order_relaxed);
+}
+
+void NativeRuntimeLoop::accountElapsed() {
+  const Nanos at = now();
+  stats_.elapsedNanos += at - accountedUpTo_;
+  accountedUpTo_ = at;
+}
+
+bool NativeRuntimeLoop::drainEvents() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty()) {
+      return false;
+    }
+    draining_.swap(pending_);
+  }
+  for (Callback& event : draining_) {
+    const Nanos begin = now();
+    if (event) {
+      event();
+    }
+    stats_.busyNanos += now() - begin;
+    ++stats_.eventsRun;
+  }
+  draining_.clear();
+  return true;
+}
+
+void NativeRuntimeLoop::waitUntil(Nanos deadline) {
+  ++stats_.wakeups;
+  if (mode_ == TimeMode::kVirtual && deadline != kForever) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty() && !stop_.load(std::memory_order_relaxed)) {
+      virtualNow_ = deadline;
+    }
+    return;
+  }
+  // Real time, or virtual time with nothing scheduled: only another thread can
+  // give us work, so block for it.
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto ready = [this] { return !pending_.empty() || stop_.load(std::memory_order_relaxed); };
+  if (deadline == kForever) {
+    wake_.wait(lock, ready);
+  } else {
+    wake_.wait_until(lock, origin_ + std::chrono::nanoseconds(deadline), ready);
+  }
+}
+
+void NativeRuntimeLoop::fire(Timer& timer) {
+  const Nanos begin = now();
+  const Nanos lateness = begin - timer.deadline;
+  if (lateness > stats_.worstLatenessNanos) {
+    stats_.worstLatenessNanos = lateness;
+  }
+  Nanos next = timer.deadline + timer.period;
+  if (lateness >= timer.period) {
+    const Nanos skipped = lateness / timer.period;
+    ++stats_.deadlineMisses;
+    stats_.skippedPeriods += skipped;
+    next += skipped * timer.period;
+  }
+  timer.deadline = next;
+  ++stats_.timerFires;
+  if (timer.callback) {
+    timer.callback();
+  }
+  stats_.busyNanos += now() - begin;
+}
+
+#endif  // !SEEDBOX_HW
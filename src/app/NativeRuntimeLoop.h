@@ -0,0 +1,134 @@
+#pragma once
+
+//
+// NativeRuntimeLoop
+// -----------------
+// The desktop stand-in for the Teensy's "interrupts wake us up" life-cycle.
+// The old native `main()` spun `loop()` as fast as the CPU allowed, which pins a
+// core on a headless box and still says nothing about *when* a tick happens.
+// This loop keeps a handful of periodic timers (control tick, audio block, ...)
+// on a fixed deadline grid and sleeps on a condition variable until the
+// earliest deadline or until another thread posts a control event.
+//
+// Deadlines are `start + k * period`, never "now + period", so jitter in one
+// wake-up does not slide every later tick.  If a timer fires a whole period (or
+// more) late, that is a deadline miss: it is counted, the skipped periods are
+// dropped, and the timer re-joins its grid instead of bursting to catch up.
+//
+// Virtual time: with TimeMode::kVirtual nothing ever sleeps.  The clock jumps
+// straight to the next deadline, and only moves otherwise when a callback
+// charges itself with advanceVirtual().  Same inputs, same fire order, same
+// stats on every machine — which is what tests want.
+//
+// Threading: run()/runFor() and everything they call belong to one thread.
+// post() and requestStop() are safe from anywhere.
+#include "SeedBoxConfig.h"
+
+#if !SEEDBOX_HW
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+class NativeRuntimeLoop {
+public:
+  enum class TimeMode : std::uint8_t { kRealTime = 0, kVirtual };
+
+  using Nanos = std::uint64_t;
+  using TimerId = std::size_t;
+  using Callback = std::function<void()>;
+
+  struct Stats {
+    std::uint64_t wakeups{0};         // times the loop went to sleep and came back
+    std::uint64_t timerFires{0};
+    std::uint64_t eventsRun{0};
+    std::uint64_t deadlineMisses{0};  // fires that landed a full period or more late
+    std::uint64_t skippedPeriods{0};  // periods dropped to re-join the grid
+    Nanos worstLatenessNanos{0};
+    Nanos busyNanos{0};     // time spent inside callbacks
+    Nanos elapsedNanos{0};  // loop time covered by run()/runFor(), kept current while they run
+
+    // Share of the covered time spent working; the rest was spent asleep.
+    float loadPercent() const {
+      return elapsedNanos ? static_cast<float>(static_cast<double>(busyNanos) * 100.0 / static_cast<double>(elapsedNanos))
+                          : 0.0f;
+    }
+  };
+
+  static constexpr Nanos kNanosPerSecond = 1000000000ull;
+
+  explicit NativeRuntimeLoop(TimeMode mode = TimeMode::kRealTime);
+  NativeRuntimeLoop(const NativeRuntimeLoop&) = delete;
+  NativeRuntimeLoop& operator=(const NativeRuntimeLoop&) = delete;
+
+  // Setup: a timer first fires one period after it is added.
+  TimerId addTimer(Nanos period, Callback callback);
+  // Loop thread: takes effect from the timer's next deadline.
+  void setTimerPeriod(TimerId id, Nanos period);
+
+  // Any thread.  Events run on the loop thread, in post order, before the next
+  // timer is considered.
+  void post(Callback event);
+  void requestStop();
+
+  // Loop thread.  run() returns once requestStop() is seen; runFor() also
+  // returns when `duration` of loop time has passed.
+  void run();
+  void runFor(Nanos duration);
+
+  // Loop time since construction.
+  Nanos now() const;
+  // Virtual mode only: account for `cost` of work done inside a callback.
+  void advanceVirtual(Nanos cost);
+
+  TimeMode mode() const { return mode_; }
+  // Safe to read from inside a callback: elapsedNanos is brought up to date on
+  // every pass, not only when run() returns (which, for main(), is never).
+  const Stats& stats() const { return stats_; }
+  void resetStats() {
+    stats_ = Stats{};
+    accountedUpTo_ = now();
+  }
+
+  // Helpers for the usual periods.
+  static Nanos periodForFrames(std::size_t frames, float sampleRate);
+  static Nanos periodForTicks(float bpm, float ticksPerBeat = 24.0f);
+
+private:
+  struct Timer {
+    Nanos period{0};
+    Nanos deadline{0};
+    Callback callback{};
+  };
+
+  static constexpr Nanos kForever = std::numeric_limits<Nanos>::max();
+
+  void runUntil(Nanos limit);
+  // Charge the loop time since the last call to stats_.elapsedNanos.
+  void accountElapsed();
+  bool drainEvents();
+  // Sleep until `deadline` or until an event/stop arrives.
+  void waitUntil(Nanos deadline);
+  void fire(Timer& timer);
+
+  TimeMode mode_;
+  std::chrono::steady_clock::time_point origin_;
+  Nanos virtualNow_{0};
+  Nanos accountedUpTo_{0};
+  std::vector<Timer> timers_{};
+  Stats stats_{};
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::vector<Callback> pending_{};
+  std::vector<Callback> draining_{};
+  std::atomic<bool> stop_{false};
+};
+
+#endif  // !SEEDBOX_HW
@@ -0,0 +1,54 @@
+#include "app/NativeSimRunner.h"
+
+#if !SEEDBOX_HW
+
+#include "app/AppState.h"
+#include "app/NativeRuntimeLoop.h"
+#include "hal/hal_audio.h"
+
+NativeSimRunner::NativeSimRunner(AppState& app) : NativeSimRunner(app, Options{}) {}
+
+NativeSimRunner::NativeSimRunner(AppState& app, const Options& options)
+    : app_(app), options_(options), left_(options.audioFrames), right_(options.audioFrames) {}
+
+NativeSimRunner::Stats NativeSimRunner::run(const hal::NativeScript& script, std::uint64_t tailMicros) {
+  hal::nativeBoardLoadScript(script);
+  Stats stats = simulate(script.duration_us + tailMicros);
+  // The run always reaches the script's end, so every event has come due.  An
+  // edge queued behind an unsampled one for the same button lands on the next
+  // tick, which is why a tap at the very end wants a little tail.
+  stats.scriptEvents = script.events.size();
+  return stats;
+}
+
+NativeSimRunner::Stats NativeSimRunner::runFor(std::uint64_t micros) { return simulate(micros); }
+
+NativeSimRunner::Stats NativeSimRunner::simulate(std::uint64_t micros) {
+  Stats stats{};
+  hal::Board& board = hal::nativeBoard();
+  const std::uint64_t startUs = board.nowMicros();
+
+  NativeRuntimeLoop loop(NativeRuntimeLoop::TimeMode::kVirtual);
+  NativeRuntimeLoop::TimerId control = 0;
+  control = loop.addTimer(NativeRuntimeLoop::periodForTicks(app_.schedulerBpm()), [&]() {
+    hal::nativeBoardAdvanceTo(startUs + loop.now() / 1000u);
+    app_.tick();
+    ++stats.ticks;
+    // Tempo can change mid-script (tap, encoder, reseed); follow it.
+    loop.setTimerPeriod(control, NativeRuntimeLoop::periodForTicks(app_.schedulerBpm()));
+  });
+  if (options_.audioFrames > 0) {
+    loop.addTimer(NativeRuntimeLoop::periodForFrames(options_.audioFrames, hal::audio::sampleRate()), [&]() {
+      hal::audio::renderHostBuffer(left_.data(), right_.data(), options_.audioFrames);
+      ++stats.audioBlocks;
+    });
+  }
+  loop.runFor(micros * 1000u);
+  // Land exactly on the requested end so the next run picks up from there.
+  hal::nativeBoardAdvanceTo(startUs + micros);
+
+  stats.simulatedMicros = micros;
+  return stats;
+}
+
+#endif  // !SEEDBOX_HW
@@ -0,0 +1,67 @@
+#pragma once
+
+//
+// NativeSimRunner
+// ---------------
+// Fast-forward simulation for scripted panel sessions.  Feeding lines through
+// `nativeBoardFeed()` and calling tick() in a loop ties board time to the
+// 10 ms poll step, so an hour of UI soak costs an hour's worth of polls and
+// still cannot say exactly when a press landed.  The runner instead:
+//
+//   1. loads a compiled hal::NativeScript onto the native board,
+//   2. drives a virtual-time NativeRuntimeLoop with the control tick (24 PPQN
+//      at whatever tempo AppState currently runs) and the audio block cadence,
+//   3. before every control tick jumps the board clock straight to the loop's
+//      time, so due script events land with their own timestamps.  A button
+//      gets at most one new edge per tick; a tap shorter than a tick shows its
+//      down on one tick and its up on the next instead of cancelling out.
+//
+// Nothing sleeps and nothing depends on the host's speed: the same script and
+// the same boot give the same tick count, the same gestures and the same UI
+// state on every machine.  The scheduler and audio keep ticking between events
+// exactly as they would live; only the waiting is gone.
+#include "SeedBoxConfig.h"
+
+#if !SEEDBOX_HW
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hal/Board.h"
+
+class AppState;
+
+class NativeSimRunner {
+public:
+  struct Options {
+    std::size_t audioFrames{128};  // frames per rendered block; 0 disables audio
+  };
+
+  struct Stats {
+    std::uint64_t ticks{0};          // AppState::tick() calls
+    std::uint64_t audioBlocks{0};    // blocks rendered through hal::audio
+    std::uint64_t scriptEvents{0};   // timeline events delivered by run()
+    std::uint64_t simulatedMicros{0};
+  };
+
+  // `app` must already be booted (initSim()) on hal::nativeBoard().
+  explicit NativeSimRunner(AppState& app);
+  NativeSimRunner(AppState& app, const Options& options);
+
+  // Load `script` at the current board time and run until its last event plus
+  // `tailMicros` of idle time (for gestures that resolve after release).
+  Stats run(const hal::NativeScript& script, std::uint64_t tailMicros = 0);
+  // Keep simulating with no new script input.
+  Stats runFor(std::uint64_t micros);
+
+private:
+  Stats simulate(std::uint64_t micros);
+
+  AppState& app_;
+  Options options_;
+  std::vector<float> left_;
+  std::vector<float> right_;
+};
+
+#endif  // !SEEDBOX_HW
@@ -39,6 +39,10 @@ std::vector<std::uint8_t> Preset::serialize() const {
   clockObj["debugMeters"] = clock.debugMeters;
   clockObj["transportLatch"] = clock.transportLatch;
   doc["page"] = static_cast<std::uint8_t>(page);
+  JsonObject quantizeObj = doc["quantize"].to<JsonObject>();
+  quantizeObj["scale"] = quantize.scaleIndex;
+  quantizeObj["root"] = quantize.root;
+  quantizeObj["mask"] = quantize.scaleMask;
 
   JsonArray enginesArr = doc["engineSelections"].to<JsonArray>();
   for (std::uint8_t v : engineSelections) {
@@ -113,6 +117,13 @@ bool Preset::deserialize(const std::vector<std::uint8_t>& bytes, Preset& out) {
     next.clock.debugMeters = clockObj["debugMeters"].as<bool>();
     next.clock.transportLatch = clockObj["transportLatch"].as<bool>();
   }
+  // Older presets predate quantize settings; a missing object keeps defaults.
+  JsonObject quantizeObj = doc["quantize"].as<JsonObject>();
+  if (!quantizeObj.isNull()) {
+    next.quantize.scaleIndex = quantizeObj["scale"].as<std::uint8_t>();
+    next.quantize.root = static_cast<std::uint8_t>(quantizeObj["root"].as<std::uint8_t>() % 12);
+    next.quantize.scaleMask = static_cast<std::uint16_t>(quantizeObj["mask"].as<std::uint16_t>() & 0x0FFF);
+  }
 
   next.engineSelections.clear();
   JsonArray enginesArr = doc["engineSelections"].as<JsonArray>();
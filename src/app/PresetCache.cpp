@@ -0,0 +1,122 @@
+#include "app/PresetCache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "io/Store.h"
+
+void PresetCache::reset(seedbox::io::Store* store) {
+  store_ = store;
+  entries_.clear();
+  pending_.clear();
+  if (!store_) {
+    return;
+  }
+  generation_ = store_->generation();
+  // Warm in list order but pop from the back, so reverse once up front.
+  pending_ = store_->list();
+  std::reverse(pending_.begin(), pending_.end());
+  entries_.reserve(pending_.size());
+}
+
+bool PresetCache::warmNext() {
+  syncGeneration();
+  while (!pending_.empty()) {
+    const std::string slot = std::move(pending_.back());
+    pending_.pop_back();
+    // A save or an on-demand recall may have beaten the warm-up to this slot.
+    if (find(slot)) {
+      continue;
+    }
+    if (Handle preset = decode(slot)) {
+      insert(slot, std::move(preset));
+    }
+    break;
+  }
+  return !pending_.empty();
+}
+
+void PresetCache::warmAll() {
+  while (warmNext()) {
+  }
+}
+
+PresetCache::Handle PresetCache::find(std::string_view slot) const {
+  for (const auto& entry : entries_) {
+    if (entry.slot == slot) {
+      return entry.preset;
+    }
+  }
+  return nullptr;
+}
+
+PresetCache::Handle PresetCache::load(std::string_view slot) {
+  syncGeneration();
+  if (Handle cached = find(slot)) {
+    return cached;
+  }
+  Handle preset = decode(slot);
+  if (!preset) {
+    return nullptr;
+  }
+  return insert(slot, std::move(preset));
+}
+
+PresetCache::Handle PresetCache::save(std::string_view slot, seedbox::Preset preset) {
+  // Catch up on anyone else's writes first, so the generation bump below is
+  // known to be ours alone and the rest of the cache can stay.
+  syncGeneration();
+  if (!store_) {
+    return nullptr;
+  }
+  const auto bytes = preset.serialize();
+  if (bytes.empty() || !store_->save(slot, bytes)) {
+    return nullptr;
+  }
+  generation_ = store_->generation();
+  return remember(slot, std::move(preset));
+}
+
+PresetCache::Handle PresetCache::remember(std::string_view slot, seedbox::Preset preset) {
+  if (preset.slot.empty()) {
+    preset.slot = std::string(slot);
+  }
+  return insert(slot, std::make_shared<const seedbox::Preset>(std::move(preset)));
+}
+
+void PresetCache::syncGeneration() {
+  if (store_ && store_->generation() != generation_) {
+    reset(store_);
+  }
+}
+
+PresetCache::Handle PresetCache::decode(std::string_view slot) const {
+  if (!store_) {
+    return nullptr;
+  }
+  std::vector<std::uint8_t> bytes;
+  if (!store_->load(slot, bytes)) {
+    return nullptr;
+  }
+  seedbox::Preset preset{};
+  if (!seedbox::Preset::deserialize(bytes, preset)) {
+    return nullptr;
+  }
+  if (preset.slot.empty()) {
+    preset.slot = std::string(slot);
+  }
+  return std::make_shared<const seedbox::Preset>(std::move(preset));
+}
+
+PresetCache::Handle PresetCache::insert(std::string_view slot, Handle preset) {
+  // Replacing the handle (rather than mutating the preset) keeps any recall that
+  // is already queued pointing at the version it asked for.
+  for (auto& entry : entries_) {
+    if (entry.slot == slot) {
+      entry.preset = std::move(preset);
+      return entry.preset;
+    }
+  }
+  entries_.push_back(Entry{std::string(slot), std::move(preset)});
+  return entries_.back().preset;
+}
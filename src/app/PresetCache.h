@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "app/Preset.h"
+
+namespace seedbox::io {
+class Store;
+}
+
+// PresetCache keeps every stored slot decoded and ready to apply. Recalling a
+// preset mid-set should cost a lookup, not an EEPROM read plus a JSON parse, so
+// the cache front-loads that work: `reset()` queues every slot the store lists
+// and `warmNext()` decodes one of them per main-loop pass until the queue runs
+// dry. Entries are immutable and shared, which lets a queued recall hold the
+// exact preset it will commit without copying it again at the boundary.
+//
+// Other code may write the same medium behind the cache's back (the legacy
+// Storage::saveScene helper does).  The store's generation() says when that
+// happened; the next warm, load or remember then drops every entry and queues
+// the slots again, so a recall never hands out bytes the store replaced.
+// Writes made through save() keep the cache as it is.
+class PresetCache {
+public:
+  using Handle = std::shared_ptr<const seedbox::Preset>;
+
+  // Forget everything and queue the slots of `store` (which may be null) for
+  // background decoding. Called at boot and whenever the store is swapped.
+  void reset(seedbox::io::Store* store);
+
+  // Decode one queued slot. Returns true while work remains so callers can
+  // spin it to completion when they are not on a timing-sensitive path.
+  bool warmNext();
+  void warmAll();
+  bool warming() const { return !pending_.empty(); }
+
+  // Ready-to-apply preset for `slot`, or null when it has not been decoded.
+  Handle find(std::string_view slot) const;
+
+  // Cache-miss path: load and decode `slot` right now, then keep the result.
+  Handle load(std::string_view slot);
+
+  // Write `preset` to the store and keep it, so the next recall never touches
+  // the store.  Null when the store refused the write.
+  Handle save(std::string_view slot, seedbox::Preset preset);
+  // Keep a preset that is already in the store under `slot`.
+  Handle remember(std::string_view slot, seedbox::Preset preset);
+
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  struct Entry {
+    std::string slot;
+    Handle preset;
+  };
+
+  Handle decode(std::string_view slot) const;
+  Handle insert(std::string_view slot, Handle preset);
+  // Start over if the store was written since we last looked.
+  void syncGeneration();
+
+  seedbox::io::Store* store_{nullptr};
+  std::uint32_t generation_{0};
+  std::vector<Entry> entries_{};
+  std::vector<std::string> pending_{};
+};
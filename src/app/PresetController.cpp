@@ -21,6 +21,7 @@ seedbox::Preset PresetController::snapshotPreset(const SnapshotInput& input) con
   preset.clock.debugMeters = input.debugMeters;
   preset.clock.transportLatch = input.transportLatch;
   preset.page = input.page;
+  preset.quantize = input.quantize;
   if (input.seeds) {
     preset.seeds = *input.seeds;
   }
@@ -37,12 +38,21 @@ seedbox::Preset PresetController::snapshotPreset(const SnapshotInput& input) con
 }
 
 void PresetController::requestPresetChange(const seedbox::Preset& preset, bool crossfade, Boundary boundary,
-                                           std::uint64_t currentTick) {
+                                           std::uint64_t currentTick, std::uint64_t gridOriginTick) {
+  requestPresetChange(std::make_shared<const seedbox::Preset>(preset), crossfade, boundary, currentTick,
+                      gridOriginTick);
+}
+
+void PresetController::requestPresetChange(PresetHandle preset, bool crossfade, Boundary boundary,
+                                           std::uint64_t currentTick, std::uint64_t gridOriginTick) {
+  if (!preset) {
+    return;
+  }
   PendingPresetRequest request;
-  request.preset = preset;
+  request.preset = std::move(preset);
   request.crossfade = crossfade;
   request.boundary = boundary;
-  request.targetTick = computeNextPresetTickForBoundary(boundary, currentTick);
+  request.targetTick = computeNextPresetTickForBoundary(boundary, currentTick, gridOriginTick);
   pendingPresetRequest_ = std::move(request);
 }
 
@@ -53,14 +63,18 @@ std::optional<PresetController::PendingPresetRequest> PresetController::takePend
   if (currentTick < pendingPresetRequest_->targetTick) {
     return std::nullopt;
   }
-  PendingPresetRequest request = *pendingPresetRequest_;
+  // Move, don't copy: the boundary tick only hands over the shared handle.
+  std::optional<PendingPresetRequest> request = std::move(pendingPresetRequest_);
   pendingPresetRequest_.reset();
   return request;
 }
 
-std::uint64_t PresetController::computeNextPresetTickForBoundary(Boundary boundary, std::uint64_t currentTick) const {
+std::uint64_t PresetController::computeNextPresetTickForBoundary(Boundary boundary, std::uint64_t currentTick,
+                                                                 std::uint64_t gridOriginTick) const {
   if (boundary == Boundary::kBar) {
-    const std::uint64_t base = (currentTick / kPresetBoundaryTicksPerBar) * kPresetBoundaryTicksPerBar;
+    const std::uint64_t origin = std::min(gridOriginTick, currentTick);
+    const std::uint64_t intoGrid = currentTick - origin;
+    const std::uint64_t base = origin + (intoGrid / kPresetBoundaryTicksPerBar) * kPresetBoundaryTicksPerBar;
     std::uint64_t target = base + kPresetBoundaryTicksPerBar;
     if (target <= currentTick) {
       target += kPresetBoundaryTicksPerBar;
@@ -72,14 +86,62 @@ std::uint64_t PresetController::computeNextPresetTickForBoundary(Boundary bounda
 
 void PresetController::clearPendingPresetRequest() { pendingPresetRequest_.reset(); }
 
-void PresetController::beginCrossfade(std::vector<Seed> from, std::vector<Seed> to, std::uint32_t totalTicks) {
-  crossfade_.from = std::move(from);
-  crossfade_.to = std::move(to);
+void PresetController::beginCrossfade(const std::vector<Seed>& from, const std::vector<Seed>& to,
+                                      std::uint32_t totalTicks) {
+  // Matrices and the target vector keep their storage between fades, so a
+  // recall on a steady seed count does not allocate.
+  const std::size_t rows = std::max(from.size(), to.size());
+  crossfade_.from.assign(from, rows);
+  crossfade_.to.assign(to, rows);
+  for (std::size_t i = from.size(); i < rows; ++i) {
+    SeedParamMatrix::packRow(to[i], crossfade_.from.row(i));
+    crossfade_.from.at(i, SeedParam::kDensity) = 0.0f;
+  }
+  for (std::size_t i = to.size(); i < rows; ++i) {
+    SeedParamMatrix::packRow(from[i], crossfade_.to.row(i));
+    crossfade_.to.at(i, SeedParam::kDensity) = 0.0f;
+  }
+  crossfade_.target = to;
   crossfade_.total = totalTicks;
   crossfade_.remaining = totalTicks;
 }
 
-void PresetController::clearCrossfade() { crossfade_ = {}; }
+void PresetController::clearCrossfade() {
+  crossfade_.from.clear();
+  crossfade_.to.clear();
+  crossfade_.blended.clear();
+  crossfade_.target.clear();
+  crossfade_.remaining = 0;
+  crossfade_.total = 0;
+}
+
+void PresetController::setCrossfadeCurve(SeedParam param, CrossfadeCurve curve) {
+  const auto index = static_cast<std::size_t>(param);
+  if (index < curves_.size()) {
+    curves_[index] = curve;
+  }
+}
+
+CrossfadeCurve PresetController::crossfadeCurve(SeedParam param) const {
+  const auto index = static_cast<std::size_t>(param);
+  return index < curves_.size() ? curves_[index] : CrossfadeCurve::kLinear;
+}
+
+void PresetController::crossfadeWeights(float mix, SeedParamMatrix::Weights& wFrom,
+                                        SeedParamMatrix::Weights& wTo) const {
+  // Three curves, twenty columns: evaluate each curve once, then scatter.
+  constexpr std::size_t kCurveCount = 3;
+  std::array<float, kCurveCount> from{};
+  std::array<float, kCurveCount> to{};
+  for (std::size_t c = 0; c < kCurveCount; ++c) {
+    SeedParamMatrix::curveWeights(static_cast<CrossfadeCurve>(c), mix, from[c], to[c]);
+  }
+  for (std::size_t i = 0; i < curves_.size(); ++i) {
+    const auto curve = static_cast<std::size_t>(curves_[i]);
+    wFrom[i] = from[curve];
+    wTo[i] = to[curve];
+  }
+}
 
 bool PresetController::crossfadeActive() const {
   return crossfade_.remaining != 0u && crossfade_.total != 0u;
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -8,6 +10,7 @@
 
 #include "Seed.h"
 #include "app/Preset.h"
+#include "app/SeedParamMatrix.h"
 
 class AppState;
 
@@ -30,20 +33,33 @@ public:
     bool debugMeters{false};
     bool transportLatch{false};
     seedbox::PageId page{seedbox::PageId::kSeeds};
+    seedbox::PresetQuantizeSettings quantize{};
     const std::vector<Seed>* seeds{nullptr};
     const std::vector<std::uint8_t>* engineSelections{nullptr};
   };
 
+  // Queued recalls hold the preset by shared handle: cached presets are queued
+  // and committed without another deep copy.
+  using PresetHandle = std::shared_ptr<const seedbox::Preset>;
+
   struct PendingPresetRequest {
-    seedbox::Preset preset{};
+    PresetHandle preset{};
     bool crossfade{false};
     Boundary boundary{Boundary::kStep};
     std::uint64_t targetTick{0};
   };
 
+  // A fade keeps only the continuous parameters of both worlds, packed as
+  // matrices with one row per seed, plus the destination seeds for the
+  // discrete fields and the final snap.  When the worlds have different seed
+  // counts, both matrices get max(from, to) rows.  A missing row copies its
+  // partner with density zero, so extra seeds fade in or out instead of
+  // forcing a hard cut.
   struct CrossfadeState {
-    std::vector<Seed> from{};
-    std::vector<Seed> to{};
+    SeedParamMatrix from{};
+    SeedParamMatrix to{};
+    SeedParamMatrix blended{};
+    std::vector<Seed> target{};
     std::uint32_t remaining{0};
     std::uint32_t total{0};
   };
@@ -53,12 +69,23 @@ public:
 
   seedbox::Preset snapshotPreset(const SnapshotInput& input) const;
 
-  void requestPresetChange(const seedbox::Preset& preset, bool crossfade, Boundary boundary, std::uint64_t currentTick);
+  // Bars are counted from `gridOriginTick`, the scheduler's beat origin, so a
+  // tap tempo that moved beat one moves the bar line with it.
+  void requestPresetChange(const seedbox::Preset& preset, bool crossfade, Boundary boundary, std::uint64_t currentTick,
+                           std::uint64_t gridOriginTick = 0);
+  void requestPresetChange(PresetHandle preset, bool crossfade, Boundary boundary, std::uint64_t currentTick,
+                           std::uint64_t gridOriginTick = 0);
   std::optional<PendingPresetRequest> takePendingPreset(std::uint64_t currentTick);
-  std::uint64_t computeNextPresetTickForBoundary(Boundary boundary, std::uint64_t currentTick) const;
+  std::uint64_t computeNextPresetTickForBoundary(Boundary boundary, std::uint64_t currentTick,
+                                                 std::uint64_t gridOriginTick = 0) const;
   void clearPendingPresetRequest();
 
-  void beginCrossfade(std::vector<Seed> from, std::vector<Seed> to, std::uint32_t totalTicks);
+  void beginCrossfade(const std::vector<Seed>& from, const std::vector<Seed>& to, std::uint32_t totalTicks);
+  // Per-parameter fade curves; everything starts linear.
+  void setCrossfadeCurve(SeedParam param, CrossfadeCurve curve);
+  CrossfadeCurve crossfadeCurve(SeedParam param) const;
+  // Column weights for the current position of the fade (0 = all `from`).
+  void crossfadeWeights(float mix, SeedParamMatrix::Weights& wFrom, SeedParamMatrix::Weights& wTo) const;
   void clearCrossfade();
   bool crossfadeActive() const;
   const CrossfadeState& crossfade() const { return crossfade_; }
@@ -69,4 +96,5 @@ private:
   std::string activePresetSlot_{};
   std::optional<PendingPresetRequest> pendingPresetRequest_{};
   CrossfadeState crossfade_{};
+  std::array<CrossfadeCurve, SeedParamMatrix::kColumns> curves_{};
 };
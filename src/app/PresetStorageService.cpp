@@ -1,8 +1,11 @@
 #include "app/PresetStorageService.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "app/PresetTransitionRunner.h"
+
 // PresetStorageService keeps the boring but important I/O rules in one place:
 // slot naming, serialization, and the difference between "capture what exists
 // now" and "request that a stored scene take over later".
@@ -31,18 +34,16 @@ bool PresetStorageService::savePreset(AppState& app, std::string_view slot) cons
     return false;
   }
   const std::string slotName = slot.empty() ? std::string(kDefaultPresetSlot) : std::string(slot);
-  seedbox::Preset preset = app.snapshotPreset(slotName);
-  const auto bytes = preset.serialize();
-  if (bytes.empty()) {
-    return false;
-  }
-  if (!app.store_->save(slotName, bytes)) {
+  // The write goes through the cache so the next recall of this slot (or of
+  // any other) needs no store read.
+  const auto saved = app.presetCache_.save(slotName, app.snapshotPreset(slotName));
+  if (!saved) {
     return false;
   }
   // Saving also updates the app's notion of the active slot so the UI reflects
   // the last successful write, not just the last requested name.
   app.presetController_.setActivePresetSlot(slotName);
-  app.setSeedPreset(preset.masterSeed, preset.seeds);
+  app.setSeedPreset(saved->masterSeed, saved->seeds);
   return true;
 }
 
@@ -50,20 +51,16 @@ bool PresetStorageService::recallPreset(AppState& app, std::string_view slot, bo
   if (!app.store_) {
     return false;
   }
-  const std::string slotName = slot.empty() ? std::string(kDefaultPresetSlot) : std::string(slot);
-  std::vector<std::uint8_t> bytes;
-  if (!app.store_->load(slotName, bytes)) {
+  const std::string_view slotName = slot.empty() ? kDefaultPresetSlot : slot;
+  // The cache normally has every slot decoded already; a miss (warm-up still
+  // running, or a slot written behind our back) pays the load + parse once.
+  auto preset = app.presetCache_.load(slotName);
+  if (!preset) {
     return false;
   }
-  seedbox::Preset preset{};
-  if (!seedbox::Preset::deserialize(bytes, preset)) {
-    return false;
-  }
-  if (preset.slot.empty()) {
-    preset.slot = slotName;
-  }
   // Recall goes through the same preset-transition path as host-triggered
   // changes so boundary and crossfade behavior stay consistent.
-  app.requestPresetChange(preset, crossfade, AppState::PresetBoundary::Step);
+  static const PresetTransitionRunner runner{};
+  runner.requestChange(app, std::move(preset), crossfade, static_cast<std::uint8_t>(AppState::PresetBoundary::Step));
   return true;
 }
@@ -1,8 +1,10 @@
 #include "app/PresetTransitionRunner.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "SeedBoxConfig.h"
 #include "app/AppState.h"
@@ -24,46 +26,15 @@ PresetController::Boundary toPresetControllerBoundary(std::uint8_t boundary) {
   }
 }
 
-float lerp(float a, float b, float t) {
-  return a + (b - a) * t;
-}
-
-Seed blendSeeds(const Seed& from, const Seed& to, float t) {
-  // Crossfades treat seeds like parameter snapshots. Continuous fields glide;
-  // discrete fields snap toward whichever side of the fade currently dominates.
-  const float mix = std::clamp(t, 0.0f, 1.0f);
-  Seed blended = from;
-  blended.id = to.id;
-  blended.prng = to.prng;
-  blended.pitch = lerp(from.pitch, to.pitch, mix);
-  blended.envA = lerp(from.envA, to.envA, mix);
-  blended.envD = lerp(from.envD, to.envD, mix);
-  blended.envS = lerp(from.envS, to.envS, mix);
-  blended.envR = lerp(from.envR, to.envR, mix);
-  blended.density = lerp(from.density, to.density, mix);
-  blended.probability = lerp(from.probability, to.probability, mix);
-  blended.jitterMs = lerp(from.jitterMs, to.jitterMs, mix);
-  blended.tone = lerp(from.tone, to.tone, mix);
-  blended.spread = lerp(from.spread, to.spread, mix);
-  blended.engine = (mix < 0.5f) ? from.engine : to.engine;
-  blended.sampleIdx = (mix < 0.5f) ? from.sampleIdx : to.sampleIdx;
-  blended.mutateAmt = lerp(from.mutateAmt, to.mutateAmt, mix);
-
-  blended.granular.grainSizeMs = lerp(from.granular.grainSizeMs, to.granular.grainSizeMs, mix);
-  blended.granular.sprayMs = lerp(from.granular.sprayMs, to.granular.sprayMs, mix);
-  blended.granular.transpose = lerp(from.granular.transpose, to.granular.transpose, mix);
-  blended.granular.windowSkew = lerp(from.granular.windowSkew, to.granular.windowSkew, mix);
-  blended.granular.stereoSpread = lerp(from.granular.stereoSpread, to.granular.stereoSpread, mix);
-  blended.granular.source = (mix < 0.5f) ? from.granular.source : to.granular.source;
-  blended.granular.sdSlot = (mix < 0.5f) ? from.granular.sdSlot : to.granular.sdSlot;
-
-  blended.resonator.exciteMs = lerp(from.resonator.exciteMs, to.resonator.exciteMs, mix);
-  blended.resonator.damping = lerp(from.resonator.damping, to.resonator.damping, mix);
-  blended.resonator.brightness = lerp(from.resonator.brightness, to.resonator.brightness, mix);
-  blended.resonator.feedback = lerp(from.resonator.feedback, to.resonator.feedback, mix);
-  blended.resonator.mode = (mix < 0.5f) ? from.resonator.mode : to.resonator.mode;
-  blended.resonator.bank = (mix < 0.5f) ? from.resonator.bank : to.resonator.bank;
-  return blended;
+// Discrete fields cannot glide, so they flip to the destination once the fade
+// is past halfway, the same moment a listener would say the new scene "won".
+void adoptDiscreteFields(Seed& seed, const Seed& to) {
+  seed.engine = to.engine;
+  seed.sampleIdx = to.sampleIdx;
+  seed.granular.source = to.granular.source;
+  seed.granular.sdSlot = to.granular.sdSlot;
+  seed.resonator.mode = to.resonator.mode;
+  seed.resonator.bank = to.resonator.bank;
 }
 
 }  // namespace
@@ -76,6 +47,7 @@ void PresetTransitionRunner::rebuildScheduler(AppState& app, float bpm) {
   app.scheduler_.setTriggerCallback(&app.engines_, &EngineRouter::dispatchThunk);
   const bool hardwareMode = (app.engines_.granular().mode() == GranularEngine::Mode::kHardware);
   app.scheduler_.setSampleClockFn(hardwareMode ? &hal::audio::sampleClock : nullptr);
+  app.scheduler_.reserveSeeds(app.seeds_.size());
   for (const Seed& seed : app.seeds_) {
     app.scheduler_.addSeed(seed);
   }
@@ -85,7 +57,17 @@ void PresetTransitionRunner::requestChange(AppState& app, const seedbox::Preset&
                                            std::uint8_t boundary) const {
   // Requesting a preset is cheap: we queue the intent plus its boundary policy,
   // then let the main tick decide when that intent becomes audible reality.
-  app.presetController_.requestPresetChange(preset, crossfade, toPresetControllerBoundary(boundary), app.scheduler_.ticks());
+  app.presetController_.requestPresetChange(preset, crossfade, toPresetControllerBoundary(boundary), app.scheduler_.ticks(),
+                                            app.scheduler_.beatOriginTick());
+  app.displayDirty_ = true;
+}
+
+void PresetTransitionRunner::requestChange(AppState& app, std::shared_ptr<const seedbox::Preset> preset,
+                                           bool crossfade, std::uint8_t boundary) const {
+  // Cached recalls arrive already decoded; queue the shared handle itself so
+  // the boundary commit neither parses nor copies the preset.
+  app.presetController_.requestPresetChange(std::move(preset), crossfade, toPresetControllerBoundary(boundary),
+                                            app.scheduler_.ticks(), app.scheduler_.beatOriginTick());
   app.displayDirty_ = true;
 }
 
@@ -96,7 +78,7 @@ void PresetTransitionRunner::maybeCommitPending(AppState& app, std::uint64_t cur
   }
   // Once the boundary fires, preset application is intentionally the same code
   // path regardless of whether the request came from storage, host, or UI.
-  apply(app, pending->preset, pending->crossfade);
+  apply(app, *pending->preset, pending->crossfade);
 }
 
 seedbox::Preset PresetTransitionRunner::snapshot(const AppState& app, std::string_view slot) const {
@@ -111,6 +93,9 @@ seedbox::Preset PresetTransitionRunner::snapshot(const AppState& app, std::strin
   input.debugMeters = app.debugMetersEnabled_;
   input.transportLatch = app.transportLatchEnabled();
   input.page = static_cast<seedbox::PageId>(app.currentPage_);
+  input.quantize.scaleIndex = app.quantizeScaleIndex_;
+  input.quantize.root = app.quantizeRoot_;
+  input.quantize.scaleMask = app.quantizeCustomScale_.mask();
   input.seeds = &app.seeds_;
   input.engineSelections = &app.seedEngineSelections_;
   return app.presetController_.snapshotPreset(input);
@@ -128,6 +113,14 @@ void PresetTransitionRunner::apply(AppState& app, const seedbox::Preset& preset,
   app.currentPage_ = static_cast<AppState::Page>(preset.page);
   app.storageButtonHeld_ = false;
   app.storageLongPress_ = false;
+  // Quantize settings are restored, not re-applied: the seeds already carry
+  // whatever pitches were saved, so nothing gets snapped here.
+  app.quantizeCustomScale_ = util::ScaleQuantizer::Table(preset.quantize.scaleMask);
+  const std::uint8_t maxScaleIndex = app.quantizeCustomScale_.mask() != 0
+                                         ? AppState::kQuantizeCustomScaleIndex
+                                         : static_cast<std::uint8_t>(AppState::kQuantizeCustomScaleIndex - 1);
+  app.quantizeScaleIndex_ = std::min(preset.quantize.scaleIndex, maxScaleIndex);
+  app.quantizeRoot_ = static_cast<std::uint8_t>(preset.quantize.root % 12);
 
   if (!preset.engineSelections.empty()) {
     app.seedEngineSelections_ = preset.engineSelections;
@@ -140,11 +133,20 @@ void PresetTransitionRunner::apply(AppState& app, const seedbox::Preset& preset,
   }
 
   const bool haveSeeds = !preset.seeds.empty();
-  const bool doCrossfade = crossfade && haveSeeds && !app.seeds_.empty() && preset.seeds.size() == app.seeds_.size();
+  const bool doCrossfade = crossfade && haveSeeds && !app.seeds_.empty() && app.presetCrossfadeTicks_ > 0;
   if (doCrossfade) {
-    // Crossfade only makes sense when both worlds have the same slot geometry.
-    // Otherwise we fall back to a hard cut plus scheduler rebuild.
-    app.presetController_.beginCrossfade(app.seeds_, preset.seeds, AppState::kPresetCrossfadeTicks);
+    // Worlds of different sizes fade too: the matrices pad the smaller side
+    // with silent copies, and seeds that only exist in the destination join
+    // the roster now so the scheduler can fade them in.
+    app.presetController_.beginCrossfade(app.seeds_, preset.seeds, app.presetCrossfadeTicks_);
+    for (std::size_t i = app.seeds_.size(); i < preset.seeds.size(); ++i) {
+      Seed joining = preset.seeds[i];
+      joining.density = 0.0f;
+      app.seeds_.push_back(joining);
+    }
+    while (app.scheduler_.seedCount() < app.seeds_.size()) {
+      app.scheduler_.addSeed(app.seeds_[app.scheduler_.seedCount()]);
+    }
   } else {
     app.seeds_ = preset.seeds;
     app.presetController_.clearCrossfade();
@@ -162,11 +164,12 @@ void PresetTransitionRunner::stepCrossfade(AppState& app) const {
   if (!app.presetController_.crossfadeActive()) {
     return;
   }
-  const auto& crossfade = app.presetController_.crossfade();
-  if (crossfade.from.size() != crossfade.to.size() || crossfade.to.size() != app.seeds_.size()) {
+  auto& crossfade = app.presetController_.crossfade();
+  const std::size_t rows = crossfade.from.rows();
+  if (crossfade.to.rows() != rows || rows != app.seeds_.size() || crossfade.target.size() > rows) {
     // A malformed crossfade state is resolved by committing the destination
     // scene outright; silent corruption is worse than an abrupt but correct cut.
-    app.seeds_ = crossfade.to;
+    app.seeds_ = crossfade.target;
     app.presetController_.clearCrossfade();
     rebuildScheduler(app, app.scheduler_.bpm());
     return;
@@ -175,18 +178,36 @@ void PresetTransitionRunner::stepCrossfade(AppState& app) const {
   const float total = static_cast<float>(crossfade.total);
   const float remaining = static_cast<float>(crossfade.remaining);
   const float mix = (total <= 0.f) ? 1.0f : (1.0f - (remaining / total));
-  for (std::size_t i = 0; i < app.seeds_.size(); ++i) {
+  // The whole tick's worth of blending is one fused sweep over the packed
+  // matrices; the per-seed loop below only copies rows back out.
+  SeedParamMatrix::Weights wFrom{};
+  SeedParamMatrix::Weights wTo{};
+  app.presetController_.crossfadeWeights(mix, wFrom, wTo);
+  SeedParamMatrix::blend(crossfade.from, crossfade.to, wFrom, wTo, crossfade.blended);
+  for (std::size_t i = 0; i < rows; ++i) {
+    Seed& seed = app.seeds_[i];
+    SeedParamMatrix::unpackRow(crossfade.blended.row(i), seed);
+    if (i < crossfade.target.size()) {
+      const Seed& to = crossfade.target[i];
+      seed.id = to.id;
+      seed.prng = to.prng;
+      if (mix >= 0.5f) {
+        adoptDiscreteFields(seed, to);
+      }
+    }
     // We update the scheduler slot-by-slot during the fade so any currently
     // running transport reflects the in-between world, not just the endpoints.
-    app.seeds_[i] = blendSeeds(crossfade.from[i], crossfade.to[i], mix);
-    app.scheduler_.updateSeed(i, app.seeds_[i]);
+    app.scheduler_.updateSeed(i, seed);
   }
 
   app.presetController_.decrementCrossfade();
   if (!app.presetController_.crossfadeActive()) {
     // The final tick snaps to the exact destination preset so no accumulated
-    // float drift from the blend math survives after the fade is done.
-    app.seeds_ = crossfade.to;
+    // float drift from the blend math survives after the fade is done.  Seeds
+    // that only existed in the old world have faded to silence by now and
+    // simply leave the roster.
+    app.seeds_ = crossfade.target;
+    app.scheduler_.truncateSeeds(app.seeds_.size());
     for (std::size_t i = 0; i < app.seeds_.size(); ++i) {
       app.scheduler_.updateSeed(i, app.seeds_[i]);
     }
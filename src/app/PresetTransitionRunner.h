@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string_view>
 
 #include "app/Preset.h"
@@ -10,6 +11,8 @@ class AppState;
 class PresetTransitionRunner {
 public:
   void requestChange(AppState& app, const seedbox::Preset& preset, bool crossfade, std::uint8_t boundary) const;
+  void requestChange(AppState& app, std::shared_ptr<const seedbox::Preset> preset, bool crossfade,
+                     std::uint8_t boundary) const;
   void maybeCommitPending(AppState& app, std::uint64_t currentTick) const;
   seedbox::Preset snapshot(const AppState& app, std::string_view slot) const;
   void apply(AppState& app, const seedbox::Preset& preset, bool crossfade) const;
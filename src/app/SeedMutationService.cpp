@@ -23,8 +23,10 @@ std::uint8_t SeedMutationService::sanitizeEngine(const EngineRouter& router, std
 void SeedMutationService::syncSeedState(AppState& app, std::size_t idx) {
   // Scheduler and engine caches both mirror the seed table, so any successful
   // mutation has to refresh both or the next trigger will speak stale data.
+  // Voices already sounding glide to the new tone/spread per sample.
   app.scheduler_.updateSeed(idx, app.seeds_[idx]);
   app.engines_.onSeed(app.seeds_[idx]);
+  app.engines_.glideSeedParams(app.seeds_[idx]);
   app.displayDirty_ = true;
 }
 
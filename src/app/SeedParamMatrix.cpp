@@ -0,0 +1,114 @@
+#include "app/SeedParamMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kHalfPi = 1.57079632679489661923f;
+
+constexpr std::size_t col(SeedParam param) { return static_cast<std::size_t>(param); }
+}  // namespace
+
+void SeedParamMatrix::assign(const std::vector<Seed>& seeds, std::size_t rows) {
+  resize(std::max(rows, seeds.size()));
+  for (std::size_t i = 0; i < seeds.size(); ++i) {
+    packRow(seeds[i], row(i));
+  }
+}
+
+void SeedParamMatrix::resize(std::size_t rows) {
+  rows_ = rows;
+  values_.resize(rows * kColumns);
+}
+
+void SeedParamMatrix::clear() {
+  rows_ = 0;
+  values_.clear();
+}
+
+void SeedParamMatrix::packRow(const Seed& seed, float* row) {
+  row[col(SeedParam::kPitch)] = seed.pitch;
+  row[col(SeedParam::kEnvA)] = seed.envA;
+  row[col(SeedParam::kEnvD)] = seed.envD;
+  row[col(SeedParam::kEnvS)] = seed.envS;
+  row[col(SeedParam::kEnvR)] = seed.envR;
+  row[col(SeedParam::kDensity)] = seed.density;
+  row[col(SeedParam::kProbability)] = seed.probability;
+  row[col(SeedParam::kJitterMs)] = seed.jitterMs;
+  row[col(SeedParam::kTone)] = seed.tone;
+  row[col(SeedParam::kSpread)] = seed.spread;
+  row[col(SeedParam::kMutateAmt)] = seed.mutateAmt;
+  row[col(SeedParam::kGrainSizeMs)] = seed.granular.grainSizeMs;
+  row[col(SeedParam::kSprayMs)] = seed.granular.sprayMs;
+  row[col(SeedParam::kTranspose)] = seed.granular.transpose;
+  row[col(SeedParam::kWindowSkew)] = seed.granular.windowSkew;
+  row[col(SeedParam::kStereoSpread)] = seed.granular.stereoSpread;
+  row[col(SeedParam::kExciteMs)] = seed.resonator.exciteMs;
+  row[col(SeedParam::kDamping)] = seed.resonator.damping;
+  row[col(SeedParam::kBrightness)] = seed.resonator.brightness;
+  row[col(SeedParam::kFeedback)] = seed.resonator.feedback;
+}
+
+void SeedParamMatrix::unpackRow(const float* row, Seed& seed) {
+  seed.pitch = row[col(SeedParam::kPitch)];
+  seed.envA = row[col(SeedParam::kEnvA)];
+  seed.envD = row[col(SeedParam::kEnvD)];
+  seed.envS = row[col(SeedParam::kEnvS)];
+  seed.envR = row[col(SeedParam::kEnvR)];
+  seed.density = row[col(SeedParam::kDensity)];
+  seed.probability = row[col(SeedParam::kProbability)];
+  seed.jitterMs = row[col(SeedParam::kJitterMs)];
+  seed.tone = row[col(SeedParam::kTone)];
+  seed.spread = row[col(SeedParam::kSpread)];
+  seed.mutateAmt = row[col(SeedParam::kMutateAmt)];
+  seed.granular.grainSizeMs = row[col(SeedParam::kGrainSizeMs)];
+  seed.granular.sprayMs = row[col(SeedParam::kSprayMs)];
+  seed.granular.transpose = row[col(SeedParam::kTranspose)];
+  seed.granular.windowSkew = row[col(SeedParam::kWindowSkew)];
+  seed.granular.stereoSpread = row[col(SeedParam::kStereoSpread)];
+  seed.resonator.exciteMs = row[col(SeedParam::kExciteMs)];
+  seed.resonator.damping = row[col(SeedParam::kDamping)];
+  seed.resonator.brightness = row[col(SeedParam::kBrightness)];
+  seed.resonator.feedback = row[col(SeedParam::kFeedback)];
+}
+
+void SeedParamMatrix::curveWeights(CrossfadeCurve curve, float mix, float& wFrom, float& wTo) {
+  const float t = std::clamp(mix, 0.0f, 1.0f);
+  switch (curve) {
+    case CrossfadeCurve::kEqualPower:
+      // sin alone gives the bulge; cos would add a second bulge on top (the
+      // pair sums to sqrt(2) mid-fade), so the "from" side takes what is left.
+      // sin(pi/2) is not exactly one in float; make the far end land exactly.
+      wTo = t >= 1.0f ? 1.0f : std::sin(t * kHalfPi);
+      wFrom = 1.0f - wTo;
+      break;
+    case CrossfadeCurve::kSCurve: {
+      const float s = t * t * (3.0f - 2.0f * t);
+      wFrom = 1.0f - s;
+      wTo = s;
+      break;
+    }
+    case CrossfadeCurve::kLinear:
+    default:
+      wFrom = 1.0f - t;
+      wTo = t;
+      break;
+  }
+}
+
+void SeedParamMatrix::blend(const SeedParamMatrix& from, const SeedParamMatrix& to, const Weights& wFrom,
+                            const Weights& wTo, SeedParamMatrix& out) {
+  const std::size_t rows = std::min(from.rows_, to.rows_);
+  out.resize(rows);
+  // One flat sweep; the inner loop has a fixed trip count and no aliasing
+  // between inputs and output, which is what lets compilers unroll/vectorize it.
+  const float* a = from.values_.data();
+  const float* b = to.values_.data();
+  float* dst = out.values_.data();
+  for (std::size_t r = 0; r < rows; ++r) {
+    const std::size_t base = r * kColumns;
+    for (std::size_t c = 0; c < kColumns; ++c) {
+      dst[base + c] = a[base + c] * wFrom[c] + b[base + c] * wTo[c];
+    }
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+//
+// SeedParamMatrix.h
+// -----------------
+// Crossfades only ever glide the continuous half of a Seed: pitch, envelopes,
+// density, tone, the granular/resonator knobs.  Walking those field by field
+// for every seed on every tick is slow and hard to vectorize, so fades pack
+// them into a flat row-major float matrix instead: one row per seed, one
+// column per parameter.  A fade tick is then a single fused
+// `out = from * wFrom + to * wTo` sweep over the whole matrix, with the
+// per-column weights coming from whichever curve that parameter uses.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Seed.h"
+
+// Column order of the matrix.  Discrete fields (engine, sample index, modes,
+// banks) are not here on purpose: they snap, they do not glide.
+enum class SeedParam : std::uint8_t {
+  kPitch = 0,
+  kEnvA,
+  kEnvD,
+  kEnvS,
+  kEnvR,
+  kDensity,
+  kProbability,
+  kJitterMs,
+  kTone,
+  kSpread,
+  kMutateAmt,
+  kGrainSizeMs,
+  kSprayMs,
+  kTranspose,
+  kWindowSkew,
+  kStereoSpread,
+  kExciteMs,
+  kDamping,
+  kBrightness,
+  kFeedback,
+  kCount,
+};
+
+// How a parameter travels from the old scene to the new one.  Linear is the
+// classic lerp.  Equal-power borrows the quarter-sine rise of an equal-power
+// audio fade, so loudness-like parameters bulge through the middle instead of
+// dipping.  The S-curve (smoothstep) lingers at both ends and rushes the
+// middle.  Every curve's weights sum to 1: these are scalar parameters, not
+// two uncorrelated signals, so a value that is the same in both scenes must
+// not move during the fade.
+enum class CrossfadeCurve : std::uint8_t {
+  kLinear = 0,
+  kEqualPower,
+  kSCurve,
+};
+
+class SeedParamMatrix {
+public:
+  static constexpr std::size_t kColumns = static_cast<std::size_t>(SeedParam::kCount);
+  using Weights = std::array<float, kColumns>;
+
+  // Pack `seeds` into the first rows and leave any extra rows (up to `rows`)
+  // for the caller to fill.  Storage is reused across fades.
+  void assign(const std::vector<Seed>& seeds, std::size_t rows);
+  void resize(std::size_t rows);
+  void clear();
+
+  std::size_t rows() const { return rows_; }
+  float* row(std::size_t index) { return values_.data() + index * kColumns; }
+  const float* row(std::size_t index) const { return values_.data() + index * kColumns; }
+  float& at(std::size_t index, SeedParam param) { return row(index)[static_cast<std::size_t>(param)]; }
+
+  static void packRow(const Seed& seed, float* row);
+  static void unpackRow(const float* row, Seed& seed);
+
+  // The (from, to) weight pair for `curve` at `mix` in [0, 1].
+  static void curveWeights(CrossfadeCurve curve, float mix, float& wFrom, float& wTo);
+
+  // out = from * wFrom + to * wTo, weights broadcast down every row.  `out` is
+  // resized to match; `from` and `to` must have the same row count.
+  static void blend(const SeedParamMatrix& from, const SeedParamMatrix& to, const Weights& wFrom,
+                    const Weights& wTo, SeedParamMatrix& out);
+
+private:
+  std::vector<float> values_{};
+  std::size_t rows_{0};
+};
@@ -276,6 +276,7 @@ void SeedPrimeRuntimeService::primeSeeds(AppState& app, std::uint32_t masterSeed
 
   // Only non-empty seeds become scheduled voices. Empty placeholder seeds still
   // exist for UI shape, but they should not advance any pattern state.
+  app.scheduler_.reserveSeeds(app.seeds_.size());
   for (const Seed& seed : app.seeds_) {
     if (seed.prng != 0) {
       app.scheduler_.addSeed(seed);
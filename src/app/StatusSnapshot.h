@@ -9,6 +9,9 @@ struct StatusSnapshot {
     std::uint32_t oversizeBlockDropCount{0};
     std::uint32_t lastOversizeBlockFrames{0};
     std::uint32_t preparedScratchFrames{0};
+    std::uint32_t commandQueueOverflowCount{0};
+    std::uint32_t commandQueueHighWater{0};
+    std::uint32_t commandQueueMaxLatencyUs{0};
   } hostDiagnostics{};
   char mode[12];
   char page[12];
@@ -177,7 +177,10 @@ std::string StatusSnapshotBuilder::toJson(const seedbox::StatusSnapshot& status)
   appendJsonUIntField(out, "midiDroppedCount", status.hostDiagnostics.midiDroppedCount, true);
   appendJsonUIntField(out, "oversizeBlockDropCount", status.hostDiagnostics.oversizeBlockDropCount, true);
   appendJsonUIntField(out, "lastOversizeBlockFrames", status.hostDiagnostics.lastOversizeBlockFrames, true);
-  appendJsonUIntField(out, "preparedScratchFrames", status.hostDiagnostics.preparedScratchFrames, false);
+  appendJsonUIntField(out, "preparedScratchFrames", status.hostDiagnostics.preparedScratchFrames, true);
+  appendJsonUIntField(out, "commandQueueOverflowCount", status.hostDiagnostics.commandQueueOverflowCount, true);
+  appendJsonUIntField(out, "commandQueueHighWater", status.hostDiagnostics.commandQueueHighWater, true);
+  appendJsonUIntField(out, "commandQueueMaxLatencyUs", status.hostDiagnostics.commandQueueMaxLatencyUs, false);
   out += "},";
   appendJsonBoolField(out, "externalClockDominant", status.externalClockDominant, true);
   appendJsonBoolField(out, "followExternalClockEnabled", status.followExternalClockEnabled, true);
@@ -0,0 +1,163 @@
+#include "app/StatusTelemetry.h"
+
+#include <cstring>
+
+static_assert(StatusTelemetry::kFieldCount <= 32, "Mirror::lastChangedMask() holds one bit per field");
+
+namespace {
+constexpr std::uint8_t kMagic0 = 'S';
+constexpr std::uint8_t kMagic1 = 'T';
+
+std::size_t putVarint(std::uint64_t value, std::uint8_t* out) {
+  std::size_t n = 0;
+  while (value >= 0x80u) {
+    out[n++] = static_cast<std::uint8_t>(value | 0x80u);
+    value >>= 7u;
+  }
+  out[n++] = static_cast<std::uint8_t>(value);
+  return n;
+}
+
+bool getVarint(const std::uint8_t* data, std::size_t size, std::size_t& pos, std::uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64u; shift += 7u) {
+    if (pos >= size) {
+      return false;
+    }
+    const std::uint8_t byte = data[pos++];
+    value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+    if ((byte & 0x80u) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+StatusTelemetry::Values StatusTelemetry::sample(const seedbox::StatusSnapshot& status, std::uint8_t modeId,
+                                                std::uint8_t pageId) {
+  Values v{};
+  const auto set = [&v](Field field, std::uint64_t value) { v[index(field)] = value; };
+  set(Field::kMode, modeId);
+  set(Field::kPage, pageId);
+  set(Field::kMasterSeed, status.masterSeed);
+  set(Field::kActivePresetId, status.activePresetId);
+  set(Field::kBpm, floatBits(status.bpm));
+  set(Field::kSchedulerTick, status.schedulerTick);
+  const auto& host = status.hostDiagnostics;
+  set(Field::kMidiDroppedCount, host.midiDroppedCount);
+  set(Field::kOversizeBlockDropCount, host.oversizeBlockDropCount);
+  set(Field::kLastOversizeBlockFrames, host.lastOversizeBlockFrames);
+  set(Field::kPreparedScratchFrames, host.preparedScratchFrames);
+  set(Field::kCommandQueueOverflowCount, host.commandQueueOverflowCount);
+  set(Field::kCommandQueueHighWater, host.commandQueueHighWater);
+  set(Field::kCommandQueueMaxLatencyUs, host.commandQueueMaxLatencyUs);
+  set(Field::kExternalClockDominant, status.externalClockDominant);
+  set(Field::kFollowExternalClockEnabled, status.followExternalClockEnabled);
+  set(Field::kWaitingForExternalClock, status.waitingForExternalClock);
+  set(Field::kQuietMode, status.quietMode);
+  set(Field::kGlobalSeedLocked, status.globalSeedLocked);
+  set(Field::kFocusSeedLocked, status.focusSeedLocked);
+  set(Field::kHasFocusedSeed, status.hasFocusedSeed);
+  set(Field::kFocusSeedIndex, status.focusSeedIndex);
+  set(Field::kFocusSeedId, status.focusSeedId);
+  set(Field::kFocusSeedEngineId, status.focusSeedEngineId);
+  return v;
+}
+
+std::uint64_t StatusTelemetry::floatBits(float value) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float StatusTelemetry::bitsToFloat(std::uint64_t bits) {
+  const auto narrow = static_cast<std::uint32_t>(bits);
+  float value = 0.0f;
+  std::memcpy(&value, &narrow, sizeof(value));
+  return value;
+}
+
+std::uint32_t StatusTelemetry::publish(const Values& values) {
+  // The very first publish stamps every slot, so "since 0" is a full frame
+  // even for fields whose value happens to be zero.
+  const bool first = sequence_ == 0;
+  const std::uint32_t next = sequence_ + 1u;
+  bool any = false;
+  for (std::size_t i = 0; i < kFieldCount; ++i) {
+    if (first || values[i] != values_[i]) {
+      values_[i] = values[i];
+      sequences_[i] = next;
+      any = true;
+    }
+  }
+  if (any) {
+    sequence_ = next;
+  }
+  return sequence_;
+}
+
+std::size_t StatusTelemetry::changesSince(std::uint32_t since, Change* out, std::size_t capacity) const {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < kFieldCount && count < capacity; ++i) {
+    if (sequences_[i] > since) {
+      out[count++] = Change{static_cast<Field>(i), sequences_[i], values_[i]};
+    }
+  }
+  return count;
+}
+
+std::size_t StatusTelemetry::encodeSince(std::uint32_t since, std::uint8_t* out, std::size_t capacity) const {
+  std::array<std::uint8_t, kMaxFrameBytes> frame{};
+  std::size_t n = 0;
+  frame[n++] = kMagic0;
+  frame[n++] = kMagic1;
+  frame[n++] = kWireVersion;
+  n += putVarint(sequence_, frame.data() + n);
+  const std::size_t countPos = n++;
+  std::uint8_t count = 0;
+  for (std::size_t i = 0; i < kFieldCount; ++i) {
+    if (sequences_[i] > since) {
+      frame[n++] = static_cast<std::uint8_t>(i);
+      n += putVarint(values_[i], frame.data() + n);
+      ++count;
+    }
+  }
+  frame[countPos] = count;
+  if (!out || n > capacity) {
+    return 0;
+  }
+  std::memcpy(out, frame.data(), n);
+  return n;
+}
+
+bool StatusTelemetry::Mirror::apply(const std::uint8_t* data, std::size_t size) {
+  if (!data || size < 5 || data[0] != kMagic0 || data[1] != kMagic1 || data[2] != kWireVersion) {
+    return false;
+  }
+  std::size_t pos = 3;
+  std::uint64_t sequence = 0;
+  if (!getVarint(data, size, pos, sequence) || pos >= size) {
+    return false;
+  }
+  const std::uint8_t count = data[pos++];
+  // Decode into a scratch copy first so a bad frame leaves the mirror intact.
+  Values next = values_;
+  std::uint32_t mask = 0;
+  for (std::uint8_t c = 0; c < count; ++c) {
+    if (pos >= size) {
+      return false;
+    }
+    const std::uint8_t id = data[pos++];
+    std::uint64_t value = 0;
+    if (id >= kFieldCount || !getVarint(data, size, pos, value)) {
+      return false;
+    }
+    next[id] = value;
+    mask |= 1u << id;
+  }
+  values_ = next;
+  sequence_ = static_cast<std::uint32_t>(sequence);
+  lastChangedMask_ = mask;
+  return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+//
+// StatusTelemetry
+// ---------------
+// A numeric, sequence-stamped view of the status document.  `captureStatusJson`
+// re-renders the whole payload on every request, which is fine for a one-off
+// but wasteful for a serial monitor or editor panel polling at tens of Hz.
+// Here every status value is a fixed slot in a schema, each slot remembers the
+// sequence number at which it last changed, and a consumer asks for "what moved
+// since sequence N" and gets only those slots.
+//
+// The flow is pull-based: whoever polls calls publish() with a fresh sample,
+// which bumps the sequence once if anything differs, then reads the delta for
+// its own last-seen sequence.  Several consumers can poll at different rates;
+// they each just remember a different N.  Sequence 0 means "never seen
+// anything", so asking for changes since 0 always returns the full state.
+//
+// The wire frame is small and self-describing enough for a serial link:
+//   'S' 'T' version  varint(sequence)  count  { fieldId varint(value) }*count
+// Floats travel as their IEEE-754 bits.  Mirror on the receiving side applies
+// frames in order and rebuilds the same slot table.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "app/StatusSnapshot.h"
+
+class StatusTelemetry {
+public:
+  // Append-only: ids go over the wire, so new fields join at the end.
+  enum class Field : std::uint8_t {
+    kMode = 0,
+    kPage,
+    kMasterSeed,
+    kActivePresetId,
+    kBpm,  // float bits
+    kSchedulerTick,
+    kMidiDroppedCount,
+    kOversizeBlockDropCount,
+    kLastOversizeBlockFrames,
+    kPreparedScratchFrames,
+    kCommandQueueOverflowCount,
+    kCommandQueueHighWater,
+    kCommandQueueMaxLatencyUs,
+    kExternalClockDominant,
+    kFollowExternalClockEnabled,
+    kWaitingForExternalClock,
+    kQuietMode,
+    kGlobalSeedLocked,
+    kFocusSeedLocked,
+    kHasFocusedSeed,
+    kFocusSeedIndex,
+    kFocusSeedId,
+    kFocusSeedEngineId,
+    kCount,
+  };
+
+  static constexpr std::size_t kFieldCount = static_cast<std::size_t>(Field::kCount);
+  static constexpr std::uint8_t kWireVersion = 1;
+  // Header (2 magic + version + 5-byte varint + count) plus every field at its
+  // worst-case 1 + 10 bytes: a buffer this big always fits a full frame.
+  static constexpr std::size_t kMaxFrameBytes = 9 + kFieldCount * 11;
+
+  using Values = std::array<std::uint64_t, kFieldCount>;
+
+  struct Change {
+    Field field{Field::kMode};
+    std::uint32_t sequence{0};
+    std::uint64_t value{0};
+  };
+
+  // Flatten a status snapshot into the schema.  Mode and page travel as their
+  // enum ids; the snapshot only carries their labels.
+  static Values sample(const seedbox::StatusSnapshot& status, std::uint8_t modeId, std::uint8_t pageId);
+
+  static std::uint64_t floatBits(float value);
+  static float bitsToFloat(std::uint64_t bits);
+
+  // Returns the sequence after publishing.  Unchanged samples leave it alone.
+  std::uint32_t publish(const Values& values);
+
+  std::uint32_t sequence() const { return sequence_; }
+  std::uint64_t value(Field field) const { return values_[index(field)]; }
+  std::uint32_t fieldSequence(Field field) const { return sequences_[index(field)]; }
+
+  // Copy the fields changed after `since` into `out` (schema order) and return
+  // how many there were.  With too little room the tail is dropped, so size
+  // `out` for kFieldCount when in doubt.
+  std::size_t changesSince(std::uint32_t since, Change* out, std::size_t capacity) const;
+
+  // Encode the changes after `since` as one wire frame.  Returns the bytes
+  // written, or 0 when `capacity` cannot hold the whole frame.
+  std::size_t encodeSince(std::uint32_t since, std::uint8_t* out, std::size_t capacity) const;
+
+  // The receiving end of encodeSince().
+  class Mirror {
+  public:
+    // False (and no state touched) for truncated or foreign frames.
+    bool apply(const std::uint8_t* data, std::size_t size);
+
+    std::uint32_t sequence() const { return sequence_; }
+    std::uint64_t value(Field field) const { return values_[index(field)]; }
+    // Slots touched by the last applied frame, one bit per field id.
+    std::uint32_t lastChangedMask() const { return lastChangedMask_; }
+
+  private:
+    Values values_{};
+    std::uint32_t sequence_{0};
+    std::uint32_t lastChangedMask_{0};
+  };
+
+private:
+  static constexpr std::size_t index(Field field) { return static_cast<std::size_t>(field); }
+
+  Values values_{};
+  std::array<std::uint32_t, kFieldCount> sequences_{};
+  std::uint32_t sequence_{0};
+};
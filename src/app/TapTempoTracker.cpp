@@ -1,63 +1,154 @@
 #include "app/TapTempoTracker.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
+namespace {
+// An interval within this fraction of the estimate counts as "the same beat".
+constexpr double kAgreeTolerance = 0.15;
+// Trimmed mean window around the median.
+constexpr double kInlierTolerance = 0.12;
+constexpr float kFallbackBpm = 120.f;
+
+bool near(double value, double target, double tolerance) {
+  return std::fabs(value - target) <= target * tolerance;
+}
+
+std::uint32_t clampToU32(std::uint64_t value) {
+  return static_cast<std::uint32_t>(std::min<std::uint64_t>(value, std::numeric_limits<std::uint32_t>::max()));
+}
+}  // namespace
+
 std::optional<std::uint32_t> TapTempoTracker::noteTap(std::uint64_t timestampUs) {
-  std::optional<std::uint32_t> intervalMs;
-  if (lastTapUs_ != 0 && timestampUs > lastTapUs_) {
-    const std::uint64_t deltaUs = timestampUs - lastTapUs_;
-    const std::uint64_t rawIntervalMs = deltaUs / 1000ULL;
-    if (rawIntervalMs > 0) {
-      const std::uint64_t clamped =
-          std::min<std::uint64_t>(rawIntervalMs, static_cast<std::uint64_t>(std::numeric_limits<std::uint32_t>::max()));
-      intervalMs = static_cast<std::uint32_t>(clamped);
-      recordInterval(*intervalMs);
+  if (lastTapUs_ == 0 || timestampUs <= lastTapUs_ || timestampUs - lastTapUs_ > kMaxIntervalUs) {
+    // First tap of a phrase: it only sets the anchor.
+    lastTapUs_ = timestampUs;
+    suspectTapUs_ = 0;
+    foldedIntervalUs_ = 0;
+    return std::nullopt;
+  }
+
+  const std::uint64_t intervalUs = timestampUs - lastTapUs_;
+  const Estimate current = estimate();
+  std::uint64_t accepted = 0;
+  std::uint64_t folded = 0;
+  if (suspectTapUs_ != 0 && timestampUs > suspectTapUs_ &&
+      near(static_cast<double>(timestampUs - suspectTapUs_), static_cast<double>(suspectIntervalUs_),
+           kAgreeTolerance)) {
+    // The outlier came back with the same spacing: the performer really
+    // changed tempo (doubling included), so restart the history there.  This
+    // is checked first; a stray tap almost never lands where it would.
+    clearHistory();
+    recordIntervalUs(clampToU32(suspectIntervalUs_));
+    accepted = timestampUs - suspectTapUs_;
+  } else if (count_ < 2 || near(static_cast<double>(intervalUs), current.intervalUs, kAgreeTolerance)) {
+    // Too little history to argue with, or the tap agrees with it.
+    accepted = intervalUs;
+  } else if (near(static_cast<double>(intervalUs), current.intervalUs * 2.0, kAgreeTolerance)) {
+    if (foldedIntervalUs_ != 0 &&
+        near(static_cast<double>(intervalUs), static_cast<double>(foldedIntervalUs_), kAgreeTolerance)) {
+      // Two beats again: that was half tempo, not a clumsy hand.  Restart the
+      // history there, exactly like a confirmed faster tempo.
+      clearHistory();
+      recordIntervalUs(clampToU32(foldedIntervalUs_));
+      accepted = intervalUs;
+    } else {
+      // Missed a tap: two beats went by.  The grid is still intact, so keep
+      // it, but remember the interval in case the next one says the same.
+      accepted = intervalUs / 2u;
+      folded = intervalUs;
     }
+  } else {
+    // Double tap or a stray hit.  Remember it in case the next tap confirms a
+    // new tempo, but keep measuring from the last good tap.
+    suspectIntervalUs_ = suspectTapUs_ != 0 && timestampUs > suspectTapUs_ ? timestampUs - suspectTapUs_ : intervalUs;
+    suspectTapUs_ = timestampUs;
+    return std::nullopt;
   }
 
+  suspectTapUs_ = 0;
+  foldedIntervalUs_ = folded;
   lastTapUs_ = timestampUs;
-  return intervalMs;
+  const std::uint32_t acceptedUs = clampToU32(accepted);
+  recordIntervalUs(acceptedUs);
+  const std::uint32_t acceptedMs = acceptedUs / 1000u;
+  return acceptedMs > 0 ? std::optional<std::uint32_t>(acceptedMs) : std::nullopt;
 }
 
-void TapTempoTracker::resetPendingTap() { lastTapUs_ = 0; }
+void TapTempoTracker::resetPendingTap() {
+  lastTapUs_ = 0;
+  suspectTapUs_ = 0;
+  foldedIntervalUs_ = 0;
+}
 
 void TapTempoTracker::recordInterval(std::uint32_t intervalMs) {
   if (intervalMs == 0) {
     return;
   }
-  history_.push_back(intervalMs);
-  if (history_.size() > kMaxHistory) {
-    const std::size_t drop = history_.size() - kMaxHistory;
-    history_.erase(history_.begin(), history_.begin() + static_cast<std::ptrdiff_t>(drop));
-  }
+  recordIntervalUs(clampToU32(static_cast<std::uint64_t>(intervalMs) * 1000u));
 }
 
-float TapTempoTracker::currentBpm() const {
-  if (history_.empty()) {
-    return 120.f;
+void TapTempoTracker::recordIntervalUs(std::uint32_t intervalUs) {
+  if (intervalUs == 0) {
+    return;
   }
+  ring_[head_] = intervalUs;
+  head_ = (head_ + 1) % kMaxHistory;
+  count_ = std::min(count_ + 1, kMaxHistory);
+}
 
+void TapTempoTracker::clearHistory() {
+  head_ = 0;
+  count_ = 0;
+}
+
+TapTempoTracker::Estimate TapTempoTracker::estimate() const {
+  Estimate out{};
+  if (count_ == 0) {
+    return out;
+  }
+  std::array<std::uint32_t, kMaxHistory> sorted{};
+  std::copy(ring_.begin(), ring_.begin() + static_cast<std::ptrdiff_t>(count_), sorted.begin());
+  std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count_));
+  const double median = (count_ % 2u) ? static_cast<double>(sorted[count_ / 2u])
+                                      : 0.5 * (static_cast<double>(sorted[count_ / 2u - 1u]) +
+                                               static_cast<double>(sorted[count_ / 2u]));
   double total = 0.0;
-  std::size_t count = 0;
-  for (std::uint32_t interval : history_) {
-    if (interval == 0) {
-      continue;
+  for (std::size_t i = 0; i < count_; ++i) {
+    const double interval = static_cast<double>(sorted[i]);
+    if (near(interval, median, kInlierTolerance)) {
+      total += interval;
+      ++out.inliers;
     }
-    total += static_cast<double>(interval);
-    ++count;
   }
-  if (count == 0) {
-    return 120.f;
+  // With an even split (e.g. two wildly different intervals) nothing may sit
+  // near the median; fall back to the median itself.
+  out.intervalUs = out.inliers ? total / static_cast<double>(out.inliers) : median;
+  return out;
+}
+
+float TapTempoTracker::currentBpm() const {
+  const Estimate current = estimate();
+  if (current.intervalUs <= 0.0) {
+    return kFallbackBpm;
   }
+  return static_cast<float>(60000000.0 / current.intervalUs);
+}
 
-  const double averageMs = total / static_cast<double>(count);
-  if (averageMs <= 0.0) {
-    return 120.f;
+float TapTempoTracker::confidence() const {
+  if (count_ == 0) {
+    return 0.0f;
   }
-  return static_cast<float>(60000.0 / averageMs);
+  const Estimate current = estimate();
+  const double agreement = static_cast<double>(current.inliers) / static_cast<double>(count_);
+  const double depth = std::min(static_cast<double>(count_), 4.0) / 4.0;
+  return static_cast<float>(agreement * depth);
 }
 
 std::uint32_t TapTempoTracker::lastIntervalMs() const {
-  return history_.empty() ? 0u : history_.back();
+  if (count_ == 0) {
+    return 0u;
+  }
+  return ring_[(head_ + kMaxHistory - 1) % kMaxHistory] / 1000u;
 }
@@ -1,22 +1,70 @@
 #pragma once
 
+//
+// TapTempoTracker
+// ---------------
+// Turns a stream of Tap button timestamps into a tempo you can trust.  Human
+// taps are noisy in three distinct ways, and each gets its own treatment:
+//
+//   * jitter      -- every interval is a few ms off.  The estimate is a
+//                    trimmed mean around the median, so one sloppy tap moves
+//                    it a little instead of dragging the average.
+//   * missed tap  -- an interval of ~2 beats.  Folded in half and kept.
+//   * double tap  -- a stray tap mid-beat.  Rejected; the anchor stays on the
+//                    last good tap so the next real tap still measures a beat.
+//
+// A *deliberate* tempo change looks like an outlier at first, so one rejected
+// tap is held as a suspect.  If the next tap confirms it (same interval again)
+// the history restarts at the new tempo.  Halving the tempo looks exactly like
+// a missed tap, so a folded interval is held the same way: a second ~2-beat
+// interval in a row means the performer slowed down, not that they missed
+// twice.
+//
+// Intervals are kept in microseconds in a fixed ring: no allocation, no erase
+// from the front, safe to call from the control tick.
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
-#include <vector>
 
 class TapTempoTracker {
 public:
+  static constexpr std::size_t kMaxHistory = 8;
+  // Taps further apart than this start a new phrase instead of measuring one
+  // enormous beat (20 BPM is the slowest tempo the app accepts).
+  static constexpr std::uint64_t kMaxIntervalUs = 3000000;
+
+  // Feed one tap.  Returns the interval (ms) it contributed to the estimate,
+  // or nullopt when the tap only set the anchor or was rejected.
   std::optional<std::uint32_t> noteTap(std::uint64_t timestampUs);
   void resetPendingTap();
+  // Push a pre-measured interval (host UIs that time taps themselves).  These
+  // skip the double/missed-tap logic; the median still shrugs off outliers.
   void recordInterval(std::uint32_t intervalMs);
+  void recordIntervalUs(std::uint32_t intervalUs);
 
   float currentBpm() const;
+  // 0..1: how much of the history agrees with the estimate, scaled down until
+  // there are at least four intervals to agree.
+  float confidence() const;
   std::uint32_t lastIntervalMs() const;
+  // Timestamp of the tap the current beat grid hangs off (0 = none yet).
+  std::uint64_t lastTapUs() const { return lastTapUs_; }
 
 private:
-  static constexpr std::size_t kMaxHistory = 8;
+  struct Estimate {
+    double intervalUs{0.0};
+    std::size_t inliers{0};
+  };
+
+  Estimate estimate() const;
+  void clearHistory();
 
-  std::vector<std::uint32_t> history_{};
+  std::array<std::uint32_t, kMaxHistory> ring_{};
+  std::size_t head_{0};   // next write slot
+  std::size_t count_{0};
   std::uint64_t lastTapUs_{0};
+  std::uint64_t suspectTapUs_{0};
+  std::uint64_t suspectIntervalUs_{0};
+  std::uint64_t foldedIntervalUs_{0};  // last ~2-beat interval, until a tap disagrees
 };
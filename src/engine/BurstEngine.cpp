@@ -10,12 +10,36 @@
 Engine::Type BurstEngine::type() const noexcept { return Engine::Type::kBurst; }
 
 namespace {
+static_assert((BurstEngine::kHitRingCapacity & (BurstEngine::kHitRingCapacity - 1)) == 0,
+              "Burst hit ring must be a power of two");
+constexpr std::size_t kHitRingMask = BurstEngine::kHitRingCapacity - 1;
+constexpr float kTwoPi = 6.2831853071795864769f;
+constexpr float kBaseToneHz = 220.0f;
+constexpr float kVoiceGain = 0.2f;
+// Each hit in a cluster is a little quieter than the one before, so a long
+// burst reads as a bounce rather than a machine gun.
+constexpr float kClusterTaper = 0.85f;
+// A voice is retired once its envelope falls 60 dB below the hit peak.
+constexpr float kSilenceFloor = 0.001f;
+constexpr float kClickSeconds = 0.001f;
+
 constexpr std::uint8_t clampCluster(std::int32_t value) {
   if (value < 1) return 1;
-  if (value > 16) return 16;
+  if (value > static_cast<std::int32_t>(BurstEngine::kMaxClusterCount)) {
+    return static_cast<std::uint8_t>(BurstEngine::kMaxClusterCount);
+  }
   return static_cast<std::uint8_t>(value);
 }
 
+// xorshift32 mapped onto [-1, 1]. Cheap, deterministic, and good enough for
+// the breathy part of a click.
+float nextNoise(std::uint32_t& state) {
+  state ^= state << 13u;
+  state ^= state >> 17u;
+  state ^= state << 5u;
+  return static_cast<float>(state) * (2.0f / 4294967295.0f) - 1.0f;
+}
+
 void appendU32(Engine::StateBuffer& out, std::uint32_t value) {
   out.push_back(static_cast<std::uint8_t>(value & 0xFFu));
   out.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFFu));
@@ -45,15 +69,29 @@ std::size_t wrapDelayTap(std::size_t writePos, std::size_t bufferSize, std::size
 void BurstEngine::prepare(const Engine::PrepareContext& ctx) {
   generationSeed_ = ctx.masterSeed;
   lastSeedId_ = 0;
-  hostSampleRate_ = (ctx.sampleRate > 0) ? static_cast<float>(ctx.sampleRate) : 48000.0f;
-  const std::size_t echoFrames = std::max<std::size_t>(static_cast<std::size_t>(hostSampleRate_), ctx.framesPerBlock + 1u);
+  // Ring time, tone partial, click length and cluster spacing all come from
+  // the cache, so a hit sounds the same at 44.1 kHz as at 96 kHz.
+  rates_.prepare(static_cast<float>(ctx.sampleRate));
+  const std::size_t echoFrames = std::max<std::size_t>(rates_.samples(1.0f), ctx.framesPerBlock + 1u);
   hostEchoLeft_.assign(echoFrames, 0.0f);
   hostEchoRight_.assign(echoFrames, 0.0f);
   hostWritePos_ = 0;
   hostCursor_ = 0;
+  oversampleLeft_.reset();
+  oversampleRight_.reset();
   // Pending triggers stay resident between seeds; clearing here keeps the
   // scheduler honest when a test fixture swaps from noisy to quiet seeds.
-  pending_.clear();
+  lastCluster_.count_ = 0;
+  hitHead_ = 0;
+  hitCount_ = 0;
+  droppedHits_ = 0;
+  voices_.fill(ExciterVoice{});
+  maxVoices_ = kMaxVoices;
+  tails_.fill(ExciterVoice{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
+  allocator_.resetCounters();
+  nextHandle_ = 1;
+  renderSample_ = 0;
 }
 
 void BurstEngine::onTick(const Engine::TickContext& ctx) {
@@ -79,12 +117,34 @@ void BurstEngine::onParam(const Engine::ParamChange& change) {
 }
 
 void BurstEngine::onSeed(const Engine::SeedContext& ctx) {
-  pending_.clear();
-  pending_.reserve(clusterCount_);
+  const Seed& seed = ctx.seed;
+  // The seed colours every hit in the cluster the same way: pitch sets the
+  // tone partial, `tone` leans from pure tone into noise, `envD` is the ring
+  // time, and `spread` scatters alternate hits across the stereo field.
+  Hit hit{};
+  hit.toneHz = kBaseToneHz * rates_.pitchRatio(std::clamp(seed.pitch, -48.0f, 48.0f));
+  hit.noiseMix = std::clamp(seed.tone, 0.0f, 1.0f);
+  hit.decaySeconds = std::clamp(seed.envD, 0.005f, 0.5f);
+  const float spread = std::clamp(seed.spread, 0.0f, 1.0f);
+  const std::uint32_t noiseBase = generationSeed_ ^ seed.prng ^ (seed.id * 0x9E3779B9u);
+  hit.seedId = seed.id;
+  hit.priority = VoiceAllocator::priorityFromSeed(seed);
+
+  lastCluster_.count_ = 0;
   std::uint32_t when = ctx.whenSamples;
+  float amplitude = 1.0f;
   for (std::uint8_t i = 0; i < clusterCount_; ++i) {
-    pending_.push_back(when);
+    lastCluster_.times_[lastCluster_.count_++] = when;
+    hit.whenSamples = when;
+    hit.amplitude = amplitude;
+    hit.pan = 0.5f + ((i & 1u) ? 0.5f : -0.5f) * spread;
+    hit.noiseSeed = noiseBase ^ (static_cast<std::uint32_t>(i + 1u) * 0x85EBCA6Bu);
+    if (hit.noiseSeed == 0) {
+      hit.noiseSeed = 1;
+    }
+    enqueueHit(hit);
     when += spacingSamples_;
+    amplitude *= kClusterTaper;
   }
   // `lastSeedId_` mirrors the Euclid engine so the router and UI have a stable
   // label for the last trigger cloud emitted by this engine.
@@ -97,7 +157,7 @@ void BurstEngine::processInputAudio(const Seed& seed, const Engine::RenderContex
   }
   if (hostEchoLeft_.empty() || hostEchoRight_.empty()) {
     const std::size_t echoFrames =
-        std::max<std::size_t>(static_cast<std::size_t>(std::max(48000.0f, hostSampleRate_)), ctx.frames + 1u);
+        std::max<std::size_t>(static_cast<std::size_t>(std::max(48000.0f, rates_.sampleRate())), ctx.frames + 1u);
     hostEchoLeft_.assign(echoFrames, 0.0f);
     hostEchoRight_.assign(echoFrames, 0.0f);
   }
@@ -106,16 +166,17 @@ void BurstEngine::processInputAudio(const Seed& seed, const Engine::RenderContex
   const std::size_t cluster = static_cast<std::size_t>(
       std::clamp<int>(static_cast<int>(std::lround(1.0f + (density * 1.6f) + (seed.probability * 3.0f))), 1, 8));
   const std::size_t spacingSamples = std::clamp<std::size_t>(
-      static_cast<std::size_t>(hostSampleRate_ * (0.015f + (seed.jitterMs * 0.0008f))), 48u,
+      rates_.samples(0.015f + (seed.jitterMs * 0.0008f)), 48u,
       std::max<std::size_t>(96u, hostEchoLeft_.size() / 6u));
   const std::size_t pulseWidth = std::clamp<std::size_t>(
-      static_cast<std::size_t>(hostSampleRate_ * (0.006f + (seed.tone * 0.018f))), 24u, spacingSamples);
+      rates_.samples(0.006f + (seed.tone * 0.018f)), 24u, spacingSamples);
   const std::size_t cycleSamples = std::max<std::size_t>(
       cluster * spacingSamples,
-      static_cast<std::size_t>(hostSampleRate_ * (0.16f + ((1.0f - std::clamp(seed.spread, 0.0f, 1.0f)) * 0.18f))));
+      rates_.samples(0.16f + ((1.0f - std::clamp(seed.spread, 0.0f, 1.0f)) * 0.18f)));
   const float feedback = 0.2f + (0.38f * std::clamp(seed.mutateAmt, 0.0f, 1.0f));
   const float wet = 0.7f + (0.2f * std::clamp(seed.probability, 0.0f, 1.0f));
   const std::size_t delaySize = hostEchoLeft_.size();
+  const auto saturate = [](float x) { return std::tanh(x); };
 
   for (std::size_t i = 0; i < ctx.frames; ++i) {
     const float inL = ctx.inputLeft[i];
@@ -133,8 +194,8 @@ void BurstEngine::processInputAudio(const Seed& seed, const Engine::RenderContex
                         (hostEchoRight_[wrapDelayTap(hostWritePos_, delaySize, delayB)] * 0.35f);
 
     const float gate = pulseOpen ? 1.0f : (0.08f + (0.12f * std::clamp(seed.spread, 0.0f, 1.0f)));
-    const float outL = std::tanh((inL * gate * (1.0f - wet * 0.25f)) + (echoL * wet * 1.25f));
-    const float outR = std::tanh((inR * gate * (1.0f - wet * 0.25f)) + (echoR * wet * 1.25f));
+    const float outL = oversampleLeft_.process((inL * gate * (1.0f - wet * 0.25f)) + (echoL * wet * 1.25f), saturate);
+    const float outR = oversampleRight_.process((inR * gate * (1.0f - wet * 0.25f)) + (echoR * wet * 1.25f), saturate);
 
     ctx.left[i] += outL;
     ctx.right[i] += outR;
@@ -146,8 +207,181 @@ void BurstEngine::processInputAudio(const Seed& seed, const Engine::RenderContex
   }
 }
 
+bool BurstEngine::enqueueHit(const Hit& hit) {
+  if (hitCount_ == kHitRingCapacity) {
+    ++droppedHits_;
+    return false;
+  }
+  Hit& slot = hits_[(hitHead_ + hitCount_) & kHitRingMask];
+  slot = hit;
+  slot.live = true;
+  ++hitCount_;
+  return true;
+}
+
+std::size_t BurstEngine::allocateVoice(const Hit& hit) {
+  // Same default stealing rule as the sampler and resonator: earliest start
+  // loses, lowest handle breaks ties.  The policy knob can change that.
+  const VoiceAllocator::Request request{hit.seedId, hit.priority};
+  const auto choice = allocator_.allocate(maxVoices_, request, [this](std::size_t i) {
+    const ExciterVoice& v = voices_[i];
+    return VoiceAllocator::Candidate{v.active, v.startSample, v.handle, v.level * v.amplitude, v.priority, v.seedId};
+  });
+  if (choice.stolen) {
+    tails_[choice.index] = voices_[choice.index];
+    tailFades_[choice.index].start(rates_.sampleRate());
+  }
+  return choice.index;
+}
+
+void BurstEngine::setMaxVoices(std::size_t voices) {
+  maxVoices_ = std::max<std::size_t>(1, std::min(voices, kMaxVoices));
+  for (std::size_t i = maxVoices_; i < kMaxVoices; ++i) {
+    retireVoice(i);
+  }
+}
+
+void BurstEngine::retireVoice(std::size_t index) {
+  ExciterVoice& voice = voices_[index];
+  if (!voice.active) {
+    return;
+  }
+  tails_[index] = voice;
+  tailFades_[index].start(rates_.sampleRate());
+  voice.active = false;
+}
+
+void BurstEngine::launch(const Hit& hit, std::uint64_t startSample) {
+  ExciterVoice& voice = voices_[allocateVoice(hit)];
+  voice = ExciterVoice{};
+  voice.seedId = hit.seedId;
+  voice.priority = hit.priority;
+  voice.active = true;
+  voice.handle = nextHandle_++;
+  voice.startSample = startSample;
+  voice.amplitude = hit.amplitude;
+  voice.toneHz = hit.toneHz;
+  voice.level = 1.0f;
+  // -60 dB after `decaySeconds`.
+  voice.decayPerSample = rates_.decayPerSample(hit.decaySeconds);
+  const float omega = rates_.radiansPerSample(hit.toneHz);
+  voice.rotateRe = std::cos(omega);
+  voice.rotateIm = std::sin(omega);
+  voice.noiseMix = hit.noiseMix;
+  voice.noiseState = hit.noiseSeed;
+  voice.clickSamples = std::max<std::uint32_t>(1u, static_cast<std::uint32_t>(rates_.samples(kClickSeconds)));
+  const float theta = hit.pan * (kTwoPi * 0.25f);
+  voice.leftGain = std::cos(theta);
+  voice.rightGain = std::sin(theta);
+}
+
 void BurstEngine::renderAudio(const Engine::RenderContext& ctx) {
-  (void)ctx;
+  if (!ctx.left || !ctx.right || ctx.frames == 0) {
+    return;
+  }
+  const std::uint64_t blockStart = renderSample_;
+  const std::uint64_t blockEnd = blockStart + ctx.frames;
+
+  // Launch every hit that falls inside this block. Clusters from different
+  // seeds can interleave, so we look past a not-yet-due head instead of
+  // stopping at it; launched slots are tombstoned and reclaimed from the head.
+  for (std::size_t n = 0; n < hitCount_; ++n) {
+    Hit& hit = hits_[(hitHead_ + n) & kHitRingMask];
+    if (!hit.live || hit.whenSamples >= blockEnd) {
+      continue;
+    }
+    // A hit that arrived late still plays, just from the top of the block.
+    launch(hit, std::max<std::uint64_t>(hit.whenSamples, blockStart));
+    hit.live = false;
+  }
+  while (hitCount_ > 0 && !hits_[hitHead_].live) {
+    hitHead_ = (hitHead_ + 1) & kHitRingMask;
+    --hitCount_;
+  }
+
+  for (auto& voice : voices_) {
+    if (voice.active) {
+      renderVoice(voice, nullptr, ctx, blockStart);
+    }
+  }
+  for (std::size_t t = 0; t < tails_.size(); ++t) {
+    if (tailFades_[t].active()) {
+      renderVoice(tails_[t], &tailFades_[t], ctx, blockStart);
+    }
+  }
+
+  renderSample_ = blockEnd;
+}
+
+void BurstEngine::renderVoice(ExciterVoice& voice, VoiceAllocator::StealFade* fade, const Engine::RenderContext& ctx,
+                              std::uint64_t blockStart) {
+  const float gain = kVoiceGain;
+  std::size_t i = voice.startSample > blockStart ? static_cast<std::size_t>(voice.startSample - blockStart) : 0u;
+  std::uint64_t age = blockStart + i - voice.startSample;
+  const float toneMix = 1.0f - voice.noiseMix;
+  for (; i < ctx.frames; ++i, ++age) {
+    float excite = toneMix * voice.phasorIm + voice.noiseMix * nextNoise(voice.noiseState);
+    if (age < voice.clickSamples) {
+      excite += 1.0f;
+    }
+    float sample = excite * voice.level * voice.amplitude * gain;
+    if (fade != nullptr) {
+      if (!fade->active()) {
+        break;
+      }
+      sample *= fade->next();
+    }
+    ctx.left[i] += sample * voice.leftGain;
+    ctx.right[i] += sample * voice.rightGain;
+
+    voice.level *= voice.decayPerSample;
+    const float re = voice.phasorRe * voice.rotateRe - voice.phasorIm * voice.rotateIm;
+    voice.phasorIm = voice.phasorRe * voice.rotateIm + voice.phasorIm * voice.rotateRe;
+    voice.phasorRe = re;
+  }
+  // Pull the phasor back onto the unit circle once per block so float
+  // rounding never lets the tone creep louder or quieter.
+  const float magnitude = std::sqrt(voice.phasorRe * voice.phasorRe + voice.phasorIm * voice.phasorIm);
+  if (magnitude > 0.0f) {
+    voice.phasorRe /= magnitude;
+    voice.phasorIm /= magnitude;
+  }
+  if (voice.level < kSilenceFloor || (fade != nullptr && !fade->active())) {
+    voice.active = false;
+    if (fade != nullptr) {
+      fade->stop();
+    }
+  }
+}
+
+std::size_t BurstEngine::activeVoiceCount() const {
+  std::size_t count = 0;
+  for (const auto& voice : voices_) {
+    count += voice.active ? 1u : 0u;
+  }
+  return count;
+}
+
+std::size_t BurstEngine::fadingVoices() const {
+  std::size_t count = 0;
+  for (const auto& fade : tailFades_) {
+    count += fade.active() ? 1u : 0u;
+  }
+  return count;
+}
+
+BurstEngine::VoiceState BurstEngine::voice(std::size_t index) const {
+  VoiceState state{};
+  if (index >= voices_.size()) {
+    return state;
+  }
+  const auto& src = voices_[index];
+  state.active = src.active;
+  state.handle = src.handle;
+  state.startSample = static_cast<std::uint32_t>(src.startSample);
+  state.amplitude = src.amplitude;
+  state.toneHz = src.toneHz;
+  return state;
 }
 
 Engine::StateBuffer BurstEngine::serializeState() const {
@@ -171,7 +405,14 @@ void BurstEngine::deserializeState(const Engine::StateBuffer& state) {
 }
 
 void BurstEngine::panic() {
-  pending_.clear();
+  lastCluster_.count_ = 0;
+  hitHead_ = 0;
+  hitCount_ = 0;
+  voices_.fill(ExciterVoice{});
+  tails_.fill(ExciterVoice{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
+  nextHandle_ = 1;
+  renderSample_ = 0;
   std::fill(hostEchoLeft_.begin(), hostEchoLeft_.end(), 0.0f);
   std::fill(hostEchoRight_.begin(), hostEchoRight_.end(), 0.0f);
   hostWritePos_ = 0;
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
 #include "engine/Engine.h"
+#include "engine/RateCache.h"
+#include "engine/VoiceAllocator.h"
+#include "util/Oversampler.h"
 
 //
 // BurstEngine
@@ -12,6 +17,13 @@
 // intent: demonstrate how scheduling math can be kept transparent without
 // sacrificing musicality. State serialization mirrors EuclidEngine so reseed
 // flows and lockouts stay deterministic.
+//
+// Every hit in a cluster lands in a fixed-size ring of scheduled sub-triggers.
+// `renderAudio` walks that ring once per block, launches each hit on its exact
+// sample, and plays it through a tiny exciter voice: a click, a breath of
+// noise, and a decaying tone, all shaped by the seed. Nothing on that path
+// allocates — the ring and the voice pool are plain arrays sized up front, and
+// a full ring drops the newest hit (and counts it) instead of growing.
 class BurstEngine : public Engine {
 public:
   enum class Param : std::uint16_t {
@@ -19,6 +31,43 @@ public:
     kSpacingSamples = 1,
   };
 
+  static constexpr std::size_t kMaxClusterCount = 16;
+  // Four maximum-size clusters in flight before anything has to be dropped.
+  static constexpr std::size_t kHitRingCapacity = 64;
+  static constexpr std::size_t kMaxVoices = 8;
+
+  // Trigger times of the most recent cluster. Reads like a small const vector
+  // (size, indexing, iteration) so tests and golden renders can print the
+  // timeline, but it lives in a fixed array so `onSeed` never allocates.
+  class TriggerList {
+  public:
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::uint32_t operator[](std::size_t index) const { return times_[index]; }
+    std::uint32_t front() const { return times_[0]; }
+    std::uint32_t back() const { return times_[count_ - 1]; }
+    const std::uint32_t* begin() const { return times_.data(); }
+    const std::uint32_t* end() const { return times_.data() + count_; }
+
+  private:
+    friend class BurstEngine;
+    std::array<std::uint32_t, kMaxClusterCount> times_{};
+    std::size_t count_{0};
+  };
+
+  // Snapshot of one exciter voice for tests and debug dumps.
+  struct VoiceState {
+    bool active{false};
+    // Bumps on every launch so steals are easy to spot in diffs.
+    std::uint32_t handle{0};
+    // Sample (on the render timeline) where the hit starts sounding.
+    std::uint32_t startSample{0};
+    // Peak level of this hit; later hits in a cluster taper off.
+    float amplitude{0.0f};
+    // Frequency of the tone partial.
+    float toneHz{0.0f};
+  };
+
   Engine::Type type() const noexcept override;
   void prepare(const Engine::PrepareContext& ctx) override;
   void onTick(const Engine::TickContext& ctx) override;
@@ -30,20 +79,110 @@ public:
   void deserializeState(const Engine::StateBuffer& state) override;
   void panic() override;
 
-  const std::vector<std::uint32_t>& pendingTriggers() const { return pending_; }
+  const TriggerList& pendingTriggers() const { return lastCluster_; }
   std::uint32_t generationSeed() const { return generationSeed_; }
   std::uint8_t clusterCount() const { return clusterCount_; }
   std::uint32_t spacingSamples() const { return spacingSamples_; }
 
+  // Hits still waiting in the ring (launched-but-unreclaimed slots included).
+  std::size_t queuedHits() const { return hitCount_; }
+  // Hits refused because the ring was full.
+  std::uint32_t droppedHits() const { return droppedHits_; }
+  std::size_t activeVoiceCount() const;
+  VoiceState voice(std::size_t index) const;
+  // Steal policy once all eight exciters ring (default kOldest).  Levels are
+  // the live decay envelopes, so kQuietest picks the most-decayed hit;
+  // kSameSeedRetrigger turns each seed's cluster into a choke group.
+  void setStealPolicy(StealPolicy policy) { allocator_.setPolicy(policy); }
+  StealPolicy stealPolicy() const { return allocator_.policy(); }
+  // Rate the input saturator runs at (default kBypass, the base rate).  Hot
+  // host input aliases at the base rate; see util/Oversampler.h.
+  void setOversampling(const util::Oversampler::Quality& quality) {
+    oversampleLeft_.setQuality(quality);
+    oversampleRight_.setQuality(quality);
+  }
+  const util::Oversampler::Quality& oversampling() const { return oversampleLeft_.quality(); }
+  const VoiceAllocator::Counters& stealCounters() const { return allocator_.counters(); }
+  // Stolen voices still fading out underneath their replacements.
+  std::size_t fadingVoices() const;
+  // Exciter ceiling, 1..kMaxVoices.  The block-time governor lowers it under
+  // load; exciters above a lowered ceiling fade out like a steal.
+  void setMaxVoices(std::size_t voices);
+  std::size_t maxVoices() const { return maxVoices_; }
+  // Absolute sample index of the next frame `renderAudio` will write.
+  std::uint64_t renderSample() const { return renderSample_; }
+
 private:
+  struct Hit {
+    std::uint32_t whenSamples{0};
+    float amplitude{0.0f};
+    float toneHz{0.0f};
+    float noiseMix{0.0f};
+    float decaySeconds{0.0f};
+    float pan{0.5f};
+    std::uint32_t noiseSeed{0};
+    std::uint32_t seedId{0};
+    std::uint8_t priority{0};
+    // Cleared once the hit has launched; the slot is reclaimed when it
+    // reaches the head of the ring.
+    bool live{false};
+  };
+
+  struct ExciterVoice {
+    bool active{false};
+    std::uint32_t handle{0};
+    std::uint64_t startSample{0};
+    float amplitude{0.0f};
+    float toneHz{0.0f};
+    float level{0.0f};
+    float decayPerSample{0.0f};
+    // The tone is a rotating phasor: one complex multiply per sample instead
+    // of a sin() call.
+    float phasorRe{1.0f};
+    float phasorIm{0.0f};
+    float rotateRe{1.0f};
+    float rotateIm{0.0f};
+    float noiseMix{0.0f};
+    std::uint32_t noiseState{1};
+    std::uint32_t clickSamples{0};
+    float leftGain{0.0f};
+    float rightGain{0.0f};
+    std::uint32_t seedId{0};
+    std::uint8_t priority{0};
+  };
+
+  bool enqueueHit(const Hit& hit);
+  void launch(const Hit& hit, std::uint64_t startSample);
+  std::size_t allocateVoice(const Hit& hit);
+  void retireVoice(std::size_t index);
+  // Mix one voice into the block.  A non-null `fade` scales it down to
+  // silence and retires it when the fade ends.
+  void renderVoice(ExciterVoice& voice, VoiceAllocator::StealFade* fade, const Engine::RenderContext& ctx,
+                   std::uint64_t blockStart);
+
   std::uint8_t clusterCount_{1};
   std::uint32_t spacingSamples_{0};
-  std::vector<std::uint32_t> pending_{};
+  TriggerList lastCluster_{};
   std::uint32_t generationSeed_{0};
   std::uint32_t lastSeedId_{0};
-  float hostSampleRate_{48000.0f};
+  RateCache rates_{};
   std::vector<float> hostEchoLeft_{};
   std::vector<float> hostEchoRight_{};
   std::size_t hostWritePos_{0};
   std::uint64_t hostCursor_{0};
+  util::Oversampler oversampleLeft_{};
+  util::Oversampler oversampleRight_{};
+
+  std::array<Hit, kHitRingCapacity> hits_{};
+  std::size_t hitHead_{0};
+  std::size_t hitCount_{0};
+  std::uint32_t droppedHits_{0};
+  std::array<ExciterVoice, kMaxVoices> voices_{};
+  std::size_t maxVoices_{kMaxVoices};
+  // A stolen exciter rings on here for VoiceAllocator::kStealFadeMs.
+  std::array<ExciterVoice, kMaxVoices> tails_{};
+  std::array<VoiceAllocator::StealFade, kMaxVoices> tailFades_{};
+  VoiceAllocator allocator_{};
+  std::uint32_t nextHandle_{1};
+  std::uint64_t renderSample_{0};
 };
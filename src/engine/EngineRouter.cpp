@@ -101,6 +101,9 @@ const Engine* EngineRouter::findEngine(std::uint8_t engineId) const {
 
 void EngineRouter::init(Mode mode) {
   mode_ = mode;
+  // Fresh engines come up at their boot ceilings; the governor starts over
+  // once AppState has set them.
+  governorEnabled_ = false;
   registry_.clear();
   sampler_ = nullptr;
   granular_ = nullptr;
@@ -129,6 +132,92 @@ void EngineRouter::init(Mode mode) {
       entry.instance->prepare(ctx);
     }
   }
+
+  setLiveCaptureSeconds(liveCaptureSeconds_);
+  if (granular_) {
+    granular_->attachLiveCapture(&liveCapture_);
+  }
+  if (resonator_) {
+    resonator_->attachLiveCapture(&liveCapture_);
+  }
+}
+
+void EngineRouter::setLiveCaptureSeconds(float seconds) {
+  liveCaptureSeconds_ = seconds > 0.0f ? seconds : 0.0f;
+#if SEEDBOX_HW
+  // Teensy RAM can't spare seconds of float stereo; AudioEffectGranular keeps
+  // its own int16 grain memory instead.
+  liveCapture_.prepare(0.0f, hal::audio::sampleRate());
+#else
+  liveCapture_.prepare(liveCaptureSeconds_, hal::audio::sampleRate());
+#endif
+}
+
+void EngineRouter::captureLiveInput(const Engine::RenderContext& ctx) {
+  liveCapture_.write(ctx.inputLeft, ctx.inputRight, ctx.frames);
+}
+
+void EngineRouter::setVoiceGovernorEnabled(bool enabled) {
+  if (enabled == governorEnabled_) {
+    return;
+  }
+  if (!enabled) {
+    governorEnabled_ = false;
+    applyVoiceLimits(true);
+    return;
+  }
+  // Floors keep each engine recognisable under load: a sampler that can only
+  // play one hit still plays the groove, a granular cloud needs a few voices
+  // to be a cloud at all.  Ceilings are the pool sizes.
+  auto lane = [&](std::uint8_t id, std::size_t floor, std::size_t limit, std::size_t ceiling) {
+    governor_.configureLane(id, static_cast<std::uint8_t>(std::min(floor, limit)), static_cast<std::uint8_t>(limit),
+                            static_cast<std::uint8_t>(ceiling));
+  };
+  if (sampler_) {
+    lane(kSamplerId, 1, sampler_->maxVoices(), Sampler::kMaxVoices);
+  }
+  if (granular_) {
+    lane(kGranularId, 4, granular_->maxActiveVoices(), GranularEngine::kVoicePoolSize);
+  }
+  if (resonator_) {
+    lane(kResonatorId, 1, resonator_->maxVoices(), ResonatorBank::kMaxVoices);
+  }
+  if (burst_) {
+    lane(kBurstId, 2, burst_->maxVoices(), BurstEngine::kMaxVoices);
+  }
+  governor_.reset();
+  governorEnabled_ = true;
+}
+
+void EngineRouter::governVoices(std::uint32_t renderNanos, std::uint32_t budgetNanos,
+                                const VoiceGovernor::LaneNanos& engineNanos) {
+  if (!governorEnabled_) {
+    return;
+  }
+  if (governor_.noteBlock(renderNanos, budgetNanos, engineNanos)) {
+    applyVoiceLimits(false);
+  }
+}
+
+void EngineRouter::applyVoiceLimits(bool nominal) {
+  auto limit = [&](std::uint8_t id) {
+    const VoiceGovernor::Lane& lane = governor_.lane(id);
+    return nominal ? lane.nominal : lane.limit;
+  };
+  // Each setter is a no-op for voices under the new ceiling and fades out the
+  // ones above it, so pushing all four every time a limit moves is cheap.
+  if (sampler_ && limit(kSamplerId) > 0) {
+    sampler_->setMaxVoices(limit(kSamplerId));
+  }
+  if (granular_ && limit(kGranularId) > 0) {
+    granular_->setMaxActiveVoices(limit(kGranularId));
+  }
+  if (resonator_ && limit(kResonatorId) > 0) {
+    resonator_->setMaxVoices(limit(kResonatorId));
+  }
+  if (burst_ && limit(kBurstId) > 0) {
+    burst_->setMaxVoices(limit(kBurstId));
+  }
 }
 
 void EngineRouter::setSeedCount(std::size_t count) {
@@ -245,6 +334,17 @@ void EngineRouter::onSeed(const Seed& seed) {
       break;
   }
 }
+
+void EngineRouter::glideSeedParams(const Seed& seed) {
+  // Only the sampler renders voices that outlive the edit in the sim today;
+  // the other engines pick the new values up at their next trigger.
+  if (!sampler_ || sanitizeEngineId(seed.engine) != kSamplerId) {
+    return;
+  }
+  sampler_->queueParamTarget(seed.id, Sampler::Param::kTone, seed.tone);
+  sampler_->queueParamTarget(seed.id, Sampler::Param::kSpread, seed.spread);
+}
+
 std::size_t EngineRouter::engineCount() const { return registry_.size(); }
 
 std::uint8_t EngineRouter::sanitizeEngineId(std::uint8_t engineId) const {
@@ -22,7 +22,9 @@
 #include "engine/Resonator.h"
 #include "engine/Sampler.h"
 #include "engine/ToyGenerator.h"
+#include "engine/VoiceGovernor.h"
 #include "util/Annotations.h"
+#include "util/CaptureRing.h"
 
 class EngineRouter {
 public:
@@ -35,6 +37,9 @@ public:
   static constexpr std::uint8_t kBurstId = 4;
   static constexpr std::uint8_t kToyId = 5;
 
+  // Seconds of live input the capture ring keeps for granular and resonator.
+  static constexpr float kDefaultLiveCaptureSeconds = 4.0f;
+
   void init(Mode mode);
 
   void setSeedCount(std::size_t count);
@@ -44,8 +49,36 @@ public:
   void reseed(std::uint32_t masterSeed);
   void panic();
   void onSeed(const Seed& seed);
+  // Hand a seed's continuous params (tone, spread) to the voices it already
+  // has sounding as per-sample glide targets.  Any control surface that edits
+  // a live seed calls this after updating the seed table.
+  void glideSeedParams(const Seed& seed);
   void triggerSeed(const Seed& seed, std::uint32_t whenSamples);
   void processInputAudio(const Seed& seed, const Engine::RenderContext& ctx);
+  // Append this block's live input to the capture ring.  Call it before the
+  // engines render so grains can reach all the way up to "now".
+  void captureLiveInput(const Engine::RenderContext& ctx);
+  // Resize the capture ring (reallocates; not for the audio thread).  Desktop
+  // builds only: on the Teensy the granular effect keeps its own memory and
+  // the ring stays empty.
+  SEEDBOX_MAYBE_UNUSED void setLiveCaptureSeconds(float seconds);
+  util::CaptureRing& liveCapture() { return liveCapture_; }
+  const util::CaptureRing& liveCapture() const { return liveCapture_; }
+
+  // Block-time voice governor (see VoiceGovernor.h).  Off after init() so sim
+  // and offline renders stay deterministic; AppState switches it on for the
+  // Teensy and plugin hosts once the boot ceilings are set.  Enabling takes
+  // the engines' current ceilings as the starting point; disabling puts them
+  // back.
+  void setVoiceGovernorEnabled(bool enabled);
+  bool voiceGovernorEnabled() const { return governorEnabled_; }
+  VoiceGovernor& voiceGovernor() { return governor_; }
+  const VoiceGovernor& voiceGovernor() const { return governor_; }
+  // Audio thread, once per block: hand the governor this block's timings
+  // (engineNanos indexed by engine id) and push any moved ceilings into the
+  // engines.  A no-op while the governor is off.
+  void governVoices(std::uint32_t renderNanos, std::uint32_t budgetNanos,
+                    const VoiceGovernor::LaneNanos& engineNanos);
 
   SEEDBOX_MAYBE_UNUSED static void dispatchThunk(void* ctx, const Seed& seed, std::uint32_t whenSamples);
 
@@ -77,6 +110,7 @@ private:
   const Engine* findEngine(std::uint8_t engineId) const;
   void registerEngine(std::uint8_t id, std::string_view name, std::string_view shortName,
                       std::unique_ptr<Engine> engine);
+  void applyVoiceLimits(bool nominal);
 
   Mode mode_{Mode::kSim};
   std::map<std::uint8_t, RegisteredEngine> registry_{};
@@ -89,4 +123,8 @@ private:
   std::vector<bool> seedLocks_{};
   bool globalLock_{false};
   std::uint32_t lastMasterSeed_{0};
+  util::CaptureRing liveCapture_{};
+  float liveCaptureSeconds_{kDefaultLiveCaptureSeconds};
+  VoiceGovernor governor_{};
+  bool governorEnabled_{false};
 };
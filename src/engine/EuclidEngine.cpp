@@ -4,7 +4,6 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <vector>
 
 #include "Seed.h"
 
@@ -13,7 +12,7 @@ Engine::Type EuclidEngine::type() const noexcept { return Engine::Type::kEuclid;
 namespace {
 constexpr std::uint8_t clampSteps(std::int32_t value) {
   if (value < 1) return 1;
-  if (value > 32) return 32;
+  if (value > EuclidEngine::kMaxSteps) return EuclidEngine::kMaxSteps;
   return static_cast<std::uint8_t>(value);
 }
 
@@ -47,66 +46,92 @@ std::uint32_t readU32(const Engine::StateBuffer& in, std::size_t index) {
          (static_cast<std::uint32_t>(in[index + 3]) << 24u);
 }
 
-std::vector<std::uint8_t> buildHostMask(std::uint8_t steps, std::uint8_t fills, std::uint8_t rotate) {
-  std::vector<std::uint8_t> mask(steps, 0u);
-  if (fills == 0 || steps == 0) {
-    return mask;
-  }
+constexpr std::uint64_t widthMask(std::uint8_t steps) {
+  return steps >= 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << steps) - 1u);
+}
+}  // namespace
+
+std::uint64_t EuclidEngine::BuildMask(std::uint8_t steps, std::uint8_t fills, std::uint8_t rotate) {
+  steps = clampSteps(steps);
+  fills = clampFills(steps, fills);
+  rotate = wrapRotate(steps, rotate);
+  // Bresenham-style spread: step i fires when the running fill total crosses a
+  // multiple of `steps`. That is Bjorklund's even distribution (up to
+  // rotation), computed with one add and compare per step.
+  std::uint64_t bits = 0;
+  std::uint32_t accumulator = 0;
   for (std::uint8_t i = 0; i < steps; ++i) {
-    const std::uint32_t start = static_cast<std::uint32_t>(i) * fills;
-    const std::uint32_t end = static_cast<std::uint32_t>(i + 1) * fills;
-    const bool gate = (end / steps) > (start / steps);
-    const std::uint8_t rotated = static_cast<std::uint8_t>((i + steps - (rotate % steps)) % steps);
-    mask[rotated] = gate ? 1u : 0u;
+    accumulator += fills;
+    if (accumulator >= steps) {
+      accumulator -= steps;
+      bits |= std::uint64_t{1} << i;
+    }
+  }
+  if (rotate == 0) {
+    return bits;
   }
-  return mask;
+  return ((bits >> rotate) | (bits << (steps - rotate))) & widthMask(steps);
 }
-}  // namespace
 
 void EuclidEngine::prepare(const Engine::PrepareContext& ctx) {
   generationSeed_ = ctx.masterSeed;
-  cursor_ = 0;
   lastSeedId_ = 0;
-  hostSampleRate_ = (ctx.sampleRate > 0) ? static_cast<float>(ctx.sampleRate) : 48000.0f;
+  rates_.prepare(static_cast<float>(ctx.sampleRate));
   hostCursor_ = 0;
   hostGateLevel_ = 0.0f;
-  // The mask lives entirely in RAM and is rebuilt from the param trio so
-  // students can reseed or tweak rotation without paying for heap churn or
+  // The masks live entirely in RAM and are rebuilt from each lane's param trio
+  // so students can reseed or tweak rotation without paying for heap churn or
   // risking a race with the audio thread.
-  rebuildMask();
+  for (auto& lane : lanes_) {
+    lane.cursor = 0;
+    rebuildLane(lane);
+  }
+  laneGates_ = 0;
 }
 
 void EuclidEngine::onTick(const Engine::TickContext& ctx) {
   (void)ctx;
-  if (mask_.empty()) {
-    lastGate_ = false;
-    return;
+  // Every lane advances together; each gate is one shift and one mask, so a
+  // tick over dozens of polyrhythmic lanes is a tight loop with no lookups.
+  std::uint64_t gates = 0;
+  for (std::size_t n = 0; n < laneCount_; ++n) {
+    Lane& lane = lanes_[n];
+    gates |= ((lane.mask >> lane.cursor) & 1u) << n;
+    if (++lane.cursor >= lane.steps) {
+      lane.cursor = 0;
+    }
   }
-  const std::size_t index = cursor_ % mask_.size();
-  lastGate_ = (mask_[index] != 0);
-  ++cursor_;
+  laneGates_ = gates;
+  lastGate_ = (gates & 1u) != 0;
 }
 
 void EuclidEngine::onParam(const Engine::ParamChange& change) {
+  const std::size_t index = LaneForSeed(change.seedId);
+  Lane& lane = lanes_[index];
   const auto param = static_cast<Param>(change.id);
   switch (param) {
     case Param::kSteps:
-      steps_ = clampSteps(change.value);
-      fills_ = std::min<std::uint8_t>(fills_, steps_);
-      rotate_ = wrapRotate(steps_, rotate_);
-      rebuildMask();
+      lane.steps = clampSteps(change.value);
+      lane.fills = std::min<std::uint8_t>(lane.fills, lane.steps);
+      lane.rotate = wrapRotate(lane.steps, lane.rotate);
       break;
     case Param::kFills:
-      fills_ = clampFills(steps_, change.value);
-      rebuildMask();
+      lane.fills = clampFills(lane.steps, change.value);
       break;
     case Param::kRotate:
-      rotate_ = wrapRotate(steps_, change.value);
-      rebuildMask();
+      lane.rotate = wrapRotate(lane.steps, change.value);
       break;
     default:
-      break;
+      return;
   }
+  rebuildLane(lane);
+  // A fresh lane joins the tick loop from its first step.
+  laneCount_ = std::max(laneCount_, index + 1);
+}
+
+EuclidEngine::Pattern EuclidEngine::mask(std::size_t lane) const {
+  const Lane& src = laneAt(lane);
+  return Pattern(src.mask, src.steps);
 }
 
 void EuclidEngine::onSeed(const Engine::SeedContext& ctx) {
@@ -125,10 +150,9 @@ void EuclidEngine::processInputAudio(const Seed& seed, const Engine::RenderConte
   const std::uint8_t fills = std::clamp<std::uint8_t>(
       static_cast<std::uint8_t>(std::lround(std::clamp(seed.probability, 0.0f, 1.0f) * steps)), 1u, steps);
   const std::uint8_t rotate = wrapRotate(steps, static_cast<int>(std::lround(seed.spread * steps)));
-  const std::vector<std::uint8_t> hostMask = buildHostMask(steps, fills, rotate);
+  const std::uint64_t hostMask = BuildMask(steps, fills, rotate);
   const std::size_t stepSamples = std::clamp<std::size_t>(
-      static_cast<std::size_t>(hostSampleRate_ * (0.04f + ((1.0f - densityNorm) * 0.08f))), 128u,
-      static_cast<std::size_t>(hostSampleRate_ * 0.25f));
+      rates_.samples(0.04f + ((1.0f - densityNorm) * 0.08f)), 128u, rates_.samples(0.25f));
   const float gateFloor = 0.12f + (0.18f * std::clamp(seed.tone, 0.0f, 1.0f));
   const float wet = 0.6f + (0.25f * densityNorm);
   const float cross = 0.08f + (0.22f * std::clamp(seed.spread, 0.0f, 1.0f));
@@ -136,8 +160,8 @@ void EuclidEngine::processInputAudio(const Seed& seed, const Engine::RenderConte
   for (std::size_t i = 0; i < ctx.frames; ++i) {
     const float inL = ctx.inputLeft[i];
     const float inR = ctx.inputRight ? ctx.inputRight[i] : inL;
-    const std::size_t stepIndex = static_cast<std::size_t>((hostCursor_ / stepSamples) % hostMask.size());
-    const float gateTarget = hostMask[stepIndex] ? 1.0f : gateFloor;
+    const std::size_t stepIndex = static_cast<std::size_t>((hostCursor_ / stepSamples) % steps);
+    const float gateTarget = ((hostMask >> stepIndex) & 1u) ? 1.0f : gateFloor;
     const float glide = (gateTarget > hostGateLevel_) ? 0.16f : 0.045f;
     hostGateLevel_ += (gateTarget - hostGateLevel_) * glide;
 
@@ -154,14 +178,28 @@ void EuclidEngine::renderAudio(const Engine::RenderContext& ctx) {
 }
 
 Engine::StateBuffer EuclidEngine::serializeState() const {
+  // Lane 0 keeps the original 15-byte layout so older snapshots still load;
+  // extra lanes follow as a count plus four bytes each (steps, fills, rotate,
+  // cursor). The masks themselves are derived, so they never hit the wire.
+  const Lane& primary = lanes_[0];
   Engine::StateBuffer buffer;
-  buffer.reserve(3 + 8);
-  buffer.push_back(steps_);
-  buffer.push_back(fills_);
-  buffer.push_back(rotate_);
-  appendU32(buffer, cursor_);
+  buffer.reserve(3 + 12 + 1 + 4 * (laneCount_ - 1));
+  buffer.push_back(primary.steps);
+  buffer.push_back(primary.fills);
+  buffer.push_back(primary.rotate);
+  appendU32(buffer, primary.cursor);
   appendU32(buffer, generationSeed_);
   appendU32(buffer, lastSeedId_);
+  if (laneCount_ > 1) {
+    buffer.push_back(static_cast<std::uint8_t>(laneCount_));
+    for (std::size_t n = 1; n < laneCount_; ++n) {
+      const Lane& lane = lanes_[n];
+      buffer.push_back(lane.steps);
+      buffer.push_back(lane.fills);
+      buffer.push_back(lane.rotate);
+      buffer.push_back(lane.cursor);
+    }
+  }
   return buffer;
 }
 
@@ -169,38 +207,45 @@ void EuclidEngine::deserializeState(const Engine::StateBuffer& state) {
   if (state.size() < 3) {
     return;
   }
-  steps_ = state[0];
-  if (steps_ == 0) steps_ = 1;
-  fills_ = std::min<std::uint8_t>(state[1], steps_);
-  rotate_ = wrapRotate(steps_, state[2]);
-  cursor_ = readU32(state, 3);
+  const auto restoreLane = [](Lane& lane, std::uint8_t steps, std::uint8_t fills, std::uint8_t rotate,
+                              std::uint32_t cursor) {
+    lane.steps = clampSteps(steps);
+    lane.fills = std::min<std::uint8_t>(fills, lane.steps);
+    lane.rotate = wrapRotate(lane.steps, rotate);
+    lane.cursor = static_cast<std::uint8_t>(cursor % lane.steps);
+    rebuildLane(lane);
+  };
+  restoreLane(lanes_[0], state[0], state[1], state[2], readU32(state, 3));
   generationSeed_ = readU32(state, 7);
   lastSeedId_ = readU32(state, 11);
-  rebuildMask();
-}
 
-void EuclidEngine::rebuildMask() {
-  const std::uint8_t steps = std::max<std::uint8_t>(1, steps_);
-  const std::uint8_t fills = std::min<std::uint8_t>(steps, fills_);
-  mask_.assign(steps, 0u);
-  if (fills == 0) {
-    return;
+  laneCount_ = 1;
+  constexpr std::size_t kLaneBlock = 15;
+  if (state.size() > kLaneBlock) {
+    const std::size_t count = std::min<std::size_t>(state[kLaneBlock], kMaxLanes);
+    for (std::size_t n = 1; n < count; ++n) {
+      const std::size_t at = kLaneBlock + 1 + (n - 1) * 4;
+      if (at + 4 > state.size()) {
+        break;
+      }
+      restoreLane(lanes_[n], state[at], state[at + 1], state[at + 2], state[at + 3]);
+      laneCount_ = n + 1;
+    }
   }
+}
 
-  for (std::uint8_t i = 0; i < steps; ++i) {
-    const std::uint32_t start = static_cast<std::uint32_t>(i) * fills;
-    const std::uint32_t end = static_cast<std::uint32_t>(i + 1) * fills;
-    const bool gate = (end / steps) > (start / steps);
-    const std::uint8_t rotated = static_cast<std::uint8_t>((i + steps - (rotate_ % steps)) % steps);
-    mask_[rotated] = gate ? 1u : 0u;
-  }
-  if (cursor_ >= mask_.size()) {
-    cursor_ %= mask_.size();
+void EuclidEngine::rebuildLane(Lane& lane) {
+  lane.mask = BuildMask(lane.steps, lane.fills, lane.rotate);
+  if (lane.cursor >= lane.steps) {
+    lane.cursor = static_cast<std::uint8_t>(lane.cursor % lane.steps);
   }
 }
 
 void EuclidEngine::panic() {
-  cursor_ = 0;
+  for (std::size_t n = 0; n < laneCount_; ++n) {
+    lanes_[n].cursor = 0;
+  }
+  laneGates_ = 0;
   lastGate_ = false;
   hostCursor_ = 0;
   hostGateLevel_ = 0.0f;
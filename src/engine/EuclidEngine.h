@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
 
 #include "engine/Engine.h"
+#include "engine/RateCache.h"
 
 //
 // EuclidEngine
@@ -13,6 +15,14 @@
 // about "steps vs. fills vs. rotation" can be taught straight from the code.
 // Every reseed pins the engine to a known `masterSeed`, and the serialized state
 // captures enough bread crumbs for lock flows to round-trip cleanly.
+//
+// A pattern is a single `uint64_t`: bit i set means step i fires, so patterns
+// run up to 64 steps, rotation is two shifts, and the per-tick gate lookup is a
+// shift and a mask. The engine runs several of these side by side as lanes —
+// each seed edits its own lane (`ParamChange::seedId` picks it), and every tick
+// advances all of them at once, which is how polyrhythms fall out for free.
+// Lane 0 is the classic single pattern that `mask()`, `steps()`, and
+// `lastGate()` have always reported.
 class EuclidEngine : public Engine {
 public:
   enum class Param : std::uint16_t {
@@ -21,6 +31,33 @@ public:
     kRotate = 2,
   };
 
+  static constexpr std::uint8_t kMaxSteps = 64;
+  static constexpr std::size_t kMaxLanes = 64;
+
+  // Read-only view of one lane's bitmask. Indexes like the old byte-per-step
+  // vector (`size()`, `operator[]`) so lesson code and golden dumps still print
+  // "X.X..", while `bits()` hands over the raw mask.
+  class Pattern {
+  public:
+    Pattern() = default;
+    Pattern(std::uint64_t bits, std::uint8_t steps) : bits_(bits), steps_(steps) {}
+
+    std::uint64_t bits() const { return bits_; }
+    std::size_t size() const { return steps_; }
+    bool empty() const { return steps_ == 0; }
+    std::uint8_t operator[](std::size_t step) const { return static_cast<std::uint8_t>((bits_ >> step) & 1u); }
+
+  private:
+    std::uint64_t bits_{0};
+    std::uint8_t steps_{0};
+  };
+
+  // Euclidean pulses for `steps`/`fills`, rotated so step `rotate` lands on 0.
+  // Arguments are clamped the same way the params are.
+  static std::uint64_t BuildMask(std::uint8_t steps, std::uint8_t fills, std::uint8_t rotate);
+  // Seeds beyond the lane budget fold back onto the low lanes.
+  static std::size_t LaneForSeed(std::uint32_t seedId) { return seedId % kMaxLanes; }
+
   Engine::Type type() const noexcept override;
   void prepare(const Engine::PrepareContext& ctx) override;
   void onTick(const Engine::TickContext& ctx) override;
@@ -34,24 +71,42 @@ public:
 
   bool lastGate() const { return lastGate_; }
   std::uint32_t generationSeed() const { return generationSeed_; }
-  const std::vector<std::uint8_t>& mask() const { return mask_; }
-  std::uint8_t steps() const { return steps_; }
-  std::uint8_t fills() const { return fills_; }
-  std::uint8_t rotate() const { return rotate_; }
+  Pattern mask() const { return mask(0); }
+  std::uint8_t steps() const { return lanes_[0].steps; }
+  std::uint8_t fills() const { return lanes_[0].fills; }
+  std::uint8_t rotate() const { return lanes_[0].rotate; }
+
+  // Per-lane views. Out-of-range lanes read as lane 0.
+  Pattern mask(std::size_t lane) const;
+  std::uint8_t steps(std::size_t lane) const { return laneAt(lane).steps; }
+  std::uint8_t fills(std::size_t lane) const { return laneAt(lane).fills; }
+  std::uint8_t rotate(std::size_t lane) const { return laneAt(lane).rotate; }
+  // Lanes that tick: lane 0 plus every lane a seed has edited.
+  std::size_t laneCount() const { return laneCount_; }
+  // Bit n is set when lane n fired on the most recent tick.
+  std::uint64_t laneGates() const { return laneGates_; }
+  bool laneGate(std::size_t lane) const { return lane < kMaxLanes && ((laneGates_ >> lane) & 1u) != 0; }
 
 private:
-  void rebuildMask();
+  struct Lane {
+    std::uint64_t mask{0};
+    std::uint8_t steps{16};
+    std::uint8_t fills{4};
+    std::uint8_t rotate{0};
+    std::uint8_t cursor{0};
+  };
+
+  const Lane& laneAt(std::size_t lane) const { return lanes_[lane < kMaxLanes ? lane : 0]; }
+  static void rebuildLane(Lane& lane);
 
 private:
-  std::uint8_t steps_{16};
-  std::uint8_t fills_{4};
-  std::uint8_t rotate_{0};
-  std::vector<std::uint8_t> mask_{};
+  std::array<Lane, kMaxLanes> lanes_{};
+  std::size_t laneCount_{1};
+  std::uint64_t laneGates_{0};
   std::uint32_t generationSeed_{0};
-  std::uint32_t cursor_{0};
   bool lastGate_{false};
   std::uint32_t lastSeedId_{0};
-  float hostSampleRate_{48000.0f};
+  RateCache rates_{};
   std::uint64_t hostCursor_{0};
   float hostGateLevel_{0.0f};
 };
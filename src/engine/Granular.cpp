@@ -61,6 +61,41 @@ std::size_t wrapDelayTap(std::size_t writePos, std::size_t bufferSize, std::size
   const std::size_t clampedDelay = std::min(delaySamples, bufferSize - 1);
   return (writePos + bufferSize - clampedDelay) % bufferSize;
 }
+
+// Live grains are quieter than the dry input so a 40-grain cloud doesn't
+// bury it.
+constexpr float kLiveGrainGain = 0.35f;
+constexpr float kLiveGrainMinMs = 2.0f;
+
+// Quarter-wave sin^2 lookup: the rising half of a Hann window.  Grains use it
+// rising up to the skewed peak and mirrored falling after it, which is cheap
+// enough to run for every sample of every grain.
+constexpr std::size_t kWindowTableSize = 256;
+const std::array<float, kWindowTableSize + 1>& hannRiseTable() {
+  static const auto table = [] {
+    std::array<float, kWindowTableSize + 1> t{};
+    for (std::size_t i = 0; i <= kWindowTableSize; ++i) {
+      const float s = std::sin(1.5707963f * static_cast<float>(i) / static_cast<float>(kWindowTableSize));
+      t[i] = s * s;
+    }
+    return t;
+  }();
+  return table;
+}
+
+// `x` in [0, 1) through the grain; `peak` is where the window tops out
+// (0.5 = symmetric Hann, windowSkew slides it toward either edge).
+float grainWindow(float x, float peak) {
+  const auto& table = hannRiseTable();
+  const float rise = x < peak ? (x / peak) : ((1.0f - x) / (1.0f - peak));
+  const float scaled = std::clamp(rise, 0.0f, 1.0f) * static_cast<float>(kWindowTableSize);
+  const auto idx = static_cast<std::size_t>(scaled);
+  if (idx >= kWindowTableSize) {
+    return table[kWindowTableSize];
+  }
+  const float frac = scaled - static_cast<float>(idx);
+  return table[idx] + (table[idx + 1] - table[idx]) * frac;
+}
 #endif
 }
 
@@ -117,6 +152,7 @@ void GranularEngine::Stats::reset() {
   mixerGroupsEngaged = 0;
   busiestMixerGroup = 0;
   busiestMixerLoad = 0;
+  steals = VoiceAllocator::Counters{};
   voiceSamples_.fill(VoiceSample{});
 }
 
@@ -126,25 +162,7 @@ void GranularEngine::Stats::onVoicePlanned(uint8_t voiceIndex, const GrainVoice&
   }
 
   auto& slot = voiceSamples_[voiceIndex];
-  if (slot.active) {
-    if (activeVoiceCount > 0) {
-      --activeVoiceCount;
-    }
-    if (slot.sizeBin < grainSizeHistogram.size() && grainSizeHistogram[slot.sizeBin] > 0) {
-      --grainSizeHistogram[slot.sizeBin];
-    }
-    if (slot.sprayBin < sprayHistogram.size() && sprayHistogram[slot.sprayBin] > 0) {
-      --sprayHistogram[slot.sprayBin];
-    }
-    if (slot.sdOnly && sdOnlyVoiceCount > 0) {
-      --sdOnlyVoiceCount;
-    }
-    if (slot.mixerGroup < mixerGroupLoad.size() && mixerGroupLoad[slot.mixerGroup] > 0) {
-      --mixerGroupLoad[slot.mixerGroup];
-    }
-  }
-
-  slot = VoiceSample{};
+  forgetSlot(slot);
   ++grainsPlanned;
 
   if (!voice.active) {
@@ -170,6 +188,35 @@ void GranularEngine::Stats::onVoicePlanned(uint8_t voiceIndex, const GrainVoice&
   refreshMixerAggregates();
 }
 
+void GranularEngine::Stats::onVoiceRetired(uint8_t voiceIndex) {
+  if (voiceIndex >= voiceSamples_.size()) {
+    return;
+  }
+  forgetSlot(voiceSamples_[voiceIndex]);
+  refreshMixerAggregates();
+}
+
+void GranularEngine::Stats::forgetSlot(VoiceSample& slot) {
+  if (slot.active) {
+    if (activeVoiceCount > 0) {
+      --activeVoiceCount;
+    }
+    if (slot.sizeBin < grainSizeHistogram.size() && grainSizeHistogram[slot.sizeBin] > 0) {
+      --grainSizeHistogram[slot.sizeBin];
+    }
+    if (slot.sprayBin < sprayHistogram.size() && sprayHistogram[slot.sprayBin] > 0) {
+      --sprayHistogram[slot.sprayBin];
+    }
+    if (slot.sdOnly && sdOnlyVoiceCount > 0) {
+      --sdOnlyVoiceCount;
+    }
+    if (slot.mixerGroup < mixerGroupLoad.size() && mixerGroupLoad[slot.mixerGroup] > 0) {
+      --mixerGroupLoad[slot.mixerGroup];
+    }
+  }
+  slot = VoiceSample{};
+}
+
 void GranularEngine::Stats::refreshMixerAggregates() {
   mixerGroupsEngaged = 0;
   busiestMixerGroup = 0;
@@ -190,17 +237,19 @@ Engine::Type GranularEngine::type() const noexcept { return Engine::Type::kGranu
 
 void GranularEngine::init(Mode mode) {
   mode_ = mode;
-  hostSampleRate_ = 48000.0f;
+  rates_.prepare(Units::kSampleRate);
   maxActiveVoices_ = (mode == Mode::kHardware) ? 32 : 12;
   liveInputArmed_ = true;
   voices_.fill(GrainVoice{});
   sdClips_.fill(SourceSlot{});
   stats_.reset();
+  allocator_.resetCounters();
   effectDelayLeft_.clear();
   effectDelayRight_.clear();
   effectWritePos_ = 0;
   effectLowpassLeft_ = 0.0f;
   effectLowpassRight_ = 0.0f;
+  renderSample_ = 0;
   // Slot zero is a reserved label for "live input" so deterministic seeds can
   // reference it even though it never appears in the SD clip registry.
   sdClips_[0].inUse = true;
@@ -210,6 +259,8 @@ void GranularEngine::init(Mode mode) {
 
 #if !SEEDBOX_HW
   simHwVoices_.fill(SimHardwareVoice{});
+  liveGrains_.fill(LiveGrain{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
 #endif
 
 #if SEEDBOX_HW
@@ -259,7 +310,9 @@ void GranularEngine::init(Mode mode) {
 
 void GranularEngine::prepare(const Engine::PrepareContext& ctx) {
   init(ctx.hardware ? Mode::kHardware : Mode::kSim);
-  hostSampleRate_ = (ctx.sampleRate > 0) ? static_cast<float>(ctx.sampleRate) : 48000.0f;
+  // Grain lengths, spray offsets and the smear tap all come out of the
+  // cache, so a 40 ms grain is 40 ms whatever the host runs at.
+  rates_.prepare(static_cast<float>(ctx.sampleRate));
   ensureEffectBuffers(ctx.framesPerBlock);
   (void)ctx.masterSeed;
   (void)ctx.framesPerBlock;
@@ -296,13 +349,13 @@ void GranularEngine::processInputAudio(const Seed& seed, const Engine::RenderCon
   const float density = std::max(0.5f, seed.density);
   const float wet = 0.82f + (0.15f * clampUnit(seed.probability));
   const float feedback = 0.28f + (0.45f * clampUnit(seed.mutateAmt));
-  const float lpCoeff = 0.04f + (tone * 0.32f);
+  const float lpCoeff = rates_.onePole(0.04f + (tone * 0.32f));
   const float transposeMix = clampUnit((seed.granular.transpose + 12.0f) / 24.0f);
   const std::size_t delaySize = effectDelayLeft_.size();
   const std::size_t grainDelay = std::clamp<std::size_t>(
-      static_cast<std::size_t>(Units::msToSamples(std::max(12.0f, seed.granular.grainSizeMs))), 24u, delaySize / 3u);
+      static_cast<std::size_t>(rates_.msToSamples(std::max(12.0f, seed.granular.grainSizeMs))), 24u, delaySize / 3u);
   const std::size_t sprayDelay = std::clamp<std::size_t>(
-      static_cast<std::size_t>(Units::msToSamples(std::max(4.0f, seed.granular.sprayMs + (density * 6.0f)))), 16u,
+      static_cast<std::size_t>(rates_.msToSamples(std::max(4.0f, seed.granular.sprayMs + (density * 6.0f)))), 16u,
       delaySize / 2u);
   const float windowBlend = clampUnit((seed.granular.windowSkew + 1.0f) * 0.5f);
   const float width = 0.12f + (0.6f * spread);
@@ -352,8 +405,145 @@ void GranularEngine::processInputAudio(const Seed& seed, const Engine::RenderCon
 }
 
 void GranularEngine::renderAudio(const Engine::RenderContext& ctx) {
+#if SEEDBOX_HW
+  // AudioEffectGranular renders the live grains inside the Teensy graph.
   (void)ctx;
+#else
+  if (!ctx.left || !ctx.right || ctx.frames == 0) {
+    return;
+  }
+  // Live grains only sound once the capture ring has audio to chew on.  The
+  // ring was already handed this block's input, so "now" is its write head.
+  // The ring's head is 32 bits and wraps; grains keep absolute positions, so
+  // follow it by the distance it moved instead of reading it raw.
+  if (liveCapture_ != nullptr) {
+    const uint32_t head = liveCapture_->writeHead();
+    liveHead_ += static_cast<double>(static_cast<uint32_t>(head - liveHeadSeen_));
+    liveHeadSeen_ = head;
+  }
+  if (liveCapture_ != nullptr && liveCapture_->available() > 0) {
+    for (uint8_t i = 0; i < maxActiveVoices_; ++i) {
+      const GrainVoice& voice = voices_[i];
+      if (voice.active && voice.source == Source::kLiveInput) {
+        renderLiveVoice(i, ctx);
+      }
+    }
+    for (uint8_t i = 0; i < kVoicePoolSize; ++i) {
+      if (tailFades_[i].active()) {
+        renderLiveTail(i, ctx);
+      }
+    }
+  }
+  renderSample_ += ctx.frames;
+#endif
+}
+
+#if !SEEDBOX_HW
+void GranularEngine::startLiveGrain(uint8_t index, double now) {
+  const GrainVoice& voice = voices_[index];
+  LiveGrain& grain = liveGrains_[index];
+  const float sr = rates_.sampleRate();
+  const float rate = std::max(0.0625f, voice.playbackRate);
+  grain.length = std::max<uint32_t>(1u, static_cast<uint32_t>(std::max(kLiveGrainMinMs, voice.sizeMs) * 0.001f * sr));
+  grain.pos = 0;
+
+  // `now` trails the ring head by the frames left in this block.  A grain
+  // must start far enough back that reading `length` frames at `rate` never
+  // overtakes the present.
+  const double head = liveHead_;
+  const double lag = head - now;
+  const double have = static_cast<double>(liveCapture_->available()) - lag;
+  const double reach = static_cast<double>(grain.length) * rate + 1.0;
+  double window = have;
+  if (liveScatterSeconds_ > 0.0f) {
+    window = std::min(window, static_cast<double>(liveScatterSeconds_) * sr);
+  }
+  if (window <= reach) {
+    // Not enough history yet: play the freshest audio that fits.
+    grain.readPos = now - std::min(reach, std::max(1.0, have));
+    return;
+  }
+
+  // Half the grains land on a recent attack when the gate has flagged one in
+  // the window; the rest scatter uniformly across it.  Spray jitters either.
+  double ago = reach + static_cast<double>(RNG::uniform01(grain.rng)) * (window - reach);
+  const std::size_t onsets = liveCapture_->onsetCount();
+  if (onsets > 0 && RNG::uniform01(grain.rng) < 0.5f) {
+    const auto pick = static_cast<std::size_t>(RNG::uniform01(grain.rng) * static_cast<float>(onsets));
+    const double onsetAgo = static_cast<double>(liveCapture_->onsetFramesAgo(std::min(pick, onsets - 1))) - lag;
+    if (onsetAgo >= reach && onsetAgo <= window) {
+      ago = onsetAgo;
+    }
+  }
+  if (voice.sprayMs > 0.0f) {
+    ago += static_cast<double>(RNG::uniformSigned(grain.rng) * voice.sprayMs * 0.001f * sr);
+  }
+  grain.readPos = now - std::clamp(ago, reach, window);
+}
+
+void GranularEngine::renderLiveVoice(uint8_t index, const Engine::RenderContext& ctx) {
+  const GrainVoice& voice = voices_[index];
+  LiveGrain& grain = liveGrains_[index];
+  const double head = liveHead_;
+  const double blockStart = head - static_cast<double>(ctx.frames);
+  const float rate = std::max(0.0625f, voice.playbackRate);
+  const float peak = 0.5f + 0.45f * std::clamp(voice.windowSkew, -1.0f, 1.0f);
+  const float leftGain = voice.leftGain * kLiveGrainGain;
+  const float rightGain = voice.rightGain * kLiveGrainGain;
+
+  std::size_t first = 0;
+  if (renderSample_ + ctx.frames <= voice.startSample) {
+    return;
+  }
+  if (renderSample_ < voice.startSample) {
+    first = static_cast<std::size_t>(voice.startSample - renderSample_);
+  }
+  float peakLevel = 0.0f;
+  for (std::size_t i = first; i < ctx.frames; ++i) {
+    if (grain.pos >= grain.length) {
+      startLiveGrain(index, blockStart + static_cast<double>(i));
+    }
+    const float x = static_cast<float>(grain.pos) / static_cast<float>(grain.length);
+    const float w = grainWindow(x, peak);
+    float l = 0.0f;
+    float r = 0.0f;
+    liveCapture_->read(static_cast<float>(head - grain.readPos), l, r);
+    ctx.left[i] += l * w * leftGain;
+    ctx.right[i] += r * w * rightGain;
+    peakLevel = std::max(peakLevel, std::max(std::fabs(l), std::fabs(r)) * w);
+    grain.readPos += rate;
+    ++grain.pos;
+  }
+  grain.level = peakLevel;
+}
+
+void GranularEngine::renderLiveTail(uint8_t index, const Engine::RenderContext& ctx) {
+  const GrainVoice& voice = tailVoices_[index];
+  LiveGrain& grain = tailGrains_[index];
+  VoiceAllocator::StealFade& fade = tailFades_[index];
+  const double head = liveHead_;
+  const float rate = std::max(0.0625f, voice.playbackRate);
+  const float peak = 0.5f + 0.45f * std::clamp(voice.windowSkew, -1.0f, 1.0f);
+  const float leftGain = voice.leftGain * kLiveGrainGain;
+  const float rightGain = voice.rightGain * kLiveGrainGain;
+  // No new grains here: the tail finishes (or fades out of) the one it had.
+  for (std::size_t i = 0; i < ctx.frames && fade.active(); ++i) {
+    if (grain.pos >= grain.length) {
+      fade.stop();
+      break;
+    }
+    const float x = static_cast<float>(grain.pos) / static_cast<float>(grain.length);
+    const float w = grainWindow(x, peak) * fade.next();
+    float l = 0.0f;
+    float r = 0.0f;
+    liveCapture_->read(static_cast<float>(head - grain.readPos), l, r);
+    ctx.left[i] += l * w * leftGain;
+    ctx.right[i] += r * w * rightGain;
+    grain.readPos += rate;
+    ++grain.pos;
+  }
 }
+#endif
 
 Engine::StateBuffer GranularEngine::serializeState() const {
   return {};
@@ -366,11 +556,13 @@ void GranularEngine::deserializeState(const Engine::StateBuffer& state) {
 void GranularEngine::panic() {
   voices_.fill(GrainVoice{});
   stats_.reset();
+  allocator_.resetCounters();
   std::fill(effectDelayLeft_.begin(), effectDelayLeft_.end(), 0.0f);
   std::fill(effectDelayRight_.begin(), effectDelayRight_.end(), 0.0f);
   effectWritePos_ = 0;
   effectLowpassLeft_ = 0.0f;
   effectLowpassRight_ = 0.0f;
+  renderSample_ = 0;
 #if SEEDBOX_HW
   for (auto& hwVoice : hwVoices_) {
     hwVoice.sdPlayer.stop();
@@ -398,15 +590,52 @@ void GranularEngine::panic() {
   }
 #else
   simHwVoices_.fill(SimHardwareVoice{});
+  liveGrains_.fill(LiveGrain{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
 #endif
 }
 
 void GranularEngine::setMaxActiveVoices(uint8_t voices) {
   maxActiveVoices_ = clampVoices(voices);
+  for (uint8_t i = maxActiveVoices_; i < kVoicePoolSize; ++i) {
+    retireVoice(i);
+  }
+}
+
+void GranularEngine::retireVoice(uint8_t index) {
+  GrainVoice& voice = voices_[index];
+  if (!voice.active) {
+    return;
+  }
+#if SEEDBOX_HW
+  // The Teensy mixer switches gain at the next block edge.  That is one
+  // 128-sample step, but the voice is silent afterwards and its slot is free.
+  auto& hwVoice = hwVoices_[index];
+  hwVoice.sdPlayer.stop();
+  const uint8_t group = static_cast<uint8_t>(index / kMixerFanIn);
+  const uint8_t slot = static_cast<uint8_t>(index % kMixerFanIn);
+  voiceMixerLeft_[group].gain(slot, 0.0f);
+  voiceMixerRight_[group].gain(slot, 0.0f);
+#else
+  // Same tail as a steal: play out the grain in flight under a short fade.
+  const LiveGrain& grain = liveGrains_[index];
+  if (voice.source == Source::kLiveInput && grain.pos < grain.length) {
+    tailVoices_[index] = voice;
+    tailGrains_[index] = grain;
+    tailFades_[index].start(rates_.sampleRate());
+  }
+  simHwVoices_[index].sdPlayerPlaying = false;
+#endif
+  voice.active = false;
+  stats_.onVoiceRetired(index);
+}
+
+void GranularEngine::setLiveScatterSeconds(float seconds) {
+  liveScatterSeconds_ = std::max(0.0f, seconds);
 }
 
 void GranularEngine::ensureEffectBuffers(std::size_t minFrames) {
-  const float sr = (hostSampleRate_ > 0.0f) ? hostSampleRate_ : 48000.0f;
+  const float sr = rates_.sampleRate();
   const std::size_t desired = std::max<std::size_t>(static_cast<std::size_t>(sr * 2.0f), minFrames + 1u);
   if (effectDelayLeft_.size() == desired && effectDelayRight_.size() == desired) {
     return;
@@ -437,6 +666,26 @@ uint8_t GranularEngine::activeVoiceCount() const {
   }));
 }
 
+#if SEEDBOX_HW
+float GranularEngine::graphUsagePercent() {
+  float percent = 0.0f;
+  for (HardwareVoice& hw : hwVoices_) {
+    percent += hw.sdPlayer.processorUsage() + hw.sourceMixer.processorUsage() + hw.granular.processorUsage();
+  }
+  return percent;
+}
+#endif
+
+uint8_t GranularEngine::fadingVoices() const {
+#if SEEDBOX_HW
+  return 0;
+#else
+  return static_cast<uint8_t>(std::count_if(tailFades_.begin(), tailFades_.end(), [](const VoiceAllocator::StealFade& f) {
+    return f.active();
+  }));
+#endif
+}
+
 GranularEngine::GrainVoice GranularEngine::voice(uint8_t index) const {
   if (index >= kVoicePoolSize) {
     return GrainVoice{};
@@ -479,31 +728,40 @@ const GranularEngine::SourceSlot* GranularEngine::resolveSourceSlot(Source sourc
   return nullptr;
 }
 
-uint8_t GranularEngine::allocateVoice() {
-  // First hunt for an idle voice.
-  for (uint8_t i = 0; i < maxActiveVoices_; ++i) {
-    if (!voices_[i].active) {
-      return i;
-    }
-  }
-
-  // If all voices are active we just steal the oldest one. This keeps the
-  // control code deterministic even before the DSP stage exists.
-  uint8_t oldest = 0;
-  uint32_t minSample = voices_[0].startSample;
-  for (uint8_t i = 1; i < maxActiveVoices_; ++i) {
-    if (voices_[i].startSample < minSample) {
-      oldest = i;
-      minSample = voices_[i].startSample;
+uint8_t GranularEngine::allocateVoice(const Seed& seed) {
+  // Idle voices first.  If all voices are active the steal policy picks one
+  // (oldest by default), which keeps the control code deterministic even
+  // before the DSP stage exists.
+  const VoiceAllocator::Request request{seed.id & 0xFFu, VoiceAllocator::priorityFromSeed(seed)};
+  const auto choice = allocator_.allocate(maxActiveVoices_, request, [this](std::size_t i) {
+    const GrainVoice& v = voices_[i];
+    float level = 1.0f;
+#if !SEEDBOX_HW
+    if (v.source == Source::kLiveInput) {
+      level = liveGrains_[i].level;
     }
+#endif
+    return VoiceAllocator::Candidate{v.active, v.startSample, 0u, level, v.priority, v.seedId};
+  });
+  stats_.steals = allocator_.counters();
+#if !SEEDBOX_HW
+  // Only a live grain that has actually started has anything to fade.
+  const GrainVoice& victim = voices_[choice.index];
+  const LiveGrain& grain = liveGrains_[choice.index];
+  if (choice.stolen && victim.source == Source::kLiveInput && grain.pos < grain.length) {
+    tailVoices_[choice.index] = victim;
+    tailGrains_[choice.index] = grain;
+    tailFades_[choice.index].start(rates_.sampleRate());
   }
-  return oldest;
+#endif
+  return choice.index;
 }
 
 void GranularEngine::planGrain(GrainVoice& voice, const Seed& seed, uint32_t whenSamples) {
   voice.active = true;
   voice.startSample = whenSamples;
   voice.seedId = static_cast<uint8_t>(seed.id);
+  voice.priority = VoiceAllocator::priorityFromSeed(seed);
   voice.sizeMs = seed.granular.grainSizeMs;
   voice.sprayMs = seed.granular.sprayMs;
   voice.windowSkew = seed.granular.windowSkew;
@@ -532,12 +790,12 @@ void GranularEngine::planGrain(GrainVoice& voice, const Seed& seed, uint32_t whe
   float semitones = seed.pitch + seed.granular.transpose;
   voice.playbackRate = 1.0f;
   if (semitones != 0.f) {
-    voice.playbackRate = std::pow(2.0f, semitones / 12.0f);
+    voice.playbackRate = rates_.pitchRatio(semitones);
   }
 
   if (voice.sprayMs > 0.f) {
     const float spray = (RNG::uniformSigned(prng) * voice.sprayMs);
-    const uint32_t offset = Units::msToSamples(std::abs(spray));
+    const uint32_t offset = rates_.msToSamples(std::abs(spray));
     if (spray >= 0.f) {
       voice.startSample += offset;
     } else {
@@ -565,7 +823,7 @@ void GranularEngine::mapGrainToGraph(uint8_t index, GrainVoice& grain) {
 
   hwVoice.granular.setSpeed(grain.playbackRate);
   const float grainLengthMs = std::max(1.0f, grain.sizeMs);
-  const int grainLengthSamples = static_cast<int>(Units::msToSamples(grainLengthMs));
+  const int grainLengthSamples = static_cast<int>(rates_.msToSamples(grainLengthMs));
   configureGranularWindow(hwVoice.granular, grain.windowSkew, grainLengthMs, grainLengthSamples);
 
   const uint8_t group = static_cast<uint8_t>(index / kMixerFanIn);
@@ -584,6 +842,10 @@ void GranularEngine::mapGrainToGraph(uint8_t index, GrainVoice& grain) {
     sim.sdPlayerPlaying = true;
     sim.lastPlayPath = grain.sourcePath;
   }
+
+  // A fresh plan scatters its first grain on the first sample it plays.
+  liveGrains_[index] = LiveGrain{};
+  liveGrains_[index].rng = grain.seedPrng ^ (0x9E3779B9u * (index + 1u));
 #endif
 }
 
@@ -591,7 +853,7 @@ void GranularEngine::trigger(const Seed& seed, uint32_t whenSamples) {
   if (maxActiveVoices_ == 0) {
     return;
   }
-  uint8_t voiceIndex = allocateVoice();
+  uint8_t voiceIndex = allocateVoice(seed);
   planGrain(voices_[voiceIndex], seed, whenSamples);
   stats_.onVoicePlanned(voiceIndex, voices_[voiceIndex]);
   voices_[voiceIndex].dspHandle = voiceIndex;
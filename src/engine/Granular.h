@@ -7,7 +7,10 @@
 #include "HardwarePrelude.h"
 #endif
 #include "engine/Engine.h"
+#include "engine/RateCache.h"
+#include "engine/VoiceAllocator.h"
 #include "util/Annotations.h"
+#include "util/CaptureRing.h"
 
 // Planning scaffold for Option B (granular engine). We now spin up the Teensy
 // Audio graph when running on hardware (and keep detailed stubs for the native
@@ -46,6 +49,7 @@ public:
     uint16_t dspHandle{0};
     uint8_t sdSlot{0};
     uint8_t seedId{0};
+    uint8_t priority{0};
   };
 
   struct Stats {
@@ -60,6 +64,8 @@ public:
 
     void reset();
     void onVoicePlanned(uint8_t voiceIndex, const GrainVoice& voice);
+    // A voice left without being replaced (its ceiling dropped under it).
+    void onVoiceRetired(uint8_t voiceIndex);
 
     uint8_t activeVoiceCount{0};
     uint8_t sdOnlyVoiceCount{0};
@@ -70,18 +76,35 @@ public:
     uint8_t mixerGroupsEngaged{0};
     uint8_t busiestMixerGroup{0};
     uint8_t busiestMixerLoad{0};
+    // Mirror of the allocator's counters: how often a full pool stole a
+    // voice, and how loud the last victim was.
+    VoiceAllocator::Counters steals{};
 
    private:
     std::array<VoiceSample, kVoicePoolSize> voiceSamples_{};
+    void forgetSlot(VoiceSample& slot);
     void refreshMixerAggregates();
   };
 
   GranularEngine() = default;
 
   void init(Mode mode);
+  // Voice ceiling, 1..kVoicePoolSize.  Lowering it (the block-time governor
+  // does, under load) retires the voices above it: live grains fade out like
+  // a steal, SD voices are muted.
   SEEDBOX_MAYBE_UNUSED void setMaxActiveVoices(uint8_t voices);
+  uint8_t maxActiveVoices() const { return maxActiveVoices_; }
   SEEDBOX_MAYBE_UNUSED void armLiveInput(bool enabled);
   SEEDBOX_MAYBE_UNUSED void registerSdClip(uint8_t slot, const char* path);
+  // Live-input grains read from this ring (EngineRouter owns it and AppState
+  // fills it).  Without one, or before it has captured anything, live grains
+  // stay silent in the sim; the Teensy effect keeps its own grain memory.
+  void attachLiveCapture(const util::CaptureRing* ring) { liveCapture_ = ring; }
+  const util::CaptureRing* liveCapture() const { return liveCapture_; }
+  // How far back (seconds) live grains may scatter; clamped to what the ring
+  // holds.  Zero means "the whole ring".
+  SEEDBOX_MAYBE_UNUSED void setLiveScatterSeconds(float seconds);
+  float liveScatterSeconds() const { return liveScatterSeconds_; }
 
   SEEDBOX_MAYBE_UNUSED void trigger(const Seed& seed, uint32_t whenSamples);
   void onSeed(const Seed& seed);
@@ -103,6 +126,17 @@ public:
   SEEDBOX_MAYBE_UNUSED GrainVoice voice(uint8_t index) const;
   Mode mode() const { return mode_; }
   const Stats& stats() const { return stats_; }
+  // Steal policy for a full pool (default kOldest).  Live-input voices report
+  // the level of their last rendered block; SD voices have no envelope in
+  // the sim and always count as full level.
+  void setStealPolicy(StealPolicy policy) { allocator_.setPolicy(policy); }
+  StealPolicy stealPolicy() const { return allocator_.policy(); }
+  // Stolen live voices still fading out (always 0 on hardware).
+  uint8_t fadingVoices() const;
+#if SEEDBOX_HW
+  // Library-node cost of the grain voices; see Sampler::graphUsagePercent().
+  float graphUsagePercent();
+#endif
 
 #if !SEEDBOX_HW
   struct SimHardwareVoice {
@@ -127,12 +161,30 @@ private:
   //   allocateVoice -> pick a slot,
   //   planGrain     -> translate seed genome into a GrainVoice record,
   //   mapGrainToGraph -> wire that plan into the Teensy graph (or simulator).
-  uint8_t allocateVoice();
+  uint8_t allocateVoice(const Seed& seed);
+  void retireVoice(uint8_t index);
   void planGrain(GrainVoice& voice, const Seed& seed, uint32_t whenSamples);
   void mapGrainToGraph(uint8_t index, GrainVoice& grain);
   Source resolveSource(uint8_t encoded) const;
   const SourceSlot* resolveSourceSlot(Source source, uint8_t requestedSlot) const;
   void ensureEffectBuffers(std::size_t minFrames);
+#if !SEEDBOX_HW
+  // One grain in flight per live-input voice.  When it runs out the voice
+  // scatters the next one, so a voice is a continuous cloud until it is
+  // stolen, the same way AudioEffectGranular keeps chewing on its input.
+  struct LiveGrain {
+    double readPos{0.0};  // absolute capture-ring frame the grain reads next
+    uint32_t length{0};   // frames in this grain
+    uint32_t pos{0};      // frames already played
+    uint32_t rng{0};
+    float level{1.0f};    // output peak of the last block, for kQuietest
+  };
+  void startLiveGrain(uint8_t index, double now);
+  void renderLiveVoice(uint8_t index, const Engine::RenderContext& ctx);
+  // Play out the grain a stolen live voice was in the middle of, under a
+  // VoiceAllocator::StealFade, so the steal doesn't click.
+  void renderLiveTail(uint8_t index, const Engine::RenderContext& ctx);
+#endif
 
 private:
   Mode mode_{Mode::kSim};
@@ -142,12 +194,19 @@ private:
   std::array<SourceSlot, kSdClipSlots> sdClips_{};
   std::vector<Seed> seedCache_{};
   Stats stats_{};
-  float hostSampleRate_{48000.0f};
+  VoiceAllocator allocator_{};
+  RateCache rates_{};
   std::vector<float> effectDelayLeft_{};
   std::vector<float> effectDelayRight_{};
   std::size_t effectWritePos_{0};
   float effectLowpassLeft_{0.0f};
   float effectLowpassRight_{0.0f};
+  const util::CaptureRing* liveCapture_{nullptr};
+  float liveScatterSeconds_{0.0f};
+  uint64_t renderSample_{0};
+  // Unwrapped copy of the capture ring's write head, advanced once per block.
+  double liveHead_{0.0};
+  uint32_t liveHeadSeen_{0};
 
 #if SEEDBOX_HW
   struct HardwareVoice {
@@ -168,5 +227,9 @@ private:
   std::vector<std::unique_ptr<AudioConnection>> patchCables_{};
 #else
   std::array<SimHardwareVoice, kVoicePoolSize> simHwVoices_{};
+  std::array<LiveGrain, kVoicePoolSize> liveGrains_{};
+  std::array<GrainVoice, kVoicePoolSize> tailVoices_{};
+  std::array<LiveGrain, kVoicePoolSize> tailGrains_{};
+  std::array<VoiceAllocator::StealFade, kVoicePoolSize> tailFades_{};
 #endif
 };
@@ -39,24 +39,66 @@ void PatternScheduler::setClockProvider(ClockProvider* clock) {
   }
 }
 
+namespace {
+// 24 PPQN: density is quoted in hits per beat, the gate runs once per tick.
+constexpr float kTicksPerBeat = 24.f;
+
+float densityStep(float density) { return density > 0.f ? density / kTicksPerBeat : 0.f; }
+}  // namespace
+
 // Add a seed to the scheduling roster and make sure it has a matching density
-// accumulator slot. The accumulator tracks fractional hits until densityGate
-// decides it's time to trigger.
+// accumulator slot. The accumulator tracks fractional hits until the density
+// gate decides it's time to trigger.  The hot lanes get their own copies of the
+// per-tick fields so onTick never has to stride across whole genomes.
 void PatternScheduler::addSeed(const Seed& s) {
   seeds_.push_back(s);
   densityAccumulators_.push_back(0.f);
+  densitySteps_.push_back(densityStep(s.density));
+  probabilities_.push_back(s.probability);
+  jitterMs_.push_back(s.jitterMs);
+  prngs_.push_back(s.prng);
+  densityHits_.push_back(0u);
 }
 
 // Update the copy of the seed the scheduler owns. Returns false if the caller
 // fat-fingered the index so the tests can assert deterministic behaviour.
+// The accumulator survives on purpose: crossfades call this every tick and
+// should not restart the groove phase.
 bool PatternScheduler::updateSeed(std::size_t index, const Seed& s) {
   if (index >= seeds_.size()) {
     return false;
   }
   seeds_[index] = s;
+  densitySteps_[index] = densityStep(s.density);
+  probabilities_[index] = s.probability;
+  jitterMs_[index] = s.jitterMs;
+  prngs_[index] = s.prng;
   return true;
 }
 
+void PatternScheduler::truncateSeeds(std::size_t count) {
+  if (count >= seeds_.size()) {
+    return;
+  }
+  seeds_.resize(count);
+  densityAccumulators_.resize(count);
+  densitySteps_.resize(count);
+  probabilities_.resize(count);
+  jitterMs_.resize(count);
+  prngs_.resize(count);
+  densityHits_.resize(count);
+}
+
+void PatternScheduler::reserveSeeds(std::size_t count) {
+  seeds_.reserve(count);
+  densityAccumulators_.reserve(count);
+  densitySteps_.reserve(count);
+  probabilities_.reserve(count);
+  jitterMs_.reserve(count);
+  prngs_.reserve(count);
+  densityHits_.reserve(count);
+}
+
 void PatternScheduler::setTriggerCallback(void* ctx, void (*fn)(void*, const Seed&, uint32_t)) {
   // The callback gets called inside `onTick` whenever a seed survives density +
   // probability filtering.  Keeping both the context pointer and function
@@ -92,22 +134,52 @@ void PatternScheduler::clearPendingTriggers() {
   quantizedQueue_.clear();
 }
 
-bool PatternScheduler::densityGate(std::size_t seedIndex, float density) {
-  if (density <= 0.f) return false;
-  if (seedIndex >= densityAccumulators_.size()) return false;
+// Run the density gate for the whole roster in one sweep and return how many
+// seeds cleared it (their indices land in densityHits_, in roster order).
+//
+// Each seed accrues fractional hits according to its density. Once the
+// accumulator crosses 1.0 we let the note through and subtract 1.0 so the
+// groove stays phase-aligned. Think of it as a poor-person's Bernoulli clock
+// that stays deterministic for tests.
+//
+// The loop body is branch-free: every index is written to the hit list and the
+// cursor only advances on a hit.  That keeps the sweep a straight run over
+// three flat arrays — friendly to auto-vectorizers on the desktop and to the
+// M7's pipeline on the Teensy — however many seeds a dense patch throws at it.
+std::size_t PatternScheduler::densityGateAll() {
+  const std::size_t count = densityAccumulators_.size();
+  float* accumulators = densityAccumulators_.data();
+  const float* steps = densitySteps_.data();
+  uint32_t* hits = densityHits_.data();
+  std::size_t hitCount = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const float step = steps[i];
+    const float next = accumulators[i] + step;
+    const bool hit = (next >= 1.f) & (step > 0.f);
+    accumulators[i] = hit ? next - 1.f : next;
+    hits[hitCount] = static_cast<uint32_t>(i);
+    hitCount += hit ? 1u : 0u;
+  }
+  return hitCount;
+}
 
-  // Each seed accrues fractional hits according to its density. Once the
-  // accumulator crosses 1.0 we let the note through and subtract 1.0 so the
-  // groove stays phase-aligned. Think of it as a poor-person's Bernoulli clock
-  // that stays deterministic for tests.
-  static constexpr float kTicksPerBeat = 24.f;
-  float& accumulator = densityAccumulators_[seedIndex];
-  accumulator += density / kTicksPerBeat;
-  if (accumulator >= 1.f) {
-    accumulator -= 1.f;
-    return true;
+// A tap moves beat one, and a beat grid that only swing listens to is not
+// much of a beat grid.  Every density accumulator is rewound to where it would
+// be had it hit exactly on the new downbeat: one step short of 1.0 when the
+// downbeat is the next tick, and `ticksSinceDownbeat - 1` steps past a hit when
+// the downbeat already went by.  Seeds with no density keep their state.
+void PatternScheduler::alignBeat(uint32_t ticksSinceDownbeat) {
+  const uint32_t sinceDownbeat = static_cast<uint32_t>(std::min<uint64_t>(ticksSinceDownbeat % 24u, tickCount_));
+  beatOriginTick_ = tickCount_ - sinceDownbeat;
+  const float ticksSinceHit = static_cast<float>(sinceDownbeat) - 1.f;
+  for (std::size_t i = 0; i < densityAccumulators_.size(); ++i) {
+    const float step = densitySteps_[i];
+    if (step <= 0.f) {
+      continue;
+    }
+    const float phase = ticksSinceHit * step;
+    densityAccumulators_[i] = phase - std::floor(phase);
   }
-  return false;
 }
 
 void PatternScheduler::recalcSamplesPerTick() {
@@ -130,7 +202,7 @@ uint32_t PatternScheduler::latchTickSample() {
 #else
   double interval = samplesPerTick_;
   if (clock_) {
-    interval += clock_->swingNudgeSamples(tickCount_, samplesPerTick_);
+    interval += clock_->swingNudgeSamples(tickCount_ - beatOriginTick_, samplesPerTick_);
   }
   if (interval < 1.0) {
     interval = 1.0;
@@ -159,6 +231,7 @@ void PatternScheduler::dispatchQueues() {
         continue;
       }
       triggerFn_(triggerCtx_, seeds_[evt.seedIndex], evt.when);
+      ++triggersFired_;
     }
     queue.clear();
   };
@@ -190,8 +263,8 @@ void PatternScheduler::onTick() {
 
   // Seed lifecycle doctrine, MOARkNOBS style:
   // 1) PICK: this scheduler is the authority — we march through seeds_ in
-  //    their programmed order every 24 PPQN tick and let densityGate decide if
-  //    the seed is even allowed to wake up on this tick.
+  //    their programmed order every 24 PPQN tick and let densityGateAll decide
+  //    which seeds are even allowed to wake up on this tick.
   // 2) SCHEDULE: once a seed earns a hit we grab the current clock, smear it by
   //    the seed's jitter, and book the trigger time in samples (see nowSamples
   //    and msToSamples) so the render engine can fire with sample-accurate
@@ -206,36 +279,41 @@ void PatternScheduler::onTick() {
   //    engine trigger call.
   quantizedQueue_.clear();
   uint32_t triggersThisTick = 0;
-  for (std::size_t i = 0; i < seeds_.size(); ++i) {
-    Seed& s = seeds_[i];
-    if (densityGate(i, s.density)) {
-      // probability gate
-      if (RNG::uniform01(s.prng) < s.probability) {
-        const uint32_t baseSamples = tickSample;
-        int32_t jitterSamples = 0;
-        if (s.jitterMs != 0.f) {
-          const float jitterMs = RNG::uniformSigned(s.prng) * s.jitterMs;
-          const uint32_t magnitude = msToSamples(std::abs(jitterMs));
-          jitterSamples = static_cast<int32_t>(magnitude);
-          if (jitterMs < 0.f) {
-            jitterSamples = -jitterSamples;
-          }
-        }
-        int64_t scheduled = static_cast<int64_t>(baseSamples) + static_cast<int64_t>(jitterSamples);
-        if (scheduled < 0) {
-          scheduled = 0;
-        }
-        const uint32_t t = static_cast<uint32_t>(scheduled);
-        if (quantizedQueue_.size() >= kMaxQueuedTriggers) {
-          if (diagnosticsEnabled_) {
-            ++diagnostics_.quantizedQueueOverflows;
-          }
-          continue;
-        }
-        quantizedQueue_.push_back({i, t});
-        ++triggersThisTick;
+  const std::size_t hitCount = densityGateAll();
+  for (std::size_t h = 0; h < hitCount; ++h) {
+    const std::size_t i = densityHits_[h];
+    uint32_t& prng = prngs_[i];
+    // probability gate
+    const bool fires = RNG::uniform01(prng) < probabilities_[i];
+    int32_t jitterSamples = 0;
+    if (fires && jitterMs_[i] != 0.f) {
+      const float jitterMs = RNG::uniformSigned(prng) * jitterMs_[i];
+      const uint32_t magnitude = msToSamples(std::abs(jitterMs));
+      jitterSamples = static_cast<int32_t>(magnitude);
+      if (jitterMs < 0.f) {
+        jitterSamples = -jitterSamples;
+      }
+    }
+    // The RNG just moved, so this is the one place the cold genome has to hear
+    // about it: triggers and seedForDebug() read the full Seed.
+    seeds_[i].prng = prng;
+    if (!fires) {
+      continue;
+    }
+    const uint32_t baseSamples = tickSample;
+    int64_t scheduled = static_cast<int64_t>(baseSamples) + static_cast<int64_t>(jitterSamples);
+    if (scheduled < 0) {
+      scheduled = 0;
+    }
+    const uint32_t t = static_cast<uint32_t>(scheduled);
+    if (quantizedQueue_.size() >= kMaxQueuedTriggers) {
+      if (diagnosticsEnabled_) {
+        ++diagnostics_.quantizedQueueOverflows;
       }
+      continue;
     }
+    quantizedQueue_.push_back({i, t});
+    ++triggersThisTick;
   }
   dispatchQueues();
   lastTickTriggerCount_ = triggersThisTick;
@@ -9,6 +9,7 @@
 // perfect whiteboard companion for explaining probability gates, density, and
 // jitter to curious students.  Native builds now advance an internal
 // samples-per-tick cursor so BPM finally dictates the simulated transport math.
+#include <algorithm>
 #include <vector>
 #include <cstddef>
 #include <cstdint>
@@ -37,17 +38,38 @@ public:
   SEEDBOX_MAYBE_UNUSED void onTick();
 
   // Manage the scheduler's seed roster.  Seeds are stored by value so the
-  // scheduler can mutate its own copies without racing callers.
+  // scheduler can mutate its own copies without racing callers.  `reserveSeeds`
+  // is optional; dense patches call it so a rebuild does one allocation per
+  // lane instead of growing hundreds of times.
   SEEDBOX_MAYBE_UNUSED void addSeed(const Seed& s);
   SEEDBOX_MAYBE_UNUSED bool updateSeed(std::size_t index, const Seed& s);
+  SEEDBOX_MAYBE_UNUSED void reserveSeeds(std::size_t count);
+  // Drop every seed from `count` onward (no-op when the roster is smaller).
+  // Pending triggers for dropped seeds are discarded at dispatch.
+  SEEDBOX_MAYBE_UNUSED void truncateSeeds(std::size_t count);
+  std::size_t seedCount() const { return seeds_.size(); }
 
   // Register a callback that will fire whenever a seed earns a trigger.  The
   // callback receives the sample timestamp so downstream code can render in
   // lockstep with the audio device.
   SEEDBOX_MAYBE_UNUSED void setTriggerCallback(void* ctx, void (*fn)(void*, const Seed&, uint32_t));
   uint64_t ticks() const { return tickCount_; }
+  // Position inside the current quarter note (0..23).  ticks() never rewinds,
+  // so beat phase is kept relative to a movable origin instead.
+  uint32_t tickWithinBeat() const { return static_cast<uint32_t>((tickCount_ - beatOriginTick_) % 24u); }
+  // Re-phase the beat so the downbeat was `ticksSinceDownbeat` ticks ago (0:
+  // the next onTick() is the downbeat) -- what a tap tempo means by "here".
+  // Swing and the density gates both follow: a seed at one hit per beat lands
+  // on the tapped downbeat.  See Patterns.cpp.
+  SEEDBOX_MAYBE_UNUSED void alignBeat(uint32_t ticksSinceDownbeat);
+  // Tick of the current beat grid's downbeat.  Bar and gate grids count from
+  // here rather than from tick zero.
+  uint64_t beatOriginTick() const { return beatOriginTick_; }
 
   SEEDBOX_MAYBE_UNUSED uint32_t lastTickTriggerCount() const { return lastTickTriggerCount_; }
+  // Every trigger handed to the callback since construction, immediate ones
+  // included.  Monotonic, so observers diff it instead of resetting it.
+  SEEDBOX_MAYBE_UNUSED uint64_t triggersFired() const { return triggersFired_; }
 
   SEEDBOX_MAYBE_UNUSED uint32_t nowSamples() const;
 
@@ -79,16 +101,28 @@ public:
 private:
   // Implementation helpers documented in Patterns.cpp.  We keep declarations
   // clustered here so readers know what machinery hides behind `onTick`.
-  bool densityGate(std::size_t seedIndex, float density);
+  std::size_t densityGateAll();
   void recalcSamplesPerTick();
   uint32_t latchTickSample();
   uint32_t msToSamples(float ms);
   void dispatchQueues();
 
 private:
+  // The roster is split hot/cold.  `onTick` walks every seed, but only needs
+  // the handful of fields below, so they live in parallel contiguous arrays
+  // (one float/word per seed, a few cache lines for a hundred seeds).  The full
+  // ~100-byte genome in `seeds_` is only touched for seeds that clear the
+  // density gate: their RNG state is mirrored back, and fired ones are handed
+  // to the trigger callback.
   std::vector<Seed> seeds_;
   std::vector<float> densityAccumulators_;
+  std::vector<float> densitySteps_;    // density / 24, or 0 when density <= 0
+  std::vector<float> probabilities_;
+  std::vector<float> jitterMs_;
+  std::vector<uint32_t> prngs_;        // authoritative RNG state per seed
+  std::vector<uint32_t> densityHits_;  // scratch: indices that cleared the gate
   uint64_t tickCount_{0};
+  uint64_t beatOriginTick_{0};
   ClockProvider* clock_{nullptr};
   float bpm_{120.f};
   void* triggerCtx_{nullptr};
@@ -107,6 +141,7 @@ private:
   std::vector<QueuedTrigger> immediateQueue_;
   std::vector<uint32_t> tickLog_;
   uint32_t lastTickTriggerCount_{0};
+  uint64_t triggersFired_{0};
   Diagnostics diagnostics_{};
   bool diagnosticsEnabled_{false};
 };
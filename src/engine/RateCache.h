@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+//
+// RateCache
+// ---------
+// Every engine needs some numbers that depend on the sample rate: how many
+// samples are in 2 s of delay, the per-sample decay that reaches -60 dB in
+// 0.4 s, a one-pole coefficient, the radians per sample of a 440 Hz tone.
+// These used to be worked out inline, sometimes inside the per-sample loop,
+// and sometimes against `Units::kSampleRate` instead of the rate the host
+// actually runs at.  That quietly detuned the resonator, and shortened the
+// granular smear, in any 44.1 or 96 kHz session.
+//
+// Each engine now owns one of these and calls `prepare()` from its own
+// `prepare(PrepareContext)`.  After that, the hot path reads from the cache
+// instead of dividing by the rate or calling pow().  The rules:
+// - At the reference rate (48 kHz) every helper returns exactly what the old
+//   inline maths did, bit for bit, so golden renders do not move.
+// - Pitch ratios for whole semitones come from a table built here with the
+//   same std::pow call the engines used to make.  Quantized seeds, the
+//   common case with the scale quantizer on, never touch pow() on a
+//   trigger.  Fractional pitches fall back to pow() and get the identical
+//   answer.
+// - Filter coefficients are written at 48 kHz, because that is where they
+//   were tuned by ear.  `onePole()` re-derives them for the current rate so
+//   the corner frequency stays put in Hz.
+class RateCache {
+public:
+  static constexpr float kReferenceRate = 48000.0f;
+  // Whole-semitone table covers the range seeds are clamped to.
+  static constexpr int kPitchTableSemitones = 48;
+
+  RateCache() { prepare(kReferenceRate); }
+
+  // Rebuild every cached value for `sampleRate` (0 or negative means 48 kHz).
+  void prepare(float sampleRate) {
+    sampleRate_ = sampleRate > 0.0f ? sampleRate : kReferenceRate;
+    secondsPerSample_ = 1.0f / sampleRate_;
+    referenceRatio_ = kReferenceRate / sampleRate_;
+    nyquistGuardHz_ = sampleRate_ * 0.45f;
+    for (int i = 0; i < static_cast<int>(pitchTable_.size()); ++i) {
+      const float semitones = static_cast<float>(i - kPitchTableSemitones);
+      pitchTable_[static_cast<std::size_t>(i)] = std::pow(2.0f, semitones / 12.0f);
+    }
+  }
+
+  float sampleRate() const { return sampleRate_; }
+  float secondsPerSample() const { return secondsPerSample_; }
+
+  // Whole samples in `seconds` / `ms`, truncated the way the engines always
+  // have, so a 2 s delay is exactly `2 * rate` samples long.
+  std::size_t samples(float seconds) const { return static_cast<std::size_t>(sampleRate_ * seconds); }
+  std::uint32_t msToSamples(float ms) const { return static_cast<std::uint32_t>((ms * 0.001f) * sampleRate_); }
+
+  // Samples in one period of `hz`, for string and comb delays.
+  float periodSamples(float hz) const { return sampleRate_ / hz; }
+
+  // Phase step of a sine at `hz`, capped a little under Nyquist.
+  float radiansPerSample(float hz) const { return kTwoPi * std::min(hz, nyquistGuardHz_) / sampleRate_; }
+
+  // Per-sample multiplier that falls 60 dB in `seconds`.
+  float decayPerSample(float seconds) const { return std::exp(-6.9077553f / (seconds * sampleRate_)); }
+
+  // A one-pole smoothing coefficient tuned at 48 kHz, adjusted for this rate
+  // so the corner frequency stays the same in Hz.
+  float onePole(float coefficientAtReference) const {
+    if (referenceRatio_ == 1.0f) {
+      return coefficientAtReference;
+    }
+    const float c = std::clamp(coefficientAtReference, 0.0f, 1.0f);
+    return 1.0f - std::pow(1.0f - c, referenceRatio_);
+  }
+
+  // 2^(semitones / 12).  Whole semitones in range read the table; anything
+  // else pays for the pow() call.
+  float pitchRatio(float semitones) const {
+    const float whole = std::floor(semitones);
+    if (whole == semitones && std::fabs(whole) <= static_cast<float>(kPitchTableSemitones)) {
+      return pitchTable_[static_cast<std::size_t>(static_cast<int>(whole) + kPitchTableSemitones)];
+    }
+    return std::pow(2.0f, semitones / 12.0f);
+  }
+
+private:
+  static constexpr float kTwoPi = 6.2831853071795864769f;
+
+  float sampleRate_{kReferenceRate};
+  float secondsPerSample_{1.0f / kReferenceRate};
+  float referenceRatio_{1.0f};
+  float nyquistGuardHz_{kReferenceRate * 0.45f};
+  std::array<float, 2 * kPitchTableSemitones + 1> pitchTable_{};
+};
@@ -9,7 +9,6 @@
 #include <array>
 #include <cmath>
 #include "util/RNG.h"
-#include "util/Units.h"
 
 Engine::Type ResonatorBank::type() const noexcept { return Engine::Type::kResonator; }
 
@@ -73,6 +72,7 @@ void ResonatorBank::init(Mode mode) {
   presets_ = kDefaultPresets;
 
   voices_.fill(VoiceInternal{});
+  allocator_.resetCounters();
 
 #if SEEDBOX_HW
   patchCables_.clear();
@@ -84,6 +84,8 @@ void ResonatorBank::init(Mode mode) {
     hwVoice.burstEnv.decay(3.0f);
     hwVoice.burstEnv.sustain(0.0f);
     hwVoice.burstEnv.release(2.0f);
+    // Restealing a voice ramps its exciter down before the next burst.
+    hwVoice.burstEnv.releaseNoteOn(VoiceAllocator::kStealFadeMs);
 
     hwVoice.brightnessFilter.frequency(4000.0f);
     hwVoice.brightnessFilter.resonance(0.7f);
@@ -159,14 +161,19 @@ void ResonatorBank::init(Mode mode) {
 void ResonatorBank::prepare(const Engine::PrepareContext& ctx) {
   init(ctx.hardware ? Mode::kHardware : Mode::kSim);
   (void)ctx.masterSeed;
-  hostSampleRate_ = (ctx.sampleRate > 0) ? static_cast<float>(ctx.sampleRate) : 48000.0f;
-  const std::size_t delayFrames = std::max<std::size_t>(static_cast<std::size_t>(hostSampleRate_ * 2.0f),
+  // String lengths, the host comb's modal taps and its brightness filter all
+  // read the cache, so a seed rings at the same pitch at any host rate.
+  rates_.prepare(static_cast<float>(ctx.sampleRate));
+  const std::size_t delayFrames = std::max<std::size_t>(rates_.samples(2.0f),
                                                         static_cast<std::size_t>(ctx.framesPerBlock) + 1u);
   hostDelayLeft_.assign(delayFrames, 0.0f);
   hostDelayRight_.assign(delayFrames, 0.0f);
   hostWritePos_ = 0;
+  hostHoldPos_ = 0;
   hostBrightLeft_ = 0.0f;
   hostBrightRight_ = 0.0f;
+  oversampleLeft_.reset();
+  oversampleRight_.reset();
 }
 
 void ResonatorBank::onTick(const Engine::TickContext& ctx) {
@@ -191,7 +198,7 @@ void ResonatorBank::processInputAudio(const Seed& seed, const Engine::RenderCont
   }
   if (hostDelayLeft_.empty() || hostDelayRight_.empty()) {
     const std::size_t delayFrames =
-        std::max<std::size_t>(static_cast<std::size_t>(std::max(48000.0f, hostSampleRate_) * 2.0f), ctx.frames + 1u);
+        std::max<std::size_t>(static_cast<std::size_t>(std::max(48000.0f, rates_.sampleRate()) * 2.0f), ctx.frames + 1u);
     hostDelayLeft_.assign(delayFrames, 0.0f);
     hostDelayRight_.assign(delayFrames, 0.0f);
   }
@@ -207,33 +214,50 @@ void ResonatorBank::processInputAudio(const Seed& seed, const Engine::RenderCont
   const float basePitch = clamp01((seed.pitch + 24.0f) / 48.0f);
   const float baseFrequency = 70.0f + (basePitch * 260.0f) + (seed.tone * 180.0f);
   const std::size_t delaySize = hostDelayLeft_.size();
+  // Everything below is fixed for the block, so the per-sample loop only
+  // reads: one tap distance per mode and one filter coefficient.
+  const float brightCoeff = rates_.onePole(0.04f + (brightness * 0.22f));
+  std::array<std::size_t, 4> modeTaps{};
+  static_assert(std::tuple_size<decltype(ModalPreset::modeRatios)>::value == 4, "one tap per modal ratio");
+  for (std::size_t mode = 0; mode < modeTaps.size(); ++mode) {
+    const float modeHz = std::max(28.0f, baseFrequency * preset.modeRatios[mode]);
+    const std::size_t delaySamples = std::clamp<std::size_t>(static_cast<std::size_t>(rates_.periodSamples(modeHz)),
+                                                             12u, std::max<std::size_t>(24u, delaySize / 3u));
+    modeTaps[mode] = delaySamples + (mode * 7u);
+  }
+  const std::size_t held = (liveCapture_ != nullptr && liveCapture_->frozen()) ? liveCapture_->available() : 0u;
+  if (held == 0) {
+    hostHoldPos_ = 0;
+  }
+  const auto saturate = [](float x) { return std::tanh(x); };
 
   for (std::size_t i = 0; i < ctx.frames; ++i) {
-    const float inL = ctx.inputLeft[i];
-    const float inR = ctx.inputRight ? ctx.inputRight[i] : inL;
+    float inL = ctx.inputLeft[i];
+    float inR = ctx.inputRight ? ctx.inputRight[i] : inL;
+    if (held > 0) {
+      // Oldest to newest through the frozen window, then around again.
+      liveCapture_->read(static_cast<float>(held - (hostHoldPos_ % held)), inL, inR);
+      ++hostHoldPos_;
+    }
 
-    hostBrightLeft_ += (0.04f + (brightness * 0.22f)) * (inL - hostBrightLeft_);
-    hostBrightRight_ += (0.04f + (brightness * 0.22f)) * (inR - hostBrightRight_);
+    hostBrightLeft_ += brightCoeff * (inL - hostBrightLeft_);
+    hostBrightRight_ += brightCoeff * (inR - hostBrightRight_);
 
     const float exciteL = ((inL - hostBrightLeft_) * (0.55f + (seed.tone * 0.35f)) + (hostBrightLeft_ * 0.25f)) * excitation;
     const float exciteR = ((inR - hostBrightRight_) * (0.55f + (seed.tone * 0.35f)) + (hostBrightRight_ * 0.25f)) * excitation;
 
     float modalL = 0.0f;
     float modalR = 0.0f;
-    for (std::size_t mode = 0; mode < preset.modeRatios.size(); ++mode) {
-      const float modeHz = std::max(28.0f, baseFrequency * preset.modeRatios[mode]);
-      const std::size_t delaySamples = std::clamp<std::size_t>(
-          static_cast<std::size_t>(hostSampleRate_ / modeHz), 12u,
-          std::max<std::size_t>(24u, delaySize / 3u));
-      const std::size_t tap = wrapDelayTap(hostWritePos_, delaySize, delaySamples + (mode * 7u));
+    for (std::size_t mode = 0; mode < modeTaps.size(); ++mode) {
+      const std::size_t tap = wrapDelayTap(hostWritePos_, delaySize, modeTaps[mode]);
       modalL += hostDelayLeft_[tap] * preset.modeGains[mode];
       modalR += hostDelayRight_[tap] * preset.modeGains[mode];
     }
 
     const float resonantL = (modalL * feedback) + exciteL;
     const float resonantR = (modalR * feedback) + exciteR;
-    const float outL = std::tanh((inL * (1.0f - wet * 0.4f)) + (resonantL * wet * 1.2f));
-    const float outR = std::tanh((inR * (1.0f - wet * 0.4f)) + (resonantR * wet * 1.2f));
+    const float outL = oversampleLeft_.process((inL * (1.0f - wet * 0.4f)) + (resonantL * wet * 1.2f), saturate);
+    const float outR = oversampleRight_.process((inR * (1.0f - wet * 0.4f)) + (resonantR * wet * 1.2f), saturate);
 
     ctx.left[i] += outL;
     ctx.right[i] += outR;
@@ -263,6 +287,7 @@ void ResonatorBank::panic() {
   std::fill(hostDelayLeft_.begin(), hostDelayLeft_.end(), 0.0f);
   std::fill(hostDelayRight_.begin(), hostDelayRight_.end(), 0.0f);
   hostWritePos_ = 0;
+  hostHoldPos_ = 0;
   hostBrightLeft_ = 0.0f;
   hostBrightRight_ = 0.0f;
 
@@ -297,6 +322,22 @@ void ResonatorBank::panic() {
 
 void ResonatorBank::setMaxVoices(uint8_t voices) {
   maxVoices_ = std::max<uint8_t>(1, std::min<uint8_t>(voices, kMaxVoices));
+  for (uint8_t i = maxVoices_; i < kMaxVoices; ++i) {
+    retireVoice(i);
+  }
+}
+
+void ResonatorBank::retireVoice(uint8_t index) {
+  VoiceInternal& voice = voices_[index];
+  if (!voice.active) {
+    return;
+  }
+#if SEEDBOX_HW
+  // Close the exciter and leave the string alone: it decays on its own
+  // feedback, which is the gentlest way for a resonator to leave.
+  hwVoices_[index].burstEnv.noteOff();
+#endif
+  voice.active = false;
 }
 
 void ResonatorBank::setDampingRange(float minDamping, float maxDamping) {
@@ -310,25 +351,25 @@ uint8_t ResonatorBank::activeVoices() const {
   }));
 }
 
-uint8_t ResonatorBank::allocateVoice() {
-  for (uint8_t i = 0; i < maxVoices_; ++i) {
-    if (!voices_[i].active) {
-      return i;
-    }
-  }
-  // steal the oldest voice to keep the modal bank ringing
-  uint8_t oldest = 0;
-  uint32_t minSample = voices_[0].startSample;
-  uint32_t minHandle = voices_[0].handle;
-  for (uint8_t i = 1; i < maxVoices_; ++i) {
-    if (voices_[i].startSample < minSample ||
-        (voices_[i].startSample == minSample && voices_[i].handle < minHandle)) {
-      oldest = i;
-      minSample = voices_[i].startSample;
-      minHandle = voices_[i].handle;
-    }
+uint8_t ResonatorBank::allocateVoice(const Seed& seed, uint32_t whenSamples) {
+  // Free slots first; with the bank full the steal policy picks the victim
+  // (oldest by default) to keep the modal bank ringing.
+  const VoiceAllocator::Request request{seed.id & 0xFFu, VoiceAllocator::priorityFromSeed(seed)};
+  const auto choice = allocator_.allocate(maxVoices_, request, [&](std::size_t i) {
+    const VoiceInternal& v = voices_[i];
+    return VoiceAllocator::Candidate{v.active, v.startSample, v.handle, estimatedLevel(v, whenSamples), v.priority,
+                                     v.seedId};
+  });
+  return choice.index;
+}
+
+float ResonatorBank::estimatedLevel(const VoiceInternal& v, uint32_t atSample) const {
+  if (!v.active || atSample <= v.startSample) {
+    return v.burstGain;
   }
-  return oldest;
+  // One trip round the string per period, losing `feedback` each time.
+  const float periods = static_cast<float>(atSample - v.startSample) / std::max(1.0f, v.delaySamples);
+  return v.burstGain * std::pow(std::max(0.05f, v.feedback), periods);
 }
 
 void ResonatorBank::planExcitation(VoiceInternal& v, const Seed& seed, uint32_t whenSamples) {
@@ -338,6 +379,7 @@ void ResonatorBank::planExcitation(VoiceInternal& v, const Seed& seed, uint32_t
   v.mode = clampMode(seed.resonator.mode);
   v.bank = (seed.resonator.bank < presets_.size()) ? seed.resonator.bank : static_cast<uint8_t>(presets_.size() - 1);
   v.preset = &resolvePreset(v.bank);
+  v.priority = VoiceAllocator::priorityFromSeed(seed);
 
   v.handle = nextHandle_++;
   if (nextHandle_ == 0) {
@@ -346,7 +388,7 @@ void ResonatorBank::planExcitation(VoiceInternal& v, const Seed& seed, uint32_t
 
   const float semitones = seed.pitch;
   const float baseHz = 110.0f; // A2 reference
-  v.frequency = baseHz * std::pow(2.0f, semitones / 12.0f);
+  v.frequency = baseHz * rates_.pitchRatio(semitones);
 
   v.burstMs = std::max(0.25f, seed.resonator.exciteMs);
 
@@ -359,7 +401,7 @@ void ResonatorBank::planExcitation(VoiceInternal& v, const Seed& seed, uint32_t
   const float seedFeedback = clamp01(seed.resonator.feedback);
   v.feedback = clamp01(lerp(v.preset->baseFeedback, seedFeedback, 0.65f));
 
-  v.delaySamples = std::max(1.0f, Units::kSampleRate / std::max(10.0f, v.frequency));
+  v.delaySamples = std::max(1.0f, rates_.periodSamples(std::max(10.0f, v.frequency)));
 
   // Calculate burst gain so brighter hits lean into the modal bank harder while
   // still respecting damping — darker hits sound softer.
@@ -385,7 +427,7 @@ void ResonatorBank::trigger(const Seed& seed, uint32_t whenSamples) {
   if (maxVoices_ == 0) {
     return;
   }
-  const uint8_t voiceIndex = allocateVoice();
+  const uint8_t voiceIndex = allocateVoice(seed, whenSamples);
   VoiceInternal& voiceSlot = voices_[voiceIndex];
 
   planExcitation(voiceSlot, seed, whenSamples);
@@ -440,7 +482,7 @@ void ResonatorBank::mapVoiceToGraph(uint8_t voiceIndex, VoiceInternal& voicePlan
   hwVoice.brightnessFilter.frequency(tiltHz);
   hwVoice.brightnessFilter.resonance(0.7f + 0.2f * (1.0f - voicePlan.damping));
 
-  const float delayMs = (voicePlan.delaySamples / Units::kSampleRate) * 1000.0f;
+  const float delayMs = voicePlan.delaySamples * rates_.secondsPerSample() * 1000.0f;
   hwVoice.stringDelay.delay(0, std::max(0.1f, delayMs));
 
   for (uint8_t m = 0; m < hwVoice.modalFilters.size(); ++m) {
@@ -487,6 +529,20 @@ const ResonatorBank::ModalPreset& ResonatorBank::resolvePreset(uint8_t bank) con
   return presets_[bank];
 }
 
+#if SEEDBOX_HW
+float ResonatorBank::graphUsagePercent() {
+  float percent = 0.0f;
+  for (HardwareVoice& hw : hwVoices_) {
+    percent += hw.burstNoise.processorUsage() + hw.burstEnv.processorUsage() + hw.brightnessFilter.processorUsage() +
+               hw.stringDelay.processorUsage() + hw.modalMix.processorUsage() + hw.mix.processorUsage();
+    for (AudioFilterBiquad& filter : hw.modalFilters) {
+      percent += filter.processorUsage();
+    }
+  }
+  return percent;
+}
+#endif
+
 uint8_t ResonatorBank::clampMode(uint8_t requested) const {
   return requested == 0 ? 0 : 1;
 }
@@ -6,7 +6,11 @@
 #include "HardwarePrelude.h"
 #endif
 #include "engine/Engine.h"
+#include "engine/RateCache.h"
+#include "engine/VoiceAllocator.h"
 #include "util/Annotations.h"
+#include "util/CaptureRing.h"
+#include "util/Oversampler.h"
 #include <vector>
 
 // ResonatorBank sketches Option C (Karplus-Strong / modal ping engine). The
@@ -17,8 +21,15 @@ public:
   enum class Mode : uint8_t { kSim, kHardware };
 
   void init(Mode mode);
+  // Voice ceiling, 1..kMaxVoices.  Lowering it (the block-time governor does,
+  // under load) lets the voices above it ring out instead of killing them.
   SEEDBOX_MAYBE_UNUSED void setMaxVoices(uint8_t voices);
+  uint8_t maxVoices() const { return maxVoices_; }
   SEEDBOX_MAYBE_UNUSED void setDampingRange(float minDamping, float maxDamping);
+  // While this ring is frozen, the live-input exciter loops the held window
+  // instead of the block arriving now, so a captured hit keeps ringing the
+  // bank after the player stops.
+  void attachLiveCapture(const util::CaptureRing* ring) { liveCapture_ = ring; }
 
   SEEDBOX_MAYBE_UNUSED void trigger(const Seed& seed, uint32_t whenSamples);
   void onSeed(const Seed& seed);
@@ -37,6 +48,19 @@ public:
   void panic() override;
 
   uint8_t activeVoices() const;
+  // Steal policy for a full bank (default kOldest).  The bank has no
+  // per-voice render loop yet, so kQuietest ranks voices by an estimate: the
+  // burst gain decayed by the string's feedback once per period since start.
+  void setStealPolicy(StealPolicy policy) { allocator_.setPolicy(policy); }
+  StealPolicy stealPolicy() const { return allocator_.policy(); }
+  // Rate the host comb's output saturator runs at (default kBypass).  See
+  // util/Oversampler.h for the presets.
+  void setOversampling(const util::Oversampler::Quality& quality) {
+    oversampleLeft_.setQuality(quality);
+    oversampleRight_.setQuality(quality);
+  }
+  const util::Oversampler::Quality& oversampling() const { return oversampleLeft_.quality(); }
+  const VoiceAllocator::Counters& stealCounters() const { return allocator_.counters(); }
   SEEDBOX_MAYBE_UNUSED const char* presetName(uint8_t bank) const;
 
   SEEDBOX_MAYBE_UNUSED float fanoutProbeLevel() const;
@@ -61,6 +85,10 @@ public:
   };
 
   SEEDBOX_MAYBE_UNUSED VoiceState voice(uint8_t voiceIndex) const;
+#if SEEDBOX_HW
+  // Library-node cost of the string voices; see Sampler::graphUsagePercent().
+  float graphUsagePercent();
+#endif
 
   static constexpr uint8_t kMaxVoices = 16;
 
@@ -90,11 +118,14 @@ private:
     uint8_t mode{0};
     uint8_t bank{0};
     const ModalPreset* preset{nullptr};
+    uint8_t priority{0};
   };
 
   // Helper trio: choose a voice slot, translate the seed into modal parameters,
   // and then map that plan onto either hardware nodes or simulator state.
-  uint8_t allocateVoice();
+  uint8_t allocateVoice(const Seed& seed, uint32_t whenSamples);
+  float estimatedLevel(const VoiceInternal& v, uint32_t atSample) const;
+  void retireVoice(uint8_t index);
   void planExcitation(VoiceInternal& v, const Seed& seed, uint32_t whenSamples);
   void mapVoiceToGraph(uint8_t voiceIndex, VoiceInternal& voicePlan);
   const ModalPreset& resolvePreset(uint8_t bank) const;
@@ -107,14 +138,19 @@ private:
   float maxDamping_{0.9f};
   std::array<VoiceInternal, kMaxVoices> voices_{};
   uint32_t nextHandle_{1};
+  VoiceAllocator allocator_{};
   std::array<ModalPreset, 6> presets_{};
   std::vector<Seed> seedCache_{};
-  float hostSampleRate_{48000.0f};
+  RateCache rates_{};
   std::vector<float> hostDelayLeft_{};
   std::vector<float> hostDelayRight_{};
   std::size_t hostWritePos_{0};
   float hostBrightLeft_{0.0f};
   float hostBrightRight_{0.0f};
+  const util::CaptureRing* liveCapture_{nullptr};
+  std::size_t hostHoldPos_{0};
+  util::Oversampler oversampleLeft_{};
+  util::Oversampler oversampleRight_{};
 
 #if SEEDBOX_HW
   struct HardwareVoice {
@@ -21,9 +21,15 @@ namespace {
 constexpr uint8_t kRamPreloadCount = Sampler::kMaxVoices;
 #if SEEDBOX_HW
 constexpr float msFromSeconds(float seconds) { return seconds * 1000.0f; }
+
+// Map the 0-1 tone knob to a useful musical range for the tilt filter.
+constexpr float tiltHzFromTone(float tone) {
+  constexpr float kMinTiltHz = 400.0f;
+  constexpr float kMaxTiltHz = 8000.0f;
+  return kMinTiltHz + (kMaxTiltHz - kMinTiltHz) * tone;
+}
 #endif
 
-constexpr float kFallbackSampleRate = 48000.0f;
 constexpr float kFallbackBaseHz = 440.0f;
 constexpr float kFallbackVoiceGain = 0.18f;
 constexpr float kTwoPi = 6.2831853071795864769f;
@@ -33,11 +39,8 @@ float phaseFromPrng(uint32_t prng) {
   return normalized * kTwoPi;
 }
 
-float sampleRateOrFallback(float sampleRate) {
-  return sampleRate > 0.0f ? sampleRate : kFallbackSampleRate;
-}
-
-#if !SEEDBOX_HW
+// Shared by the native renderer and the hardware level tracker, which needs
+// to know how loud each Teensy envelope is for the kQuietest steal policy.
 float envelopeOneShot(float t, float attack, float decay, float sustain, float release) {
   if (t <= 0.0f) {
     return 0.0f;
@@ -66,7 +69,6 @@ float envelopeOneShot(float t, float attack, float decay, float sustain, float r
 float totalOneShotSeconds(float attack, float decay, float release) {
   return std::max(0.0f, attack) + std::max(0.0f, decay) + std::max(0.0f, release);
 }
-#endif
 }
 
 Engine::Type Sampler::type() const noexcept { return Engine::Type::kSampler; }
@@ -78,6 +80,16 @@ void Sampler::init() {
   // when you power-cycle the synth — no lingering envelope states or stale
   // sample handles survive a call to `init`.
   voices_.fill(VoiceInternal{});
+  maxVoices_ = kMaxVoices;
+  allocator_.resetCounters();
+#if !SEEDBOX_HW
+  tails_.fill(VoiceInternal{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
+#endif
+  // Targets queued for the old voices have nobody left to steer.
+  util::ParamTarget stale{};
+  while (paramTargets_.pop(stale)) {
+  }
 
 #if SEEDBOX_HW
   patchCables_.clear();
@@ -96,6 +108,9 @@ void Sampler::init() {
     hwVoice.envelope.decay(50.0f);
     hwVoice.envelope.sustain(0.8f);
     hwVoice.envelope.release(100.0f);
+    // A retriggered envelope ramps the old note down this fast before the new
+    // attack, which is the anti-click fade for stolen voices on hardware.
+    hwVoice.envelope.releaseNoteOn(VoiceAllocator::kStealFadeMs);
 
     // Tone filter starts bright-ish and wide. ConfigureVoice narrows it based on
     // the seed's tilt request.
@@ -124,7 +139,9 @@ void Sampler::init() {
 }
 
 void Sampler::prepare(const Engine::PrepareContext& ctx) {
-  sampleRate_ = sampleRateOrFallback(static_cast<float>(ctx.sampleRate));
+  // Envelope times, glide rates and the fallback oscillator's phase step all
+  // come from here, so a 96 kHz host hears the same note for the same time.
+  rates_.prepare(static_cast<float>(ctx.sampleRate));
   init();
 }
 
@@ -133,7 +150,98 @@ void Sampler::onTick(const Engine::TickContext& ctx) {
 }
 
 void Sampler::onParam(const Engine::ParamChange& change) {
-  (void)change;
+  if (change.id >= static_cast<std::uint16_t>(Param::kCount)) {
+    return;
+  }
+  const float value = static_cast<float>(change.value) / static_cast<float>(kParamUnity);
+  queueParamTarget(change.seedId, static_cast<Param>(change.id), value);
+}
+
+bool Sampler::queueParamTarget(uint32_t seedId, Param param, float value) {
+  if (param >= Param::kCount) {
+    return false;
+  }
+  util::ParamTarget target{};
+  target.seedId = seedId;
+  target.param = static_cast<std::uint16_t>(param);
+  target.value = clamp01(value);
+  return paramTargets_.push(target);
+}
+
+void Sampler::setParamSmoothingMs(Param param, float ms) {
+  if (param >= Param::kCount) {
+    return;
+  }
+  smoothingMs_[static_cast<std::size_t>(param)] = std::max(0.0f, ms);
+}
+
+float Sampler::paramSmoothingMs(Param param) const {
+  if (param >= Param::kCount) {
+    return 0.0f;
+  }
+  return smoothingMs_[static_cast<std::size_t>(param)];
+}
+
+uint8_t Sampler::rampingVoices() const {
+  return static_cast<uint8_t>(std::count_if(voices_.begin(), voices_.end(), [](const VoiceInternal& v) {
+    return v.active && v.ramping;
+  }));
+}
+
+void Sampler::drainParamTargets() {
+  // Bounded by the ring size, so a flood of automation costs at most one
+  // queue's worth of work per block.
+  util::ParamTarget target{};
+  while (paramTargets_.pop(target)) {
+    for (auto& voice : voices_) {
+      if (voice.active && voice.seedId == target.seedId) {
+        applyParamTarget(voice, target);
+      }
+    }
+  }
+}
+
+void Sampler::applyParamTarget(VoiceInternal& voice, const util::ParamTarget& target) {
+  const float ms = smoothingMs_[target.param];
+  switch (static_cast<Param>(target.param)) {
+    case Param::kTone:
+      if (voice.toneRamp.timeMs() != ms) {
+        voice.toneRamp.configure(ms, rates_.sampleRate(), util::ParamRamp::Curve::kOnePole);
+      }
+      voice.toneRamp.setTarget(target.value);
+      break;
+    case Param::kSpread: {
+      // Ramp the two channel gains rather than the width itself: that keeps
+      // the per-sample cost to two slews instead of a sin/cos pair.
+      voice.spread = target.value;
+      const auto gains = stereo::constantPowerWidth(voice.spread);
+      if (voice.leftGainRamp.timeMs() != ms) {
+        voice.leftGainRamp.configure(ms, rates_.sampleRate());
+        voice.rightGainRamp.configure(ms, rates_.sampleRate());
+      }
+      voice.leftGainRamp.setTarget(gains.left);
+      voice.rightGainRamp.setTarget(gains.right);
+      break;
+    }
+    default:
+      return;
+  }
+  voice.ramping = voice.toneRamp.ramping() || voice.leftGainRamp.ramping() || voice.rightGainRamp.ramping();
+}
+
+void Sampler::stepRamps(VoiceInternal& voice, std::uint32_t samples) {
+  if (samples == 1) {
+    // The per-sample path only feeds the native mix, which reads the gains.
+    // Tone has no per-sample consumer there; renderAudio() catches it up once
+    // per block.
+    voice.leftGain = voice.leftGainRamp.next();
+    voice.rightGain = voice.rightGainRamp.next();
+  } else {
+    voice.tone = voice.toneRamp.advance(samples);
+    voice.leftGain = voice.leftGainRamp.advance(samples);
+    voice.rightGain = voice.rightGainRamp.advance(samples);
+  }
+  voice.ramping = voice.toneRamp.ramping() || voice.leftGainRamp.ramping() || voice.rightGainRamp.ramping();
 }
 
 void Sampler::onSeed(const Engine::SeedContext& ctx) {
@@ -141,15 +249,37 @@ void Sampler::onSeed(const Engine::SeedContext& ctx) {
 }
 
 void Sampler::renderAudio(const Engine::RenderContext& ctx) {
+  drainParamTargets();
 #if SEEDBOX_HW
-  (void)ctx;
+  // The Teensy graph owns the samples, so glides land on the mixer and tilt
+  // filter once per block instead of per sample.
+  const auto frames = static_cast<std::uint32_t>(ctx.frames);
+  const float secondsPerSample = rates_.secondsPerSample();
+  for (uint8_t i = 0; i < kMaxVoices; ++i) {
+    VoiceInternal& voice = voices_[i];
+    if (!voice.active) {
+      continue;
+    }
+    // Once per block is plenty for the steal policy's level estimate.
+    if (renderSample_ >= voice.startSample) {
+      const float t = static_cast<float>(renderSample_ - voice.startSample) * secondsPerSample;
+      voice.level = envelopeOneShot(t, voice.envA, voice.envD, voice.envS, voice.envR);
+    }
+    if (!voice.ramping) {
+      continue;
+    }
+    stepRamps(voice, frames);
+    voiceMixerLeft_.gain(i, voice.leftGain);
+    voiceMixerRight_.gain(i, voice.rightGain);
+    hwVoices_[i].toneFilter.frequency(tiltHzFromTone(voice.tone));
+  }
+  renderSample_ += ctx.frames;
   return;
 #else
   if (!ctx.left || !ctx.right || ctx.frames == 0) {
     return;
   }
 
-  const float sr = sampleRateOrFallback(sampleRate_);
   for (std::size_t i = 0; i < ctx.frames; ++i) {
     const std::uint64_t sampleIndex = renderSample_ + static_cast<std::uint64_t>(i);
     float leftMix = 0.0f;
@@ -160,36 +290,73 @@ void Sampler::renderAudio(const Engine::RenderContext& ctx) {
         continue;
       }
 
-      if (sampleIndex < voice.startSample) {
-        continue;
-      }
-
-      const float t = static_cast<float>(sampleIndex - voice.startSample) / sr;
-      const float amplitude =
-          envelopeOneShot(t, voice.envA, voice.envD, voice.envS, voice.envR);
-      const float lifespan = totalOneShotSeconds(voice.envA, voice.envD, voice.envR);
-      if (amplitude <= 0.0f) {
-        if (t >= lifespan) {
-          voice.active = false;
-        }
-        continue;
+      // Glides run on the audio clock even before the voice launches, so a
+      // target always takes its smoothing time from when it was picked up.
+      if (voice.ramping) {
+        stepRamps(voice, 1);
       }
 
-      const float freq = kFallbackBaseHz * voice.playbackRate;
-      const float phase = voice.phaseOffset + kTwoPi * freq * t;
-      const float sample = std::sin(phase) * amplitude * kFallbackVoiceGain;
+      const float sample = renderVoiceSample(voice, sampleIndex);
       leftMix += sample * voice.leftGain;
       rightMix += sample * voice.rightGain;
     }
 
+    // Stolen voices ride out their fade on frozen gains.
+    for (std::size_t t = 0; t < tails_.size(); ++t) {
+      VoiceAllocator::StealFade& fade = tailFades_[t];
+      if (!fade.active()) {
+        continue;
+      }
+      VoiceInternal& tail = tails_[t];
+      const float sample = renderVoiceSample(tail, sampleIndex) * fade.next();
+      leftMix += sample * tail.leftGain;
+      rightMix += sample * tail.rightGain;
+      if (!tail.active) {
+        fade.stop();
+      }
+    }
+
     ctx.left[i] += leftMix;
     ctx.right[i] += rightMix;
   }
 
+  // Tone only steers the Teensy tilt filter.  Here it is just what voice()
+  // reports, so one O(1) skip per block keeps it on the audio clock without a
+  // one-pole step per voice per sample.
+  const auto frames = static_cast<std::uint32_t>(ctx.frames);
+  for (auto& voice : voices_) {
+    if (voice.active && voice.toneRamp.ramping()) {
+      voice.tone = voice.toneRamp.advance(frames);
+      voice.ramping = voice.toneRamp.ramping() || voice.leftGainRamp.ramping() || voice.rightGainRamp.ramping();
+    }
+  }
+
   renderSample_ += ctx.frames;
 #endif
 }
 
+#if !SEEDBOX_HW
+float Sampler::renderVoiceSample(VoiceInternal& voice, std::uint64_t sampleIndex) {
+  if (sampleIndex < voice.startSample) {
+    return 0.0f;
+  }
+
+  const float age = static_cast<float>(sampleIndex - voice.startSample);
+  const float t = age * rates_.secondsPerSample();
+  const float amplitude = envelopeOneShot(t, voice.envA, voice.envD, voice.envS, voice.envR);
+  voice.level = amplitude;
+  if (amplitude <= 0.0f) {
+    if (t >= totalOneShotSeconds(voice.envA, voice.envD, voice.envR)) {
+      voice.active = false;
+    }
+    return 0.0f;
+  }
+
+  const float phase = voice.phaseOffset + voice.phaseStep * age;
+  return std::sin(phase) * amplitude * kFallbackVoiceGain;
+}
+#endif
+
 Engine::StateBuffer Sampler::serializeState() const {
   return {};
 }
@@ -200,6 +367,13 @@ void Sampler::deserializeState(const Engine::StateBuffer& state) {
 
 void Sampler::panic() {
   voices_.fill(VoiceInternal{});
+#if !SEEDBOX_HW
+  tails_.fill(VoiceInternal{});
+  tailFades_.fill(VoiceAllocator::StealFade{});
+#endif
+  util::ParamTarget stale{};
+  while (paramTargets_.pop(stale)) {
+  }
   nextHandle_ = 1;
   renderSample_ = 0;
 
@@ -216,6 +390,17 @@ void Sampler::panic() {
 #endif
 }
 
+#if SEEDBOX_HW
+float Sampler::graphUsagePercent() {
+  float percent = 0.0f;
+  for (HardwareVoice& hw : hwVoices_) {
+    percent += hw.ramPlayer.processorUsage() + hw.sdPlayer.processorUsage() + hw.sourceMixer.processorUsage() +
+               hw.envelope.processorUsage() + hw.toneFilter.processorUsage();
+  }
+  return percent;
+}
+#endif
+
 uint8_t Sampler::activeVoices() const {
   return static_cast<uint8_t>(std::count_if(voices_.begin(), voices_.end(), [](const VoiceInternal& v) {
     return v.active;
@@ -243,35 +428,64 @@ Sampler::VoiceState Sampler::voice(uint8_t index) const {
   state.usesSdStreaming = src.usesSdStreaming;
   state.leftGain = src.leftGain;
   state.rightGain = src.rightGain;
+  state.level = src.level;
   return state;
 }
 
-uint8_t Sampler::allocateVoice(uint32_t whenSamples) {
-  (void)whenSamples;
-  // First pass: look for a free slot. Most of the time we will find one because
-  // the pool is tiny and percussive.
-  for (uint8_t i = 0; i < kMaxVoices; ++i) {
-    if (!voices_[i].active) {
-      return i;
-    }
+uint8_t Sampler::fadingVoices() const {
+#if SEEDBOX_HW
+  return 0;
+#else
+  return static_cast<uint8_t>(std::count_if(tailFades_.begin(), tailFades_.end(), [](const VoiceAllocator::StealFade& f) {
+    return f.active();
+  }));
+#endif
+}
+
+void Sampler::setMaxVoices(uint8_t voices) {
+  maxVoices_ = std::max<uint8_t>(1, std::min<uint8_t>(voices, kMaxVoices));
+  for (uint8_t i = maxVoices_; i < kMaxVoices; ++i) {
+    retireVoice(i);
   }
+}
 
-  // No free slots: steal the oldest voice (FIFO). The `startSample` clock wins;
-  // if two triggers landed at the same sample, the lower handle (older trigger)
-  // gets the boot.
-  uint8_t oldest = 0;
-  uint32_t oldestStart = voices_[0].startSample;
-  uint32_t oldestHandle = voices_[0].handle;
-  for (uint8_t i = 1; i < kMaxVoices; ++i) {
-    if (voices_[i].startSample < oldestStart ||
-        (voices_[i].startSample == oldestStart && voices_[i].handle < oldestHandle)) {
-      oldest = i;
-      oldestStart = voices_[i].startSample;
-      oldestHandle = voices_[i].handle;
-    }
+void Sampler::retireVoice(uint8_t index) {
+  VoiceInternal& voice = voices_[index];
+  if (!voice.active) {
+    return;
+  }
+#if SEEDBOX_HW
+  // Same short ramp a steal gets; configureVoice restores the seed's release
+  // time on the next trigger.
+  hwVoices_[index].envelope.release(VoiceAllocator::kStealFadeMs);
+  hwVoices_[index].envelope.noteOff();
+#else
+  // A voice that has not launched yet has nothing to fade.
+  if (renderSample_ >= voice.startSample) {
+    tails_[index] = voice;
+    tailFades_[index].start(rates_.sampleRate());
   }
+#endif
+  voice.active = false;
+}
 
-  return oldest;
+uint8_t Sampler::allocateVoice(const Seed& seed) {
+  // Free slots win first; most of the time we find one because the pool is
+  // tiny and percussive.  With all four busy the steal policy decides —
+  // kOldest by default: the `startSample` clock wins and, if two triggers
+  // landed at the same sample, the lower handle (older trigger) gets the boot.
+  const VoiceAllocator::Request request{seed.id, VoiceAllocator::priorityFromSeed(seed)};
+  const auto choice = allocator_.allocate(maxVoices_, request, [this](std::size_t i) {
+    const VoiceInternal& v = voices_[i];
+    return VoiceAllocator::Candidate{v.active, v.startSample, v.handle, v.level, v.priority, v.seedId};
+  });
+#if !SEEDBOX_HW
+  if (choice.stolen) {
+    tails_[choice.index] = voices_[choice.index];
+    tailFades_[choice.index].start(rates_.sampleRate());
+  }
+#endif
+  return choice.index;
 }
 
 void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& seed, uint32_t whenSamples) {
@@ -280,7 +494,8 @@ void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& se
   voice.active = true;
   voice.startSample = whenSamples;
   voice.sampleIndex = seed.sampleIdx;
-  voice.playbackRate = pitchToPlaybackRate(seed.pitch);
+  voice.playbackRate = rates_.pitchRatio(seed.pitch);
+  voice.phaseStep = rates_.radiansPerSample(kFallbackBaseHz * voice.playbackRate);
   voice.envA = std::max(0.0f, seed.envA);
   voice.envD = std::max(0.0f, seed.envD);
   voice.envS = clamp01(seed.envS);
@@ -289,6 +504,10 @@ void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& se
   voice.spread = clamp01(seed.spread);
   voice.usesSdStreaming = (seed.sampleIdx >= kRamPreloadCount);
   voice.phaseOffset = phaseFromPrng(seed.prng);
+  voice.seedId = seed.id;
+  // A fresh hit counts as full level so quietest-first stealing leaves it be.
+  voice.level = 1.0f;
+  voice.priority = VoiceAllocator::priorityFromSeed(seed);
 
   // Constant-power width law: `spread` 0 => centered, 1 => hard pan. Future
   // versions can feed a polarity flag to swing left; for now we focus on the
@@ -297,6 +516,18 @@ void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& se
   voice.leftGain = gains.left;
   voice.rightGain = gains.right;
 
+  // A fresh trigger starts settled on the seed's values; only targets queued
+  // after this point glide.
+  const float toneMs = smoothingMs_[static_cast<std::size_t>(Param::kTone)];
+  const float spreadMs = smoothingMs_[static_cast<std::size_t>(Param::kSpread)];
+  voice.toneRamp.configure(toneMs, rates_.sampleRate(), util::ParamRamp::Curve::kOnePole);
+  voice.leftGainRamp.configure(spreadMs, rates_.sampleRate());
+  voice.rightGainRamp.configure(spreadMs, rates_.sampleRate());
+  voice.toneRamp.reset(voice.tone);
+  voice.leftGainRamp.reset(voice.leftGain);
+  voice.rightGainRamp.reset(voice.rightGain);
+  voice.ramping = false;
+
 #if SEEDBOX_HW
   auto& hw = hwVoices_[index];
   if (voice.usesSdStreaming) {
@@ -314,10 +545,7 @@ void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& se
   hw.envelope.release(msFromSeconds(voice.envR));
 
   // Map the 0-1 tone knob to a useful musical range.
-  const float minTiltHz = 400.0f;
-  const float maxTiltHz = 8000.0f;
-  const float freq = minTiltHz + (maxTiltHz - minTiltHz) * voice.tone;
-  hw.toneFilter.frequency(freq);
+  hw.toneFilter.frequency(tiltHzFromTone(voice.tone));
   hw.toneFilter.resonance(0.707f);
 
   // Stereo gains feed into a pair of mixers that eventually land on I²S out.
@@ -333,10 +561,6 @@ void Sampler::configureVoice(VoiceInternal& voice, uint8_t index, const Seed& se
 #endif
 }
 
-float Sampler::pitchToPlaybackRate(float semitones) {
-  return std::pow(2.0f, semitones / 12.0f);
-}
-
 float Sampler::clamp01(float value) {
   return std::max(0.0f, std::min(1.0f, value));
 }
@@ -358,7 +582,7 @@ const Seed* Sampler::lastSeed(uint32_t id) const {
 }
 
 void Sampler::trigger(const Seed& seed, uint32_t whenSamples) {
-  const uint8_t voiceIndex = allocateVoice(whenSamples);
+  const uint8_t voiceIndex = allocateVoice(seed);
   VoiceInternal& voiceSlot = voices_[voiceIndex];
 
   // Increment the deterministic handle. Wrap around safely (0 is reserved so we
@@ -7,7 +7,10 @@
 #include "HardwarePrelude.h"
 #endif
 #include "engine/Engine.h"
+#include "engine/RateCache.h"
+#include "engine/VoiceAllocator.h"
 #include "util/Annotations.h"
+#include "util/ParamRamp.h"
 
 // Sampler owns a deterministic voice pool shared between hardware and the
 // native simulator. The intent: **any seed rendered in rehearsal behaves the
@@ -26,6 +29,16 @@ class Sampler : public Engine {
 public:
   static constexpr uint8_t kMaxVoices = 4;
 
+  // Continuous seed params that glide on voices already sounding.  A
+  // ParamChange carries the new value as Q16 (kParamUnity == 1.0f).
+  enum class Param : std::uint16_t {
+    kTone = 0,
+    kSpread,
+    kCount,
+  };
+  static constexpr std::int32_t kParamUnity = 1 << 16;
+  static constexpr float kDefaultSmoothingMs = 20.0f;
+
   struct VoiceState {
     // Is the slot currently reserved by a voice? Determined by sampler logic,
     // not the downstream audio nodes.
@@ -59,6 +72,9 @@ public:
     // Calculated via constant-power panning so center position stays loud.
     float leftGain{0.0f};
     float rightGain{0.0f};
+    // Envelope level as of the last rendered sample (1.0 until the voice
+    // starts).  The kQuietest steal policy reads this.
+    float level{0.0f};
   };
 
   // Reset the voice pool and (on hardware) spin up the Teensy Audio graph.
@@ -81,6 +97,37 @@ public:
   void deserializeState(const Engine::StateBuffer& state) override;
   void panic() override;
 
+  // Any thread.  Queue a glide for every voice `seedId` currently owns; the
+  // render loop drains the queue at the top of the next block and ramps the
+  // value per sample.  New triggers still bake the seed's value directly.
+  // Returns false when the queue is full (the target is dropped).
+  bool queueParamTarget(uint32_t seedId, Param param, float value);
+  // Glide time per parameter (0 ms == jump at the next sample).  Control
+  // thread; takes effect on the next target each voice picks up.
+  void setParamSmoothingMs(Param param, float ms);
+  float paramSmoothingMs(Param param) const;
+  // How many voices still have a glide in flight.
+  uint8_t rampingVoices() const;
+
+  // Which voice loses its slot when all four are busy.  Defaults to
+  // StealPolicy::kOldest; see VoiceAllocator.h for the others.
+  void setStealPolicy(StealPolicy policy) { allocator_.setPolicy(policy); }
+  StealPolicy stealPolicy() const { return allocator_.policy(); }
+  const VoiceAllocator::Counters& stealCounters() const { return allocator_.counters(); }
+  // Stolen voices still fading out underneath their replacements.
+  uint8_t fadingVoices() const;
+  // Voice ceiling, 1..kMaxVoices (default all four).  The block-time governor
+  // lowers it under load; voices above a lowered ceiling fade out like a
+  // steal instead of cutting.
+  void setMaxVoices(uint8_t voices);
+  uint8_t maxVoices() const { return maxVoices_; }
+#if SEEDBOX_HW
+  // What this engine's per-voice library nodes cost in their last update, in
+  // percent of one block (AudioStream::processorUsage() summed).  They render
+  // outside renderAudio(), so the voice governor reads this instead.
+  float graphUsagePercent();
+#endif
+
   // Count how many voices are flagged active. Handy for UI + tests.
   uint8_t activeVoices() const;
   // Introspect a specific voice slot. Out-of-range requests return a default
@@ -109,22 +156,56 @@ private:
     // Deterministic phase offset for the fallback oscillator. We stash it here
     // so software rendering can be repeatable without lugging in RNG state.
     float phaseOffset{0.0f};
+    // Radians per sample of the fallback oscillator, baked at trigger time.
+    float phaseStep{0.0f};
+    // Owner seed, so queued param targets can find the voices they steer.
+    uint32_t seedId{0};
+    // Steal bookkeeping: last rendered envelope level and the seed's priority.
+    float level{0.0f};
+    uint8_t priority{0};
+    // Per-sample glides for params that move while the voice sounds.  The
+    // render loop only touches them while `ramping` is set.
+    util::ParamRamp toneRamp{};
+    util::ParamRamp leftGainRamp{};
+    util::ParamRamp rightGainRamp{};
+    bool ramping{false};
   };
 
   // Voice bookkeeping helpers.  `allocateVoice` picks a slot, `configureVoice`
   // bakes the seed genome into it, and the static math helpers keep the float
   // conversions centralized.
-  uint8_t allocateVoice(uint32_t whenSamples);
+  uint8_t allocateVoice(const Seed& seed);
+  // Release slot `index` with the steal fade (ceiling dropped under it).
+  void retireVoice(uint8_t index);
   void configureVoice(VoiceInternal& voice, uint8_t index, const Seed& seed, uint32_t whenSamples);
-  static float pitchToPlaybackRate(float semitones);
+  void drainParamTargets();
+  void applyParamTarget(VoiceInternal& voice, const util::ParamTarget& target);
+  // Step every ramp on `voice` by `samples` (1 in the per-sample loop).
+  void stepRamps(VoiceInternal& voice, std::uint32_t samples);
+#if !SEEDBOX_HW
+  // One mono sample of `voice` at `sampleIndex`; updates its level and
+  // retires it once the envelope has run out.
+  float renderVoiceSample(VoiceInternal& voice, std::uint64_t sampleIndex);
+#endif
   static float clamp01(float value);
 
 private:
   std::array<VoiceInternal, kMaxVoices> voices_{};
+  uint8_t maxVoices_{kMaxVoices};
   uint32_t nextHandle_{1};
   std::vector<Seed> seedCache_{};
-  float sampleRate_{48000.0f};
+  RateCache rates_{};
   std::uint64_t renderSample_{0};
+  util::ParamTargetQueue<> paramTargets_{};
+  std::array<float, static_cast<std::size_t>(Param::kCount)> smoothingMs_{kDefaultSmoothingMs, kDefaultSmoothingMs};
+  VoiceAllocator allocator_{};
+#if !SEEDBOX_HW
+  // A stolen voice keeps playing here for VoiceAllocator::kStealFadeMs while
+  // its slot starts the new one.  The Teensy envelope does this itself
+  // (releaseNoteOn), so hardware builds skip the copies.
+  std::array<VoiceInternal, kMaxVoices> tails_{};
+  std::array<VoiceAllocator::StealFade, kMaxVoices> tailFades_{};
+#endif
 
 #if SEEDBOX_HW
   struct HardwareVoice {
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "Seed.h"
+
+//
+// VoiceAllocator
+// --------------
+// Every engine with a voice pool answers the same question on each trigger:
+// "which slot does this new voice get?"  Until now each one answered it with
+// its own copy of the oldest-start-wins loop.  That rule is easy to explain
+// but in a dense pattern it kills a loud hit that landed a moment ago while a
+// near-silent release tail from two bars back keeps its slot.
+//
+// This class keeps the choice in one place and makes it a knob:
+// - kOldest: earliest `startSample` loses, lowest handle breaks ties.  The
+//   historical rule and still the default, so nothing changes until an engine
+//   opts in.
+// - kQuietest: the slot whose tracked envelope level is lowest loses.  Fresh
+//   triggers report full level, so brand-new hits are the last to go.
+// - kLowestPriority: the seed with the lowest priority loses (see
+//   `priorityFromSeed`), quietest first inside a priority, then oldest.
+// - kSameSeedRetrigger: a seed that already owns a voice reuses it, even when
+//   other slots are free — a choke group per seed, like an open hat closing.
+//   Seeds without a voice fall back to kOldest.
+//
+// The engine describes its slots through a small callback, so the allocator
+// never copies a voice pool or knows its layout.  Selection is one pass over
+// the pool (at most 40 slots for granular), with no heap and no sorting.
+//
+// A stolen slot is still sounding, and cutting it dead clicks.  `Choice`
+// flags the steal so the engine can move the old voice into a short tail and
+// ride it down with a `StealFade` while the new voice starts in its place.
+enum class StealPolicy : std::uint8_t {
+  kOldest = 0,
+  kQuietest,
+  kLowestPriority,
+  kSameSeedRetrigger,
+};
+
+class VoiceAllocator {
+public:
+  // Long enough to hide the step, short enough that two voices overlapping
+  // for a moment never reads as a flam.
+  static constexpr float kStealFadeMs = 3.0f;
+
+  // What the allocator needs to know about one slot.
+  struct Candidate {
+    bool active{false};
+    std::uint64_t startSample{0};
+    std::uint32_t handle{0};
+    // Current envelope level, 0..1-ish.  Engines without an envelope report a
+    // constant and kQuietest degrades to kOldest.
+    float level{0.0f};
+    std::uint8_t priority{0};
+    std::uint32_t seedId{0};
+  };
+
+  struct Request {
+    std::uint32_t seedId{0};
+    std::uint8_t priority{0};
+  };
+
+  struct Choice {
+    std::uint8_t index{0};
+    // The slot held a live voice: fade it out instead of cutting it.
+    bool stolen{false};
+    // ...and that voice belonged to the requesting seed.
+    bool retrigger{false};
+  };
+
+  // Running totals for stats pages and tests.  `steals` excludes same-seed
+  // retriggers, which are counted on their own.
+  struct Counters {
+    std::uint32_t allocations{0};
+    std::uint32_t steals{0};
+    std::uint32_t retriggers{0};
+    // Envelope level of the most recent victim; a high number here means the
+    // policy is killing audible voices.
+    float lastStolenLevel{0.0f};
+  };
+
+  // Linear ramp from 1 to 0 over kStealFadeMs.  One per tail voice.
+  struct StealFade {
+    std::uint32_t remaining{0};
+    float gain{0.0f};
+    float step{0.0f};
+
+    void start(float sampleRate) {
+      const float sr = sampleRate > 0.0f ? sampleRate : 48000.0f;
+      remaining = std::max<std::uint32_t>(1u, static_cast<std::uint32_t>(sr * kStealFadeMs * 0.001f));
+      gain = 1.0f;
+      step = 1.0f / static_cast<float>(remaining);
+    }
+    bool active() const { return remaining > 0; }
+    // Gain for the next sample; reaches zero on the last one.
+    float next() {
+      if (remaining == 0) {
+        return 0.0f;
+      }
+      --remaining;
+      gain = std::max(0.0f, gain - step);
+      return gain;
+    }
+    void stop() { remaining = 0; gain = 0.0f; }
+  };
+
+  // Seeds the scheduler is less sure about (low `probability`) are the
+  // ornaments in a pattern, so they are the first to give up a slot.
+  static std::uint8_t priorityFromSeed(const Seed& seed) {
+    const float p = std::clamp(seed.probability, 0.0f, 1.0f);
+    return static_cast<std::uint8_t>(p * 255.0f + 0.5f);
+  }
+
+  void setPolicy(StealPolicy policy) { policy_ = policy; }
+  StealPolicy policy() const { return policy_; }
+  const Counters& counters() const { return counters_; }
+  void resetCounters() { counters_ = Counters{}; }
+
+  // Pick a slot in [0, poolSize).  `describe(i)` returns the Candidate for
+  // slot i.  A zero-sized pool returns slot 0 so callers never index out of
+  // range; engines guard that case before calling.
+  template <typename Describe>
+  Choice allocate(std::size_t poolSize, const Request& request, Describe&& describe) {
+    ++counters_.allocations;
+    Choice choice{};
+    int freeSlot = -1;
+    int sameSeed = -1;
+    int victim = -1;
+    Candidate sameBest{};
+    Candidate victimBest{};
+    for (std::size_t i = 0; i < poolSize; ++i) {
+      const Candidate c = describe(i);
+      if (!c.active) {
+        if (freeSlot < 0) {
+          freeSlot = static_cast<int>(i);
+        }
+        continue;
+      }
+      if (policy_ == StealPolicy::kSameSeedRetrigger && c.seedId == request.seedId &&
+          (sameSeed < 0 || older(c, sameBest))) {
+        sameSeed = static_cast<int>(i);
+        sameBest = c;
+      }
+      if (victim < 0 || betterVictim(c, victimBest)) {
+        victim = static_cast<int>(i);
+        victimBest = c;
+      }
+    }
+
+    if (sameSeed >= 0) {
+      choice.index = static_cast<std::uint8_t>(sameSeed);
+      choice.stolen = true;
+      choice.retrigger = true;
+      ++counters_.retriggers;
+      counters_.lastStolenLevel = sameBest.level;
+      return choice;
+    }
+    if (freeSlot >= 0) {
+      choice.index = static_cast<std::uint8_t>(freeSlot);
+      return choice;
+    }
+    if (victim >= 0) {
+      choice.index = static_cast<std::uint8_t>(victim);
+      choice.stolen = true;
+      ++counters_.steals;
+      counters_.lastStolenLevel = victimBest.level;
+    }
+    return choice;
+  }
+
+private:
+  static bool older(const Candidate& a, const Candidate& b) {
+    return a.startSample < b.startSample || (a.startSample == b.startSample && a.handle < b.handle);
+  }
+
+  // Is `a` a better slot to steal than `b` under the current policy?
+  bool betterVictim(const Candidate& a, const Candidate& b) const {
+    switch (policy_) {
+      case StealPolicy::kQuietest:
+        if (a.level != b.level) {
+          return a.level < b.level;
+        }
+        return older(a, b);
+      case StealPolicy::kLowestPriority:
+        if (a.priority != b.priority) {
+          return a.priority < b.priority;
+        }
+        if (a.level != b.level) {
+          return a.level < b.level;
+        }
+        return older(a, b);
+      case StealPolicy::kOldest:
+      case StealPolicy::kSameSeedRetrigger:
+      default:
+        return older(a, b);
+    }
+  }
+
+  StealPolicy policy_{StealPolicy::kOldest};
+  Counters counters_{};
+};
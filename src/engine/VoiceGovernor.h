@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//
+// VoiceGovernor
+// -------------
+// Voice ceilings used to be picked once at boot: 32 granular voices on the
+// Teensy, 12 in the sim, four sampler slots, and so on.  Those numbers are a
+// guess about how much DSP fits in one block, and the guess is wrong in both
+// directions.  A dense live-grain cloud can blow the deadline, and a sparse
+// patch leaves most of the block idle.
+//
+// The governor turns the guess into a feedback loop.  Once per block AppState
+// hands it two things: how long the block took to render, and how long
+// each engine took.  It divides the render time by the block deadline
+// (frames / sample rate) to get a load figure and smooths it with a one-pole
+// filter.  Then it nudges the per-engine ceilings:
+// - A block that misses its deadline sheds a quarter of the costliest
+//   engine's voices on the spot.  This is the fast attack.
+// - A smoothed load above `shedLoad` sheds one voice, then waits
+//   `shedHoldBlocks` to see the effect before shedding another.
+// - A smoothed load below `growLoad` for `growHoldBlocks` in a row gives one
+//   voice back, cheapest engine first.  This is the slow release.
+// - Anything in between holds still.  The gap between the two thresholds is
+//   the hysteresis that stops the ceiling from hunting every block.
+//
+// Each lane (one per engine id) moves between a `floor` the patch cannot
+// live without and a `ceiling` its pool can hold.  Engines retire voices
+// above a lowered ceiling with the same short fade they use for steals, so
+// shedding sounds like a few tails ending early, not a dropout.
+//
+// The governor only counts and compares.  It has no clock, allocations or
+// engine pointers, so tests can drive it with made-up timings.
+class VoiceGovernor {
+public:
+  // Indexed by EngineRouter engine id: sampler, granular, resonator, euclid,
+  // burst.  Lanes that are never configured (euclid has no pool) stay put.
+  static constexpr std::size_t kLanes = 5;
+  using LaneNanos = std::array<std::uint32_t, kLanes>;
+
+  struct Config {
+    // Smoothed load (render time / deadline) that starts shedding voices.
+    float shedLoad{0.85f};
+    // Smoothed load that, held for `growHoldBlocks`, gives one voice back.
+    float growLoad{0.60f};
+    std::uint32_t growHoldBlocks{64};
+    // Blocks to wait after a shed before judging whether it helped.
+    std::uint32_t shedHoldBlocks{4};
+    // One-pole smoothing per block; 1/8 settles in roughly 20 blocks.
+    float smoothing{0.125f};
+  };
+
+  struct Lane {
+    std::uint8_t floor{0};
+    std::uint8_t ceiling{0};
+    std::uint8_t limit{0};
+    // Where `limit` started, so switching the governor off can put it back.
+    std::uint8_t nominal{0};
+    // Smoothed render time of this engine, in nanoseconds per block.
+    float costNanos{0.0f};
+  };
+
+  struct Stats {
+    std::uint64_t blocks{0};
+    std::uint64_t deadlineMisses{0};
+    std::uint32_t sheds{0};
+    std::uint32_t grows{0};
+    // Smoothed and worst load seen; 1.0 means the block used its whole budget.
+    float load{0.0f};
+    float peakLoad{0.0f};
+  };
+
+  void setConfig(const Config& config) { config_ = config; }
+  const Config& config() const { return config_; }
+
+  // Let `lane` move between `floor` and `ceiling`, starting at `limit`.
+  // Passing the same value for all three pins the lane.
+  void configureLane(std::size_t lane, std::uint8_t floor, std::uint8_t limit, std::uint8_t ceiling) {
+    if (lane >= kLanes) {
+      return;
+    }
+    Lane& l = lanes_[lane];
+    l.floor = std::min(floor, ceiling);
+    l.ceiling = ceiling;
+    l.limit = std::clamp(limit, l.floor, l.ceiling);
+    l.nominal = l.limit;
+    l.costNanos = 0.0f;
+  }
+
+  // Forget the load history; the limits stay where they are.
+  void reset() {
+    stats_ = Stats{};
+    calmBlocks_ = 0;
+    holdBlocks_ = 0;
+    for (auto& lane : lanes_) {
+      lane.costNanos = 0.0f;
+    }
+  }
+
+  std::uint8_t limit(std::size_t lane) const { return lane < kLanes ? lanes_[lane].limit : 0; }
+  const Lane& lane(std::size_t lane) const { return lanes_[std::min(lane, kLanes - 1)]; }
+  const Stats& stats() const { return stats_; }
+
+  // Audio thread, once per block.  Returns true when a limit moved so the
+  // caller knows to push the new ceilings into the engines.
+  bool noteBlock(std::uint32_t renderNanos, std::uint32_t budgetNanos, const LaneNanos& laneNanos) {
+    if (budgetNanos == 0) {
+      return false;
+    }
+    const float load = static_cast<float>(renderNanos) / static_cast<float>(budgetNanos);
+    const float a = std::clamp(config_.smoothing, 0.0f, 1.0f);
+    stats_.load = (stats_.blocks == 0) ? load : stats_.load + a * (load - stats_.load);
+    stats_.peakLoad = std::max(stats_.peakLoad, load);
+    ++stats_.blocks;
+    for (std::size_t i = 0; i < kLanes; ++i) {
+      lanes_[i].costNanos += a * (static_cast<float>(laneNanos[i]) - lanes_[i].costNanos);
+    }
+    if (holdBlocks_ > 0) {
+      --holdBlocks_;
+    }
+
+    if (load > 1.0f) {
+      ++stats_.deadlineMisses;
+      calmBlocks_ = 0;
+      return shed(true);
+    }
+    if (stats_.load > config_.shedLoad) {
+      calmBlocks_ = 0;
+      return holdBlocks_ == 0 && shed(false);
+    }
+    if (stats_.load < config_.growLoad) {
+      if (++calmBlocks_ >= config_.growHoldBlocks) {
+        calmBlocks_ = 0;
+        return grow();
+      }
+      return false;
+    }
+    calmBlocks_ = 0;
+    return false;
+  }
+
+private:
+  // Take voices from the engine eating the most time.  A missed deadline
+  // takes a quarter of its voices, an overloaded trend takes one.
+  bool shed(bool missed) {
+    int victim = -1;
+    for (std::size_t i = 0; i < kLanes; ++i) {
+      const Lane& l = lanes_[i];
+      if (l.limit > l.floor && (victim < 0 || l.costNanos > lanes_[static_cast<std::size_t>(victim)].costNanos)) {
+        victim = static_cast<int>(i);
+      }
+    }
+    if (victim < 0) {
+      return false;
+    }
+    Lane& l = lanes_[static_cast<std::size_t>(victim)];
+    const std::uint8_t step = missed ? static_cast<std::uint8_t>(std::max(1, l.limit / 4)) : std::uint8_t{1};
+    l.limit = static_cast<std::uint8_t>(std::max<int>(l.floor, l.limit - step));
+    ++stats_.sheds;
+    holdBlocks_ = config_.shedHoldBlocks;
+    return true;
+  }
+
+  // Give one voice back to the cheapest engine that is below its ceiling.
+  bool grow() {
+    int pick = -1;
+    for (std::size_t i = 0; i < kLanes; ++i) {
+      const Lane& l = lanes_[i];
+      if (l.limit < l.ceiling && (pick < 0 || l.costNanos < lanes_[static_cast<std::size_t>(pick)].costNanos)) {
+        pick = static_cast<int>(i);
+      }
+    }
+    if (pick < 0) {
+      return false;
+    }
+    ++lanes_[static_cast<std::size_t>(pick)].limit;
+    ++stats_.grows;
+    return true;
+  }
+
+  Config config_{};
+  std::array<Lane, kLanes> lanes_{};
+  Stats stats_{};
+  std::uint32_t calmBlocks_{0};
+  std::uint32_t holdBlocks_{0};
+};
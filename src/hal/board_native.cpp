@@ -5,9 +5,12 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstdlib>
 #include <deque>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <optional>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -46,13 +49,159 @@ constexpr std::array<std::pair<const char*, Board::EncoderID>, 4> kEncoderLookup
     {"fx", Board::EncoderID::FxMutate},
 }};
 
-std::string toLower(std::string_view in) {
-  // Micro helper: normalise tokens from the script parser.  Everything below
-  // expects lowercase strings so students can type "Tap" or "tap" without
-  // tripping over case sensitivity.  We keep it tiny on purpose so folks can
-  // single-step through it in a debugger and see `std::transform` in action.
-  std::string out(in);
-  std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+// Script parsing is shared by feed() and compileNativeScript().  Lines are
+// split into at most four whitespace-separated views; no streams, no per-token
+// allocations, so a soak script with tens of thousands of lines compiles in a
+// blink.
+struct ScriptLine {
+  enum class Kind { Empty, Wait, At, Button, Encoder, Repeat, End, Invalid } kind{Kind::Empty};
+  std::uint64_t micros{0};
+  Board::ButtonID button{Board::ButtonID::TapTempo};
+  bool pressed{false};
+  Board::EncoderID encoder{Board::EncoderID::SeedBank};
+  int32_t delta{0};
+  std::uint64_t count{0};
+};
+
+bool iequals(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t splitTokens(std::string_view line, std::array<std::string_view, 4>& tokens) {
+  std::size_t count = 0;
+  std::size_t pos = 0;
+  while (pos < line.size() && count < tokens.size()) {
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) {
+      ++pos;
+    }
+    const std::size_t begin = pos;
+    while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos]))) {
+      ++pos;
+    }
+    if (pos > begin) {
+      tokens[count++] = line.substr(begin, pos - begin);
+    }
+  }
+  return count;
+}
+
+// Parses a leading number and hands back whatever trails it ("10ms" -> 10,
+// "ms").  strtod wants a terminated string, so copy into a small stack buffer.
+bool parseNumber(std::string_view token, double& value, std::string_view& rest) {
+  char buffer[32];
+  const std::size_t len = std::min(token.size(), sizeof(buffer) - 1);
+  std::copy(token.begin(), token.begin() + static_cast<std::ptrdiff_t>(len), buffer);
+  buffer[len] = '\0';
+  char* end = nullptr;
+  value = std::strtod(buffer, &end);
+  if (end == buffer) {
+    return false;
+  }
+  rest = token.substr(static_cast<std::size_t>(end - buffer));
+  return true;
+}
+
+bool parseDuration(std::string_view number, std::string_view unitToken, std::uint64_t& micros) {
+  double value = 0.0;
+  std::string_view unit;
+  if (!parseNumber(number, value, unit) || value < 0.0) {
+    return false;
+  }
+  if (unit.empty()) {
+    unit = unitToken;
+  }
+  double scale = 1000.0;  // bare numbers are milliseconds, as they always were
+  if (unit.empty() || iequals(unit, "ms") || iequals(unit, "millis") || iequals(unit, "milliseconds")) {
+    scale = 1000.0;
+  } else if (iequals(unit, "us") || iequals(unit, "micros") || iequals(unit, "microseconds")) {
+    scale = 1.0;
+  } else if (iequals(unit, "s") || iequals(unit, "sec") || iequals(unit, "seconds")) {
+    scale = 1.0e6;
+  } else if (iequals(unit, "min") || iequals(unit, "minutes")) {
+    scale = 60.0e6;
+  } else if (iequals(unit, "h") || iequals(unit, "hours")) {
+    scale = 3600.0e6;
+  } else {
+    return false;
+  }
+  micros = static_cast<std::uint64_t>(value * scale);
+  return true;
+}
+
+template <typename Id, std::size_t N>
+std::optional<Id> lookup(const std::array<std::pair<const char*, Id>, N>& table, std::string_view token) {
+  // Map human-friendly nicknames to the canonical enum.  Returning
+  // std::nullopt instead of throwing keeps the flow approachable for labs and
+  // lets students experiment with failure cases without crashing.
+  for (const auto& entry : table) {
+    if (iequals(token, entry.first)) {
+      return entry.second;
+    }
+  }
+  return std::nullopt;
+}
+
+ScriptLine parseScriptLine(std::string_view line) {
+  ScriptLine out{};
+  const std::size_t hash = line.find('#');
+  if (hash != std::string_view::npos) {
+    line = line.substr(0, hash);
+  }
+  std::array<std::string_view, 4> tokens{};
+  const std::size_t count = splitTokens(line, tokens);
+  if (count == 0) {
+    return out;
+  }
+  out.kind = ScriptLine::Kind::Invalid;
+  const std::string_view command = tokens[0];
+  if (iequals(command, "wait") || iequals(command, "sleep") || iequals(command, "at")) {
+    if (count >= 2 && parseDuration(tokens[1], count >= 3 ? tokens[2] : std::string_view{}, out.micros)) {
+      out.kind = iequals(command, "at") ? ScriptLine::Kind::At : ScriptLine::Kind::Wait;
+    }
+    return out;
+  }
+  if (iequals(command, "btn") || iequals(command, "button")) {
+    if (count >= 3) {
+      if (auto id = lookup(kButtonLookup, tokens[1])) {
+        out.kind = ScriptLine::Kind::Button;
+        out.button = *id;
+        out.pressed = iequals(tokens[2], "down") || iequals(tokens[2], "press") || iequals(tokens[2], "on");
+      }
+    }
+    return out;
+  }
+  if (iequals(command, "enc") || iequals(command, "encoder")) {
+    if (count >= 2) {
+      if (auto id = lookup(kEncoderLookup, tokens[1])) {
+        double delta = 0.0;
+        std::string_view rest;
+        out.kind = ScriptLine::Kind::Encoder;
+        out.encoder = *id;
+        out.delta = (count >= 3 && parseNumber(tokens[2], delta, rest)) ? static_cast<int32_t>(delta) : 0;
+      }
+    }
+    return out;
+  }
+  if (iequals(command, "repeat")) {
+    double times = 0.0;
+    std::string_view rest;
+    if (count >= 2 && parseNumber(tokens[1], times, rest) && rest.empty() && times >= 1.0) {
+      out.kind = ScriptLine::Kind::Repeat;
+      out.count = static_cast<std::uint64_t>(times);
+    }
+    return out;
+  }
+  if (iequals(command, "end")) {
+    out.kind = ScriptLine::Kind::End;
+  }
   return out;
 }
 
@@ -64,13 +213,21 @@ public:
     // possible.  This mirrors the "tight loop" vibe of embedded firmware
     // without forcing the host CPU to sleep.  If you want to explain game loop
     // patterns to students, this is an approachable anchor point.
-    now_us_ += poll_period_us_;
-    now_ms_ = static_cast<std::uint32_t>(now_us_ / 1000u);
+    // Once a runner drives the clock through advanceTo(), poll() only applies
+    // what is due; time moves when the runner says so.
+    if (!clock_driven_) {
+      now_us_ += poll_period_us_;
+      now_ms_ = static_cast<std::uint32_t>(now_us_ / 1000u);
+    }
 
     // Dev-note for the lab: each poll step nibbles through the scripted queue
     // until a `wait` tells us to pause.  That keeps simulated time moving at
     // the same cadence as the hardware board class.
     processScript();
+    applyTimeline();
+    // AppState reads the buttons right after poll(), so every edge applied so
+    // far has now been seen and the next one for that button may land.
+    unsampled_edges_ = 0;
   }
 
   ButtonSample sampleButton(ButtonID id) const override {
@@ -114,6 +271,11 @@ public:
     // tests hermetic and mirrors the "pull the USB cable" ritual students know
     // from real hardware.
     script_.clear();
+    timeline_.clear();
+    timeline_cursor_ = 0;
+    timeline_base_us_ = 0;
+    clock_driven_ = false;
+    unsampled_edges_ = 0;
     std::fill(button_samples_.begin(), button_samples_.end(), ButtonSample{});
     std::fill(encoder_deltas_.begin(), encoder_deltas_.end(), 0);
     now_us_ = 0;
@@ -125,72 +287,53 @@ public:
   // binary blobs.
   void feed(std::string_view line) {
     // Entry point for scripted input.  Each line is a mini DSL command like
-    // "wait 10ms" or "btn seed down".  By keeping the parser here and
-    // readable we can show new firmware folks how to translate human-friendly
-    // text into structured events without needing a full parser generator.
-    auto trimmed = trim(line);
-    if (trimmed.empty() || trimmed.front() == '#') {
-      return;
-    }
-    std::istringstream stream{std::string(trimmed)};
-    std::string command;
-    stream >> command;
-    command = toLower(command);
-    if (command == "wait" || command == "sleep") {
-      double value = 0.0;
-      std::string unit;
-      stream >> value >> unit;
-      if (unit.empty()) {
-        unit = "ms";
-      }
-      unit = toLower(unit);
-      std::uint64_t duration = 0;
-      if (unit == "ms" || unit == "millis" || unit == "milliseconds") {
-        duration = static_cast<std::uint64_t>(value * 1000.0);
-      } else {
-        duration = static_cast<std::uint64_t>(value);
-      }
-      ScriptEvent evt;
-      evt.type = ScriptEvent::Type::Wait;
-      evt.duration_us = duration;
-      script_.push_back(evt);
-      return;
+    // "wait 10ms" or "btn seed down".  parseScriptLine() does the heavy
+    // lifting; here we only translate the result into the poll-stepped queue.
+    // Lines the queue cannot express (`at`, `repeat`) and typos are ignored,
+    // exactly as unknown commands always were.
+    const ScriptLine parsed = parseScriptLine(line);
+    ScriptEvent evt;
+    switch (parsed.kind) {
+      case ScriptLine::Kind::Wait:
+        evt.type = ScriptEvent::Type::Wait;
+        evt.duration_us = parsed.micros;
+        break;
+      case ScriptLine::Kind::Button:
+        evt.type = ScriptEvent::Type::Button;
+        evt.button = parsed.button;
+        evt.pressed = parsed.pressed;
+        break;
+      case ScriptLine::Kind::Encoder:
+        evt.type = ScriptEvent::Type::Encoder;
+        evt.encoder = parsed.encoder;
+        evt.encoder_delta = parsed.delta;
+        break;
+      default:
+        return;
     }
+    script_.push_back(evt);
+  }
 
-    if (command == "btn" || command == "button") {
-      std::string idToken;
-      std::string stateToken;
-      stream >> idToken >> stateToken;
-      if (idToken.empty() || stateToken.empty()) {
-        return;
-      }
-      if (auto optId = parseButton(idToken)) {
-        const bool pressed = (toLower(stateToken) == "down" || toLower(stateToken) == "press" || toLower(stateToken) == "on");
-        ScriptEvent evt;
-        evt.type = ScriptEvent::Type::Button;
-        evt.button = *optId;
-        evt.pressed = pressed;
-        script_.push_back(evt);
-      }
-      return;
+  void load(const NativeScript& script) {
+    timeline_ = script.events;
+    timeline_cursor_ = 0;
+    timeline_base_us_ = now_us_;
+  }
+
+  std::uint64_t nextEventMicros() const {
+    if (timeline_cursor_ >= timeline_.size()) {
+      return std::numeric_limits<std::uint64_t>::max();
     }
+    return timeline_base_us_ + timeline_[timeline_cursor_].at_us;
+  }
 
-    if (command == "enc" || command == "encoder") {
-      std::string idToken;
-      int delta = 0;
-      stream >> idToken >> delta;
-      if (idToken.empty()) {
-        return;
-      }
-      if (auto optId = parseEncoder(idToken)) {
-        ScriptEvent evt;
-        evt.type = ScriptEvent::Type::Encoder;
-        evt.encoder = *optId;
-        evt.encoder_delta = delta;
-        script_.push_back(evt);
-      }
-      return;
+  void advanceTo(std::uint64_t micros) {
+    clock_driven_ = true;
+    if (micros > now_us_) {
+      now_us_ = micros;
+      now_ms_ = static_cast<std::uint32_t>(now_us_ / 1000u);
     }
+    applyTimeline();
   }
 
   // Unit tests sometimes need to jump the simulated clock ahead without
@@ -217,44 +360,6 @@ public:
   }
 
 private:
-  static std::string_view trim(std::string_view text) {
-    // Trim leading and trailing whitespace for the script parser.  Written in
-    // plain C++17 so it is a friendly demo of string_view mutation.
-    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
-      text.remove_prefix(1);
-    }
-    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
-      text.remove_suffix(1);
-    }
-    return text;
-  }
-
-  static std::optional<Board::ButtonID> parseButton(std::string_view token) {
-    // Map human-friendly button nicknames to the canonical enum.  Returning
-    // std::nullopt instead of throwing keeps the flow approachable for labs and
-    // allows students to experiment with failure cases without crashing.
-    const std::string key = toLower(token);
-    for (const auto& entry : kButtonLookup) {
-      if (key == entry.first) {
-        return entry.second;
-      }
-    }
-    return std::nullopt;
-  }
-
-  static std::optional<Board::EncoderID> parseEncoder(std::string_view token) {
-    // Same idea as parseButton but for the four encoders.  Keeping separate
-    // lookup tables makes it obvious how to extend the script language if the
-    // front panel grows more controls.
-    const std::string key = toLower(token);
-    for (const auto& entry : kEncoderLookup) {
-      if (key == entry.first) {
-        return entry.second;
-      }
-    }
-    return std::nullopt;
-  }
-
   void processScript() {
     // Core of the native stack: walk through the queued ScriptEvents and apply
     // them to the simulated hardware state.  Because we munch events until a
@@ -297,7 +402,39 @@ private:
     }
   }
 
-  void writeButton(ButtonID id, bool pressed) {
+  void applyTimeline() {
+    // Compiled events land with their scheduled timestamp, not the time the
+    // clock happened to reach, so a coarse runner still sees exact press times.
+    // A button only holds one level between samples, though: a tap whose down
+    // and up both fall inside one control tick would overwrite itself and
+    // vanish.  So a second edge for a button nobody has sampled yet waits, and
+    // the rest of the timeline waits behind it to keep the order intact.
+    while (timeline_cursor_ < timeline_.size()) {
+      const NativeScriptEvent& evt = timeline_[timeline_cursor_];
+      const std::uint64_t at = timeline_base_us_ + evt.at_us;
+      if (at > now_us_) {
+        break;
+      }
+      if (evt.type == NativeScriptEvent::Type::Button) {
+        const std::size_t idx = static_cast<std::size_t>(evt.button);
+        const std::uint32_t bit = 1u << idx;
+        if (idx < button_samples_.size() && button_samples_[idx].pressed != evt.pressed) {
+          if (unsampled_edges_ & bit) {
+            break;
+          }
+          unsampled_edges_ |= bit;
+        }
+        writeButton(evt.button, evt.pressed, at);
+      } else {
+        encoder_deltas_[static_cast<std::size_t>(evt.encoder)] += evt.delta;
+      }
+      ++timeline_cursor_;
+    }
+  }
+
+  void writeButton(ButtonID id, bool pressed) { writeButton(id, pressed, now_us_); }
+
+  void writeButton(ButtonID id, bool pressed, std::uint64_t timestamp_us) {
     // Internal helper that mirrors a button press into the sampled state.  The
     // timestamp uses the simulator clock so lessons about debouncing still
     // apply even when everything is synthetic.
@@ -308,10 +445,15 @@ private:
     // Same layout as the hardware board: `pressed` is level, timestamp is the
     // simulator's notion of "now".
     button_samples_[idx].pressed = pressed;
-    button_samples_[idx].timestamp_us = now_us_;
+    button_samples_[idx].timestamp_us = timestamp_us;
   }
 
   std::deque<ScriptEvent> script_{};
+  std::vector<NativeScriptEvent> timeline_{};
+  std::size_t timeline_cursor_{0};
+  std::uint64_t timeline_base_us_{0};
+  bool clock_driven_{false};
+  std::uint32_t unsampled_edges_{0};  // buttons whose timeline edge poll() has not handed out yet
   std::array<ButtonSample, 8> button_samples_{};
   std::array<int32_t, 4> encoder_deltas_{};
   std::uint64_t now_us_{0};
@@ -350,6 +492,125 @@ void nativeBoardFastForwardMicros(std::uint64_t delta) {
 
 void nativeBoardSetButton(Board::ButtonID id, bool pressed) { instance().setButton(id, pressed); }
 
+bool compileNativeScript(std::string_view text, NativeScript& out, std::string* error) {
+  // One pass: keep a cursor in script time, emit events at it, and unroll
+  // `repeat` blocks on `end` by copying the block shifted by its own length.
+  // `at` may move the cursor backwards, hence the stable sort at the end and
+  // the separate high-water mark for the script's duration.
+  constexpr std::size_t kMaxEvents = 1u << 22;  // keeps a typo'd repeat count from eating RAM
+  struct Block {
+    std::size_t firstEvent;
+    std::uint64_t startUs;
+    std::uint64_t count;
+  };
+  std::vector<NativeScriptEvent> events;
+  std::vector<Block> blocks;
+  std::uint64_t cursor = 0;
+  std::uint64_t furthest = 0;
+  std::size_t lineNumber = 0;
+  auto fail = [&](const char* what) {
+    if (error) {
+      *error = "line " + std::to_string(lineNumber) + ": " + what;
+    }
+    return false;
+  };
+
+  while (!text.empty()) {
+    ++lineNumber;
+    const std::size_t newline = text.find('\n');
+    const std::string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+    const ScriptLine parsed = parseScriptLine(line);
+    NativeScriptEvent evt{};
+    evt.at_us = cursor;
+    switch (parsed.kind) {
+      case ScriptLine::Kind::Empty:
+        continue;
+      case ScriptLine::Kind::Invalid:
+        return fail("unrecognised command");
+      case ScriptLine::Kind::Wait:
+        cursor += parsed.micros;
+        furthest = std::max(furthest, cursor);
+        continue;
+      case ScriptLine::Kind::At:
+        if (!blocks.empty()) {
+          return fail("`at` inside repeat");
+        }
+        cursor = parsed.micros;
+        furthest = std::max(furthest, cursor);
+        continue;
+      case ScriptLine::Kind::Repeat:
+        blocks.push_back({events.size(), cursor, parsed.count});
+        continue;
+      case ScriptLine::Kind::End: {
+        if (blocks.empty()) {
+          return fail("`end` without `repeat`");
+        }
+        const Block block = blocks.back();
+        blocks.pop_back();
+        const std::size_t bodySize = events.size() - block.firstEvent;
+        const std::uint64_t span = cursor - block.startUs;
+        if (bodySize * block.count > kMaxEvents || events.size() + bodySize * (block.count - 1) > kMaxEvents) {
+          return fail("repeat expands past the event limit");
+        }
+        events.reserve(events.size() + bodySize * (block.count - 1));
+        for (std::uint64_t pass = 1; pass < block.count; ++pass) {
+          for (std::size_t i = 0; i < bodySize; ++i) {
+            NativeScriptEvent copy = events[block.firstEvent + i];
+            copy.at_us += span * pass;
+            events.push_back(copy);
+          }
+        }
+        cursor += span * (block.count - 1);
+        furthest = std::max(furthest, cursor);
+        continue;
+      }
+      case ScriptLine::Kind::Button:
+        evt.type = NativeScriptEvent::Type::Button;
+        evt.button = parsed.button;
+        evt.pressed = parsed.pressed;
+        break;
+      case ScriptLine::Kind::Encoder:
+        evt.type = NativeScriptEvent::Type::Encoder;
+        evt.encoder = parsed.encoder;
+        evt.delta = parsed.delta;
+        break;
+    }
+    if (events.size() >= kMaxEvents) {
+      return fail("script exceeds the event limit");
+    }
+    events.push_back(evt);
+  }
+  if (!blocks.empty()) {
+    return fail("`repeat` without `end`");
+  }
+
+  std::stable_sort(events.begin(), events.end(),
+                   [](const NativeScriptEvent& a, const NativeScriptEvent& b) { return a.at_us < b.at_us; });
+  out.events = std::move(events);
+  out.duration_us = furthest;
+  return true;
+}
+
+bool loadNativeScriptFile(const std::string& path, NativeScript& out, std::string* error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    if (error) {
+      *error = "cannot open " + path;
+    }
+    return false;
+  }
+  const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  return compileNativeScript(text, out, error);
+}
+
+void nativeBoardLoadScript(const NativeScript& script) { instance().load(script); }
+
+std::uint64_t nativeBoardNextEventMicros() { return instance().nextEventMicros(); }
+
+void nativeBoardAdvanceTo(std::uint64_t micros) { instance().advanceTo(micros); }
+
 std::vector<std::string> nativeEnumerateControllers() {
   // Native desktop builds don't talk to real hardware yet, so this hook stays
   // intentionally sparse.  It still exists so the front panel can surface a
@@ -6,8 +6,10 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstring>
 #include <vector>
 
+#include "hal_audio_q15.h"
 #include "util/Units.h"
 
 #if SEEDBOX_HW
@@ -27,6 +29,8 @@ std::size_t g_frames_per_block = 64;
 std::atomic<uint32_t> g_sample_clock{0};
 
 #if SEEDBOX_HW
+ConversionCycles g_conversion_cycles{};
+
 class CallbackStream : public AudioStream {
  public:
   CallbackStream() : AudioStream(0, nullptr) {}
@@ -46,25 +50,22 @@ class CallbackStream : public AudioStream {
       return;
     }
 
-    std::array<float, AUDIO_BLOCK_SAMPLES> left{};
-    std::array<float, AUDIO_BLOCK_SAMPLES> right{};
-
     if (g_running && g_callback) {
-      // Convert the int16_t AudioStream buffers into floating point scratch so
-      // our engines can stay sample-format agnostic.  Later we quantize back
-      // down before handing the blocks to the codec.
-      StereoBufferView view{left.data(), right.data(), left.size()};
+      // The engines render float into our scratch, then the Q15 kernel writes
+      // straight into the library blocks.  No zero-fill here: the callback owns
+      // every frame it is handed.
+      StereoBufferView view{left_.data(), right_.data(), left_.size()};
       g_callback(view, g_user_data);
+      const std::uint32_t start = ARM_DWT_CYCCNT;
+      floatBlockToQ15(left_.data(), left_block->data, AUDIO_BLOCK_SAMPLES);
+      floatBlockToQ15(right_.data(), right_block->data, AUDIO_BLOCK_SAMPLES);
+      const std::uint32_t cycles = ARM_DWT_CYCCNT - start;
+      g_conversion_cycles.last = cycles;
+      g_conversion_cycles.peak = std::max(g_conversion_cycles.peak, cycles);
     } else {
-      left.fill(0.0f);
-      right.fill(0.0f);
-    }
-
-    for (std::size_t i = 0; i < left.size(); ++i) {
-      const float l = std::clamp(left[i], -1.0f, 1.0f);
-      const float r = std::clamp(right[i], -1.0f, 1.0f);
-      left_block->data[i] = static_cast<int16_t>(l * 32767.0f);
-      right_block->data[i] = static_cast<int16_t>(r * 32767.0f);
+      // Silence never needed the float detour.
+      std::memset(left_block->data, 0, sizeof(left_block->data));
+      std::memset(right_block->data, 0, sizeof(right_block->data));
     }
 
     transmit(left_block, 0);
@@ -73,6 +74,10 @@ class CallbackStream : public AudioStream {
     release(right_block);
     g_sample_clock.fetch_add(static_cast<uint32_t>(AUDIO_BLOCK_SAMPLES), std::memory_order_relaxed);
   }
+
+ private:
+  std::array<float, AUDIO_BLOCK_SAMPLES> left_;
+  std::array<float, AUDIO_BLOCK_SAMPLES> right_;
 };
 
 CallbackStream &streamInstance() {
@@ -118,6 +123,12 @@ float sampleRate() { return g_sample_rate; }
 
 std::uint32_t sampleClock() { return static_cast<std::uint32_t>(g_sample_clock.load(std::memory_order_relaxed)); }
 
+#if SEEDBOX_HW
+ConversionCycles conversionCycles() { return g_conversion_cycles; }
+
+float processorUsagePercent() { return AudioProcessorUsage(); }
+#endif
+
 #if !SEEDBOX_HW
 namespace {
 std::vector<float> &scratch(std::vector<float> &buffer, std::size_t frames) {
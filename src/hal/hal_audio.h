@@ -39,6 +39,22 @@ SEEDBOX_MAYBE_UNUSED std::size_t framesPerBlock();
 SEEDBOX_MAYBE_UNUSED float sampleRate();
 SEEDBOX_MAYBE_UNUSED std::uint32_t sampleClock();
 
+#if SEEDBOX_HW
+// CPU cycles (DWT cycle counter) the float -> Q15 write-out took for one stereo
+// block: the most recent block and the worst seen since boot.  Cheap enough to
+// leave on; the serial console can print it when chasing audio-ISR budget.
+struct ConversionCycles {
+  std::uint32_t last{0};
+  std::uint32_t peak{0};
+};
+SEEDBOX_MAYBE_UNUSED ConversionCycles conversionCycles();
+// Whole audio-library update as a percent of one block period
+// (AudioProcessorUsage()), from the last completed update.  The engines' voices
+// are library nodes that render outside our callback, so this, not a
+// stopwatch around the callback, is the block's real cost on the Teensy.
+SEEDBOX_MAYBE_UNUSED float processorUsagePercent();
+#endif  // SEEDBOX_HW
+
 #if !SEEDBOX_HW
 // Tell the sim/desktop path what the host's buffer sizing looks like. JUCE and
 // other native audio drivers call this when they learn the device configuration
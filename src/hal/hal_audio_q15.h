@@ -0,0 +1,77 @@
+#pragma once
+
+//
+// Q15 <-> float block conversion.
+// -------------------------------
+// The Teensy Audio library speaks int16 blocks; our engines speak float.  These
+// helpers are the only place the two meet, so the hardware stream can render
+// float scratch and write straight into the library's `audio_block_t::data`
+// without another staging copy.
+//
+// Scaling matches what the HAL always did: clamp to [-1, 1], multiply by 32767
+// and truncate toward zero, so the codec sees a symmetric range (-32767..32767)
+// and +1.0f maps exactly to full scale.  NaN is the one addition — it used to be
+// undefined behaviour and now lands on silence.
+//
+// `floatToQ15()` is the reference.  The block functions must produce exactly the
+// same bits: on Cortex-M7 (which has the DSP extension) they pack two samples
+// per 32-bit store with PKHBT; everywhere else they are a plain branch-free loop
+// the compiler is free to vectorise.  tests/test_app/test_hal_audio_q15.cpp
+// holds both to the reference.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hal {
+namespace audio {
+
+inline constexpr float kQ15Scale = 32767.0f;
+inline constexpr float kQ15InverseScale = 1.0f / 32767.0f;
+
+inline std::int16_t floatToQ15(float x) {
+  if (x != x) {
+    return 0;
+  }
+  const float clamped = x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+  return static_cast<std::int16_t>(clamped * kQ15Scale);
+}
+
+inline float q15ToFloat(std::int16_t q) { return static_cast<float>(q) * kQ15InverseScale; }
+
+namespace detail {
+#if defined(__ARM_FEATURE_DSP)
+// Low half from `lo`, high half from `hi`: one store instead of two.
+inline std::uint32_t packQ15Pair(std::int32_t lo, std::int32_t hi) {
+  std::uint32_t out;
+  asm("pkhbt %0, %1, %2, lsl #16" : "=r"(out) : "r"(lo), "r"(hi));
+  return out;
+}
+#endif
+}  // namespace detail
+
+inline void floatBlockToQ15(const float* in, std::int16_t* out, std::size_t frames) {
+  std::size_t i = 0;
+#if defined(__ARM_FEATURE_DSP)
+  // Audio library blocks are word aligned, but stay honest for any caller.
+  if ((reinterpret_cast<std::uintptr_t>(out) & 0x3u) != 0 && frames > 0) {
+    out[0] = floatToQ15(in[0]);
+    i = 1;
+  }
+  auto* words = reinterpret_cast<std::uint32_t*>(out + i);
+  for (; i + 1 < frames; i += 2) {
+    *words++ = detail::packQ15Pair(floatToQ15(in[i]), floatToQ15(in[i + 1]));
+  }
+#endif
+  for (; i < frames; ++i) {
+    out[i] = floatToQ15(in[i]);
+  }
+}
+
+inline void q15BlockToFloat(const std::int16_t* in, float* out, std::size_t frames) {
+  for (std::size_t i = 0; i < frames; ++i) {
+    out[i] = q15ToFloat(in[i]);
+  }
+}
+
+}  // namespace audio
+}  // namespace hal
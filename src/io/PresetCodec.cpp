@@ -0,0 +1,729 @@
+#include "io/PresetCodec.h"
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "app/Preset.h"
+
+namespace {
+
+// Payload markers.  Raw JSON always starts with '{' (or whitespace), so a
+// marker byte in front is enough to tell the encodings apart.
+constexpr std::uint8_t kPackedMarker = 0x50u;  // 'P' — everything we write today
+// Older firmware wrote token-only blobs (0x00) and, when those still did not
+// fit, a binary struct dump (0x42).  Both stay readable for existing EEPROMs.
+constexpr std::uint8_t kLegacyTokenMarker = 0x00u;
+constexpr std::uint8_t kLegacyTokenEscape = 0x1Fu;
+constexpr std::uint8_t kLegacyBinaryMarker = 0x42u;
+constexpr std::size_t kLegacyTokenCount = 40;
+
+// Packed op codes: the top two bits pick the op, the low six carry its size.
+constexpr std::uint8_t kOpMask = 0xC0u;
+constexpr std::uint8_t kLiteralOp = 0x00u;  // 1..64 verbatim bytes follow
+constexpr std::uint8_t kNumberOp = 0x40u;   // 1..64 number chars, two per byte
+constexpr std::uint8_t kTokenOp = 0x80u;    // dictionary token index
+constexpr std::uint8_t kMatchOp = 0xC0u;    // back-reference into the output
+constexpr std::uint8_t kRunMask = 0x3Fu;
+constexpr std::size_t kMaxRun = 64;
+constexpr std::uint8_t kMatchWideOffset = 0x20u;
+constexpr std::uint8_t kMatchLengthMask = 0x1Fu;
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kMaxMatch = 1024;
+constexpr std::size_t kMaxShortOffset = 256;
+constexpr std::size_t kMaxOffset = 65536;
+constexpr std::size_t kHashBits = 12;
+constexpr std::size_t kMaxChainSteps = 16;
+constexpr std::size_t kLongMatch = 64;
+// Sanity ceiling for the length header so a corrupt varint cannot ask the
+// decoder for an absurd allocation.
+constexpr std::uint32_t kMaxUnpackedSize = 1u << 20;
+
+// Number runs only need 15 symbols, so every char fits in a nibble.
+constexpr std::string_view kNumberAlphabet = "0123456789.-+eE";
+constexpr std::uint8_t kNumberPad = 0x0Fu;
+
+// Raw-string tokens mirror verbatim JSON fragments. The custom delimiter keeps
+// the punctuation readable so future tweaks don't devolve into escape soup.
+// The first 40 entries are frozen: legacy token blobs index into them.  New
+// fragments may only be appended (the packed op has room for 64).
+constexpr std::array<std::string_view, 43> kPresetTokens{
+    R"tok(,"transportLatch":false)tok",
+    R"tok(,"followExternal":false)tok",
+    R"tok(,"debugMeters":false)tok",
+    R"tok("engineSelections":[)tok",
+    R"tok(,"stereoSpread":)tok",
+    R"tok(,"probability":)tok",
+    R"tok(,"grainSizeMs":)tok",
+    R"tok("clock":{"bpm":)tok",
+    R"tok(,"windowSkew":)tok",
+    R"tok(,"resonator":{)tok",
+    R"tok(,"brightness":)tok",
+    R"tok("masterSeed":)tok",
+    R"tok(,"mutateAmt":)tok",
+    R"tok(,"transpose":)tok",
+    R"tok(,"granular":{)tok",
+    R"tok(,"focusSeed":)tok",
+    R"tok(,"sampleIdx":)tok",
+    R"tok(,"feedback":)tok",
+    R"tok(,"exciteMs":)tok",
+    R"tok(,"jitterMs":)tok",
+    R"tok(,"damping":)tok",
+    R"tok(,"density":)tok",
+    R"tok(,"sprayMs":)tok",
+    R"tok(,"sdSlot":)tok",
+    R"tok(,"spread":)tok",
+    R"tok(,"source":)tok",
+    R"tok(,"engine":)tok",
+    R"tok("seeds":[)tok",
+    R"tok(,"pitch":)tok",
+    R"tok(,"mode":)tok",
+    R"tok(,"prng":)tok",
+    R"tok(,"envS":)tok",
+    R"tok(,"tone":)tok",
+    R"tok(,"bank":)tok",
+    R"tok(,"envA":)tok",
+    R"tok(,"envD":)tok",
+    R"tok(,"envR":)tok",
+    R"tok({"id":)tok",
+    R"tok(},)tok",
+    R"tok(}])tok",
+    R"tok({"slot":")tok",
+    R"tok(,"page":)tok",
+    R"tok(":true)tok",
+};
+static_assert(kPresetTokens.size() <= kRunMask + 1u, "token index must fit the packed op");
+
+constexpr std::size_t trieCapacity() {
+  std::size_t total = 1;  // root
+  for (const auto& token : kPresetTokens) {
+    total += token.size();
+  }
+  return total;
+}
+
+// Prefix trie over the dictionary.  Children hang off a first-child /
+// next-sibling list, which keeps the table flat enough to live in a static
+// array on the Teensy while still giving the encoder every token at any offset
+// in O(token length) instead of O(tokens x token length).
+class TokenTrie {
+public:
+  static constexpr std::uint8_t kNoToken = 0xFFu;
+  static constexpr std::uint16_t kNoNode = 0xFFFFu;
+
+  TokenTrie() {
+    nodes_[0] = Node{};
+    used_ = 1;
+    for (std::size_t t = 0; t < kPresetTokens.size(); ++t) {
+      std::uint16_t node = 0;
+      for (char ch : kPresetTokens[t]) {
+        node = childOrInsert(node, static_cast<std::uint8_t>(ch));
+      }
+      nodes_[node].token = static_cast<std::uint8_t>(t);
+    }
+  }
+
+  // Calls `fn(length, token)` for every dictionary token that starts at
+  // `data`, shortest first.  One walk down the trie, however many hit.
+  template <typename Fn>
+  void forEachToken(const std::uint8_t* data, std::size_t available, Fn&& fn) const {
+    std::uint16_t node = 0;
+    for (std::size_t i = 0; i < available; ++i) {
+      node = child(node, data[i]);
+      if (node == kNoNode) {
+        return;
+      }
+      if (nodes_[node].token != kNoToken) {
+        fn(i + 1, nodes_[node].token);
+      }
+    }
+  }
+
+private:
+  struct Node {
+    std::uint8_t ch{0};
+    std::uint8_t token{kNoToken};
+    std::uint16_t firstChild{kNoNode};
+    std::uint16_t nextSibling{kNoNode};
+  };
+
+  std::uint16_t child(std::uint16_t parent, std::uint8_t ch) const {
+    for (std::uint16_t c = nodes_[parent].firstChild; c != kNoNode; c = nodes_[c].nextSibling) {
+      if (nodes_[c].ch == ch) {
+        return c;
+      }
+    }
+    return kNoNode;
+  }
+
+  std::uint16_t childOrInsert(std::uint16_t parent, std::uint8_t ch) {
+    const std::uint16_t existing = child(parent, ch);
+    if (existing != kNoNode) {
+      return existing;
+    }
+    const std::uint16_t fresh = static_cast<std::uint16_t>(used_++);
+    nodes_[fresh] = Node{};
+    nodes_[fresh].ch = ch;
+    nodes_[fresh].nextSibling = nodes_[parent].firstChild;
+    nodes_[parent].firstChild = fresh;
+    return fresh;
+  }
+
+  std::array<Node, trieCapacity()> nodes_{};
+  std::size_t used_{0};
+};
+
+const TokenTrie& tokenTrie() {
+  static const TokenTrie trie{};
+  return trie;
+}
+
+std::uint8_t numberNibble(std::uint8_t ch) {
+  const std::size_t pos = kNumberAlphabet.find(static_cast<char>(ch));
+  return pos == std::string_view::npos ? kNumberPad : static_cast<std::uint8_t>(pos);
+}
+
+bool startsNumber(const std::uint8_t* data, std::size_t available) {
+  const auto isDigit = [](std::uint8_t c) { return c >= '0' && c <= '9'; };
+  return isDigit(data[0]) || (data[0] == '-' && available > 1 && isDigit(data[1]));
+}
+
+std::uint32_t hash4(const std::uint8_t* p) {
+  const std::uint32_t v = static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8u) |
+                          (static_cast<std::uint32_t>(p[2]) << 16u) |
+                          (static_cast<std::uint32_t>(p[3]) << 24u);
+  return (v * 2654435761u) >> (32u - kHashBits);
+}
+
+void appendVarint(std::vector<std::uint8_t>& out, std::size_t value) {
+  while (value >= 0x80u) {
+    out.push_back(static_cast<std::uint8_t>((value & 0x7Fu) | 0x80u));
+    value >>= 7u;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool readVarint(const std::vector<std::uint8_t>& data, std::size_t& offset, std::uint32_t& out) {
+  std::uint32_t value = 0;
+  for (unsigned shift = 0; shift < 35u; shift += 7u) {
+    if (offset >= data.size()) {
+      return false;
+    }
+    const std::uint8_t byte = data[offset++];
+    value |= static_cast<std::uint32_t>(byte & 0x7Fu) << shift;
+    if ((byte & 0x80u) == 0) {
+      out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+void appendLiterals(std::vector<std::uint8_t>& out, const std::uint8_t* data, std::size_t count) {
+  while (count > 0) {
+    const std::size_t run = count < kMaxRun ? count : kMaxRun;
+    out.push_back(static_cast<std::uint8_t>(kLiteralOp | (run - 1)));
+    out.insert(out.end(), data, data + run);
+    data += run;
+    count -= run;
+  }
+}
+
+std::size_t matchCost(std::size_t length, std::size_t offset) {
+  std::size_t cost = (offset <= kMaxShortOffset) ? 2u : 3u;
+  std::size_t extra = length - kMinMatch;
+  if (extra >= kMatchLengthMask) {
+    extra -= kMatchLengthMask;
+    do {
+      ++cost;
+      extra >>= 7u;
+    } while (extra > 0);
+  }
+  return cost;
+}
+
+void appendMatch(std::vector<std::uint8_t>& out, std::size_t length, std::size_t offset) {
+  const bool wide = offset > kMaxShortOffset;
+  const std::size_t field = length - kMinMatch;
+  const std::uint8_t lengthBits =
+      static_cast<std::uint8_t>(field < kMatchLengthMask ? field : kMatchLengthMask);
+  out.push_back(static_cast<std::uint8_t>(kMatchOp | (wide ? kMatchWideOffset : 0u) | lengthBits));
+  if (lengthBits == kMatchLengthMask) {
+    appendVarint(out, field - kMatchLengthMask);
+  }
+  const std::size_t stored = offset - 1;
+  out.push_back(static_cast<std::uint8_t>(stored & 0xFFu));
+  if (wide) {
+    out.push_back(static_cast<std::uint8_t>((stored >> 8u) & 0xFFu));
+  }
+}
+
+void appendNumber(std::vector<std::uint8_t>& out, const std::uint8_t* data, std::size_t count) {
+  out.push_back(static_cast<std::uint8_t>(kNumberOp | (count - 1)));
+  for (std::size_t i = 0; i < count; i += 2) {
+    const std::uint8_t hi = numberNibble(data[i]);
+    const std::uint8_t lo = (i + 1 < count) ? numberNibble(data[i + 1]) : kNumberPad;
+    out.push_back(static_cast<std::uint8_t>((hi << 4u) | lo));
+  }
+}
+
+// Parse bookkeeping for the encoder.  `closed[i]` is the cheapest way to have
+// emitted the first i bytes ending on a token/match/number op, `open[i]` the
+// cheapest ending inside a literal run (which still owes no new run header).
+enum class OpKind : std::uint8_t { kLiteral, kToken, kMatch, kNumber };
+
+struct ParseStep {
+  std::uint32_t cost{UINT32_MAX};
+  std::uint32_t aux{0};     // token index or match offset
+  std::uint16_t length{0};  // bytes consumed by the op that got us here
+  std::uint8_t run{0};      // literal run length so far (open states only)
+  OpKind kind{OpKind::kLiteral};
+  bool fromOpen{false};     // which state the previous op ended in
+};
+
+struct ParsedOp {
+  std::size_t pos;
+  std::size_t length;
+  std::uint32_t aux;
+  OpKind kind;
+};
+
+bool looksEncoded(const std::vector<std::uint8_t>& bytes) {
+  return !bytes.empty() && (bytes[0] == kPackedMarker || bytes[0] == kLegacyTokenMarker ||
+                            bytes[0] == kLegacyBinaryMarker);
+}
+
+bool unpackPacked(const std::vector<std::uint8_t>& stored, std::vector<std::uint8_t>& out) {
+  std::size_t pos = 1;
+  std::uint32_t rawLen = 0;
+  if (!readVarint(stored, pos, rawLen) || rawLen > kMaxUnpackedSize) {
+    return false;
+  }
+
+  // The length header lets us size the output once and write through a plain
+  // cursor — no incremental growth while tokens and matches expand.
+  std::vector<std::uint8_t> decoded(rawLen);
+  std::uint8_t* dst = decoded.data();
+  std::size_t written = 0;
+  while (pos < stored.size()) {
+    const std::uint8_t op = stored[pos++];
+    switch (op & kOpMask) {
+      case kLiteralOp: {
+        const std::size_t run = static_cast<std::size_t>(op & kRunMask) + 1u;
+        if (pos + run > stored.size() || written + run > rawLen) {
+          return false;
+        }
+        std::memcpy(dst + written, stored.data() + pos, run);
+        pos += run;
+        written += run;
+        break;
+      }
+      case kNumberOp: {
+        const std::size_t run = static_cast<std::size_t>(op & kRunMask) + 1u;
+        if (pos + (run + 1u) / 2u > stored.size() || written + run > rawLen) {
+          return false;
+        }
+        for (std::size_t i = 0; i < run; ++i) {
+          const std::uint8_t packed = stored[pos + i / 2u];
+          const std::uint8_t nibble = (i & 1u) ? (packed & 0x0Fu) : (packed >> 4u);
+          if (nibble >= kNumberAlphabet.size()) {
+            return false;
+          }
+          dst[written++] = static_cast<std::uint8_t>(kNumberAlphabet[nibble]);
+        }
+        pos += (run + 1u) / 2u;
+        break;
+      }
+      case kTokenOp: {
+        const std::size_t index = op & kRunMask;
+        if (index >= kPresetTokens.size()) {
+          return false;
+        }
+        const std::string_view token = kPresetTokens[index];
+        if (written + token.size() > rawLen) {
+          return false;
+        }
+        std::memcpy(dst + written, token.data(), token.size());
+        written += token.size();
+        break;
+      }
+      default: {
+        std::uint32_t field = op & kMatchLengthMask;
+        if (field == kMatchLengthMask) {
+          std::uint32_t extra = 0;
+          if (!readVarint(stored, pos, extra)) {
+            return false;
+          }
+          field += extra;
+        }
+        const std::size_t length = static_cast<std::size_t>(field) + kMinMatch;
+        const bool wide = (op & kMatchWideOffset) != 0;
+        if (pos + (wide ? 2u : 1u) > stored.size()) {
+          return false;
+        }
+        std::size_t offset = stored[pos++];
+        if (wide) {
+          offset |= static_cast<std::size_t>(stored[pos++]) << 8u;
+        }
+        offset += 1u;
+        if (offset > written || length > rawLen - written) {
+          return false;
+        }
+        // Byte-wise on purpose: matches may overlap the bytes they produce.
+        const std::uint8_t* src = dst + written - offset;
+        for (std::size_t i = 0; i < length; ++i) {
+          dst[written + i] = src[i];
+        }
+        written += length;
+        break;
+      }
+    }
+  }
+
+  if (written != rawLen) {
+    return false;
+  }
+  out = std::move(decoded);
+  return true;
+}
+
+bool unpackLegacyTokens(const std::vector<std::uint8_t>& stored, std::vector<std::uint8_t>& out) {
+  std::vector<std::uint8_t> decoded;
+  decoded.reserve(stored.size() * 2u);
+  std::size_t i = 1;
+  while (i < stored.size()) {
+    const std::uint8_t byte = stored[i++];
+    if (byte != kLegacyTokenEscape) {
+      decoded.push_back(byte);
+      continue;
+    }
+    if (i >= stored.size()) {
+      return false;
+    }
+    const std::uint8_t code = stored[i++];
+    if (code == kLegacyTokenCount) {
+      decoded.push_back(kLegacyTokenEscape);
+      continue;
+    }
+    if (code > kLegacyTokenCount) {
+      return false;
+    }
+    const std::string_view token = kPresetTokens[code];
+    decoded.insert(decoded.end(), token.begin(), token.end());
+  }
+  out = std::move(decoded);
+  return true;
+}
+
+bool readUint8(const std::vector<std::uint8_t>& data, std::size_t& offset, std::uint8_t& out) {
+  if (offset >= data.size()) {
+    return false;
+  }
+  out = data[offset++];
+  return true;
+}
+
+bool readUint32(const std::vector<std::uint8_t>& data, std::size_t& offset, std::uint32_t& out) {
+  if (offset + 4 > data.size()) {
+    return false;
+  }
+  out = static_cast<std::uint32_t>(data[offset]) |
+        (static_cast<std::uint32_t>(data[offset + 1]) << 8u) |
+        (static_cast<std::uint32_t>(data[offset + 2]) << 16u) |
+        (static_cast<std::uint32_t>(data[offset + 3]) << 24u);
+  offset += 4;
+  return true;
+}
+
+bool readFloat(const std::vector<std::uint8_t>& data, std::size_t& offset, float& out) {
+  std::uint32_t bits = 0;
+  if (!readUint32(data, offset, bits)) {
+    return false;
+  }
+  std::memcpy(&out, &bits, sizeof(out));
+  return true;
+}
+
+bool unpackLegacyBinary(const std::vector<std::uint8_t>& stored, std::vector<std::uint8_t>& out) {
+  std::size_t offset = 1;
+  std::uint8_t slotLen = 0;
+  if (!readUint8(stored, offset, slotLen) || offset + slotLen > stored.size()) {
+    return false;
+  }
+
+  seedbox::Preset preset{};
+  preset.slot.assign(reinterpret_cast<const char*>(stored.data() + offset), slotLen);
+  offset += slotLen;
+
+  std::uint8_t focus = 0;
+  std::uint8_t follow = 0;
+  std::uint8_t debug = 0;
+  std::uint8_t latch = 0;
+  std::uint8_t page = 0;
+  if (!readUint32(stored, offset, preset.masterSeed) || !readUint8(stored, offset, focus) ||
+      !readFloat(stored, offset, preset.clock.bpm) || !readUint8(stored, offset, follow) ||
+      !readUint8(stored, offset, debug) || !readUint8(stored, offset, latch) ||
+      !readUint8(stored, offset, page)) {
+    return false;
+  }
+  preset.focusSeed = focus;
+  preset.clock.followExternal = (follow != 0);
+  preset.clock.debugMeters = (debug != 0);
+  preset.clock.transportLatch = (latch != 0);
+  preset.page = static_cast<seedbox::PageId>(page);
+
+  std::uint8_t engineCount = 0;
+  if (!readUint8(stored, offset, engineCount)) {
+    return false;
+  }
+  preset.engineSelections.resize(engineCount);
+  for (std::size_t i = 0; i < engineCount; ++i) {
+    if (!readUint8(stored, offset, preset.engineSelections[i])) {
+      return false;
+    }
+  }
+
+  std::uint8_t seedCount = 0;
+  if (!readUint8(stored, offset, seedCount)) {
+    return false;
+  }
+  preset.seeds.resize(seedCount);
+  for (std::size_t i = 0; i < seedCount; ++i) {
+    Seed& seed = preset.seeds[i];
+    std::uint8_t source = 0;
+    if (!readUint32(stored, offset, seed.id) || !readUint32(stored, offset, seed.prng) ||
+        !readUint8(stored, offset, source) || !readUint32(stored, offset, seed.lineage) ||
+        !readFloat(stored, offset, seed.pitch) || !readFloat(stored, offset, seed.envA) ||
+        !readFloat(stored, offset, seed.envD) || !readFloat(stored, offset, seed.envS) ||
+        !readFloat(stored, offset, seed.envR) || !readFloat(stored, offset, seed.density) ||
+        !readFloat(stored, offset, seed.probability) || !readFloat(stored, offset, seed.jitterMs) ||
+        !readFloat(stored, offset, seed.tone) || !readFloat(stored, offset, seed.spread) ||
+        !readUint8(stored, offset, seed.engine) || !readUint8(stored, offset, seed.sampleIdx) ||
+        !readFloat(stored, offset, seed.mutateAmt) ||
+        !readFloat(stored, offset, seed.granular.grainSizeMs) ||
+        !readFloat(stored, offset, seed.granular.sprayMs) ||
+        !readFloat(stored, offset, seed.granular.transpose) ||
+        !readFloat(stored, offset, seed.granular.windowSkew) ||
+        !readFloat(stored, offset, seed.granular.stereoSpread) ||
+        !readUint8(stored, offset, seed.granular.source) ||
+        !readUint8(stored, offset, seed.granular.sdSlot) ||
+        !readFloat(stored, offset, seed.resonator.exciteMs) ||
+        !readFloat(stored, offset, seed.resonator.damping) ||
+        !readFloat(stored, offset, seed.resonator.brightness) ||
+        !readFloat(stored, offset, seed.resonator.feedback) ||
+        !readUint8(stored, offset, seed.resonator.mode) ||
+        !readUint8(stored, offset, seed.resonator.bank)) {
+      return false;
+    }
+    seed.source = static_cast<Seed::Source>(source);
+  }
+
+  out = preset.serialize();
+  return !out.empty();
+}
+
+}  // namespace
+
+namespace seedbox::io {
+
+std::vector<std::uint8_t> packPresetBlob(const std::vector<std::uint8_t>& input) {
+  if (input.empty()) {
+    return input;
+  }
+
+  const std::size_t size = input.size();
+  const std::uint8_t* data = input.data();
+  const TokenTrie& trie = tokenTrie();
+
+  // Hash chains over 4-byte prefixes give us the LZ candidates.  Every input
+  // position is inserted exactly once and each lookup walks a bounded chain.
+  std::vector<std::int32_t> head(std::size_t{1} << kHashBits, -1);
+  std::vector<std::int32_t> chain(size, -1);
+
+  // Greedy picking lets a cheap four-byte match swallow the start of a key the
+  // dictionary would have covered whole, so instead the forward pass prices
+  // every candidate op into `closed`/`open` and a backward walk keeps the
+  // cheapest path.  Still one sweep over the input; the parse arrays cost
+  // ~24 bytes per input byte, only while saving.
+  std::vector<ParseStep> closed(size + 1);
+  std::vector<ParseStep> open(size + 1);
+  closed[0].cost = 0;
+
+  const auto relax = [&](std::size_t to, std::uint32_t cost, OpKind kind, std::size_t length,
+                         std::uint32_t aux, bool fromOpen) {
+    ParseStep& step = closed[to];
+    if (cost < step.cost) {
+      step.cost = cost;
+      step.kind = kind;
+      step.length = static_cast<std::uint16_t>(length);
+      step.aux = aux;
+      step.fromOpen = fromOpen;
+    }
+  };
+
+  struct Candidate {
+    std::size_t length;
+    std::size_t offset;
+  };
+  std::array<Candidate, kMaxChainSteps> candidates{};
+  std::size_t searchResume = 0;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    const std::size_t available = size - i;
+    const bool fromOpen = open[i].cost < closed[i].cost;
+    const std::uint32_t base = fromOpen ? open[i].cost : closed[i].cost;
+
+    // Literal: extend the current run, or pay for a fresh run header.
+    {
+      std::uint32_t cost = closed[i].cost == UINT32_MAX ? UINT32_MAX : closed[i].cost + 2u;
+      bool extend = false;
+      std::size_t run = 1;
+      if (open[i].cost != UINT32_MAX) {
+        const bool full = open[i].run == kMaxRun;
+        const std::uint32_t extendCost = open[i].cost + (full ? 2u : 1u);
+        if (extendCost <= cost) {
+          cost = extendCost;
+          extend = true;
+          run = full ? 1u : open[i].run + 1u;
+        }
+      }
+      ParseStep& step = open[i + 1];
+      step.cost = cost;
+      step.kind = OpKind::kLiteral;
+      step.length = 1;
+      step.run = static_cast<std::uint8_t>(run);
+      step.fromOpen = extend;
+    }
+
+    trie.forEachToken(data + i, available, [&](std::size_t length, std::uint8_t token) {
+      if (length > 1) {
+        relax(i + length, base + 1u, OpKind::kToken, length, token, fromOpen);
+      }
+    });
+
+    if (available >= kMinMatch && i >= searchResume) {
+      // Nearest candidates come first, so each entry is the closest (cheapest)
+      // offset that reaches its length.
+      const std::size_t limit = available < kMaxMatch ? available : kMaxMatch;
+      std::size_t found = 0;
+      std::size_t bestLength = 0;
+      std::int32_t candidate = head[hash4(data + i)];
+      for (std::size_t step = 0; candidate >= 0 && step < kMaxChainSteps; ++step) {
+        const std::size_t from = static_cast<std::size_t>(candidate);
+        if (i - from > kMaxOffset) {
+          break;
+        }
+        // Only a longer match earns a slot, so check the byte that would make
+        // it longer before scanning the rest.
+        if (bestLength > 0 && data[from + bestLength] != data[i + bestLength]) {
+          candidate = chain[from];
+          continue;
+        }
+        std::size_t length = 0;
+        while (length < limit && data[from + length] == data[i + length]) {
+          ++length;
+        }
+        if (length > bestLength) {
+          bestLength = length;
+          candidates[found++] = Candidate{length, i - from};
+          if (length == limit) {
+            break;
+          }
+        }
+        candidate = chain[from];
+      }
+      // Every length is worth pricing while the op stays one byte; past that
+      // only the longest reach matters.
+      std::size_t c = 0;
+      const std::size_t shortCap = kMinMatch + kMatchLengthMask - 1u;
+      for (std::size_t length = kMinMatch; length <= bestLength; ++length) {
+        if (length > shortCap && length != bestLength) {
+          length = bestLength;
+        }
+        while (candidates[c].length < length) {
+          ++c;
+        }
+        const std::size_t offset = candidates[c].offset;
+        relax(i + length, base + static_cast<std::uint32_t>(matchCost(length, offset)),
+              OpKind::kMatch, length, static_cast<std::uint32_t>(offset), fromOpen);
+      }
+      // A long match (a whole repeated seed, say) is already the answer for
+      // the bytes it covers; re-searching inside it just burns cycles.
+      if (bestLength >= kLongMatch) {
+        searchResume = i + bestLength;
+      }
+    }
+
+    if (startsNumber(data + i, available)) {
+      std::size_t run = 0;
+      while (run < available && run < kMaxRun && numberNibble(data[i + run]) != kNumberPad) {
+        ++run;
+      }
+      relax(i + run, base + static_cast<std::uint32_t>(1u + (run + 1u) / 2u), OpKind::kNumber, run,
+            0, fromOpen);
+    }
+
+    if (i + kMinMatch <= size) {
+      const std::uint32_t h = hash4(data + i);
+      chain[i] = head[h];
+      head[h] = static_cast<std::int32_t>(i);
+    }
+  }
+
+  // Walk the cheapest path back from the end, then emit it front to back.
+  std::vector<ParsedOp> ops;
+  bool inOpen = open[size].cost < closed[size].cost;
+  for (std::size_t pos = size; pos > 0;) {
+    const ParseStep& step = inOpen ? open[pos] : closed[pos];
+    pos -= step.length;
+    ops.push_back(ParsedOp{pos, step.length, step.aux, step.kind});
+    inOpen = step.fromOpen;
+  }
+
+  std::vector<std::uint8_t> out;
+  out.reserve(closed[size].cost < open[size].cost ? closed[size].cost + 8u : open[size].cost + 8u);
+  out.push_back(kPackedMarker);
+  appendVarint(out, size);
+  std::size_t literalStart = 0;
+  std::size_t literalCount = 0;
+  for (auto it = ops.rbegin(); it != ops.rend(); ++it) {
+    if (it->kind == OpKind::kLiteral) {
+      if (literalCount == 0) {
+        literalStart = it->pos;
+      }
+      ++literalCount;
+      continue;
+    }
+    appendLiterals(out, data + literalStart, literalCount);
+    literalCount = 0;
+    switch (it->kind) {
+      case OpKind::kToken: out.push_back(static_cast<std::uint8_t>(kTokenOp | it->aux)); break;
+      case OpKind::kMatch: appendMatch(out, it->length, it->aux); break;
+      case OpKind::kNumber: appendNumber(out, data + it->pos, it->length); break;
+      case OpKind::kLiteral: break;
+    }
+  }
+  appendLiterals(out, data + literalStart, literalCount);
+
+  // Tiny or incompressible blobs stay raw — unless their first byte could be
+  // mistaken for a marker, in which case the packed form is the only safe one.
+  if (out.size() >= size && !looksEncoded(input)) {
+    return input;
+  }
+  return out;
+}
+
+bool unpackPresetBlob(const std::vector<std::uint8_t>& stored, std::vector<std::uint8_t>& out) {
+  if (stored.empty()) {
+    out.clear();
+    return true;
+  }
+  switch (stored[0]) {
+    case kPackedMarker: return unpackPacked(stored, out);
+    case kLegacyTokenMarker: return unpackLegacyTokens(stored, out);
+    case kLegacyBinaryMarker: return unpackLegacyBinary(stored, out);
+    default: out = stored; return true;
+  }
+}
+
+}  // namespace seedbox::io
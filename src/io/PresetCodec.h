@@ -0,0 +1,35 @@
+#pragma once
+
+//
+// PresetCodec.h
+// -------------
+// The byte format `StoreEeprom` actually writes.  Preset JSON is chatty — the
+// same keys repeat for every seed — so before a blob hits EEPROM we squeeze it
+// through a single-pass packer:
+//
+//   * a static dictionary of preset JSON fragments, matched through a trie so
+//     the encoder never rescans the token table at every byte,
+//   * LZ-style back-references into the output already produced, which is what
+//     makes seed #2..#N nearly free once seed #1 spelled out the schema,
+//   * nibble-packed number runs, because digits are the part of the JSON no
+//     dictionary can predict.
+//
+// Every save lands in that one format.  Older EEPROM images (token-only blobs
+// and the binary struct dump) still decode so nobody loses a bank on upgrade.
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace seedbox::io {
+
+// Pack a preset blob (normally the JSON from `Preset::serialize`).  Arbitrary
+// bytes are fine; the result is returned unpacked when packing would not save
+// space and the raw bytes cannot be mistaken for a packed payload.
+std::vector<std::uint8_t> packPresetBlob(const std::vector<std::uint8_t>& input);
+
+// Inflate anything `packPresetBlob` (or an older firmware) wrote back into the
+// original bytes.  Returns false on truncated/corrupt payloads and leaves `out`
+// untouched in that case.
+bool unpackPresetBlob(const std::vector<std::uint8_t>& stored, std::vector<std::uint8_t>& out);
+
+}  // namespace seedbox::io
@@ -215,14 +215,7 @@ std::optional<StorageSpec> parseSpec(const char* path) {
   return spec;
 }
 
-seedbox::io::StoreEeprom& eepromStore() {
-#if SEEDBOX_HW
-  static seedbox::io::StoreEeprom store;
-#else
-  static seedbox::io::StoreEeprom store(4096);
-#endif
-  return store;
-}
+seedbox::io::StoreEeprom& eepromStore() { return seedbox::io::StoreEeprom::board(); }
 
 #if SEEDBOX_HW
 bool ensureSdReady() {
@@ -407,6 +400,12 @@ bool saveScene(const char* path) {
 
   switch (spec.backend) {
     case Backend::kEeprom:
+      // The live app usually fronts this same EEPROM; write through its preset
+      // cache so its next recall sees the new scene without a reload.  Any
+      // other cache notices the store's generation move instead.
+      if (app->store_ == &eepromStore()) {
+        return app->presetCache_.save(spec.key, snapshot) != nullptr;
+      }
       return eepromStore().save(spec.key, bytes);
     case Backend::kSd: {
 #if SEEDBOX_HW
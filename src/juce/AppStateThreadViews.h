@@ -116,6 +116,11 @@ class HostControlThreadAccess {
     detail::assertMessageThread();
     app_.setHostDiagnosticsFromHost(host);
   }
+  // Message thread only: publishing mutates the telemetry table.
+  std::size_t pollStatusTelemetry(std::uint32_t since, std::uint8_t* out, std::size_t capacity) {
+    detail::assertMessageThread();
+    return app_.pollStatusTelemetry(since, out, capacity);
+  }
   std::uint32_t masterSeed() const { return app_.masterSeed(); }
   void reseed(std::uint32_t masterSeed) { app_.reseed(masterSeed); }
   void setMode(AppState::Mode mode) { app_.setModeFromHost(mode); }
@@ -125,6 +130,9 @@ class HostControlThreadAccess {
   bool applySeedEdit(std::uint8_t seedIndex, const std::function<void(Seed&)>& edit) {
     return app_.applySeedEditFromHost(seedIndex, edit);
   }
+  bool setSeedParam(std::uint8_t seedIndex, SeedParam param, float value) {
+    return app_.setSeedParamFromHost(seedIndex, param, value);
+  }
   void seedPageCycleGranularSource(std::uint8_t seedIndex, int steps) {
     app_.seedPageCycleGranularSource(seedIndex, steps);
   }
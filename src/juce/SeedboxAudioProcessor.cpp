@@ -21,7 +21,6 @@ namespace seedbox::juce_bridge {
 namespace {
 constexpr int kMinPreparedScratchFrames = 8192;
 constexpr int kHostMaintenanceHz = 15;
-constexpr std::uint32_t kInvalidDeferredHostCommand = 0xFFFFFFFFu;
 constexpr std::size_t kDeferredSeedSlotCount = 4u;
 constexpr auto kParamMasterSeed = "masterSeed";
 constexpr auto kParamFocusSeed = "focusSeed";
@@ -123,6 +122,9 @@ AppState::DiagnosticsSnapshot::HostRuntime SeedboxAudioProcessor::hostDiagnostic
       static_cast<std::uint32_t>(std::max(lastOversizeBlockFrames_.load(std::memory_order_relaxed), 0));
   host.preparedScratchFrames =
       static_cast<std::uint32_t>(std::max(preparedScratchFrames_.load(std::memory_order_relaxed), 0));
+  host.commandQueueOverflowCount = hostCommands_.overflowCount();
+  host.commandQueueHighWater = hostCommands_.highWater();
+  host.commandQueueMaxLatencyUs = hostCommandMaxLatencyUs_.load(std::memory_order_relaxed);
   return host;
 }
 
@@ -376,66 +378,81 @@ bool SeedboxAudioProcessor::applyPanelQuickPreset() {
   return true;
 }
 
+bool SeedboxAudioProcessor::queueHostCommand(HostCommand command) {
+  command.stampMs = juce::Time::getMillisecondCounterHiRes();
+  return hostCommands_.push(command);
+}
+
+bool SeedboxAudioProcessor::queueSeedParamEdit(std::uint8_t seedIndex, SeedParam param, float value) {
+  if (param >= SeedParam::kCount) {
+    return false;
+  }
+  HostCommand command{};
+  command.kind = HostCommand::Kind::kSeedEdit;
+  command.seedIndex = seedIndex;
+  command.arg = static_cast<std::uint8_t>(param);
+  command.value = value;
+  return queueHostCommand(command);
+}
+
 void SeedboxAudioProcessor::flushDeferredHostParameterWork() {
-  // Deferred host parameter work is intentionally tiny: scalar commands are
-  // last-wins slots, while granular source movement is an accumulating per-seed
-  // delta. This keeps rapid automation bounded without a heap-backed command
-  // queue in a live instrument build.
-  //
-  // Deferred host command ordering matters. The current ritual is:
-  // 1. last-wins master seed reseed
-  // 2. last-wins focused seed engine apply
-  // 3. last-wins quantize apply
-  // 4. seed-state sync back into APVTS-facing storage
-  // 5. accumulated granular source movement, flushed independently per seed
-  // 6. last-wins gate division / gate floor policy
+  // Deferred host commands replay in exactly the order the host sent them, one
+  // at a time, here on the maintenance timer and nowhere else.  A reseed
+  // followed by an engine swap stays a reseed followed by an engine swap, and
+  // three granular source nudges stay three nudges.
   //
-  // That keeps "new world" mutations first, pitch/body policy next, host-state
-  // persistence after that, and live-input gate policy last.
-  const std::uint32_t masterSeed =
-      pendingMasterSeedReseed_.exchange(kInvalidDeferredHostCommand, std::memory_order_relaxed);
-  if (masterSeed != kInvalidDeferredHostCommand) {
-    controlThreadApp_.reseed(masterSeed);
-    pendingSeedStateSync_.store(true, std::memory_order_relaxed);
-  }
-
-  const std::uint32_t packedSeedEngine =
-      pendingSeedEngineApply_.exchange(kInvalidDeferredHostCommand, std::memory_order_relaxed);
-  if (packedSeedEngine != kInvalidDeferredHostCommand) {
-    const auto seedIndex = static_cast<std::uint8_t>((packedSeedEngine >> 8u) & 0xFFu);
-    const auto engineId = static_cast<std::uint8_t>(packedSeedEngine & 0xFFu);
-    controlThreadApp_.setSeedEngine(seedIndex, engineId);
-    setSeedProp(static_cast<int>(seedIndex), kPropEngineId, static_cast<int>(engineId));
-  }
-
-  const std::uint32_t packedQuantize =
-      pendingQuantizeApply_.exchange(kInvalidDeferredHostCommand, std::memory_order_relaxed);
-  if (packedQuantize != kInvalidDeferredHostCommand) {
-    const auto scale = static_cast<std::uint8_t>((packedQuantize >> 8u) & 0xFFu);
-    const auto root = static_cast<std::uint8_t>(packedQuantize & 0xFFu);
-    const auto control = static_cast<std::uint8_t>((scale * 32u) + (root % 12u));
-    controlThreadApp_.applyQuantizeControl(control);
-  }
-
-  if (pendingSeedStateSync_.exchange(false, std::memory_order_relaxed)) {
+  // The drain is capped at one ring's worth so a host that never stops
+  // automating cannot pin the timer; anything left waits for the next tick.
+  // Seed-state sync back into APVTS-facing storage happens once, after the
+  // batch, if any command moved seeds around.
+  bool seedStateDirty = false;
+  const double nowMs = juce::Time::getMillisecondCounterHiRes();
+  double oldestMs = nowMs;
+  HostCommand command{};
+  for (std::size_t drained = 0; drained < kHostCommandCapacity && hostCommands_.pop(command); ++drained) {
+    oldestMs = std::min(oldestMs, command.stampMs);
+    applyHostCommand(command, seedStateDirty);
+  }
+
+  const auto latencyUs = static_cast<std::uint32_t>(std::max(0.0, (nowMs - oldestMs) * 1000.0));
+  if (latencyUs > hostCommandMaxLatencyUs_.load(std::memory_order_relaxed)) {
+    hostCommandMaxLatencyUs_.store(latencyUs, std::memory_order_relaxed);
+  }
+  if (seedStateDirty) {
     syncSeedStateFromApp();
   }
+}
 
-  for (std::size_t seedIndex = 0; seedIndex < pendingGranularSourceDelta_.size(); ++seedIndex) {
-    const int delta = pendingGranularSourceDelta_[seedIndex].exchange(0, std::memory_order_relaxed);
-    if (delta != 0) {
-      controlThreadApp_.seedPageCycleGranularSource(static_cast<std::uint8_t>(seedIndex), delta);
+void SeedboxAudioProcessor::applyHostCommand(const HostCommand& command, bool& seedStateDirty) {
+  switch (command.kind) {
+    case HostCommand::Kind::kReseed:
+      controlThreadApp_.reseed(command.masterSeed);
+      seedStateDirty = true;
+      break;
+    case HostCommand::Kind::kSeedEngine:
+      controlThreadApp_.setSeedEngine(command.seedIndex, command.arg);
+      setSeedProp(static_cast<int>(command.seedIndex), kPropEngineId, static_cast<int>(command.arg));
+      break;
+    case HostCommand::Kind::kQuantize: {
+      const auto control = static_cast<std::uint8_t>((command.arg * 32u) + (command.root % 12u));
+      controlThreadApp_.applyQuantizeControl(control);
+      break;
     }
-  }
-
-  const int pendingGateDivision = pendingGateDivisionApply_.exchange(-1, std::memory_order_relaxed);
-  if (pendingGateDivision >= 0) {
-    controlThreadApp_.setInputGateDivision(static_cast<AppState::GateDivision>(pendingGateDivision));
-  }
-
-  const float pendingGateFloor = pendingGateFloorApply_.exchange(-1.0f, std::memory_order_relaxed);
-  if (pendingGateFloor >= 0.0f) {
-    controlThreadApp_.setInputGateFloor(pendingGateFloor);
+    case HostCommand::Kind::kGranularSourceStep:
+      controlThreadApp_.seedPageCycleGranularSource(command.seedIndex, command.steps);
+      break;
+    case HostCommand::Kind::kGateDivision:
+      controlThreadApp_.setInputGateDivision(static_cast<AppState::GateDivision>(command.arg));
+      break;
+    case HostCommand::Kind::kGateFloor:
+      controlThreadApp_.setInputGateFloor(command.value);
+      break;
+    case HostCommand::Kind::kSeedEdit:
+      // The packed parameter row makes every continuous Seed field reachable
+      // by column, and journals as one compact event.
+      controlThreadApp_.setSeedParam(command.seedIndex, static_cast<SeedParam>(command.arg), command.value);
+      seedStateDirty = true;
+      break;
   }
 }
 
@@ -445,29 +462,47 @@ void SeedboxAudioProcessor::parameterChanged(const juce::String& parameterID, fl
       quantizeScaleParam_,
       quantizeRootParam_,
       [this](std::uint32_t masterSeed) {
-        pendingMasterSeedReseed_.store(masterSeed, std::memory_order_relaxed);
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kReseed;
+        command.masterSeed = masterSeed;
+        queueHostCommand(command);
       },
       [this](std::uint8_t seedIndex, std::uint8_t engineId) {
-        const std::uint32_t packed =
-            (static_cast<std::uint32_t>(seedIndex) << 8u) | static_cast<std::uint32_t>(engineId);
-        pendingSeedEngineApply_.store(packed, std::memory_order_relaxed);
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kSeedEngine;
+        command.seedIndex = seedIndex;
+        command.arg = engineId;
+        queueHostCommand(command);
       },
       [this](std::uint8_t scale, std::uint8_t root) {
-        const std::uint32_t packed =
-            (static_cast<std::uint32_t>(scale) << 8u) | static_cast<std::uint32_t>(root);
-        pendingQuantizeApply_.store(packed, std::memory_order_relaxed);
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kQuantize;
+        command.arg = scale;
+        command.root = root;
+        queueHostCommand(command);
       },
       [this](std::uint8_t seedIndex, std::int16_t delta) {
         if (seedIndex >= kDeferredSeedSlotCount) {
           return;
         }
-        const std::size_t slot = static_cast<std::size_t>(seedIndex);
-        pendingGranularSourceDelta_[slot].fetch_add(static_cast<int>(delta), std::memory_order_relaxed);
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kGranularSourceStep;
+        command.seedIndex = seedIndex;
+        command.steps = delta;
+        queueHostCommand(command);
       },
       [this](std::uint8_t division) {
-        pendingGateDivisionApply_.store(static_cast<int>(division), std::memory_order_relaxed);
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kGateDivision;
+        command.arg = division;
+        queueHostCommand(command);
+      },
+      [this](float floor) {
+        HostCommand command{};
+        command.kind = HostCommand::Kind::kGateFloor;
+        command.value = floor;
+        queueHostCommand(command);
       },
-      [this](float floor) { pendingGateFloorApply_.store(floor, std::memory_order_relaxed); },
   };
   if (hostControl_.handleParameterChange(parameterID, newValue, context)) {
     return;
@@ -572,6 +607,17 @@ void SeedboxAudioProcessor::applySeedEdit(const juce::Identifier& key, double va
   setSeedProp(static_cast<int>(focus), key, value);
 }
 
+bool SeedboxAudioProcessor::applySeedEdit(const juce::Identifier& key, SeedParam param, double value) {
+  const std::uint8_t focus = controlThreadApp_.focusSeed();
+  if (!queueSeedParamEdit(focus, param, static_cast<float>(value))) {
+    // Ring full: the overflow counter already noted it, and the next sync puts
+    // the control back on the seed's real value.
+    return false;
+  }
+  setSeedProp(static_cast<int>(focus), key, value);
+  return true;
+}
+
 void SeedboxAudioProcessor::syncSeedStateFromApp() {
   const auto& seeds = app_.seeds();
   for (std::size_t i = 0; i < seeds.size(); ++i) {
@@ -12,8 +12,10 @@
 
 #include "app/AppState.h"
 #include "app/Preset.h"
+#include "app/SeedParamMatrix.h"
 #include "juce/AppStateThreadViews.h"
 #include "juce/HostControlBridge.h"
+#include "util/MpscRing.h"
 
 namespace seedbox::juce_bridge {
 
@@ -65,10 +67,16 @@ class SeedboxAudioProcessor : public juce::AudioProcessor,
   void requestShutdown();
   void applySeedEdit(const juce::Identifier& key, double value,
                      const std::function<void(Seed&)>& applyFn);
+  // Focused-seed edit of one packed column.  Rides the host command ring via
+  // queueSeedParamEdit(), so it lands in order behind earlier host commands.
+  bool applySeedEdit(const juce::Identifier& key, SeedParam param, double value);
   juce::var getSeedProp(int idx, const juce::Identifier& key, juce::var defaultValue) const;
   void setPanelQuickPreset(const seedbox::Preset& preset);
   bool applyPanelQuickPreset();
   const std::optional<seedbox::Preset>& panelQuickPreset() const { return panelPreset_; }
+  // Thread-safe seed tweak: queued behind any earlier host commands and applied
+  // on the next maintenance tick.  Returns false if the command ring is full.
+  bool queueSeedParamEdit(std::uint8_t seedIndex, SeedParam param, float value);
   bool hostTransportPlaying() const { return hostControl_.hostPlaying(); }
   bool followHostTransportEnabled() const;
   std::uint32_t midiDroppedCount() const;
@@ -78,6 +86,29 @@ class SeedboxAudioProcessor : public juce::AudioProcessor,
   int preparedScratchFrames() const { return preparedScratchFrames_.load(std::memory_order_relaxed); }
 
  private:
+  // Deferred host work travels as typed commands through one bounded ring, so
+  // bursts keep every step and the order they arrived in, across kinds.
+  struct HostCommand {
+    enum class Kind : std::uint8_t {
+      kReseed,
+      kSeedEngine,
+      kQuantize,
+      kGranularSourceStep,
+      kGateDivision,
+      kGateFloor,
+      kSeedEdit,
+    };
+    Kind kind{Kind::kReseed};
+    std::uint8_t seedIndex{0};
+    std::uint8_t arg{0};      // engine id, quantize scale, gate division, or SeedParam column
+    std::uint8_t root{0};     // quantize root
+    std::int16_t steps{0};    // granular source step
+    std::uint32_t masterSeed{0};
+    float value{0.0f};        // gate floor or seed edit value
+    double stampMs{0.0};      // enqueue time, for the latency counter
+  };
+  static constexpr std::size_t kHostCommandCapacity = 256;
+
   struct BufferedMidiMessage {
     juce::MidiMessage message;
     int samplePosition{0};
@@ -127,6 +158,8 @@ class SeedboxAudioProcessor : public juce::AudioProcessor,
   juce::String serializePresetToBase64(const seedbox::Preset& preset) const;
   void prepareScratchBuffers(int samplesPerBlock);
   void flushDeferredHostParameterWork();
+  bool queueHostCommand(HostCommand command);
+  void applyHostCommand(const HostCommand& command, bool& seedStateDirty);
 
   AppState app_;
   HostAudioThreadAccess audioThreadApp_;
@@ -146,17 +179,10 @@ class SeedboxAudioProcessor : public juce::AudioProcessor,
   std::uint8_t quantizeScaleParam_{0};
   std::uint8_t quantizeRootParam_{0};
   bool testToneEnabled_{false};
-  std::atomic<bool> pendingSeedStateSync_{false};
-  // Deferred host parameters are either last-wins scalar commands or
-  // accumulating relative commands. The maintenance timer is the only consumer.
-  std::atomic<std::uint32_t> pendingMasterSeedReseed_{0xFFFFFFFFu};
-  std::atomic<std::uint32_t> pendingSeedEngineApply_{0xFFFFFFFFu};
-  std::atomic<std::uint32_t> pendingQuantizeApply_{0xFFFFFFFFu};
-  // Granular source changes are relative gestures, so each seed slot keeps its
-  // own accumulated delta until flush rather than collapsing to a final value.
-  std::array<std::atomic<int>, 4> pendingGranularSourceDelta_{};
-  std::atomic<int> pendingGateDivisionApply_{-1};
-  std::atomic<float> pendingGateFloorApply_{-1.0f};
+  // Filled from the host's parameter threads, drained only by the maintenance
+  // timer.  Overflow and depth are reported through hostDiagnostics().
+  util::MpscRing<HostCommand, kHostCommandCapacity> hostCommands_{};
+  std::atomic<std::uint32_t> hostCommandMaxLatencyUs_{0};
   std::atomic<int> preparedScratchFrames_{0};
   std::atomic<std::uint32_t> oversizeBlockDropCount_{0};
   std::atomic<int> lastOversizeBlockFrames_{0};
@@ -241,10 +241,8 @@ SeedsPageComponent::SeedsPageComponent(SeedboxAudioProcessor& processor) : PageC
   seedToneSlider_.setRange(0.0, 1.0, 0.01);
   seedToneSlider_.setTooltip("Per-seed tone skew; lives in the state tree so it saves/restores.");
   seedToneSlider_.onValueChange = [this]() {
-    processor_.applySeedEdit(juce::Identifier{"tone"}, seedToneSlider_.getValue(),
-                             [v = seedToneSlider_.getValue()](Seed& seed) {
-                               seed.tone = juce::jlimit(0.0f, 1.0f, static_cast<float>(v));
-                             });
+    processor_.applySeedEdit(juce::Identifier{"tone"}, SeedParam::kTone,
+                             juce::jlimit(0.0, 1.0, seedToneSlider_.getValue()));
   };
   addAndMakeVisible(seedToneSlider_);
 
@@ -253,10 +251,8 @@ SeedsPageComponent::SeedsPageComponent(SeedboxAudioProcessor& processor) : PageC
   seedProbabilitySlider_.setRange(0.0, 1.0, 0.01);
   seedProbabilitySlider_.setTooltip("Seed probability (focused seed only). Saves via ValueTree.");
   seedProbabilitySlider_.onValueChange = [this]() {
-    processor_.applySeedEdit(juce::Identifier{"probability"}, seedProbabilitySlider_.getValue(),
-                             [v = seedProbabilitySlider_.getValue()](Seed& seed) {
-                               seed.probability = juce::jlimit(0.0f, 1.0f, static_cast<float>(v));
-                             });
+    processor_.applySeedEdit(juce::Identifier{"probability"}, SeedParam::kProbability,
+                             juce::jlimit(0.0, 1.0, seedProbabilitySlider_.getValue()));
   };
   addAndMakeVisible(seedProbabilitySlider_);
 
@@ -272,30 +272,24 @@ SeedboxPanelView::SeedboxPanelView(SeedboxAudioProcessor& processor, juce::Audio
   setupKnob(densityKnob_, "Motion", "Rate / pulse");
   densityKnob_.knob.setRange(0.0, 8.0, 0.05);
   densityKnob_.knob.onValueChange = [this]() {
-    processor_.applySeedEdit(juce::Identifier{"density"}, densityKnob_.knob.getValue(),
-                             [v = densityKnob_.knob.getValue()](Seed& seed) {
-                               seed.density = juce::jlimit(0.0f, 8.0f, static_cast<float>(v));
-                             });
+    processor_.applySeedEdit(juce::Identifier{"density"}, SeedParam::kDensity,
+                             juce::jlimit(0.0, 8.0, densityKnob_.knob.getValue()));
     lastActive_ = &densityKnob_.knob;
   };
 
   setupKnob(toneKnob_, "Color", "Bright / soft");
   toneKnob_.knob.setRange(0.0, 1.0, 0.01);
   toneKnob_.knob.onValueChange = [this]() {
-    processor_.applySeedEdit(juce::Identifier{"tone"}, toneKnob_.knob.getValue(),
-                             [v = toneKnob_.knob.getValue()](Seed& seed) {
-                               seed.tone = juce::jlimit(0.0f, 1.0f, static_cast<float>(v));
-                             });
+    processor_.applySeedEdit(juce::Identifier{"tone"}, SeedParam::kTone,
+                             juce::jlimit(0.0, 1.0, toneKnob_.knob.getValue()));
     lastActive_ = &toneKnob_.knob;
   };
 
   setupKnob(fxKnob_, "Shape", "Turn=space  Press=mode");
   fxKnob_.knob.setRange(0.0, 1.0, 0.01);
   fxKnob_.knob.onValueChange = [this]() {
-    processor_.applySeedEdit(juce::Identifier{"spread"}, fxKnob_.knob.getValue(),
-                             [v = fxKnob_.knob.getValue()](Seed& seed) {
-                               seed.spread = juce::jlimit(0.0f, 1.0f, static_cast<float>(v));
-                             });
+    processor_.applySeedEdit(juce::Identifier{"spread"}, SeedParam::kSpread,
+                             juce::jlimit(0.0, 1.0, fxKnob_.knob.getValue()));
     lastActive_ = &fxKnob_.knob;
   };
   fxKnob_.knob.onPress = [this]() {
@@ -576,9 +570,10 @@ void SeedboxPanelView::refresh(bool displayDirty) {
   const auto diagnostics = app.diagnosticsSnapshot();
   const auto& host = diagnostics.host;
   juce::String clockStatus = "CLK " + clockMode + " | " + meter;
-  if (host.midiDroppedCount > 0u || host.oversizeBlockDropCount > 0u) {
+  if (host.midiDroppedCount > 0u || host.oversizeBlockDropCount > 0u || host.commandQueueOverflowCount > 0u) {
     clockStatus << " | WARN " << juce::String(static_cast<int>(host.midiDroppedCount)) << "/"
-                << juce::String(static_cast<int>(host.oversizeBlockDropCount));
+                << juce::String(static_cast<int>(host.oversizeBlockDropCount)) << "/"
+                << juce::String(static_cast<int>(host.commandQueueOverflowCount));
   }
   clockStatusLabel_.setText(clockStatus, juce::dontSendNotification);
 
@@ -51,18 +51,36 @@ void loop() {
 }
 
 #if !defined(ARDUINO) && !defined(PLATFORMIO_UNIT_TESTING) && !defined(UNIT_TEST)
+#include "app/NativeRuntimeLoop.h"
+#include "hal/hal_audio.h"
+
 // When PlatformIO targets the native toolchain there is no autogenerated
 // `main` shim like the Teensy toolchain provides.  We bolt on a tiny desktop
 // front door that mirrors the firmware life-cycle so the simulator can run.
 //
 // Tests bring their own harness with a custom `main`, so we duck out whenever
 // PlatformIO flags a unit-test compile.  That keeps the linker from seeing two
-// entry points while letting normal desktop builds keep spinning forever.
+// entry points.
+//
+// Instead of spinning `loop()` flat out, the desktop build sleeps until the
+// next deadline: one `loop()` per 24 PPQN scheduler tick at the current tempo
+// (which is what a tick means on hardware too) and one audio pump per block.
+// The loop's own timing stats land in the diagnostics snapshot once a beat.
 int main() {
   setup();
-  for (;;) {
+  NativeRuntimeLoop runtime;
+  NativeRuntimeLoop::TimerId controlTimer = 0;
+  std::uint64_t controlTicks = 0;
+  controlTimer = runtime.addTimer(NativeRuntimeLoop::periodForTicks(app.schedulerBpm()), [&]() {
     loop();
-  }
+    runtime.setTimerPeriod(controlTimer, NativeRuntimeLoop::periodForTicks(app.schedulerBpm()));
+    if (++controlTicks % 24u == 0u) {
+      app.setRuntimeLoopDiagnostics(runtime.stats());
+    }
+  });
+  runtime.addTimer(NativeRuntimeLoop::periodForFrames(hal::audio::framesPerBlock(), hal::audio::sampleRate()),
+                   []() { hal::audio::mockPump(hal::audio::framesPerBlock()); });
+  runtime.run();
   return 0;
 }
 #endif
@@ -1,7 +1,6 @@
 #include "ui/AsciiOledView.h"
 #include <cstdio>
 #include <sstream>
-#include "ui/TextFrame.h"
 
 namespace ui {
 
@@ -21,6 +20,11 @@ void AsciiOledView::present(const AppState::DisplaySnapshot& snapshot, const UiS
     return;
   }
   frames_.push_back(rendered);
+  lastDiff_ = DiffTextFrames(rendered_, frame);
+  lastFlushBytes_ = FlushBytes(lastDiff_);
+  totalFlushBytes_ += lastFlushBytes_;
+  totalFullFlushBytes_ += FullFlushBytes();
+  rendered_ = frame;
   if (log_) {
     std::printf("[oled:%zu]\n%s\n", frames_.size(), rendered.c_str());
     std::fflush(stdout);
@@ -8,8 +8,6 @@
 
 namespace {
 constexpr std::uint32_t kFlushIntervalUs = 1500;
-constexpr int16_t kLineHeight = 10;
-constexpr int16_t kStatusInsetY = 1;
 }
 
 namespace ui {
@@ -59,32 +57,44 @@ void OledView::flush() {
     return;
   }
 
-  display_->clearDisplay();
+  // No clearDisplay(): only the cells that changed since the last flush get
+  // cleared and redrawn.  The SH110X driver tracks the window touched since its
+  // last display() call and ships just those pages and columns, so pushing one
+  // span at a time keeps each I2C burst down to the rectangle that moved.
   display_->setTextSize(1);
   display_->setTextWrap(false);
 
-  int16_t y = 0;
-  for (std::size_t i = 0; i < pending_.lineCount; ++i) {
-    const bool statusLine = (i == 0);
-    const bool quietBanner = SeedBoxConfig::kQuietMode && (i == 1);
-    if (statusLine) {
-      display_->fillRect(0, 0, display_->width(), kLineHeight, SH110X_WHITE);
-      display_->setTextColor(SH110X_BLACK, SH110X_WHITE);
-      display_->setCursor(0, kStatusInsetY);
-    } else {
-      if (quietBanner) {
-        display_->fillRect(0, y, display_->width(), kLineHeight, SH110X_BLACK);
-        display_->setTextColor(SH110X_WHITE, SH110X_BLACK);
+  const FrameDiff diff = DiffTextFrames(rendered_, pending_);
+  for (std::size_t i = 0; i < diff.spanCount; ++i) {
+    const FrameDiff::Span& span = diff.spans[i];
+    const PixelRect rect = SpanRect(span);
+    if (rect.w <= 0 || rect.h <= 0) {
+      continue;
+    }
+    const bool present = span.line < pending_.lineCount;
+    const bool statusLine = (span.line == 0) && present;
+    const uint16_t background = statusLine ? SH110X_WHITE : SH110X_BLACK;
+    display_->fillRect(rect.x, rect.y, rect.w, rect.h, background);
+
+    if (present) {
+      char text[UiState::kTextColumns + 1]{};
+      const auto& line = pending_.lines[span.line];
+      std::size_t length = 0;
+      for (std::size_t column = span.firstColumn; column < span.endColumn && line[column] != '\0'; ++column) {
+        text[length++] = line[column];
+      }
+      if (statusLine) {
+        display_->setTextColor(SH110X_BLACK, SH110X_WHITE);
       } else {
-        display_->setTextColor(SH110X_WHITE);
+        display_->setTextColor(SH110X_WHITE, SH110X_BLACK);
       }
-      display_->setCursor(0, y);
+      display_->setCursor(static_cast<int16_t>(span.firstColumn * oled::kGlyphWidth),
+                          static_cast<int16_t>(rect.y + (statusLine ? oled::kStatusInsetY : 0)));
+      display_->print(text);
     }
-    display_->print(pending_.lines[i].data());
-    y = static_cast<int16_t>(y + kLineHeight);
+    display_->display();
   }
   display_->setTextColor(SH110X_WHITE);
-  display_->display();
 
   rendered_ = pending_;
   dirty_ = false;
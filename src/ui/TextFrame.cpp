@@ -143,5 +143,91 @@ bool operator==(const TextFrame& a, const TextFrame& b) {
   return true;
 }
 
-}  // namespace ui
+namespace {
+
+// Bytes after a line's terminator are not guaranteed to be zero, and lines past
+// `lineCount` are stale, so both read as blank.
+std::size_t lineLength(const TextFrame& frame, std::size_t line) {
+  if (line >= frame.lineCount) {
+    return 0;
+  }
+  const char* text = frame.lines[line].data();
+  return static_cast<std::size_t>(std::find(text, text + UiState::kTextColumns, '\0') - text);
+}
+
+}  // namespace
 
+FrameDiff DiffTextFrames(const TextFrame& before, const TextFrame& after) {
+  FrameDiff diff{};
+  const std::size_t lines = std::max(before.lineCount, after.lineCount);
+  for (std::size_t line = 0; line < lines && line < TextFrame::kMaxLines; ++line) {
+    const std::size_t beforeLen = lineLength(before, line);
+    const std::size_t afterLen = lineLength(after, line);
+    std::size_t first = UiState::kTextColumns;
+    std::size_t end = 0;
+    for (std::size_t column = 0; column < std::max(beforeLen, afterLen); ++column) {
+      const char was = column < beforeLen ? before.lines[line][column] : '\0';
+      const char now = column < afterLen ? after.lines[line][column] : '\0';
+      if (was != now) {
+        first = std::min(first, column);
+        end = column + 1;
+      }
+    }
+    const bool barToggled = (line == 0) && ((before.lineCount == 0) != (after.lineCount == 0));
+    if (end == 0 && !barToggled) {
+      continue;
+    }
+    auto& span = diff.spans[diff.spanCount++];
+    span.line = static_cast<std::uint8_t>(line);
+    span.firstColumn = static_cast<std::uint8_t>(end == 0 ? 0 : first);
+    span.endColumn = static_cast<std::uint8_t>(end == 0 ? UiState::kTextColumns : end);
+    span.fullWidth = barToggled;
+  }
+  return diff;
+}
+
+PixelRect SpanRect(const FrameDiff::Span& span) {
+  PixelRect rect{};
+  rect.y = static_cast<std::int16_t>(span.line * oled::kLineHeight);
+  rect.h = oled::kLineHeight;
+  if (span.fullWidth) {
+    rect.x = 0;
+    rect.w = oled::kPanelWidth;
+  } else {
+    rect.x = static_cast<std::int16_t>(span.firstColumn * oled::kGlyphWidth);
+    rect.w = static_cast<std::int16_t>((span.endColumn - span.firstColumn) * oled::kGlyphWidth);
+  }
+  if (rect.y >= oled::kPanelHeight) {
+    rect.h = 0;
+  } else if (rect.y + rect.h > oled::kPanelHeight) {
+    rect.h = static_cast<std::int16_t>(oled::kPanelHeight - rect.y);
+  }
+  if (rect.x + rect.w > oled::kPanelWidth) {
+    rect.w = static_cast<std::int16_t>(oled::kPanelWidth - rect.x);
+  }
+  return rect;
+}
+
+std::size_t FlushBytes(const PixelRect& rect) {
+  if (rect.w <= 0 || rect.h <= 0) {
+    return 0;
+  }
+  const std::size_t firstPage = static_cast<std::size_t>(rect.y / oled::kPageHeight);
+  const std::size_t lastPage = static_cast<std::size_t>((rect.y + rect.h - 1) / oled::kPageHeight);
+  const std::size_t pages = lastPage - firstPage + 1;
+  return pages * (oled::kPageCommandBytes + static_cast<std::size_t>(rect.w));
+}
+
+std::size_t FlushBytes(const FrameDiff& diff) {
+  std::size_t bytes = 0;
+  for (std::size_t i = 0; i < diff.spanCount; ++i) {
+    bytes += FlushBytes(SpanRect(diff.spans[i]));
+  }
+  return bytes;
+}
+
+std::size_t FullFlushBytes() {
+  return FlushBytes(PixelRect{0, 0, oled::kPanelWidth, oled::kPanelHeight});
+}
+
+}  // namespace ui
@@ -0,0 +1,204 @@
+#pragma once
+
+//
+// CaptureRing.h
+// -------------
+// A rolling tape loop of the last few seconds of live input.  The audio thread
+// appends every input block; grains and exciters then reach back into it at
+// any fractional position ("0.37 s ago, plus a bit") instead of only seeing the
+// block that is flying past right now.  It is the desktop twin of the memory
+// AudioEffectGranular keeps on the Teensy.
+//
+// Rules of the road:
+// - `prepare()` is the only call that allocates.  It rounds the length up to a
+//   power of two so wrapping is a mask, not a modulo.
+// - Exactly one thread writes (the audio callback).  The write head is an
+//   atomic, so any other thread may read `writeHead()`/`available()` and peek
+//   at samples without a lock.  A reader should stay at least one block behind
+//   the head, since that is the part the writer is about to overwrite.
+// - Every shared counter is 32 bits.  A Cortex-M7 has no lock-free 64-bit
+//   atomics, so the head wraps after 2^32 frames (about a day at 48 kHz).
+//   Distances are taken as `head - at` in unsigned 32-bit maths, which stays
+//   right across the wrap as long as nobody looks further back than the ring.
+// - `setFrozen(true)` holds the loop: writes are counted but dropped, so the
+//   captured window stays put for as long as you like.
+// - `markOnset()` drops a marker at the current head.  AppState calls it when
+//   InputGateMonitor sees the input open, so grains can land on attacks
+//   instead of in the gaps between them.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+class CaptureRing {
+public:
+  static constexpr std::size_t kOnsetSlots = 16;
+
+  CaptureRing() = default;
+  CaptureRing(const CaptureRing&) = delete;
+  CaptureRing& operator=(const CaptureRing&) = delete;
+
+  // Allocate room for at least `seconds` of stereo audio and clear it.  Zero
+  // seconds releases the buffers; the ring then swallows writes silently.
+  void prepare(float seconds, float sampleRate) {
+    const float rate = sampleRate > 0.0f ? sampleRate : 48000.0f;
+    const float wanted = std::max(0.0f, seconds) * rate;
+    std::size_t frames = 0;
+    if (wanted >= 1.0f) {
+      frames = 1;
+      while (static_cast<float>(frames) < wanted) {
+        frames <<= 1u;
+      }
+    }
+    seconds_ = std::max(0.0f, seconds);
+    sampleRate_ = rate;
+    left_.assign(frames, 0.0f);
+    right_.assign(frames, 0.0f);
+    mask_ = frames > 0 ? frames - 1 : 0;
+    clear();
+  }
+
+  // Forget the captured audio and markers; keeps the allocation.
+  void clear() {
+    std::fill(left_.begin(), left_.end(), 0.0f);
+    std::fill(right_.begin(), right_.end(), 0.0f);
+    onsets_.fill(0);
+    onsetCount_.store(0, std::memory_order_relaxed);
+    heldFrames_.store(0, std::memory_order_relaxed);
+    head_.store(0, std::memory_order_release);
+    filled_.store(0, std::memory_order_release);
+  }
+
+  // Audio thread.  `right` may be null for mono input.
+  void write(const float* left, const float* right, std::size_t frames) {
+    if (!left || frames == 0 || left_.empty()) {
+      return;
+    }
+    if (frozen_.load(std::memory_order_relaxed)) {
+      heldFrames_.fetch_add(static_cast<std::uint32_t>(frames), std::memory_order_relaxed);
+      return;
+    }
+    const float* r = right ? right : left;
+    std::uint32_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t filled = std::min(left_.size(), filled_.load(std::memory_order_relaxed) + frames);
+    // Only the newest `capacity` frames can survive a long block anyway.
+    if (frames > left_.size()) {
+      const std::size_t skip = frames - left_.size();
+      left += skip;
+      r += skip;
+      head += static_cast<std::uint32_t>(skip);
+      frames = left_.size();
+    }
+    std::size_t pos = static_cast<std::size_t>(head & mask_);
+    std::size_t remaining = frames;
+    while (remaining > 0) {
+      const std::size_t run = std::min(remaining, left_.size() - pos);
+      std::copy(left, left + run, left_.begin() + static_cast<std::ptrdiff_t>(pos));
+      std::copy(r, r + run, right_.begin() + static_cast<std::ptrdiff_t>(pos));
+      left += run;
+      r += run;
+      remaining -= run;
+      pos = 0;
+    }
+    head_.store(head + static_cast<std::uint32_t>(frames), std::memory_order_release);
+    // After the head, so a reader that sees the new fill level also sees the
+    // frames behind it.
+    filled_.store(static_cast<std::uint32_t>(filled), std::memory_order_release);
+  }
+
+  void setFrozen(bool frozen) { frozen_.store(frozen, std::memory_order_relaxed); }
+  bool frozen() const { return frozen_.load(std::memory_order_relaxed); }
+  // Frames dropped on the floor while frozen, for meters and tests.  Wraps
+  // like the head.
+  std::uint32_t heldFrames() const { return heldFrames_.load(std::memory_order_relaxed); }
+
+  // Audio thread.  Marks "something started here" at the current head.
+  // Ignored while frozen: the held window has no new attacks in it.
+  void markOnset() {
+    if (left_.empty() || frozen()) {
+      return;
+    }
+    const std::uint32_t count = onsetCount_.load(std::memory_order_relaxed);
+    onsets_[count % kOnsetSlots] = head_.load(std::memory_order_relaxed);
+    onsetCount_.store(count + 1, std::memory_order_release);
+  }
+
+  // Markers still inside the captured window, newest first.
+  std::size_t onsetCount() const {
+    const std::uint32_t total = onsetCount_.load(std::memory_order_acquire);
+    const std::size_t recent = std::min<std::size_t>(total, kOnsetSlots);
+    std::size_t live = 0;
+    while (live < recent && onsetFramesAgo(live) <= static_cast<float>(available())) {
+      ++live;
+    }
+    return live;
+  }
+
+  // How far behind the head marker `index` (0 = newest) sits, in frames.
+  float onsetFramesAgo(std::size_t index) const {
+    const std::uint32_t total = onsetCount_.load(std::memory_order_acquire);
+    if (index >= kOnsetSlots || index >= total) {
+      return -1.0f;
+    }
+    const std::uint32_t at = onsets_[(total - 1 - index) % kOnsetSlots];
+    const std::uint32_t ago = head_.load(std::memory_order_acquire) - at;
+    return static_cast<float>(ago);
+  }
+
+  // Stereo sample `framesAgo` behind the head, linearly interpolated.  One
+  // frame ago is the newest sample; anything outside the captured window
+  // reads as silence.
+  void read(float framesAgo, float& left, float& right) const {
+    left = 0.0f;
+    right = 0.0f;
+    const std::size_t have = available();
+    if (have == 0 || !(framesAgo >= 1.0f) || framesAgo > static_cast<float>(have)) {
+      return;
+    }
+    const std::uint32_t head = head_.load(std::memory_order_acquire);
+    const float whole = std::floor(framesAgo);
+    const float frac = framesAgo - whole;
+    const auto back = static_cast<std::uint32_t>(whole);
+    // framesAgo sits between sample `back` ago (newer) and `back + 1` ago.
+    const std::size_t newer = static_cast<std::size_t>((head - back) & mask_);
+    const float l0 = left_[newer];
+    const float r0 = right_[newer];
+    if (frac <= 0.0f || back + 1 > have) {
+      left = l0;
+      right = r0;
+      return;
+    }
+    const std::size_t older = static_cast<std::size_t>((head - back - 1) & mask_);
+    left = l0 + (left_[older] - l0) * frac;
+    right = r0 + (right_[older] - r0) * frac;
+  }
+
+  // Frames written since the last clear(), modulo 2^32.
+  std::uint32_t writeHead() const { return head_.load(std::memory_order_acquire); }
+  std::size_t capacityFrames() const { return left_.size(); }
+  std::size_t available() const { return filled_.load(std::memory_order_acquire); }
+  float seconds() const { return seconds_; }
+  float sampleRate() const { return sampleRate_; }
+
+private:
+  std::vector<float> left_{};
+  std::vector<float> right_{};
+  std::size_t mask_{0};
+  float seconds_{0.0f};
+  float sampleRate_{48000.0f};
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "CaptureRing needs lock-free 32-bit atomics");
+
+  std::atomic<std::uint32_t> head_{0};
+  std::atomic<std::uint32_t> filled_{0};  // min(frames written, capacity)
+  std::atomic<std::uint32_t> heldFrames_{0};
+  std::atomic<bool> frozen_{false};
+  std::array<std::uint32_t, kOnsetSlots> onsets_{};
+  std::atomic<std::uint32_t> onsetCount_{0};
+};
+
+}  // namespace util
@@ -0,0 +1,114 @@
+#pragma once
+
+//
+// MpscRing.h
+// ----------
+// Bounded many-producer / single-consumer queue.  Any number of threads may
+// push; exactly one thread pops, and it sees every accepted item in the order
+// the producers claimed their slots.  Nothing allocates after construction and
+// nothing ever blocks: a push either lands or bumps the overflow counter and
+// reports failure, so an automation storm costs dropped commands, not a stalled
+// host thread.
+//
+// The layout is the classic per-cell sequence ring: each cell remembers which
+// "lap" it is ready for.  A producer claims a position with one CAS on the
+// tail, writes the payload, then publishes by bumping the cell's sequence.
+// The consumer only ever reads its own head and the cell it points at, so the
+// pop side is wait-free; producers retry only when another producer won the
+// same slot a moment earlier.
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+template <typename T, std::size_t Capacity>
+class MpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscRing capacity must be a power of two");
+
+public:
+  MpscRing() {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  static constexpr std::size_t capacity() { return Capacity; }
+
+  // Any thread.  Returns false (and counts an overflow) when the ring is full.
+  bool push(const T& value) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+      cell = &cells_[pos & kMask];
+      const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto lap = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (lap == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lap < 0) {
+        // The consumer has not freed this cell from the previous lap yet.
+        overflowCount_.fetch_add(1u, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    notePending(pos + 1);
+    return true;
+  }
+
+  // Consumer thread only.  A slot that was claimed but not yet published stops
+  // the pop there, which is what keeps the output in claim order.
+  bool pop(T& out) {
+    Cell& cell = cells_[head_ & kMask];
+    if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    out = cell.value;
+    cell.sequence.store(head_ + Capacity, std::memory_order_release);
+    ++head_;
+    headSnapshot_.store(head_, std::memory_order_relaxed);
+    return true;
+  }
+
+  std::uint32_t overflowCount() const { return overflowCount_.load(std::memory_order_relaxed); }
+  // Deepest backlog seen so far; handy for sizing the ring from real sessions.
+  std::uint32_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr std::size_t kMask = Capacity - 1;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    T value{};
+  };
+
+  void notePending(std::size_t published) {
+    const std::size_t head = headSnapshot_.load(std::memory_order_relaxed);
+    // The snapshot can trail the real head by a pop, so clamp to the ring size.
+    std::size_t pending = published > head ? published - head : 0u;
+    pending = pending > Capacity ? Capacity : pending;
+    const auto depth = static_cast<std::uint32_t>(pending);
+    std::uint32_t seen = highWater_.load(std::memory_order_relaxed);
+    while (depth > seen && !highWater_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::array<Cell, Capacity> cells_{};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::size_t head_{0};
+  // Consumer position mirrored for producers; only feeds highWater().
+  std::atomic<std::size_t> headSnapshot_{0};
+  std::atomic<std::uint32_t> overflowCount_{0};
+  std::atomic<std::uint32_t> highWater_{0};
+};
+
+}  // namespace util
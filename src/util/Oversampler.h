@@ -0,0 +1,274 @@
+#pragma once
+
+//
+// Oversampler.h
+// -------------
+// `tanh` is the seedBox house saturator: Burst, the resonator's host comb and
+// the plugin's output safety all squash their sum through it.  A saturator
+// makes harmonics, and at the base rate every harmonic above Nyquist folds
+// back down as an inharmonic whistle.  A hot 5 kHz input at 48 kHz puts its
+// 5th harmonic at 25 kHz, which comes back at 23 kHz, and its 7th lands on
+// 13 kHz.  That is the grit you hear on loud input.
+//
+// The cure is to run the nonlinearity faster than the host does.  Upsample
+// 2x or 4x, saturate at that rate, low-pass away everything above the
+// original Nyquist, and only then decimate.  The new harmonics now have room
+// to exist and get filtered out instead of folding.
+//
+// Both directions use half-band filters.  Half the taps of a half-band low-pass
+// are zero and the centre tap is exactly 0.5, so the polyphase form does
+// half the work of an ordinary FIR.  4x is two 2x stages in a row.  The second
+// stage only has to reject images of content already under the first stage's
+// passband, so it gets away with a much shorter filter.
+//
+// Two filter families, picked per stage:
+// - Phase::kLinear: Kaiser-windowed FIR half-bands.  Every frequency is delayed
+//   by the same `latency()` samples, so the oversampled path lines up with a
+//   dry copy.  That is the offline choice.
+// - Phase::kMinimum: polyphase IIR half-bands, two chains of first-order
+//   allpasses (the elliptic design popularised by Laurent de Soras' HIIR).
+//   There is no pre-ringing and only a few samples of delay, at the cost of
+//   phase shift near the top of the band.  Several times cheaper than the FIR,
+//   so this is the realtime choice.
+//
+// All state is fixed-size arrays inside the object: no heap, no locks.
+// `setQuality()` only copies a preset and clears history, so a control thread
+// may flip it between blocks.  Stereo callers own one Oversampler per channel.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// Polyphase IIR half-band, `N` allpass coefficients split across two paths.
+// The low-pass is 0.5 * (A0(z^2) + z^-1 * A1(z^2)), where A0 takes the even
+// coefficients and A1 the odd ones, each a chain of (c + z^-1) / (1 + c z^-1).
+template <std::size_t N>
+class HalfbandIir {
+public:
+  explicit HalfbandIir(const std::array<float, N>& coefs) : coefs_(coefs) {}
+
+  void reset() {
+    upState_ = State{};
+    downState_ = State{};
+  }
+
+  // One input sample in, two output samples out (earlier one first).
+  void up(float in, float& out0, float& out1) {
+    out0 = chain(upState_, 0, in);
+    out1 = chain(upState_, 1, in);
+  }
+
+  // Two input samples in (earlier one first), one output sample out.
+  float down(float in0, float in1) { return 0.5f * (chain(downState_, 0, in1) + chain(downState_, 1, in0)); }
+
+private:
+  // Previous input and output of every allpass section.
+  struct State {
+    std::array<float, N> x1{};
+    std::array<float, N> y1{};
+  };
+
+  float chain(State& state, std::size_t path, float x) const {
+    for (std::size_t i = path; i < N; i += 2) {
+      const float y = coefs_[i] * (x - state.y1[i]) + state.x1[i];
+      state.x1[i] = x;
+      state.y1[i] = y;
+      x = y;
+    }
+    return x;
+  }
+
+  std::array<float, N> coefs_;
+  State upState_{};
+  State downState_{};
+};
+
+// Linear-phase FIR half-band with 4K - 1 taps.  `side` holds the K non-zero
+// taps left of centre, nearest the edge first.  The filter is symmetric, so
+// they are mirrored on the right.  The centre tap is 0.5, which makes one
+// polyphase branch a pure delay.
+template <std::size_t K>
+class HalfbandFir {
+public:
+  static constexpr std::size_t kBranch = 2 * K;
+
+  explicit HalfbandFir(const std::array<float, K>& side) {
+    for (std::size_t j = 0; j < K; ++j) {
+      taps_[j] = side[j];
+      taps_[kBranch - 1 - j] = side[j];
+    }
+  }
+
+  void reset() {
+    upHistory_.fill(0.0f);
+    oddHistory_.fill(0.0f);
+    evenHistory_.fill(0.0f);
+    upPos_ = 0;
+    downPos_ = 0;
+  }
+
+  // Output delay of one pass, in samples at the higher of the two rates.
+  static constexpr std::size_t latency() { return 2 * K - 1; }
+
+  void up(float in, float& out0, float& out1) {
+    upPos_ = step(upPos_);
+    write(upHistory_, upPos_, in);
+    out0 = 2.0f * dot(upHistory_.data() + upPos_);
+    out1 = upHistory_[upPos_ + K - 1];
+  }
+
+  float down(float in0, float in1) {
+    downPos_ = step(downPos_);
+    write(evenHistory_, downPos_, in0);
+    write(oddHistory_, downPos_, in1);
+    return dot(evenHistory_.data() + downPos_) + 0.5f * oddHistory_[downPos_ + K];
+  }
+
+private:
+  // Each history is written twice, kBranch apart, so the newest kBranch
+  // samples are always contiguous from `pos` onward, newest first.
+  using History = std::array<float, 2 * kBranch>;
+
+  // The write position walks backwards so reads run forwards in time order.
+  static std::size_t step(std::size_t pos) { return pos == 0 ? kBranch - 1 : pos - 1; }
+
+  static void write(History& history, std::size_t pos, float x) {
+    history[pos] = x;
+    history[pos + kBranch] = x;
+  }
+
+  float dot(const float* newestFirst) const {
+    float acc = 0.0f;
+    for (std::size_t j = 0; j < kBranch; ++j) {
+      acc += taps_[j] * newestFirst[j];
+    }
+    return acc;
+  }
+
+  std::array<float, kBranch> taps_{};
+  History upHistory_{};
+  History oddHistory_{};
+  History evenHistory_{};
+  std::size_t upPos_{0};
+  std::size_t downPos_{0};
+};
+
+class Oversampler {
+public:
+  enum class Factor : std::uint8_t { kOff = 1, k2x = 2, k4x = 4 };
+  enum class Phase : std::uint8_t { kMinimum, kLinear };
+
+  struct Quality {
+    Factor factor{Factor::kOff};
+    Phase phase{Phase::kMinimum};
+
+    bool operator==(const Quality& other) const { return factor == other.factor && phase == other.phase; }
+    bool operator!=(const Quality& other) const { return !(*this == other); }
+  };
+
+  // Plain base-rate saturation, bit-identical to calling the shaper directly.
+  static constexpr Quality kBypass{Factor::kOff, Phase::kMinimum};
+  // Cheap enough for every block inside a plugin host.
+  static constexpr Quality kRealtime{Factor::k2x, Phase::kMinimum};
+  // Cleanest result and a fixed delay, for bounces and tests.
+  static constexpr Quality kOffline{Factor::k4x, Phase::kLinear};
+
+  Oversampler()
+      : iirFirst_(kIirFirst), iirSecond_(kIirSecond), firFirst_(kFirFirst), firSecond_(kFirSecond) {}
+
+  void setQuality(const Quality& quality) {
+    quality_ = quality;
+    reset();
+  }
+  const Quality& quality() const { return quality_; }
+  bool active() const { return quality_.factor != Factor::kOff; }
+
+  // Clear filter history, e.g. when the host re-prepares or a voice restarts.
+  void reset() {
+    iirFirst_.reset();
+    iirSecond_.reset();
+    firFirst_.reset();
+    firSecond_.reset();
+  }
+
+  // Delay through up, shape and down, in base-rate samples.  Only the
+  // linear-phase path has a fixed delay; the IIR path reports 0.
+  float latency() const {
+    if (quality_.phase != Phase::kLinear || quality_.factor == Factor::kOff) {
+      return 0.0f;
+    }
+    float samples = static_cast<float>(FirFirst::latency());
+    if (quality_.factor == Factor::k4x) {
+      samples += 0.5f * static_cast<float>(FirSecond::latency());
+    }
+    return samples;
+  }
+
+  // Run `shape` (float -> float) on `x` at the selected rate and return one
+  // base-rate sample.
+  template <typename Shaper>
+  float process(float x, Shaper&& shape) {
+    switch (quality_.factor) {
+      case Factor::k2x:
+        return quality_.phase == Phase::kLinear ? twice(firFirst_, x, shape) : twice(iirFirst_, x, shape);
+      case Factor::k4x:
+        return quality_.phase == Phase::kLinear ? fourTimes(firFirst_, firSecond_, x, shape)
+                                                : fourTimes(iirFirst_, iirSecond_, x, shape);
+      case Factor::kOff:
+      default:
+        return shape(x);
+    }
+  }
+
+private:
+  // Stage one: 8 allpasses, 0.04 transition band, about 99 dB of rejection.
+  // Stage two sits behind it and only needs a 0.2 transition: 4 allpasses,
+  // about 100 dB.
+  static constexpr std::array<float, 8> kIirFirst{0.0406334609f, 0.1505051290f, 0.3007570560f, 0.4607745050f,
+                                                  0.6095243149f, 0.7385038411f, 0.8492238104f, 0.9497427837f};
+  static constexpr std::array<float, 4> kIirSecond{0.0495510353f, 0.1935703263f, 0.4267366888f, 0.7670700728f};
+  // Kaiser (beta 8.96) windowed sinc, rescaled for unity gain at DC.  Stage
+  // one: 95 taps, passband to 0.21 of the oversampled rate, about 91 dB of
+  // rejection.  Stage two: 23 taps, about 89 dB outside its wider band.
+  static constexpr std::array<float, 24> kFirFirst{
+      -6.4309211834e-06f, 2.3607887769e-05f, -5.7250945381e-05f, 1.1603160351e-04f, -2.1118594761e-04f,
+      3.5681724857e-04f,  -5.7017323137e-04f, 8.7191538109e-04f, -1.2864217785e-03f, 1.8422012178e-03f,
+      -2.5725520169e-03f, 3.5166879995e-03f, -4.7217046387e-03f, 6.2460285375e-03f, -8.1655099677e-03f,
+      1.0584372819e-02f,  -1.3655549773e-02f, 1.7620444173e-02f, -2.2892698769e-02f, 3.0254178417e-02f,
+      -4.1387207224e-02f, 6.0683976039e-02f, -1.0429224446e-01f, 3.1770266835e-01f};
+  static constexpr std::array<float, 6> kFirSecond{-2.7476952208e-05f, 1.0477826246e-03f, -6.7082700824e-03f,
+                                                   2.5387996461e-02f,  -7.7067496518e-02f, 3.0736746447e-01f};
+
+  using IirFirst = HalfbandIir<kIirFirst.size()>;
+  using IirSecond = HalfbandIir<kIirSecond.size()>;
+  using FirFirst = HalfbandFir<kFirFirst.size()>;
+  using FirSecond = HalfbandFir<kFirSecond.size()>;
+
+  template <typename Stage, typename Shaper>
+  static float twice(Stage& stage, float x, Shaper& shape) {
+    float a = 0.0f;
+    float b = 0.0f;
+    stage.up(x, a, b);
+    return stage.down(shape(a), shape(b));
+  }
+
+  template <typename First, typename Second, typename Shaper>
+  static float fourTimes(First& first, Second& second, float x, Shaper& shape) {
+    float a = 0.0f;
+    float b = 0.0f;
+    first.up(x, a, b);
+    // Named so the earlier sample is sure to go through `second` first.
+    const float early = twice(second, a, shape);
+    const float late = twice(second, b, shape);
+    return first.down(early, late);
+  }
+
+  Quality quality_{};
+  IirFirst iirFirst_;
+  IirSecond iirSecond_;
+  FirFirst firFirst_;
+  FirSecond firSecond_;
+};
+
+}  // namespace util
@@ -0,0 +1,149 @@
+#pragma once
+
+//
+// ParamRamp.h
+// -----------
+// Per-sample parameter glide.  Control surfaces (MN42 CC, the front panel, host
+// automation) move seed parameters in coarse steps: a 7-bit CC jumps 1/127 at a
+// time, and it lands between audio blocks.  If an engine copies that value
+// straight into a voice, every step becomes a discontinuity you can hear as
+// "zipper" noise.  A ParamRamp sits between the two: the control side sets a
+// target, the render loop calls `next()` once per sample, and the value glides
+// there over a fixed number of samples.
+//
+// The glide math reuses the control-rate helpers from Smoother.h, just clocked
+// at the sample rate instead of the control tick:
+// - Curve::kLinear drives a SlewLimiter whose step is sized so the ramp
+//   arrives in exactly `timeMs`.  Good for gains: equal steps, no overshoot.
+// - Curve::kOnePole drives a OnePoleSmoother whose time constant puts it within
+//   0.1% of the target after `timeMs`.  Good for filter-ish controls where the
+//   ear prefers an exponential approach.
+// Either way the ramp snaps onto the target when its sample budget runs out, so
+// a ramp costs work for exactly `timeMs` and then nothing but a branch.
+//
+// Targets may come from any thread: ParamTargetQueue is an MpscRing of
+// (seed, param, value) triples.  The engine drains it at the top of each render
+// block and points the matching voices at their new targets.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "util/MpscRing.h"
+#include "util/Smoother.h"
+
+namespace util {
+
+class ParamRamp {
+public:
+  enum class Curve : std::uint8_t { kLinear, kOnePole };
+
+  // ln(1000): a one-pole ramp that has run for this many time constants is
+  // within 0.1% of its target.
+  static constexpr float kOnePoleTimeConstants = 6.9077553f;
+  // Moves smaller than this are applied immediately instead of ramped.
+  static constexpr float kSettleEpsilon = 1.0e-6f;
+
+  // Pick the glide time and shape.  A ramp already in flight restarts from
+  // where it stands toward the same target on the new timing.
+  void configure(float timeMs, float sampleRate, Curve curve = Curve::kLinear) {
+    const float now = value();
+    const bool wasRamping = ramping();
+    timeMs_ = timeMs > 0.0f ? timeMs : 0.0f;
+    curve_ = curve;
+    const float rate = sampleRate > 0.0f ? sampleRate : 48000.0f;
+    const float samples = std::floor(timeMs_ * 0.001f * rate + 0.5f);
+    rampSamples_ = samples >= 1.0f ? static_cast<std::uint32_t>(samples) : 1u;
+    pole_.setAlpha(1.0f - std::exp(-kOnePoleTimeConstants / static_cast<float>(rampSamples_)));
+    const float goal = target_;
+    reset(now);
+    if (wasRamping) {
+      setTarget(goal);
+    }
+  }
+
+  // Jump straight to `value` with nothing left to ramp.
+  void reset(float value) {
+    target_ = value;
+    slew_.reset(value);
+    pole_.reset(value);
+    remaining_ = 0;
+  }
+
+  // Start a fresh glide from wherever the ramp is right now.
+  void setTarget(float target) {
+    const float from = value();
+    const float distance = std::fabs(target - from);
+    if (distance <= kSettleEpsilon) {
+      reset(target);
+      return;
+    }
+    target_ = target;
+    slew_.reset(from);
+    pole_.reset(from);
+    const float step = distance / static_cast<float>(rampSamples_);
+    slew_.setSteps(step, step);
+    remaining_ = rampSamples_;
+  }
+
+  // One sample of glide.  Settled ramps return the target untouched.
+  float next() {
+    if (remaining_ == 0) {
+      return target_;
+    }
+    if (--remaining_ == 0) {
+      reset(target_);
+      return target_;
+    }
+    return curve_ == Curve::kLinear ? slew_.process(target_) : pole_.process(target_);
+  }
+
+  // Skip `samples` of glide in O(1); used where a whole block shares one
+  // value (the Teensy mixer gains, say).
+  float advance(std::uint32_t samples) {
+    if (remaining_ == 0 || samples == 0) {
+      return value();
+    }
+    if (samples >= remaining_) {
+      reset(target_);
+      return target_;
+    }
+    remaining_ -= samples;
+    if (curve_ == Curve::kLinear) {
+      const float moved = slew_.riseStep * static_cast<float>(samples);
+      slew_.state += slew_.state < target_ ? moved : -moved;
+    } else {
+      pole_.state = target_ + (pole_.state - target_) * std::pow(1.0f - pole_.alpha, static_cast<float>(samples));
+    }
+    return value();
+  }
+
+  bool ramping() const { return remaining_ != 0; }
+  float value() const { return curve_ == Curve::kLinear ? slew_.state : pole_.state; }
+  float target() const { return target_; }
+  float timeMs() const { return timeMs_; }
+  Curve curve() const { return curve_; }
+  std::uint32_t rampSamples() const { return rampSamples_; }
+  std::uint32_t remainingSamples() const { return remaining_; }
+
+private:
+  SlewLimiter slew_{};
+  OnePoleSmoother pole_{};
+  float target_{0.0f};
+  float timeMs_{0.0f};
+  std::uint32_t rampSamples_{1};
+  std::uint32_t remaining_{0};
+  Curve curve_{Curve::kLinear};
+};
+
+// One queued "glide here" request.  `param` is engine-defined (Sampler::Param
+// and friends); `seedId` lets the engine find every voice that seed owns.
+struct ParamTarget {
+  std::uint32_t seedId{0};
+  std::uint16_t param{0};
+  float value{0.0f};
+};
+
+template <std::size_t Capacity = 64>
+using ParamTargetQueue = MpscRing<ParamTarget, Capacity>;
+
+}  // namespace util
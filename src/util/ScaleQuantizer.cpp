@@ -1,122 +1,129 @@
 #include "util/ScaleQuantizer.h"
 
-#include <algorithm>
 #include <cmath>
-#include <limits>
 
 namespace util {
 namespace {
-constexpr float kOctave = 12.0f;
-
-std::vector<int> MakeChromatic() {
-  std::vector<int> degrees(12);
-  for (int i = 0; i < 12; ++i) {
-    degrees[i] = i;
-  }
-  return degrees;
-}
-
-const std::vector<int>& ChromaticDegrees() {
-  static const std::vector<int> kChromatic = MakeChromatic();
-  return kChromatic;
-}
-
-const std::vector<int>& MajorDegrees() {
-  static const std::vector<int> kMajor{0, 2, 4, 5, 7, 9, 11};
-  return kMajor;
-}
-
-const std::vector<int>& MinorDegrees() {
-  static const std::vector<int> kMinor{0, 2, 3, 5, 7, 8, 10};
-  return kMinor;
-}
-
-const std::vector<int>& PentatonicMajorDegrees() {
-  static const std::vector<int> kPent{0, 2, 4, 7, 9};
-  return kPent;
-}
-
-const std::vector<int>& PentatonicMinorDegrees() {
-  static const std::vector<int> kPent{0, 3, 5, 7, 10};
-  return kPent;
-}
+constexpr int kOctave = 12;
 
 int ClampRoot(int root) {
-  const int normalized = root % 12;
-  return normalized < 0 ? normalized + 12 : normalized;
+  const int normalized = root % kOctave;
+  return normalized < 0 ? normalized + kOctave : normalized;
 }
 
-float CandidatePitch(int octave, int root, int degree) {
-  return static_cast<float>(octave * 12 + root + degree);
+// One pass over a block with the mode baked in at compile time, so the loop
+// body carries no mode switch.  `down`/`up` are the rows for the chosen root.
+template <QuantizerMode kMode>
+void SnapRun(const float* in, float* out, std::size_t n, const std::uint8_t* down, const std::uint8_t* up) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const float x = in[i];
+    if (!std::isfinite(x)) {
+      out[i] = x;
+      continue;
+    }
+    // floor(x) picks the pitch class; an off-grid pitch looks "up" from the
+    // next semitone because the one under it is already below x.
+    const float floored = std::floor(x);
+    const int pc = ClampRoot(static_cast<int>(floored));
+    const float below = floored - static_cast<float>(down[pc]);
+    if (kMode == QuantizerMode::kDown) {
+      out[i] = below;
+      continue;
+    }
+    const float above = (floored == x) ? floored + static_cast<float>(up[pc])
+                                       : floored + 1.0f + static_cast<float>(up[pc == kOctave - 1 ? 0 : pc + 1]);
+    if (kMode == QuantizerMode::kUp) {
+      out[i] = above;
+      continue;
+    }
+    // Ties go to the lower degree, matching the original octave scan.
+    out[i] = (above - x) < (x - below) ? above : below;
+  }
 }
 
 }  // namespace
 
-const std::vector<int>& ScaleQuantizer::DegreesFor(Scale scale) {
-  switch (scale) {
-    case Scale::kChromatic:
-      return ChromaticDegrees();
-    case Scale::kMajor:
-      return MajorDegrees();
-    case Scale::kMinor:
-      return MinorDegrees();
-    case Scale::kPentatonicMajor:
-      return PentatonicMajorDegrees();
-    case Scale::kPentatonicMinor:
-      return PentatonicMinorDegrees();
+ScaleQuantizer::Table::Table(Mask mask) : mask_(static_cast<Mask>(mask & kChromaticMask)) {
+  if (mask_ == 0) {
+    return;
   }
-  return ChromaticDegrees();
-}
-
-float ScaleQuantizer::Snap(float semitoneOffset, std::uint8_t root, Scale scale, int direction) {
-  const auto& degrees = DegreesFor(scale);
-  if (degrees.empty()) {
-    return semitoneOffset;
-  }
-
-  const int normalizedRoot = ClampRoot(root);
-  const float target = semitoneOffset;
-  const float relative = target - static_cast<float>(normalizedRoot);
-  const int baseOctave = static_cast<int>(std::floor(relative / kOctave));
-
-  float bestPitch = target;
-  float bestDistance = std::numeric_limits<float>::infinity();
-
-  for (int octave = baseOctave - 2; octave <= baseOctave + 2; ++octave) {
-    for (int degree : degrees) {
-      const float candidate = CandidatePitch(octave, normalizedRoot, degree);
-      const float delta = candidate - target;
-      const float absDelta = std::abs(delta);
-      if (direction > 0 && delta < 0.0f) {
-        continue;
-      }
-      if (direction < 0 && delta > 0.0f) {
-        continue;
+  // Brute force is fine here: 12 roots x 12 pitch classes x at most 11 steps,
+  // paid once per mask instead of once per note.
+  for (int root = 0; root < kOctave; ++root) {
+    for (int pc = 0; pc < kOctave; ++pc) {
+      const auto inScale = [&](int pitchClass) {
+        const int degree = ClampRoot(pitchClass - root);
+        return (mask_ >> degree) & 1u;
+      };
+      int down = 0;
+      while (!inScale(pc - down)) {
+        ++down;
       }
-      if (absDelta < bestDistance || (absDelta == bestDistance && candidate < bestPitch)) {
-        bestPitch = candidate;
-        bestDistance = absDelta;
+      int up = 0;
+      while (!inScale(pc + up)) {
+        ++up;
       }
+      down_[root][pc] = static_cast<std::uint8_t>(down);
+      up_[root][pc] = static_cast<std::uint8_t>(up);
     }
   }
+}
 
-  if (!std::isfinite(bestDistance)) {
-    return target;
+float ScaleQuantizer::Table::snap(float semitoneOffset, std::uint8_t root, QuantizerMode mode) const {
+  float out = semitoneOffset;
+  quantizeBlock(&semitoneOffset, &out, 1, root, mode);
+  return out;
+}
+
+void ScaleQuantizer::Table::quantizeBlock(const float* in, float* out, std::size_t n, std::uint8_t root,
+                                          QuantizerMode mode) const {
+  if (mask_ == 0) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = in[i];
+    }
+    return;
   }
-  return bestPitch;
+  const std::uint8_t* down = down_[ClampRoot(root)].data();
+  const std::uint8_t* up = up_[ClampRoot(root)].data();
+  switch (mode) {
+    case QuantizerMode::kUp:
+      SnapRun<QuantizerMode::kUp>(in, out, n, down, up);
+      break;
+    case QuantizerMode::kDown:
+      SnapRun<QuantizerMode::kDown>(in, out, n, down, up);
+      break;
+    case QuantizerMode::kNearest:
+    default:
+      SnapRun<QuantizerMode::kNearest>(in, out, n, down, up);
+      break;
+  }
+}
+
+const ScaleQuantizer::Table& ScaleQuantizer::TableFor(Scale scale) {
+  static const Table kTables[] = {
+      Table(MaskFor(Scale::kChromatic)),       Table(MaskFor(Scale::kMajor)),
+      Table(MaskFor(Scale::kMinor)),           Table(MaskFor(Scale::kPentatonicMajor)),
+      Table(MaskFor(Scale::kPentatonicMinor)),
+  };
+  const auto index = static_cast<std::size_t>(scale);
+  return kTables[index < sizeof(kTables) / sizeof(kTables[0]) ? index : 0];
 }
 
 float ScaleQuantizer::SnapToScale(float semitoneOffset, std::uint8_t root, Scale scale) {
-  return Snap(semitoneOffset, root, scale, 0);
+  return TableFor(scale).snap(semitoneOffset, root, QuantizerMode::kNearest);
 }
 
 float ScaleQuantizer::SnapUp(float semitoneOffset, std::uint8_t root, Scale scale) {
-  return Snap(semitoneOffset, root, scale, 1);
+  return TableFor(scale).snap(semitoneOffset, root, QuantizerMode::kUp);
 }
 
 float ScaleQuantizer::SnapDown(float semitoneOffset, std::uint8_t root, Scale scale) {
-  return Snap(semitoneOffset, root, scale, -1);
+  return TableFor(scale).snap(semitoneOffset, root, QuantizerMode::kDown);
 }
 
-}  // namespace util
+void ScaleQuantizer::QuantizeBlock(const float* in, float* out, std::size_t n, std::uint8_t root, Scale scale,
+                                   QuantizerMode mode) {
+  TableFor(scale).quantizeBlock(in, out, n, root, mode);
+}
 
+}  // namespace util
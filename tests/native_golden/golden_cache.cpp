@@ -0,0 +1,260 @@
+#include "golden_cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace golden {
+
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+// Bump when the entry layout or the key recipe changes; old entries then miss.
+constexpr const char* kEntryMagic = "seedbox-golden-cache 1";
+
+std::uint64_t fnv1a(std::uint64_t state, std::string_view bytes) {
+    for (unsigned char c : bytes) {
+        state ^= static_cast<std::uint64_t>(c);
+        state *= kFnvPrime;
+    }
+    return state;
+}
+
+std::string to_hex(std::uint64_t value) {
+    std::ostringstream oss;
+    oss << std::hex << std::nouppercase << std::setfill('0') << std::setw(16) << value;
+    return oss.str();
+}
+
+bool read_file(const std::filesystem::path& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Quoted includes only: angle-bracket headers are the toolchain's business.
+std::vector<std::string> quoted_includes(const std::string& source) {
+    std::vector<std::string> includes;
+    std::istringstream lines(source);
+    std::string line;
+    while (std::getline(lines, line)) {
+        const auto first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] != '#') {
+            continue;
+        }
+        const auto directive = line.find("include", first);
+        if (directive == std::string::npos) {
+            continue;
+        }
+        const auto open = line.find('"', directive);
+        if (open == std::string::npos) {
+            continue;
+        }
+        const auto close = line.find('"', open + 1);
+        if (close == std::string::npos) {
+            continue;
+        }
+        includes.push_back(line.substr(open + 1, close - open - 1));
+    }
+    return includes;
+}
+
+}  // namespace
+
+std::string hash_file(const std::filesystem::path& path) {
+    std::string bytes;
+    if (!read_file(path, bytes)) {
+        return {};
+    }
+    return to_hex(fnv1a(kFnvOffset, bytes));
+}
+
+CacheKeyBuilder::CacheKeyBuilder(std::filesystem::path project_root)
+    : root_(std::move(project_root)), state_(kFnvOffset) {
+    mix(kEntryMagic);
+}
+
+void CacheKeyBuilder::mix(std::string_view bytes) {
+    // Length-prefix every field so ("ab","c") and ("a","bc") key differently.
+    const std::string length = std::to_string(bytes.size()) + ':';
+    state_ = fnv1a(state_, length);
+    state_ = fnv1a(state_, bytes);
+}
+
+CacheKeyBuilder& CacheKeyBuilder::add(std::string_view label, std::string_view value) {
+    mix(label);
+    mix(value);
+    return *this;
+}
+
+CacheKeyBuilder& CacheKeyBuilder::add(std::string_view label, std::uint64_t value) {
+    return add(label, std::to_string(value));
+}
+
+CacheKeyBuilder& CacheKeyBuilder::add_source_closure(std::string_view relative_path) {
+    std::vector<std::filesystem::path> pending{root_ / std::filesystem::path(relative_path)};
+    while (!pending.empty()) {
+        const std::filesystem::path path = pending.back().lexically_normal();
+        pending.pop_back();
+        const std::string rel = path.lexically_relative(root_).generic_string();
+        if (std::find(visited_.begin(), visited_.end(), rel) != visited_.end()) {
+            continue;
+        }
+        visited_.push_back(rel);
+
+        std::string source;
+        if (!read_file(path, source)) {
+            add("missing", rel);
+            continue;
+        }
+        add("source", rel);
+        mix(source);
+
+        for (const auto& include : quoted_includes(source)) {
+            const std::filesystem::path candidates[] = {
+                path.parent_path() / include,
+                root_ / "include" / include,
+                root_ / "src" / include,
+                root_ / include,
+            };
+            for (const auto& candidate : candidates) {
+                std::error_code ec;
+                if (std::filesystem::is_regular_file(candidate, ec)) {
+                    pending.push_back(candidate);
+                    break;
+                }
+            }
+            // Unresolved includes (Teensy headers in HW-only branches) are
+            // not part of a desktop render, so they do not key anything.
+        }
+    }
+    return *this;
+}
+
+std::string CacheKeyBuilder::finish() const {
+    return to_hex(state_);
+}
+
+FixtureCache::FixtureCache(std::filesystem::path project_root, std::filesystem::path cache_root, bool enabled)
+    : project_root_(std::move(project_root)), cache_root_(std::move(cache_root)), enabled_(enabled) {}
+
+std::filesystem::path FixtureCache::entry_path(const std::string& fixture) const {
+    return cache_root_ / "entries" / (fixture + ".txt");
+}
+
+std::filesystem::path FixtureCache::object_path(const std::string& object) const {
+    return cache_root_ / "objects" / object;
+}
+
+bool FixtureCache::lookup(const std::string& fixture,
+                          const std::string& key,
+                          std::vector<CacheArtifact>& out) const {
+    out.clear();
+    if (!enabled_) {
+        return false;
+    }
+    std::ifstream in(entry_path(fixture));
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    if (!std::getline(in, line) || line != kEntryMagic) {
+        return false;
+    }
+    if (!std::getline(in, line) || line != "key " + key) {
+        return false;
+    }
+    std::vector<CacheArtifact> artifacts;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string tag;
+        CacheArtifact artifact;
+        if (!(fields >> tag >> artifact.object >> artifact.manifest_hash >> artifact.fixture >> artifact.path) ||
+            tag != "artifact") {
+            return false;
+        }
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(object_path(artifact.object), ec)) {
+            return false;
+        }
+        artifacts.push_back(std::move(artifact));
+    }
+    if (artifacts.empty()) {
+        return false;
+    }
+
+    // Every object is present; now make the tree match them.
+    for (const auto& artifact : artifacts) {
+        const auto target = project_root_ / artifact.path;
+        if (hash_file(target) == artifact.object) {
+            continue;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(target.parent_path(), ec);
+        std::filesystem::copy_file(object_path(artifact.object), target,
+                                   std::filesystem::copy_options::overwrite_existing, ec);
+        if (ec) {
+            return false;
+        }
+    }
+    out = std::move(artifacts);
+    return true;
+}
+
+bool FixtureCache::store(const std::string& fixture,
+                         const std::string& key,
+                         std::vector<CacheArtifact>& artifacts) const {
+    if (!enabled_ || artifacts.empty()) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(cache_root_ / "objects", ec);
+    std::filesystem::create_directories(cache_root_ / "entries", ec);
+    if (ec) {
+        return false;
+    }
+    for (auto& artifact : artifacts) {
+        const auto source = project_root_ / artifact.path;
+        artifact.object = hash_file(source);
+        if (artifact.object.empty()) {
+            return false;
+        }
+        const auto object = object_path(artifact.object);
+        if (!std::filesystem::exists(object, ec)) {
+            std::filesystem::copy_file(source, object, ec);
+            if (ec) {
+                return false;
+            }
+        }
+    }
+    // Write the entry last and swap it in, so an interrupted run leaves the
+    // previous entry (or none) rather than a half-written one.
+    const auto entry = entry_path(fixture);
+    const auto staging = entry.string() + ".tmp";
+    {
+        std::ofstream outFile(staging, std::ios::trunc);
+        if (!outFile) {
+            return false;
+        }
+        outFile << kEntryMagic << '\n' << "key " << key << '\n';
+        for (const auto& artifact : artifacts) {
+            outFile << "artifact " << artifact.object << ' ' << artifact.manifest_hash << ' ' << artifact.fixture
+                    << ' ' << artifact.path << '\n';
+        }
+        if (!outFile.good()) {
+            return false;
+        }
+    }
+    std::filesystem::rename(staging, entry, ec);
+    return !ec;
+}
+
+}  // namespace golden
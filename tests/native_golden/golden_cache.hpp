@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace golden {
+
+//! Incremental, content-addressed cache for golden fixture renders.
+//!
+//! Every fixture render is keyed by a hash of what it *reads*: the fixture
+//! definition (name, channels, sample rate, seed/tone parameters), a recipe
+//! revision the render routine owns, and the bytes of every engine source the
+//! routine compiles against. Source files are followed through their quoted
+//! `#include`s, so touching `Resonator.h` re-keys the resonator fixtures and
+//! nothing else.
+//!
+//! Artifacts (WAVs and control logs) land in `objects/<fnv>` under the cache
+//! root, named by the FNV-1a hash of their bytes. A hit restores any missing or
+//! edited file in `build/fixtures/` from the object store and hands back the
+//! manifest hashes recorded at render time, so the caller can still report
+//! `[ok]`/`[delta]` without rendering. Everything lives on local disk under
+//! `build/`; nothing touches the network.
+struct CacheArtifact {
+    std::string fixture;        // manifest name ("sampler-grains-control")
+    std::string path;           // repo-relative path ("build/fixtures/...")
+    std::string manifest_hash;  // hash_pcm16 / hash_bytes value golden.json compares
+    std::string object;         // FNV-1a of the file bytes; object store name
+};
+
+//! Folds labelled strings and source files into one 64-bit FNV-1a key.
+class CacheKeyBuilder {
+public:
+    explicit CacheKeyBuilder(std::filesystem::path project_root);
+
+    CacheKeyBuilder& add(std::string_view label, std::string_view value);
+    CacheKeyBuilder& add(std::string_view label, std::uint64_t value);
+    //! Hash `relative_path` plus every quoted include it reaches (searched next
+    //! to the including file, then `include/`, `src/` and the repo root).
+    //! Missing files hash as a marker, so deleting one still changes the key.
+    CacheKeyBuilder& add_source_closure(std::string_view relative_path);
+
+    std::string finish() const;
+
+private:
+    void mix(std::string_view bytes);
+
+    std::filesystem::path root_;
+    std::uint64_t state_;
+    std::vector<std::string> visited_;
+};
+
+class FixtureCache {
+public:
+    //! `cache_root` is usually `<repo>/build/golden-cache`. A disabled cache
+    //! never hits and never writes, which is what `--no-cache` asks for.
+    FixtureCache(std::filesystem::path project_root, std::filesystem::path cache_root, bool enabled);
+
+    bool enabled() const { return enabled_; }
+
+    //! On a key match, restore every artifact into the tree and fill `out`.
+    //! Returns false (and leaves the tree alone) when the key is new, the entry
+    //! is unreadable, or an object went missing.
+    bool lookup(const std::string& fixture, const std::string& key, std::vector<CacheArtifact>& out) const;
+
+    //! Copy the freshly written artifacts into the object store and record the
+    //! entry. `artifacts[i].object` is filled in here.
+    bool store(const std::string& fixture, const std::string& key, std::vector<CacheArtifact>& artifacts) const;
+
+private:
+    std::filesystem::path entry_path(const std::string& fixture) const;
+    std::filesystem::path object_path(const std::string& object) const;
+
+    std::filesystem::path project_root_;
+    std::filesystem::path cache_root_;
+    bool enabled_;
+};
+
+//! FNV-1a of a file's bytes as 16 hex digits; empty string when unreadable.
+std::string hash_file(const std::filesystem::path& path);
+
+}  // namespace golden
@@ -271,7 +271,7 @@ std::vector<int16_t> render_reseed_variant(
     int passes = 3,
     const std::vector<reseed::StemDefinition>* stems_override = nullptr);
 std::vector<int16_t> render_granular_fixture();
-std::vector<int16_t> render_long_random_take_fixture();
+bool render_long_random_take_fixture(offline::WavStreamWriter& writer);
 bool write_text_file_impl(const std::string& manifest_path, const std::string& body);
 bool emit_control_log_impl(const char* fixture_name, const std::string& body);
 
@@ -1099,7 +1099,7 @@ std::vector<int16_t> render_reseed_variant(
 }
 
 
-std::vector<int16_t> render_long_random_take_fixture() {
+bool render_long_random_take_fixture(offline::WavStreamWriter& writer) {
     constexpr double kDurationSeconds = 30.0;
     constexpr std::uint32_t kMasterSeed = 0x30F00Du;
     constexpr int kBpm = 120;
@@ -1120,7 +1120,6 @@ std::vector<int16_t> render_long_random_take_fixture() {
     offline::OfflineRenderer renderer(settings);
     renderer.mixSamplerEvents(plan.samplerEvents);
     renderer.mixResonatorEvents(plan.resonatorEvents);
-    const auto& pcm = renderer.finalize();
 
     const std::size_t frames = settings.frames;
     std::ostringstream control;
@@ -1137,14 +1136,10 @@ std::vector<int16_t> render_long_random_take_fixture() {
     }
     (void)emit_control_log_impl("long-random-take", control.str());
 
-    std::vector<int16_t> trimmed(frames * 2u, 0);
-    const std::size_t available_frames = std::min(frames, pcm.size());
-    for (std::size_t i = 0; i < available_frames; ++i) {
-        const int16_t sample = pcm[i];
-        trimmed[2u * i] = sample;
-        trimmed[2u * i + 1u] = sample;
-    }
-    return trimmed;
+    // The manifest files this take as mono with every sample written twice.
+    // Stream the normalised mix straight into the writer instead of building
+    // the PCM vector and a doubled copy of it.
+    return renderer.streamTo(writer, frames, 2u);
 }
 
 std::string render_reseed_log_fixture() {
@@ -1691,21 +1686,106 @@ void test_render_long_take_golden() {
     const auto* fixture = find_audio_fixture("long-random-take");
     TEST_ASSERT_NOT_NULL_MESSAGE(fixture, "long-random-take fixture metadata missing");
 
-    golden::WavWriteRequest request{};
-    request.path = fixture_disk_path(fixture->path).string();
-    request.sample_rate_hz = static_cast<uint32_t>(kSampleRate);
-    request.samples = render_long_random_take_fixture();
-
-    const bool write_ok = golden::write_wav_16(request);
+    // Streamed: the take goes to disk a chunk at a time and is hashed on the
+    // way out, so neither the PCM nor a second pass over it ever exists.
+    offline::WavStreamWriter writer;
+    const bool open_ok = writer.open(fixture_disk_path(fixture->path).string(), static_cast<uint32_t>(kSampleRate), 1);
+    TEST_ASSERT_TRUE_MESSAGE(open_ok, "Failed to open long random take WAV");
+    const bool render_ok = render_long_random_take_fixture(writer);
+    const std::string hash = writer.hashHex();
+    const bool write_ok = writer.close() && render_ok;
     TEST_ASSERT_TRUE_MESSAGE(write_ok, "Failed to write long random take WAV");
-
-    const std::string hash = golden::hash_pcm16(request.samples);
+    TEST_ASSERT_EQUAL_UINT64(2u * static_cast<std::uint64_t>(30.0 * kSampleRate), writer.samplesWritten());
     TEST_ASSERT_EQUAL_STRING(fixture->expected_hash, hash.c_str());
 
     const std::string manifest_body = load_manifest();
     assert_manifest_contains(manifest_body, *fixture);
 }
 
+std::vector<unsigned char> read_file_bytes(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::uint32_t read_le32(const std::vector<unsigned char>& bytes, std::size_t offset) {
+    return static_cast<std::uint32_t>(bytes[offset]) | (static_cast<std::uint32_t>(bytes[offset + 1]) << 8u) |
+           (static_cast<std::uint32_t>(bytes[offset + 2]) << 16u) |
+           (static_cast<std::uint32_t>(bytes[offset + 3]) << 24u);
+}
+
+void test_wav_stream_writer_formats() {
+    const auto dir = std::filesystem::temp_directory_path() / "seedbox_wav_stream";
+    std::filesystem::create_directories(dir);
+
+    // 16-bit, fed in ragged pieces that straddle the chunk buffer: same file
+    // as the one-shot writer, same hash as hash_pcm16.
+    std::vector<int16_t> pcm(offline::WavStreamWriter::kChunkBytes + 777u);
+    for (std::size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<int16_t>((static_cast<int>(i) * 7919) % 65536 - 32768);
+    }
+    offline::WavStreamWriter writer;
+    TEST_ASSERT_TRUE(writer.open((dir / "streamed16.wav").string(), 48000u, 1));
+    std::size_t cursor = 0;
+    for (std::size_t piece = 1; cursor < pcm.size(); piece = piece * 3 + 1) {
+        const std::size_t count = std::min(piece, pcm.size() - cursor);
+        TEST_ASSERT_TRUE(writer.writePcm16(pcm.data() + cursor, count));
+        cursor += count;
+    }
+    const std::string streamed_hash = writer.hashHex();
+    TEST_ASSERT_TRUE(writer.close());
+    const std::string buffered_hash = golden::hash_pcm16(pcm);
+    TEST_ASSERT_EQUAL_STRING(buffered_hash.c_str(), streamed_hash.c_str());
+
+    golden::WavWriteRequest request{};
+    request.path = (dir / "buffered16.wav").string();
+    request.samples = pcm;
+    TEST_ASSERT_TRUE(golden::write_wav_16(request));
+    const auto streamed = read_file_bytes(dir / "streamed16.wav");
+    TEST_ASSERT_TRUE(streamed == read_file_bytes(dir / "buffered16.wav"));
+    TEST_ASSERT_EQUAL_UINT32(44u + 2u * pcm.size(), streamed.size());
+    TEST_ASSERT_EQUAL_UINT32(streamed.size() - 8u, read_le32(streamed, 4));
+    TEST_ASSERT_EQUAL_UINT32(2u * pcm.size(), read_le32(streamed, 40));
+
+    // 24-bit mono with an odd sample count: three bytes per sample, a RIFF pad
+    // byte after the data, and the pad kept out of the data size.
+    const double ramp[] = {-1.0, -0.5, 0.0, 0.25, 1.0};
+    TEST_ASSERT_TRUE(writer.open((dir / "streamed24.wav").string(), 44100u, 1, offline::WavSampleFormat::kPcm24));
+    TEST_ASSERT_TRUE(writer.writeNormalized(ramp, 5));
+    TEST_ASSERT_TRUE(writer.close());
+    const auto pcm24 = read_file_bytes(dir / "streamed24.wav");
+    TEST_ASSERT_EQUAL_UINT32(44u + 15u + 1u, pcm24.size());
+    TEST_ASSERT_EQUAL_UINT32(24u, pcm24[34]);
+    TEST_ASSERT_EQUAL_UINT32(15u, read_le32(pcm24, 40));
+    TEST_ASSERT_EQUAL_UINT32(pcm24.size() - 8u, read_le32(pcm24, 4));
+    TEST_ASSERT_EQUAL_UINT8(0xFFu, pcm24[44 + 12]);  // +1.0 -> 0x7FFFFF
+    TEST_ASSERT_EQUAL_UINT8(0x7Fu, pcm24[44 + 14]);
+    TEST_ASSERT_EQUAL_UINT8(0x01u, pcm24[44]);  // -1.0 -> -8388607 = 0x800001
+
+    // 32-bit float stereo: format tag 3, fact chunk carries the frame count,
+    // samples land bit-exact.
+    const float stereo[] = {0.5f, -0.25f, 0.125f, 1.5f};
+    TEST_ASSERT_TRUE(writer.open((dir / "streamedf32.wav").string(), 96000u, 2, offline::WavSampleFormat::kFloat32));
+    TEST_ASSERT_TRUE(writer.writeNormalized(stereo, 4));
+    TEST_ASSERT_EQUAL_UINT64(2u, writer.frames());
+    TEST_ASSERT_TRUE(writer.close());
+    const auto f32 = read_file_bytes(dir / "streamedf32.wav");
+    TEST_ASSERT_EQUAL_UINT32(58u + 16u, f32.size());
+    TEST_ASSERT_EQUAL_UINT8(3u, f32[20]);
+    TEST_ASSERT_EQUAL_UINT32(2u, read_le32(f32, 46));
+    TEST_ASSERT_EQUAL_UINT32(16u, read_le32(f32, 54));
+    float last = 0.0f;
+    std::memcpy(&last, f32.data() + 58 + 12, sizeof(last));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, last);
+
+    // A take that ends mid-frame is reported, not silently accepted.
+    TEST_ASSERT_TRUE(writer.open((dir / "ragged.wav").string(), 48000u, 2));
+    TEST_ASSERT_TRUE(writer.writePcm16(pcm.data(), 3));
+    TEST_ASSERT_FALSE(writer.close());
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
 void test_euclid_mask_pair_golden() {
     const auto* audio_fixture = find_audio_fixture("euclid-mask");
     const auto* log_fixture = find_log_fixture("euclid-mask-control");
@@ -1815,6 +1895,7 @@ int main(int, char**) {
     RUN_TEST(test_render_reseed_C_golden);
     RUN_TEST(test_render_reseed_poly_golden);
     RUN_TEST(test_render_long_take_golden);
+    RUN_TEST(test_wav_stream_writer_formats);
     RUN_TEST(test_euclid_mask_pair_golden);
     RUN_TEST(test_log_burst_golden);
     RUN_TEST(test_log_reseed_golden);
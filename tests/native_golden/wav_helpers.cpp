@@ -20,6 +20,8 @@
 #include "engine/EuclidEngine.h"
 #include "Seed.h"
 
+#include "../../examples/shared/wav_stream_writer.hpp"
+
 #if ENABLE_GOLDEN
 extern bool emit_control_log(const char* fixture_name, const std::string& body);
 #endif
@@ -65,113 +67,50 @@ inline double sample_lane(const std::vector<double>& lane, std::size_t frame) {
 }  // namespace
 
 bool write_wav_16(const WavWriteRequest &request) {
-#if ENABLE_GOLDEN
-    if (request.path.empty() || request.samples.empty() || request.sample_rate_hz == 0) {
-        return false;
-    }
-
-    if (request.channels == 0) {
-        return false;
-    }
-
-    if (request.samples.size() % request.channels != 0) {
-        return false;
-    }
+    return !write_wav_16_hashed(request.path, request.sample_rate_hz, request.channels, request.samples).empty();
+}
 
-    std::filesystem::path path(request.path);
-    if (path.has_parent_path()) {
-        std::error_code ec;
-        std::filesystem::create_directories(path.parent_path(), ec);
-        if (ec) {
-            return false;
-        }
+std::string write_wav_16_hashed(const std::string &path,
+                                uint32_t sample_rate_hz,
+                                uint16_t channels,
+                                const std::vector<int16_t> &samples) {
+#if ENABLE_GOLDEN
+    if (samples.empty() || channels == 0 || samples.size() % channels != 0) {
+        return {};
     }
-
-    std::ofstream out(path, std::ios::binary);
-    if (!out) {
-        return false;
+    offline::WavStreamWriter writer;
+    if (!writer.open(path, sample_rate_hz, channels)) {
+        return {};
     }
-
-    const std::uint16_t kBitsPerSample = 16;
-    const std::uint16_t channels = request.channels;
-    const std::uint32_t data_bytes = static_cast<std::uint32_t>(request.samples.size() * sizeof(std::int16_t));
-    const std::uint32_t byte_rate = request.sample_rate_hz * channels * (kBitsPerSample / 8);
-    const std::uint16_t block_align = static_cast<std::uint16_t>(channels * (kBitsPerSample / 8));
-
-    auto write_tag = [&](const char (&tag)[5]) {
-        out.write(tag, 4);
-    };
-
-    auto write_le = [&](auto value) {
-        using T = std::decay_t<decltype(value)>;
-        using UnsignedT = std::make_unsigned_t<T>;
-        UnsignedT v = static_cast<UnsignedT>(value);
-        for (std::size_t i = 0; i < sizeof(UnsignedT); ++i) {
-            const char byte = static_cast<char>((v >> (8u * i)) & 0xFFu);
-            out.put(byte);
-        }
-    };
-
-    write_tag("RIFF");
-    const std::uint32_t riff_size = 36u + data_bytes;
-    write_le(riff_size);
-    write_tag("WAVE");
-    write_tag("fmt ");
-    const std::uint32_t fmt_size = 16u;
-    write_le(fmt_size);
-    const std::uint16_t audio_format = 1u;  // PCM
-    write_le(audio_format);
-    write_le(channels);
-    write_le(request.sample_rate_hz);
-    write_le(byte_rate);
-    write_le(block_align);
-    write_le(kBitsPerSample);
-    write_tag("data");
-    write_le(data_bytes);
-    out.write(reinterpret_cast<const char*>(request.samples.data()), data_bytes);
-
-    return out.good();
+    const bool wrote = writer.writePcm16(samples.data(), samples.size());
+    const std::string hash = writer.hashHex();
+    return (writer.close() && wrote) ? hash : std::string{};
 #else
-    (void)request;
-    return false;
+    (void)path;
+    (void)sample_rate_hz;
+    (void)channels;
+    (void)samples;
+    return {};
 #endif
 }
 
-namespace {
-
-constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
-constexpr std::uint64_t kFnvPrime = 1099511628211ull;
-
-std::string format_fnv(std::uint64_t state) {
-    std::ostringstream oss;
-    oss << std::hex << std::nouppercase << std::setfill('0') << std::setw(16) << state;
-    return oss.str();
-}
-
-}  // namespace
-
 std::string hash_pcm16(const std::vector<int16_t> &samples) {
-    std::uint64_t state = kFnvOffset;
+    // Little-endian bytes, low byte first: the same bytes the WAV data chunk
+    // holds, which is what lets the streaming writer hash on the way out.
+    offline::Fnv1a64 hash;
     for (std::int16_t sample : samples) {
-        std::uint16_t value = static_cast<std::uint16_t>(sample);
-        const std::uint8_t lo = static_cast<std::uint8_t>(value & 0xFFu);
-        const std::uint8_t hi = static_cast<std::uint8_t>((value >> 8u) & 0xFFu);
-        state ^= lo;
-        state *= kFnvPrime;
-        state ^= hi;
-        state *= kFnvPrime;
+        const std::uint16_t value = static_cast<std::uint16_t>(sample);
+        const unsigned char bytes[2] = {static_cast<unsigned char>(value & 0xFFu),
+                                        static_cast<unsigned char>((value >> 8u) & 0xFFu)};
+        hash.update(bytes, 2);
     }
-
-    return format_fnv(state);
+    return hash.hex();
 }
 
 std::string hash_bytes(const std::string &payload) {
-    std::uint64_t state = kFnvOffset;
-    for (unsigned char byte : payload) {
-        state ^= static_cast<std::uint8_t>(byte);
-        state *= kFnvPrime;
-    }
-    return format_fnv(state);
+    offline::Fnv1a64 hash;
+    hash.update(payload);
+    return hash.hex();
 }
 
 namespace {
@@ -19,6 +19,15 @@ struct WavWriteRequest {
 //! humans can inspect the render alongside the stored hash.
 bool write_wav_16(const WavWriteRequest &request);
 
+//! Same file as `write_wav_16`, but hands back the `hash_pcm16` of the payload
+//! computed while the bytes stream out (empty string on failure), so callers
+//! that need both skip a second walk over the buffer. Takes the samples by
+//! reference; no request copy required.
+std::string write_wav_16_hashed(const std::string &path,
+                                uint32_t sample_rate_hz,
+                                uint16_t channels,
+                                const std::vector<int16_t> &samples);
+
 //! Produces a stable hash of the WAV payload (PCM data only) using 64-bit
 //! FNV-1a.
 std::string hash_pcm16(const std::vector<int16_t> &samples);
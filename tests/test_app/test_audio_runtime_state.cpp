@@ -1,5 +1,6 @@
 #include <unity.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "app/AudioRuntimeState.h"
@@ -38,4 +39,21 @@ void test_audio_runtime_state_tracks_flags_and_processes_audio() {
   for (float sample : hotRight) {
     TEST_ASSERT_TRUE(std::fabs(sample) <= 0.9f);
   }
+
+  // Oversampling the soft clip must not let the filters overshoot the ceiling.
+  TEST_ASSERT_TRUE(runtime.outputOversampling() == util::Oversampler::kBypass);
+  runtime.setOutputOversampling(util::Oversampler::kOffline);
+  float squareLeft[256]{};
+  float squareRight[256]{};
+  for (std::size_t i = 0; i < 256; ++i) {
+    squareLeft[i] = ((i / 8) % 2) ? 1.4f : -1.4f;
+    squareRight[i] = -squareLeft[i];
+  }
+  runtime.applyHostOutputSafety(squareLeft, squareRight, 256u);
+  float loudest = 0.0f;
+  for (std::size_t i = 0; i < 256; ++i) {
+    loudest = std::max(loudest, std::max(std::fabs(squareLeft[i]), std::fabs(squareRight[i])));
+  }
+  TEST_ASSERT_TRUE(loudest > 0.1f);
+  TEST_ASSERT_TRUE(loudest <= 0.9f);
 }
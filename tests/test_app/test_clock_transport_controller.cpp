@@ -1,5 +1,8 @@
 #include <unity.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "app/ClockTransportController.h"
 #include "engine/Patterns.h"
 
@@ -68,3 +71,79 @@ void test_clock_transport_controller_watchdog_falls_back_to_internal() {
   TEST_ASSERT_EQUAL_PTR(&internal, controller.clock());
   TEST_ASSERT_FALSE(controller.externalClockDominant());
 }
+
+void test_clock_transport_controller_tap_tempo_sets_phase() {
+  InternalClock internal{};
+  MidiClockIn midiIn{};
+  MidiClockOut midiOut{};
+  PatternScheduler scheduler{};
+  ClockTransportController controller(internal, midiIn, midiOut, scheduler);
+  for (int i = 0; i < 7; ++i) {
+    scheduler.onTick();
+  }
+  TEST_ASSERT_EQUAL_UINT32(7u, scheduler.tickWithinBeat());
+
+  // The tap landed three ticks ago at 120 BPM (20.833 ms per tick): beat one
+  // was there, so the upcoming tick is the fourth of the new beat.
+  controller.applyTapTempo(120.0f, 62500);
+  TEST_ASSERT_EQUAL_FLOAT(120.0f, scheduler.bpm());
+  TEST_ASSERT_EQUAL_UINT32(3u, scheduler.tickWithinBeat());
+  TEST_ASSERT_EQUAL_UINT64(7u, scheduler.ticks());
+  for (int i = 0; i < 21; ++i) {
+    scheduler.onTick();
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, scheduler.tickWithinBeat());
+
+  // While an external clock dominates, only the tempo lands.
+  controller.toggleClockProvider();
+  controller.applyTapTempo(90.0f, 0);
+  TEST_ASSERT_EQUAL_FLOAT(90.0f, scheduler.bpm());
+  TEST_ASSERT_EQUAL_UINT32(0u, scheduler.tickWithinBeat());
+}
+
+void test_clock_transport_controller_tap_lands_density_hits_on_the_downbeat() {
+  InternalClock internal{};
+  MidiClockIn midiIn{};
+  MidiClockOut midiOut{};
+  PatternScheduler scheduler{};
+  ClockTransportController controller(internal, midiIn, midiOut, scheduler);
+  Seed seed{};
+  seed.density = 1.0f;
+  seed.probability = 1.0f;
+  seed.jitterMs = 0.0f;
+  scheduler.addSeed(seed);
+  std::vector<std::uint64_t> fired;
+  struct Ctx {
+    PatternScheduler* scheduler;
+    std::vector<std::uint64_t>* fired;
+  } ctx{&scheduler, &fired};
+  scheduler.setTriggerCallback(&ctx, [](void* raw, const Seed&, std::uint32_t) {
+    auto* c = static_cast<Ctx*>(raw);
+    c->fired->push_back(c->scheduler->ticks());
+  });
+  for (int i = 0; i < 7; ++i) {
+    scheduler.onTick();
+  }
+  TEST_ASSERT_TRUE(fired.empty());
+
+  // Tap right now: the very next tick is beat one and the seed plays on it,
+  // then once per beat from there.
+  controller.applyTapTempo(120.0f, 0);
+  for (int i = 0; i < 49; ++i) {
+    scheduler.onTick();
+  }
+  TEST_ASSERT_EQUAL_UINT32(3u, fired.size());
+  TEST_ASSERT_EQUAL_UINT64(7u, fired[0]);
+  TEST_ASSERT_EQUAL_UINT64(31u, fired[1]);
+  TEST_ASSERT_EQUAL_UINT64(55u, fired[2]);
+
+  // A tap reported three ticks late: beat one already went by at tick 53, so
+  // the next hit is a beat after it.
+  fired.clear();
+  controller.applyTapTempo(120.0f, 62500);
+  for (int i = 0; i < 24; ++i) {
+    scheduler.onTick();
+  }
+  TEST_ASSERT_EQUAL_UINT32(1u, fired.size());
+  TEST_ASSERT_EQUAL_UINT64(77u, fired[0]);
+}
@@ -0,0 +1,304 @@
+#include <unity.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "app/AppState.h"
+#include "app/ControlJournal.h"
+#include "hal/Board.h"
+#include "hal/hal_audio.h"
+
+void test_control_journal_encodes_compactly_and_round_trips() {
+  ControlJournal::Header header{};
+  header.boot = ControlJournal::Boot::kJuceHost;
+  header.sampleRate = 44100.0f;
+  header.framesPerBlock = 256;
+  ControlJournal journal(header);
+  ControlJournal::Event cc{};
+  cc.kind = ControlJournal::Kind::kControlChange;
+  cc.a = 0;
+  cc.b = 74;
+  cc.c = 127;
+  journal.append(cc);
+  ControlJournal::Event encoder{};
+  encoder.kind = ControlJournal::Kind::kEncoder;
+  encoder.a = 2;
+  encoder.value = static_cast<std::uint32_t>(-3);
+  journal.append(encoder);
+  ControlJournal::Event bpm{};
+  bpm.kind = ControlJournal::Kind::kInternalBpm;
+  bpm.value = ControlJournal::floatBits(133.5f);
+  journal.append(bpm);
+  const float left[2] = {0.25f, -0.5f};
+  const float right[2] = {0.0f, 1.0f};
+  journal.noteAudioBlock(left, right, 2);
+
+  std::vector<std::uint8_t> bytes;
+  journal.encode(bytes);
+  ControlJournal decoded;
+  TEST_ASSERT_TRUE(ControlJournal::decode(bytes.data(), bytes.size(), decoded));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(ControlJournal::Boot::kJuceHost),
+                          static_cast<std::uint8_t>(decoded.header().boot));
+  TEST_ASSERT_EQUAL_FLOAT(44100.0f, decoded.header().sampleRate);
+  TEST_ASSERT_EQUAL_UINT32(256u, decoded.header().framesPerBlock);
+  TEST_ASSERT_EQUAL_UINT64(journal.audioHash(), decoded.audioHash());
+  TEST_ASSERT_EQUAL_UINT64(1u, decoded.audioBlocks());
+  TEST_ASSERT_EQUAL_UINT32(3u, decoded.events().size());
+  TEST_ASSERT_EQUAL_UINT8(74u, decoded.events()[0].b);
+  TEST_ASSERT_EQUAL_UINT8(127u, decoded.events()[0].c);
+  TEST_ASSERT_EQUAL_INT32(-3, static_cast<std::int32_t>(static_cast<std::uint32_t>(decoded.events()[1].value)));
+  TEST_ASSERT_EQUAL_FLOAT(133.5f, ControlJournal::bitsToFloat(decoded.events()[2].value));
+  for (std::size_t i = 0; i < decoded.events().size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(journal.events()[i].sample, decoded.events()[i].sample);
+  }
+
+  // Truncated or foreign payloads are refused rather than half-loaded.
+  TEST_ASSERT_FALSE(ControlJournal::decode(bytes.data(), bytes.size() - 1, decoded));
+  bytes[0] = 'X';
+  TEST_ASSERT_FALSE(ControlJournal::decode(bytes.data(), bytes.size(), decoded));
+}
+
+void test_control_journal_replays_host_session_bit_exact() {
+  // A JUCE-style session: the host drives audio ticks and renders, automation
+  // and MIDI arrive between blocks, and the panel is scripted through a
+  // recording wrapper around the native board.
+  constexpr float kSampleRate = 48000.0f;
+  constexpr std::size_t kFrames = 128;
+  constexpr int kBlocks = 1500;  // ~4 s of audio
+
+  hal::nativeBoardReset();
+  ControlJournal::Header header{};
+  header.boot = ControlJournal::Boot::kJuceHost;
+  header.sampleRate = kSampleRate;
+  header.framesPerBlock = kFrames;
+  ControlJournal journal(header);
+  ControlJournal::RecordingBoard board(hal::nativeBoard(), journal);
+  AppState app(board);
+  app.initJuceHost(kSampleRate, kFrames);
+  app.attachControlJournal(&journal);
+
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  for (int block = 0; block < kBlocks; ++block) {
+    switch (block) {
+      case 10: app.reseed(0xC0FFEEu); break;
+      case 40: app.setInternalBpmFromHost(97.0f); break;
+      case 90: app.onExternalControlChange(0, 74, 100); break;
+      case 200: app.setSeedEngine(1, 2); break;
+      case 300: app.setSwingPercentFromHost(0.2f); break;
+      case 420: app.setFocusSeed(2); break;
+      case 500: hal::nativeBoardFeed("enc density 3"); break;
+      case 620: hal::nativeBoardFeed("btn shift down"); break;
+      case 640: hal::nativeBoardFeed("btn shift up"); break;
+      case 900: app.syncInternalBpmFromHostTransport(128.0f); break;
+      case 1100: app.onExternalControlChange(0, 71, 12); break;
+      default: break;
+    }
+    app.tickHostAudio();
+    hal::audio::renderHostBuffer(left.data(), right.data(), kFrames);
+    if (block % 8 == 0) {
+      app.serviceHostMaintenance();
+    }
+  }
+  app.attachControlJournal(nullptr);
+  TEST_ASSERT_EQUAL_UINT64(static_cast<std::uint64_t>(kBlocks), journal.audioBlocks());
+  TEST_ASSERT_TRUE(journal.audioHash() != ControlJournal::kHashSeed);
+
+  std::vector<std::uint8_t> bytes;
+  journal.encode(bytes);
+  ControlJournal loaded;
+  TEST_ASSERT_TRUE(ControlJournal::decode(bytes.data(), bytes.size(), loaded));
+
+  const ControlJournal::ReplayResult result = ControlJournal::replay(loaded);
+  TEST_ASSERT_TRUE(result.ok);
+  TEST_ASSERT_EQUAL_UINT64(journal.audioHash(), result.audioHash);
+  TEST_ASSERT_EQUAL_UINT64(static_cast<std::uint64_t>(kBlocks), result.audioBlocks);
+  TEST_ASSERT_EQUAL_UINT64(loaded.events().size(), result.events);
+
+  // A changed control stream must not hash the same.
+  ControlJournal tampered(loaded.header());
+  bool changed = false;
+  for (ControlJournal::Event event : loaded.events()) {
+    if (!changed && event.kind == ControlJournal::Kind::kReseed) {
+      event.value ^= 1u;
+      changed = true;
+    }
+    tampered.append(event);
+  }
+  TEST_ASSERT_TRUE(changed);
+  TEST_ASSERT_TRUE(ControlJournal::replay(tampered).audioHash != journal.audioHash());
+}
+
+void test_control_journal_replays_host_seed_edits() {
+  // The JUCE parameter path (setSeedParamFromHost), raw closures
+  // (applySeedEditFromHost) and the seed-page / gate / quantize setters must
+  // all land in the journal, or the replay drifts off the recorded audio.
+  constexpr float kSampleRate = 48000.0f;
+  constexpr std::size_t kFrames = 128;
+  constexpr int kBlocks = 1200;
+
+  hal::nativeBoardReset();
+  ControlJournal::Header header{};
+  header.boot = ControlJournal::Boot::kJuceHost;
+  header.sampleRate = kSampleRate;
+  header.framesPerBlock = kFrames;
+  ControlJournal journal(header);
+  AppState app(hal::nativeBoard());
+  app.initJuceHost(kSampleRate, kFrames);
+  app.attachControlJournal(&journal);
+
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  AppState::SeedNudge nudge{};
+  nudge.pitchSemitones = 5.0f;
+  nudge.toneDelta = -0.2f;
+  for (int block = 0; block < kBlocks; ++block) {
+    switch (block) {
+      case 20: app.setSeedParamFromHost(2, SeedParam::kDensity, 3.5f); break;
+      case 60: app.setSeedParamFromHost(1, SeedParam::kPitch, -7.0f); break;
+      case 100:
+        app.applySeedEditFromHost(0, [](Seed& seed) {
+          seed.tone = 0.9f;
+          seed.envR = 0.4f;
+        });
+        break;
+      case 140: app.setInputGateDivisionFromHost(AppState::GateDivision::kOneOverFour); break;
+      case 160: app.setInputGateFloorFromHost(0.05f); break;
+      case 200: app.seedPageToggleLock(2); break;
+      // Locked: refused on record and must be refused the same way on replay.
+      case 220: app.setSeedParamFromHost(2, SeedParam::kDensity, 0.5f); break;
+      case 260: app.seedPageNudge(1, nudge); break;
+      case 300: app.seedPageCycleGranularSource(3, -1); break;
+      case 340: app.setQuantizeScaleMaskFromHost(0x0AB5u); break;
+      case 380: app.setSeedPrimeBypassFromHost(true); break;
+      case 420: app.seedPageToggleLock(2); break;
+      case 460: app.setPage(AppState::Page::kClock); break;
+      case 500: app.armGranularLiveInput(true); break;
+      case 560: app.setSeedPreset(0x51u, app.seeds()); break;
+      case 600: app.seedPageReseed(0xBEEFu, AppState::SeedPrimeMode::kLfsr); break;
+      case 700: app.setSeedParamFromHost(2, SeedParam::kProbability, 0.6f); break;
+      default: break;
+    }
+    app.tickHostAudio();
+    hal::audio::renderHostBuffer(left.data(), right.data(), kFrames);
+    if (block % 8 == 0) {
+      app.serviceHostMaintenance();
+    }
+  }
+  app.attachControlJournal(nullptr);
+
+  // The closure and the nudge travelled as blobs; setSeedParamFromHost's inner
+  // closure did not journal a second time.
+  std::size_t seedParams = 0;
+  std::size_t seedEdits = 0;
+  std::size_t blobs = 0;
+  for (const auto& event : journal.events()) {
+    seedParams += event.kind == ControlJournal::Kind::kSeedParam ? 1u : 0u;
+    seedEdits += event.kind == ControlJournal::Kind::kSeedEdit ? 1u : 0u;
+    blobs += event.kind == ControlJournal::Kind::kBlob ? 1u : 0u;
+  }
+  TEST_ASSERT_EQUAL_UINT32(4u, seedParams);
+  TEST_ASSERT_EQUAL_UINT32(1u, seedEdits);
+  TEST_ASSERT_TRUE(blobs > 0u);
+
+  std::vector<std::uint8_t> bytes;
+  journal.encode(bytes);
+  ControlJournal loaded;
+  TEST_ASSERT_TRUE(ControlJournal::decode(bytes.data(), bytes.size(), loaded));
+  const ControlJournal::ReplayResult result = ControlJournal::replay(loaded);
+  TEST_ASSERT_TRUE(result.ok);
+  TEST_ASSERT_EQUAL_UINT64(journal.audioHash(), result.audioHash);
+
+  // The first density edit is audible: changing it changes the hash.
+  ControlJournal tampered(loaded.header());
+  bool changed = false;
+  for (ControlJournal::Event event : loaded.events()) {
+    if (!changed && event.kind == ControlJournal::Kind::kSeedParam) {
+      event.value = ControlJournal::floatBits(0.25f);
+      changed = true;
+    }
+    tampered.append(event);
+  }
+  TEST_ASSERT_TRUE(changed);
+  TEST_ASSERT_TRUE(ControlJournal::replay(tampered).audioHash != journal.audioHash());
+}
+
+void test_control_journal_keeps_audio_and_control_depth_apart() {
+  // The JUCE audio thread ticks and renders while the message thread applies
+  // host setters.  With one shared depth counter, a setter landing while the
+  // audio thread sits inside tickHostAudio() was silently dropped (or the
+  // counter itself was torn).  Every event from both threads must be there.
+  constexpr std::size_t kFrames = 64;
+  constexpr int kBlocks = 3000;
+  // The journal is bounded, so the message thread stops after this many
+  // setters even if audio is still running.
+  constexpr std::uint32_t kMaxSetters = 200000;
+
+  hal::nativeBoardReset();
+  ControlJournal::Header header{};
+  header.boot = ControlJournal::Boot::kJuceHost;
+  header.framesPerBlock = kFrames;
+  ControlJournal journal(header, 2u * kBlocks + kMaxSetters);
+  AppState app(hal::nativeBoard());
+  app.initJuceHost(48000.0f, kFrames);
+  app.attachControlJournal(&journal);
+
+  std::atomic<bool> audioDone{false};
+  std::thread audio([&app, &audioDone]() {
+    std::vector<float> left(kFrames);
+    std::vector<float> right(kFrames);
+    for (int block = 0; block < kBlocks; ++block) {
+      app.tickHostAudio();
+      hal::audio::renderHostBuffer(left.data(), right.data(), kFrames);
+    }
+    audioDone.store(true);
+  });
+  // Keep the message thread busy for as long as audio runs.
+  std::uint32_t setterCalls = 0;
+  while (!audioDone.load() && setterCalls < kMaxSetters) {
+    app.setDebugMetersEnabledFromHost((++setterCalls & 1u) != 0);
+  }
+  audio.join();
+  app.attachControlJournal(nullptr);
+
+  std::size_t ticks = 0;
+  std::size_t blocks = 0;
+  std::size_t setters = 0;
+  for (const auto& event : journal.events()) {
+    ticks += event.kind == ControlJournal::Kind::kHostAudioTick ? 1u : 0u;
+    blocks += event.kind == ControlJournal::Kind::kAudioBlock ? 1u : 0u;
+    setters += event.kind == ControlJournal::Kind::kDebugMeters ? 1u : 0u;
+  }
+  TEST_ASSERT_EQUAL_UINT32(static_cast<std::uint32_t>(kBlocks), ticks);
+  TEST_ASSERT_EQUAL_UINT32(static_cast<std::uint32_t>(kBlocks), blocks);
+  TEST_ASSERT_EQUAL_UINT32(setterCalls, setters);
+  TEST_ASSERT_EQUAL_UINT32(0u, journal.droppedEvents());
+}
+
+void test_control_journal_drops_whole_runs_when_full() {
+  // Four slots: a blob run that does not fit is refused whole, a single event
+  // that does fit still lands, and the result refuses to replay.
+  ControlJournal journal(4);
+  ControlJournal::Event lock{};
+  lock.kind = ControlJournal::Kind::kSeedLock;
+  journal.append(lock);
+  ControlJournal::Event edit{};
+  edit.kind = ControlJournal::Kind::kSeedEdit;
+  journal.append(edit, std::vector<std::uint8_t>(24, 0x5Au));
+  TEST_ASSERT_EQUAL_UINT32(1u, journal.events().size());
+  TEST_ASSERT_EQUAL_UINT32(4u, journal.droppedEvents());
+  journal.append(edit, std::vector<std::uint8_t>(9, 0x5Au));
+  TEST_ASSERT_EQUAL_UINT32(4u, journal.events().size());
+  TEST_ASSERT_TRUE(journal.events()[1].kind == ControlJournal::Kind::kBlob);
+  TEST_ASSERT_TRUE(journal.events()[3].kind == ControlJournal::Kind::kSeedEdit);
+  journal.append(lock);
+  TEST_ASSERT_EQUAL_UINT32(4u, journal.events().size());
+  TEST_ASSERT_EQUAL_UINT32(5u, journal.droppedEvents());
+  TEST_ASSERT_FALSE(ControlJournal::replay(journal).ok);
+
+  journal.clear();
+  TEST_ASSERT_EQUAL_UINT32(0u, journal.events().size());
+  TEST_ASSERT_EQUAL_UINT32(0u, journal.droppedEvents());
+}
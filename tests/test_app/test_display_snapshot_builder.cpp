@@ -1,6 +1,10 @@
 #include <unity.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -71,3 +75,150 @@ void test_display_snapshot_builder_switches_settings_hints() {
   TEST_ASSERT_EQUAL_STRING("Alt:prime skip", ui.pageHints[0].data());
   TEST_ASSERT_EQUAL_STRING("Tap:ext clock", ui.pageHints[1].data());
 }
+
+namespace {
+// Tiny deterministic PRNG so the equivalence sweep is repeatable.
+std::uint32_t nextRandom(std::uint32_t& state) {
+  state ^= state << 13u;
+  state ^= state >> 17u;
+  state ^= state << 5u;
+  return state;
+}
+
+float randomUnit(std::uint32_t& state) {
+  return static_cast<float>(nextRandom(state) & 0xFFFFu) / 65535.0f;
+}
+
+template <typename... Args>
+std::string reference(const char* fmt, Args... args) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), fmt, args...);
+  return std::string(buf);
+}
+
+DisplaySnapshotBuilder::Input seededInput(const std::vector<Seed>& seeds, const SeedLock& seedLock) {
+  DisplaySnapshotBuilder::Input input{};
+  input.masterSeed = 0x00C0FFEEu;
+  input.sampleRate = 48000.0f;
+  input.framesPerBlock = 128;
+  input.mode = static_cast<std::uint8_t>(AppState::Mode::HOME);
+  input.debugMetersEnabled = true;
+  input.seeds = &seeds;
+  input.seedLock = &seedLock;
+  input.schedulerSeed = &seeds.front();
+  return input;
+}
+}  // namespace
+
+void test_display_snapshot_builder_matches_printf_formatting() {
+  // The builder formats with integer maths now; sweep a few thousand random
+  // frames through one long-lived builder and hold every field to what the
+  // old snprintf formats printed for the same values.
+  DisplaySnapshotBuilder builder;
+  SeedLock seedLock{};
+  std::vector<Seed> seeds(1);
+  std::uint32_t rng = 0x5EEDu;
+  seedbox::DisplaySnapshot snap{};
+  UiState ui{};
+
+  for (int i = 0; i < 4000; ++i) {
+    Seed& s = seeds.front();
+    s.id = nextRandom(rng) % 120u;
+    s.prng = nextRandom(rng) | 1u;
+    // Quarter-semitone steps land exactly on %.1f rounding ties.
+    s.pitch = static_cast<float>(static_cast<int>(nextRandom(rng) % 193u) - 96) * 0.25f;
+    if (i % 3 == 0) {
+      s.pitch += randomUnit(rng) * 0.1f;
+    }
+    s.density = randomUnit(rng) * 20.0f;
+    s.probability = randomUnit(rng);
+    s.mutateAmt = randomUnit(rng) * 1.2f;
+    s.jitterMs = randomUnit(rng) * 150.0f;
+    s.engine = static_cast<std::uint8_t>(nextRandom(rng) % 4u);
+
+    auto input = seededInput(seeds, seedLock);
+    input.ledOn = (nextRandom(rng) & 1u) != 0;
+    input.inputGateHot = (nextRandom(rng) & 1u) != 0;
+    builder.build(snap, ui, input);
+
+    const float density = std::clamp(s.density, 0.0f, 99.99f);
+    const float probability = std::clamp(s.probability, 0.0f, 1.0f);
+    const float mutate = std::clamp(s.mutateAmt, 0.0f, 1.0f);
+    const unsigned jitter = static_cast<unsigned>(std::min(99.0f, std::round(s.jitterMs)));
+    char token[8];
+    std::snprintf(token, sizeof(token), "?%03u", static_cast<unsigned>(s.engine));
+    const std::string status = reference("#%02u%.*s%+0.1fst%c", s.id, 3, "UNK", s.pitch, input.ledOn ? '*' : '-');
+    const std::string metrics =
+        reference("D%.1fP%.1fF%.1f%c", density, probability, 0.0f, input.inputGateHot ? '!' : '-');
+    const std::string nuance =
+        reference("Mu%.2f%sR%02XJ%02u", mutate, token, static_cast<unsigned>(s.prng & 0xFFu), jitter);
+    TEST_ASSERT_EQUAL_STRING(status.c_str(), snap.status);
+    TEST_ASSERT_EQUAL_STRING(metrics.c_str(), snap.metrics);
+    TEST_ASSERT_EQUAL_STRING(nuance.c_str(), snap.nuance);
+  }
+
+  // The empty layout: sample rate, block size and the two rolling counters.
+  seedbox::DisplaySnapshot empty{};
+  for (int i = 0; i < 500; ++i) {
+    DisplaySnapshotBuilder::Input input{};
+    input.seedLock = &seedLock;
+    input.masterSeed = nextRandom(rng);
+    input.sampleRate = static_cast<float>(8000u + nextRandom(rng) % 184000u) + randomUnit(rng);
+    input.framesPerBlock = nextRandom(rng) % 2048u;
+    input.audioCallbackCount = (static_cast<std::uint64_t>(nextRandom(rng)) << 20u) | nextRandom(rng);
+    input.frame = nextRandom(rng);
+    builder.build(empty, ui, input);
+    const std::string title = reference("SeedBox %06X", input.masterSeed & 0xFFFFFFu);
+    const std::string metrics = reference("SR%.1fkB%02zu", input.sampleRate / 1000.f, input.framesPerBlock);
+    const std::string nuance = reference("AC%05lluF%05lu", static_cast<unsigned long long>(input.audioCallbackCount % 100000ULL),
+                                         static_cast<unsigned long>(input.frame % 100000ULL));
+    TEST_ASSERT_EQUAL_STRING(title.c_str(), empty.title);
+    TEST_ASSERT_EQUAL_STRING(metrics.c_str(), empty.metrics);
+    TEST_ASSERT_EQUAL_STRING(nuance.c_str(), empty.nuance);
+  }
+}
+
+void test_display_snapshot_builder_reformats_only_dirty_fields() {
+  DisplaySnapshotBuilder builder;
+  SeedLock seedLock{};
+  std::vector<Seed> seeds(1);
+  seeds.front().prng = 0xABCDu;
+  seedbox::DisplaySnapshot snap{};
+  UiState ui{};
+  auto input = seededInput(seeds, seedLock);
+
+  builder.build(snap, ui, input);
+  TEST_ASSERT_EQUAL_UINT8(7, builder.lastFormattedFields());
+  const seedbox::DisplaySnapshot first = snap;
+
+  // Nothing moved: every field comes from the cache, byte for byte.
+  seedbox::DisplaySnapshot again{};
+  builder.build(again, ui, input);
+  TEST_ASSERT_EQUAL_UINT8(0, builder.lastFormattedFields());
+  TEST_ASSERT_EQUAL_STRING(first.status, again.status);
+  TEST_ASSERT_EQUAL_STRING(first.metrics, again.metrics);
+  TEST_ASSERT_EQUAL_STRING(first.nuance, again.nuance);
+
+  // The status LED only feeds the status line.
+  input.ledOn = true;
+  builder.build(snap, ui, input);
+  TEST_ASSERT_EQUAL_UINT8(1, builder.lastFormattedFields());
+  TEST_ASSERT_EQUAL('*', snap.status[std::strlen(snap.status) - 1]);
+
+  // Density touches metrics only; the focus seed's PRNG byte touches nuance.
+  seeds.front().density = 3.5f;
+  seeds.front().prng = 0xAB11u;
+  builder.build(snap, ui, input);
+  TEST_ASSERT_EQUAL_UINT8(2, builder.lastFormattedFields());
+  TEST_ASSERT_EQUAL_STRING("D3.5P0.9F0.0-", snap.metrics);
+
+  // Switching layout (seeded -> empty) rewrites whatever the new layout prints.
+  input.seeds = nullptr;
+  builder.build(snap, ui, input);
+  TEST_ASSERT_EQUAL_STRING("HOME empty", snap.status);
+  TEST_ASSERT_EQUAL_STRING("SR48.0kB128", snap.metrics);
+
+  builder.invalidate();
+  builder.build(snap, ui, input);
+  TEST_ASSERT_EQUAL_UINT8(7, builder.lastFormattedFields());
+}
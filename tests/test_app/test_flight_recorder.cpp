@@ -0,0 +1,229 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "app/AppState.h"
+#include "app/FlightRecorder.h"
+#include "hal/hal_audio.h"
+
+namespace {
+FlightRecorder::Record makeRecord(std::uint64_t block, std::uint8_t flags = 0) {
+  FlightRecorder::Record rec{};
+  rec.block = block;
+  rec.frames = 128;
+  rec.renderNanos = static_cast<std::uint32_t>(1000u + block);
+  rec.engineRms = {0.1f, 0.0f, 0.25f, 0.0f, 0.05f};
+  rec.outputPeak = 0.5f;
+  rec.triggersFired = static_cast<std::uint32_t>(block % 3u);
+  rec.burstQueueDepth = 2;
+  rec.flags = flags;
+  rec.clock = FlightRecorder::ClockSource::kExternal;
+  return rec;
+}
+}  // namespace
+
+void test_flight_recorder_keeps_newest_records_in_order() {
+  FlightRecorder recorder;
+  std::vector<FlightRecorder::Record> records;
+  TEST_ASSERT_EQUAL_UINT32(0u, recorder.snapshot(records));
+
+  for (std::uint64_t block = 1; block <= 10; ++block) {
+    recorder.record(makeRecord(block));
+  }
+  TEST_ASSERT_EQUAL_UINT32(10u, recorder.snapshot(records));
+  TEST_ASSERT_EQUAL_UINT64(1u, records.front().block);
+  TEST_ASSERT_EQUAL_UINT64(10u, records.back().block);
+
+  // Wrap the ring more than once: only the newest kCapacity survive, oldest first.
+  const std::uint64_t total = FlightRecorder::kCapacity * 2 + 37;
+  for (std::uint64_t block = 11; block <= total; ++block) {
+    recorder.record(makeRecord(block));
+  }
+  TEST_ASSERT_EQUAL_UINT64(total, recorder.recorded());
+  TEST_ASSERT_EQUAL_UINT32(FlightRecorder::kCapacity, recorder.snapshot(records));
+  TEST_ASSERT_EQUAL_UINT64(total - FlightRecorder::kCapacity + 1, records.front().block);
+  TEST_ASSERT_EQUAL_UINT64(total, records.back().block);
+  for (std::size_t i = 1; i < records.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT64(records[i - 1].block + 1, records[i].block);
+  }
+
+  // Host drop counters turn into one-shot flags on the next record.
+  recorder.noteHostCounters(3, 0, 17);
+  recorder.record(makeRecord(total + 1));
+  recorder.record(makeRecord(total + 2));
+  recorder.snapshot(records);
+  const auto& flagged = records[records.size() - 2];
+  TEST_ASSERT_EQUAL_UINT8(FlightRecorder::kMidiDrop, flagged.flags);
+  TEST_ASSERT_EQUAL_UINT16(17u, flagged.hostCommandHighWater);
+  TEST_ASSERT_EQUAL_UINT8(0u, records.back().flags);
+}
+
+void test_flight_recorder_dumps_round_trip() {
+  FlightRecorder recorder;
+  for (std::uint64_t block = 1; block <= 6; ++block) {
+    recorder.record(makeRecord(block, block == 4 ? FlightRecorder::kClip : 0));
+  }
+  std::vector<FlightRecorder::Record> records;
+  recorder.snapshot(records);
+
+  FlightRecorder::DumpHeader header{};
+  header.sampleRate = 48000.0f;
+  header.triggerBlock = 4;
+  std::vector<std::uint8_t> bytes;
+  FlightRecorder::encodeDump(header, records, bytes);
+
+  FlightRecorder::DumpHeader decodedHeader{};
+  std::vector<FlightRecorder::Record> decoded;
+  TEST_ASSERT_TRUE(FlightRecorder::decodeDump(bytes.data(), bytes.size(), decodedHeader, decoded));
+  TEST_ASSERT_EQUAL_FLOAT(48000.0f, decodedHeader.sampleRate);
+  TEST_ASSERT_EQUAL_UINT64(4u, decodedHeader.triggerBlock);
+  TEST_ASSERT_EQUAL_UINT32(records.size(), decoded.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT64(records[i].block, decoded[i].block);
+    TEST_ASSERT_EQUAL_UINT32(records[i].renderNanos, decoded[i].renderNanos);
+    TEST_ASSERT_EQUAL_FLOAT(records[i].engineRms[2], decoded[i].engineRms[2]);
+    TEST_ASSERT_EQUAL_UINT32(records[i].triggersFired, decoded[i].triggersFired);
+    TEST_ASSERT_EQUAL_UINT8(records[i].flags, decoded[i].flags);
+    TEST_ASSERT_TRUE(decoded[i].clock == FlightRecorder::ClockSource::kExternal);
+  }
+
+  // Truncated or foreign bytes are refused.
+  TEST_ASSERT_FALSE(FlightRecorder::decodeDump(bytes.data(), bytes.size() - 1, decodedHeader, decoded));
+  bytes[0] = 'X';
+  TEST_ASSERT_FALSE(FlightRecorder::decodeDump(bytes.data(), bytes.size(), decodedHeader, decoded));
+
+  std::string csv;
+  FlightRecorder::appendCsv(records, csv);
+  std::size_t lines = 0;
+  for (char c : csv) {
+    lines += c == '\n' ? 1u : 0u;
+  }
+  TEST_ASSERT_EQUAL_UINT32(records.size() + 1, lines);
+  TEST_ASSERT_TRUE(csv.rfind("block,frames,render_ns", 0) == 0);
+  TEST_ASSERT_TRUE(csv.find("\n4,128,1004,") != std::string::npos);
+}
+
+void test_flight_recorder_auto_dump_waits_for_post_roll() {
+  FlightRecorder recorder;
+  std::uint64_t triggerBlock = 0;
+  // Disarmed: a clip raises nothing.
+  recorder.record(makeRecord(1, FlightRecorder::kClip));
+  for (std::uint64_t block = 2; block < 2 + FlightRecorder::kDumpPostRollBlocks; ++block) {
+    recorder.record(makeRecord(block));
+  }
+  TEST_ASSERT_FALSE(recorder.takeDumpRequest(triggerBlock));
+
+  recorder.setAutoDump(true);
+  std::uint64_t block = 100;
+  recorder.record(makeRecord(block++, FlightRecorder::kOverrun));
+  // A second event inside the post-roll folds into the first request.
+  recorder.record(makeRecord(block++, FlightRecorder::kClip));
+  while (block < 100 + FlightRecorder::kDumpPostRollBlocks) {
+    recorder.record(makeRecord(block++));
+    TEST_ASSERT_FALSE(recorder.takeDumpRequest(triggerBlock));
+  }
+  recorder.record(makeRecord(block++));
+  TEST_ASSERT_TRUE(recorder.takeDumpRequest(triggerBlock));
+  TEST_ASSERT_EQUAL_UINT64(100u, triggerBlock);
+  TEST_ASSERT_FALSE(recorder.takeDumpRequest(triggerBlock));
+}
+
+void test_flight_recorder_dumps_once_per_scripted_overrun_burst() {
+  // Overruns at scripted blocks, with the control thread polling after every
+  // block the way AppState's maintenance does.  Events inside a pending
+  // request's post-roll fold into it; the first one after it is taken starts
+  // a new dump.
+  constexpr std::uint64_t kPostRoll = FlightRecorder::kDumpPostRollBlocks;
+  const std::vector<std::uint64_t> overruns{10, 11, 10 + kPostRoll, 200, 200 + kPostRoll + 1, 900, 901, 902};
+  const std::vector<std::uint64_t> expected{10, 200, 200 + kPostRoll + 1, 900};
+  FlightRecorder recorder;
+  recorder.setAutoDump(true);
+  std::vector<std::uint64_t> dumps;
+  std::size_t next = 0;
+  for (std::uint64_t block = 1; block <= 1000; ++block) {
+    const bool overrun = next < overruns.size() && overruns[next] == block;
+    next += overrun ? 1u : 0u;
+    recorder.record(makeRecord(block, overrun ? FlightRecorder::kOverrun : 0));
+    std::uint64_t triggerBlock = 0;
+    if (recorder.takeDumpRequest(triggerBlock)) {
+      dumps.push_back(triggerBlock);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(expected.size(), dumps.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT64(expected[i], dumps[i]);
+  }
+}
+
+void test_app_state_records_flight_blocks_and_dumps() {
+  constexpr std::size_t kFrames = 128;
+  constexpr std::size_t kBlocks = 24;
+  AppState app;
+  app.initJuceHost(48000.0f, kFrames);
+
+  std::vector<float> left(kFrames, 0.0f);
+  std::vector<float> right(kFrames, 0.0f);
+  const std::uint64_t before = app.flightRecorder().recorded();
+  for (std::size_t i = 0; i < kBlocks; ++i) {
+    app.tickHostAudio();
+    hal::audio::renderHostBuffer(left.data(), right.data(), left.size());
+  }
+  TEST_ASSERT_EQUAL_UINT64(before + kBlocks, app.flightRecorder().recorded());
+
+  std::vector<FlightRecorder::Record> records;
+  app.flightRecorder().snapshot(records);
+  TEST_ASSERT_TRUE(records.size() >= kBlocks);
+  std::uint64_t triggers = 0;
+  for (const auto& rec : records) {
+    TEST_ASSERT_EQUAL_UINT32(kFrames, rec.frames);
+    triggers += rec.triggersFired;
+    // Engine metering is off by default, so no block paid for it.
+    for (float rms : rec.engineRms) {
+      TEST_ASSERT_EQUAL_FLOAT(0.0f, rms);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT64(app.diagnosticsSnapshot().audioCallbackCount, records.back().block);
+  // Every scheduler trigger since boot lands in exactly one record.
+  TEST_ASSERT_TRUE(app.schedulerTriggersFired() > 0u);
+  TEST_ASSERT_EQUAL_UINT64(app.schedulerTriggersFired(), triggers);
+
+  // With metering on, the engines that sounded show up in their slots.
+  app.setFlightRecorderEngineMetering(true);
+  float loudest = 0.0f;
+  for (std::size_t i = 0; i < kBlocks * 8; ++i) {
+    app.tickHostAudio();
+    hal::audio::renderHostBuffer(left.data(), right.data(), left.size());
+  }
+  app.flightRecorder().snapshot(records);
+  for (std::size_t i = records.size() - kBlocks * 8; i < records.size(); ++i) {
+    for (float rms : records[i].engineRms) {
+      loudest = std::max(loudest, rms);
+    }
+  }
+  TEST_ASSERT_TRUE(loudest > 0.0f);
+
+  const auto dir = std::filesystem::temp_directory_path() / "seedbox_flight_recorder_test";
+  std::filesystem::create_directories(dir);
+  const std::string binPath = (dir / "manual.sbfr").string();
+  const std::string csvPath = (dir / "manual.csv").string();
+  TEST_ASSERT_TRUE(app.dumpFlightRecorder(binPath, FlightRecorder::DumpFormat::kBinary));
+  TEST_ASSERT_TRUE(app.dumpFlightRecorder(csvPath, FlightRecorder::DumpFormat::kCsv));
+
+  std::ifstream in(binPath, std::ios::binary);
+  const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  FlightRecorder::DumpHeader header{};
+  std::vector<FlightRecorder::Record> decoded;
+  TEST_ASSERT_TRUE(FlightRecorder::decodeDump(bytes.data(), bytes.size(), header, decoded));
+  TEST_ASSERT_EQUAL_UINT32(records.size(), decoded.size());
+  TEST_ASSERT_EQUAL_FLOAT(48000.0f, header.sampleRate);
+  TEST_ASSERT_TRUE(std::filesystem::file_size(csvPath) > 0u);
+  std::printf("[flight-recorder] records=%zu dump=%zu bytes\n", decoded.size(), bytes.size());
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,71 @@
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "hal/hal_audio_q15.h"
+
+namespace {
+// The conversion the HAL shipped before the Q15 kernels existed, kept here
+// verbatim so the new path can be held to it bit for bit.
+std::int16_t legacyQuantize(float x) {
+  const float clamped = std::fmin(std::fmax(x, -1.0f), 1.0f);
+  return static_cast<std::int16_t>(clamped * 32767.0f);
+}
+}  // namespace
+
+void test_q15_block_conversion_matches_reference() {
+  // Every representable float in [-1.25, 1.25] would take too long; a dense
+  // xorshift sweep plus the edges catches rounding and saturation mistakes.
+  std::vector<float> in;
+  const float edges[] = {0.0f, -0.0f, 1.0f, -1.0f, 1.0001f, -1.0001f, 0.5f, -0.5f,
+                         1.0f / 32767.0f, -1.0f / 32767.0f, 0.99999f, -0.99999f,
+                         std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                         std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min()};
+  in.assign(std::begin(edges), std::end(edges));
+  std::uint32_t state = 0x1234567u;
+  for (int i = 0; i < 100000; ++i) {
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+    in.push_back((static_cast<float>(state & 0xFFFFFu) / 1048575.0f) * 2.5f - 1.25f);
+  }
+
+  // Odd lengths and an odd output offset exercise the packed path's head and
+  // tail handling.
+  std::vector<std::int16_t> storage(in.size() + 2, 0x5A5A);
+  std::int16_t* out = storage.data() + 1;
+  hal::audio::floatBlockToQ15(in.data(), out, in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    TEST_ASSERT_EQUAL_INT16(hal::audio::floatToQ15(in[i]), out[i]);
+    if (!std::isnan(in[i])) {
+      TEST_ASSERT_EQUAL_INT16(legacyQuantize(in[i]), out[i]);
+    }
+  }
+  TEST_ASSERT_EQUAL_INT16(0x5A5A, storage.front());
+  TEST_ASSERT_EQUAL_INT16(0x5A5A, storage.back());
+
+  TEST_ASSERT_EQUAL_INT16(32767, hal::audio::floatToQ15(1.0f));
+  TEST_ASSERT_EQUAL_INT16(-32767, hal::audio::floatToQ15(-3.0f));
+  TEST_ASSERT_EQUAL_INT16(0, hal::audio::floatToQ15(std::numeric_limits<float>::quiet_NaN()));
+
+  // Back to float and out again.  Truncation toward zero may shave one code
+  // off on the way back, never more, and full scale stays full scale.
+  std::vector<std::int16_t> codes;
+  for (int q = -32767; q <= 32767; ++q) {
+    codes.push_back(static_cast<std::int16_t>(q));
+  }
+  std::vector<float> floats(codes.size());
+  hal::audio::q15BlockToFloat(codes.data(), floats.data(), codes.size());
+  std::vector<std::int16_t> back(codes.size());
+  hal::audio::floatBlockToQ15(floats.data(), back.data(), floats.size());
+  for (std::size_t i = 0; i < codes.size(); ++i) {
+    TEST_ASSERT_TRUE(std::abs(static_cast<int>(codes[i]) - static_cast<int>(back[i])) <= 1);
+  }
+  TEST_ASSERT_EQUAL_INT16(32767, back.back());
+  TEST_ASSERT_EQUAL_INT16(-32767, back.front());
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, floats.back());
+}
@@ -15,6 +15,7 @@ void test_mn42_param_controls_respect_lock();
 void test_engine_mode_twiddles_euclid_and_burst();
 void test_simulator_audio_reports_48k();
 void test_engine_idle_floor_tracks_peak_and_rms();
+void test_q15_block_conversion_matches_reference();
 void test_clock_transport_controller_toggles_provider_and_follow_flag();
 void test_clock_transport_controller_latches_transport_gate();
 void test_clock_transport_controller_watchdog_falls_back_to_internal();
@@ -23,19 +24,33 @@ void test_juce_host_render_boot_seeds_remain_audible_when_focus_changes();
 void test_juce_host_arms_granular_live_input_for_effect_processing();
 void test_display_snapshot_builder_renders_empty_state();
 void test_display_snapshot_builder_switches_settings_hints();
+void test_display_snapshot_builder_matches_printf_formatting();
+void test_display_snapshot_builder_reformats_only_dirty_fields();
 void test_diagnostics_snapshot_includes_shared_host_counters();
 void test_audio_runtime_state_tracks_flags_and_processes_audio();
 void test_input_gate_monitor_tracks_dry_input_and_arms_once_per_hot_edge();
 void test_preset_round_trip_via_eeprom_store();
 void test_init_sim_attaches_default_store();
+void test_preset_codec_round_trips_teaching_fixtures();
+void test_preset_codec_guards_marker_bytes_and_corruption();
+void test_preset_codec_fits_teaching_bank_in_teensy41_eeprom();
+void test_preset_cache_warms_every_slot_once();
+void test_preset_recall_commits_from_cache_without_touching_store();
+void test_preset_cache_sees_saves_made_behind_its_back();
 void test_preset_controller_snapshots_and_defaults();
 void test_preset_controller_queues_and_crossfades();
+void test_seed_param_matrix_packs_and_weights_curves();
+void test_preset_crossfade_grows_and_shrinks_seed_count();
+void test_preset_crossfade_honours_length_and_curves();
+void test_preset_crossfade_equal_power_holds_equal_endpoints();
 void test_seed_lock_survives_reseed_and_engine_swap();
 void test_global_lock_blocks_reseed_changes();
 void test_quantize_control_snaps_pitch_to_scale();
+void test_quantize_custom_scale_mask_round_trips_through_presets();
 void test_gate_reseed_respects_division_and_locks();
 void test_ascii_frame_matches_boot_snapshot();
 void test_ascii_renderer_tracks_engine_swaps();
+void test_ascii_view_counts_partial_refresh_bytes();
 void test_debug_meter_toggle_updates_metrics_and_mode();
 void test_ui_gallery_snapshots();
 void test_live_input_prime_tags_seeds_as_live();
@@ -62,6 +77,33 @@ void test_learn_frame_reports_generator_state();
 void test_status_snapshot_reports_focus_seed_and_clock_state();
 void test_status_json_contains_expected_fields();
 void test_status_snapshot_builder_defaults_empty_state();
+void test_status_telemetry_reports_only_changed_fields();
+void test_status_telemetry_frames_round_trip_through_mirror();
+void test_app_state_polls_status_telemetry_deltas();
+void test_flight_recorder_keeps_newest_records_in_order();
+void test_flight_recorder_dumps_round_trip();
+void test_flight_recorder_auto_dump_waits_for_post_roll();
+void test_flight_recorder_dumps_once_per_scripted_overrun_burst();
+void test_app_state_records_flight_blocks_and_dumps();
+void test_native_runtime_loop_virtual_time_is_deterministic();
+void test_native_runtime_loop_counts_overruns_and_keeps_grid();
+void test_native_runtime_loop_wakes_for_posted_events();
+void test_app_state_reports_runtime_loop_diagnostics();
+void test_native_runtime_loop_publishes_load_while_running();
+void test_control_journal_encodes_compactly_and_round_trips();
+void test_control_journal_replays_host_session_bit_exact();
+void test_control_journal_replays_host_seed_edits();
+void test_control_journal_keeps_audio_and_control_depth_apart();
+void test_control_journal_drops_whole_runs_when_full();
+void test_native_script_compiles_sorted_timeline();
+void test_native_sim_runner_drives_gestures_deterministically();
+void test_native_sim_runner_soaks_an_hour_of_gestures();
+void test_native_sim_runner_keeps_taps_shorter_than_a_tick();
+void test_tap_tempo_tracker_shrugs_off_jitter_and_missed_taps();
+void test_tap_tempo_tracker_rejects_double_taps_but_follows_tempo_changes();
+void test_tap_tempo_tracker_confirms_half_tempo();
+void test_clock_transport_controller_tap_tempo_sets_phase();
+void test_clock_transport_controller_tap_lands_density_hits_on_the_downbeat();
 void test_status_snapshot_builder_serializes_json_escapes();
 void test_tap_tempo_tracker_builds_bpm_and_resets_pending_tap();
 void test_tap_tempo_tracker_caps_history();
@@ -83,6 +125,7 @@ int main(int, char**) {
   RUN_TEST(test_engine_mode_twiddles_euclid_and_burst);
   RUN_TEST(test_simulator_audio_reports_48k);
   RUN_TEST(test_engine_idle_floor_tracks_peak_and_rms);
+  RUN_TEST(test_q15_block_conversion_matches_reference);
   RUN_TEST(test_clock_transport_controller_toggles_provider_and_follow_flag);
   RUN_TEST(test_clock_transport_controller_latches_transport_gate);
   RUN_TEST(test_clock_transport_controller_watchdog_falls_back_to_internal);
@@ -91,19 +134,33 @@ int main(int, char**) {
   RUN_TEST(test_juce_host_arms_granular_live_input_for_effect_processing);
   RUN_TEST(test_display_snapshot_builder_renders_empty_state);
   RUN_TEST(test_display_snapshot_builder_switches_settings_hints);
+  RUN_TEST(test_display_snapshot_builder_matches_printf_formatting);
+  RUN_TEST(test_display_snapshot_builder_reformats_only_dirty_fields);
   RUN_TEST(test_diagnostics_snapshot_includes_shared_host_counters);
   RUN_TEST(test_audio_runtime_state_tracks_flags_and_processes_audio);
   RUN_TEST(test_input_gate_monitor_tracks_dry_input_and_arms_once_per_hot_edge);
   RUN_TEST(test_preset_round_trip_via_eeprom_store);
   RUN_TEST(test_init_sim_attaches_default_store);
+  RUN_TEST(test_preset_codec_round_trips_teaching_fixtures);
+  RUN_TEST(test_preset_codec_guards_marker_bytes_and_corruption);
+  RUN_TEST(test_preset_codec_fits_teaching_bank_in_teensy41_eeprom);
+  RUN_TEST(test_preset_cache_warms_every_slot_once);
+  RUN_TEST(test_preset_recall_commits_from_cache_without_touching_store);
+  RUN_TEST(test_preset_cache_sees_saves_made_behind_its_back);
   RUN_TEST(test_preset_controller_snapshots_and_defaults);
   RUN_TEST(test_preset_controller_queues_and_crossfades);
+  RUN_TEST(test_seed_param_matrix_packs_and_weights_curves);
+  RUN_TEST(test_preset_crossfade_grows_and_shrinks_seed_count);
+  RUN_TEST(test_preset_crossfade_honours_length_and_curves);
+  RUN_TEST(test_preset_crossfade_equal_power_holds_equal_endpoints);
   RUN_TEST(test_seed_lock_survives_reseed_and_engine_swap);
   RUN_TEST(test_global_lock_blocks_reseed_changes);
   RUN_TEST(test_quantize_control_snaps_pitch_to_scale);
+  RUN_TEST(test_quantize_custom_scale_mask_round_trips_through_presets);
   RUN_TEST(test_gate_reseed_respects_division_and_locks);
   RUN_TEST(test_ascii_frame_matches_boot_snapshot);
   RUN_TEST(test_ascii_renderer_tracks_engine_swaps);
+  RUN_TEST(test_ascii_view_counts_partial_refresh_bytes);
   RUN_TEST(test_debug_meter_toggle_updates_metrics_and_mode);
   RUN_TEST(test_ui_gallery_snapshots);
   RUN_TEST(test_live_input_prime_tags_seeds_as_live);
@@ -130,6 +187,33 @@ int main(int, char**) {
   RUN_TEST(test_status_snapshot_reports_focus_seed_and_clock_state);
   RUN_TEST(test_status_json_contains_expected_fields);
   RUN_TEST(test_status_snapshot_builder_defaults_empty_state);
+  RUN_TEST(test_status_telemetry_reports_only_changed_fields);
+  RUN_TEST(test_status_telemetry_frames_round_trip_through_mirror);
+  RUN_TEST(test_app_state_polls_status_telemetry_deltas);
+  RUN_TEST(test_flight_recorder_keeps_newest_records_in_order);
+  RUN_TEST(test_flight_recorder_dumps_round_trip);
+  RUN_TEST(test_flight_recorder_auto_dump_waits_for_post_roll);
+  RUN_TEST(test_flight_recorder_dumps_once_per_scripted_overrun_burst);
+  RUN_TEST(test_app_state_records_flight_blocks_and_dumps);
+  RUN_TEST(test_native_runtime_loop_virtual_time_is_deterministic);
+  RUN_TEST(test_native_runtime_loop_counts_overruns_and_keeps_grid);
+  RUN_TEST(test_native_runtime_loop_wakes_for_posted_events);
+  RUN_TEST(test_app_state_reports_runtime_loop_diagnostics);
+  RUN_TEST(test_native_runtime_loop_publishes_load_while_running);
+  RUN_TEST(test_control_journal_encodes_compactly_and_round_trips);
+  RUN_TEST(test_control_journal_replays_host_session_bit_exact);
+  RUN_TEST(test_control_journal_replays_host_seed_edits);
+  RUN_TEST(test_control_journal_keeps_audio_and_control_depth_apart);
+  RUN_TEST(test_control_journal_drops_whole_runs_when_full);
+  RUN_TEST(test_native_script_compiles_sorted_timeline);
+  RUN_TEST(test_native_sim_runner_drives_gestures_deterministically);
+  RUN_TEST(test_native_sim_runner_soaks_an_hour_of_gestures);
+  RUN_TEST(test_native_sim_runner_keeps_taps_shorter_than_a_tick);
+  RUN_TEST(test_tap_tempo_tracker_shrugs_off_jitter_and_missed_taps);
+  RUN_TEST(test_tap_tempo_tracker_rejects_double_taps_but_follows_tempo_changes);
+  RUN_TEST(test_tap_tempo_tracker_confirms_half_tempo);
+  RUN_TEST(test_clock_transport_controller_tap_tempo_sets_phase);
+  RUN_TEST(test_clock_transport_controller_tap_lands_density_hits_on_the_downbeat);
   RUN_TEST(test_status_snapshot_builder_serializes_json_escapes);
   RUN_TEST(test_tap_tempo_tracker_builds_bpm_and_resets_pending_tap);
   RUN_TEST(test_tap_tempo_tracker_caps_history);
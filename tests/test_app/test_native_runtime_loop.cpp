@@ -0,0 +1,160 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app/AppState.h"
+#include "app/NativeRuntimeLoop.h"
+#include "hal/Board.h"
+
+using Nanos = NativeRuntimeLoop::Nanos;
+
+void test_native_runtime_loop_virtual_time_is_deterministic() {
+  // One second of a 120-frame audio lane (2.5 ms, so the count is exact at
+  // whole nanoseconds) and a 120 BPM control lane, twice:
+  // identical fire counts, identical interleaving, and no wall-clock waiting.
+  auto runOnce = [](std::string& trace) {
+    NativeRuntimeLoop loop(NativeRuntimeLoop::TimeMode::kVirtual);
+    std::uint32_t audio = 0;
+    std::uint32_t control = 0;
+    loop.addTimer(NativeRuntimeLoop::periodForFrames(120, 48000.0f), [&]() {
+      ++audio;
+      trace.push_back('a');
+    });
+    loop.addTimer(NativeRuntimeLoop::periodForTicks(120.0f), [&]() {
+      ++control;
+      trace.push_back('c');
+    });
+    loop.runFor(NativeRuntimeLoop::kNanosPerSecond);
+    TEST_ASSERT_EQUAL_UINT64(NativeRuntimeLoop::kNanosPerSecond, loop.now());
+    TEST_ASSERT_EQUAL_UINT32(400u, audio);  // 48000 / 120
+    TEST_ASSERT_EQUAL_UINT32(48u, control);  // 2 beats * 24 PPQN
+    TEST_ASSERT_EQUAL_UINT64(0u, loop.stats().deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT64(0u, loop.stats().worstLatenessNanos);
+  };
+  std::string first;
+  std::string second;
+  runOnce(first);
+  runOnce(second);
+  TEST_ASSERT_EQUAL_UINT32(first.size(), second.size());
+  TEST_ASSERT_TRUE(first == second);
+}
+
+void test_native_runtime_loop_counts_overruns_and_keeps_grid() {
+  NativeRuntimeLoop loop(NativeRuntimeLoop::TimeMode::kVirtual);
+  constexpr Nanos kPeriod = 1000000;  // 1 ms
+  std::uint32_t fires = 0;
+  std::vector<Nanos> fireTimes;
+  loop.addTimer(kPeriod, [&]() {
+    fireTimes.push_back(loop.now());
+    // The fifth block "takes" 3.5 periods of work.
+    loop.advanceVirtual(++fires == 5 ? kPeriod * 7 / 2 : kPeriod / 10);
+  });
+  loop.runFor(20 * kPeriod + kPeriod / 2);
+
+  const auto& stats = loop.stats();
+  // Fire 5 starts at 5 ms and ends at 8.5 ms, so the 6, 7 and 8 ms deadlines
+  // are gone; the next fire is at 8.5 ms (one miss, two periods skipped) and the
+  // timer is back on the whole-millisecond grid afterwards.
+  TEST_ASSERT_EQUAL_UINT64(1u, stats.deadlineMisses);
+  TEST_ASSERT_EQUAL_UINT64(2u, stats.skippedPeriods);
+  TEST_ASSERT_EQUAL_UINT64(kPeriod * 5 / 2, stats.worstLatenessNanos);
+  TEST_ASSERT_EQUAL_UINT64(8 * kPeriod + kPeriod / 2, fireTimes[5]);
+  TEST_ASSERT_EQUAL_UINT64(9 * kPeriod, fireTimes[6]);
+  TEST_ASSERT_EQUAL_UINT32(18u, fires);
+  TEST_ASSERT_EQUAL_UINT64(20 * kPeriod + kPeriod / 2, stats.elapsedNanos);
+  // 17 light blocks at 0.1 ms plus one 3.5 ms block over 20.5 ms.
+  TEST_ASSERT_EQUAL_UINT64(17 * (kPeriod / 10) + kPeriod * 7 / 2, stats.busyNanos);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.2f / 20.5f * 100.0f, stats.loadPercent());
+}
+
+void test_native_runtime_loop_wakes_for_posted_events() {
+  // Real time: an hour-long timer would keep a busy-spin loop hot; this one
+  // must sleep, then wake promptly when another thread posts work.
+  NativeRuntimeLoop loop;
+  std::uint32_t timerFires = 0;
+  loop.addTimer(3600ull * NativeRuntimeLoop::kNanosPerSecond, [&]() { ++timerFires; });
+  std::uint32_t eventsSeen = 0;
+  std::thread poster([&loop, &eventsSeen]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    loop.post([&eventsSeen]() { ++eventsSeen; });
+    loop.post([&loop, &eventsSeen]() {
+      ++eventsSeen;
+      loop.requestStop();
+    });
+  });
+  loop.run();
+  poster.join();
+
+  const auto& stats = loop.stats();
+  TEST_ASSERT_EQUAL_UINT32(2u, eventsSeen);
+  TEST_ASSERT_EQUAL_UINT32(0u, timerFires);
+  TEST_ASSERT_EQUAL_UINT64(2u, stats.eventsRun);
+  // A handful of sleeps, not millions of spins.
+  TEST_ASSERT_TRUE(stats.wakeups < 10u);
+}
+
+void test_app_state_reports_runtime_loop_diagnostics() {
+  hal::nativeBoardReset();
+  AppState app(hal::nativeBoard());
+  app.initSim();
+
+  NativeRuntimeLoop loop(NativeRuntimeLoop::TimeMode::kVirtual);
+  NativeRuntimeLoop::TimerId control = 0;
+  control = loop.addTimer(NativeRuntimeLoop::periodForTicks(app.schedulerBpm()), [&]() {
+    app.tick();
+    loop.setTimerPeriod(control, NativeRuntimeLoop::periodForTicks(app.schedulerBpm()));
+  });
+  const std::uint64_t ticksBefore = app.schedulerTicks();
+  loop.runFor(NativeRuntimeLoop::kNanosPerSecond);
+  // One scheduler tick per control deadline, at 24 PPQN of whatever tempo the
+  // boot preset chose.
+  const std::uint64_t fired = loop.stats().timerFires;
+  TEST_ASSERT_EQUAL_UINT64(fired, app.schedulerTicks() - ticksBefore);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, app.schedulerBpm() * 24.0f / 60.0f, static_cast<float>(fired));
+
+  AppState::DiagnosticsSnapshot::RuntimeLoop published{};
+  published.timerFires = loop.stats().timerFires;
+  published.deadlineMisses = 3;
+  published.loadPercent = 1.5f;
+  app.setRuntimeLoopDiagnostics(published);
+  const auto snapshot = app.diagnosticsSnapshot();
+  TEST_ASSERT_EQUAL_UINT64(fired, snapshot.runtimeLoop.timerFires);
+  TEST_ASSERT_EQUAL_UINT64(3u, snapshot.runtimeLoop.deadlineMisses);
+  TEST_ASSERT_EQUAL_FLOAT(1.5f, snapshot.runtimeLoop.loadPercent);
+}
+
+void test_native_runtime_loop_publishes_load_while_running() {
+  // main() calls run(), which never returns, and publishes from inside the
+  // control callback once a beat.  The load it publishes must already count
+  // the time run() has covered so far.
+  hal::nativeBoardReset();
+  AppState app(hal::nativeBoard());
+  app.initSim();
+
+  NativeRuntimeLoop loop(NativeRuntimeLoop::TimeMode::kVirtual);
+  constexpr Nanos kPeriod = 1000000;  // 1 ms
+  std::uint64_t controlTicks = 0;
+  loop.addTimer(kPeriod, [&]() {
+    app.tick();
+    // Each tick "costs" a quarter of its period.
+    loop.advanceVirtual(kPeriod / 4);
+    if (++controlTicks % 24u == 0u) {
+      app.setRuntimeLoopDiagnostics(loop.stats());
+    }
+    if (controlTicks == 48u) {
+      loop.requestStop();
+    }
+  });
+  loop.run();
+
+  // Published during tick 48: 47 finished ticks of work over the 48 ms up to
+  // its start.
+  const auto snapshot = app.diagnosticsSnapshot();
+  TEST_ASSERT_EQUAL_UINT64(48u, snapshot.runtimeLoop.timerFires);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 47.0f * 0.25f / 48.0f * 100.0f, snapshot.runtimeLoop.loadPercent);
+  TEST_ASSERT_EQUAL_UINT64(0u, snapshot.runtimeLoop.deadlineMisses);
+}
@@ -0,0 +1,137 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "app/AppState.h"
+#include "app/NativeSimRunner.h"
+#include "hal/Board.h"
+
+using ButtonID = hal::Board::ButtonID;
+
+void test_native_script_compiles_sorted_timeline() {
+  hal::NativeScript script;
+  std::string error;
+  const char* text =
+      "# two taps, then an absolute cue\n"
+      "btn tap down\n"
+      "wait 20ms\n"
+      "btn tap up\n"
+      "repeat 3\n"
+      "  enc density -1\n"
+      "  wait 1.5s\n"
+      "end\n"
+      "at 250ms\n"
+      "BTN Shift Down\r\n"
+      "wait 2 us\n";
+  TEST_ASSERT_TRUE(hal::compileNativeScript(text, script, &error));
+  TEST_ASSERT_EQUAL_UINT32(6u, script.events.size());
+  // `at 250ms` jumped back in time; the timeline is still sorted.
+  TEST_ASSERT_EQUAL_UINT64(0u, script.events[0].at_us);
+  TEST_ASSERT_EQUAL_UINT64(20000u, script.events[1].at_us);
+  TEST_ASSERT_EQUAL_UINT64(20000u, script.events[2].at_us);
+  TEST_ASSERT_EQUAL_UINT64(250000u, script.events[3].at_us);
+  TEST_ASSERT_TRUE(script.events[3].button == ButtonID::Shift);
+  TEST_ASSERT_TRUE(script.events[3].pressed);
+  TEST_ASSERT_EQUAL_UINT64(1520000u, script.events[4].at_us);
+  TEST_ASSERT_EQUAL_UINT64(3020000u, script.events[5].at_us);
+  TEST_ASSERT_EQUAL_INT32(-1, script.events[5].delta);
+  // The repeat block ran to 4.52 s, then `at` rewound the cursor.
+  TEST_ASSERT_EQUAL_UINT64(4520000u, script.duration_us);
+
+  hal::NativeScript untouched;
+  TEST_ASSERT_FALSE(hal::compileNativeScript("btn tap down\nbtn nope up\n", untouched, &error));
+  TEST_ASSERT_EQUAL_STRING("line 2: unrecognised command", error.c_str());
+  TEST_ASSERT_FALSE(hal::compileNativeScript("repeat 2\nwait 5ms\n", untouched, &error));
+  TEST_ASSERT_FALSE(hal::compileNativeScript("wait 5 fortnights\n", untouched, &error));
+  TEST_ASSERT_EQUAL_UINT32(0u, untouched.events.size());
+
+  const auto path = std::filesystem::temp_directory_path() / "seedbox_native_script.txt";
+  {
+    std::ofstream file(path);
+    file << text;
+  }
+  hal::NativeScript loaded;
+  TEST_ASSERT_TRUE(hal::loadNativeScriptFile(path.string(), loaded, &error));
+  TEST_ASSERT_EQUAL_UINT32(script.events.size(), loaded.events.size());
+  std::filesystem::remove(path);
+  TEST_ASSERT_FALSE(hal::loadNativeScriptFile(path.string(), loaded, &error));
+}
+
+void test_native_sim_runner_drives_gestures_deterministically() {
+  auto runOnce = [](NativeSimRunner::Stats& stats, std::uint64_t& pressStamp) {
+    hal::nativeBoardReset();
+    AppState app(hal::nativeBoard());
+    app.initSim();
+    hal::NativeScript script;
+    TEST_ASSERT_TRUE(hal::compileNativeScript("wait 7ms\nbtn seed down\nwait 30ms\nbtn seed up\n", script));
+    NativeSimRunner runner(app);
+    stats = runner.run(script, 500000);
+    TEST_ASSERT_EQUAL(AppState::Mode::SEEDS, app.mode());
+    pressStamp = hal::nativeBoard().sampleButton(ButtonID::EncoderSeedBank).timestamp_us;
+    return app.schedulerTicks();
+  };
+  NativeSimRunner::Stats first{};
+  NativeSimRunner::Stats second{};
+  std::uint64_t firstStamp = 0;
+  std::uint64_t secondStamp = 0;
+  const std::uint64_t firstTicks = runOnce(first, firstStamp);
+  const std::uint64_t secondTicks = runOnce(second, secondStamp);
+  TEST_ASSERT_EQUAL_UINT64(firstTicks, secondTicks);
+  TEST_ASSERT_EQUAL_UINT64(first.ticks, second.ticks);
+  TEST_ASSERT_EQUAL_UINT64(first.audioBlocks, second.audioBlocks);
+  TEST_ASSERT_EQUAL_UINT64(2u, first.scriptEvents);
+  TEST_ASSERT_EQUAL_UINT64(537000u, first.simulatedMicros);
+  TEST_ASSERT_EQUAL_UINT64(537000u, hal::nativeBoard().nowMicros());
+  // The release carries its scheduled time, not the tick that noticed it.
+  TEST_ASSERT_EQUAL_UINT64(37000u, firstStamp);
+  TEST_ASSERT_EQUAL_UINT64(firstStamp, secondStamp);
+  // 128-frame blocks at 48 kHz over 537 ms.
+  TEST_ASSERT_EQUAL_UINT64(201u, first.audioBlocks);
+}
+
+void test_native_sim_runner_soaks_an_hour_of_gestures() {
+  hal::nativeBoardReset();
+  AppState app(hal::nativeBoard());
+  app.initSim();
+  // Six seconds per pass: open SEEDS, long-press Shift back HOME, nudge an
+  // encoder.  600 passes is one simulated hour.
+  hal::NativeScript script;
+  TEST_ASSERT_TRUE(hal::compileNativeScript(
+      "repeat 600\n"
+      "  btn seed down\n  wait 30ms\n  btn seed up\n  wait 2s\n"
+      "  btn shift down\n  wait 600ms\n  btn shift up\n  wait 1s\n"
+      "  enc tone 1\n  wait 2370ms\n"
+      "end\n",
+      script));
+  TEST_ASSERT_EQUAL_UINT32(600u * 5u, script.events.size());
+  TEST_ASSERT_EQUAL_UINT64(3600ull * 1000000ull, script.duration_us);
+
+  NativeSimRunner::Options options{};
+  options.audioFrames = 0;  // the sim boot stops audio; skip the silent blocks
+  NativeSimRunner runner(app, options);
+  const NativeSimRunner::Stats stats = runner.run(script);
+
+  TEST_ASSERT_EQUAL(AppState::Mode::HOME, app.mode());
+  TEST_ASSERT_EQUAL_UINT64(3000u, stats.scriptEvents);
+  TEST_ASSERT_EQUAL_UINT64(0u, stats.audioBlocks);
+  TEST_ASSERT_FLOAT_WITHIN(2.0f, app.schedulerBpm() * 24.0f * 60.0f, static_cast<float>(stats.ticks));
+}
+
+void test_native_sim_runner_keeps_taps_shorter_than_a_tick() {
+  hal::nativeBoardReset();
+  AppState app(hal::nativeBoard());
+  app.initSim();
+  // Down and up 5 ms apart: both come due before the first control tick.
+  hal::NativeScript script;
+  TEST_ASSERT_TRUE(hal::compileNativeScript("btn seed down\nwait 5ms\nbtn seed up\n", script));
+  NativeSimRunner runner(app);
+  const NativeSimRunner::Stats stats = runner.run(script, 500000);
+  TEST_ASSERT_EQUAL_UINT64(2u, stats.scriptEvents);
+  TEST_ASSERT_EQUAL(AppState::Mode::SEEDS, app.mode());
+  const hal::Board::ButtonSample sample = hal::nativeBoard().sampleButton(ButtonID::EncoderSeedBank);
+  TEST_ASSERT_FALSE(sample.pressed);
+  TEST_ASSERT_EQUAL_UINT64(5000u, sample.timestamp_us);
+}
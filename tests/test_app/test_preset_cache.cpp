@@ -0,0 +1,156 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "app/AppState.h"
+#include "app/Preset.h"
+#include "app/PresetCache.h"
+#include "io/Store.h"
+#include "io/Storage.h"
+
+namespace {
+// Counts how often anyone reaches past the cache into the backend.
+class CountingStore : public seedbox::io::StoreEeprom {
+public:
+  CountingStore() : seedbox::io::StoreEeprom(4096) {}
+
+  bool load(std::string_view slot, std::vector<std::uint8_t>& out) const override {
+    ++loads;
+    return seedbox::io::StoreEeprom::load(slot, out);
+  }
+
+  mutable int loads{0};
+};
+
+seedbox::Preset makePreset(std::string slot, std::uint32_t masterSeed) {
+  seedbox::Preset preset{};
+  preset.slot = std::move(slot);
+  preset.masterSeed = masterSeed;
+  preset.clock.bpm = 120.f;
+  preset.seeds.resize(4);
+  for (std::size_t i = 0; i < preset.seeds.size(); ++i) {
+    preset.seeds[i].id = static_cast<std::uint32_t>(i);
+    preset.seeds[i].pitch = static_cast<float>(masterSeed % 12u) + static_cast<float>(i);
+  }
+  return preset;
+}
+
+void storePreset(seedbox::io::Store& store, const seedbox::Preset& preset) {
+  TEST_ASSERT_TRUE(store.save(preset.slot, preset.serialize()));
+}
+}  // namespace
+
+void test_preset_cache_warms_every_slot_once() {
+  CountingStore store;
+  storePreset(store, makePreset("a", 1u));
+  storePreset(store, makePreset("b", 2u));
+  storePreset(store, makePreset("c", 3u));
+
+  PresetCache cache;
+  cache.reset(&store);
+  TEST_ASSERT_TRUE(cache.warming());
+  TEST_ASSERT_NULL(cache.find("a").get());
+
+  // One slot per call, in the order the store lists them.
+  TEST_ASSERT_TRUE(cache.warmNext());
+  TEST_ASSERT_NOT_NULL(cache.find("a").get());
+  TEST_ASSERT_NULL(cache.find("b").get());
+  cache.warmAll();
+  TEST_ASSERT_FALSE(cache.warming());
+  TEST_ASSERT_EQUAL_UINT32(3u, cache.size());
+  TEST_ASSERT_EQUAL_INT(3, store.loads);
+
+  const auto b = cache.load("b");
+  TEST_ASSERT_NOT_NULL(b.get());
+  TEST_ASSERT_EQUAL_UINT32(2u, b->masterSeed);
+  TEST_ASSERT_EQUAL_INT(3, store.loads);
+
+  // Remembering a fresh save swaps the handle but leaves old holders intact.
+  cache.remember("b", makePreset("b", 22u));
+  TEST_ASSERT_EQUAL_UINT32(2u, b->masterSeed);
+  TEST_ASSERT_EQUAL_UINT32(22u, cache.find("b")->masterSeed);
+
+  TEST_ASSERT_NULL(cache.load("missing").get());
+  cache.reset(nullptr);
+  TEST_ASSERT_EQUAL_UINT32(0u, cache.size());
+  TEST_ASSERT_FALSE(cache.warming());
+}
+
+void test_preset_recall_commits_from_cache_without_touching_store() {
+  CountingStore store;
+  storePreset(store, makePreset("verse", 0x1111u));
+  storePreset(store, makePreset("chorus", 0x2222u));
+
+  AppState app;
+  app.attachStore(&store);
+  app.initSim();
+  // The main loop decodes the bank in the background, one slot per tick.
+  app.tick();
+  app.tick();
+  app.tick();
+  const int warmLoads = store.loads;
+  TEST_ASSERT_EQUAL_INT(2, warmLoads);
+
+  TEST_ASSERT_TRUE(app.recallPreset("chorus", false));
+  app.tick();
+  TEST_ASSERT_EQUAL_UINT32(0x2222u, app.masterSeed());
+  TEST_ASSERT_EQUAL_STRING("chorus", app.activePresetSlot().c_str());
+
+  TEST_ASSERT_TRUE(app.recallPreset("verse", true));
+  app.tick();
+  TEST_ASSERT_EQUAL_UINT32(0x1111u, app.masterSeed());
+
+  // A save lands in the cache too, so recalling it stays off the store.
+  app.reseed(0x3333u);
+  const std::uint32_t bridgeSeed = app.masterSeed();
+  TEST_ASSERT_TRUE(app.savePreset("bridge"));
+  TEST_ASSERT_TRUE(app.recallPreset("verse", false));
+  app.tick();
+  TEST_ASSERT_TRUE(app.recallPreset("bridge", false));
+  app.tick();
+  TEST_ASSERT_EQUAL_UINT32(bridgeSeed, app.masterSeed());
+  TEST_ASSERT_EQUAL_INT(warmLoads, store.loads);
+  TEST_ASSERT_FALSE(app.recallPreset("nope", false));
+}
+
+void test_preset_cache_sees_saves_made_behind_its_back() {
+  // A write straight to the store (not through the cache) moves the store's
+  // generation, so the next load decodes the new bytes instead of the stale
+  // entry.
+  CountingStore store;
+  storePreset(store, makePreset("a", 1u));
+  PresetCache cache;
+  cache.reset(&store);
+  cache.warmAll();
+  TEST_ASSERT_EQUAL_UINT32(1u, cache.load("a")->masterSeed);
+  storePreset(store, makePreset("a", 11u));
+  TEST_ASSERT_EQUAL_UINT32(11u, cache.load("a")->masterSeed);
+  // Writes through the cache leave the rest of it warm.
+  storePreset(store, makePreset("b", 2u));
+  cache.warmAll();
+  const int loads = store.loads;
+  TEST_ASSERT_NOT_NULL(cache.save("a", makePreset("a", 12u)).get());
+  TEST_ASSERT_EQUAL_UINT32(12u, cache.load("a")->masterSeed);
+  TEST_ASSERT_EQUAL_UINT32(2u, cache.load("b")->masterSeed);
+  TEST_ASSERT_EQUAL_INT(loads, store.loads);
+
+  // The legacy Storage::saveScene helper writes the same EEPROM the app
+  // recalls from; a recall right after the save must get the new scene.
+  AppState app;
+  app.initSim();
+  app.reseed(0x4444u);
+  TEST_ASSERT_TRUE(app.savePreset("scene"));
+  app.tick();
+  app.reseed(0x5555u);
+  const std::uint32_t savedSeed = app.masterSeed();
+  TEST_ASSERT_TRUE(Storage::saveScene("eeprom:scene"));
+  app.reseed(0x6666u);
+  TEST_ASSERT_TRUE(app.recallPreset("scene", false));
+  app.tick();
+  TEST_ASSERT_EQUAL_UINT32(savedSeed, app.masterSeed());
+  std::vector<Seed> bank;
+  TEST_ASSERT_TRUE(Storage::loadSeedBank("eeprom:scene", bank));
+  TEST_ASSERT_EQUAL_UINT32(app.seeds().size(), bank.size());
+}
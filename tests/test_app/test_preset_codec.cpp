@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "app/Preset.h"
+#include "io/PresetCodec.h"
+#include "io/Store.h"
+
+namespace {
+// Teensy 4.1 ships 4284 bytes of emulated EEPROM.
+constexpr std::size_t kTeensy41EepromBytes = 4284;
+
+struct Fixture {
+  std::string name;
+  std::vector<std::uint8_t> json;  // compact JSON, exactly what savePreset() hands the store
+};
+
+std::filesystem::path projectRoot() {
+#ifdef SEEDBOX_PROJECT_ROOT_HINT
+  return std::filesystem::path(SEEDBOX_PROJECT_ROOT_HINT);
+#else
+  return std::filesystem::current_path();
+#endif
+}
+
+std::vector<Fixture> loadTeachingFixtures() {
+  std::vector<Fixture> fixtures;
+  const auto dir = projectRoot() / "presets" / "teaching";
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+    if (!entry.is_regular_file() || entry.path().extension() != ".json") {
+      continue;
+    }
+    std::ifstream in(entry.path(), std::ios::binary);
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                                          std::istreambuf_iterator<char>());
+    seedbox::Preset preset{};
+    if (!seedbox::Preset::deserialize(bytes, preset)) {
+      continue;
+    }
+    fixtures.push_back(Fixture{entry.path().stem().string(), preset.serialize()});
+  }
+  std::sort(fixtures.begin(), fixtures.end(),
+            [](const Fixture& a, const Fixture& b) { return a.name < b.name; });
+  return fixtures;
+}
+}  // namespace
+
+void test_preset_codec_round_trips_teaching_fixtures() {
+  const auto fixtures = loadTeachingFixtures();
+  TEST_ASSERT_FALSE(fixtures.empty());
+
+  std::size_t jsonTotal = 0;
+  std::size_t packedTotal = 0;
+  for (const auto& fixture : fixtures) {
+    const auto packed = seedbox::io::packPresetBlob(fixture.json);
+    std::vector<std::uint8_t> unpacked;
+    TEST_ASSERT_TRUE(seedbox::io::unpackPresetBlob(packed, unpacked));
+    TEST_ASSERT_TRUE(unpacked == fixture.json);
+    TEST_ASSERT_TRUE(packed.size() < fixture.json.size());
+    std::printf("[preset-codec] %-28s json=%5zu packed=%4zu ratio=%.3f\n", fixture.name.c_str(),
+                fixture.json.size(), packed.size(),
+                static_cast<double>(packed.size()) / static_cast<double>(fixture.json.size()));
+    jsonTotal += fixture.json.size();
+    packedTotal += packed.size();
+  }
+  const double ratio = static_cast<double>(packedTotal) / static_cast<double>(jsonTotal);
+  std::printf("[preset-codec] total json=%zu packed=%zu ratio=%.3f\n", jsonTotal, packedTotal, ratio);
+  TEST_ASSERT_TRUE(ratio < 0.35);
+}
+
+void test_preset_codec_guards_marker_bytes_and_corruption() {
+  // Raw blobs whose first byte collides with a marker must still round-trip.
+  for (std::uint8_t lead : {std::uint8_t{0x00}, std::uint8_t{0x42}, std::uint8_t{0x50}}) {
+    const std::vector<std::uint8_t> raw{lead, 0x1F, 0x28, 'x'};
+    std::vector<std::uint8_t> back;
+    TEST_ASSERT_TRUE(seedbox::io::unpackPresetBlob(seedbox::io::packPresetBlob(raw), back));
+    TEST_ASSERT_TRUE(back == raw);
+  }
+
+  const auto fixtures = loadTeachingFixtures();
+  TEST_ASSERT_FALSE(fixtures.empty());
+  auto packed = seedbox::io::packPresetBlob(fixtures.front().json);
+  TEST_ASSERT_TRUE(packed.size() > 8);
+  std::vector<std::uint8_t> untouched{'k', 'e', 'e', 'p'};
+  auto truncated = packed;
+  truncated.resize(packed.size() / 2);
+  TEST_ASSERT_FALSE(seedbox::io::unpackPresetBlob(truncated, untouched));
+  TEST_ASSERT_EQUAL_UINT32(4u, untouched.size());
+
+  auto bogusBackReference = std::vector<std::uint8_t>{0x50, 0x08, 0xC0, 0x10};
+  TEST_ASSERT_FALSE(seedbox::io::unpackPresetBlob(bogusBackReference, untouched));
+}
+
+void test_preset_codec_fits_teaching_bank_in_teensy41_eeprom() {
+  const auto fixtures = loadTeachingFixtures();
+  TEST_ASSERT_TRUE(fixtures.size() >= 4);
+
+  // Raw JSON only squeezes two four-seed presets into a Teensy 4.1 (the old
+  // token blobs managed five of the eight).  The packed format has to at least
+  // double whatever raw JSON would manage, header overhead ignored.
+  std::size_t rawFit = 0;
+  std::size_t rawBytes = 0;
+  while (rawFit < fixtures.size() && rawBytes + fixtures[rawFit].json.size() <= kTeensy41EepromBytes) {
+    rawBytes += fixtures[rawFit].json.size();
+    ++rawFit;
+  }
+
+  seedbox::io::StoreEeprom store(kTeensy41EepromBytes);
+  std::size_t saved = 0;
+  while (saved < fixtures.size() && store.save(fixtures[saved].name, fixtures[saved].json)) {
+    ++saved;
+  }
+  std::printf("[preset-codec] teensy 4.1 eeprom holds %zu/%zu teaching presets (raw json: %zu)\n",
+              saved, fixtures.size(), rawFit);
+  TEST_ASSERT_TRUE(saved >= 2 * rawFit || saved == fixtures.size());
+  TEST_ASSERT_EQUAL_UINT32(saved, store.list().size());
+  for (std::size_t i = 0; i < saved; ++i) {
+    std::vector<std::uint8_t> loaded;
+    TEST_ASSERT_TRUE(store.load(fixtures[i].name, loaded));
+    TEST_ASSERT_TRUE(loaded == fixtures[i].json);
+  }
+}
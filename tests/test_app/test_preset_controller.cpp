@@ -56,12 +56,18 @@ void test_preset_controller_queues_and_crossfades() {
 
   const auto pending = controller.takePendingPreset(96u);
   TEST_ASSERT_TRUE(pending.has_value());
-  TEST_ASSERT_EQUAL_STRING("beta", pending->preset.slot.c_str());
+  TEST_ASSERT_NOT_NULL(pending->preset.get());
+  TEST_ASSERT_EQUAL_STRING("beta", pending->preset->slot.c_str());
   TEST_ASSERT_TRUE(pending->crossfade);
   TEST_ASSERT_EQUAL_UINT64(96u, pending->targetTick);
 
   TEST_ASSERT_EQUAL_UINT64(96u, controller.computeNextPresetTickForBoundary(PresetController::Boundary::kBar, 95u));
   TEST_ASSERT_EQUAL_UINT64(192u, controller.computeNextPresetTickForBoundary(PresetController::Boundary::kBar, 96u));
+  // A tapped downbeat at tick 10 moves the bar lines with it.
+  TEST_ASSERT_EQUAL_UINT64(106u,
+                           controller.computeNextPresetTickForBoundary(PresetController::Boundary::kBar, 100u, 10u));
+  TEST_ASSERT_EQUAL_UINT64(202u,
+                           controller.computeNextPresetTickForBoundary(PresetController::Boundary::kBar, 106u, 10u));
 
   std::vector<Seed> fromSeeds(2);
   fromSeeds[0].id = 10;
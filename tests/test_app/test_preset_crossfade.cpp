@@ -0,0 +1,178 @@
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Seed.h"
+#include "app/AppState.h"
+#include "app/SeedParamMatrix.h"
+
+namespace {
+void runTicks(AppState& app, std::uint32_t count) {
+  for (std::uint32_t i = 0; i < count; ++i) {
+    app.tick();
+  }
+}
+
+// Start from the booted world and give every seed a recognisable density.
+seedbox::Preset presetWithSeeds(const AppState& app, std::size_t count, float density) {
+  seedbox::Preset preset = app.snapshotPresetForHost("xfade");
+  preset.seeds.resize(count, preset.seeds.empty() ? Seed{} : preset.seeds.front());
+  preset.engineSelections.clear();
+  for (std::size_t i = 0; i < preset.seeds.size(); ++i) {
+    preset.seeds[i].id = static_cast<std::uint32_t>(i);
+    preset.seeds[i].prng = 0x1000u + static_cast<std::uint32_t>(i);
+    preset.seeds[i].density = density;
+    preset.seeds[i].pitch = 12.f;
+  }
+  return preset;
+}
+}  // namespace
+
+void test_seed_param_matrix_packs_and_weights_curves() {
+  Seed seed{};
+  seed.pitch = -3.f;
+  seed.density = 2.5f;
+  seed.granular.windowSkew = 0.25f;
+  seed.resonator.feedback = 0.5f;
+  float row[SeedParamMatrix::kColumns]{};
+  SeedParamMatrix::packRow(seed, row);
+  TEST_ASSERT_EQUAL_FLOAT(2.5f, row[static_cast<std::size_t>(SeedParam::kDensity)]);
+  Seed back{};
+  SeedParamMatrix::unpackRow(row, back);
+  TEST_ASSERT_EQUAL_FLOAT(-3.f, back.pitch);
+  TEST_ASSERT_EQUAL_FLOAT(0.25f, back.granular.windowSkew);
+  TEST_ASSERT_EQUAL_FLOAT(0.5f, back.resonator.feedback);
+
+  float wFrom = 0.f;
+  float wTo = 0.f;
+  for (auto curve : {CrossfadeCurve::kLinear, CrossfadeCurve::kEqualPower, CrossfadeCurve::kSCurve}) {
+    SeedParamMatrix::curveWeights(curve, 0.f, wFrom, wTo);
+    TEST_ASSERT_EQUAL_FLOAT(1.f, wFrom);
+    TEST_ASSERT_EQUAL_FLOAT(0.f, wTo);
+    SeedParamMatrix::curveWeights(curve, 1.f, wFrom, wTo);
+    TEST_ASSERT_EQUAL_FLOAT(0.f, wFrom);
+    TEST_ASSERT_EQUAL_FLOAT(1.f, wTo);
+  }
+  SeedParamMatrix::curveWeights(CrossfadeCurve::kEqualPower, 0.3f, wFrom, wTo);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, std::sin(0.3f * 1.57079633f), wTo);
+  // Every curve's weights sum to 1 all the way through, so no curve can push a
+  // parameter past its endpoints.
+  for (auto curve : {CrossfadeCurve::kLinear, CrossfadeCurve::kEqualPower, CrossfadeCurve::kSCurve}) {
+    for (int step = 0; step <= 20; ++step) {
+      SeedParamMatrix::curveWeights(curve, static_cast<float>(step) / 20.f, wFrom, wTo);
+      TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.f, wFrom + wTo);
+    }
+  }
+  SeedParamMatrix::curveWeights(CrossfadeCurve::kSCurve, 0.25f, wFrom, wTo);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.15625f, wTo);
+
+  // blend() is one sweep over every row with per-column weights.
+  SeedParamMatrix from;
+  SeedParamMatrix to;
+  from.assign(std::vector<Seed>(3, Seed{}), 3);
+  to.assign(std::vector<Seed>(3, seed), 3);
+  SeedParamMatrix::Weights wa{};
+  SeedParamMatrix::Weights wb{};
+  wa.fill(0.5f);
+  wb.fill(0.5f);
+  SeedParamMatrix out;
+  SeedParamMatrix::blend(from, to, wa, wb, out);
+  TEST_ASSERT_EQUAL_UINT32(3u, out.rows());
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f * (Seed{}.density + 2.5f), out.at(2, SeedParam::kDensity));
+}
+
+void test_preset_crossfade_grows_and_shrinks_seed_count() {
+  AppState app;
+  app.initSim();
+  runTicks(app, 1);
+  const std::size_t startCount = app.seeds().size();
+  TEST_ASSERT_TRUE(startCount >= 2);
+
+  // Growing: the extra seeds join immediately and fade in from silence rather
+  // than forcing a hard cut and a scheduler rebuild.
+  const auto bigger = presetWithSeeds(app, startCount + 2, 2.f);
+  app.applyPresetFromHost(bigger, true);
+  runTicks(app, AppState::kPresetCrossfadeTicks / 2);
+  TEST_ASSERT_EQUAL_UINT32(startCount + 2, app.seeds().size());
+  const Seed& joining = app.seeds()[startCount + 1];
+  TEST_ASSERT_TRUE(joining.density > 0.f && joining.density < 2.f);
+  TEST_ASSERT_NOT_NULL(app.debugScheduledSeed(static_cast<std::uint8_t>(startCount + 1)));
+  runTicks(app, AppState::kPresetCrossfadeTicks);
+  TEST_ASSERT_EQUAL_UINT32(startCount + 2, app.seeds().size());
+  TEST_ASSERT_EQUAL_FLOAT(2.f, app.seeds()[startCount + 1].density);
+  TEST_ASSERT_EQUAL_FLOAT(12.f, app.debugScheduledSeed(0)->pitch);
+
+  // Shrinking: the surplus seeds fade out, then leave the roster at the end.
+  const auto smaller = presetWithSeeds(app, 2, 1.f);
+  app.applyPresetFromHost(smaller, true);
+  runTicks(app, AppState::kPresetCrossfadeTicks / 2);
+  TEST_ASSERT_EQUAL_UINT32(startCount + 2, app.seeds().size());
+  TEST_ASSERT_TRUE(app.seeds()[startCount].density < 2.f);
+  runTicks(app, AppState::kPresetCrossfadeTicks);
+  TEST_ASSERT_EQUAL_UINT32(2u, app.seeds().size());
+  TEST_ASSERT_NULL(app.debugScheduledSeed(2));
+  TEST_ASSERT_EQUAL_FLOAT(1.f, app.debugScheduledSeed(1)->density);
+}
+
+void test_preset_crossfade_honours_length_and_curves() {
+  AppState app;
+  app.initSim();
+  runTicks(app, 1);
+  const auto low = presetWithSeeds(app, app.seeds().size(), 0.f);
+  app.applyPresetFromHost(low, false);
+  runTicks(app, 1);
+
+  // A long fade with an equal-power density curve: halfway through, density
+  // sits well above the linear midpoint (the quarter-sine rise bulges it).
+  constexpr std::uint32_t kLongFade = AppState::kPresetCrossfadeTicks * 4;
+  app.setPresetCrossfadeTicks(kLongFade);
+  app.setPresetCrossfadeCurve(SeedParam::kDensity, CrossfadeCurve::kEqualPower);
+  const auto high = presetWithSeeds(app, app.seeds().size(), 4.f);
+  app.applyPresetFromHost(high, true);
+  runTicks(app, kLongFade / 2 + 1);
+  const float density = app.seeds()[0].density;
+  TEST_ASSERT_TRUE(density > 2.5f);
+  TEST_ASSERT_TRUE(density < 4.f);
+  // Pitch stayed linear, so it sits on the straight line between endpoints.
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 12.f, app.seeds()[0].pitch);
+  runTicks(app, kLongFade);
+  TEST_ASSERT_EQUAL_FLOAT(4.f, app.seeds()[0].density);
+
+  // Zero ticks means "cut", even when the caller asked for a crossfade.
+  app.setPresetCrossfadeTicks(0);
+  app.applyPresetFromHost(low, true);
+  runTicks(app, 1);
+  TEST_ASSERT_EQUAL_FLOAT(0.f, app.seeds()[0].density);
+}
+
+void test_preset_crossfade_equal_power_holds_equal_endpoints() {
+  AppState app;
+  app.initSim();
+  runTicks(app, 1);
+  auto scene = presetWithSeeds(app, app.seeds().size(), 4.f);
+  for (auto& seed : scene.seeds) {
+    seed.probability = 1.f;
+    seed.envS = 1.f;
+  }
+  app.applyPresetFromHost(scene, false);
+  runTicks(app, 1);
+
+  // Same values on both sides, every parameter on the equal-power curve: the
+  // fade has nothing to do, so nothing may move, least of all past 1.
+  app.setPresetCrossfadeTicks(AppState::kPresetCrossfadeTicks * 2);
+  for (std::size_t p = 0; p < static_cast<std::size_t>(SeedParam::kCount); ++p) {
+    app.setPresetCrossfadeCurve(static_cast<SeedParam>(p), CrossfadeCurve::kEqualPower);
+  }
+  scene.slot = "xfade-again";
+  app.applyPresetFromHost(scene, true);
+  for (std::uint32_t tick = 0; tick < AppState::kPresetCrossfadeTicks * 2 + 1; ++tick) {
+    app.tick();
+    const Seed& seed = app.seeds()[0];
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 4.f, seed.density);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.f, seed.probability);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.f, seed.envS);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 12.f, seed.pitch);
+  }
+}
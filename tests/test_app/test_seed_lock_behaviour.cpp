@@ -89,3 +89,42 @@ void test_quantize_control_snaps_pitch_to_scale() {
   TEST_ASSERT_FLOAT_WITHIN(1e-4f, quantized.pitch, samplerSeed->pitch);
 }
 
+void test_quantize_custom_scale_mask_round_trips_through_presets() {
+  AppState app;
+  app.initSim();
+  const uint8_t focus = app.focusSeed();
+  AppState::SeedNudge nudge{};
+  nudge.pitchSemitones = 3.4f - app.seeds()[focus].pitch;
+  app.seedPageNudge(focus, nudge);
+
+  // Without a loaded mask the custom slot does not exist, so scale 5 clamps
+  // down to the last built-in scale.
+  const uint8_t customFromC = static_cast<uint8_t>(AppState::kQuantizeCustomScaleIndex * 32u);
+  app.applyQuantizeControlFromHost(customFromC);
+  TEST_ASSERT_EQUAL_UINT8(4, app.quantizeScaleIndex());
+
+  // Whole-tone from C: 3.4 sits between 2 and 4 and snaps up to 4, where the
+  // chromatic scale would have stopped at 3.
+  nudge.pitchSemitones = 3.4f - app.seeds()[focus].pitch;
+  app.seedPageNudge(focus, nudge);
+  app.setQuantizeScaleMaskFromHost(0xF555);
+  TEST_ASSERT_EQUAL_UINT16(0x0555, app.quantizeScaleMask());
+  app.applyQuantizeControlFromHost(customFromC);
+  TEST_ASSERT_EQUAL_UINT8(AppState::kQuantizeCustomScaleIndex, app.quantizeScaleIndex());
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 4.f, app.seeds()[focus].pitch);
+
+  seedbox::Preset restored{};
+  TEST_ASSERT_TRUE(seedbox::Preset::deserialize(app.snapshotPresetForHost("whole").serialize(), restored));
+  TEST_ASSERT_EQUAL_UINT16(0x0555, restored.quantize.scaleMask);
+  TEST_ASSERT_EQUAL_UINT8(AppState::kQuantizeCustomScaleIndex, restored.quantize.scaleIndex);
+
+  // Dropping the mask falls back to chromatic; recalling the scene brings the
+  // compiled scale and its slot back.
+  app.setQuantizeScaleMaskFromHost(0);
+  TEST_ASSERT_EQUAL_UINT8(0, app.quantizeScaleIndex());
+  app.applyPresetFromHost(restored, false);
+  app.tick();
+  TEST_ASSERT_EQUAL_UINT16(0x0555, app.quantizeScaleMask());
+  TEST_ASSERT_EQUAL_UINT8(AppState::kQuantizeCustomScaleIndex, app.quantizeScaleIndex());
+}
+
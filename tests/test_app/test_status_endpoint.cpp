@@ -28,6 +28,8 @@ void test_status_snapshot_reports_focus_seed_and_clock_state() {
   host.oversizeBlockDropCount = 1;
   host.lastOversizeBlockFrames = 512;
   host.preparedScratchFrames = 4096;
+  host.commandQueueOverflowCount = 9;
+  host.commandQueueHighWater = 31;
   app.setHostDiagnosticsFromHost(host);
 
   AppState::StatusSnapshot status{};
@@ -48,6 +50,8 @@ void test_status_snapshot_reports_focus_seed_and_clock_state() {
   TEST_ASSERT_EQUAL_UINT32(1u, status.hostDiagnostics.oversizeBlockDropCount);
   TEST_ASSERT_EQUAL_UINT32(512u, status.hostDiagnostics.lastOversizeBlockFrames);
   TEST_ASSERT_EQUAL_UINT32(4096u, status.hostDiagnostics.preparedScratchFrames);
+  TEST_ASSERT_EQUAL_UINT32(9u, status.hostDiagnostics.commandQueueOverflowCount);
+  TEST_ASSERT_EQUAL_UINT32(31u, status.hostDiagnostics.commandQueueHighWater);
   TEST_ASSERT_EQUAL_UINT8(SeedBoxConfig::kQuietMode ? 1u : 0u, status.quietMode ? 1u : 0u);
 }
 
@@ -66,6 +70,7 @@ void test_status_json_contains_expected_fields() {
   host.oversizeBlockDropCount = 2;
   host.lastOversizeBlockFrames = 1024;
   host.preparedScratchFrames = 8192;
+  host.commandQueueMaxLatencyUs = 1250;
   app.setHostDiagnosticsFromHost(host);
 
   const std::string json = app.captureStatusJson();
@@ -78,6 +83,8 @@ void test_status_json_contains_expected_fields() {
   TEST_ASSERT_TRUE(contains(json, "\"oversizeBlockDropCount\":2"));
   TEST_ASSERT_TRUE(contains(json, "\"lastOversizeBlockFrames\":1024"));
   TEST_ASSERT_TRUE(contains(json, "\"preparedScratchFrames\":8192"));
+  TEST_ASSERT_TRUE(contains(json, "\"commandQueueOverflowCount\":0"));
+  TEST_ASSERT_TRUE(contains(json, "\"commandQueueMaxLatencyUs\":1250}"));
   TEST_ASSERT_TRUE(contains(json, "\"externalClockDominant\":true"));
   TEST_ASSERT_TRUE(contains(json, "\"focusSeed\":{\"present\":true"));
   TEST_ASSERT_TRUE(contains(json, "\"engineId\":3"));
@@ -0,0 +1,125 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "app/AppState.h"
+#include "app/StatusTelemetry.h"
+#include "hal/Board.h"
+
+namespace {
+using Field = StatusTelemetry::Field;
+
+seedbox::StatusSnapshot baseStatus() {
+  seedbox::StatusSnapshot status{};
+  status.masterSeed = 0xCAFEF00Du;
+  status.bpm = 120.0f;
+  status.schedulerTick = 96;
+  status.hasFocusedSeed = true;
+  status.focusSeedId = 3;
+  return status;
+}
+}  // namespace
+
+void test_status_telemetry_reports_only_changed_fields() {
+  StatusTelemetry telemetry;
+  StatusTelemetry::Change changes[StatusTelemetry::kFieldCount]{};
+  TEST_ASSERT_EQUAL_UINT32(0u, telemetry.changesSince(0, changes, StatusTelemetry::kFieldCount));
+
+  auto status = baseStatus();
+  TEST_ASSERT_EQUAL_UINT32(1u, telemetry.publish(StatusTelemetry::sample(status, 2, 1)));
+  // The first publish stamps every slot, zeros included.
+  TEST_ASSERT_EQUAL_UINT32(StatusTelemetry::kFieldCount, telemetry.changesSince(0, changes, StatusTelemetry::kFieldCount));
+  TEST_ASSERT_EQUAL_UINT32(2u, static_cast<std::uint32_t>(telemetry.value(Field::kMode)));
+
+  // Nothing moved: same sequence, empty delta.
+  TEST_ASSERT_EQUAL_UINT32(1u, telemetry.publish(StatusTelemetry::sample(status, 2, 1)));
+  TEST_ASSERT_EQUAL_UINT32(0u, telemetry.changesSince(1, changes, StatusTelemetry::kFieldCount));
+
+  status.bpm = 121.5f;
+  status.schedulerTick = 97;
+  TEST_ASSERT_EQUAL_UINT32(2u, telemetry.publish(StatusTelemetry::sample(status, 2, 1)));
+  TEST_ASSERT_EQUAL_UINT32(2u, telemetry.changesSince(1, changes, StatusTelemetry::kFieldCount));
+  TEST_ASSERT_EQUAL(Field::kBpm, changes[0].field);
+  TEST_ASSERT_EQUAL_FLOAT(121.5f, StatusTelemetry::bitsToFloat(changes[0].value));
+  TEST_ASSERT_EQUAL(Field::kSchedulerTick, changes[1].field);
+  TEST_ASSERT_EQUAL_UINT64(97u, changes[1].value);
+  TEST_ASSERT_EQUAL_UINT32(2u, telemetry.fieldSequence(Field::kBpm));
+  TEST_ASSERT_EQUAL_UINT32(1u, telemetry.fieldSequence(Field::kMasterSeed));
+
+  // A consumer that polls less often still sees everything since its own N.
+  status.hostDiagnostics.midiDroppedCount = 4;
+  telemetry.publish(StatusTelemetry::sample(status, 2, 1));
+  TEST_ASSERT_EQUAL_UINT32(3u, telemetry.changesSince(1, changes, StatusTelemetry::kFieldCount));
+  TEST_ASSERT_EQUAL_UINT32(1u, telemetry.changesSince(2, changes, StatusTelemetry::kFieldCount));
+  TEST_ASSERT_EQUAL(Field::kMidiDroppedCount, changes[0].field);
+}
+
+void test_status_telemetry_frames_round_trip_through_mirror() {
+  StatusTelemetry telemetry;
+  StatusTelemetry::Mirror mirror;
+  std::uint8_t frame[StatusTelemetry::kMaxFrameBytes]{};
+
+  auto status = baseStatus();
+  telemetry.publish(StatusTelemetry::sample(status, 0, 0));
+  const std::size_t full = telemetry.encodeSince(0, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(full > 0u);
+  TEST_ASSERT_TRUE(mirror.apply(frame, full));
+  TEST_ASSERT_EQUAL_UINT32(1u, mirror.sequence());
+  TEST_ASSERT_EQUAL_UINT32(0xCAFEF00Du, static_cast<std::uint32_t>(mirror.value(Field::kMasterSeed)));
+  TEST_ASSERT_EQUAL_FLOAT(120.0f, StatusTelemetry::bitsToFloat(mirror.value(Field::kBpm)));
+
+  status.schedulerTick = 1u << 20u;
+  telemetry.publish(StatusTelemetry::sample(status, 0, 0));
+  const std::size_t delta = telemetry.encodeSince(mirror.sequence(), frame, sizeof(frame));
+  // Header (5 bytes) plus one field id and a three-byte varint.
+  TEST_ASSERT_EQUAL_UINT32(9u, delta);
+  TEST_ASSERT_TRUE(mirror.apply(frame, delta));
+  TEST_ASSERT_EQUAL_UINT32(2u, mirror.sequence());
+  TEST_ASSERT_EQUAL_UINT64(1u << 20u, mirror.value(Field::kSchedulerTick));
+  TEST_ASSERT_EQUAL_UINT32(1u << static_cast<unsigned>(Field::kSchedulerTick), mirror.lastChangedMask());
+
+  // Truncated, foreign, or too-small destinations are refused outright.
+  TEST_ASSERT_FALSE(mirror.apply(frame, delta - 1));
+  frame[0] = 'X';
+  TEST_ASSERT_FALSE(mirror.apply(frame, delta));
+  TEST_ASSERT_EQUAL_UINT32(2u, mirror.sequence());
+  TEST_ASSERT_EQUAL_UINT32(0u, telemetry.encodeSince(0, frame, 4));
+}
+
+void test_app_state_polls_status_telemetry_deltas() {
+  hal::nativeBoardReset();
+  AppState app(hal::nativeBoard());
+  app.initSim();
+  app.tick();
+
+  StatusTelemetry::Mirror mirror;
+  std::uint8_t frame[StatusTelemetry::kMaxFrameBytes]{};
+  const std::size_t full = app.pollStatusTelemetry(0, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(mirror.apply(frame, full));
+  TEST_ASSERT_EQUAL_UINT32(app.masterSeed(), static_cast<std::uint32_t>(mirror.value(Field::kMasterSeed)));
+  TEST_ASSERT_EQUAL_UINT64(app.schedulerTicks(), mirror.value(Field::kSchedulerTick));
+
+  // Polling again without ticking yields an empty delta.
+  const std::size_t idle = app.pollStatusTelemetry(mirror.sequence(), frame, sizeof(frame));
+  TEST_ASSERT_TRUE(mirror.apply(frame, idle));
+  TEST_ASSERT_EQUAL_UINT32(0u, mirror.lastChangedMask());
+
+  // A host BPM change (smoothed toward 133) shows up as its own slot; the
+  // master seed does not resend.
+  app.setInternalBpmFromHost(133.0f);
+  app.tick();
+  const std::size_t delta = app.pollStatusTelemetry(mirror.sequence(), frame, sizeof(frame));
+  TEST_ASSERT_TRUE(mirror.apply(frame, delta));
+  TEST_ASSERT_TRUE((mirror.lastChangedMask() & (1u << static_cast<unsigned>(Field::kBpm))) != 0u);
+  TEST_ASSERT_EQUAL_UINT32(0u, mirror.lastChangedMask() & (1u << static_cast<unsigned>(Field::kMasterSeed)));
+  AppState::StatusSnapshot status{};
+  app.captureStatusSnapshot(status);
+  TEST_ASSERT_EQUAL_FLOAT(status.bpm, StatusTelemetry::bitsToFloat(mirror.value(Field::kBpm)));
+
+  const std::string json = app.captureStatusJson();
+  std::printf("[status-telemetry] json=%zu bytes full=%zu delta=%zu\n", json.size(), full, delta);
+  TEST_ASSERT_TRUE(delta < full);
+  TEST_ASSERT_TRUE(full < json.size());
+}
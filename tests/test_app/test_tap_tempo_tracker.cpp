@@ -30,3 +30,72 @@ void test_tap_tempo_tracker_caps_history() {
   const float expected = 60000.0f / 650.0f;
   TEST_ASSERT_FLOAT_WITHIN(0.0001f, expected, tracker.currentBpm());
 }
+
+void test_tap_tempo_tracker_shrugs_off_jitter_and_missed_taps() {
+  TapTempoTracker tracker;
+  // 120 BPM with +-12 ms of human slop, and one tap forgotten entirely.
+  const std::int64_t jitterUs[] = {0, 9000, -12000, 4000, -7000, 11000, -3000, 6000};
+  std::uint64_t beat = 10000000;
+  for (int i = 0; i < 8; ++i) {
+    if (i == 5) {
+      beat += 500000;  // missed tap: two beats pass before the next one
+    }
+    tracker.noteTap(static_cast<std::uint64_t>(static_cast<std::int64_t>(beat) + jitterUs[i]));
+    beat += 500000;
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 120.0f, tracker.currentBpm());
+  TEST_ASSERT_TRUE(tracker.confidence() > 0.8f);
+}
+
+void test_tap_tempo_tracker_rejects_double_taps_but_follows_tempo_changes() {
+  TapTempoTracker tracker;
+  std::uint64_t t = 1000000;
+  for (int i = 0; i < 5; ++i, t += 500000) {
+    tracker.noteTap(t);
+  }
+  const std::uint64_t lastGood = t - 500000;
+  // A stray bounce 180 ms after the last good tap is ignored...
+  TEST_ASSERT_FALSE(tracker.noteTap(lastGood + 180000).has_value());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 120.0f, tracker.currentBpm());
+  // ...and the next real tap still measures a full beat from the good one.
+  const auto interval = tracker.noteTap(lastGood + 500000);
+  TEST_ASSERT_TRUE(interval.has_value());
+  TEST_ASSERT_EQUAL_UINT32(500u, *interval);
+  TEST_ASSERT_EQUAL_UINT64(lastGood + 500000, tracker.lastTapUs());
+
+  // A real change to 150 BPM is an outlier once, then confirmed.
+  t = lastGood + 500000;
+  t += 400000;
+  TEST_ASSERT_FALSE(tracker.noteTap(t).has_value());
+  t += 400000;
+  TEST_ASSERT_TRUE(tracker.noteTap(t).has_value());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 150.0f, tracker.currentBpm());
+  // Two fresh intervals is not much evidence yet.
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, tracker.confidence());
+}
+
+void test_tap_tempo_tracker_confirms_half_tempo() {
+  TapTempoTracker tracker;
+  std::uint64_t t = 1000000;
+  for (int i = 0; i < 5; ++i, t += 500000) {
+    tracker.noteTap(t);
+  }
+  t -= 500000;
+  // One ~2-beat gap is a missed tap: folded, tempo unchanged.
+  t += 1000000;
+  const auto folded = tracker.noteTap(t);
+  TEST_ASSERT_TRUE(folded.has_value());
+  TEST_ASSERT_EQUAL_UINT32(500u, *folded);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 120.0f, tracker.currentBpm());
+  // The same gap again is the performer dropping to half tempo.
+  t += 1010000;
+  const auto confirmed = tracker.noteTap(t);
+  TEST_ASSERT_TRUE(confirmed.has_value());
+  TEST_ASSERT_EQUAL_UINT32(1010u, *confirmed);
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 60.0f, tracker.currentBpm());
+  TEST_ASSERT_EQUAL_UINT64(t, tracker.lastTapUs());
+  // And it sticks: the next tap at the new spacing agrees.
+  t += 1000000;
+  TEST_ASSERT_TRUE(tracker.noteTap(t).has_value());
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 60.0f, tracker.currentBpm());
+}
@@ -5,6 +5,7 @@
 #include "app/AppState.h"
 #include "engine/EngineRouter.h"
 #include "ui/AsciiOledView.h"
+#include "ui/TextFrame.h"
 
 namespace {
 
@@ -80,3 +81,50 @@ void test_debug_meter_toggle_updates_metrics_and_mode() {
   TEST_ASSERT_NOT_NULL(strstr(debugSnap.metrics, "F"));
 }
 
+void test_ascii_view_counts_partial_refresh_bytes() {
+  AppState::DisplaySnapshot snap{};
+  std::strcpy(snap.title, "SeedBox");
+  std::strcpy(snap.status, "S1 GRA");
+  std::strcpy(snap.metrics, "D1.00 P0.85");
+  std::strcpy(snap.nuance, "jitter 7.5ms");
+  UiState ui{};
+  ui.bpm = 120.0f;
+  std::strcpy(ui.engineName.data(), "Granular");
+
+  ui::AsciiOledView view(false);
+  view.present(snap, ui);
+  // The first frame paints from a blank panel, status bar included, but still
+  // skips the rows and columns no text touches.
+  const std::size_t full = ui::FullFlushBytes();
+  TEST_ASSERT_TRUE(view.lastFlushBytes() > 0);
+  TEST_ASSERT_TRUE(view.lastFlushBytes() < full);
+  TEST_ASSERT_TRUE(view.lastDiff().spans[0].fullWidth);
+
+  // One tempo digit: "PRFI120" -> "PRFI121" touches a single glyph cell, which
+  // straddles SH1107 pages 0 and 1.
+  ui.bpm = 121.0f;
+  view.present(snap, ui);
+  TEST_ASSERT_EQUAL_UINT32(1, view.lastDiff().spanCount);
+  const auto& span = view.lastDiff().spans[0];
+  TEST_ASSERT_EQUAL_UINT8(0, span.line);
+  TEST_ASSERT_EQUAL_UINT8(6, span.firstColumn);
+  TEST_ASSERT_EQUAL_UINT8(7, span.endColumn);
+  TEST_ASSERT_EQUAL_UINT32(2 * (ui::oled::kPageCommandBytes + ui::oled::kGlyphWidth), view.lastFlushBytes());
+
+  // Dropping the last line leaves a span that clears exactly its old text.
+  const ui::TextFrame before = ui::ComposeTextFrame(snap, ui);
+  snap.nuance[0] = '\0';
+  view.present(snap, ui);
+  TEST_ASSERT_EQUAL_UINT32(1, view.lastDiff().spanCount);
+  TEST_ASSERT_EQUAL_UINT8(before.lineCount - 1, view.lastDiff().spans[0].line);
+  TEST_ASSERT_EQUAL_UINT8(0, view.lastDiff().spans[0].firstColumn);
+  TEST_ASSERT_EQUAL_UINT8(std::strlen("jitter 7.5ms"), view.lastDiff().spans[0].endColumn);
+
+  // Re-presenting the same frame costs nothing and records no new frame.
+  const std::size_t totalBefore = view.totalFlushBytes();
+  view.present(snap, ui);
+  TEST_ASSERT_EQUAL_UINT32(totalBefore, view.totalFlushBytes());
+  TEST_ASSERT_EQUAL_UINT32(3, view.frames().size());
+  TEST_ASSERT_EQUAL_UINT32(3 * full, view.totalFullFlushBytes());
+  TEST_ASSERT_TRUE(view.totalFlushBytes() * 2 < view.totalFullFlushBytes());
+}
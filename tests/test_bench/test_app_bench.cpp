@@ -0,0 +1,254 @@
+// Cost receipts for the app layer: preset packing, display capture, the
+// Q15 write-out and control journal replay.  The behaviour behind each loop is pinned in tests/test_app;
+// this file times it.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "SeedLock.h"
+#include "hal/Board.h"
+#include "app/AppState.h"
+#include "app/ControlJournal.h"
+#include "app/DisplaySnapshotBuilder.h"
+#include "app/Preset.h"
+#include "hal/hal_audio_q15.h"
+#include "io/PresetCodec.h"
+
+namespace {
+std::filesystem::path projectRoot() {
+#ifdef SEEDBOX_PROJECT_ROOT_HINT
+  return std::filesystem::path(SEEDBOX_PROJECT_ROOT_HINT);
+#else
+  return std::filesystem::current_path();
+#endif
+}
+
+// Compact JSON for every teaching preset, the bytes savePreset() would pack.
+std::vector<std::vector<std::uint8_t>> loadTeachingJson() {
+  std::vector<std::filesystem::path> paths;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(projectRoot() / "presets" / "teaching", ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".json") {
+      paths.push_back(entry.path());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  std::vector<std::vector<std::uint8_t>> json;
+  for (const auto& path : paths) {
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    seedbox::Preset preset{};
+    if (seedbox::Preset::deserialize(bytes, preset)) {
+      json.push_back(preset.serialize());
+    }
+  }
+  return json;
+}
+
+DisplaySnapshotBuilder::Input seededInput(const std::vector<Seed>& seeds, const SeedLock& seedLock) {
+  DisplaySnapshotBuilder::Input input{};
+  input.masterSeed = 0x00C0FFEEu;
+  input.sampleRate = 48000.0f;
+  input.framesPerBlock = 128;
+  input.mode = static_cast<std::uint8_t>(AppState::Mode::HOME);
+  input.seeds = &seeds;
+  input.seedLock = &seedLock;
+  input.schedulerSeed = &seeds.front();
+  return input;
+}
+
+// The pre-kernel HAL conversion, the baseline the Q15 block path is timed
+// against.
+std::int16_t legacyQuantize(float x) {
+  const float clamped = std::fmin(std::fmax(x, -1.0f), 1.0f);
+  return static_cast<std::int16_t>(clamped * 32767.0f);
+}
+
+double megabytesPerSecond(std::size_t bytes, std::chrono::steady_clock::duration elapsed) {
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds : 0.0;
+}
+}  // namespace
+
+void test_preset_codec_throughput() {
+  const auto fixtures = loadTeachingJson();
+  TEST_ASSERT_FALSE(fixtures.empty());
+  std::size_t jsonTotal = 0;
+  for (const auto& json : fixtures) {
+    jsonTotal += json.size();
+  }
+
+  constexpr int kRounds = 200;
+  std::size_t sink = 0;
+  const auto packStart = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto& json : fixtures) {
+      sink += seedbox::io::packPresetBlob(json).size();
+    }
+  }
+  const auto packElapsed = std::chrono::steady_clock::now() - packStart;
+
+  std::vector<std::vector<std::uint8_t>> packedFixtures;
+  for (const auto& json : fixtures) {
+    packedFixtures.push_back(seedbox::io::packPresetBlob(json));
+  }
+  const auto unpackStart = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto& packed : packedFixtures) {
+      std::vector<std::uint8_t> unpacked;
+      seedbox::io::unpackPresetBlob(packed, unpacked);
+      sink += unpacked.size();
+    }
+  }
+  const auto unpackElapsed = std::chrono::steady_clock::now() - unpackStart;
+  std::printf("[preset-codec-bench] pack=%.1f MB/s unpack=%.1f MB/s (sink=%zu)\n",
+              megabytesPerSecond(jsonTotal * kRounds, packElapsed),
+              megabytesPerSecond(jsonTotal * kRounds, unpackElapsed), sink);
+  TEST_ASSERT_TRUE(sink > jsonTotal * kRounds);
+}
+
+void test_display_snapshot_builder_capture_benchmark() {
+  // Per-tick capture cost, old style (fresh builder, every field formatted)
+  // against the persistent builder.  Only the callback counter and the frame
+  // counter move between ticks, which is what an idle front panel looks like.
+  constexpr int kTicks = 20000;
+  SeedLock seedLock{};
+  std::vector<Seed> seeds(1);
+  seeds.front().prng = 0x1234u;
+  seeds.front().pitch = -2.5f;
+  auto input = seededInput(seeds, seedLock);
+  input.debugMetersEnabled = false;
+  seedbox::DisplaySnapshot snap{};
+  UiState ui{};
+
+  std::uint32_t coldFields = 0;
+  const auto coldStart = std::chrono::steady_clock::now();
+  for (int i = 0; i < kTicks; ++i) {
+    input.audioCallbackCount = static_cast<std::uint64_t>(i);
+    input.frame = static_cast<std::uint64_t>(i);
+    input.ledOn = (i & 0x40) != 0;
+    DisplaySnapshotBuilder fresh;
+    fresh.build(snap, ui, input);
+    coldFields += fresh.lastFormattedFields();
+  }
+  const auto coldNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - coldStart).count();
+
+  DisplaySnapshotBuilder warm;
+  std::uint32_t warmFields = 0;
+  const auto warmStart = std::chrono::steady_clock::now();
+  for (int i = 0; i < kTicks; ++i) {
+    input.audioCallbackCount = static_cast<std::uint64_t>(i);
+    input.frame = static_cast<std::uint64_t>(i);
+    input.ledOn = (i & 0x40) != 0;
+    warm.build(snap, ui, input);
+    warmFields += warm.lastFormattedFields();
+  }
+  const auto warmNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - warmStart).count();
+
+  std::printf("[display-bench] ticks=%d cold=%.1f ns/capture (%u fields) warm=%.1f ns/capture (%u fields)\n", kTicks,
+              static_cast<double>(coldNs) / kTicks, coldFields, static_cast<double>(warmNs) / kTicks, warmFields);
+  // The field counts prove both loops did their work.  The LED flips every
+  // 64 ticks, so the warm builder formats the whole frame once and then one
+  // status line per flip.
+  TEST_ASSERT_EQUAL_UINT32(7u * kTicks, coldFields);
+  TEST_ASSERT_EQUAL_UINT32(7u + (kTicks - 1) / 64, warmFields);
+}
+
+void test_q15_block_conversion_benchmark() {
+  // Host-side write-out cost per 128-frame block.  The Teensy cycle counts
+  // live in tests/test_hardware.
+  constexpr std::size_t kFrames = 128;
+  constexpr int kBlocks = 20000;
+  float in[kFrames];
+  const auto resetInput = [&in]() {
+    for (std::size_t i = 0; i < kFrames; ++i) {
+      in[i] = std::sin(static_cast<float>(i) * 0.11f) * 1.1f;
+    }
+  };
+  std::int16_t out[kFrames]{};
+
+  // The input drifts a hair every block so neither loop can be hoisted.
+  resetInput();
+  std::int64_t legacySum = 0;
+  const auto legacyStart = std::chrono::steady_clock::now();
+  for (int b = 0; b < kBlocks; ++b) {
+    in[b % kFrames] += 1e-5f;
+    for (std::size_t i = 0; i < kFrames; ++i) {
+      out[i] = legacyQuantize(in[i]);
+    }
+    legacySum += out[b % kFrames];
+  }
+  const auto legacyNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - legacyStart).count();
+
+  resetInput();
+  std::int64_t blockSum = 0;
+  const auto blockStart = std::chrono::steady_clock::now();
+  for (int b = 0; b < kBlocks; ++b) {
+    in[b % kFrames] += 1e-5f;
+    hal::audio::floatBlockToQ15(in, out, kFrames);
+    blockSum += out[b % kFrames];
+  }
+  const auto blockNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - blockStart).count();
+
+  std::printf("[q15-bench] frames=%zu legacy=%.1f ns/block q15=%.1f ns/block\n", kFrames,
+              static_cast<double>(legacyNs) / kBlocks, static_cast<double>(blockNs) / kBlocks);
+  // Same input, same bits: the sums have to agree exactly.
+  TEST_ASSERT_EQUAL_INT64(legacySum, blockSum);
+}
+
+void test_control_journal_replay_benchmark() {
+  // How much faster than realtime a recorded host session replays.  The
+  // bit-exact check itself lives in tests/test_app/test_control_journal.cpp.
+  constexpr float kSampleRate = 48000.0f;
+  constexpr std::size_t kFrames = 128;
+  constexpr int kBlocks = 1500;  // ~4 s of audio
+
+  hal::nativeBoardReset();
+  ControlJournal::Header header{};
+  header.boot = ControlJournal::Boot::kJuceHost;
+  header.sampleRate = kSampleRate;
+  header.framesPerBlock = kFrames;
+  ControlJournal journal(header);
+  AppState app(hal::nativeBoard());
+  app.initJuceHost(kSampleRate, kFrames);
+  app.attachControlJournal(&journal);
+  std::vector<float> left(kFrames);
+  std::vector<float> right(kFrames);
+  for (int block = 0; block < kBlocks; ++block) {
+    if (block == 10) {
+      app.reseed(0xC0FFEEu);
+    } else if (block == 90) {
+      app.onExternalControlChange(0, 74, 100);
+    }
+    app.tickHostAudio();
+    hal::audio::renderHostBuffer(left.data(), right.data(), kFrames);
+    if (block % 8 == 0) {
+      app.serviceHostMaintenance();
+    }
+  }
+  app.attachControlJournal(nullptr);
+  std::vector<std::uint8_t> bytes;
+  journal.encode(bytes);
+
+  const auto start = std::chrono::steady_clock::now();
+  const ControlJournal::ReplayResult result = ControlJournal::replay(journal);
+  const double replayMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  const double sessionMs = kBlocks * kFrames * 1000.0 / kSampleRate;
+  std::printf("[control-journal-bench] events=%zu bytes=%zu session=%.0f ms replay=%.1f ms (%.0fx realtime)\n",
+              journal.events().size(), bytes.size(), sessionMs, replayMs,
+              replayMs > 0.0 ? sessionMs / replayMs : 0.0);
+  TEST_ASSERT_TRUE(result.ok);
+}
@@ -0,0 +1,159 @@
+// Cost receipts for the engines.  Nothing here is a behaviour check: each
+// loop prints its timing and asserts just enough to prove it did the work.
+// The suite is opt-in (see tests/README.md), so `pio test -e native` stays
+// fast and quiet.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <unity.h>
+
+#include "Seed.h"
+#include "engine/BurstEngine.h"
+#include "engine/EuclidEngine.h"
+#include "engine/Granular.h"
+#include "util/CaptureRing.h"
+
+namespace {
+constexpr std::size_t kBurstBlock = 64;
+
+BurstEngine makeBurst(std::int32_t cluster, std::int32_t spacing) {
+  BurstEngine engine;
+  Engine::PrepareContext ctx{};
+  ctx.sampleRate = 48000;
+  ctx.framesPerBlock = kBurstBlock;
+  ctx.masterSeed = 0x5EEDB0B5u;
+  engine.prepare(ctx);
+  engine.onParam({0, static_cast<std::uint16_t>(BurstEngine::Param::kClusterCount), cluster});
+  engine.onParam({0, static_cast<std::uint16_t>(BurstEngine::Param::kSpacingSamples), spacing});
+  return engine;
+}
+}  // namespace
+
+void test_burst_render_benchmark_max_cluster() {
+  // Cost receipt for renderAudio with a full 16-hit cluster fired every
+  // 512 samples, which keeps the whole voice pool busy. Timing is printed,
+  // not asserted; the launch count and energy are, so the loop cannot be empty.
+  constexpr std::size_t kBlocks = 4096;
+  auto engine = makeBurst(static_cast<std::int32_t>(BurstEngine::kMaxClusterCount), 24);
+  Seed seed{};
+  seed.id = 11;
+  seed.tone = 0.5f;
+  seed.envD = 0.25f;
+
+  std::array<float, kBurstBlock> left{};
+  std::array<float, kBurstBlock> right{};
+  double energy = 0.0;
+  std::size_t peakVoices = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t b = 0; b < kBlocks; ++b) {
+    if (b % 8 == 0) {
+      engine.onSeed({seed, static_cast<std::uint32_t>(engine.renderSample() + 5)});
+    }
+    left.fill(0.0f);
+    right.fill(0.0f);
+    Engine::RenderContext ctx{nullptr, nullptr, left.data(), right.data(), kBurstBlock};
+    engine.renderAudio(ctx);
+    energy += static_cast<double>(left[kBurstBlock / 2] * left[kBurstBlock / 2]);
+    peakVoices = std::max(peakVoices, engine.activeVoiceCount());
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  const double frames = static_cast<double>(kBlocks * kBurstBlock);
+  std::printf("[burst-bench] cluster=%zu voices=%zu ns/frame=%.2f ns/block=%.1f dropped=%u\n",
+              BurstEngine::kMaxClusterCount, peakVoices, ns / frames, ns / kBlocks, engine.droppedHits());
+  TEST_ASSERT_EQUAL_UINT64(kBlocks * kBurstBlock, engine.renderSample());
+  TEST_ASSERT_EQUAL_UINT32(BurstEngine::kMaxVoices, peakVoices);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.droppedHits());
+  TEST_ASSERT_TRUE(energy > 0.0);
+}
+
+void test_euclid_lane_benchmark() {
+  // Cost receipt for a tick across every lane. Timing is printed, not asserted;
+  // the gate total is, so the loop cannot be optimised into nothing.
+  Engine::PrepareContext ctx{};
+  EuclidEngine engine;
+  engine.prepare(ctx);
+  for (std::uint32_t lane = 0; lane < EuclidEngine::kMaxLanes; ++lane) {
+    const int steps = 5 + static_cast<int>(lane % 60);
+    engine.onParam({lane, static_cast<std::uint16_t>(EuclidEngine::Param::kSteps), steps});
+    engine.onParam({lane, static_cast<std::uint16_t>(EuclidEngine::Param::kFills), 1 + static_cast<int>(lane % 4)});
+  }
+  TEST_ASSERT_EQUAL_UINT32(EuclidEngine::kMaxLanes, engine.laneCount());
+
+  constexpr std::uint32_t kTicks = 200000;
+  std::uint64_t gates = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::uint32_t tick = 0; tick < kTicks; ++tick) {
+    engine.onTick({tick});
+    gates += static_cast<std::uint64_t>(__builtin_popcountll(engine.laneGates()));
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  std::printf("[euclid-bench] lanes=%zu ns/tick=%.1f ns/lane-tick=%.2f gates=%llu\n", engine.laneCount(),
+              ns / kTicks, ns / (static_cast<double>(kTicks) * EuclidEngine::kMaxLanes),
+              static_cast<unsigned long long>(gates));
+  TEST_ASSERT_TRUE(gates > kTicks);
+}
+
+void test_granular_live_grain_benchmark_40_grains() {
+#if SEEDBOX_HW
+  TEST_IGNORE_MESSAGE("Benchmark runs on the native build only");
+#else
+  // Cost receipt for a full 40-grain live cloud scattering over four seconds
+  // of captured noise.  Energy is asserted so the loop cannot be optimised
+  // away.
+  constexpr std::size_t kGrains = 40;
+  constexpr std::size_t kBlock = 128;
+  constexpr std::size_t kBlocks = 750;  // two seconds at 128 frames
+  constexpr float kRate = 48000.0f;
+  util::CaptureRing ring;
+  ring.prepare(4.0f, kRate);
+  std::array<float, kBlock> block{};
+  uint32_t noise = 0x1234567u;
+  for (std::size_t b = 0; b < static_cast<std::size_t>(4.0f * kRate) / kBlock; ++b) {
+    for (auto& s : block) {
+      noise = noise * 1664525u + 1013904223u;
+      s = static_cast<float>(noise >> 8) / 8388608.0f - 1.0f;
+    }
+    ring.write(block.data(), nullptr, block.size());
+  }
+  ring.markOnset();
+
+  GranularEngine engine;
+  engine.prepare({false, static_cast<uint32_t>(kRate), static_cast<uint32_t>(kBlock), 0u});
+  engine.setMaxActiveVoices(static_cast<uint8_t>(kGrains));
+  engine.attachLiveCapture(&ring);
+  for (uint32_t i = 0; i < kGrains; ++i) {
+    Seed seed{};
+    seed.id = 100 + i;
+    seed.prng = 0x51CE0000u + seed.id;
+    seed.granular.source = static_cast<uint8_t>(GranularEngine::Source::kLiveInput);
+    seed.granular.grainSizeMs = 30.0f + static_cast<float>(i);
+    seed.granular.sprayMs = 5.0f;
+    seed.granular.stereoSpread = 0.3f;
+    seed.granular.transpose = -6.0f + 0.3f * static_cast<float>(i);
+    engine.trigger(seed, 0u);
+  }
+  TEST_ASSERT_EQUAL_UINT8(kGrains, engine.activeVoiceCount());
+
+  // Silence keeps arriving, so the grains chew on the noise already captured.
+  std::array<float, kBlock> silence{};
+  std::array<float, kBlock> left{};
+  std::array<float, kBlock> right{};
+  double energy = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t b = 0; b < kBlocks; ++b) {
+    ring.write(silence.data(), nullptr, silence.size());
+    left.fill(0.0f);
+    right.fill(0.0f);
+    engine.renderAudio({silence.data(), silence.data(), left.data(), right.data(), kBlock});
+    energy += std::fabs(left[kBlock / 2]) + std::fabs(right[kBlock / 2]);
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  const double grainSamples = static_cast<double>(kGrains * kBlocks * kBlock);
+  std::printf("[granular-live-bench] grains=%zu ring_s=%.1f ns/block=%.1f ns/grain-sample=%.2f\n", kGrains,
+              ring.seconds(), ns / kBlocks, ns / grainSamples);
+  TEST_ASSERT_TRUE(energy > 0.0);
+#endif
+}
@@ -0,0 +1,29 @@
+#include <unity.h>
+
+void test_burst_render_benchmark_max_cluster();
+void test_euclid_lane_benchmark();
+void test_granular_live_grain_benchmark_40_grains();
+void test_scheduler_on_tick_benchmark();
+void test_scale_quantizer_block_benchmark();
+void test_param_ramp_benchmark_64_params();
+void test_oversampler_benchmark_per_quality();
+void test_preset_codec_throughput();
+void test_display_snapshot_builder_capture_benchmark();
+void test_q15_block_conversion_benchmark();
+void test_control_journal_replay_benchmark();
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_burst_render_benchmark_max_cluster);
+  RUN_TEST(test_euclid_lane_benchmark);
+  RUN_TEST(test_granular_live_grain_benchmark_40_grains);
+  RUN_TEST(test_scheduler_on_tick_benchmark);
+  RUN_TEST(test_scale_quantizer_block_benchmark);
+  RUN_TEST(test_param_ramp_benchmark_64_params);
+  RUN_TEST(test_oversampler_benchmark_per_quality);
+  RUN_TEST(test_preset_codec_throughput);
+  RUN_TEST(test_display_snapshot_builder_capture_benchmark);
+  RUN_TEST(test_q15_block_conversion_benchmark);
+  RUN_TEST(test_control_journal_replay_benchmark);
+  return UNITY_END();
+}
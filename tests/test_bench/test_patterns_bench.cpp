@@ -0,0 +1,57 @@
+// onTick() cost receipt for rosters far bigger than the four front panel slots.
+// Timing is printed, not asserted; see tests/test_patterns/test_scheduler_roster.cpp
+// for the behaviour this loop leans on.
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "Seed.h"
+#include "engine/Patterns.h"
+#include "util/RNG.h"
+
+namespace {
+void countFired(void* ctx, const Seed&, uint32_t) { ++*static_cast<uint32_t*>(ctx); }
+
+// Same spread as the roster test: silent to busy densities, so hits land on
+// different ticks.
+std::vector<Seed> makeRoster(std::size_t count) {
+  std::vector<Seed> roster(count);
+  uint32_t state = 0x5EEDB0B1u;
+  for (std::size_t i = 0; i < count; ++i) {
+    Seed& s = roster[i];
+    s.id = static_cast<uint32_t>(i);
+    s.prng = RNG::xorshift(state);
+    s.density = (i % 11 == 0) ? 0.f : 0.25f + 0.25f * static_cast<float>(state % 12u);
+    s.probability = 0.5f + 0.05f * static_cast<float>((state >> 8) % 10u);
+    s.jitterMs = (i % 3 == 0) ? 0.f : static_cast<float>((state >> 16) % 6u);
+  }
+  return roster;
+}
+}  // namespace
+
+void test_scheduler_on_tick_benchmark() {
+  // The trigger totals are asserted so the benchmark cannot quietly measure an
+  // empty loop.
+  constexpr int kTicks = 24 * 64;
+  for (std::size_t count : {std::size_t{4}, std::size_t{64}, std::size_t{256}, std::size_t{1024}}) {
+    PatternScheduler ps;
+    uint32_t triggers = 0;
+    ps.setTriggerCallback(&triggers, countFired);
+    ps.reserveSeeds(count);
+    for (const Seed& s : makeRoster(count)) {
+      ps.addSeed(s);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < kTicks; ++tick) {
+      ps.onTick();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("[scheduler-bench] seeds=%4zu ns/tick=%9.1f ns/seed-tick=%6.2f triggers=%u\n", count,
+                ns / kTicks, ns / (static_cast<double>(kTicks) * static_cast<double>(count)), triggers);
+    TEST_ASSERT_TRUE(triggers > 0);
+    TEST_ASSERT_EQUAL_UINT64(static_cast<uint64_t>(kTicks), ps.ticks());
+  }
+}
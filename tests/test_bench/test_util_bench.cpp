@@ -0,0 +1,103 @@
+// Cost receipts for the util primitives.  Same deal as test_engine_bench.cpp:
+// timing is printed, and the checksum is only asserted so the loop has to run.
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <unity.h>
+
+#include "util/Oversampler.h"
+#include "util/ParamRamp.h"
+#include "util/ScaleQuantizer.h"
+
+void test_scale_quantizer_block_benchmark() {
+  // Cost receipt for a scheduler-sized batch.
+  using util::QuantizerMode;
+  using util::ScaleQuantizer;
+  constexpr std::size_t kPitches = 512;
+  constexpr int kRounds = 2000;
+  std::vector<float> in(kPitches);
+  std::vector<float> out(kPitches);
+  for (std::size_t i = 0; i < kPitches; ++i) {
+    in[i] = -36.0f + static_cast<float>((i * 37) % 720) * 0.1f;
+  }
+  const ScaleQuantizer::Table& table = ScaleQuantizer::TableFor(ScaleQuantizer::Scale::kMinor);
+  float checksum = 0.0f;
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    table.quantizeBlock(in.data(), out.data(), kPitches, static_cast<std::uint8_t>(round % 12),
+                        QuantizerMode::kNearest);
+    checksum += out[static_cast<std::size_t>(round) % kPitches];
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  std::printf("[scale_quantizer-bench] block=%zu ns/pitch=%.2f checksum=%.1f\n", kPitches,
+              ns / (static_cast<double>(kRounds) * kPitches), static_cast<double>(checksum));
+  TEST_ASSERT_TRUE(std::isfinite(checksum));
+}
+
+void test_param_ramp_benchmark_64_params() {
+  // Cost receipt: 64 parameters all gliding at once, retargeted every block
+  // so none of them ever settles.
+  constexpr std::size_t kParams = 64;
+  constexpr std::uint32_t kFrames = 128;
+  constexpr int kBlocks = 4000;
+  std::array<util::ParamRamp, kParams> ramps{};
+  for (std::size_t p = 0; p < kParams; ++p) {
+    ramps[p].configure(5.0f + static_cast<float>(p), 48000.0f,
+                       (p % 2) ? util::ParamRamp::Curve::kOnePole : util::ParamRamp::Curve::kLinear);
+    ramps[p].reset(0.0f);
+  }
+  float checksum = 0.0f;
+  const auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < kBlocks; ++block) {
+    for (std::size_t p = 0; p < kParams; ++p) {
+      ramps[p].setTarget((block + static_cast<int>(p)) % 2 ? 1.0f : 0.0f);
+    }
+    for (std::uint32_t i = 0; i < kFrames; ++i) {
+      float sum = 0.0f;
+      for (auto& ramp : ramps) {
+        sum += ramp.next();
+      }
+      checksum += sum * (1.0f / 64.0f);
+    }
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  const double samples = static_cast<double>(kBlocks) * kFrames;
+  std::printf("[param_ramp-bench] params=%zu ns/sample=%.1f ns/param-sample=%.2f checksum=%.1f\n", kParams,
+              ns / samples, ns / (samples * kParams), static_cast<double>(checksum));
+  TEST_ASSERT_TRUE(std::isfinite(checksum));
+}
+
+void test_oversampler_benchmark_per_quality() {
+  // Cost receipt: one channel of hot tanh at each quality.
+  using Factor = util::Oversampler::Factor;
+  using Phase = util::Oversampler::Phase;
+  struct Rung {
+    const char* label;
+    util::Oversampler::Quality quality;
+  };
+  constexpr std::array<Rung, 5> kLadder{{{"off", {Factor::kOff, Phase::kMinimum}},
+                                         {"2x-minimum", {Factor::k2x, Phase::kMinimum}},
+                                         {"2x-linear", {Factor::k2x, Phase::kLinear}},
+                                         {"4x-minimum", {Factor::k4x, Phase::kMinimum}},
+                                         {"4x-linear", {Factor::k4x, Phase::kLinear}}}};
+  constexpr std::size_t kSamples = 48000 * 4;
+  for (const Rung& rung : kLadder) {
+    util::Oversampler os;
+    os.setQuality(rung.quality);
+    float checksum = 0.0f;
+    float phase = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kSamples; ++i) {
+      phase += 0.61f;
+      phase = phase > 6.2831853f ? phase - 6.2831853f : phase;
+      checksum += os.process(std::sin(phase), [](float v) { return std::tanh(2.5f * v); });
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("[oversampler-bench] quality=%s ns/sample=%.1f latency=%.1f checksum=%.3f\n", rung.label,
+                ns / kSamples, static_cast<double>(os.latency()), static_cast<double>(checksum));
+    TEST_ASSERT_TRUE(std::isfinite(checksum));
+  }
+}
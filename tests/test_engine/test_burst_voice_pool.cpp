@@ -0,0 +1,109 @@
+#include <array>
+#include <cmath>
+#include <vector>
+#include <unity.h>
+
+#include "Seed.h"
+#include "engine/BurstEngine.h"
+
+namespace {
+constexpr std::size_t kBlock = 64;
+
+BurstEngine makeEngine(std::int32_t cluster, std::int32_t spacing) {
+  BurstEngine engine;
+  Engine::PrepareContext ctx{};
+  ctx.sampleRate = 48000;
+  ctx.framesPerBlock = kBlock;
+  ctx.masterSeed = 0x5EEDB0B5u;
+  engine.prepare(ctx);
+  engine.onParam({0, static_cast<std::uint16_t>(BurstEngine::Param::kClusterCount), cluster});
+  engine.onParam({0, static_cast<std::uint16_t>(BurstEngine::Param::kSpacingSamples), spacing});
+  return engine;
+}
+
+// Render `blocks` callbacks and append the left channel to `out`.
+void renderBlocks(BurstEngine& engine, std::size_t blocks, std::vector<float>& out) {
+  std::array<float, kBlock> left{};
+  std::array<float, kBlock> right{};
+  for (std::size_t b = 0; b < blocks; ++b) {
+    left.fill(0.0f);
+    right.fill(0.0f);
+    Engine::RenderContext ctx{nullptr, nullptr, left.data(), right.data(), kBlock};
+    engine.renderAudio(ctx);
+    out.insert(out.end(), left.begin(), left.end());
+  }
+}
+}  // namespace
+
+void test_burst_hits_render_on_their_exact_sample() {
+  auto engine = makeEngine(3, 100);
+  Seed seed{};
+  seed.id = 9;
+  seed.tone = 0.0f;  // pure tone + click, no noise, so silence really is zero
+  // 150 sits mid-block, so the launch has to honour the offset inside a block.
+  engine.onSeed({seed, 150});
+  TEST_ASSERT_EQUAL_UINT32(3, engine.queuedHits());
+
+  std::vector<float> left;
+  renderBlocks(engine, 3, left);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, left[149]);
+  TEST_ASSERT_TRUE(left[150] > 0.0f);
+  // Second hit is still in the future after three blocks; the first has played.
+  TEST_ASSERT_EQUAL_UINT32(1, engine.activeVoiceCount());
+  TEST_ASSERT_EQUAL_UINT32(2, engine.queuedHits());
+
+  renderBlocks(engine, 3, left);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.queuedHits());
+  TEST_ASSERT_EQUAL_UINT32(150, engine.voice(0).startSample);
+  TEST_ASSERT_EQUAL_UINT32(250, engine.voice(1).startSample);
+  TEST_ASSERT_EQUAL_UINT32(350, engine.voice(2).startSample);
+  // Later hits in the cluster taper off.
+  TEST_ASSERT_TRUE(engine.voice(1).amplitude < engine.voice(0).amplitude);
+  TEST_ASSERT_TRUE(engine.voice(2).amplitude < engine.voice(1).amplitude);
+  // The click lands right on each hit, on top of the ringing voices.
+  TEST_ASSERT_TRUE(left[250] - left[249] > 0.05f);
+
+  // Voices retire themselves once the envelope has rung out.
+  renderBlocks(engine, 48000 / kBlock, left);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.activeVoiceCount());
+
+  engine.onSeed({seed, static_cast<std::uint32_t>(engine.renderSample() + 10)});
+  renderBlocks(engine, 1, left);
+  TEST_ASSERT_EQUAL_UINT32(1, engine.activeVoiceCount());
+  engine.panic();
+  TEST_ASSERT_EQUAL_UINT32(0, engine.activeVoiceCount());
+  TEST_ASSERT_EQUAL_UINT32(0, engine.queuedHits());
+}
+
+void test_burst_ring_and_voice_pool_stay_bounded() {
+  auto engine = makeEngine(32, 0);
+  TEST_ASSERT_EQUAL_UINT8(BurstEngine::kMaxClusterCount, engine.clusterCount());
+  Seed seed{};
+  seed.id = 3;
+
+  // Five full clusters before the audio thread gets a look in: the ring keeps
+  // exactly its capacity and counts the rest instead of growing.
+  for (int i = 0; i < 5; ++i) {
+    engine.onSeed({seed, 32});
+  }
+  TEST_ASSERT_EQUAL_UINT32(BurstEngine::kHitRingCapacity, engine.queuedHits());
+  TEST_ASSERT_EQUAL_UINT32(5 * BurstEngine::kMaxClusterCount - BurstEngine::kHitRingCapacity,
+                           engine.droppedHits());
+
+  // Every queued hit shares one start sample, so the pool steals oldest-first
+  // by handle and the last kMaxVoices launches are the ones left sounding.
+  std::vector<float> left;
+  renderBlocks(engine, 1, left);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.queuedHits());
+  TEST_ASSERT_EQUAL_UINT32(BurstEngine::kMaxVoices, engine.activeVoiceCount());
+  const std::uint32_t launched = static_cast<std::uint32_t>(BurstEngine::kHitRingCapacity);
+  for (std::size_t i = 0; i < BurstEngine::kMaxVoices; ++i) {
+    const auto voice = engine.voice(i);
+    TEST_ASSERT_TRUE(voice.active);
+    TEST_ASSERT_EQUAL_UINT32(32, voice.startSample);
+    TEST_ASSERT_TRUE(voice.handle > launched - BurstEngine::kMaxVoices);
+  }
+  for (float sample : left) {
+    TEST_ASSERT_TRUE(std::isfinite(sample));
+  }
+}
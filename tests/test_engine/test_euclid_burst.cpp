@@ -3,7 +3,9 @@
 #endif
 
 #include <unity.h>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -105,6 +107,76 @@ void run_euclid_mask() {
   runScenario(3, rotateMask(baseMask, 3));
 }
 
+void run_euclid_lanes() {
+  // BuildMask must match the byte-per-step construction it replaced for every
+  // legal steps/fills/rotate combination, all the way up to 64 steps.
+  for (int steps = 1; steps <= EuclidEngine::kMaxSteps; ++steps) {
+    for (int fills = 0; fills <= steps; ++fills) {
+      std::vector<std::uint8_t> reference(static_cast<std::size_t>(steps), 0u);
+      for (int i = 0; i < steps; ++i) {
+        reference[static_cast<std::size_t>(i)] = ((i + 1) * fills / steps) > (i * fills / steps) ? 1u : 0u;
+      }
+      for (int rotate = 0; rotate < steps; rotate += (steps > 16 ? 7 : 1)) {
+        const auto expected = rotateMask(reference, static_cast<std::uint8_t>(rotate));
+        const std::uint64_t bits = EuclidEngine::BuildMask(static_cast<std::uint8_t>(steps),
+                                                           static_cast<std::uint8_t>(fills),
+                                                           static_cast<std::uint8_t>(rotate));
+        for (int i = 0; i < 64; ++i) {
+          const std::uint8_t want = i < steps ? expected[static_cast<std::size_t>(i)] : 0u;
+          TEST_ASSERT_EQUAL_UINT8_MESSAGE(want, (bits >> i) & 1u, "Euclid bitmask mismatch");
+        }
+      }
+    }
+  }
+
+  // Three seeds, three lanes: 1-in-4, 1-in-3, and a long 64-step lane. Every
+  // tick advances them all, so the 4-against-3 polyrhythm lines up every 12.
+  Engine::PrepareContext ctx{};
+  ctx.masterSeed = 0x0BADF00Du;
+  EuclidEngine engine;
+  engine.prepare(ctx);
+  const auto setLane = [&engine](std::uint32_t seedId, int steps, int fills, int rotate) {
+    engine.onParam({seedId, static_cast<std::uint16_t>(EuclidEngine::Param::kSteps), steps});
+    engine.onParam({seedId, static_cast<std::uint16_t>(EuclidEngine::Param::kFills), fills});
+    engine.onParam({seedId, static_cast<std::uint16_t>(EuclidEngine::Param::kRotate), rotate});
+  };
+  setLane(0, 4, 1, 3);
+  setLane(1, 3, 1, 2);
+  setLane(2, 64, 5, 0);
+  TEST_ASSERT_EQUAL_UINT32(3, engine.laneCount());
+  TEST_ASSERT_EQUAL_UINT8(4, engine.steps());
+  TEST_ASSERT_EQUAL_UINT8(64, engine.steps(2));
+  TEST_ASSERT_EQUAL_UINT32(64, engine.mask(2).size());
+
+  for (std::uint32_t tick = 0; tick < 12; ++tick) {
+    engine.onTick({tick});
+    TEST_ASSERT_EQUAL_INT(tick % 4 == 0, engine.laneGate(0));
+    TEST_ASSERT_EQUAL_INT(tick % 3 == 0, engine.laneGate(1));
+    TEST_ASSERT_EQUAL_INT(engine.laneGate(0), engine.lastGate());
+    TEST_ASSERT_EQUAL_INT(engine.mask(2)[tick], engine.laneGate(2));
+  }
+
+  // Mid-cycle round trip: the restored engine carries on exactly in step.
+  const auto state = engine.serializeState();
+  TEST_ASSERT_EQUAL_UINT32(15 + 1 + 2 * 4, state.size());
+  EuclidEngine restored;
+  restored.prepare(ctx);
+  restored.deserializeState(state);
+  TEST_ASSERT_EQUAL_UINT32(3, restored.laneCount());
+  for (std::uint32_t tick = 12; tick < 140; ++tick) {
+    engine.onTick({tick});
+    restored.onTick({tick});
+    TEST_ASSERT_EQUAL_UINT64(engine.laneGates(), restored.laneGates());
+  }
+
+  // A single-lane snapshot keeps the original 15-byte layout.
+  EuclidEngine single;
+  single.prepare(ctx);
+  TEST_ASSERT_EQUAL_UINT32(15, single.serializeState().size());
+  single.deserializeState(single.serializeState());
+  TEST_ASSERT_EQUAL_UINT32(1, single.laneCount());
+}
+
 void run_burst_spacing() {
   BurstEngine engine;
   Engine::PrepareContext ctx{};
@@ -189,6 +261,8 @@ void run_engine_display_snapshots() {
 
 void test_euclid_mask() { run_euclid_mask(); }
 
+void test_euclid_lanes() { run_euclid_lanes(); }
+
 void test_burst_spacing() { run_burst_spacing(); }
 
 void test_router_reseed_and_locks() { run_router_reseed_and_locks(); }
@@ -7,14 +7,31 @@ void test_granular_perf_stats_refresh();
 void test_granular_perf_stats_sd_only_runs_drop_back_when_voice_reused();
 void test_granular_perf_stats_profiles_mixer_fanout();
 void test_granular_graph_layout_tracks_dsp_handles();
+void test_granular_live_grains_scatter_across_capture_ring();
+void test_granular_live_grains_are_deterministic_per_seed();
+void test_resonator_excites_from_frozen_capture();
 void test_resonator_maps_seed_into_voice_plan();
 void test_resonator_voice_stealing_by_start_then_handle();
 void test_resonator_preset_lookup_guards_index();
 void test_sampler_stores_seed_state();
 void test_sampler_voice_stealing_is_oldest_first();
 void test_sampler_spread_width_maps_constant_power_curve();
+void test_sampler_param_targets_glide_per_sample();
 void test_euclid_mask();
+void test_euclid_lanes();
 void test_burst_spacing();
+void test_burst_hits_render_on_their_exact_sample();
+void test_burst_ring_and_voice_pool_stay_bounded();
+void test_voice_allocator_policies_pick_expected_victim();
+void test_sampler_quietest_policy_spares_loud_voice();
+void test_sampler_steal_fades_instead_of_clicking();
+void test_engine_steal_counters_and_retrigger();
+void test_voice_governor_keeps_deadline_misses_low();
+void test_voice_governor_retires_voices_with_fades();
+void test_engine_router_governor_sheds_and_restores();
+void test_rate_cache_matches_inline_math_at_reference_rate();
+void test_engines_hold_pitch_and_time_across_host_rates();
+void test_nonlinear_oversampling_cuts_engine_aliasing();
 void test_router_reseed_and_locks();
 void test_engine_display_snapshots();
 
@@ -27,14 +44,31 @@ int main(int, char**) {
   RUN_TEST(test_granular_perf_stats_sd_only_runs_drop_back_when_voice_reused);
   RUN_TEST(test_granular_perf_stats_profiles_mixer_fanout);
   RUN_TEST(test_granular_graph_layout_tracks_dsp_handles);
+  RUN_TEST(test_granular_live_grains_scatter_across_capture_ring);
+  RUN_TEST(test_granular_live_grains_are_deterministic_per_seed);
+  RUN_TEST(test_resonator_excites_from_frozen_capture);
   RUN_TEST(test_resonator_maps_seed_into_voice_plan);
   RUN_TEST(test_resonator_voice_stealing_by_start_then_handle);
   RUN_TEST(test_resonator_preset_lookup_guards_index);
   RUN_TEST(test_sampler_stores_seed_state);
   RUN_TEST(test_sampler_voice_stealing_is_oldest_first);
   RUN_TEST(test_sampler_spread_width_maps_constant_power_curve);
+  RUN_TEST(test_sampler_param_targets_glide_per_sample);
   RUN_TEST(test_euclid_mask);
+  RUN_TEST(test_euclid_lanes);
   RUN_TEST(test_burst_spacing);
+  RUN_TEST(test_burst_hits_render_on_their_exact_sample);
+  RUN_TEST(test_burst_ring_and_voice_pool_stay_bounded);
+  RUN_TEST(test_voice_allocator_policies_pick_expected_victim);
+  RUN_TEST(test_sampler_quietest_policy_spares_loud_voice);
+  RUN_TEST(test_sampler_steal_fades_instead_of_clicking);
+  RUN_TEST(test_engine_steal_counters_and_retrigger);
+  RUN_TEST(test_voice_governor_keeps_deadline_misses_low);
+  RUN_TEST(test_voice_governor_retires_voices_with_fades);
+  RUN_TEST(test_engine_router_governor_sheds_and_restores);
+  RUN_TEST(test_rate_cache_matches_inline_math_at_reference_rate);
+  RUN_TEST(test_engines_hold_pitch_and_time_across_host_rates);
+  RUN_TEST(test_nonlinear_oversampling_cuts_engine_aliasing);
   RUN_TEST(test_router_reseed_and_locks);
   RUN_TEST(test_engine_display_snapshots);
   return UNITY_END();
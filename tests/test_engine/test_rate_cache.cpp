@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+#include <unity.h>
+
+#include "Seed.h"
+#include "engine/BurstEngine.h"
+#include "engine/RateCache.h"
+#include "engine/Resonator.h"
+#include "engine/Sampler.h"
+
+namespace {
+constexpr std::array<std::uint32_t, 4> kHostRates{44100u, 48000u, 88200u, 96000u};
+
+template <typename EngineT>
+std::vector<float> renderSeconds(EngineT& engine, std::uint32_t sampleRate, float seconds) {
+  const std::size_t frames = static_cast<std::size_t>(seconds * static_cast<float>(sampleRate));
+  std::vector<float> out;
+  std::array<float, 128> left{};
+  std::array<float, 128> right{};
+  while (out.size() < frames) {
+    left.fill(0.0f);
+    right.fill(0.0f);
+    engine.renderAudio({nullptr, nullptr, left.data(), right.data(), left.size()});
+    out.insert(out.end(), left.begin(), left.end());
+  }
+  out.resize(frames);
+  return out;
+}
+
+// Frequency from the first and last rising zero crossings in [from, to),
+// interpolated between samples so the answer is not quantized to one frame.
+float risingCrossingHz(const std::vector<float>& x, std::size_t from, std::size_t to, float sampleRate) {
+  double first = -1.0;
+  double last = -1.0;
+  int crossings = 0;
+  for (std::size_t i = std::max<std::size_t>(from, 1); i < std::min(to, x.size()); ++i) {
+    if (x[i - 1] < 0.0f && x[i] >= 0.0f) {
+      const double at = static_cast<double>(i - 1) + x[i - 1] / (x[i - 1] - x[i]);
+      if (first < 0.0) {
+        first = at;
+      }
+      last = at;
+      ++crossings;
+    }
+  }
+  if (crossings < 2) {
+    return 0.0f;
+  }
+  return static_cast<float>((crossings - 1) * sampleRate / (last - first));
+}
+
+float peakIn(const std::vector<float>& x, float fromSeconds, float toSeconds, float sampleRate) {
+  float peak = 0.0f;
+  const auto from = static_cast<std::size_t>(fromSeconds * sampleRate);
+  const auto to = std::min(x.size(), static_cast<std::size_t>(toSeconds * sampleRate));
+  for (std::size_t i = from; i < to; ++i) {
+    peak = std::max(peak, std::fabs(x[i]));
+  }
+  return peak;
+}
+}  // namespace
+
+void test_rate_cache_matches_inline_math_at_reference_rate() {
+  // Golden renders hash the pitch ratios the engines store, so the table has
+  // to agree with the pow() it replaced to the last bit.
+  RateCache cache;
+  for (int semitones = -RateCache::kPitchTableSemitones; semitones <= RateCache::kPitchTableSemitones; ++semitones) {
+    const float s = static_cast<float>(semitones);
+    TEST_ASSERT_TRUE(cache.pitchRatio(s) == std::pow(2.0f, s / 12.0f));
+  }
+  TEST_ASSERT_TRUE(cache.pitchRatio(3.25f) == std::pow(2.0f, 3.25f / 12.0f));
+  TEST_ASSERT_TRUE(cache.pitchRatio(60.0f) == std::pow(2.0f, 60.0f / 12.0f));
+  TEST_ASSERT_EQUAL_size_t(96000u, cache.samples(2.0f));
+  TEST_ASSERT_EQUAL_UINT32(480u, cache.msToSamples(10.0f));
+  TEST_ASSERT_TRUE(cache.onePole(0.2f) == 0.2f);
+
+  // At twice the rate a one-pole runs twice per 48 kHz sample, so two steps
+  // of the new coefficient must close the same gap as one step of the old.
+  cache.prepare(96000.0f);
+  const float c = cache.onePole(0.2f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.8f, (1.0f - c) * (1.0f - c));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 48000.0f / 440.0f, cache.periodSamples(440.0f) * 0.5f);
+  // Zero or negative rates mean "host did not say": fall back to 48 kHz.
+  cache.prepare(0.0f);
+  TEST_ASSERT_EQUAL_FLOAT(RateCache::kReferenceRate, cache.sampleRate());
+}
+
+void test_engines_hold_pitch_and_time_across_host_rates() {
+  for (std::uint32_t sr : kHostRates) {
+    const float rate = static_cast<float>(sr);
+
+    // Sampler fallback voice: a fifth above A4, 71 ms from attack to the end
+    // of the release.
+    Sampler sampler;
+    sampler.prepare({false, sr, 128u, 0u});
+    Seed note{};
+    note.id = 1;
+    note.pitch = 7.0f;
+    note.envA = 0.001f;
+    note.envD = 0.02f;
+    note.envS = 0.8f;
+    note.envR = 0.05f;
+    sampler.trigger(note, 0u);
+    const auto sampled = renderSeconds(sampler, sr, 0.2f);
+    std::size_t lastSound = 0;
+    for (std::size_t i = 0; i < sampled.size(); ++i) {
+      if (sampled[i] != 0.0f) {
+        lastSound = i;
+      }
+    }
+    const float samplerSeconds = static_cast<float>(lastSound + 1) / rate;
+    const float samplerHz = risingCrossingHz(sampled, 0, lastSound, rate);
+
+    // Burst: one pure-tone hit at 220 Hz ringing down 60 dB in 0.2 s, so
+    // 0.1 s later it should sit 30 dB lower.
+    BurstEngine burst;
+    burst.prepare({false, sr, 128u, 0x51u});
+    burst.onParam({0, static_cast<std::uint16_t>(BurstEngine::Param::kClusterCount), 1});
+    Seed hit{};
+    hit.id = 2;
+    hit.tone = 0.0f;
+    hit.envD = 0.2f;
+    burst.onSeed({hit, 0u});
+    const auto rung = renderSeconds(burst, sr, 0.25f);
+    const float burstHz = risingCrossingHz(rung, static_cast<std::size_t>(0.005f * rate), rung.size(), rate);
+    const float drop = peakIn(rung, 0.12f, 0.13f, rate) / peakIn(rung, 0.02f, 0.03f, rate);
+
+    // Resonator: the string delay is one period at the host rate.
+    ResonatorBank bank;
+    bank.prepare({false, sr, 128u, 0u});
+    Seed pluck{};
+    pluck.id = 3;
+    pluck.pitch = 5.0f;
+    bank.trigger(pluck, 0u);
+    const auto string = bank.voice(0);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.071f, samplerSeconds);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 440.0f * std::pow(2.0f, 7.0f / 12.0f), samplerHz);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 220.0f, burstHz);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f * 0.0316f, 0.0316f, drop);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 110.0f * std::pow(2.0f, 5.0f / 12.0f), string.frequency);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, rate / string.frequency, string.delaySamples);
+  }
+}
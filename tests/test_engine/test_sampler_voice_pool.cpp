@@ -124,3 +124,76 @@ void test_sampler_spread_width_maps_constant_power_curve() {
   TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, state.leftGain);
   TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, state.rightGain);
 }
+
+void test_sampler_param_targets_glide_per_sample() {
+  Sampler sampler;
+  Engine::PrepareContext prepare{};
+  prepare.sampleRate = 48000;
+  prepare.framesPerBlock = 128;
+  sampler.prepare(prepare);
+  sampler.setParamSmoothingMs(Sampler::Param::kSpread, 10.0f);  // 480 samples
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 10.0f, sampler.paramSmoothingMs(Sampler::Param::kSpread));
+
+  const Seed seed = makeSeed(21, 0, 0.0f, 0.4f, 0.0f);
+  sampler.trigger(seed, 0u);
+  TEST_ASSERT_EQUAL_UINT8(0u, sampler.rampingVoices());
+
+  // A full-width CC lands as one Q16 ParamChange.  Targets for other seeds
+  // leave this voice alone.
+  Engine::ParamChange change{};
+  change.seedId = seed.id;
+  change.id = static_cast<std::uint16_t>(Sampler::Param::kSpread);
+  change.value = Sampler::kParamUnity;
+  sampler.onParam(change);
+  TEST_ASSERT_TRUE(sampler.queueParamTarget(seed.id + 1, Sampler::Param::kTone, 1.0f));
+
+  // Render one frame at a time so every per-sample gain is visible.
+  std::array<float, 1> left{};
+  std::array<float, 1> right{};
+  Engine::RenderContext ctx{};
+  ctx.left = left.data();
+  ctx.right = right.data();
+  ctx.frames = 1;
+  const float startGain = sampler.voice(0).rightGain;
+  // Equal linear steps; the slack covers float drift over 480 additions.
+  const float maxStep = (1.0f - startGain) / 480.0f * 1.05f;
+  float previous = startGain;
+  for (int i = 0; i < 480; ++i) {
+    sampler.renderAudio(ctx);
+    const auto state = sampler.voice(0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, state.spread);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.4f, state.tone);
+    TEST_ASSERT_TRUE(state.rightGain >= previous);
+    TEST_ASSERT_TRUE(state.rightGain - previous <= maxStep);
+    previous = state.rightGain;
+    if (i < 479) {
+      TEST_ASSERT_EQUAL_UINT8(1u, sampler.rampingVoices());
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT8(0u, sampler.rampingVoices());
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, sampler.voice(0).rightGain);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, sampler.voice(0).leftGain);
+
+  // Zero smoothing is a jump on the very next sample.
+  sampler.setParamSmoothingMs(Sampler::Param::kTone, 0.0f);
+  TEST_ASSERT_TRUE(sampler.queueParamTarget(seed.id, Sampler::Param::kTone, 0.9f));
+  sampler.renderAudio(ctx);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.9f, sampler.voice(0).tone);
+  TEST_ASSERT_EQUAL_UINT8(0u, sampler.rampingVoices());
+
+  // Tone has no per-sample consumer in the sim, so it catches up once per
+  // block: half a glide in, it sits between the ends, and it lands on time.
+  sampler.setParamSmoothingMs(Sampler::Param::kTone, 10.0f);
+  TEST_ASSERT_TRUE(sampler.queueParamTarget(seed.id, Sampler::Param::kTone, 0.1f));
+  std::array<float, 240> blockLeft{};
+  std::array<float, 240> blockRight{};
+  ctx.left = blockLeft.data();
+  ctx.right = blockRight.data();
+  ctx.frames = blockLeft.size();
+  sampler.renderAudio(ctx);
+  TEST_ASSERT_TRUE(sampler.voice(0).tone < 0.9f && sampler.voice(0).tone > 0.1f);
+  TEST_ASSERT_EQUAL_UINT8(1u, sampler.rampingVoices());
+  sampler.renderAudio(ctx);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.1f, sampler.voice(0).tone);
+  TEST_ASSERT_EQUAL_UINT8(0u, sampler.rampingVoices());
+}
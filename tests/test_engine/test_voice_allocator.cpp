@@ -0,0 +1,220 @@
+#include <array>
+#include <cmath>
+#include <vector>
+#include <unity.h>
+
+#include "Seed.h"
+#include "engine/BurstEngine.h"
+#include "engine/Granular.h"
+#include "engine/Resonator.h"
+#include "engine/Sampler.h"
+#include "engine/VoiceAllocator.h"
+
+namespace {
+using Pool = std::array<VoiceAllocator::Candidate, 4>;
+
+VoiceAllocator::Choice pick(VoiceAllocator& allocator, const Pool& pool, std::uint32_t seedId,
+                            std::uint8_t priority = 128) {
+  return allocator.allocate(pool.size(), {seedId, priority}, [&](std::size_t i) { return pool[i]; });
+}
+
+Seed samplerSeed(uint32_t id, float envD, float envS, float envR) {
+  Seed seed{};
+  seed.id = id;
+  seed.prng = 0xACE00000u + id;
+  seed.envA = 0.001f;
+  seed.envD = envD;
+  seed.envS = envS;
+  seed.envR = envR;
+  seed.spread = 0.0f;
+  return seed;
+}
+
+// Render `blocks` x 128 frames and append the left channel to `out`.
+void renderSampler(Sampler& sampler, std::size_t blocks, std::vector<float>& out) {
+  std::array<float, 128> left{};
+  std::array<float, 128> right{};
+  for (std::size_t b = 0; b < blocks; ++b) {
+    left.fill(0.0f);
+    right.fill(0.0f);
+    Engine::RenderContext ctx{nullptr, nullptr, left.data(), right.data(), left.size()};
+    sampler.renderAudio(ctx);
+    out.insert(out.end(), left.begin(), left.end());
+  }
+}
+}  // namespace
+
+void test_voice_allocator_policies_pick_expected_victim() {
+  // Slot 0 is oldest but loudest, slot 2 is quietest, slot 3 has the lowest
+  // priority, slot 1 belongs to seed 42.
+  Pool pool{};
+  pool[0] = {true, 100, 1, 0.9f, 200, 7};
+  pool[1] = {true, 200, 2, 0.5f, 200, 42};
+  pool[2] = {true, 300, 3, 0.05f, 200, 8};
+  pool[3] = {true, 400, 4, 0.6f, 10, 9};
+
+  VoiceAllocator allocator;
+  TEST_ASSERT_EQUAL_UINT8(0, pick(allocator, pool, 99).index);
+  allocator.setPolicy(StealPolicy::kQuietest);
+  TEST_ASSERT_EQUAL_UINT8(2, pick(allocator, pool, 99).index);
+  allocator.setPolicy(StealPolicy::kLowestPriority);
+  TEST_ASSERT_EQUAL_UINT8(3, pick(allocator, pool, 99).index);
+  allocator.setPolicy(StealPolicy::kSameSeedRetrigger);
+  auto choice = pick(allocator, pool, 42);
+  TEST_ASSERT_EQUAL_UINT8(1, choice.index);
+  TEST_ASSERT_TRUE(choice.retrigger);
+  // Unknown seeds fall back to oldest.
+  TEST_ASSERT_EQUAL_UINT8(0, pick(allocator, pool, 99).index);
+
+  // Same-seed retrigger wins even over a free slot; everyone else takes the
+  // free slot without stealing.
+  pool[2].active = false;
+  TEST_ASSERT_EQUAL_UINT8(1, pick(allocator, pool, 42).index);
+  choice = pick(allocator, pool, 99);
+  TEST_ASSERT_EQUAL_UINT8(2, choice.index);
+  TEST_ASSERT_FALSE(choice.stolen);
+
+  // Ties fall through to age: equal levels under kQuietest pick the older.
+  allocator.setPolicy(StealPolicy::kQuietest);
+  pool[2].active = true;
+  pool[1].level = 0.05f;
+  TEST_ASSERT_EQUAL_UINT8(1, pick(allocator, pool, 99).index);
+
+  const auto& counters = allocator.counters();
+  TEST_ASSERT_EQUAL_UINT32(8, counters.allocations);
+  TEST_ASSERT_EQUAL_UINT32(5, counters.steals);
+  TEST_ASSERT_EQUAL_UINT32(2, counters.retriggers);
+  TEST_ASSERT_EQUAL_FLOAT(0.05f, counters.lastStolenLevel);
+}
+
+void test_sampler_quietest_policy_spares_loud_voice() {
+  for (StealPolicy policy : {StealPolicy::kOldest, StealPolicy::kQuietest}) {
+    Sampler sampler;
+    sampler.prepare({false, 48000u, 128u, 0u});
+    sampler.setStealPolicy(policy);
+    // The first voice sustains loud; the next three are short hits already
+    // deep in their release when the fifth trigger arrives.
+    sampler.trigger(samplerSeed(1, 0.05f, 0.9f, 2.0f), 0u);
+    for (uint32_t id = 2; id <= 4; ++id) {
+      sampler.trigger(samplerSeed(id, 0.01f, 0.2f, 0.5f), 100u * id);
+    }
+    std::vector<float> out;
+    renderSampler(sampler, 150, out);  // 0.4 s
+    TEST_ASSERT_EQUAL_UINT8(4, sampler.activeVoices());
+    TEST_ASSERT_TRUE(sampler.voice(0).level > 0.5f);
+    TEST_ASSERT_TRUE(sampler.voice(1).level < 0.2f);
+
+    sampler.trigger(samplerSeed(5, 0.05f, 0.5f, 0.2f), 19200u);
+    const auto steals = sampler.stealCounters();
+    TEST_ASSERT_EQUAL_UINT32(1, steals.steals);
+    if (policy == StealPolicy::kOldest) {
+      TEST_ASSERT_EQUAL_UINT32(5, sampler.voice(0).handle);
+      TEST_ASSERT_TRUE(steals.lastStolenLevel > 0.5f);
+    } else {
+      TEST_ASSERT_EQUAL_UINT32(1, sampler.voice(0).handle);
+      TEST_ASSERT_TRUE(steals.lastStolenLevel < 0.2f);
+    }
+  }
+}
+
+void test_sampler_steal_fades_instead_of_clicking() {
+#if SEEDBOX_HW
+  TEST_IGNORE_MESSAGE("Teensy envelopes fade stolen voices in the audio graph");
+#else
+  // Render the same four sustained voices twice, stealing one in the second
+  // run.  The difference between the runs is exactly what the steal removed:
+  // cut dead it jumps straight to the victim's value, faded it starts near
+  // zero and grows smoothly.  Several steal points spread over one 440 Hz
+  // period make sure at least one of them lands away from a zero crossing.
+  float firstGap = 0.0f;
+  float maxGapStep = 0.0f;
+  for (std::size_t offset = 0; offset < 8; ++offset) {
+    std::array<Sampler, 2> runs;
+    std::array<std::vector<float>, 2> out;
+    const std::size_t before = 2560 + offset * 13;
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+      runs[r].prepare({false, 48000u, 128u, 0u});
+      for (uint32_t id = 1; id <= Sampler::kMaxVoices; ++id) {
+        runs[r].trigger(samplerSeed(id, 0.05f, 0.9f, 2.0f), 0u);
+      }
+      std::vector<float> left(before, 0.0f);
+      std::vector<float> right(before, 0.0f);
+      runs[r].renderAudio({nullptr, nullptr, left.data(), right.data(), before});
+      if (r == 1) {
+        // Starts later, so the only change in the next 64 samples is the fade.
+        runs[r].trigger(samplerSeed(9, 0.05f, 0.9f, 2.0f), static_cast<uint32_t>(before + 512));
+        TEST_ASSERT_EQUAL_UINT8(1, runs[r].fadingVoices());
+      }
+      renderSampler(runs[r], 2, out[r]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, runs[1].fadingVoices());
+    float previous = 0.0f;
+    for (std::size_t i = 0; i < 64; ++i) {
+      const float gap = out[0][i] - out[1][i];
+      if (i == 0) {
+        firstGap = std::max(firstGap, std::fabs(gap));
+      }
+      maxGapStep = std::max(maxGapStep, std::fabs(gap - previous));
+      previous = gap;
+    }
+  }
+  // The victim peaks around 0.115, so an unfaded cut would leave gaps of that
+  // order on the first sample for most of these offsets.
+  TEST_ASSERT_TRUE(firstGap < 0.005f);
+  TEST_ASSERT_TRUE(maxGapStep < 0.01f);
+#endif
+}
+
+void test_engine_steal_counters_and_retrigger() {
+  // Granular mirrors the allocator counters into its stats block.
+  GranularEngine granular;
+  granular.init(GranularEngine::Mode::kSim);
+  granular.setMaxActiveVoices(2);
+  Seed seed{};
+  seed.granular.source = static_cast<uint8_t>(GranularEngine::Source::kSdClip);
+  for (uint32_t id = 1; id <= 3; ++id) {
+    seed.id = id;
+    granular.trigger(seed, 100u * id);
+  }
+  TEST_ASSERT_EQUAL_UINT32(3, granular.stats().steals.allocations);
+  TEST_ASSERT_EQUAL_UINT32(1, granular.stats().steals.steals);
+
+  // Resonator: lowest-probability seed gives up its slot.
+  ResonatorBank bank;
+  bank.init(ResonatorBank::Mode::kSim);
+  bank.setMaxVoices(3);
+  bank.setStealPolicy(StealPolicy::kLowestPriority);
+  const float probabilities[] = {0.9f, 0.2f, 0.7f};
+  for (uint32_t id = 1; id <= 3; ++id) {
+    Seed s{};
+    s.id = id;
+    s.probability = probabilities[id - 1];
+    bank.trigger(s, 10u * id);
+  }
+  Seed loud{};
+  loud.id = 4;
+  loud.probability = 1.0f;
+  bank.trigger(loud, 100u);
+  TEST_ASSERT_EQUAL_UINT8(4, bank.voice(1).seedId);
+  TEST_ASSERT_EQUAL_UINT32(1, bank.stealCounters().steals);
+
+  // Burst: same-seed retrigger chokes the seed's previous hit and fades it.
+  BurstEngine burst;
+  burst.prepare({false, 48000u, 128u, 0x1234u});
+  burst.setStealPolicy(StealPolicy::kSameSeedRetrigger);
+  Seed hat{};
+  hat.id = 5;
+  hat.envD = 0.4f;
+  std::array<float, 128> left{};
+  std::array<float, 128> right{};
+  for (int hit = 0; hit < 3; ++hit) {
+    burst.onSeed({hat, static_cast<uint32_t>(burst.renderSample())});
+    left.fill(0.0f);
+    right.fill(0.0f);
+    Engine::RenderContext ctx{nullptr, nullptr, left.data(), right.data(), left.size()};
+    burst.renderAudio(ctx);
+  }
+  TEST_ASSERT_EQUAL_size_t(1, burst.activeVoiceCount());
+  TEST_ASSERT_EQUAL_UINT32(2, burst.stealCounters().retriggers);
+  TEST_ASSERT_EQUAL_UINT32(0, burst.stealCounters().steals);
+}
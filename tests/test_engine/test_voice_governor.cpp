@@ -0,0 +1,202 @@
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <unity.h>
+
+#include "Seed.h"
+#include "engine/BurstEngine.h"
+#include "engine/EngineRouter.h"
+#include "engine/Sampler.h"
+#include "engine/VoiceGovernor.h"
+
+namespace {
+// 128 frames at 48 kHz.
+constexpr std::uint32_t kBudgetNanos = 2666666u;
+
+// A toy cost model standing in for the audio thread: each engine charges a
+// fixed price per sounding voice, every engine wants more voices than its
+// ceiling allows, and a deterministic +/-10% wobble keeps the loop honest.
+struct LoadModel {
+  std::array<std::uint32_t, VoiceGovernor::kLanes> nanosPerVoice{40000u, 60000u, 20000u, 0u, 10000u};
+  std::uint32_t rng{0xC0FFEEu};
+
+  // Returns the block's render time and fills in each engine's share.
+  std::uint32_t render(const VoiceGovernor& governor, std::uint32_t extraNanos, VoiceGovernor::LaneNanos& lanes) {
+    rng = rng * 1664525u + 1013904223u;
+    const float wobble = 0.9f + 0.2f * static_cast<float>(rng >> 8) / 16777216.0f;
+    std::uint32_t total = 0;
+    for (std::size_t i = 0; i < VoiceGovernor::kLanes; ++i) {
+      lanes[i] = static_cast<std::uint32_t>(static_cast<float>(nanosPerVoice[i] * governor.limit(i)) * wobble);
+      total += lanes[i];
+    }
+    return total + extraNanos;
+  }
+};
+
+void configureBootCeilings(VoiceGovernor& governor) {
+  governor.configureLane(EngineRouter::kSamplerId, 1, 4, Sampler::kMaxVoices);
+  governor.configureLane(EngineRouter::kGranularId, 4, 32, GranularEngine::kVoicePoolSize);
+  governor.configureLane(EngineRouter::kResonatorId, 1, 10, ResonatorBank::kMaxVoices);
+  governor.configureLane(EngineRouter::kBurstId, 2, 8, BurstEngine::kMaxVoices);
+}
+
+Seed sustainedSeed(std::uint32_t id) {
+  Seed seed{};
+  seed.id = id;
+  seed.prng = 0xD00D0000u + id;
+  seed.envA = 0.001f;
+  seed.envD = 0.05f;
+  seed.envS = 0.9f;
+  seed.envR = 2.0f;
+  return seed;
+}
+
+float renderSamplerBlock(Sampler& sampler, std::array<float, 128>& left) {
+  std::array<float, 128> right{};
+  left.fill(0.0f);
+  sampler.renderAudio({nullptr, nullptr, left.data(), right.data(), left.size()});
+  float energy = 0.0f;
+  for (float s : left) {
+    energy += std::fabs(s);
+  }
+  return energy;
+}
+}  // namespace
+
+void test_voice_governor_keeps_deadline_misses_low() {
+  // Boot ceilings already sit near the deadline (~0.9 load).  For 3000
+  // blocks something else on the machine steals 1.5 ms per block, which
+  // alone would push every block 45% past its deadline.  The governor has
+  // to shed its way under it, then give the voices back once the load lifts.
+  VoiceGovernor governor;
+  configureBootCeilings(governor);
+  LoadModel model;
+  VoiceGovernor::LaneNanos lanes{};
+  constexpr std::size_t kCalm = 500;
+  constexpr std::size_t kLoaded = 3000;
+  constexpr std::size_t kRecover = 6000;
+  std::size_t misses = 0;
+  std::size_t lateMisses = 0;
+  std::size_t limitMoves = 0;
+  std::uint8_t loadedGranular = 0;
+  for (std::size_t block = 0; block < kCalm + kLoaded + kRecover; ++block) {
+    const bool loaded = block >= kCalm && block < kCalm + kLoaded;
+    const std::uint32_t nanos = model.render(governor, loaded ? 1500000u : 0u, lanes);
+    if (nanos > kBudgetNanos) {
+      ++misses;
+      if (block >= kCalm + 100) {
+        ++lateMisses;
+      }
+    }
+    if (governor.noteBlock(nanos, kBudgetNanos, lanes) && block >= kCalm + 500 && loaded) {
+      ++limitMoves;
+    }
+    if (block == kCalm + kLoaded - 1) {
+      loadedGranular = governor.limit(EngineRouter::kGranularId);
+    }
+  }
+  const auto& stats = governor.stats();
+  std::printf("[voice-governor] misses=%zu/%zu late=%zu sheds=%u grows=%u granular loaded=%u final=%u\n", misses,
+              kLoaded, lateMisses, stats.sheds, stats.grows, loadedGranular,
+              governor.limit(EngineRouter::kGranularId));
+
+  TEST_ASSERT_EQUAL_UINT64(misses, stats.deadlineMisses);
+  // Under 1% of the loaded stretch, and none once the first 100 blocks have
+  // taught the governor what the machine can do.
+  TEST_ASSERT_TRUE(misses < kLoaded / 100);
+  TEST_ASSERT_EQUAL_size_t(0, lateMisses);
+  // Granular costs the most, so it gave up the most; floors hold.
+  TEST_ASSERT_TRUE(loadedGranular < 32);
+  for (std::size_t lane = 0; lane < VoiceGovernor::kLanes; ++lane) {
+    TEST_ASSERT_TRUE(governor.limit(lane) >= governor.lane(lane).floor);
+  }
+  // Hysteresis: once settled under load the ceilings barely move.
+  TEST_ASSERT_TRUE(limitMoves < 40);
+  // With the load gone the voices came back, and the loop still stops short
+  // of the deadline.
+  TEST_ASSERT_TRUE(governor.limit(EngineRouter::kGranularId) > loadedGranular);
+  TEST_ASSERT_TRUE(stats.load < 1.0f);
+}
+
+void test_voice_governor_retires_voices_with_fades() {
+#if SEEDBOX_HW
+  TEST_IGNORE_MESSAGE("Teensy envelopes fade retired voices in the audio graph");
+#else
+  // Two identical samplers; one loses half its pool mid-note.  The first
+  // sample after the cut must match the untouched run (the tails fade from
+  // full level), and the difference settles to silence within the fade.
+  std::array<Sampler, 2> runs;
+  std::array<float, 128> reference{};
+  std::array<float, 128> retired{};
+  for (auto& sampler : runs) {
+    sampler.prepare({false, 48000u, 128u, 0u});
+    for (std::uint32_t id = 1; id <= Sampler::kMaxVoices; ++id) {
+      sampler.trigger(sustainedSeed(id), 0u);
+    }
+    for (int b = 0; b < 20; ++b) {
+      renderSamplerBlock(sampler, reference);
+    }
+  }
+  runs[1].setMaxVoices(2);
+  TEST_ASSERT_EQUAL_UINT8(2, runs[1].maxVoices());
+  TEST_ASSERT_EQUAL_UINT8(2, runs[1].activeVoices());
+  TEST_ASSERT_EQUAL_UINT8(2, runs[1].fadingVoices());
+  renderSamplerBlock(runs[0], reference);
+  renderSamplerBlock(runs[1], retired);
+  TEST_ASSERT_TRUE(std::fabs(reference[0] - retired[0]) < 0.01f);
+  renderSamplerBlock(runs[1], retired);
+  TEST_ASSERT_EQUAL_UINT8(0, runs[1].fadingVoices());
+  TEST_ASSERT_TRUE(renderSamplerBlock(runs[1], retired) > 0.0f);
+
+  // New triggers stay under the lowered ceiling and steal inside it.
+  runs[1].trigger(sustainedSeed(9), 3000u);
+  TEST_ASSERT_EQUAL_UINT8(2, runs[1].activeVoices());
+  TEST_ASSERT_EQUAL_UINT32(1, runs[1].stealCounters().steals);
+
+  // Burst exciters retire the same way.
+  BurstEngine burst;
+  burst.prepare({false, 48000u, 128u, 0x77u});
+  std::array<float, 128> left{};
+  std::array<float, 128> right{};
+  for (std::uint32_t id = 1; id <= 6; ++id) {
+    Seed hit{};
+    hit.id = id;
+    hit.envD = 0.5f;
+    burst.onSeed({hit, 0u});
+  }
+  burst.renderAudio({nullptr, nullptr, left.data(), right.data(), left.size()});
+  TEST_ASSERT_TRUE(burst.activeVoiceCount() >= 3);
+  burst.setMaxVoices(2);
+  TEST_ASSERT_TRUE(burst.activeVoiceCount() <= 2);
+  TEST_ASSERT_TRUE(burst.fadingVoices() >= 1);
+#endif
+}
+
+void test_engine_router_governor_sheds_and_restores() {
+  // Injected timings through the real router: granular "costs" far more
+  // than the block has, so its ceiling falls while the others hold; turning
+  // the governor off puts the boot ceilings back.
+  EngineRouter router;
+  router.init(EngineRouter::Mode::kSim);
+  TEST_ASSERT_FALSE(router.voiceGovernorEnabled());
+  router.granular().setMaxActiveVoices(12);
+  router.setVoiceGovernorEnabled(true);
+  TEST_ASSERT_EQUAL_UINT8(12, router.voiceGovernor().limit(EngineRouter::kGranularId));
+
+  VoiceGovernor::LaneNanos lanes{};
+  lanes[EngineRouter::kSamplerId] = 100000u;
+  lanes[EngineRouter::kGranularId] = 3000000u;
+  // Every block misses, so each one sheds a quarter: 12, 9, 7, 6, 5, floor 4.
+  for (int block = 0; block < 5; ++block) {
+    router.governVoices(3200000u, kBudgetNanos, lanes);
+  }
+  TEST_ASSERT_EQUAL_UINT8(4, router.granular().maxActiveVoices());
+  TEST_ASSERT_EQUAL_UINT8(Sampler::kMaxVoices, router.sampler().maxVoices());
+  TEST_ASSERT_EQUAL_UINT64(5, router.voiceGovernor().stats().deadlineMisses);
+
+  router.setVoiceGovernorEnabled(false);
+  TEST_ASSERT_EQUAL_UINT8(12, router.granular().maxActiveVoices());
+  // Off means off: timings are ignored.
+  router.governVoices(3200000u, kBudgetNanos, lanes);
+  TEST_ASSERT_EQUAL_UINT8(12, router.granular().maxActiveVoices());
+}
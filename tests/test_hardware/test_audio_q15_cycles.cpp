@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <cstdio>
+#include <unity.h>
+
+#include "hal/hal_audio_q15.h"
+
+#if SEEDBOX_HW
+#include <Arduino.h>
+#include <AudioStream.h>
+
+namespace {
+// One 128-frame block the way the CallbackStream sees it: mostly in range,
+// with a few overs so the clamp path is exercised too.
+void fillBlock(float* block) {
+  for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) {
+    block[i] = static_cast<float>((i * 37) % 257 - 128) / 112.0f;
+  }
+}
+
+std::uint32_t cyclesFor(void (*body)(const float*, std::int16_t*), const float* in, std::int16_t* out) {
+  // Warm the caches once, then take the best of a few runs so an interrupt
+  // landing mid-measurement does not pass for the kernel's cost.
+  body(in, out);
+  std::uint32_t best = UINT32_MAX;
+  for (int run = 0; run < 16; ++run) {
+    const std::uint32_t start = ARM_DWT_CYCCNT;
+    body(in, out);
+    const std::uint32_t elapsed = ARM_DWT_CYCCNT - start;
+    best = elapsed < best ? elapsed : best;
+  }
+  return best;
+}
+
+void scalarBody(const float* in, std::int16_t* out) {
+  for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) {
+    out[i] = hal::audio::floatToQ15(in[i]);
+  }
+}
+
+void blockBody(const float* in, std::int16_t* out) { hal::audio::floatBlockToQ15(in, out, AUDIO_BLOCK_SAMPLES); }
+
+}  // namespace
+
+void test_q15_conversion_cycle_benchmark() {
+  alignas(4) static float in[AUDIO_BLOCK_SAMPLES];
+  alignas(4) static std::int16_t scalarOut[AUDIO_BLOCK_SAMPLES];
+  alignas(4) static std::int16_t blockOut[AUDIO_BLOCK_SAMPLES];
+  fillBlock(in);
+
+  const std::uint32_t scalarCycles = cyclesFor(&scalarBody, in, scalarOut);
+  const std::uint32_t blockCycles = cyclesFor(&blockBody, in, blockOut);
+  char line[96];
+  std::snprintf(line, sizeof(line), "[q15-cycles] frames=%d scalar=%lu packed=%lu cycles/block", AUDIO_BLOCK_SAMPLES,
+                static_cast<unsigned long>(scalarCycles), static_cast<unsigned long>(blockCycles));
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_MEMORY(scalarOut, blockOut, sizeof(blockOut));
+}
+
+#else  // !SEEDBOX_HW
+
+void test_q15_conversion_cycle_benchmark() {
+  TEST_IGNORE_MESSAGE("DWT cycle counts only exist on Teensy builds");
+}
+
+#endif  // SEEDBOX_HW
@@ -3,6 +3,7 @@
 void test_teensy_granular_effect_traits();
 void test_teensy_granular_assigns_dsp_handles();
 void test_teensy_granular_triggers_span_mixer_fanout();
+void test_q15_conversion_cycle_benchmark();
 
 int main(int, char **) {
   UNITY_BEGIN();
@@ -10,6 +11,7 @@ int main(int, char **) {
   RUN_TEST(test_teensy_granular_effect_traits);
   RUN_TEST(test_teensy_granular_assigns_dsp_handles);
   RUN_TEST(test_teensy_granular_triggers_span_mixer_fanout);
+  RUN_TEST(test_q15_conversion_cycle_benchmark);
 #endif
   return UNITY_END();
 }
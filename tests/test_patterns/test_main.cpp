@@ -8,6 +8,7 @@ void test_clock_tick_log_tracks_swing();
 void test_plan_grain_sprays_and_mutates_prng();
 void test_map_grain_honors_stereo_spread_width_curve();
 void test_clock_tick_log_golden();
+void test_scheduler_roster_matches_reference_walk();
 
 int main(int, char**) {
   UNITY_BEGIN();
@@ -19,5 +20,6 @@ int main(int, char**) {
   RUN_TEST(test_plan_grain_sprays_and_mutates_prng);
   RUN_TEST(test_map_grain_honors_stereo_spread_width_curve);
   RUN_TEST(test_clock_tick_log_golden);
+  RUN_TEST(test_scheduler_roster_matches_reference_walk);
   return UNITY_END();
 }
@@ -0,0 +1,114 @@
+/* PatternScheduler keeps its per-tick fields in flat lanes and only reaches for
+ * the full Seed genome when a seed clears the density gate.  These tests pin the
+ * observable behaviour of that split against a plain array-of-structs walk.
+ * The onTick() cost receipt lives in tests/test_bench.
+ */
+#include <unity.h>
+
+#include <cmath>
+#include <vector>
+
+#include "Seed.h"
+#include "engine/Patterns.h"
+#include "util/RNG.h"
+#include "util/Units.h"
+
+namespace {
+struct Fired {
+  uint32_t id;
+  uint32_t prng;
+  uint32_t when;
+};
+
+void recordFired(void* ctx, const Seed& seed, uint32_t when) {
+  static_cast<std::vector<Fired>*>(ctx)->push_back(Fired{seed.id, seed.prng, when});
+}
+
+// Scrappy mirror of the original one-struct-per-seed scheduler loop.  It walks
+// every Seed in full on every tick, which is exactly what the lanes avoid.
+struct ReferenceRoster {
+  std::vector<Seed> seeds;
+  std::vector<float> accumulators;
+
+  void tick(uint32_t tickSample, std::vector<Fired>& out) {
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+      Seed& s = seeds[i];
+      if (s.density <= 0.f) {
+        continue;
+      }
+      accumulators[i] += s.density / 24.f;
+      if (accumulators[i] < 1.f) {
+        continue;
+      }
+      accumulators[i] -= 1.f;
+      if (!(RNG::uniform01(s.prng) < s.probability)) {
+        continue;
+      }
+      int32_t jitterSamples = 0;
+      if (s.jitterMs != 0.f) {
+        const float jitterMs = RNG::uniformSigned(s.prng) * s.jitterMs;
+        jitterSamples = static_cast<int32_t>(Units::msToSamples(std::abs(jitterMs)));
+        if (jitterMs < 0.f) {
+          jitterSamples = -jitterSamples;
+        }
+      }
+      int64_t scheduled = static_cast<int64_t>(tickSample) + jitterSamples;
+      out.push_back(Fired{s.id, s.prng, static_cast<uint32_t>(scheduled < 0 ? 0 : scheduled)});
+    }
+  }
+};
+
+// Densities spread from silent to busy so hits land on different ticks and a
+// large roster does not slam the trigger queue all at once.
+std::vector<Seed> makeRoster(std::size_t count) {
+  std::vector<Seed> roster(count);
+  uint32_t state = 0x5EEDB0B1u;
+  for (std::size_t i = 0; i < count; ++i) {
+    Seed& s = roster[i];
+    s.id = static_cast<uint32_t>(i);
+    s.prng = RNG::xorshift(state);
+    s.density = (i % 11 == 0) ? 0.f : 0.25f + 0.25f * static_cast<float>(state % 12u);
+    s.probability = 0.5f + 0.05f * static_cast<float>((state >> 8) % 10u);
+    s.jitterMs = (i % 3 == 0) ? 0.f : static_cast<float>((state >> 16) % 6u);
+  }
+  return roster;
+}
+}  // namespace
+
+void test_scheduler_roster_matches_reference_walk() {
+  const auto roster = makeRoster(300);
+  PatternScheduler ps;
+  ps.reserveSeeds(roster.size());
+  std::vector<Fired> fired;
+  ps.setTriggerCallback(&fired, recordFired);
+  ReferenceRoster reference{roster, std::vector<float>(roster.size(), 0.f)};
+  for (const Seed& s : roster) {
+    ps.addSeed(s);
+  }
+  TEST_ASSERT_EQUAL_UINT32(roster.size(), ps.seedCount());
+
+  std::vector<Fired> expected;
+  for (int tick = 0; tick < 24 * 16; ++tick) {
+    ps.onTick();
+    reference.tick(ps.nowSamples(), expected);
+    if (tick == 100) {
+      // Mid-run edits flow into the hot lanes without resetting groove phase.
+      Seed edit = roster[7];
+      edit.density = 3.f;
+      edit.probability = 1.f;
+      TEST_ASSERT_TRUE(ps.updateSeed(7, edit));
+      reference.seeds[7] = edit;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(expected.size(), fired.size());
+  for (std::size_t i = 0; i < fired.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(expected[i].id, fired[i].id);
+    TEST_ASSERT_EQUAL_UINT32(expected[i].prng, fired[i].prng);
+    TEST_ASSERT_EQUAL_UINT32(expected[i].when, fired[i].when);
+  }
+  // The debug view reports the live RNG state, not the value the seed came in with.
+  for (std::size_t i = 0; i < roster.size(); i += 29) {
+    TEST_ASSERT_EQUAL_UINT32(reference.seeds[i].prng, ps.seedForDebug(i)->prng);
+  }
+}
@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "util/CaptureRing.h"
+
+namespace {
+
+void expectNear(float actual, float expected, float tolerance = 1e-5f) {
+  assert(std::fabs(actual - expected) <= tolerance);
+}
+
+// A ramp makes every position self-describing: sample n holds n (left) and -n
+// (right), so a read tells you exactly where it landed.
+std::vector<float> ramp(std::size_t start, std::size_t frames, float sign = 1.0f) {
+  std::vector<float> out(frames);
+  for (std::size_t i = 0; i < frames; ++i) {
+    out[i] = sign * static_cast<float>(start + i);
+  }
+  return out;
+}
+
+void test_power_of_two_fractional_reads_and_wrap() {
+  util::CaptureRing ring;
+  ring.prepare(0.01f, 48000.0f);  // 480 frames -> 512
+  assert(ring.capacityFrames() == 512u);
+  assert(ring.available() == 0u);
+  float l = 1.0f;
+  float r = 1.0f;
+  ring.read(1.0f, l, r);
+  expectNear(l, 0.0f);
+
+  // 700 frames in uneven blocks: the ring wraps and keeps the newest 512.
+  std::size_t written = 0;
+  for (std::size_t block : {128u, 300u, 7u, 265u}) {
+    const auto left = ramp(written, block);
+    const auto right = ramp(written, block, -1.0f);
+    ring.write(left.data(), right.data(), block);
+    written += block;
+  }
+  assert(ring.writeHead() == 700u);
+  assert(ring.available() == 512u);
+
+  ring.read(1.0f, l, r);
+  expectNear(l, 699.0f);
+  expectNear(r, -699.0f);
+  // Fractional positions interpolate between neighbours, older side second.
+  ring.read(10.25f, l, r);
+  expectNear(l, 690.0f - 0.25f, 1e-3f);
+  ring.read(512.0f, l, r);
+  expectNear(l, 188.0f);
+  // Beyond the window, or before "one frame ago", is silence.
+  ring.read(512.5f, l, r);
+  expectNear(l, 0.0f);
+  ring.read(0.5f, l, r);
+  expectNear(l, 0.0f);
+
+  // A block longer than the ring keeps only its newest frames; mono input
+  // lands on both sides.
+  const auto big = ramp(1000, 2000);
+  ring.write(big.data(), nullptr, big.size());
+  assert(ring.writeHead() == 2700u);
+  ring.read(1.0f, l, r);
+  expectNear(l, 2999.0f);
+  expectNear(r, 2999.0f);
+  ring.read(512.0f, l, r);
+  expectNear(l, 2488.0f);
+}
+
+void test_freeze_holds_and_onsets_age_out() {
+  util::CaptureRing ring;
+  ring.prepare(0.005f, 48000.0f);  // 240 -> 256 frames
+  const auto first = ramp(0, 200);
+  ring.write(first.data(), nullptr, first.size());
+  ring.markOnset();  // at frame 200
+  const auto second = ramp(200, 40);
+  ring.write(second.data(), nullptr, second.size());
+  assert(ring.onsetCount() == 1u);
+  expectNear(ring.onsetFramesAgo(0), 40.0f, 0.0f);
+
+  // Frozen: writes are counted and dropped, onsets ignored, the held window
+  // reads back unchanged.
+  ring.setFrozen(true);
+  const auto ignored = ramp(5000, 64);
+  ring.write(ignored.data(), nullptr, ignored.size());
+  ring.markOnset();
+  assert(ring.writeHead() == 240u);
+  assert(ring.heldFrames() == 64u);
+  assert(ring.onsetCount() == 1u);
+  float l = 0.0f;
+  float r = 0.0f;
+  ring.read(1.0f, l, r);
+  expectNear(l, 239.0f);
+
+  // Thawed: the marker slides back as audio arrives and drops out of the
+  // count once the window has moved past it.
+  ring.setFrozen(false);
+  const auto third = ramp(240, 100);
+  ring.write(third.data(), nullptr, third.size());
+  ring.markOnset();  // at frame 340
+  assert(ring.onsetCount() == 2u);
+  expectNear(ring.onsetFramesAgo(0), 0.0f, 0.0f);
+  expectNear(ring.onsetFramesAgo(1), 140.0f, 0.0f);
+  const auto fourth = ramp(340, 150);
+  ring.write(fourth.data(), nullptr, fourth.size());
+  assert(ring.onsetCount() == 1u);  // frame 200 is now 290 ago > 256
+  expectNear(ring.onsetFramesAgo(0), 150.0f, 0.0f);
+  assert(ring.onsetFramesAgo(5) < 0.0f);
+
+  // clear() forgets audio and markers but keeps the allocation.
+  ring.clear();
+  assert(ring.capacityFrames() == 256u);
+  assert(ring.available() == 0u && ring.onsetCount() == 0u);
+
+  // Zero seconds releases the buffers; writes become no-ops.
+  ring.prepare(0.0f, 48000.0f);
+  ring.write(first.data(), nullptr, first.size());
+  assert(ring.capacityFrames() == 0u && ring.writeHead() == 0u);
+}
+
+}  // namespace
+
+void test_capture_ring_fractional_reads_and_wrap() {
+  test_power_of_two_fractional_reads_and_wrap();
+}
+
+void test_capture_ring_freeze_and_onsets() {
+  test_freeze_holds_and_onsets_age_out();
+}
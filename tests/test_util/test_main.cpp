@@ -4,6 +4,17 @@ void test_scale_quantizer_snap_to_scale_major();
 void test_scale_quantizer_snap_up_directional();
 void test_scale_quantizer_snap_down_directional();
 void test_scale_quantizer_root_wraps();
+void test_scale_quantizer_tables_match_reference_scan();
+void test_scale_quantizer_custom_masks_and_edges();
+void test_mpsc_ring_order_overflow_and_wrap();
+void test_mpsc_ring_stress_many_producers_one_consumer();
+void test_param_ramp_arrives_on_time();
+void test_param_ramp_retarget_advance_and_reconfigure();
+void test_param_ramp_target_queue_round_trip();
+void test_capture_ring_fractional_reads_and_wrap();
+void test_capture_ring_freeze_and_onsets();
+void test_oversampler_bypass_passband_and_latency();
+void test_oversampler_sweep_aliasing();
 
 int main(int, char**) {
   std::puts("[scale_quantizer] running snap-to-scale scenarios...");
@@ -11,6 +22,25 @@ int main(int, char**) {
   test_scale_quantizer_snap_up_directional();
   test_scale_quantizer_snap_down_directional();
   test_scale_quantizer_root_wraps();
+  test_scale_quantizer_tables_match_reference_scan();
+  test_scale_quantizer_custom_masks_and_edges();
   std::puts("[scale_quantizer] all assertions passed.");
+  std::puts("[mpsc_ring] running producer/consumer scenarios...");
+  test_mpsc_ring_order_overflow_and_wrap();
+  test_mpsc_ring_stress_many_producers_one_consumer();
+  std::puts("[mpsc_ring] all assertions passed.");
+  std::puts("[param_ramp] running per-sample glide scenarios...");
+  test_param_ramp_arrives_on_time();
+  test_param_ramp_retarget_advance_and_reconfigure();
+  test_param_ramp_target_queue_round_trip();
+  std::puts("[param_ramp] all assertions passed.");
+  std::puts("[capture_ring] running live-input capture scenarios...");
+  test_capture_ring_fractional_reads_and_wrap();
+  test_capture_ring_freeze_and_onsets();
+  std::puts("[capture_ring] all assertions passed.");
+  std::puts("[oversampler] running half-band saturation scenarios...");
+  test_oversampler_bypass_passband_and_latency();
+  test_oversampler_sweep_aliasing();
+  std::puts("[oversampler] all assertions passed.");
   return 0;
 }
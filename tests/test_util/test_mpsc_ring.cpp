@@ -0,0 +1,116 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "util/MpscRing.h"
+
+namespace {
+
+struct Command {
+  std::uint32_t producer{0};
+  std::uint32_t sequence{0};
+  std::uint64_t payload{0};
+};
+
+std::uint64_t payloadFor(std::uint32_t producer, std::uint32_t sequence) {
+  return (static_cast<std::uint64_t>(producer) << 32u) ^ (sequence * 2654435761u);
+}
+
+void test_order_overflow_and_wrap() {
+  util::MpscRing<Command, 8> ring;
+  Command out{};
+  assert(!ring.pop(out));
+
+  // Fill, overflow twice, then drain in push order.
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    assert(ring.push(Command{0, i, payloadFor(0, i)}));
+  }
+  assert(!ring.push(Command{0, 99, 0}));
+  assert(!ring.push(Command{0, 100, 0}));
+  assert(ring.overflowCount() == 2u);
+  assert(ring.highWater() == 8u);
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    assert(ring.pop(out));
+    assert(out.sequence == i);
+  }
+  assert(!ring.pop(out));
+
+  // Many laps around a small ring keep working once there is room again.
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    assert(ring.push(Command{1, i, payloadFor(1, i)}));
+    assert(ring.pop(out));
+    assert(out.sequence == i && out.payload == payloadFor(1, i));
+  }
+  assert(ring.overflowCount() == 2u);
+}
+
+void test_stress_many_producers_one_consumer() {
+  // Several threads hammer a deliberately small ring while one consumer drains.
+  // Every accepted command must come out exactly once, undamaged, and in each
+  // producer's own order; every rejected one must be counted as overflow.
+  constexpr std::uint32_t kProducers = 4;
+  constexpr std::uint32_t kPerProducer = 50000;
+  util::MpscRing<Command, 64> ring;
+  std::atomic<std::uint32_t> accepted{0};
+  std::atomic<std::uint32_t> producersDone{0};
+
+  std::vector<std::thread> producers;
+  for (std::uint32_t p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, &accepted, &producersDone, p]() {
+      // A full ring gets a few polite retries, then the command is dropped,
+      // the same way a host automation burst would be.
+      for (std::uint32_t i = 0; i < kPerProducer; ++i) {
+        for (int attempt = 0; attempt < 4; ++attempt) {
+          if (ring.push(Command{p, i, payloadFor(p, i)})) {
+            accepted.fetch_add(1u, std::memory_order_relaxed);
+            break;
+          }
+          std::this_thread::yield();
+        }
+      }
+      producersDone.fetch_add(1u, std::memory_order_release);
+    });
+  }
+
+  std::vector<std::int64_t> lastSeen(kProducers, -1);
+  std::uint32_t delivered = 0;
+  Command out{};
+  for (;;) {
+    const bool finished = producersDone.load(std::memory_order_acquire) == kProducers;
+    bool any = false;
+    while (ring.pop(out)) {
+      any = true;
+      assert(out.producer < kProducers);
+      assert(static_cast<std::int64_t>(out.sequence) > lastSeen[out.producer]);
+      assert(out.payload == payloadFor(out.producer, out.sequence));
+      lastSeen[out.producer] = out.sequence;
+      ++delivered;
+    }
+    if (finished && !any) {
+      break;
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  assert(delivered == accepted.load());
+  assert(delivered > 0u);
+  assert(ring.overflowCount() >= kProducers * kPerProducer - delivered);
+  assert(ring.highWater() <= ring.capacity());
+  std::printf("[mpsc_ring] delivered=%u overflow=%u highWater=%u\n", delivered, ring.overflowCount(),
+              ring.highWater());
+}
+
+}  // namespace
+
+void test_mpsc_ring_order_overflow_and_wrap() {
+  test_order_overflow_and_wrap();
+}
+
+void test_mpsc_ring_stress_many_producers_one_consumer() {
+  test_stress_many_producers_one_consumer();
+}
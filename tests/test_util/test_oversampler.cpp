@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "util/Oversampler.h"
+
+namespace {
+
+using Quality = util::Oversampler::Quality;
+using Factor = util::Oversampler::Factor;
+using Phase = util::Oversampler::Phase;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kRate = 48000.0;
+
+constexpr std::array<Quality, 5> kLadder{{{Factor::kOff, Phase::kMinimum},
+                                          {Factor::k2x, Phase::kMinimum},
+                                          {Factor::k2x, Phase::kLinear},
+                                          {Factor::k4x, Phase::kMinimum},
+                                          {Factor::k4x, Phase::kLinear}}};
+
+const char* label(const Quality& q) {
+  if (q.factor == Factor::kOff) {
+    return "off";
+  }
+  if (q.factor == Factor::k2x) {
+    return q.phase == Phase::kLinear ? "2x-linear" : "2x-minimum";
+  }
+  return q.phase == Phase::kLinear ? "4x-linear" : "4x-minimum";
+}
+
+// Hann-windowed power at `hz`, skipping the first `settle` samples so the
+// filters have filled.
+double powerAt(const std::vector<float>& x, double hz, std::size_t settle) {
+  double re = 0.0;
+  double im = 0.0;
+  const double n = static_cast<double>(x.size() - settle);
+  for (std::size_t i = settle; i < x.size(); ++i) {
+    const double w = 0.5 - 0.5 * std::cos(2.0 * kPi * static_cast<double>(i - settle) / n);
+    const double phase = 2.0 * kPi * hz * static_cast<double>(i) / kRate;
+    re += w * x[i] * std::cos(phase);
+    im += w * x[i] * std::sin(phase);
+  }
+  return re * re + im * im;
+}
+
+// Drive a sine into a hot tanh and compare the harmonics that folded back
+// across Nyquist with the fundamental.  Returns the worst ratio in dB over a
+// stepped sweep.  Only folds below 18 kHz count, and bins within 100 Hz of a
+// real harmonic are skipped, since there the two cannot be told apart.
+double worstAliasDb(const Quality& quality) {
+  constexpr std::array<double, 6> kSweepHz{2300.0, 3700.0, 5100.0, 6700.0, 8300.0, 9900.0};
+  constexpr std::size_t kSettle = 512;
+  // Above this the folds land in the filters' transition band.
+  constexpr double kAudibleHz = 18000.0;
+  double worst = -300.0;
+  for (double f0 : kSweepHz) {
+    util::Oversampler os;
+    os.setQuality(quality);
+    std::vector<float> out(kSettle + 16384);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      const float x = static_cast<float>(std::sin(2.0 * kPi * f0 * static_cast<double>(i) / kRate));
+      out[i] = os.process(x, [](float v) { return std::tanh(3.0f * v); });
+    }
+    const double fundamental = powerAt(out, f0, kSettle);
+    double folded = 0.0;
+    for (int k = 3; k <= 41; k += 2) {
+      const double harmonic = k * f0;
+      if (harmonic < kRate * 0.5) {
+        continue;
+      }
+      double alias = std::fmod(harmonic, kRate);
+      alias = alias > kRate * 0.5 ? kRate - alias : alias;
+      bool nearHarmonic = false;
+      for (int h = 1; h * f0 < kRate * 0.5; h += 2) {
+        nearHarmonic = nearHarmonic || std::fabs(alias - h * f0) < 100.0;
+      }
+      if (!nearHarmonic && alias < kAudibleHz) {
+        folded += powerAt(out, alias, kSettle);
+      }
+    }
+    worst = std::max(worst, 10.0 * std::log10(folded / fundamental + 1e-30));
+  }
+  return worst;
+}
+
+void test_bypass_passband_and_latency() {
+  // Bypass is the shaper called directly, bit for bit.
+  util::Oversampler bypass;
+  for (int i = 0; i < 64; ++i) {
+    const float x = std::sin(0.37f * static_cast<float>(i)) * 1.7f;
+    assert(bypass.process(x, [](float v) { return std::tanh(v); }) == std::tanh(x));
+  }
+  assert(!bypass.active());
+  assert(util::Oversampler::kRealtime != util::Oversampler::kOffline);
+
+  for (const Quality& quality : kLadder) {
+    // A 1 kHz tone through an identity "shaper" comes out at the same level.
+    util::Oversampler os;
+    os.setQuality(quality);
+    std::vector<float> out(8192);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      const float x = 0.5f * static_cast<float>(std::sin(2.0 * kPi * 1000.0 * static_cast<double>(i) / kRate));
+      out[i] = os.process(x, [](float v) { return v; });
+    }
+    float peak = 0.0f;
+    for (std::size_t i = 4096; i < out.size(); ++i) {
+      peak = std::max(peak, std::fabs(out[i]));
+    }
+    assert(std::fabs(peak - 0.5f) < 0.005f);
+
+    // An impulse peaks where `latency()` says it will, to the nearest sample.
+    os.setQuality(quality);
+    std::size_t at = 0;
+    float best = 0.0f;
+    for (std::size_t i = 0; i < 128; ++i) {
+      const float y = std::fabs(os.process(i == 0 ? 1.0f : 0.0f, [](float v) { return v; }));
+      if (y > best) {
+        best = y;
+        at = i;
+      }
+    }
+    if (quality.phase == Phase::kLinear && quality.factor != Factor::kOff) {
+      assert(std::fabs(static_cast<float>(at) - os.latency()) <= 0.5f);
+    } else {
+      // No fixed delay on the IIR path, but it is short.
+      assert(os.latency() == 0.0f && at <= 8u);
+    }
+  }
+}
+
+void test_sweep_aliasing_drops_with_factor() {
+  std::array<double, kLadder.size()> alias{};
+  for (std::size_t q = 0; q < kLadder.size(); ++q) {
+    alias[q] = worstAliasDb(kLadder[q]);
+    std::printf("[oversampler-alias] quality=%s worst-folded=%.1f dB\n", label(kLadder[q]), alias[q]);
+  }
+  // Base rate: folded harmonics sit only ~20 dB under the tone.  2x removes
+  // the ones that land in its stopband; the rest fold inside the 2x band and
+  // still come through, so 4x is the big step.
+  assert(alias[0] > -30.0);
+  for (std::size_t q = 1; q < kLadder.size(); ++q) {
+    assert(alias[q] < alias[0] - 10.0);
+  }
+  assert(alias[3] < -70.0);
+  assert(alias[4] < -70.0);
+}
+
+}  // namespace
+
+void test_oversampler_bypass_passband_and_latency() {
+  test_bypass_passband_and_latency();
+}
+
+void test_oversampler_sweep_aliasing() {
+  test_sweep_aliasing_drops_with_factor();
+}
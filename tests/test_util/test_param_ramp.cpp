@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "util/ParamRamp.h"
+
+namespace {
+
+void expectNear(float actual, float expected, float tolerance = 1e-5f) {
+  assert(std::fabs(actual - expected) <= tolerance);
+}
+
+void test_linear_and_one_pole_arrive_on_time() {
+  // 1 ms at 48 kHz is 48 samples: the linear ramp moves in equal steps and
+  // lands exactly on sample 48, never before and never past the target.
+  util::ParamRamp linear;
+  linear.configure(1.0f, 48000.0f);
+  assert(linear.rampSamples() == 48u);
+  linear.reset(0.0f);
+  linear.setTarget(1.0f);
+  float previous = 0.0f;
+  for (std::uint32_t i = 1; i < 48; ++i) {
+    const float value = linear.next();
+    expectNear(value - previous, 1.0f / 48.0f, 1e-4f);
+    assert(value < 1.0f);
+    previous = value;
+  }
+  assert(linear.ramping());
+  expectNear(linear.next(), 1.0f, 0.0f);
+  assert(!linear.ramping());
+  expectNear(linear.next(), 1.0f, 0.0f);
+
+  // The one-pole is within 0.1% of the distance one sample before the budget
+  // runs out, approaches monotonically, then snaps.
+  util::ParamRamp pole;
+  pole.configure(1.0f, 48000.0f, util::ParamRamp::Curve::kOnePole);
+  pole.reset(1.0f);
+  pole.setTarget(0.0f);
+  previous = 1.0f;
+  for (std::uint32_t i = 1; i < 48; ++i) {
+    const float value = pole.next();
+    assert(value < previous && value > 0.0f);
+    previous = value;
+  }
+  assert(previous < 0.0015f);
+  expectNear(pole.next(), 0.0f, 0.0f);
+
+  // Zero time is a jump on the next sample; tiny moves never start a ramp.
+  util::ParamRamp jump;
+  jump.configure(0.0f, 48000.0f);
+  jump.reset(0.25f);
+  jump.setTarget(0.75f);
+  expectNear(jump.next(), 0.75f, 0.0f);
+  jump.setTarget(0.75f + util::ParamRamp::kSettleEpsilon * 0.5f);
+  assert(!jump.ramping());
+}
+
+void test_retarget_advance_and_reconfigure() {
+  // A new target mid-glide starts from where the ramp stands: no jump back.
+  util::ParamRamp ramp;
+  ramp.configure(2.0f, 48000.0f);
+  ramp.reset(0.0f);
+  ramp.setTarget(1.0f);
+  for (int i = 0; i < 48; ++i) {
+    ramp.next();
+  }
+  const float halfway = ramp.value();
+  expectNear(halfway, 0.5f, 1e-3f);
+  ramp.setTarget(0.0f);
+  expectNear(ramp.next(), halfway - halfway / 96.0f, 1e-4f);
+
+  // advance(n) lands where n calls to next() would.
+  util::ParamRamp stepped;
+  util::ParamRamp skipped;
+  for (auto curve : {util::ParamRamp::Curve::kLinear, util::ParamRamp::Curve::kOnePole}) {
+    stepped.configure(5.0f, 44100.0f, curve);
+    skipped.configure(5.0f, 44100.0f, curve);
+    stepped.reset(0.2f);
+    skipped.reset(0.2f);
+    stepped.setTarget(0.9f);
+    skipped.setTarget(0.9f);
+    for (int i = 0; i < 100; ++i) {
+      stepped.next();
+    }
+    expectNear(skipped.advance(100), stepped.value(), 1e-4f);
+    assert(skipped.remainingSamples() == stepped.remainingSamples());
+    expectNear(skipped.advance(100000), 0.9f, 0.0f);
+    assert(!skipped.ramping());
+  }
+
+  // Changing the time mid-glide keeps the position and re-times the rest.
+  ramp.configure(10.0f, 48000.0f);
+  ramp.reset(0.0f);
+  ramp.setTarget(1.0f);
+  ramp.advance(240);
+  const float before = ramp.value();
+  ramp.configure(1.0f, 48000.0f);
+  expectNear(ramp.value(), before, 0.0f);
+  assert(ramp.remainingSamples() == 48u);
+  expectNear(ramp.target(), 1.0f, 0.0f);
+}
+
+void test_target_queue_round_trip() {
+  util::ParamTargetQueue<8> queue;
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    assert(queue.push(util::ParamTarget{i, static_cast<std::uint16_t>(i % 2), static_cast<float>(i) * 0.1f}));
+  }
+  assert(!queue.push(util::ParamTarget{}));
+  util::ParamTarget out{};
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    assert(queue.pop(out));
+    assert(out.seedId == i && out.param == i % 2);
+    expectNear(out.value, static_cast<float>(i) * 0.1f);
+  }
+  assert(!queue.pop(out));
+}
+
+}  // namespace
+
+void test_param_ramp_arrives_on_time() {
+  test_linear_and_one_pole_arrive_on_time();
+}
+
+void test_param_ramp_retarget_advance_and_reconfigure() {
+  test_retarget_advance_and_reconfigure();
+}
+
+void test_param_ramp_target_queue_round_trip() {
+  test_target_queue_round_trip();
+}
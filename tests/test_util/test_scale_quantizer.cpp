@@ -1,6 +1,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -63,6 +64,95 @@ void test_root_wraps() {
   expectNear(largeRoot, -9.0f);
 }
 
+// The scan the tables replaced: try every degree in a few octaves around the
+// target and keep the closest allowed one, ties going low.
+float referenceSnap(float target, int root, std::uint16_t mask, int direction) {
+  root %= 12;
+  const int baseOctave = static_cast<int>(std::floor((target - static_cast<float>(root)) / 12.0f));
+  float bestPitch = target;
+  float bestDistance = std::numeric_limits<float>::infinity();
+  for (int octave = baseOctave - 2; octave <= baseOctave + 2; ++octave) {
+    for (int degree = 0; degree < 12; ++degree) {
+      if (((mask >> degree) & 1u) == 0) {
+        continue;
+      }
+      const float candidate = static_cast<float>(octave * 12 + root + degree);
+      const float delta = candidate - target;
+      if ((direction > 0 && delta < 0.0f) || (direction < 0 && delta > 0.0f)) {
+        continue;
+      }
+      const float absDelta = std::fabs(delta);
+      if (absDelta < bestDistance || (absDelta == bestDistance && candidate < bestPitch)) {
+        bestPitch = candidate;
+        bestDistance = absDelta;
+      }
+    }
+  }
+  return bestPitch;
+}
+
+void test_tables_match_reference_scan() {
+  using util::QuantizerMode;
+  using util::ScaleQuantizer;
+  // Built-in scales plus a few user masks: whole-tone, a lone root, and a
+  // lopsided cluster that leaves an eight-semitone hole.
+  const std::uint16_t masks[] = {
+      ScaleQuantizer::MaskFor(ScaleQuantizer::Scale::kChromatic),
+      ScaleQuantizer::MaskFor(ScaleQuantizer::Scale::kMajor),
+      ScaleQuantizer::MaskFor(ScaleQuantizer::Scale::kMinor),
+      ScaleQuantizer::MaskFor(ScaleQuantizer::Scale::kPentatonicMajor),
+      ScaleQuantizer::MaskFor(ScaleQuantizer::Scale::kPentatonicMinor),
+      0x0555, 0x0001, 0x000B,
+  };
+  std::vector<float> pitches;
+  for (int step = -400; step <= 400; ++step) {
+    pitches.push_back(static_cast<float>(step) * 0.125f);
+  }
+  pitches.push_back(6.5f);
+  pitches.push_back(-0.001f);
+  std::vector<float> block(pitches.size());
+
+  for (std::uint16_t mask : masks) {
+    const ScaleQuantizer::Table table(mask);
+    for (int root = 0; root < 12; ++root) {
+      const auto r = static_cast<std::uint8_t>(root);
+      for (float p : pitches) {
+        assert(table.snap(p, r, QuantizerMode::kNearest) == referenceSnap(p, root, mask, 0));
+        assert(table.snap(p, r, QuantizerMode::kUp) == referenceSnap(p, root, mask, 1));
+        assert(table.snap(p, r, QuantizerMode::kDown) == referenceSnap(p, root, mask, -1));
+      }
+      table.quantizeBlock(pitches.data(), block.data(), pitches.size(), r, QuantizerMode::kNearest);
+      for (std::size_t i = 0; i < pitches.size(); ++i) {
+        assert(block[i] == referenceSnap(pitches[i], root, mask, 0));
+      }
+    }
+  }
+}
+
+void test_custom_masks_and_edges() {
+  using util::QuantizerMode;
+  using util::ScaleQuantizer;
+  // Whole-tone from D: D E F# G# A# C.
+  const ScaleQuantizer::Table wholeTone(0x0555);
+  assert(wholeTone.snap(3.0f, 2, QuantizerMode::kNearest) == 2.0f);
+  assert(wholeTone.snap(3.0f, 2, QuantizerMode::kUp) == 4.0f);
+  assert(wholeTone.snap(-1.0f, 2, QuantizerMode::kDown) == -2.0f);
+
+  // High bits are ignored; an empty mask and non-finite pitches pass through.
+  assert(ScaleQuantizer::Table(0xF001).mask() == 0x0001);
+  const ScaleQuantizer::Table empty(0);
+  assert(empty.snap(3.3f, 0, QuantizerMode::kNearest) == 3.3f);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  assert(std::isnan(wholeTone.snap(nan, 0, QuantizerMode::kUp)));
+
+  // Blocks may be snapped in place.
+  float inPlace[] = {1.1f, 5.9f, -0.4f};
+  ScaleQuantizer::QuantizeBlock(inPlace, inPlace, 3, 0, ScaleQuantizer::Scale::kMajor, QuantizerMode::kNearest);
+  expectNear(inPlace[0], 2.0f);
+  expectNear(inPlace[1], 5.0f);
+  expectNear(inPlace[2], 0.0f);
+}
+
 void test_drift_samples_and_csv() {
   const std::vector<float> offsets{0.0f, 2.5f};
   const double driftHz = 0.25;
@@ -120,3 +210,11 @@ void test_scale_quantizer_root_wraps() {
 void test_scale_quantizer_drift_samples_and_csv() {
   test_drift_samples_and_csv();
 }
+
+void test_scale_quantizer_tables_match_reference_scan() {
+  test_tables_match_reference_scan();
+}
+
+void test_scale_quantizer_custom_masks_and_edges() {
+  test_custom_masks_and_edges();
+}
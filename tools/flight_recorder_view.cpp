@@ -0,0 +1,190 @@
+// flight_recorder_view: render a FlightRecorder dump (.sbfr) as a text timeline.
+//
+//   seedbox_flight_recorder_view <dump.sbfr> [--all] [--context N]
+//
+// By default only the blocks around flagged events (clip, overrun, host drops)
+// are printed, plus a summary; --all prints every block.  Each row shows the
+// block number, render time against its budget, one energy bar per engine, the
+// output peak, triggers fired, queue depths, flags and clock owner.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "app/FlightRecorder.h"
+
+namespace {
+
+struct ViewConfig {
+  std::string path;
+  bool all = false;
+  std::size_t context = 4u;
+};
+
+constexpr const char* kEngineNames[FlightRecorder::kEngineSlots] = {"smp", "gra", "res", "euc", "bur"};
+constexpr std::uint8_t kEventFlags = FlightRecorder::kClip | FlightRecorder::kOverrun | FlightRecorder::kMidiDrop |
+                                     FlightRecorder::kOversizeDrop;
+
+ViewConfig parseArgs(int argc, char** argv) {
+  ViewConfig config{};
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--all") {
+      config.all = true;
+    } else if (arg == "--context" && i + 1 < argc) {
+      config.context = static_cast<std::size_t>(std::stoul(argv[++i]));
+    } else if (!arg.empty() && arg[0] == '-') {
+      throw std::runtime_error("unknown option " + arg);
+    } else {
+      config.path = arg;
+    }
+  }
+  if (config.path.empty()) {
+    throw std::runtime_error("usage: seedbox_flight_recorder_view <dump.sbfr> [--all] [--context N]");
+  }
+  return config;
+}
+
+// Eight-step bar on a dB scale: -60 dBFS and below is empty, 0 dBFS is full.
+char energyGlyph(float rms) {
+  static constexpr char kGlyphs[] = " .:-=+*#@";
+  if (rms <= 0.001f) {
+    return kGlyphs[0];
+  }
+  const float db = 20.0f * std::log10(std::min(rms, 1.0f));
+  const int step = 1 + static_cast<int>((db + 60.0f) / 60.0f * 7.0f);
+  return kGlyphs[std::clamp(step, 1, 8)];
+}
+
+std::string flagText(std::uint8_t flags) {
+  std::string text;
+  auto add = [&](std::uint8_t bit, const char* name) {
+    if (flags & bit) {
+      text += text.empty() ? "" : ",";
+      text += name;
+    }
+  };
+  add(FlightRecorder::kClip, "CLIP");
+  add(FlightRecorder::kOverrun, "OVERRUN");
+  add(FlightRecorder::kMidiDrop, "MIDI-DROP");
+  add(FlightRecorder::kOversizeDrop, "OVERSIZE");
+  add(FlightRecorder::kTestTone, "tone");
+  return text;
+}
+
+const char* clockText(FlightRecorder::ClockSource clock) {
+  switch (clock) {
+    case FlightRecorder::ClockSource::kExternal:
+      return "ext";
+    case FlightRecorder::ClockSource::kWaiting:
+      return "wait";
+    case FlightRecorder::ClockSource::kInternal:
+    default:
+      return "int";
+  }
+}
+
+void printRow(const FlightRecorder::Record& rec, float sampleRate, bool trigger) {
+  const double budgetUs = sampleRate > 0.0f ? static_cast<double>(rec.frames) * 1.0e6 / sampleRate : 0.0;
+  const double renderUs = static_cast<double>(rec.renderNanos) / 1000.0;
+  const double load = budgetUs > 0.0 ? renderUs / budgetUs * 100.0 : 0.0;
+  std::string bars;
+  for (float rms : rec.engineRms) {
+    bars.push_back(energyGlyph(rms));
+  }
+  std::printf("%c %10llu %8.1fus %5.1f%% [%s] peak=%5.3f trig=%-3lu bq=%-3u hq=%-4u %-4s %s\n",
+              trigger ? '>' : ' ', static_cast<unsigned long long>(rec.block), renderUs, load, bars.c_str(),
+              static_cast<double>(rec.outputPeak), static_cast<unsigned long>(rec.triggersFired),
+              static_cast<unsigned>(rec.burstQueueDepth), static_cast<unsigned>(rec.hostCommandHighWater),
+              clockText(rec.clock), flagText(rec.flags).c_str());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  try {
+    const ViewConfig config = parseArgs(argc, argv);
+    std::ifstream in(config.path, std::ios::binary);
+    if (!in.good()) {
+      throw std::runtime_error("failed to open " + config.path);
+    }
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    FlightRecorder::DumpHeader header{};
+    std::vector<FlightRecorder::Record> records;
+    if (!FlightRecorder::decodeDump(bytes.data(), bytes.size(), header, records)) {
+      throw std::runtime_error("not a flight recorder dump (or an unsupported version): " + config.path);
+    }
+    if (records.empty()) {
+      std::printf("%s: empty dump\n", config.path.c_str());
+      return 0;
+    }
+
+    // Mark every row within `context` blocks of a flagged one.
+    std::vector<bool> show(records.size(), config.all);
+    std::size_t events = 0;
+    std::size_t clips = 0;
+    std::size_t overruns = 0;
+    std::size_t worst = 0;
+    std::uint64_t triggers = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      const auto& rec = records[i];
+      triggers += rec.triggersFired;
+      clips += (rec.flags & FlightRecorder::kClip) ? 1u : 0u;
+      overruns += (rec.flags & FlightRecorder::kOverrun) ? 1u : 0u;
+      if (rec.renderNanos > records[worst].renderNanos) {
+        worst = i;
+      }
+      if (rec.flags & kEventFlags) {
+        ++events;
+        const std::size_t from = i > config.context ? i - config.context : 0u;
+        const std::size_t to = std::min(records.size(), i + config.context + 1u);
+        std::fill(show.begin() + static_cast<std::ptrdiff_t>(from), show.begin() + static_cast<std::ptrdiff_t>(to),
+                  true);
+      }
+    }
+
+    std::printf("%s: %zu blocks (%llu..%llu) at %.0f Hz", config.path.c_str(), records.size(),
+                static_cast<unsigned long long>(records.front().block),
+                static_cast<unsigned long long>(records.back().block), static_cast<double>(header.sampleRate));
+    if (header.triggerBlock != 0) {
+      std::printf(", dumped after block %llu", static_cast<unsigned long long>(header.triggerBlock));
+    }
+    std::printf("\n  engines: ");
+    for (const char* name : kEngineNames) {
+      std::printf("%s ", name);
+    }
+    std::printf("(bars: ' ' silent .. '@' 0 dBFS)\n\n");
+
+    bool gap = false;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      if (!show[i]) {
+        gap = true;
+        continue;
+      }
+      if (gap) {
+        std::printf("  ...\n");
+        gap = false;
+      }
+      printRow(records[i], header.sampleRate, records[i].block == header.triggerBlock);
+    }
+    if (gap) {
+      std::printf("  ...\n");
+    }
+
+    std::printf("\nsummary: events=%zu clips=%zu overruns=%zu triggers=%llu worst=%.1fus at block %llu\n", events,
+                clips, overruns, static_cast<unsigned long long>(triggers),
+                static_cast<double>(records[worst].renderNanos) / 1000.0,
+                static_cast<unsigned long long>(records[worst].block));
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "flight_recorder_view: " << e.what() << '\n';
+    return 1;
+  }
+}
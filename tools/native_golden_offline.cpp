@@ -9,11 +9,13 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 // Offline helper that mirrors the PlatformIO-native golden renders. We compile
@@ -32,6 +34,7 @@
 #include "engine/Granular.h"
 #include "engine/Resonator.h"
 #include "engine/Sampler.h"
+#include "tests/native_golden/golden_cache.hpp"
 #include "tests/native_golden/wav_helpers.hpp"
 #include "tests/native_golden/fixtures_autogen.hpp"
 
@@ -58,6 +61,85 @@ struct FixtureBinding {
     std::string path_storage;
 };
 
+// Cache recipe per fixture: the engine sources its render routine compiles
+// against (followed through their includes) and a revision number for the
+// routine itself.  The routines live in this file, so bump `revision` when you
+// edit one; otherwise the cache keeps serving the old render.  Fixtures with
+// no recipe always re-render.
+struct FixtureRecipe {
+    const char* name;
+    std::uint32_t revision;
+    std::vector<const char*> sources;
+};
+
+constexpr const char* kSamplerSource = "src/engine/Sampler.cpp";
+constexpr const char* kGranularSource = "src/engine/Granular.cpp";
+constexpr const char* kResonatorSource = "src/engine/Resonator.cpp";
+constexpr const char* kEuclidSource = "src/engine/EuclidEngine.cpp";
+constexpr const char* kBurstSource = "src/engine/BurstEngine.cpp";
+constexpr const char* kOfflineRendererSource = "examples/shared/offline_renderer.cpp";
+constexpr const char* kReseedPlaybookSource = "examples/shared/reseed_playbook.hpp";
+constexpr const char* kInputTonePrefix = "input-tone-";
+
+const std::vector<FixtureRecipe>& fixture_recipes() {
+    static const std::vector<FixtureRecipe> recipes = {
+        {"drone-intro", 1, {}},
+        {"sampler-grains", 1, {kSamplerSource}},
+        {"resonator-tail", 1, {kResonatorSource}},
+        {"granular-haze", 1, {kGranularSource}},
+        {"mixer-console", 1, {kSamplerSource, kResonatorSource, kGranularSource}},
+        {"modulated-sampler", 1, {kSamplerSource, kGranularSource}},
+        {"layered-euclid-burst", 1, {kEuclidSource, kBurstSource}},
+        {"euclid-mask", 1, {kEuclidSource}},
+        {"burst-cluster", 1, {kBurstSource}},
+        {"quad-bus", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"surround-bus", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"engine-hybrid-stack", 1, {kEuclidSource, kBurstSource}},
+        {"engine-macro-orbits", 1, {kEuclidSource, kBurstSource}},
+        {"engine-multi-ledger", 1, {kEuclidSource}},
+        {"stage71-bus", 1, {}},
+        {"long-random-take", 2, {kSamplerSource, kResonatorSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"reseed-A", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"reseed-B", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"reseed-C", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"reseed-poly", 1, {kSamplerSource, kResonatorSource, kGranularSource, kOfflineRendererSource, kReseedPlaybookSource}},
+        {"burst-cluster-control", 1, {kBurstSource}},
+        {"reseed-log", 1, {kOfflineRendererSource, kReseedPlaybookSource}},
+        // Custom tones are pure math; their parameters ride in the key.
+        {kInputTonePrefix, 1, {}},
+    };
+    return recipes;
+}
+
+const FixtureRecipe* find_recipe(const char* fixture_name) {
+    const std::string_view name(fixture_name);
+    for (const auto& recipe : fixture_recipes()) {
+        if (name == recipe.name) {
+            return &recipe;
+        }
+    }
+    if (name.rfind(kInputTonePrefix, 0) == 0) {
+        return &fixture_recipes().back();
+    }
+    return nullptr;
+}
+
+// Run-wide cache state.  `recording` collects every artifact the render in
+// flight writes (its own WAV plus any control logs it emits on the way), so a
+// cache hit can restore all of them.
+struct CacheRun {
+    std::unique_ptr<golden::FixtureCache> cache;
+    bool changed_only = false;
+    std::vector<golden::CacheArtifact>* recording = nullptr;
+    std::vector<std::string> rendered;
+    std::vector<std::string> reused;
+};
+
+CacheRun& cache_run() {
+    static CacheRun run;
+    return run;
+}
+
 bool has_expected_hash(const FixtureInfo& spec) {
     return spec.expected_hash != nullptr && spec.expected_hash[0] != '\0' &&
            std::strcmp(spec.expected_hash, kPendingHashSentinel) != 0;
@@ -1197,7 +1279,7 @@ std::string fnv1a_bytes(const std::string& bytes) {
     return oss.str();
 }
 
-std::vector<int16_t> render_long_random_take_fixture() {
+bool render_long_random_take_fixture(offline::WavStreamWriter& writer) {
     constexpr double kDurationSeconds = 30.0;
     constexpr std::uint32_t kMasterSeed = 0x30F00Du;
     constexpr int kBpm = 120;
@@ -1218,7 +1300,6 @@ std::vector<int16_t> render_long_random_take_fixture() {
     offline::OfflineRenderer renderer(settings);
     renderer.mixSamplerEvents(plan.samplerEvents);
     renderer.mixResonatorEvents(plan.resonatorEvents);
-    const auto& pcm = renderer.finalize();
 
     const std::size_t frames = settings.frames;
     std::ostringstream control;
@@ -1235,14 +1316,10 @@ std::vector<int16_t> render_long_random_take_fixture() {
     }
     (void)emit_control_log_impl("long-random-take", control.str());
 
-    std::vector<int16_t> trimmed(frames * 2u, 0);
-    const std::size_t available_frames = std::min(frames, pcm.size());
-    for (std::size_t i = 0; i < available_frames; ++i) {
-        const int16_t sample = pcm[i];
-        trimmed[2u * i] = sample;
-        trimmed[2u * i + 1u] = sample;
-    }
-    return trimmed;
+    // The manifest files this take as mono with every sample written twice.
+    // Stream the normalised mix straight into the writer instead of building
+    // the PCM vector and a doubled copy of it.
+    return renderer.streamTo(writer, frames, 2u);
 }
 std::vector<int16_t> render_reseed_variant(
     std::uint32_t master_seed,
@@ -1386,6 +1463,34 @@ std::filesystem::path fixture_path(const char* manifest_path) {
     return project_root() / "build/fixtures" / path;
 }
 
+void report_fixture_hash(const FixtureInfo& spec, const std::string& hash) {
+    if (!has_expected_hash(spec)) {
+        std::cout << "[note] " << spec.name << " -> " << spec.path << " hash " << hash
+                  << " (new fixture; refresh manifest/header once happy)" << std::endl;
+        return;
+    }
+    if (hash != spec.expected_hash) {
+        std::cout << "[delta] " << spec.name << " -> " << spec.path << " expected "
+                  << spec.expected_hash << " got " << hash
+                  << " (refresh manifest after verifying the change)" << std::endl;
+        return;
+    }
+    std::cout << "[ok] " << spec.name << " -> " << spec.path << " (" << hash << ")"
+              << std::endl;
+}
+
+void record_artifact(const FixtureInfo& spec, const std::string& manifest_hash) {
+    auto* recording = cache_run().recording;
+    if (recording == nullptr) {
+        return;
+    }
+    golden::CacheArtifact artifact;
+    artifact.fixture = spec.name;
+    artifact.path = fixture_path(spec.path).lexically_relative(project_root()).generic_string();
+    artifact.manifest_hash = manifest_hash;
+    recording->push_back(std::move(artifact));
+}
+
 bool emit_control_log_impl(const char* fixture_name, const std::string& body) {
     if (fixture_name == nullptr || *fixture_name == '\0') {
         return false;
@@ -1407,29 +1512,28 @@ void ensure_fixture_with_rate(const FixtureInfo& spec,
                               const std::vector<int16_t>& samples,
                               std::uint32_t sample_rate_hz,
                               std::uint16_t channels) {
-    golden::WavWriteRequest request{};
-    request.path = fixture_path(spec.path).string();
-    request.sample_rate_hz = sample_rate_hz;
-    request.channels = channels;
-    request.samples = samples;
-
-    if (!golden::write_wav_16(request)) {
+    // Hashed while it streams to disk; no request copy, no second pass.
+    const auto hash = golden::write_wav_16_hashed(fixture_path(spec.path).string(), sample_rate_hz, channels, samples);
+    if (hash.empty()) {
         throw std::runtime_error(std::string("Failed to write fixture ") + spec.name);
     }
-    const auto hash = golden::hash_pcm16(request.samples);
-    if (!has_expected_hash(spec)) {
-        std::cout << "[note] " << spec.name << " -> " << spec.path << " hash " << hash
-                  << " (new fixture; refresh manifest/header once happy)" << std::endl;
-        return;
-    }
-    if (hash != spec.expected_hash) {
-        std::cout << "[delta] " << spec.name << " -> " << spec.path << " expected "
-                  << spec.expected_hash << " got " << hash
-                  << " (refresh manifest after verifying the change)" << std::endl;
-        return;
-    }
-    std::cout << "[ok] " << spec.name << " -> " << spec.path << " (" << hash << ")"
-              << std::endl;
+    record_artifact(spec, hash);
+    report_fixture_hash(spec, hash);
+}
+
+// For renders that can feed a writer directly (the long take): the PCM never
+// exists as a vector, and the manifest hash falls out of the write.
+template <typename Stream>
+void ensure_streamed_fixture(const FixtureInfo& spec, std::uint16_t channels, Stream&& stream) {
+    offline::WavStreamWriter writer;
+    bool ok = writer.open(fixture_path(spec.path).string(), static_cast<std::uint32_t>(kSampleRate), channels);
+    ok = ok && stream(writer);
+    const auto hash = writer.hashHex();
+    if (!writer.close() || !ok) {
+        throw std::runtime_error(std::string("Failed to stream fixture ") + spec.name);
+    }
+    record_artifact(spec, hash);
+    report_fixture_hash(spec, hash);
 }
 
 void ensure_fixture(const FixtureInfo& spec,
@@ -1448,26 +1552,77 @@ void ensure_log_fixture(const FixtureInfo& spec, const std::string& body) {
         throw std::runtime_error(std::string("Failed to write log fixture ") + spec.name);
     }
     const auto hash = fnv1a_bytes(body);
-    if (!has_expected_hash(spec)) {
-        std::cout << "[note] " << spec.name << " -> " << spec.path << " hash " << hash
-                  << " (new fixture; refresh manifest/header once happy)" << std::endl;
+    record_artifact(spec, hash);
+    report_fixture_hash(spec, hash);
+}
+
+std::string fixture_cache_key(const FixtureRecipe& recipe,
+                              const char* fixture_name,
+                              std::uint16_t channels,
+                              const std::string& params) {
+    golden::CacheKeyBuilder key(project_root());
+    key.add("fixture", fixture_name)
+        .add("revision", recipe.revision)
+        .add("channels", channels)
+        .add("sample_rate_hz", static_cast<std::uint64_t>(kSampleRate))
+        .add("params", params)
+        .add("compiler", __VERSION__);
+    // The WAV writer and the spatial renders share this file; Seed.h and the
+    // engine contract come along through its includes.
+    key.add_source_closure("tests/native_golden/wav_helpers.cpp");
+    for (const char* source : recipe.sources) {
+        key.add_source_closure(source);
+    }
+    return key.finish();
+}
+
+// Render through the cache.  A hit restores the recorded artifacts and reports
+// their manifest hashes; a miss runs `render`, which writes and reports as
+// usual, and then files what it wrote under the new key.
+template <typename Render>
+void render_cached(const char* fixture_name, std::uint16_t channels, const std::string& params, Render&& render) {
+    auto& run = cache_run();
+    const FixtureRecipe* recipe = find_recipe(fixture_name);
+    if (run.cache == nullptr || !run.cache->enabled() || recipe == nullptr) {
+        render();
+        run.rendered.emplace_back(fixture_name);
         return;
     }
-    if (hash != spec.expected_hash) {
-        std::cout << "[delta] " << spec.name << " -> " << spec.path << " expected "
-                  << spec.expected_hash << " got " << hash
-                  << " (refresh manifest after verifying the change)" << std::endl;
+
+    const std::string key = fixture_cache_key(*recipe, fixture_name, channels, params);
+    std::vector<golden::CacheArtifact> artifacts;
+    if (run.cache->lookup(fixture_name, key, artifacts)) {
+        run.reused.emplace_back(fixture_name);
+        if (run.changed_only) {
+            return;
+        }
+        std::cout << "[cached] " << fixture_name << " (key " << key << ")" << std::endl;
+        for (const auto& artifact : artifacts) {
+            const FixtureInfo* spec = find_audio_fixture(artifact.fixture.c_str());
+            if (spec == nullptr) {
+                spec = find_log_fixture(artifact.fixture.c_str());
+            }
+            FixtureInfo placeholder{artifact.fixture.c_str(), artifact.path.c_str(), kPendingHashSentinel};
+            report_fixture_hash(spec != nullptr ? *spec : placeholder, artifact.manifest_hash);
+        }
         return;
     }
-    std::cout << "[ok] " << spec.name << " -> " << spec.path << " (" << hash << ")"
-              << std::endl;
+
+    run.recording = &artifacts;
+    render();
+    run.recording = nullptr;
+    run.rendered.emplace_back(fixture_name);
+    if (!run.cache->store(fixture_name, key, artifacts)) {
+        std::cout << "[note] could not cache " << fixture_name << "; it will re-render next run" << std::endl;
+    }
 }
 
 template <typename Generator>
 void maybe_emit_audio(const char* fixture_name,
                       std::uint16_t channels,
                       Generator&& generator,
-                      const std::vector<std::string>& filters) {
+                      const std::vector<std::string>& filters,
+                      const std::string& params = {}) {
     const auto* spec = find_audio_fixture(fixture_name);
     FixtureBinding placeholder;
     if (spec == nullptr) {
@@ -1480,7 +1635,13 @@ void maybe_emit_audio(const char* fixture_name,
         std::cout << "[skip] " << spec->name << " (filtered)" << std::endl;
         return;
     }
-    ensure_fixture(*spec, generator(), channels);
+    render_cached(fixture_name, channels, params, [&] {
+        if constexpr (std::is_invocable_v<Generator&, offline::WavStreamWriter&>) {
+            ensure_streamed_fixture(*spec, channels, generator);
+        } else {
+            ensure_fixture(*spec, generator(), channels);
+        }
+    });
 }
 
 template <typename Generator>
@@ -1515,23 +1676,32 @@ void maybe_emit_spatial_fixture(const char* audio_fixture_name,
         return;
     }
 
-    const auto capture = generator();
-    const std::uint16_t channels = capture.channels > 0 ? capture.channels : 1u;
-    const std::uint32_t sample_rate =
-        capture.sample_rate_hz > 0u ? capture.sample_rate_hz : static_cast<std::uint32_t>(kSampleRate);
-
-    if (wants_audio) {
-        ensure_fixture_with_rate(*audio_spec, capture.samples, sample_rate, channels);
-    } else {
-        std::cout << "[skip] " << audio_spec->name << " (filtered)" << std::endl;
-    }
+    const auto emit = [&] {
+        const auto capture = generator();
+        const std::uint16_t channels = capture.channels > 0 ? capture.channels : 1u;
+        const std::uint32_t sample_rate =
+            capture.sample_rate_hz > 0u ? capture.sample_rate_hz : static_cast<std::uint32_t>(kSampleRate);
 
-    if (log_spec != nullptr) {
-        if (wants_log) {
-            ensure_log_fixture(*log_spec, capture.control_log);
+        if (wants_audio) {
+            ensure_fixture_with_rate(*audio_spec, capture.samples, sample_rate, channels);
         } else {
-            std::cout << "[skip] " << log_spec->name << " (filtered)" << std::endl;
+            std::cout << "[skip] " << audio_spec->name << " (filtered)" << std::endl;
         }
+
+        if (log_spec != nullptr) {
+            if (wants_log) {
+                ensure_log_fixture(*log_spec, capture.control_log);
+            } else {
+                std::cout << "[skip] " << log_spec->name << " (filtered)" << std::endl;
+            }
+        }
+    };
+    // Only whole audio+log pairs go through the cache; a half-filtered run
+    // renders directly so an entry never misses one of its artifacts.
+    if (wants_audio && (log_spec == nullptr || wants_log)) {
+        render_cached(audio_fixture_name, 0, {}, emit);
+    } else {
+        emit();
     }
 }
 
@@ -1552,7 +1722,40 @@ void maybe_emit_log(const char* fixture_name,
         std::cout << "[skip] " << spec->name << " (filtered)" << std::endl;
         return;
     }
-    ensure_log_fixture(*spec, generator());
+    render_cached(fixture_name, 0, {}, [&] { ensure_log_fixture(*spec, generator()); });
+}
+
+bool env_flag(const char* name, bool fallback) {
+    const char* raw = std::getenv(name);
+    if (raw == nullptr || *raw == '\0') {
+        return fallback;
+    }
+    const std::string value = to_lower_copy(trim_copy(raw));
+    return !(value == "0" || value == "false" || value == "off" || value == "no");
+}
+
+std::string input_tone_params(const InputToneSpec& tone) {
+    std::ostringstream params;
+    params << std::setprecision(17) << "freq_hz=" << tone.freq_hz << " amplitude=" << tone.amplitude
+           << " duration_seconds=" << tone.duration_seconds;
+    return params.str();
+}
+
+void report_cache_run(const CacheRun& run) {
+    const std::size_t total = run.rendered.size() + run.reused.size();
+    if (run.changed_only) {
+        std::cout << "[changed-only] re-rendered " << run.rendered.size() << " of " << total << " fixtures";
+        if (!run.rendered.empty()) {
+            std::cout << ':';
+            for (const auto& name : run.rendered) {
+                std::cout << ' ' << name;
+            }
+        }
+        std::cout << std::endl;
+        return;
+    }
+    std::cout << "[offline-native-golden] rendered " << run.rendered.size() << ", reused "
+              << run.reused.size() << " from build/golden-cache" << std::endl;
 }
 
 }  // namespace
@@ -1568,6 +1771,13 @@ int main() {
 
         const auto filters = parse_filter_tokens();
         const auto input_tones = parse_input_tone_specs();
+        auto& run = cache_run();
+        run.changed_only = env_flag("SEEDBOX_OFFLINE_GOLDEN_CHANGED_ONLY", false);
+        run.cache = std::make_unique<golden::FixtureCache>(
+            project_root(), project_root() / "build/golden-cache", env_flag("SEEDBOX_OFFLINE_GOLDEN_CACHE", true));
+        if (!run.cache->enabled()) {
+            std::cout << "[offline-native-golden] cache disabled; rendering everything" << std::endl;
+        }
         if (!filters.empty()) {
             std::cout << "[offline-native-golden] active filters:";
             for (const auto& token : filters) {
@@ -1620,7 +1830,9 @@ int main() {
                                    "stage71-bus-control",
                                    [] { return golden::render_stage71_scene(); },
                                    filters);
-        maybe_emit_audio("long-random-take", 1, [] { return render_long_random_take_fixture(); }, filters);
+        maybe_emit_audio(
+            "long-random-take", 1,
+            [](offline::WavStreamWriter& writer) { return render_long_random_take_fixture(writer); }, filters);
         maybe_emit_audio("reseed-A", 1,
                         [] { return render_reseed_variant(0xCAFEu, "reseed-A"); }, filters);
         maybe_emit_audio("reseed-B", 1,
@@ -1648,9 +1860,11 @@ int main() {
                     return render_input_tone(
                         tone.fixture_name.c_str(), tone.freq_hz, tone.amplitude, tone.duration_seconds);
                 },
-                filters);
+                filters,
+                input_tone_params(tone));
         }
 
+        report_cache_run(run);
         std::cout << "Native golden fixtures refreshed." << std::endl;
         return 0;
     } catch (const std::exception& ex) {